@@ -1,6 +1,6 @@
-#include "tracker.h"
+#include "tracker_i.h"
+#include <furi.h>
 #include <stdbool.h>
-#include "speaker_hal.h"
 
 // SongState song_state = {
 //     .tick = 0,
@@ -21,12 +21,16 @@ typedef struct {
     float pwm;
     bool play;
     IntegerOscillator vibrato;
+    float output_frequency;
+    float output_pwm;
 } ChannelState;
 
 typedef struct {
     ChannelState* channels;
     uint8_t tick;
     uint8_t tick_limit;
+    uint8_t slice;
+    uint8_t voice;
 
     uint8_t pattern_index;
     uint8_t row_index;
@@ -44,6 +48,8 @@ struct Tracker {
     bool playing;
     TrackerMessageCallback callback;
     void* context;
+    TrackerOutputCallback output_callback;
+    void* output_context;
     SongState song_state;
 };
 
@@ -61,6 +67,9 @@ static void channels_state_init(ChannelState* channel) {
 static void tracker_song_state_init(Tracker* tracker) {
     tracker->song_state.tick = 0;
     tracker->song_state.tick_limit = 2;
+    tracker->song_state.slice = 0;
+    // first slice goes to channel 0
+    tracker->song_state.voice = tracker->song->channels_count - 1;
     tracker->song_state.row_index = 0;
     tracker->song_state.order_list_index = 0;
     tracker->song_state.pattern_index = tracker->song->order_list[0];
@@ -196,22 +205,15 @@ static void advance_to_pattern(Tracker* tracker, Location advance) {
     tracker_send_position_message(tracker);
 }
 
-static void tracker_interrupt_body(Tracker* tracker) {
-    if(!tracker->playing) {
-        tracker_speaker_stop();
-        return;
-    }
-
-    const uint8_t channel_index = 0;
+static void tracker_apply_first_tick_effects(Tracker* tracker) {
     SongState* song_state = &tracker->song_state;
-    ChannelState* channel_state = &song_state->channels[channel_index];
     const Song* song = tracker->song;
-    UnpackedRow row = get_current_row(song, song_state, channel_index);
+    bool invalidate_row = false;
+
+    // flow effects, the first channel that has one wins
+    for(uint8_t i = 0; i < song->channels_count && !invalidate_row; i++) {
+        UnpackedRow row = get_current_row(song, song_state, i);
 
-    // load frequency from note at tick 0
-    if(song_state->tick == 0) {
-        bool invalidate_row = false;
-        // handle "on first tick" effects
         if(row.effect == EffectBreakPattern) {
             int16_t next_row_index = row.data;
             int16_t next_pattern_index =
@@ -226,11 +228,12 @@ static void tracker_interrupt_body(Tracker* tracker) {
                 });
 
             invalidate_row = true;
-        }
-
-        if(row.effect == EffectJumpToOrder) {
-            song_state->order_list_index = row.data;
-            int16_t next_pattern_index = song->order_list[song_state->order_list_index];
+        } else if(row.effect == EffectJumpToOrder) {
+            int16_t next_pattern_index = -1;
+            if(row.data < song->order_list_size) {
+                song_state->order_list_index = row.data;
+                next_pattern_index = song->order_list[song_state->order_list_index];
+            }
 
             advance_to_pattern(
                 tracker,
@@ -241,21 +244,26 @@ static void tracker_interrupt_body(Tracker* tracker) {
 
             invalidate_row = true;
         }
+    }
 
-        // tracker state can be affected by effects
-        if(!tracker->playing) {
-            tracker_speaker_stop();
-            return;
-        }
-
-        if(invalidate_row) {
-            row = get_current_row(song, song_state, channel_index);
+    // tracker state can be affected by effects
+    if(!tracker->playing) return;
 
-            if(row.effect == EffectSetSpeed) {
-                song_state->tick_limit = row.data;
-            }
+    for(uint8_t i = 0; i < song->channels_count; i++) {
+        UnpackedRow row = get_current_row(song, song_state, i);
+        if(row.effect == EffectSetSpeed) {
+            song_state->tick_limit = row.data + 1;
         }
+    }
+}
+
+static void tracker_channel_tick(Tracker* tracker, uint8_t channel_index) {
+    SongState* song_state = &tracker->song_state;
+    ChannelState* channel_state = &song_state->channels[channel_index];
+    UnpackedRow row = get_current_row(tracker->song, song_state, channel_index);
 
+    // load frequency from note at tick 0
+    if(song_state->tick == 0) {
         // handle note effects
         if(row.note == NOTE_OFF) {
             channel_state->play = false;
@@ -349,9 +357,22 @@ static void tracker_interrupt_body(Tracker* tracker) {
             pwm = (pwm - PWM_MIN) / EFFECT_DATA_1_MAX * row.data + PWM_MIN;
         }
 
-        tracker_speaker_play(frequency, pwm);
-    } else {
-        tracker_speaker_stop();
+        channel_state->output_frequency = frequency;
+        channel_state->output_pwm = pwm;
+    }
+}
+
+static void tracker_tick(Tracker* tracker) {
+    SongState* song_state = &tracker->song_state;
+    const Song* song = tracker->song;
+
+    if(song_state->tick == 0) {
+        tracker_apply_first_tick_effects(tracker);
+        if(!tracker->playing) return;
+    }
+
+    for(uint8_t i = 0; i < song->channels_count; i++) {
+        tracker_channel_tick(tracker, i);
     }
 
     song_state->tick++;
@@ -376,11 +397,55 @@ static void tracker_interrupt_body(Tracker* tracker) {
     }
 }
 
-static void tracker_interrupt_cb(void* context) {
-    Tracker* tracker = (Tracker*)context;
-    tracker_debug_set(true);
-    tracker_interrupt_body(tracker);
-    tracker_debug_set(false);
+static uint8_t tracker_next_voice(Tracker* tracker) {
+    SongState* song_state = &tracker->song_state;
+    const uint8_t channels_count = tracker->song->channels_count;
+
+    // round robin over playing channels, so each one gets the speaker in turn
+    for(uint8_t i = 1; i <= channels_count; i++) {
+        uint8_t channel = (song_state->voice + i) % channels_count;
+        if(song_state->channels[channel].play) {
+            song_state->voice = channel;
+            return channel;
+        }
+    }
+
+    return TRACKER_CHANNEL_NONE;
+}
+
+static void tracker_output(Tracker* tracker, uint8_t channel) {
+    if(tracker->output_callback == NULL) return;
+
+    if(channel == TRACKER_CHANNEL_NONE) {
+        tracker->output_callback(TRACKER_CHANNEL_NONE, 0, 0, tracker->output_context);
+    } else {
+        const ChannelState* channel_state = &tracker->song_state.channels[channel];
+        tracker->output_callback(
+            channel,
+            channel_state->output_frequency,
+            channel_state->output_pwm,
+            tracker->output_context);
+    }
+}
+
+void tracker_advance(Tracker* tracker) {
+    SongState* song_state = &tracker->song_state;
+
+    if(tracker->playing && song_state->slice == 0) {
+        tracker_tick(tracker);
+    }
+
+    if(!tracker->playing) {
+        tracker_output(tracker, TRACKER_CHANNEL_NONE);
+        return;
+    }
+
+    tracker_output(tracker, tracker_next_voice(tracker));
+
+    song_state->slice++;
+    if(song_state->slice >= tracker->song->channels_count) {
+        song_state->slice = 0;
+    }
 }
 
 /*********************************************************************
@@ -422,20 +487,27 @@ void tracker_set_row(Tracker* tracker, uint8_t row) {
     tracker->song_state.row_index = row;
 }
 
-void tracker_start(Tracker* tracker) {
+void tracker_set_output_callback(
+    Tracker* tracker,
+    TrackerOutputCallback callback,
+    void* context) {
+    furi_check(tracker->playing == false);
+    tracker->output_callback = callback;
+    tracker->output_context = context;
+}
+
+float tracker_get_advance_rate(Tracker* tracker) {
+    furi_check(tracker->song != NULL);
+    return (float)tracker->song->ticks_per_second * tracker->song->channels_count;
+}
+
+void tracker_playing_start(Tracker* tracker) {
     furi_check(tracker->song != NULL);
 
     tracker->playing = true;
     tracker_send_position_message(tracker);
-    tracker_debug_init();
-    tracker_speaker_init();
-    tracker_interrupt_init(tracker->song->ticks_per_second, tracker_interrupt_cb, tracker);
 }
 
-void tracker_stop(Tracker* tracker) {
-    tracker_interrupt_deinit();
-    tracker_speaker_deinit();
-    tracker_debug_deinit();
-
+void tracker_playing_stop(Tracker* tracker) {
     tracker->playing = false;
-}
\ No newline at end of file
+}
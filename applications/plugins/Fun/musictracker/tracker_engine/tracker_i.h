@@ -0,0 +1,36 @@
+#pragma once
+#include "tracker.h"
+
+/** Channel value for silence in TrackerOutputCallback */
+#define TRACKER_CHANNEL_NONE 0xFF
+
+/** Output callback, called on every tracker_advance
+ *
+ * @param      channel    channel that owns the slice, TRACKER_CHANNEL_NONE if silent
+ * @param      frequency  frequency, Hz
+ * @param      pwm        pwm, PWM_MIN..PWM_MAX
+ */
+typedef void (*TrackerOutputCallback)(uint8_t channel, float frequency, float pwm, void* context);
+
+void tracker_set_output_callback(Tracker* tracker, TrackerOutputCallback callback, void* context);
+
+/** Get rate at which tracker_advance must be called
+ *
+ * Every tick is split into one slice per channel, playing channels share the
+ * speaker in turns, arpeggio style.
+ *
+ * @return     rate, Hz
+ */
+float tracker_get_advance_rate(Tracker* tracker);
+
+/** Mark tracker as playing, hardware is not touched */
+void tracker_playing_start(Tracker* tracker);
+
+/** Mark tracker as stopped, hardware is not touched */
+void tracker_playing_stop(Tracker* tracker);
+
+/** Play one slice, processes a tick when a new one starts
+ *
+ * Deterministic, depends only on the song and tracker state.
+ */
+void tracker_advance(Tracker* tracker);
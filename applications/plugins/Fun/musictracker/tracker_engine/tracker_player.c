@@ -0,0 +1,35 @@
+#include "tracker_i.h"
+#include <furi.h>
+#include "speaker_hal.h"
+
+static void tracker_speaker_output(uint8_t channel, float frequency, float pwm, void* context) {
+    UNUSED(context);
+    if(channel == TRACKER_CHANNEL_NONE) {
+        tracker_speaker_stop();
+    } else {
+        tracker_speaker_play(frequency, pwm);
+    }
+}
+
+static void tracker_interrupt_cb(void* context) {
+    Tracker* tracker = (Tracker*)context;
+    tracker_debug_set(true);
+    tracker_advance(tracker);
+    tracker_debug_set(false);
+}
+
+void tracker_start(Tracker* tracker) {
+    tracker_set_output_callback(tracker, tracker_speaker_output, NULL);
+    tracker_playing_start(tracker);
+    tracker_debug_init();
+    tracker_speaker_init();
+    tracker_interrupt_init(tracker_get_advance_rate(tracker), tracker_interrupt_cb, tracker);
+}
+
+void tracker_stop(Tracker* tracker) {
+    tracker_interrupt_deinit();
+    tracker_speaker_deinit();
+    tracker_debug_deinit();
+
+    tracker_playing_stop(tracker);
+}
@@ -88,6 +88,8 @@ typedef enum {
 
 #define PATTERN_SIZE 64
 
+#define TRACKER_CHANNELS_MAX 4
+
 #define ROW_MAKE(note, effect, data) \
     ((Row)(((note)&0x3F) | (((effect)&0xF) << 6) | (((data)&0x3F) << 10)))
 
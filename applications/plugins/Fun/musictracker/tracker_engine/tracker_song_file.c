@@ -0,0 +1,260 @@
+#include "tracker_song_file.h"
+#include <furi.h>
+
+#define TAG "TrackerSongFile"
+
+#define TRACKER_SONG_FILE_MAGIC "FZTS"
+#define TRACKER_SONG_FILE_MAGIC_SIZE 4
+#define TRACKER_SONG_FILE_HEADER_SIZE 10
+
+#define TRACKER_SONG_CHANNEL_SIZE_MAX (PATTERN_SIZE * sizeof(Row))
+
+static void tracker_song_pattern_init(const Song* song, Pattern* pattern) {
+    pattern->channels = malloc(sizeof(Channel) * song->channels_count);
+}
+
+Song* tracker_song_alloc(uint8_t channels_count, uint16_t ticks_per_second) {
+    furi_check(channels_count > 0 && channels_count <= TRACKER_CHANNELS_MAX);
+    furi_check(ticks_per_second > 0 && ticks_per_second <= TRACKER_TICKS_PER_SECOND_MAX);
+
+    Song* song = malloc(sizeof(Song));
+    song->channels_count = channels_count;
+    song->ticks_per_second = ticks_per_second;
+    song->patterns_count = 1;
+    song->patterns = malloc(sizeof(Pattern));
+    tracker_song_pattern_init(song, &song->patterns[0]);
+    song->order_list_size = 1;
+    song->order_list = malloc(sizeof(uint8_t));
+    song->order_list[0] = 0;
+    return song;
+}
+
+void tracker_song_free(Song* song) {
+    furi_check(song);
+    for(uint8_t i = 0; i < song->patterns_count; i++) {
+        free(song->patterns[i].channels);
+    }
+    free(song->patterns);
+    free(song->order_list);
+    free(song);
+}
+
+bool tracker_song_add_pattern(Song* song) {
+    furi_check(song);
+    if(song->patterns_count == UINT8_MAX) return false;
+
+    song->patterns = realloc(song->patterns, sizeof(Pattern) * (song->patterns_count + 1));
+    tracker_song_pattern_init(song, &song->patterns[song->patterns_count]);
+    song->patterns_count++;
+    return true;
+}
+
+bool tracker_song_insert_order(Song* song, uint8_t index, uint8_t pattern) {
+    furi_check(song);
+    furi_check(index <= song->order_list_size);
+    furi_check(pattern < song->patterns_count);
+    if(song->order_list_size == UINT8_MAX) return false;
+
+    song->order_list = realloc(song->order_list, song->order_list_size + 1);
+    memmove(
+        &song->order_list[index + 1],
+        &song->order_list[index],
+        song->order_list_size - index);
+    song->order_list[index] = pattern;
+    song->order_list_size++;
+    return true;
+}
+
+bool tracker_song_remove_order(Song* song, uint8_t index) {
+    furi_check(song);
+    furi_check(index < song->order_list_size);
+    if(song->order_list_size == 1) return false;
+
+    memmove(
+        &song->order_list[index],
+        &song->order_list[index + 1],
+        song->order_list_size - index - 1);
+    song->order_list_size--;
+    return true;
+}
+
+static bool tracker_song_decode_channel(
+    Channel* channel,
+    TrackerSongReadCallback read,
+    void* context) {
+    uint8_t row_index = 0;
+    while(row_index < PATTERN_SIZE) {
+        uint8_t data[sizeof(Row)];
+        if(!read(context, data, sizeof(data))) return false;
+
+        const Row row = data[0] | (data[1] << 8);
+        if((row & ROW_NOTE_MASK) != TRACKER_SONG_FILE_NOTE_RUN) {
+            channel->rows[row_index++] = row;
+            continue;
+        }
+
+        // Rows are zeroed on allocation, runs only move the position
+        const uint8_t run = ((row >> 10) & ROW_EFFECT_DATA_MASK) + 1;
+        if(run > PATTERN_SIZE - row_index) return false;
+        row_index += run;
+    }
+    return true;
+}
+
+Song* tracker_song_decode(TrackerSongReadCallback read, void* context) {
+    furi_check(read);
+
+    uint8_t header[TRACKER_SONG_FILE_HEADER_SIZE];
+    if(!read(context, header, sizeof(header))) return NULL;
+
+    const uint8_t channels_count = header[5];
+    const uint8_t patterns_count = header[6];
+    const uint8_t order_list_size = header[7];
+    const uint16_t ticks_per_second = header[8] | (header[9] << 8);
+
+    if(memcmp(header, TRACKER_SONG_FILE_MAGIC, TRACKER_SONG_FILE_MAGIC_SIZE) != 0 ||
+       header[4] != TRACKER_SONG_FILE_VERSION) {
+        FURI_LOG_E(TAG, "Unknown format");
+        return NULL;
+    }
+
+    if(channels_count == 0 || channels_count > TRACKER_CHANNELS_MAX || patterns_count == 0 ||
+       order_list_size == 0 || ticks_per_second == 0 ||
+       ticks_per_second > TRACKER_TICKS_PER_SECOND_MAX) {
+        FURI_LOG_E(TAG, "Invalid header");
+        return NULL;
+    }
+
+    Song* song = tracker_song_alloc(channels_count, ticks_per_second);
+    bool success = false;
+
+    do {
+        while(song->patterns_count < patterns_count) {
+            tracker_song_add_pattern(song);
+        }
+
+        song->order_list = realloc(song->order_list, order_list_size);
+        song->order_list_size = order_list_size;
+        if(!read(context, song->order_list, order_list_size)) break;
+
+        uint8_t order;
+        for(order = 0; order < order_list_size; order++) {
+            if(song->order_list[order] >= patterns_count) break;
+        }
+        if(order < order_list_size) {
+            FURI_LOG_E(TAG, "Invalid order list");
+            break;
+        }
+
+        success = true;
+        for(uint8_t pattern = 0; success && pattern < patterns_count; pattern++) {
+            for(uint8_t channel = 0; success && channel < channels_count; channel++) {
+                success = tracker_song_decode_channel(
+                    &song->patterns[pattern].channels[channel], read, context);
+            }
+        }
+        if(!success) FURI_LOG_E(TAG, "Invalid pattern data");
+    } while(false);
+
+    if(!success) {
+        tracker_song_free(song);
+        song = NULL;
+    }
+
+    return song;
+}
+
+static size_t tracker_song_encode_channel(const Channel* channel, uint8_t* data) {
+    size_t size = 0;
+    uint8_t row_index = 0;
+    while(row_index < PATTERN_SIZE) {
+        Row row = channel->rows[row_index];
+
+        if(row == 0) {
+            uint8_t run = 0;
+            while(row_index < PATTERN_SIZE && channel->rows[row_index] == 0) {
+                row_index++;
+                run++;
+            }
+            row = ROW_MAKE(TRACKER_SONG_FILE_NOTE_RUN, 0, run - 1);
+        } else {
+            // Unused note does nothing on playback, same as no note
+            if((row & ROW_NOTE_MASK) == TRACKER_SONG_FILE_NOTE_RUN) row &= ~ROW_NOTE_MASK;
+            row_index++;
+        }
+
+        data[size++] = row & 0xFF;
+        data[size++] = row >> 8;
+    }
+    return size;
+}
+
+bool tracker_song_encode(const Song* song, TrackerSongWriteCallback write, void* context) {
+    furi_check(song);
+    furi_check(write);
+
+    uint8_t header[TRACKER_SONG_FILE_HEADER_SIZE];
+    memcpy(header, TRACKER_SONG_FILE_MAGIC, TRACKER_SONG_FILE_MAGIC_SIZE);
+    header[4] = TRACKER_SONG_FILE_VERSION;
+    header[5] = song->channels_count;
+    header[6] = song->patterns_count;
+    header[7] = song->order_list_size;
+    header[8] = song->ticks_per_second & 0xFF;
+    header[9] = song->ticks_per_second >> 8;
+
+    if(!write(context, header, sizeof(header))) return false;
+    if(!write(context, song->order_list, song->order_list_size)) return false;
+
+    uint8_t data[TRACKER_SONG_CHANNEL_SIZE_MAX];
+    for(uint8_t pattern = 0; pattern < song->patterns_count; pattern++) {
+        for(uint8_t channel = 0; channel < song->channels_count; channel++) {
+            size_t size =
+                tracker_song_encode_channel(&song->patterns[pattern].channels[channel], data);
+            if(!write(context, data, size)) return false;
+        }
+    }
+
+    return true;
+}
+
+static bool tracker_song_file_read(void* context, uint8_t* data, size_t size) {
+    return storage_file_read(context, data, size) == size;
+}
+
+static bool tracker_song_file_write(void* context, const uint8_t* data, size_t size) {
+    return storage_file_write(context, data, size) == size;
+}
+
+Song* tracker_song_load(Storage* storage, const char* path) {
+    furi_check(storage);
+    furi_check(path);
+
+    Song* song = NULL;
+    File* file = storage_file_alloc(storage);
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        song = tracker_song_decode(tracker_song_file_read, file);
+    } else {
+        FURI_LOG_E(TAG, "Unable to open %s", path);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+
+    return song;
+}
+
+bool tracker_song_save(const Song* song, Storage* storage, const char* path) {
+    furi_check(song);
+    furi_check(storage);
+    furi_check(path);
+
+    bool success = false;
+    File* file = storage_file_alloc(storage);
+    if(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        success = tracker_song_encode(song, tracker_song_file_write, file);
+    }
+    if(!success) FURI_LOG_E(TAG, "Unable to save %s", path);
+    storage_file_close(file);
+    storage_file_free(file);
+
+    return success;
+}
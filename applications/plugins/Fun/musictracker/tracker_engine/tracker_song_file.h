@@ -0,0 +1,125 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <storage/storage.h>
+#include "tracker_song.h"
+
+/**
+ * @brief Song file
+ *
+ * All values are little endian.
+ *
+ * Offset Size  Description
+ * 0      4     magic "FZTS"
+ * 4      1     version, TRACKER_SONG_FILE_VERSION
+ * 5      1     channels count, 1..TRACKER_CHANNELS_MAX
+ * 6      1     patterns count, 1..255
+ * 7      1     order list size, 1..255
+ * 8      2     ticks per second, 1..TRACKER_TICKS_PER_SECOND_MAX
+ * 10     n     order list, pattern index for every order
+ * 10+n   ...   patterns, every pattern is channels count of channels
+ *
+ * Channel is PATTERN_SIZE rows, every row is stored as 2 bytes.
+ * Runs of empty rows are stored as a single row with the unused note
+ * TRACKER_SONG_FILE_NOTE_RUN and the run length minus one in effect data,
+ * so a channel never takes more than its raw size.
+ */
+
+#define TRACKER_SONG_FILE_EXTENSION ".fzt"
+#define TRACKER_SONG_FILE_VERSION 1
+#define TRACKER_TICKS_PER_SECOND_MAX 1000
+#define TRACKER_SONG_FILE_NOTE_RUN 62
+
+/** Read exactly size bytes
+ *
+ * @return     true on success
+ */
+typedef bool (*TrackerSongReadCallback)(void* context, uint8_t* data, size_t size);
+
+/** Write exactly size bytes
+ *
+ * @return     true on success
+ */
+typedef bool (*TrackerSongWriteCallback)(void* context, const uint8_t* data, size_t size);
+
+/** Allocate empty song with one pattern in the order list
+ *
+ * @param      channels_count    1..TRACKER_CHANNELS_MAX
+ * @param      ticks_per_second  1..TRACKER_TICKS_PER_SECOND_MAX
+ *
+ * @return     Song instance, free with tracker_song_free
+ */
+Song* tracker_song_alloc(uint8_t channels_count, uint16_t ticks_per_second);
+
+/** Free song allocated by tracker_song_alloc or tracker_song_decode
+ *
+ * @param      song  Song instance
+ */
+void tracker_song_free(Song* song);
+
+/** Append empty pattern
+ *
+ * @param      song  Song instance
+ *
+ * @return     false if the song already has 255 patterns
+ */
+bool tracker_song_add_pattern(Song* song);
+
+/** Insert pattern into the order list
+ *
+ * @param      song     Song instance
+ * @param      index    order list index, up to order list size
+ * @param      pattern  pattern index
+ *
+ * @return     false if the order list is full
+ */
+bool tracker_song_insert_order(Song* song, uint8_t index, uint8_t pattern);
+
+/** Remove entry from the order list
+ *
+ * @param      song   Song instance
+ * @param      index  order list index
+ *
+ * @return     false if it is the last entry
+ */
+bool tracker_song_remove_order(Song* song, uint8_t index);
+
+/** Decode song
+ *
+ * Malformed data is rejected, so any decoded song is safe to play.
+ *
+ * @param      read     read callback
+ * @param      context  read callback context
+ *
+ * @return     Song instance or NULL
+ */
+Song* tracker_song_decode(TrackerSongReadCallback read, void* context);
+
+/** Encode song
+ *
+ * @param      song     Song instance
+ * @param      write    write callback
+ * @param      context  write callback context
+ *
+ * @return     true on success
+ */
+bool tracker_song_encode(const Song* song, TrackerSongWriteCallback write, void* context);
+
+/** Load song file
+ *
+ * @param      storage  Storage instance
+ * @param      path     file path
+ *
+ * @return     Song instance or NULL
+ */
+Song* tracker_song_load(Storage* storage, const char* path);
+
+/** Save song file
+ *
+ * @param      song     Song instance
+ * @param      storage  Storage instance
+ * @param      path     file path, overwritten
+ *
+ * @return     true on success
+ */
+bool tracker_song_save(const Song* song, Storage* storage, const char* path);
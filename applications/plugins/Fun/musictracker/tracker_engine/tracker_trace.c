@@ -0,0 +1,78 @@
+#include "tracker_trace.h"
+#include "tracker_i.h"
+
+typedef struct {
+    FuriString* output;
+    size_t slice;
+    bool end;
+    uint8_t channel;
+    int32_t frequency;
+    int32_t pwm;
+} TrackerTrace;
+
+static void tracker_trace_message(TrackerMessage message, void* context) {
+    TrackerTrace* trace = context;
+    if(message.type == TrackerPositionChanged) {
+        furi_string_cat_printf(
+            trace->output,
+            "%06zu pos %02X:%02X\n",
+            trace->slice,
+            message.data.position.order_list_index,
+            message.data.position.row);
+    } else if(message.type == TrackerEndOfSong) {
+        furi_string_cat_printf(trace->output, "%06zu end\n", trace->slice);
+        trace->end = true;
+    }
+}
+
+static void tracker_trace_output(uint8_t channel, float frequency, float pwm, void* context) {
+    TrackerTrace* trace = context;
+
+    // fixed point, so the trace does not depend on float formatting
+    const int32_t trace_frequency = (int32_t)(frequency * 100.0f + 0.5f);
+    const int32_t trace_pwm = (int32_t)(pwm * 1000.0f + 0.5f);
+
+    if(channel == trace->channel && trace_frequency == trace->frequency &&
+       trace_pwm == trace->pwm) {
+        return;
+    }
+
+    trace->channel = channel;
+    trace->frequency = trace_frequency;
+    trace->pwm = trace_pwm;
+
+    if(channel == TRACKER_CHANNEL_NONE) {
+        furi_string_cat_printf(trace->output, "%06zu off\n", trace->slice);
+    } else {
+        furi_string_cat_printf(
+            trace->output,
+            "%06zu ch%u %ld %ld\n",
+            trace->slice,
+            channel,
+            (long)trace_frequency,
+            (long)trace_pwm);
+    }
+}
+
+void tracker_trace_render(const Song* song, size_t slices_max, FuriString* output) {
+    furi_check(song);
+    furi_check(output);
+
+    TrackerTrace trace = {
+        .output = output,
+        .channel = TRACKER_CHANNEL_NONE,
+    };
+
+    Tracker* tracker = tracker_alloc();
+    tracker_set_message_callback(tracker, tracker_trace_message, &trace);
+    tracker_set_output_callback(tracker, tracker_trace_output, &trace);
+    tracker_set_song(tracker, song);
+    tracker_playing_start(tracker);
+
+    for(; trace.slice < slices_max && !trace.end; trace.slice++) {
+        tracker_advance(tracker);
+    }
+
+    tracker_playing_stop(tracker);
+    tracker_free(tracker);
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <furi.h>
+#include "tracker_song.h"
+
+/** Render song to a text trace, no hardware is used
+ *
+ * One line per event, prefixed with the slice number:
+ * "pos OO:RR" on position change, "end" on end of song,
+ * "chN F P" when channel N takes the speaker with frequency F (centi-Hz) and pwm P (per mille),
+ * "off" when the speaker goes silent. Output lines are only written on change.
+ *
+ * @param      song        Song to render
+ * @param      slices_max  render limit, in slices
+ * @param      output      trace output
+ */
+void tracker_trace_render(const Song* song, size_t slices_max, FuriString* output);
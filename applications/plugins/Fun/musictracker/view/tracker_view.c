@@ -1,24 +1,45 @@
 #include "tracker_view.h"
+#include "../tracker_engine/tracker_song_file.h"
 #include <gui/elements.h>
 #include <furi.h>
 
+#define TRACKER_VIEW_ROWS 10
+
+typedef enum {
+    TrackerViewFieldNote,
+    TrackerViewFieldEffect,
+    TrackerViewFieldData,
+    TrackerViewFieldChannel,
+    TrackerViewFieldOrder,
+    TrackerViewFieldPattern,
+
+    TrackerViewFieldCount,
+} TrackerViewField;
+
+static const char tracker_view_field_names[TrackerViewFieldCount] = {'N', 'E', 'D', 'C', 'O', 'P'};
+
 typedef struct {
-    const Song* song;
+    Song* song;
     uint8_t order_list_index;
     uint8_t row;
+    uint8_t channel;
+    TrackerViewField field;
+    bool playing;
+    bool modified;
 } TrackerViewModel;
 
 struct TrackerView {
     View* view;
     void* back_context;
     TrackerViewCallback back_callback;
+    void* play_context;
+    TrackerViewCallback play_callback;
 };
 
 static Channel* get_current_channel(TrackerViewModel* model) {
-    uint8_t channel_id = 0;
     uint8_t pattern_id = model->song->order_list[model->order_list_index];
     Pattern* pattern = &model->song->patterns[pattern_id];
-    return &pattern->channels[channel_id];
+    return &pattern->channels[model->channel];
 }
 
 static const char* get_note_from_id(uint8_t note) {
@@ -46,16 +67,16 @@ static uint8_t get_octave_from_id(uint8_t note) {
 }
 
 static uint8_t get_first_row_id(uint8_t row) {
-    return (row / 10) * 10;
+    return (row / TRACKER_VIEW_ROWS) * TRACKER_VIEW_ROWS;
 }
 
 static void
     draw_row(Canvas* canvas, uint8_t i, Channel* channel, uint8_t row, FuriString* buffer) {
-    uint8_t x = 12 * (i + 1);
+    uint8_t x = 11 * (i + 1);
     uint8_t first_row_id = get_first_row_id(row);
     uint8_t current_row_id = first_row_id + i;
 
-    if((current_row_id) >= 64) {
+    if((current_row_id) >= PATTERN_SIZE) {
         return;
     }
 
@@ -120,12 +141,103 @@ static void tracker_view_draw_callback(Canvas* canvas, void* _model) {
     Channel* channel = get_current_channel(model);
     FuriString* buffer = furi_string_alloc();
 
-    for(uint8_t i = 0; i < 10; i++) {
+    for(uint8_t i = 0; i < TRACKER_VIEW_ROWS; i++) {
         draw_row(canvas, i, channel, model->row, buffer);
     }
+
+    // status: play state, channel, order:pattern and the edited field
+    furi_string_printf(
+        buffer,
+        "%c%u %02X:%02X %c",
+        model->playing ? '>' : ' ',
+        model->channel + 1,
+        model->order_list_index,
+        model->song->order_list[model->order_list_index],
+        tracker_view_field_names[model->field]);
+    canvas_draw_str(canvas, 125, 61, furi_string_get_cstr(buffer));
+
     furi_string_free(buffer);
 }
 
+static uint8_t tracker_view_step(uint8_t value, int8_t delta, uint8_t count) {
+    return (value + count + delta) % count;
+}
+
+static uint8_t tracker_view_step_note(uint8_t note, int8_t delta) {
+    // NOTE_NONE, NOTE_C2..NOTE_B6, NOTE_OFF
+    uint8_t index = (note == NOTE_OFF) ? NOTE_B6 + 1 : note;
+    index = tracker_view_step(index, delta, NOTE_B6 + 2);
+    return (index == NOTE_B6 + 1) ? NOTE_OFF : index;
+}
+
+static void tracker_view_edit_row(TrackerViewModel* model, int8_t delta) {
+    Row* row = &get_current_channel(model)->rows[model->row];
+    uint8_t note = *row & ROW_NOTE_MASK;
+    uint8_t effect = (*row >> 6) & ROW_EFFECT_MASK;
+    uint8_t data = (*row >> 10) & ROW_EFFECT_DATA_MASK;
+
+    if(model->field == TrackerViewFieldNote) {
+        note = tracker_view_step_note(note, delta);
+    } else if(model->field == TrackerViewFieldEffect) {
+        effect = tracker_view_step(effect, delta, ROW_EFFECT_MASK + 1);
+    } else {
+        data = tracker_view_step(data, delta, ROW_EFFECT_DATA_MASK + 1);
+    }
+
+    *row = ROW_MAKE(note, effect, data);
+}
+
+static bool tracker_view_edit(TrackerViewModel* model, InputEvent* event) {
+    Song* song = model->song;
+    const int8_t delta = (event->key == InputKeyUp) ? 1 : -1;
+
+    // channel can be switched while playing, the rest changes the song
+    if(model->field == TrackerViewFieldChannel) {
+        if(event->type != InputTypeShort) return false;
+        model->channel = tracker_view_step(model->channel, delta, song->channels_count);
+        return false;
+    } else if(model->playing) {
+        return false;
+    }
+
+    if(event->type == InputTypeLong) {
+        if(model->field != TrackerViewFieldOrder) return false;
+        if(event->key == InputKeyUp) {
+            uint8_t pattern = song->order_list[model->order_list_index];
+            if(!tracker_song_insert_order(song, model->order_list_index + 1, pattern)) {
+                return false;
+            }
+            model->order_list_index++;
+        } else {
+            if(!tracker_song_remove_order(song, model->order_list_index)) return false;
+            if(model->order_list_index >= song->order_list_size) model->order_list_index--;
+        }
+        return true;
+    }
+
+    // repeat only steps row values
+    if(event->type == InputTypeRepeat && model->field >= TrackerViewFieldChannel) return false;
+
+    if(model->field == TrackerViewFieldOrder) {
+        model->order_list_index =
+            tracker_view_step(model->order_list_index, delta, song->order_list_size);
+        return false;
+    } else if(model->field == TrackerViewFieldPattern) {
+        uint8_t* pattern = &song->order_list[model->order_list_index];
+        // stepping past the last pattern creates a new one
+        if(delta > 0 && *pattern == song->patterns_count - 1) {
+            if(!tracker_song_add_pattern(song)) return false;
+            *pattern = song->patterns_count - 1;
+        } else {
+            *pattern = tracker_view_step(*pattern, delta, song->patterns_count);
+        }
+        return true;
+    }
+
+    tracker_view_edit_row(model, delta);
+    return true;
+}
+
 static bool tracker_view_input_callback(InputEvent* event, void* context) {
     TrackerView* tracker_view = context;
 
@@ -135,7 +247,41 @@ static bool tracker_view_input_callback(InputEvent* event, void* context) {
             return true;
         }
     }
-    return false;
+
+    if(tracker_view->play_callback) {
+        if(event->type == InputTypeShort && event->key == InputKeyOk) {
+            tracker_view->play_callback(tracker_view->play_context);
+            return true;
+        }
+    }
+
+    bool consumed = false;
+    with_view_model(
+        tracker_view->view,
+        TrackerViewModel * model,
+        {
+            if(model->song == NULL) {
+                // nothing to edit
+            } else if(event->type == InputTypeLong && event->key == InputKeyOk) {
+                model->field = tracker_view_step(model->field, 1, TrackerViewFieldCount);
+                consumed = true;
+            } else if(event->key == InputKeyUp || event->key == InputKeyDown) {
+                if(event->type != InputTypeRelease && event->type != InputTypePress) {
+                    if(tracker_view_edit(model, event)) model->modified = true;
+                    consumed = true;
+                }
+            } else if(event->key == InputKeyLeft || event->key == InputKeyRight) {
+                if(!model->playing &&
+                   (event->type == InputTypeShort || event->type == InputTypeRepeat)) {
+                    int8_t delta = (event->key == InputKeyRight) ? 1 : -1;
+                    model->row = tracker_view_step(model->row, delta, PATTERN_SIZE);
+                    consumed = true;
+                }
+            }
+        },
+        consumed);
+
+    return consumed;
 }
 
 TrackerView* tracker_view_alloc() {
@@ -165,9 +311,52 @@ void tracker_view_set_back_callback(
     tracker_view->back_context = context;
 }
 
-void tracker_view_set_song(TrackerView* tracker_view, const Song* song) {
+void tracker_view_set_play_callback(
+    TrackerView* tracker_view,
+    TrackerViewCallback callback,
+    void* context) {
+    tracker_view->play_callback = callback;
+    tracker_view->play_context = context;
+}
+
+void tracker_view_set_song(TrackerView* tracker_view, Song* song) {
+    with_view_model(
+        tracker_view->view,
+        TrackerViewModel * model,
+        {
+            model->song = song;
+            model->order_list_index = 0;
+            model->row = 0;
+            model->channel = 0;
+            model->modified = false;
+        },
+        true);
+}
+
+void tracker_view_set_playing(TrackerView* tracker_view, bool playing) {
+    with_view_model(
+        tracker_view->view, TrackerViewModel * model, { model->playing = playing; }, true);
+}
+
+void tracker_view_get_position(
+    TrackerView* tracker_view,
+    uint8_t* order_list_index,
+    uint8_t* row) {
+    with_view_model(
+        tracker_view->view,
+        TrackerViewModel * model,
+        {
+            *order_list_index = model->order_list_index;
+            *row = model->row;
+        },
+        false);
+}
+
+bool tracker_view_is_modified(TrackerView* tracker_view) {
+    bool modified = false;
     with_view_model(
-        tracker_view->view, TrackerViewModel * model, { model->song = song; }, true);
+        tracker_view->view, TrackerViewModel * model, { modified = model->modified; }, false);
+    return modified;
 }
 
 void tracker_view_set_position(TrackerView* tracker_view, uint8_t order_list_index, uint8_t row) {
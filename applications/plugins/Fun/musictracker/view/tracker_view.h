@@ -20,7 +20,26 @@ void tracker_view_set_back_callback(
     TrackerViewCallback callback,
     void* context);
 
-void tracker_view_set_song(TrackerView* tracker_view, const Song* song);
+/** Set play callback, called on OK press */
+void tracker_view_set_play_callback(
+    TrackerView* tracker_view,
+    TrackerViewCallback callback,
+    void* context);
+
+/** Set song to show and edit, song is edited in place while not playing */
+void tracker_view_set_song(TrackerView* tracker_view, Song* song);
+
+/** Set playing state, editing is locked while playing */
+void tracker_view_set_playing(TrackerView* tracker_view, bool playing);
+
+/** Get cursor position, playback starts from it */
+void tracker_view_get_position(
+    TrackerView* tracker_view,
+    uint8_t* order_list_index,
+    uint8_t* row);
+
+/** Check if song was edited since tracker_view_set_song */
+bool tracker_view_is_modified(TrackerView* tracker_view);
 
 void tracker_view_set_position(TrackerView* tracker_view, uint8_t order_list_index, uint8_t row);
 
@@ -1,11 +1,19 @@
 #include <furi.h>
 #include <gui/gui.h>
 #include <gui/view_dispatcher.h>
+#include <dialogs/dialogs.h>
 #include <notification/notification_messages.h>
 #include "zero_tracker.h"
 #include "tracker_engine/tracker.h"
+#include "tracker_engine/tracker_song_file.h"
 #include "view/tracker_view.h"
 
+#define TAG "Tracker"
+
+#define ZERO_TRACKER_APP_PATH_FOLDER EXT_PATH("apps_data/zero_tracker")
+#define ZERO_TRACKER_DEMO_SONG_PATH \
+    ZERO_TRACKER_APP_PATH_FOLDER "/demo" TRACKER_SONG_FILE_EXTENSION
+
 // Channel p_0_channels[] = {
 //     {
 //         .rows =
@@ -463,7 +471,8 @@ uint8_t order_list[] = {
     3,
 };
 
-Song song = {
+// Built-in song, installed to the SD card as the demo song
+const Song demo_song = {
     .channels_count = 1,
     .patterns_count = sizeof(patterns) / sizeof(patterns[0]),
     .patterns = patterns,
@@ -474,63 +483,158 @@ Song song = {
     .ticks_per_second = 60,
 };
 
+typedef enum {
+    ZeroTrackerEventTypeTracker,
+    ZeroTrackerEventTypePlay,
+    ZeroTrackerEventTypeBack,
+} ZeroTrackerEventType;
+
+typedef struct {
+    ZeroTrackerEventType type;
+    TrackerMessage message;
+} ZeroTrackerEvent;
+
 void tracker_message(TrackerMessage message, void* context) {
     FuriMessageQueue* queue = context;
     furi_assert(queue);
-    furi_message_queue_put(queue, &message, 0);
+    ZeroTrackerEvent event = {.type = ZeroTrackerEventTypeTracker, .message = message};
+    furi_message_queue_put(queue, &event, 0);
+}
+
+static void zero_tracker_play_callback(void* context) {
+    ZeroTrackerEvent event = {.type = ZeroTrackerEventTypePlay};
+    furi_message_queue_put(context, &event, FuriWaitForever);
+}
+
+static void zero_tracker_back_callback(void* context) {
+    ZeroTrackerEvent event = {.type = ZeroTrackerEventTypeBack};
+    furi_message_queue_put(context, &event, FuriWaitForever);
+}
+
+static bool zero_tracker_select_song(FuriString* file_path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, EXT_PATH("apps_data"));
+    storage_simply_mkdir(storage, ZERO_TRACKER_APP_PATH_FOLDER);
+    if(!storage_file_exists(storage, ZERO_TRACKER_DEMO_SONG_PATH)) {
+        tracker_song_save(&demo_song, storage, ZERO_TRACKER_DEMO_SONG_PATH);
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    furi_string_set(file_path, ZERO_TRACKER_APP_PATH_FOLDER);
+
+    DialogsFileBrowserOptions browser_options;
+    dialog_file_browser_set_basic_options(&browser_options, TRACKER_SONG_FILE_EXTENSION, NULL);
+    browser_options.base_path = ZERO_TRACKER_APP_PATH_FOLDER;
+
+    DialogsApp* dialogs = furi_record_open(RECORD_DIALOGS);
+    bool res = dialog_file_browser_show(dialogs, file_path, file_path, &browser_options);
+    furi_record_close(RECORD_DIALOGS);
+
+    return res;
+}
+
+static void zero_tracker_stop(Tracker* tracker, TrackerView* tracker_view) {
+    tracker_stop(tracker);
+    tracker_view_set_playing(tracker_view, false);
 }
 
 int32_t zero_tracker_app(void* p) {
-    UNUSED(p);
+    FuriString* file_path = furi_string_alloc();
+    if(p && strlen(p)) {
+        furi_string_set(file_path, (const char*)p);
+    } else if(!zero_tracker_select_song(file_path)) {
+        FURI_LOG_E(TAG, "No file selected");
+        furi_string_free(file_path);
+        return 0;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Song* song = tracker_song_load(storage, furi_string_get_cstr(file_path));
+    if(song == NULL) {
+        FURI_LOG_E(TAG, "Unable to load %s", furi_string_get_cstr(file_path));
+        furi_record_close(RECORD_STORAGE);
+        furi_string_free(file_path);
+        return 0;
+    }
 
     NotificationApp* notification = furi_record_open(RECORD_NOTIFICATION);
     notification_message(notification, &sequence_display_backlight_enforce_on);
 
+    FuriMessageQueue* queue = furi_message_queue_alloc(8, sizeof(ZeroTrackerEvent));
+
     Gui* gui = furi_record_open(RECORD_GUI);
     ViewDispatcher* view_dispatcher = view_dispatcher_alloc();
     TrackerView* tracker_view = tracker_view_alloc();
-    tracker_view_set_song(tracker_view, &song);
+    tracker_view_set_song(tracker_view, song);
+    tracker_view_set_play_callback(tracker_view, zero_tracker_play_callback, queue);
+    tracker_view_set_back_callback(tracker_view, zero_tracker_back_callback, queue);
     view_dispatcher_add_view(view_dispatcher, 0, tracker_view_get_view(tracker_view));
     view_dispatcher_attach_to_gui(view_dispatcher, gui, ViewDispatcherTypeFullscreen);
     view_dispatcher_switch_to_view(view_dispatcher, 0);
 
-    FuriMessageQueue* queue = furi_message_queue_alloc(8, sizeof(TrackerMessage));
     Tracker* tracker = tracker_alloc();
     tracker_set_message_callback(tracker, tracker_message, queue);
-    tracker_set_song(tracker, &song);
-    tracker_start(tracker);
+    bool playing = false;
 
     while(1) {
-        TrackerMessage message;
-        FuriStatus status = furi_message_queue_get(queue, &message, portMAX_DELAY);
-        if(status == FuriStatusOk) {
-            if(message.type == TrackerPositionChanged) {
-                uint8_t order_list_index = message.data.position.order_list_index;
-                uint8_t row = message.data.position.row;
-                uint8_t pattern = song.order_list[order_list_index];
-                tracker_view_set_position(tracker_view, order_list_index, row);
-                FURI_LOG_I("Tracker", "O:%d P:%d R:%d", order_list_index, pattern, row);
-            } else if(message.type == TrackerEndOfSong) {
-                FURI_LOG_I("Tracker", "End of song");
-                break;
+        ZeroTrackerEvent event;
+        FuriStatus status = furi_message_queue_get(queue, &event, FuriWaitForever);
+        if(status != FuriStatusOk) continue;
+
+        if(event.type == ZeroTrackerEventTypeBack) {
+            break;
+        } else if(event.type == ZeroTrackerEventTypePlay) {
+            if(playing) {
+                zero_tracker_stop(tracker, tracker_view);
+            } else {
+                // song can be edited while stopped, state is rebuilt on every start
+                uint8_t order_list_index, row;
+                tracker_view_set_playing(tracker_view, true);
+                tracker_view_get_position(tracker_view, &order_list_index, &row);
+                tracker_set_song(tracker, song);
+                tracker_set_order_index(tracker, order_list_index);
+                tracker_set_row(tracker, row);
+                tracker_start(tracker);
             }
+            playing = !playing;
+        } else if(event.message.type == TrackerPositionChanged) {
+            uint8_t order_list_index = event.message.data.position.order_list_index;
+            uint8_t row = event.message.data.position.row;
+            uint8_t pattern = song->order_list[order_list_index];
+            tracker_view_set_position(tracker_view, order_list_index, row);
+            FURI_LOG_D(TAG, "O:%d P:%d R:%d", order_list_index, pattern, row);
+        } else if(event.message.type == TrackerEndOfSong && playing) {
+            FURI_LOG_I(TAG, "End of song");
+            zero_tracker_stop(tracker, tracker_view);
+            tracker_view_set_position(tracker_view, 0, 0);
+            playing = false;
         }
     }
 
-    tracker_stop(tracker);
+    if(playing) zero_tracker_stop(tracker, tracker_view);
     tracker_free(tracker);
-    furi_message_queue_free(queue);
 
-    furi_delay_ms(500);
+    if(tracker_view_is_modified(tracker_view)) {
+        if(tracker_song_save(song, storage, furi_string_get_cstr(file_path))) {
+            notification_message(notification, &sequence_success);
+        } else {
+            notification_message(notification, &sequence_error);
+        }
+    }
 
     view_dispatcher_remove_view(view_dispatcher, 0);
     tracker_view_free(tracker_view);
     view_dispatcher_free(view_dispatcher);
+    furi_message_queue_free(queue);
+
+    tracker_song_free(song);
+    furi_string_free(file_path);
 
     notification_message(notification, &sequence_display_backlight_enforce_auto);
 
     furi_record_close(RECORD_NOTIFICATION);
     furi_record_close(RECORD_GUI);
+    furi_record_close(RECORD_STORAGE);
 
     return 0;
-}
\ No newline at end of file
+}
@@ -3,33 +3,40 @@
 #include <gui/elements.h>
 #include <input/input.h>
 #include <notification/notification_messages.h>
+#include <storage/storage.h>
 #include <stdlib.h>
 #include <Password_Generator_icons.h>
 
-#define PASSGEN_MAX_LENGTH 16
-#define PASSGEN_CHARACTERS_LENGTH (26 * 4)
+#include "passgen_generator.h"
+#include "passgen_hid.h"
 
-#define PASSGEN_DIGITS "0123456789"
-#define PASSGEN_LETTERS_LOW "abcdefghijklmnopqrstuvwxyz"
-#define PASSGEN_LETTERS_UP "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-#define PASSGEN_SPECIAL "!#$%^&*.-_"
+#define PASSGEN_APP_DATA_PATH EXT_PATH("apps_data/passgen")
+
+#define PASSGEN_PASSPHRASE_SEPARATOR '-'
+#define PASSGEN_LINE_LENGTH 21
+#define PASSGEN_LINE_COUNT 4
 
 typedef enum PassGen_Alphabet {
-    Digits = 1,
-    Lowercase = 2,
+    Digits = PassGenClassDigits,
+    Lowercase = PassGenClassLower,
 
-    Uppercase = 4,
-    Special = 8,
+    Uppercase = PassGenClassUpper,
+    Special = PassGenClassSpecial,
 
     DigitsLower = Digits | Lowercase,
     DigitsAllLetters = Digits | Lowercase | Uppercase,
-    Mixed = DigitsAllLetters | Special
+    Mixed = DigitsAllLetters | Special,
+
+    // Passphrase from the word list
+    Words = 0,
 } PassGen_Alphabet;
 
-const int AlphabetLevels[] = {Digits, Lowercase, DigitsLower, DigitsAllLetters, Mixed};
-const char* AlphabetLevelNames[] = {"1234", "abcd", "ab12", "Ab12", "Ab1#"};
+const int AlphabetLevels[] = {Digits, Lowercase, DigitsLower, DigitsAllLetters, Mixed, Words};
+const char* AlphabetLevelNames[] = {"1234", "abcd", "ab12", "Ab12", "Ab1#", "Word"};
 const int AlphabetLevelsCount = sizeof(AlphabetLevels) / sizeof(int);
 
+const char* HidNames[PassGenHidCount] = {"USB", "BLE"};
+
 const NotificationSequence PassGen_Alert_vibro = {
     &message_vibro_on,
     &message_blue_255,
@@ -44,10 +51,15 @@ typedef struct {
     Gui* gui;
     FuriMutex** mutex;
     NotificationApp* notify;
+    PassGenWordList* word_list;
+    PassGenPolicy policy;
     char password[PASSGEN_MAX_LENGTH + 1];
-    char alphabet[PASSGEN_CHARACTERS_LENGTH + 1];
-    int length;
+    FuriString* passphrase;
+    int words;
     int level;
+    float entropy;
+    PassGenHid hid;
+    bool typing;
 } PassGen;
 
 void state_free(PassGen* app) {
@@ -57,18 +69,29 @@ void state_free(PassGen* app) {
     furi_message_queue_free(app->input_queue);
     furi_mutex_free(app->mutex);
     furi_record_close(RECORD_NOTIFICATION);
+    if(app->word_list) passgen_word_list_free(app->word_list);
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(app->passphrase);
     free(app);
 }
 
 static void input_callback(InputEvent* input_event, void* ctx) {
     PassGen* app = ctx;
-    if(input_event->type == InputTypeShort) {
+    if(input_event->type == InputTypeShort || input_event->type == InputTypeLong) {
         furi_message_queue_put(app->input_queue, input_event, 0);
     }
 }
 
+static bool is_words(PassGen* app) {
+    return AlphabetLevels[app->level] == Words;
+}
+
+static const char* get_text(PassGen* app) {
+    return is_words(app) ? furi_string_get_cstr(app->passphrase) : app->password;
+}
+
 static void render_callback(Canvas* canvas, void* ctx) {
-    char str_length[8];
+    char str_buffer[PASSGEN_LINE_LENGTH + 1];
     PassGen* app = ctx;
     furi_check(furi_mutex_acquire(app->mutex, FuriWaitForever) == FuriStatusOk);
 
@@ -76,10 +99,27 @@ static void render_callback(Canvas* canvas, void* ctx) {
     canvas_draw_box(canvas, 0, 0, 128, 14);
     canvas_set_color(canvas, ColorWhite);
     canvas_set_font(canvas, FontPrimary);
-    canvas_draw_str(canvas, 2, 11, "Password Generator");
+    snprintf(str_buffer, sizeof(str_buffer), "%d bits", (int)app->entropy);
+    canvas_draw_str(canvas, 2, 11, str_buffer);
+    if(app->policy.exclude_lookalike && !is_words(app)) {
+        canvas_draw_str_aligned(canvas, 80, 11, AlignCenter, AlignBottom, "no 0O1l");
+    }
+    canvas_draw_str_aligned(canvas, 126, 11, AlignRight, AlignBottom, HidNames[app->hid]);
 
     canvas_set_color(canvas, ColorBlack);
-    canvas_draw_str_aligned(canvas, 64, 35, AlignCenter, AlignCenter, app->password);
+    if(app->typing) {
+        canvas_draw_str_aligned(canvas, 64, 35, AlignCenter, AlignCenter, "Typing...");
+    } else {
+        // Up to PASSGEN_LINE_COUNT lines, longer passphrases are cut
+        const char* text = get_text(app);
+        size_t text_length = strlen(text);
+        canvas_set_font(canvas, FontKeyboard);
+        for(size_t line = 0; line < PASSGEN_LINE_COUNT; line++) {
+            if(line * PASSGEN_LINE_LENGTH >= text_length) break;
+            strlcpy(str_buffer, text + line * PASSGEN_LINE_LENGTH, sizeof(str_buffer));
+            canvas_draw_str(canvas, 1, 23 + line * 9, str_buffer);
+        }
+    }
 
     // Navigation menu:
     canvas_set_font(canvas, FontSecondary);
@@ -89,27 +129,44 @@ static void render_callback(Canvas* canvas, void* ctx) {
     canvas_draw_icon(canvas, 54, 52, &I_Vertical_arrow_7x9);
     canvas_draw_str(canvas, 64, 60, AlphabetLevelNames[app->level]);
 
-    snprintf(str_length, sizeof(str_length), "Len: %d", app->length);
+    if(is_words(app)) {
+        snprintf(str_buffer, sizeof(str_buffer), "Wrd: %d", app->words);
+    } else {
+        snprintf(str_buffer, sizeof(str_buffer), "Len: %d", app->policy.length);
+    }
     canvas_draw_icon(canvas, 4, 53, &I_Horizontal_arrow_9x7);
-    canvas_draw_str(canvas, 15, 60, str_length);
+    canvas_draw_str(canvas, 15, 60, str_buffer);
 
     furi_mutex_release(app->mutex);
 }
 
+static int get_min_length(PassGen* app) {
+    return __builtin_popcount(app->policy.classes);
+}
+
 void build_alphabet(PassGen* app) {
-    PassGen_Alphabet mode = AlphabetLevels[app->level];
-    app->alphabet[0] = '\0';
-    if((mode & Digits) != 0) strcat(app->alphabet, PASSGEN_DIGITS);
-    if((mode & Lowercase) != 0) strcat(app->alphabet, PASSGEN_LETTERS_LOW);
-    if((mode & Uppercase) != 0) strcat(app->alphabet, PASSGEN_LETTERS_UP);
-    if((mode & Special) != 0) strcat(app->alphabet, PASSGEN_SPECIAL);
+    if(is_words(app)) return;
+
+    app->policy.classes = AlphabetLevels[app->level];
+    // Every class must fit, length follows the policy
+    if(app->policy.length < get_min_length(app)) {
+        app->policy.length = get_min_length(app);
+    }
 }
 
 PassGen* state_init() {
     PassGen* app = malloc(sizeof(PassGen));
-    app->length = 8;
+    app->policy.length = 8;
     app->level = 2;
+    app->words = 5;
+    app->passphrase = furi_string_alloc();
     build_alphabet(app);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, EXT_PATH("apps_data"));
+    storage_simply_mkdir(storage, PASSGEN_APP_DATA_PATH);
+    app->word_list = passgen_word_list_alloc(storage, PASSGEN_WORD_LIST_PATH);
+
     app->input_queue = furi_message_queue_alloc(8, sizeof(InputEvent));
     app->view_port = view_port_alloc();
     app->gui = furi_record_open(RECORD_GUI);
@@ -124,12 +181,16 @@ PassGen* state_init() {
 }
 
 void generate(PassGen* app) {
-    int hi = strlen(app->alphabet);
-    for(int i = 0; i < app->length; i++) {
-        int x = rand() % hi;
-        app->password[i] = app->alphabet[x];
+    if(is_words(app)) {
+        if(!passgen_generate_passphrase(
+               app->word_list, app->words, PASSGEN_PASSPHRASE_SEPARATOR, app->passphrase)) {
+            furi_string_set(app->passphrase, "Word list read error");
+        }
+        app->entropy = passgen_passphrase_entropy_bits(app->word_list, app->words);
+    } else {
+        passgen_generate(&app->policy, app->password);
+        app->entropy = passgen_entropy_bits(&app->policy);
     }
-    app->password[app->length] = '\0';
 }
 
 void update_password(PassGen* app, bool vibro) {
@@ -142,6 +203,43 @@ void update_password(PassGen* app, bool vibro) {
     view_port_update(app->view_port);
 }
 
+static int get_levels_count(PassGen* app) {
+    // Words level is last, it is only available with a word list
+    return app->word_list ? AlphabetLevelsCount : AlphabetLevelsCount - 1;
+}
+
+static bool change_length(PassGen* app, int delta) {
+    if(is_words(app)) {
+        int words = app->words + delta;
+        if(words < PASSGEN_MIN_WORDS || words > PASSGEN_MAX_WORDS) return false;
+        app->words = words;
+    } else {
+        int length = app->policy.length + delta;
+        if(length < get_min_length(app) || length > PASSGEN_MAX_LENGTH) return false;
+        app->policy.length = length;
+    }
+    return true;
+}
+
+static void type_password(PassGen* app) {
+    // Typing waits for the host, render must not block on the mutex meanwhile
+    FuriString* text = furi_string_alloc_set(get_text(app));
+    PassGenHid hid = app->hid;
+
+    app->typing = true;
+    furi_mutex_release(app->mutex);
+    view_port_update(app->view_port);
+
+    bool typed = passgen_hid_type(hid, furi_string_get_cstr(text));
+    furi_string_free(text);
+
+    furi_check(furi_mutex_acquire(app->mutex, FuriWaitForever) == FuriStatusOk);
+    app->typing = false;
+
+    notification_message(app->notify, typed ? &sequence_success : &sequence_error);
+    view_port_update(app->view_port);
+}
+
 int32_t passgenapp(void) {
     PassGen* app = state_init();
     generate(app);
@@ -166,7 +264,7 @@ int32_t passgenapp(void) {
                         notification_message(app->notify, &sequence_blink_red_100);
                     break;
                 case InputKeyUp:
-                    if(app->level < AlphabetLevelsCount - 1) {
+                    if(app->level < get_levels_count(app) - 1) {
                         app->level++;
                         build_alphabet(app);
                         update_password(app, false);
@@ -174,17 +272,15 @@ int32_t passgenapp(void) {
                         notification_message(app->notify, &sequence_blink_red_100);
                     break;
                 case InputKeyLeft:
-                    if(app->length > 1) {
-                        app->length--;
+                    if(change_length(app, -1))
                         update_password(app, false);
-                    } else
+                    else
                         notification_message(app->notify, &sequence_blink_red_100);
                     break;
                 case InputKeyRight:
-                    if(app->length < PASSGEN_MAX_LENGTH) {
-                        app->length++;
+                    if(change_length(app, 1))
                         update_password(app, false);
-                    } else
+                    else
                         notification_message(app->notify, &sequence_blink_red_100);
                     break;
                 case InputKeyOk:
@@ -193,6 +289,22 @@ int32_t passgenapp(void) {
                 default:
                     break;
                 }
+            } else if(input.type == InputTypeLong) {
+                switch(input.key) {
+                case InputKeyOk:
+                    type_password(app);
+                    break;
+                case InputKeyUp:
+                    app->policy.exclude_lookalike = !app->policy.exclude_lookalike;
+                    update_password(app, false);
+                    break;
+                case InputKeyDown:
+                    app->hid = (app->hid + 1) % PassGenHidCount;
+                    view_port_update(app->view_port);
+                    break;
+                default:
+                    break;
+                }
             }
             furi_mutex_release(app->mutex);
         }
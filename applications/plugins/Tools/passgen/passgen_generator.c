@@ -0,0 +1,232 @@
+#include "passgen_generator.h"
+
+#include <furi_hal_random.h>
+#include <toolbox/stream/buffered_file_stream.h>
+#include <math.h>
+
+#define PASSGEN_DIGITS "0123456789"
+#define PASSGEN_LETTERS_LOW "abcdefghijklmnopqrstuvwxyz"
+#define PASSGEN_LETTERS_UP "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+#define PASSGEN_SPECIAL "!#$%^&*.-_"
+#define PASSGEN_LOOKALIKE "0O1lI"
+
+#define PASSGEN_CLASS_COUNT 4
+
+static const struct {
+    PassGenClass class;
+    const char* characters;
+} passgen_classes[PASSGEN_CLASS_COUNT] = {
+    {PassGenClassDigits, PASSGEN_DIGITS},
+    {PassGenClassLower, PASSGEN_LETTERS_LOW},
+    {PassGenClassUpper, PASSGEN_LETTERS_UP},
+    {PassGenClassSpecial, PASSGEN_SPECIAL},
+};
+
+#define PASSGEN_ALPHABET_MAX \
+    (sizeof(PASSGEN_DIGITS PASSGEN_LETTERS_LOW PASSGEN_LETTERS_UP PASSGEN_SPECIAL) - 1)
+
+struct PassGenWordList {
+    Stream* stream;
+    FuriString* line;
+    size_t count;
+};
+
+uint32_t passgen_random_uniform(uint32_t upper) {
+    furi_check(upper);
+
+    // 2^32 mod upper lowest values are rejected, what is left is a multiple of upper
+    const uint32_t threshold = (0U - upper) % upper;
+    uint32_t value;
+    do {
+        value = furi_hal_random_get();
+    } while(value < threshold);
+
+    return value % upper;
+}
+
+static size_t passgen_class_characters(const PassGenPolicy* policy, size_t index, char* output) {
+    size_t size = 0;
+    for(const char* c = passgen_classes[index].characters; *c; c++) {
+        if(policy->exclude_lookalike && strchr(PASSGEN_LOOKALIKE, *c)) continue;
+        if(output) output[size] = *c;
+        size++;
+    }
+    return size;
+}
+
+static uint8_t passgen_char_class(const PassGenPolicy* policy, char c) {
+    for(size_t i = 0; i < PASSGEN_CLASS_COUNT; i++) {
+        if((policy->classes & passgen_classes[i].class) &&
+           strchr(passgen_classes[i].characters, c)) {
+            return passgen_classes[i].class;
+        }
+    }
+    return 0;
+}
+
+static size_t passgen_class_count(uint8_t classes) {
+    return __builtin_popcount(classes);
+}
+
+bool passgen_policy_is_valid(const PassGenPolicy* policy) {
+    furi_check(policy);
+
+    const uint8_t all = PassGenClassDigits | PassGenClassLower | PassGenClassUpper |
+                        PassGenClassSpecial;
+
+    return policy->classes && !(policy->classes & ~all) && policy->length > 0 &&
+           policy->length <= PASSGEN_MAX_LENGTH &&
+           policy->length >= passgen_class_count(policy->classes);
+}
+
+void passgen_generate(const PassGenPolicy* policy, char* password) {
+    furi_check(passgen_policy_is_valid(policy));
+    furi_check(password);
+
+    char alphabet[PASSGEN_ALPHABET_MAX];
+    size_t alphabet_size = 0;
+    for(size_t i = 0; i < PASSGEN_CLASS_COUNT; i++) {
+        if(policy->classes & passgen_classes[i].class) {
+            alphabet_size += passgen_class_characters(policy, i, &alphabet[alphabet_size]);
+        }
+    }
+
+    // Retry until every class is present, keeps compliant passwords equally likely
+    uint8_t missing;
+    do {
+        missing = policy->classes;
+        for(size_t i = 0; i < policy->length; i++) {
+            password[i] = alphabet[passgen_random_uniform(alphabet_size)];
+            missing &= ~passgen_char_class(policy, password[i]);
+        }
+    } while(missing);
+
+    password[policy->length] = '\0';
+}
+
+float passgen_entropy_bits(const PassGenPolicy* policy) {
+    furi_check(passgen_policy_is_valid(policy));
+
+    size_t sizes[PASSGEN_CLASS_COUNT] = {0};
+    size_t alphabet_size = 0;
+    for(size_t i = 0; i < PASSGEN_CLASS_COUNT; i++) {
+        if(policy->classes & passgen_classes[i].class) {
+            sizes[i] = passgen_class_characters(policy, i, NULL);
+            alphabet_size += sizes[i];
+        }
+    }
+
+    // Inclusion-exclusion over classes that may be missing
+    double count = 0;
+    for(uint8_t subset = 0; subset < (1 << PASSGEN_CLASS_COUNT); subset++) {
+        if(subset & ~policy->classes) continue;
+
+        size_t excluded = 0;
+        for(size_t i = 0; i < PASSGEN_CLASS_COUNT; i++) {
+            if(subset & passgen_classes[i].class) excluded += sizes[i];
+        }
+
+        double term = pow((double)(alphabet_size - excluded), policy->length);
+        count += (passgen_class_count(subset) & 1) ? -term : term;
+    }
+
+    return (float)log2(count);
+}
+
+/** Leave only the last token of the line, false if there is none */
+static bool passgen_word_list_parse(FuriString* line) {
+    furi_string_trim(line);
+    if(furi_string_empty(line)) return false;
+
+    for(size_t i = furi_string_size(line); i > 0; i--) {
+        char c = furi_string_get_char(line, i - 1);
+        if(c == ' ' || c == '\t') {
+            furi_string_right(line, i);
+            break;
+        }
+    }
+
+    return true;
+}
+
+PassGenWordList* passgen_word_list_alloc(Storage* storage, const char* path) {
+    furi_check(storage);
+    furi_check(path);
+
+    PassGenWordList* instance = malloc(sizeof(PassGenWordList));
+    instance->stream = buffered_file_stream_alloc(storage);
+    instance->line = furi_string_alloc();
+
+    if(buffered_file_stream_open(instance->stream, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        while(stream_read_line(instance->stream, instance->line)) {
+            if(passgen_word_list_parse(instance->line)) instance->count++;
+        }
+    }
+
+    if(!instance->count) {
+        passgen_word_list_free(instance);
+        instance = NULL;
+    }
+
+    return instance;
+}
+
+void passgen_word_list_free(PassGenWordList* instance) {
+    furi_check(instance);
+
+    furi_string_free(instance->line);
+    buffered_file_stream_close(instance->stream);
+    stream_free(instance->stream);
+    free(instance);
+}
+
+size_t passgen_word_list_get_count(PassGenWordList* instance) {
+    furi_check(instance);
+    return instance->count;
+}
+
+bool passgen_generate_passphrase(
+    PassGenWordList* instance,
+    size_t words,
+    char separator,
+    FuriString* passphrase) {
+    furi_check(instance);
+    furi_check(words > 0 && words <= PASSGEN_MAX_WORDS);
+    furi_check(passphrase);
+
+    size_t indices[PASSGEN_MAX_WORDS];
+    FuriString* parts[PASSGEN_MAX_WORDS];
+    for(size_t i = 0; i < words; i++) {
+        indices[i] = passgen_random_uniform(instance->count);
+        parts[i] = furi_string_alloc();
+    }
+
+    // Single pass, the list is not kept in RAM
+    size_t found = 0;
+    size_t index = 0;
+    stream_rewind(instance->stream);
+    while(found < words && stream_read_line(instance->stream, instance->line)) {
+        if(!passgen_word_list_parse(instance->line)) continue;
+        for(size_t i = 0; i < words; i++) {
+            if(indices[i] == index) {
+                furi_string_set(parts[i], instance->line);
+                found++;
+            }
+        }
+        index++;
+    }
+
+    furi_string_reset(passphrase);
+    for(size_t i = 0; i < words; i++) {
+        if(i) furi_string_push_back(passphrase, separator);
+        furi_string_cat(passphrase, parts[i]);
+        furi_string_free(parts[i]);
+    }
+
+    return found == words;
+}
+
+float passgen_passphrase_entropy_bits(PassGenWordList* instance, size_t words) {
+    furi_check(instance);
+    return (float)(words * log2((double)instance->count));
+}
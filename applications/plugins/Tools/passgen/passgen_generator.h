@@ -0,0 +1,113 @@
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#define PASSGEN_MAX_LENGTH 64
+#define PASSGEN_MIN_WORDS 3
+#define PASSGEN_MAX_WORDS 10
+
+#define PASSGEN_WORD_LIST_PATH EXT_PATH("apps_data/passgen/wordlist.txt")
+
+typedef enum {
+    PassGenClassDigits = (1 << 0),
+    PassGenClassLower = (1 << 1),
+    PassGenClassUpper = (1 << 2),
+    PassGenClassSpecial = (1 << 3),
+} PassGenClass;
+
+typedef struct {
+    uint8_t length; /**< 1..PASSGEN_MAX_LENGTH, not less than the number of classes */
+    uint8_t classes; /**< PassGenClass mask, each class is used at least once */
+    bool exclude_lookalike; /**< Skip characters that are easy to confuse, like 0 and O */
+} PassGenPolicy;
+
+typedef struct PassGenWordList PassGenWordList;
+
+/** Get uniformly distributed random number from furi_hal_random
+ *
+ * Uses rejection sampling, so there is no modulo bias.
+ *
+ * @param      upper  exclusive upper bound, not 0
+ *
+ * @return     random number in [0, upper)
+ */
+uint32_t passgen_random_uniform(uint32_t upper);
+
+/** Check if policy can be satisfied
+ *
+ * @param      policy  PassGenPolicy
+ *
+ * @return     true if valid
+ */
+bool passgen_policy_is_valid(const PassGenPolicy* policy);
+
+/** Generate password
+ *
+ * Every password that satisfies the policy is equally likely.
+ *
+ * @param      policy    valid PassGenPolicy
+ * @param      password  output buffer, at least policy length + 1 bytes
+ */
+void passgen_generate(const PassGenPolicy* policy, char* password);
+
+/** Get password entropy
+ *
+ * Exact for passgen_generate output: log2 of the number of passwords that
+ * satisfy the policy.
+ *
+ * @param      policy  valid PassGenPolicy
+ *
+ * @return     entropy in bits
+ */
+float passgen_entropy_bits(const PassGenPolicy* policy);
+
+/** Load word list
+ *
+ * One word per line, only the last whitespace separated token of a line is
+ * used, so diceware lists with dice numbers work as is. File stays open.
+ *
+ * @param      storage  Storage instance
+ * @param      path     word list path
+ *
+ * @return     PassGenWordList instance, NULL if the file has no words
+ */
+PassGenWordList* passgen_word_list_alloc(Storage* storage, const char* path);
+
+/** Free word list
+ *
+ * @param      instance  PassGenWordList instance
+ */
+void passgen_word_list_free(PassGenWordList* instance);
+
+/** Get number of words in the list
+ *
+ * @param      instance  PassGenWordList instance
+ *
+ * @return     number of words
+ */
+size_t passgen_word_list_get_count(PassGenWordList* instance);
+
+/** Generate passphrase, words are picked uniformly and independently
+ *
+ * @param      instance   PassGenWordList instance
+ * @param      words      number of words, up to PASSGEN_MAX_WORDS
+ * @param      separator  word separator
+ * @param      passphrase output string
+ *
+ * @return     true on success, false on read error
+ */
+bool passgen_generate_passphrase(
+    PassGenWordList* instance,
+    size_t words,
+    char separator,
+    FuriString* passphrase);
+
+/** Get passphrase entropy
+ *
+ * @param      instance  PassGenWordList instance
+ * @param      words     number of words
+ *
+ * @return     entropy in bits
+ */
+float passgen_passphrase_entropy_bits(PassGenWordList* instance, size_t words);
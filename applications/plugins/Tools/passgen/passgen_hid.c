@@ -0,0 +1,127 @@
+#include "passgen_hid.h"
+
+#include <furi_hal_usb.h>
+#include <furi_hal_usb_hid.h>
+#include <bt/bt_service/bt.h>
+#include <extra_profiles/hid_profile.h>
+#include <storage/storage.h>
+
+#define PASSGEN_HID_CONNECT_TIMEOUT_MS 10000
+#define PASSGEN_HID_KEY_DELAY_MS 10
+#define PASSGEN_HID_BT_KEYS_STORAGE_PATH EXT_PATH("apps_data/passgen/.bt_hid.keys")
+
+typedef bool (*PassGenHidKeyCallback)(void* context, uint16_t key);
+
+static bool passgen_hid_usb_press(void* context, uint16_t key) {
+    UNUSED(context);
+    return furi_hal_hid_kb_press(key);
+}
+
+static bool passgen_hid_usb_release(void* context, uint16_t key) {
+    UNUSED(context);
+    return furi_hal_hid_kb_release(key);
+}
+
+static bool passgen_hid_ble_press(void* context, uint16_t key) {
+    return ble_profile_hid_kb_press(context, key);
+}
+
+static bool passgen_hid_ble_release(void* context, uint16_t key) {
+    return ble_profile_hid_kb_release(context, key);
+}
+
+static void passgen_hid_type_keys(
+    const char* text,
+    PassGenHidKeyCallback press,
+    PassGenHidKeyCallback release,
+    void* context) {
+    for(; *text; text++) {
+        uint16_t key = HID_ASCII_TO_KEY(*text);
+        if(key == HID_KEYBOARD_NONE) continue;
+        press(context, key);
+        furi_delay_ms(PASSGEN_HID_KEY_DELAY_MS);
+        release(context, key);
+        furi_delay_ms(PASSGEN_HID_KEY_DELAY_MS);
+    }
+}
+
+static bool passgen_hid_wait(bool (*is_connected)(void* context), void* context) {
+    for(uint32_t waited = 0; waited < PASSGEN_HID_CONNECT_TIMEOUT_MS; waited += 100) {
+        if(is_connected(context)) return true;
+        furi_delay_ms(100);
+    }
+    return is_connected(context);
+}
+
+static bool passgen_hid_usb_is_connected(void* context) {
+    UNUSED(context);
+    return furi_hal_hid_is_connected();
+}
+
+static bool passgen_hid_type_usb(const char* text) {
+    FuriHalUsbInterface* usb_mode_prev = furi_hal_usb_get_config();
+    furi_hal_usb_unlock();
+    if(!furi_hal_usb_set_config(&usb_hid, NULL)) return false;
+
+    bool connected = passgen_hid_wait(passgen_hid_usb_is_connected, NULL);
+    if(connected) {
+        // Give the host time to enumerate the keyboard
+        furi_delay_ms(500);
+        passgen_hid_type_keys(text, passgen_hid_usb_press, passgen_hid_usb_release, NULL);
+    }
+
+    furi_hal_usb_set_config(usb_mode_prev, NULL);
+    return connected;
+}
+
+static void passgen_hid_ble_status_callback(BtStatus status, void* context) {
+    bool* connected = context;
+    *connected = (status == BtStatusConnected);
+}
+
+static bool passgen_hid_ble_is_connected(void* context) {
+    return *(volatile bool*)context;
+}
+
+static bool passgen_hid_type_ble(const char* text) {
+    Bt* bt = furi_record_open(RECORD_BT);
+    volatile bool connected = false;
+
+    bt_disconnect(bt);
+    // Wait 2nd core to update nvm storage
+    furi_delay_ms(200);
+    bt_keys_storage_set_storage_path(bt, PASSGEN_HID_BT_KEYS_STORAGE_PATH);
+
+    FuriHalBleProfileBase* profile = bt_profile_start(bt, ble_profile_hid, NULL);
+    if(profile) {
+        bt_set_status_changed_callback(bt, passgen_hid_ble_status_callback, (void*)&connected);
+        furi_hal_bt_start_advertising();
+
+        if(passgen_hid_wait(passgen_hid_ble_is_connected, (void*)&connected)) {
+            furi_delay_ms(500);
+            passgen_hid_type_keys(text, passgen_hid_ble_press, passgen_hid_ble_release, profile);
+            ble_profile_hid_kb_release_all(profile);
+        }
+
+        bt_set_status_changed_callback(bt, NULL, NULL);
+        bt_disconnect(bt);
+        furi_delay_ms(200);
+    }
+
+    bt_keys_storage_set_default_path(bt);
+    furi_check(bt_profile_restore_default(bt));
+    furi_record_close(RECORD_BT);
+
+    return connected;
+}
+
+bool passgen_hid_type(PassGenHid hid, const char* text) {
+    furi_check(hid < PassGenHidCount);
+    furi_check(text);
+
+    if(hid == PassGenHidUsb) {
+        return passgen_hid_type_usb(text);
+    } else {
+        return passgen_hid_type_ble(text);
+    }
+}
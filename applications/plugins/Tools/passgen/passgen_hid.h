@@ -0,0 +1,21 @@
+#pragma once
+
+#include <furi.h>
+
+typedef enum {
+    PassGenHidUsb,
+    PassGenHidBle,
+    PassGenHidCount,
+} PassGenHid;
+
+/** Type text as keyboard input
+ *
+ * Blocks until the host is connected and the text is typed, previous USB
+ * mode or BLE profile is restored afterwards.
+ *
+ * @param      hid   PassGenHid interface
+ * @param      text  ASCII text
+ *
+ * @return     true if typed, false if the host did not connect in time
+ */
+bool passgen_hid_type(PassGenHid hid, const char* text);
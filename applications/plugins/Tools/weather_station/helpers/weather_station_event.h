@@ -5,6 +5,7 @@ typedef enum {
     WSCustomEventStartId = 100,
 
     WSCustomEventSceneSettingLock,
+    WSCustomEventSceneReceiverInfoUpdate,
 
     WSCustomEventViewReceiverOK,
     WSCustomEventViewReceiverConfig,
@@ -16,9 +16,9 @@ static void weather_station_scene_receiver_info_add_to_history_callback(
 
     if(ws_history_add_to_history(app->txrx->history, decoder_base, app->txrx->preset) ==
        WSHistoryStateAddKeyUpdateData) {
-        ws_view_receiver_info_update(
-            app->ws_receiver_info,
-            ws_history_get_raw_data(app->txrx->history, app->txrx->idx_menu_chosen));
+        // Loading the signal may read SD card, left to the app thread
+        view_dispatcher_send_custom_event(
+            app->view_dispatcher, WSCustomEventSceneReceiverInfoUpdate);
         subghz_receiver_reset(receiver);
 
         notification_message(app->notifications, &sequence_blink_green_10);
@@ -40,8 +40,13 @@ void weather_station_scene_receiver_info_on_enter(void* context) {
 bool weather_station_scene_receiver_info_on_event(void* context, SceneManagerEvent event) {
     WeatherStationApp* app = context;
     bool consumed = false;
-    UNUSED(app);
-    UNUSED(event);
+    if(event.type == SceneManagerEventTypeCustom &&
+       event.event == WSCustomEventSceneReceiverInfoUpdate) {
+        ws_view_receiver_info_update(
+            app->ws_receiver_info,
+            ws_history_get_raw_data(app->txrx->history, app->txrx->idx_menu_chosen));
+        consumed = true;
+    }
     return consumed;
 }
 
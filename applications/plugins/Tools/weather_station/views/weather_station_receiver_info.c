@@ -15,24 +15,28 @@ typedef struct {
     uint32_t curr_ts;
     FuriString* protocol_name;
     WSBlockGeneric* generic;
+    bool load_failed;
 } WSReceiverInfoModel;
 
 void ws_view_receiver_info_update(WSReceiverInfo* ws_receiver_info, FlipperFormat* fff) {
     furi_assert(ws_receiver_info);
-    furi_assert(fff);
 
     with_view_model(
         ws_receiver_info->view,
         WSReceiverInfoModel * model,
         {
-            flipper_format_rewind(fff);
-            flipper_format_read_string(fff, "Protocol", model->protocol_name);
+            // Signal could not be read back from the history, e.g. SD read error
+            model->load_failed = !fff;
+            if(!model->load_failed) {
+                flipper_format_rewind(fff);
+                flipper_format_read_string(fff, "Protocol", model->protocol_name);
 
-            ws_block_generic_deserialize(model->generic, fff);
+                ws_block_generic_deserialize(model->generic, fff);
 
-            FuriHalRtcDateTime curr_dt;
-            furi_hal_rtc_get_datetime(&curr_dt);
-            model->curr_ts = furi_hal_rtc_datetime_to_timestamp(&curr_dt);
+                FuriHalRtcDateTime curr_dt;
+                furi_hal_rtc_get_datetime(&curr_dt);
+                model->curr_ts = furi_hal_rtc_datetime_to_timestamp(&curr_dt);
+            }
         },
         true);
 }
@@ -43,6 +47,11 @@ void ws_view_receiver_info_draw(Canvas* canvas, WSReceiverInfoModel* model) {
     canvas_set_color(canvas, ColorBlack);
     canvas_set_font(canvas, FontSecondary);
 
+    if(model->load_failed) {
+        canvas_draw_str_aligned(canvas, 64, 32, AlignCenter, AlignCenter, "Failed to load signal");
+        return;
+    }
+
     snprintf(
         buffer,
         sizeof(buffer),
@@ -19,6 +19,8 @@ static bool weather_station_app_back_event_callback(void* context) {
 static void weather_station_app_tick_event_callback(void* context) {
     furi_assert(context);
     WeatherStationApp* app = context;
+    // Signals received on the worker thread go to SD card from here
+    ws_history_flush(app->txrx->history);
     scene_manager_handle_tick_event(app->scene_manager);
 }
 
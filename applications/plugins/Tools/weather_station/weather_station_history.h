@@ -85,6 +85,12 @@ const char* ws_history_get_protocol_name(WSHistory* instance, uint16_t idx);
  */
 void ws_history_get_text_item_menu(WSHistory* instance, FuriString* output, uint16_t idx);
 
+/** Write signals received since the last call to SD card, call from the app thread
+ * 
+ * @param instance  - WSHistory instance
+ */
+void ws_history_flush(WSHistory* instance);
+
 /** Get string the remaining number of records to history
  * 
  * @param instance  - WSHistory instance
@@ -107,6 +113,6 @@ WSHistoryStateAddKey
  * 
  * @param instance  - WSHistory instance
  * @param idx       - record index
- * @return SubGhzProtocolCommonLoad*
+ * @return SubGhzProtocolCommonLoad*, NULL if the signal could not be loaded
  */
 FlipperFormat* ws_history_get_raw_data(WSHistory* instance, uint16_t idx);
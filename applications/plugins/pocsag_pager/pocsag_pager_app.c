@@ -20,6 +20,8 @@ static bool pocsag_pager_app_back_event_callback(void* context) {
 static void pocsag_pager_app_tick_event_callback(void* context) {
     furi_assert(context);
     POCSAGPagerApp* app = context;
+    // Signals received on the worker thread go to SD card from here
+    pcsg_history_flush(app->txrx->history);
     scene_manager_handle_tick_event(app->scene_manager);
 }
 
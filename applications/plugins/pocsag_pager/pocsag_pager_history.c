@@ -2,139 +2,99 @@
 #include <flipper_format/flipper_format_i.h>
 #include <lib/toolbox/stream/stream.h>
 #include <lib/subghz/receiver.h>
+#include <lib/subghz/subghz_history_store.h>
 #include "protocols/pcsg_generic.h"
 
 #include <furi.h>
 
-#define PCSG_HISTORY_MAX 50
-#define TAG "PCSGHistory"
-
-typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
-    uint8_t type;
-    SubGhzRadioPreset* preset;
-} PCSGHistoryItem;
-
-ARRAY_DEF(PCSGHistoryItemArray, PCSGHistoryItem, M_POD_OPLIST)
-
-#define M_OPL_PCSGHistoryItemArray_t() ARRAY_OPLIST(PCSGHistoryItemArray, M_POD_OPLIST)
-
-typedef struct {
-    PCSGHistoryItemArray_t data;
-} PCSGHistoryStruct;
+#define PCSG_HISTORY_MAX        200
+#define PCSG_HISTORY_SPILL_PATH EXT_PATH("pocsag/pocsag_history.tmp")
+#define TAG                     "PCSGHistory"
 
 struct PCSGHistory {
     uint32_t last_update_timestamp;
-    uint16_t last_index_write;
     uint8_t code_last_hash_data;
     FuriString* tmp_string;
-    PCSGHistoryStruct* history;
+    FlipperFormat* flipper_string;
+    SubGhzHistoryStore* store;
 };
 
 PCSGHistory* pcsg_history_alloc(void) {
     PCSGHistory* instance = malloc(sizeof(PCSGHistory));
     instance->tmp_string = furi_string_alloc();
-    instance->history = malloc(sizeof(PCSGHistoryStruct));
-    PCSGHistoryItemArray_init(instance->history->data);
+    instance->flipper_string = flipper_format_string_alloc();
+    instance->store = subghz_history_store_alloc(PCSG_HISTORY_MAX, PCSG_HISTORY_SPILL_PATH);
     return instance;
 }
 
 void pcsg_history_free(PCSGHistory* instance) {
     furi_assert(instance);
+    subghz_history_store_free(instance->store);
+    flipper_format_free(instance->flipper_string);
     furi_string_free(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, PCSGHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    PCSGHistoryItemArray_clear(instance->history->data);
-    free(instance->history);
     free(instance);
 }
 
 uint32_t pcsg_history_get_frequency(PCSGHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    PCSGHistoryItem* item = PCSGHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    return subghz_history_store_get_radio_preset(instance->store, idx)->frequency;
 }
 
 SubGhzRadioPreset* pcsg_history_get_radio_preset(PCSGHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    PCSGHistoryItem* item = PCSGHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    return subghz_history_store_get_radio_preset(instance->store, idx);
 }
 
 const char* pcsg_history_get_preset(PCSGHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    PCSGHistoryItem* item = PCSGHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    return furi_string_get_cstr(subghz_history_store_get_radio_preset(instance->store, idx)->name);
 }
 
 void pcsg_history_reset(PCSGHistory* instance) {
     furi_assert(instance);
     furi_string_reset(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, PCSGHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    PCSGHistoryItemArray_reset(instance->history->data);
-    instance->last_index_write = 0;
+    subghz_history_store_reset(instance->store);
     instance->code_last_hash_data = 0;
 }
 
 uint16_t pcsg_history_get_item(PCSGHistory* instance) {
     furi_assert(instance);
-    return instance->last_index_write;
+    return subghz_history_store_get_count(instance->store);
 }
 
 uint8_t pcsg_history_get_type_protocol(PCSGHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    PCSGHistoryItem* item = PCSGHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    return subghz_history_store_get_protocol(instance->store, idx)->type;
 }
 
 const char* pcsg_history_get_protocol_name(PCSGHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    PCSGHistoryItem* item = PCSGHistoryItemArray_get(instance->history->data, idx);
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
-    }
-    return furi_string_get_cstr(instance->tmp_string);
+    return subghz_history_store_get_protocol(instance->store, idx)->name;
 }
 
 FlipperFormat* pcsg_history_get_raw_data(PCSGHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    PCSGHistoryItem* item = PCSGHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
-    } else {
-        return NULL;
-    }
+    return subghz_history_store_get_flipper_format(instance->store, idx);
 }
+
 bool pcsg_history_get_text_space_left(PCSGHistory* instance, FuriString* output) {
     furi_assert(instance);
-    if(instance->last_index_write == PCSG_HISTORY_MAX) {
+    const uint16_t count = subghz_history_store_get_count(instance->store);
+    if(count == PCSG_HISTORY_MAX) {
         if(output != NULL) furi_string_printf(output, "Memory is FULL");
         return true;
     }
-    if(output != NULL)
-        furi_string_printf(output, "%02u/%02u", instance->last_index_write, PCSG_HISTORY_MAX);
+    if(output != NULL) furi_string_printf(output, "%02u/%02u", count, PCSG_HISTORY_MAX);
     return false;
 }
 
 void pcsg_history_get_text_item_menu(PCSGHistory* instance, FuriString* output, uint16_t idx) {
-    PCSGHistoryItem* item = PCSGHistoryItemArray_get(instance->history->data, idx);
-    furi_string_set(output, item->item_str);
+    subghz_history_store_get_text(instance->store, idx, output);
+}
+
+void pcsg_history_flush(PCSGHistory* instance) {
+    furi_assert(instance);
+    subghz_history_store_flush(instance->store);
 }
 
 PCSGHistoryStateAddKey
@@ -142,7 +102,8 @@ PCSGHistoryStateAddKey
     furi_assert(instance);
     furi_assert(context);
 
-    if(instance->last_index_write >= PCSG_HISTORY_MAX) return PCSGHistoryStateAddKeyOverflow;
+    if(subghz_history_store_get_count(instance->store) >= PCSG_HISTORY_MAX)
+        return PCSGHistoryStateAddKeyOverflow;
 
     SubGhzProtocolDecoderBase* decoder_base = context;
     if((instance->code_last_hash_data ==
@@ -155,69 +116,53 @@ PCSGHistoryStateAddKey
     instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
     instance->last_update_timestamp = furi_get_tick();
 
-    FlipperFormat* fff = flipper_format_string_alloc();
+    // Serialized once, the same text is stored and parsed for the menu
+    FlipperFormat* fff = instance->flipper_string;
+    stream_clean(flipper_format_get_raw_stream(fff));
     subghz_protocol_decoder_base_serialize(decoder_base, fff, preset);
 
-    do {
-        if(!flipper_format_rewind(fff)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-
-    } while(false);
-    flipper_format_free(fff);
-
-    PCSGHistoryItem* item = PCSGHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-
-    item->item_str = furi_string_alloc();
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
+    FuriString* temp_ric = furi_string_alloc();
+    FuriString* temp_message = furi_string_alloc();
+    furi_string_reset(instance->tmp_string);
 
     do {
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-            FURI_LOG_E(TAG, "Missing Protocol");
-            break;
-        }
-
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(fff)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
-        FuriString* temp_ric = furi_string_alloc();
-        if(!flipper_format_read_string(item->flipper_string, "Ric", temp_ric)) {
+        if(!flipper_format_read_string(fff, "Ric", temp_ric)) {
             FURI_LOG_E(TAG, "Missing Ric");
             break;
         }
-
-        FuriString* temp_message = furi_string_alloc();
-        if(!flipper_format_read_string(item->flipper_string, "Message", temp_message)) {
+        if(!flipper_format_read_string(fff, "Message", temp_message)) {
             FURI_LOG_E(TAG, "Missing Message");
             break;
         }
 
         furi_string_printf(
-            item->item_str,
+            instance->tmp_string,
             "%s%s",
             furi_string_get_cstr(temp_ric),
             furi_string_get_cstr(temp_message));
-
-        furi_string_free(temp_message);
-        furi_string_free(temp_ric);
-
     } while(false);
-    instance->last_index_write++;
-    return PCSGHistoryStateAddKeyNewDada;
 
-    return PCSGHistoryStateAddKeyUnknown;
+    furi_string_free(temp_message);
+    furi_string_free(temp_ric);
+
+    // Every message is a new record
+    switch(subghz_history_store_add(
+        instance->store,
+        false,
+        0,
+        decoder_base->protocol,
+        preset,
+        furi_string_get_cstr(instance->tmp_string),
+        fff)) {
+    case SubGhzHistoryStoreAddNew:
+        return PCSGHistoryStateAddKeyNewDada;
+    case SubGhzHistoryStoreAddOverflow:
+        return PCSGHistoryStateAddKeyOverflow;
+    default:
+        return PCSGHistoryStateAddKeyUnknown;
+    }
 }
@@ -85,6 +85,12 @@ const char* pcsg_history_get_protocol_name(PCSGHistory* instance, uint16_t idx);
  */
 void pcsg_history_get_text_item_menu(PCSGHistory* instance, FuriString* output, uint16_t idx);
 
+/** Write signals received since the last call to SD card, call from the app thread
+ * 
+ * @param instance  - PCSGHistory instance
+ */
+void pcsg_history_flush(PCSGHistory* instance);
+
 /** Get string the remaining number of records to history
  * 
  * @param instance  - PCSGHistory instance
@@ -107,6 +113,6 @@ PCSGHistoryStateAddKey
  * 
  * @param instance  - PCSGHistory instance
  * @param idx       - record index
- * @return SubGhzProtocolCommonLoad*
+ * @return SubGhzProtocolCommonLoad*, NULL if the signal could not be loaded
  */
 FlipperFormat* pcsg_history_get_raw_data(PCSGHistory* instance, uint16_t idx);
@@ -115,7 +115,7 @@ void pocsag_pager_scene_receiver_on_enter(void* context) {
 
     //Load history to receiver
     pcsg_view_receiver_exit(app->pcsg_receiver);
-    for(uint8_t i = 0; i < pcsg_history_get_item(app->txrx->history); i++) {
+    for(uint16_t i = 0; i < pcsg_history_get_item(app->txrx->history); i++) {
         furi_string_reset(str_buff);
         pcsg_history_get_text_item_menu(app->txrx->history, str_buff, i);
         pcsg_view_receiver_add_item_to_menu(
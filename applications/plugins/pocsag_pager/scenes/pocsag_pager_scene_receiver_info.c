@@ -16,9 +16,9 @@ static void pocsag_pager_scene_receiver_info_add_to_history_callback(
 
     if(pcsg_history_add_to_history(app->txrx->history, decoder_base, app->txrx->preset) ==
        PCSGHistoryStateAddKeyUpdateData) {
-        pcsg_view_receiver_info_update(
-            app->pcsg_receiver_info,
-            pcsg_history_get_raw_data(app->txrx->history, app->txrx->idx_menu_chosen));
+        // Loading the signal may read SD card, left to the app thread
+        view_dispatcher_send_custom_event(
+            app->view_dispatcher, PCSGCustomEventSceneReceiverInfoUpdate);
         subghz_receiver_reset(receiver);
 
         notification_message(app->notifications, &sequence_blink_green_10);
@@ -40,8 +40,13 @@ void pocsag_pager_scene_receiver_info_on_enter(void* context) {
 bool pocsag_pager_scene_receiver_info_on_event(void* context, SceneManagerEvent event) {
     POCSAGPagerApp* app = context;
     bool consumed = false;
-    UNUSED(app);
-    UNUSED(event);
+    if(event.type == SceneManagerEventTypeCustom &&
+       event.event == PCSGCustomEventSceneReceiverInfoUpdate) {
+        pcsg_view_receiver_info_update(
+            app->pcsg_receiver_info,
+            pcsg_history_get_raw_data(app->txrx->history, app->txrx->idx_menu_chosen));
+        consumed = true;
+    }
     return consumed;
 }
 
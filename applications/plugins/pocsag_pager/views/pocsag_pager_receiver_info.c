@@ -14,20 +14,24 @@ struct PCSGReceiverInfo {
 typedef struct {
     FuriString* protocol_name;
     PCSGBlockGeneric* generic;
+    bool load_failed;
 } PCSGReceiverInfoModel;
 
 void pcsg_view_receiver_info_update(PCSGReceiverInfo* pcsg_receiver_info, FlipperFormat* fff) {
     furi_assert(pcsg_receiver_info);
-    furi_assert(fff);
 
     with_view_model(
         pcsg_receiver_info->view,
         PCSGReceiverInfoModel * model,
         {
-            flipper_format_rewind(fff);
-            flipper_format_read_string(fff, "Protocol", model->protocol_name);
-
-            pcsg_block_generic_deserialize(model->generic, fff);
+            // Signal could not be read back from the history, e.g. SD read error
+            model->load_failed = !fff;
+            if(!model->load_failed) {
+                flipper_format_rewind(fff);
+                flipper_format_read_string(fff, "Protocol", model->protocol_name);
+
+                pcsg_block_generic_deserialize(model->generic, fff);
+            }
         },
         true);
 }
@@ -36,6 +40,10 @@ void pcsg_view_receiver_info_draw(Canvas* canvas, PCSGReceiverInfoModel* model)
     canvas_clear(canvas);
     canvas_set_color(canvas, ColorBlack);
     canvas_set_font(canvas, FontSecondary);
+    if(model->load_failed) {
+        canvas_draw_str_aligned(canvas, 64, 32, AlignCenter, AlignCenter, "Failed to load signal");
+        return;
+    }
     if(model->generic->result_ric != NULL) {
         elements_text_box(
             canvas,
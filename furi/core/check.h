@@ -30,6 +30,7 @@ FURI_NORETURN void __furi_crash_implementation(void);
 /** Halt system */
 FURI_NORETURN void __furi_halt_implementation(void);
 
+#ifdef __arm__
 /** Crash system with message. Show message after reboot. */
 #define __furi_crash(message)                                 \
     do {                                                      \
@@ -37,6 +38,12 @@ FURI_NORETURN void __furi_halt_implementation(void);
         asm volatile("sukima%=:" : : "r"(r12));               \
         __furi_crash_implementation();                        \
     } while(0)
+#else
+/** Crash host process with message, there is no r12 to pass it through */
+FURI_NORETURN void __furi_crash_host(const void* message);
+
+#define __furi_crash(message) __furi_crash_host((const void*)(message))
+#endif
 
 /** Crash system
  *
@@ -44,6 +51,7 @@ FURI_NORETURN void __furi_halt_implementation(void);
  */
 #define furi_crash(...) M_APPLY(__furi_crash, M_IF_EMPTY(__VA_ARGS__)((NULL), (__VA_ARGS__)))
 
+#ifdef __arm__
 /** Halt system with message. */
 #define __furi_halt(message)                                  \
     do {                                                      \
@@ -51,6 +59,12 @@ FURI_NORETURN void __furi_halt_implementation(void);
         asm volatile("sukima%=:" : : "r"(r12));               \
         __furi_halt_implementation();                         \
     } while(0)
+#else
+/** Halt host process with message */
+FURI_NORETURN void __furi_halt_host(const void* message);
+
+#define __furi_halt(message) __furi_halt_host((const void*)(message))
+#endif
 
 /** Halt system
  *
@@ -98,12 +112,21 @@ FURI_NORETURN void __furi_halt_implementation(void);
 #define furi_assert(...) \
     M_APPLY(__furi_assert, M_DEFAULT_ARGS(2, (__FURI_ASSERT_MESSAGE_FLAG), __VA_ARGS__))
 
+#ifdef __arm__
 #define furi_break(__e)             \
     do {                            \
         if(!(__e)) {                \
             asm volatile("bkpt 0"); \
         }                           \
     } while(0)
+#else
+#define furi_break(__e)       \
+    do {                      \
+        if(!(__e)) {          \
+            __builtin_trap(); \
+        }                     \
+    } while(0)
+#endif
 
 #ifdef __cplusplus
 }
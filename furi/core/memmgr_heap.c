@@ -157,6 +157,27 @@ static void prvInsertBlockIntoFreeList(BlockLink_t* pxBlockToInsert) PRIVILEGED_
  */
 static void prvHeapInit(void) PRIVILEGED_FUNCTION;
 
+/*
+ * Takes a block of xWantedSize bytes, BlockLink_t included and aligned, out of
+ * the list of free blocks.  Returns the memory following its BlockLink_t or
+ * NULL.  Must be called with the scheduler suspended.
+ */
+static void* prvHeapAllocate(size_t xWantedSize, size_t* pxAllocatedBlockSize)
+    PRIVILEGED_FUNCTION;
+
+/*
+ * Returns an allocated block to the list of free blocks.  Must be called with
+ * the scheduler suspended.
+ */
+static void prvHeapRelease(BlockLink_t* pxLink) PRIVILEGED_FUNCTION;
+
+/*
+ * Same as prvHeapAllocate(), but takes the block from the end of the highest
+ * free block of adequate size, keeping long-living blocks away from the ones
+ * served first fit.  Must be called with the scheduler suspended.
+ */
+static void* prvHeapAllocateFromTop(size_t xWantedSize) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -192,6 +213,223 @@ DICT_DEF2( //-V1048
 static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
 static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
 
+/* Small allocation slabs
+ *
+ * Allocations of up to MEMMGR_HEAP_SLAB_SIZE_MAX bytes are rounded up to a size
+ * class and served from slab pages: heap blocks holding objects of one class
+ * and a bitmap of used ones. Short-lived small objects no longer split the
+ * free list and take no BlockLink_t each. Pages are taken from the top of the
+ * heap and kept sorted by address so that vPortFree can tell slab objects from
+ * heap blocks. A class with full pages keeps one empty page, other empty pages
+ * go back to the heap, except for the highest one kept as a spare for any class.
+ */
+#define MEMMGR_HEAP_SLAB_PAGE_SIZE   512
+#define MEMMGR_HEAP_SLAB_PAGES_MAX   64
+#define MEMMGR_HEAP_SLAB_SIZE_MAX    64
+#define MEMMGR_HEAP_SLAB_OBJECTS_MAX 64
+
+typedef struct MemmgrHeapSlabPage {
+    struct MemmgrHeapSlabPage* prev; /**< Previous page of the class with free objects */
+    struct MemmgrHeapSlabPage* next; /**< Next page of the class with free objects */
+    uint32_t used_mask[MEMMGR_HEAP_SLAB_OBJECTS_MAX / 32]; /**< Bits past capacity are set */
+    uint8_t size_class;
+    uint8_t used;
+    uint8_t capacity;
+} MemmgrHeapSlabPage;
+
+typedef struct {
+    MemmgrHeapSlabPage* partial; /**< Pages with free objects */
+    uint16_t pages;
+    uint16_t used;
+} MemmgrHeapSlabClass;
+
+#define MEMMGR_HEAP_SLAB_HEADER_SIZE                                  \
+    ((sizeof(MemmgrHeapSlabPage) + (size_t)portBYTE_ALIGNMENT_MASK) & \
+     ~((size_t)portBYTE_ALIGNMENT_MASK))
+
+static const uint8_t memmgr_heap_slab_sizes[] = {8, 16, 24, 32, 48, 64};
+
+/* Size class for every 8 bytes of requested size */
+static const uint8_t memmgr_heap_slab_size_class[MEMMGR_HEAP_SLAB_SIZE_MAX / 8] =
+    {0, 1, 2, 3, 4, 4, 5, 5};
+
+static MemmgrHeapSlabClass memmgr_heap_slab_classes[COUNT_OF(memmgr_heap_slab_sizes)] = {0};
+static MemmgrHeapSlabPage* memmgr_heap_slab_pages[MEMMGR_HEAP_SLAB_PAGES_MAX] = {0};
+static size_t memmgr_heap_slab_page_count = 0;
+static MemmgrHeapSlabPage* memmgr_heap_slab_spare = NULL;
+
+static inline uint8_t* memmgr_heap_slab_objects(MemmgrHeapSlabPage* page) {
+    return (uint8_t*)page + MEMMGR_HEAP_SLAB_HEADER_SIZE;
+}
+
+static size_t memmgr_heap_slab_capacity(uint8_t size_class) {
+    size_t capacity = (MEMMGR_HEAP_SLAB_PAGE_SIZE - xHeapStructSize -
+                       MEMMGR_HEAP_SLAB_HEADER_SIZE) /
+                      memmgr_heap_slab_sizes[size_class];
+    return MIN(capacity, (size_t)MEMMGR_HEAP_SLAB_OBJECTS_MAX);
+}
+
+static void
+    memmgr_heap_slab_partial_push(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlabPage* page) {
+    page->prev = NULL;
+    page->next = slab_class->partial;
+    if(page->next) page->next->prev = page;
+    slab_class->partial = page;
+}
+
+static void
+    memmgr_heap_slab_partial_remove(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlabPage* page) {
+    if(page->prev) {
+        page->prev->next = page->next;
+    } else {
+        slab_class->partial = page->next;
+    }
+    if(page->next) page->next->prev = page->prev;
+}
+
+/* Number of pages starting at or below the pointer */
+static size_t memmgr_heap_slab_page_upper_bound(const void* pointer) {
+    size_t low = 0;
+    size_t high = memmgr_heap_slab_page_count;
+    while(low < high) {
+        const size_t mid = (low + high) / 2;
+        if((const void*)memmgr_heap_slab_pages[mid] <= pointer) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static MemmgrHeapSlabPage* memmgr_heap_slab_page_find(const void* pointer) {
+    const size_t index = memmgr_heap_slab_page_upper_bound(pointer);
+    if(index == 0) return NULL;
+
+    MemmgrHeapSlabPage* page = memmgr_heap_slab_pages[index - 1];
+    if((const uint8_t*)pointer >= (uint8_t*)page + MEMMGR_HEAP_SLAB_PAGE_SIZE - xHeapStructSize) {
+        return NULL;
+    }
+    return page;
+}
+
+static bool memmgr_heap_slab_is_used(MemmgrHeapSlabPage* page, const void* pointer) {
+    const size_t object_size = memmgr_heap_slab_sizes[page->size_class];
+    const size_t offset = (size_t)((const uint8_t*)pointer - memmgr_heap_slab_objects(page));
+    const size_t index = offset / object_size;
+    return (offset % object_size == 0) && (index < page->capacity) &&
+           (page->used_mask[index / 32] & (1UL << (index % 32)));
+}
+
+static MemmgrHeapSlabPage* memmgr_heap_slab_page_alloc(uint8_t size_class) {
+    if(memmgr_heap_slab_page_count == MEMMGR_HEAP_SLAB_PAGES_MAX) return NULL;
+
+    MemmgrHeapSlabPage* page = memmgr_heap_slab_spare;
+    if(page) {
+        memmgr_heap_slab_spare = NULL;
+    } else {
+        page = prvHeapAllocateFromTop(MEMMGR_HEAP_SLAB_PAGE_SIZE);
+        if(page == NULL) return NULL;
+    }
+
+    page->size_class = size_class;
+    page->used = 0;
+    page->capacity = memmgr_heap_slab_capacity(size_class);
+    for(size_t word = 0; word < COUNT_OF(page->used_mask); word++) {
+        const size_t first = word * 32;
+        const size_t bits = (page->capacity > first) ? MIN(page->capacity - first, 32U) : 0;
+        page->used_mask[word] = (bits == 32) ? 0 : (UINT32_MAX << bits);
+    }
+
+    const size_t index = memmgr_heap_slab_page_upper_bound(page);
+    memmove(
+        &memmgr_heap_slab_pages[index + 1],
+        &memmgr_heap_slab_pages[index],
+        (memmgr_heap_slab_page_count - index) * sizeof(MemmgrHeapSlabPage*));
+    memmgr_heap_slab_pages[index] = page;
+    memmgr_heap_slab_page_count++;
+
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[size_class];
+    slab_class->pages++;
+    memmgr_heap_slab_partial_push(slab_class, page);
+    return page;
+}
+
+static void memmgr_heap_slab_page_free(MemmgrHeapSlabPage* page) {
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[page->size_class];
+    memmgr_heap_slab_partial_remove(slab_class, page);
+    slab_class->pages--;
+
+    const size_t index = memmgr_heap_slab_page_upper_bound(page) - 1;
+    memmove(
+        &memmgr_heap_slab_pages[index],
+        &memmgr_heap_slab_pages[index + 1],
+        (memmgr_heap_slab_page_count - index - 1) * sizeof(MemmgrHeapSlabPage*));
+    memmgr_heap_slab_page_count--;
+
+    if(memmgr_heap_slab_spare == NULL || memmgr_heap_slab_spare < page) {
+        MemmgrHeapSlabPage* spare = memmgr_heap_slab_spare;
+        memmgr_heap_slab_spare = page;
+        page = spare;
+    }
+    if(page) {
+        prvHeapRelease((BlockLink_t*)((uint8_t*)page - xHeapStructSize));
+    }
+}
+
+/* Returns object of at least size bytes or NULL, must be called with the scheduler suspended */
+static void* memmgr_heap_slab_alloc(size_t size, size_t* object_size) {
+    const uint8_t size_class = memmgr_heap_slab_size_class[(size - 1) / 8];
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[size_class];
+
+    MemmgrHeapSlabPage* page = slab_class->partial;
+    if(page == NULL) {
+        page = memmgr_heap_slab_page_alloc(size_class);
+        if(page == NULL) return NULL;
+    }
+
+    const size_t word = (page->used_mask[0] == UINT32_MAX) ? 1 : 0;
+    const size_t bit = __builtin_ctz(~page->used_mask[word]);
+    page->used_mask[word] |= 1UL << bit;
+    if(++page->used == page->capacity) {
+        memmgr_heap_slab_partial_remove(slab_class, page);
+    }
+    slab_class->used++;
+
+    *object_size = memmgr_heap_slab_sizes[size_class];
+    return memmgr_heap_slab_objects(page) + (word * 32 + bit) * (*object_size);
+}
+
+/* Returns object size or 0 if not a slab object, must be called with the scheduler suspended */
+static size_t memmgr_heap_slab_free(void* pointer) {
+    MemmgrHeapSlabPage* page = memmgr_heap_slab_page_find(pointer);
+    if(page == NULL) return 0;
+
+    const size_t object_size = memmgr_heap_slab_sizes[page->size_class];
+    const bool is_used = memmgr_heap_slab_is_used(page, pointer);
+    configASSERT(is_used);
+    if(!is_used) return object_size;
+
+    const size_t index = ((uint8_t*)pointer - memmgr_heap_slab_objects(page)) / object_size;
+    page->used_mask[index / 32] &= ~(1UL << (index % 32));
+#if(configHEAP_CLEAR_MEMORY_ON_FREE == 1)
+    (void)memset(pointer, 0, object_size);
+#endif
+
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[page->size_class];
+    slab_class->used--;
+    if(page->used-- == page->capacity) {
+        memmgr_heap_slab_partial_push(slab_class, page);
+    }
+    // Spare page of a class with full pages is kept, so that objects can come and go cheaply
+    if(page->used == 0 &&
+       (slab_class->pages == 1 || slab_class->partial != page || page->next != NULL)) {
+        memmgr_heap_slab_page_free(page);
+    }
+
+    return object_size;
+}
+
 /* Initialize tracing storage on start */
 void memmgr_heap_init(void) {
     MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
@@ -237,11 +475,19 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
                 MemmgrHeapAllocDict_itref_t* data = MemmgrHeapAllocDict_ref(alloc_dict_it);
                 if(data->key != 0) {
                     uint8_t* puc = (uint8_t*)data->key;
+                    MemmgrHeapSlabPage* page = memmgr_heap_slab_page_find(puc);
+                    if(page) {
+                        if(memmgr_heap_slab_is_used(page, puc)) {
+                            leftovers += data->value;
+                        }
+                        continue;
+                    }
+
                     puc -= xHeapStructSize;
                     BlockLink_t* pxLink = (void*)puc;
 
                     if((pxLink->xBlockSize & heapBLOCK_ALLOCATED_BITMASK) &&
-                       pxLink->pxNextFreeBlock == NULL) {
+                       pxLink->pxNextFreeBlock == heapPROTECT_BLOCK_POINTER(NULL)) {
                         leftovers += data->value;
                     }
                 }
@@ -303,15 +549,24 @@ void memmgr_heap_printf_free_blocks(void) {
         heapVALIDATE_BLOCK_POINTER(pxBlock);
     }
 
+    for(uint8_t size_class = 0; size_class < COUNT_OF(memmgr_heap_slab_sizes); size_class++) {
+        const MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[size_class];
+        if(slab_class->pages == 0) continue;
+        printf(
+            "C %lu P %lu U %lu F %lu\r\n",
+            (uint32_t)memmgr_heap_slab_sizes[size_class],
+            (uint32_t)slab_class->pages,
+            (uint32_t)slab_class->used,
+            (uint32_t)(slab_class->pages * memmgr_heap_slab_capacity(size_class) -
+                       slab_class->used));
+    }
+
     //xTaskResumeAll();
 }
 
 /*-----------------------------------------------------------*/
 
 void* pvPortMalloc(size_t xWantedSize) {
-    BlockLink_t* pxBlock;
-    BlockLink_t* pxPreviousBlock;
-    BlockLink_t* pxNewBlockLink;
     void* pvReturn = NULL;
     size_t xToWipe = xWantedSize;
     size_t xAdditionalRequiredSize;
@@ -360,86 +615,18 @@ void* pvPortMalloc(size_t xWantedSize) {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Check the block size we are trying to allocate is not so large that the
-         * top bit is set.  The top bit of the block size member of the BlockLink_t
-         * structure is used to determine who owns the block - the application or
-         * the kernel, so it must be free. */
-        if(heapBLOCK_SIZE_IS_VALID(xWantedSize) != 0) {
-            if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
-                /* Traverse the list from the start (lowest address) block until
-                 * one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = heapPROTECT_BLOCK_POINTER(xStart.pxNextFreeBlock);
-                heapVALIDATE_BLOCK_POINTER(pxBlock);
-
-                while((pxBlock->xBlockSize < xWantedSize) &&
-                      (pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER(NULL))) {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = heapPROTECT_BLOCK_POINTER(pxBlock->pxNextFreeBlock);
-                    heapVALIDATE_BLOCK_POINTER(pxBlock);
-                }
-
-                /* If the end marker was reached then a block of adequate size
-                 * was not found. */
-                if(pxBlock != pxEnd) {
-                    /* Return the memory space pointed to - jumping over the
-                     * BlockLink_t structure at its start. */
-                    pvReturn = (void*)(((uint8_t*)heapPROTECT_BLOCK_POINTER(
-                                           pxPreviousBlock->pxNextFreeBlock)) +
-                                       xHeapStructSize);
-                    heapVALIDATE_BLOCK_POINTER(pvReturn);
-
-                    /* This block is being returned for use so must be taken out
-                     * of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-                    /* If the block is larger than required it can be split into
-                     * two. */
-                    configASSERT(
-                        heapSUBTRACT_WILL_UNDERFLOW(pxBlock->xBlockSize, xWantedSize) == 0);
-
-                    if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
-                        /* This block is to be split into two.  Create a new
-                         * block following the number of bytes requested. The void
-                         * cast is used to prevent byte alignment warnings from the
-                         * compiler. */
-                        pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
-                        configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
-
-                        /* Calculate the sizes of two blocks split from the
-                         * single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
-                        pxPreviousBlock->pxNextFreeBlock =
-                            heapPROTECT_BLOCK_POINTER(pxNewBlockLink);
-                    } else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    xFreeBytesRemaining -= pxBlock->xBlockSize;
-
-                    if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
-                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
-                    } else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+        /* Small allocations are served from slabs, the heap takes them only
+         * when no slab page can be added. */
+        if((xToWipe > 0) && (xToWipe <= MEMMGR_HEAP_SLAB_SIZE_MAX)) {
+            pvReturn = memmgr_heap_slab_alloc(xToWipe, &xAllocatedBlockSize);
+        }
 
-                    xAllocatedBlockSize = pxBlock->xBlockSize;
+        if(pvReturn == NULL) {
+            pvReturn = prvHeapAllocate(xWantedSize, &xAllocatedBlockSize);
+        }
 
-                    /* The block is being returned - it is allocated and owned
-                     * by the application and has no "next" block. */
-                    heapALLOCATE_BLOCK(pxBlock);
-                    pxBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER(NULL);
-                    xNumberOfSuccessfulAllocations++;
-                } else {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            } else {
-                mtCOVERAGE_TEST_MARKER();
-            }
+        if(pvReturn != NULL) {
+            xNumberOfSuccessfulAllocations++;
         } else {
             mtCOVERAGE_TEST_MARKER();
         }
@@ -478,6 +665,22 @@ void vPortFree(void* pv) {
     }
 
     if(pv != NULL) {
+        size_t xSlabObjectSize;
+
+        vTaskSuspendAll();
+        {
+            xSlabObjectSize = memmgr_heap_slab_free(pv);
+            if(xSlabObjectSize > 0) {
+                traceFREE(pv, xSlabObjectSize);
+                xNumberOfSuccessfulFrees++;
+            }
+        }
+        (void)xTaskResumeAll();
+
+        if(xSlabObjectSize > 0) {
+            return;
+        }
+
         /* The memory being freed will have an BlockLink_t structure immediately
          * before it. */
         puc -= xHeapStructSize;
@@ -610,6 +813,164 @@ static void prvHeapInit(void) /* PRIVILEGED_FUNCTION */
 }
 /*-----------------------------------------------------------*/
 
+static void*
+    prvHeapAllocate(size_t xWantedSize, size_t* pxAllocatedBlockSize) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t* pxBlock;
+    BlockLink_t* pxPreviousBlock;
+    BlockLink_t* pxNewBlockLink;
+    void* pvReturn = NULL;
+
+    /* Check the block size we are trying to allocate is not so large that the
+     * top bit is set.  The top bit of the block size member of the BlockLink_t
+     * structure is used to determine who owns the block - the application or
+     * the kernel, so it must be free. */
+    if(heapBLOCK_SIZE_IS_VALID(xWantedSize) != 0) {
+        if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
+            /* Traverse the list from the start (lowest address) block until
+             * one of adequate size is found. */
+            pxPreviousBlock = &xStart;
+            pxBlock = heapPROTECT_BLOCK_POINTER(xStart.pxNextFreeBlock);
+            heapVALIDATE_BLOCK_POINTER(pxBlock);
+
+            while((pxBlock->xBlockSize < xWantedSize) &&
+                  (pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER(NULL))) {
+                pxPreviousBlock = pxBlock;
+                pxBlock = heapPROTECT_BLOCK_POINTER(pxBlock->pxNextFreeBlock);
+                heapVALIDATE_BLOCK_POINTER(pxBlock);
+            }
+
+            /* If the end marker was reached then a block of adequate size
+             * was not found. */
+            if(pxBlock != pxEnd) {
+                /* Return the memory space pointed to - jumping over the
+                 * BlockLink_t structure at its start. */
+                pvReturn = (void*)(((uint8_t*)heapPROTECT_BLOCK_POINTER(
+                                       pxPreviousBlock->pxNextFreeBlock)) +
+                                   xHeapStructSize);
+                heapVALIDATE_BLOCK_POINTER(pvReturn);
+
+                /* This block is being returned for use so must be taken out
+                 * of the list of free blocks. */
+                pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+                /* If the block is larger than required it can be split into
+                 * two. */
+                configASSERT(
+                    heapSUBTRACT_WILL_UNDERFLOW(pxBlock->xBlockSize, xWantedSize) == 0);
+
+                if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+                    /* This block is to be split into two.  Create a new
+                     * block following the number of bytes requested. The void
+                     * cast is used to prevent byte alignment warnings from the
+                     * compiler. */
+                    pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
+                    configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
+
+                    /* Calculate the sizes of two blocks split from the
+                     * single block. */
+                    pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* Insert the new block into the list of free blocks. */
+                    pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+                    pxPreviousBlock->pxNextFreeBlock =
+                        heapPROTECT_BLOCK_POINTER(pxNewBlockLink);
+                } else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                } else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                *pxAllocatedBlockSize = pxBlock->xBlockSize;
+
+                /* The block is being returned - it is allocated and owned
+                 * by the application and has no "next" block. */
+                heapALLOCATE_BLOCK(pxBlock);
+                pxBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER(NULL);
+            } else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        } else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void* prvHeapAllocateFromTop(size_t xWantedSize) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t* pxBlock;
+    BlockLink_t* pxPreviousBlock;
+    BlockLink_t* pxFoundBlock = NULL;
+    BlockLink_t* pxFoundPreviousBlock = NULL;
+
+    if(xWantedSize > xFreeBytesRemaining) {
+        return NULL;
+    }
+
+    /* Traverse the whole list and remember the last block of adequate size. */
+    pxPreviousBlock = &xStart;
+    pxBlock = heapPROTECT_BLOCK_POINTER(xStart.pxNextFreeBlock);
+    heapVALIDATE_BLOCK_POINTER(pxBlock);
+
+    while(pxBlock != pxEnd) {
+        if(pxBlock->xBlockSize >= xWantedSize) {
+            pxFoundBlock = pxBlock;
+            pxFoundPreviousBlock = pxPreviousBlock;
+        }
+        pxPreviousBlock = pxBlock;
+        pxBlock = heapPROTECT_BLOCK_POINTER(pxBlock->pxNextFreeBlock);
+        heapVALIDATE_BLOCK_POINTER(pxBlock);
+    }
+
+    if(pxFoundBlock == NULL) {
+        return NULL;
+    }
+
+    if((pxFoundBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+        /* Split the block, its lower part stays in the list of free blocks. */
+        pxFoundBlock->xBlockSize -= xWantedSize;
+        pxBlock = (void*)(((uint8_t*)pxFoundBlock) + pxFoundBlock->xBlockSize);
+        pxBlock->xBlockSize = xWantedSize;
+    } else {
+        pxFoundPreviousBlock->pxNextFreeBlock = pxFoundBlock->pxNextFreeBlock;
+        pxBlock = pxFoundBlock;
+    }
+
+    xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+    if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
+        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    heapALLOCATE_BLOCK(pxBlock);
+    pxBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER(NULL);
+
+    return (void*)(((uint8_t*)pxBlock) + xHeapStructSize);
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapRelease(BlockLink_t* pxLink) /* PRIVILEGED_FUNCTION */
+{
+    heapFREE_BLOCK(pxLink);
+    xFreeBytesRemaining += pxLink->xBlockSize;
+    prvInsertBlockIntoFreeList(pxLink);
+}
+/*-----------------------------------------------------------*/
+
 static void prvInsertBlockIntoFreeList(BlockLink_t* pxBlockToInsert) /* PRIVILEGED_FUNCTION */
 {
     BlockLink_t* pxIterator;
@@ -728,6 +1089,10 @@ void vPortGetHeapStats(HeapStats_t* pxHeapStats) {
 void vPortHeapResetState(void) {
     pxEnd = NULL;
 
+    memset(memmgr_heap_slab_classes, 0, sizeof(memmgr_heap_slab_classes));
+    memmgr_heap_slab_page_count = 0;
+    memmgr_heap_slab_spare = NULL;
+
     xFreeBytesRemaining = (size_t)0U;
     xMinimumEverFreeBytesRemaining = (size_t)0U;
     xNumberOfSuccessfulAllocations = (size_t)0U;
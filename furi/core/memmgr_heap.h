@@ -41,6 +41,9 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id);
 size_t memmgr_heap_get_max_free_block(void);
 
 /** Print the address and size of all free blocks to stdout
+ *
+ * Followed by a line per small allocation size class in use: object size,
+ * slab pages, used and free objects.
  */
 void memmgr_heap_printf_free_blocks(void);
 
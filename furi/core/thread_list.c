@@ -12,7 +12,7 @@ ARRAY_DEF(FuriThreadListItemArray, FuriThreadListItem*, M_PTR_OPLIST) // NOLINT
 
 DICT_DEF2(
     FuriThreadListItemDict,
-    uint32_t,
+    uintptr_t,
     M_DEFAULT_OPLIST,
     FuriThreadListItem*,
     M_PTR_OPLIST) // NOLINT
@@ -70,7 +70,8 @@ FuriThreadListItem* furi_thread_list_get_at(FuriThreadList* instance, size_t pos
 FuriThreadListItem* furi_thread_list_get_or_insert(FuriThreadList* instance, FuriThread* thread) {
     furi_check(instance);
 
-    FuriThreadListItem** item_ptr = FuriThreadListItemDict_get(instance->search, (uint32_t)thread);
+    FuriThreadListItem** item_ptr =
+        FuriThreadListItemDict_get(instance->search, (uintptr_t)thread);
     if(item_ptr) {
         return *item_ptr;
     }
@@ -78,7 +79,7 @@ FuriThreadListItem* furi_thread_list_get_or_insert(FuriThreadList* instance, Fur
     FuriThreadListItem* item = malloc(sizeof(FuriThreadListItem));
 
     FuriThreadListItemArray_push_back(instance->items, item);
-    FuriThreadListItemDict_set_at(instance->search, (uint32_t)thread, item);
+    FuriThreadListItemDict_set_at(instance->search, (uintptr_t)thread, item);
 
     return item;
 }
@@ -100,7 +101,7 @@ void furi_thread_list_process(FuriThreadList* instance, uint32_t runtime, uint32
         FuriThreadListItem* item = *FuriThreadListItemArray_cref(it);
         if(item->tick != tick) {
             FuriThreadListItemArray_remove(instance->items, it);
-            (void)FuriThreadListItemDict_erase(instance->search, (uint32_t)item->thread);
+            (void)FuriThreadListItemDict_erase(instance->search, (uintptr_t)item->thread);
             free(item);
         } else {
             uint32_t item_counter = item->counter_current - item->counter_previous;
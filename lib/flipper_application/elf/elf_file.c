@@ -11,10 +11,15 @@
 #define ELF_NAME_BUFFER_LEN        32
 #define SECTION_OFFSET(e, n)       ((e)->section_table + (n) * sizeof(Elf32_Shdr))
 #define IS_FLAGS_SET(v, m)         (((v) & (m)) == (m))
-#define RESOLVER_THREAD_YIELD_STEP 30
+#define RELOCATION_BATCH_SIZE      64
 #define FAST_RELOCATION_VERSION    1
 
+#define SYMBOL_CACHE_PATH    EXT_PATH(".cache/elf")
+#define SYMBOL_CACHE_MAGIC   (0x434D5953UL) // "SYMC"
+#define SYMBOL_CACHE_VERSION (1U)
+
 // #define ELF_DEBUG_LOG 1
+// #define ELF_SYMBOL_CACHE_DISABLE 1
 
 #ifndef ELF_DEBUG_LOG
 #undef FURI_LOG_D
@@ -37,6 +42,30 @@ typedef struct {
     uint32_t addr;
 } FURI_PACKED JMPTrampoline;
 
+/**
+ * Symbol cache file header, followed by ELFSymbolCacheEntry records.
+ * Cache is valid only for the same file and API version.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint16_t api_version_major;
+    uint16_t api_version_minor;
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t symbol_count;
+    uint32_t entries_count;
+} FURI_PACKED ELFSymbolCacheHeader;
+
+struct ELFSymbolCacheWriter {
+    File* file;
+    ELFSymbolCacheEntry* buffer;
+    size_t buffered;
+    uint32_t count;
+    bool error;
+};
+
 /**************************************************************************************************/
 /********************************************* Caches *********************************************/
 /**************************************************************************************************/
@@ -177,23 +206,80 @@ static ELFSection* elf_section_of(ELFFile* elf, int index) {
     return NULL;
 }
 
-static Elf32_Addr elf_address_of(ELFFile* elf, Elf32_Sym* sym, const char* sName) {
-    if(sym->st_shndx == SHN_UNDEF) {
-        Elf32_Addr addr = 0;
-        uint32_t hash = elf_symbolname_hash(sName);
-        if(elf->api_interface->resolver_callback(elf->api_interface, hash, &addr)) {
-            return addr;
+static bool elf_read_symbol_name_hash(ELFFile* elf, off_t offset, uint32_t* hash) {
+    if(!storage_file_seek(elf->fd, elf->symbol_table_strings + offset, true)) return false;
+
+    // Same as elf_symbolname_hash, but without copying the name
+    uint32_t name_hash = 0x1505;
+    uint8_t buffer[ELF_NAME_BUFFER_LEN];
+
+    while(true) {
+        size_t read = storage_file_read(elf->fd, buffer, sizeof(buffer));
+        for(size_t i = 0; i < read; i++) {
+            if(buffer[i] == '\0') {
+                *hash = name_hash;
+                return true;
+            }
+            name_hash = (name_hash << 5) + name_hash + buffer[i];
         }
+
+        if(read < sizeof(buffer)) return false;
+    }
+}
+
+static bool elf_read_symbol_cache_entry(ELFFile* elf, int n, ELFSymbolCacheEntry* entry) {
+    Elf32_Sym sym;
+    off_t pos = elf->symbol_table + n * sizeof(Elf32_Sym);
+    if(!storage_file_seek(elf->fd, pos, true) ||
+       storage_file_read(elf->fd, &sym, sizeof(Elf32_Sym)) != sizeof(Elf32_Sym)) {
+        return false;
+    }
+
+    entry->symbol = n;
+    entry->section = sym.st_shndx;
+
+    // Only imported symbols need a name, it is resolved by hash
+    uint32_t value = sym.st_value;
+    if(sym.st_shndx == SHN_UNDEF && !elf_read_symbol_name_hash(elf, sym.st_name, &value)) {
+        return false;
+    }
+
+    entry->value = value;
+    return true;
+}
+
+static Elf32_Addr elf_address_of_by_hash(ELFFile* elf, uint32_t hash) {
+    Elf32_Addr addr = 0;
+    if(elf->api_interface->resolver_callback(elf->api_interface, hash, &addr)) {
+        return addr;
+    }
+    return ELF_INVALID_ADDRESS;
+}
+
+static Elf32_Addr elf_address_of(ELFFile* elf, const ELFSymbolCacheEntry* entry) {
+    if(entry->section == SHN_UNDEF) {
+        return elf_address_of_by_hash(elf, entry->value);
     } else {
-        ELFSection* symSec = elf_section_of(elf, sym->st_shndx);
+        ELFSection* symSec = elf_section_of(elf, entry->section);
         if(symSec) {
-            return ((Elf32_Addr)symSec->data) + sym->st_value;
+            return ((Elf32_Addr)symSec->data) + entry->value;
         }
     }
-    FURI_LOG_D(TAG, "  Can not find address for symbol %s", sName);
+    FURI_LOG_D(TAG, "  Can not find address for symbol #%lu", entry->symbol);
     return ELF_INVALID_ADDRESS;
 }
 
+static void elf_log_missing_symbol(ELFFile* elf, int symEntry) {
+    FuriString* symbol_name = furi_string_alloc();
+    Elf32_Sym sym;
+    if(elf_read_symbol(elf, symEntry, &sym, symbol_name)) {
+        FURI_LOG_E(TAG, "  No symbol address of %s", furi_string_get_cstr(symbol_name));
+    } else {
+        FURI_LOG_E(TAG, "  No symbol address of #%d", symEntry);
+    }
+    furi_string_free(symbol_name);
+}
+
 __attribute__((unused)) static const char* elf_reloc_type_to_str(int symt) {
 #define STRCASE(name) \
     case name:        \
@@ -356,55 +442,211 @@ static bool elf_relocate_symbol(ELFFile* elf, Elf32_Addr relAddr, int type, Elf3
     return true;
 }
 
-static bool elf_relocate(ELFFile* elf, ELFSection* s) {
-    if(s->data) {
-        Elf32_Rel rel;
-        size_t relEntries = s->rel_count;
-        size_t relCount;
-        (void)storage_file_seek(elf->fd, s->rel_offset, true);
-        FURI_LOG_D(TAG, " Offset   Info     Type             Name");
-
-        int relocate_result = true;
-        FuriString* symbol_name;
-        symbol_name = furi_string_alloc();
-
-        for(relCount = 0; relCount < relEntries; relCount++) {
-            if(relCount % RESOLVER_THREAD_YIELD_STEP == 0) {
-                FURI_LOG_D(TAG, "  reloc YIELD");
-                furi_delay_tick(1);
-            }
+/**************************************************************************************************/
+/****************************************** Symbol cache ******************************************/
+/**************************************************************************************************/
+
+static bool elf_symbol_cache_needed(ELFFile* elf) {
+    ELFSectionDict_it_t it;
+    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
+        const ELFSectionDict_itref_t* itref = ELFSectionDict_cref(it);
+        if(itref->value.rel_count && !itref->value.fast_rel) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void elf_symbol_cache_get_path(ELFFile* elf, FuriString* cache_path) {
+    furi_string_printf(
+        cache_path,
+        SYMBOL_CACHE_PATH "/%08lX.sym",
+        elf_symbolname_hash(furi_string_get_cstr(elf->path)));
+}
+
+static bool elf_symbol_cache_fill_header(ELFFile* elf, ELFSymbolCacheHeader* header) {
+    memset(header, 0, sizeof(ELFSymbolCacheHeader));
+    header->magic = SYMBOL_CACHE_MAGIC;
+    header->version = SYMBOL_CACHE_VERSION;
+    header->api_version_major = elf->api_interface->api_version_major;
+    header->api_version_minor = elf->api_interface->api_version_minor;
+    header->source_size = storage_file_size(elf->fd);
+    header->symbol_count = elf->symbol_count;
+
+    uint32_t timestamp = 0;
+    bool success = storage_common_timestamp(
+                       elf->storage, furi_string_get_cstr(elf->path), &timestamp) == FSE_OK;
+    header->source_timestamp = timestamp;
+
+    return success;
+}
+
+static bool elf_symbol_cache_load(ELFFile* elf) {
+    ELFSymbolCacheHeader expected, header;
+    if(!elf_symbol_cache_fill_header(elf, &expected)) return false;
+
+    bool success = false;
+    FuriString* cache_path = furi_string_alloc();
+    File* file = storage_file_alloc(elf->storage);
+    ELFSymbolCacheEntry* entries = malloc(sizeof(ELFSymbolCacheEntry) * RELOCATION_BATCH_SIZE);
+    elf_symbol_cache_get_path(elf, cache_path);
+
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(cache_path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(memcmp(&header, &expected, offsetof(ELFSymbolCacheHeader, entries_count)) != 0)
+            break;
+        if(storage_file_size(file) !=
+           sizeof(header) + header.entries_count * sizeof(ELFSymbolCacheEntry))
+            break;
 
-            if(storage_file_read(elf->fd, &rel, sizeof(Elf32_Rel)) != sizeof(Elf32_Rel)) {
-                FURI_LOG_E(TAG, "  reloc read fail");
-                furi_string_free(symbol_name);
-                return false;
+        size_t entries_left = header.entries_count;
+        while(entries_left) {
+            size_t batch_count = MIN(entries_left, (size_t)RELOCATION_BATCH_SIZE);
+            size_t batch_size = batch_count * sizeof(ELFSymbolCacheEntry);
+            if(storage_file_read(file, entries, batch_size) != batch_size) break;
+
+            for(size_t i = 0; i < batch_count; i++) {
+                Elf32_Addr symAddr = elf_address_of(elf, &entries[i]);
+                address_cache_put(elf->relocation_cache, entries[i].symbol, symAddr);
             }
+            entries_left -= batch_count;
+        }
+
+        success = (entries_left == 0);
+    } while(false);
+
+    if(!success) {
+        AddressCache_reset(elf->relocation_cache);
+    }
+
+    free(entries);
+    storage_file_free(file);
+    furi_string_free(cache_path);
+
+    return success;
+}
+
+static ELFSymbolCacheWriter* elf_symbol_cache_writer_alloc(ELFFile* elf) {
+    FuriString* cache_path = furi_string_alloc();
+    elf_symbol_cache_get_path(elf, cache_path);
+
+    storage_simply_mkdir(elf->storage, EXT_PATH(".cache"));
+    storage_simply_mkdir(elf->storage, SYMBOL_CACHE_PATH);
+
+    // Zeroed header is never valid, file is usable only after elf_symbol_cache_writer_free
+    ELFSymbolCacheHeader header = {0};
+    ELFSymbolCacheWriter* writer = malloc(sizeof(ELFSymbolCacheWriter));
+    writer->file = storage_file_alloc(elf->storage);
+    writer->error =
+        !storage_file_open(
+            writer->file, furi_string_get_cstr(cache_path), FSAM_WRITE, FSOM_CREATE_ALWAYS) ||
+        storage_file_write(writer->file, &header, sizeof(header)) != sizeof(header);
+    writer->buffer = malloc(sizeof(ELFSymbolCacheEntry) * RELOCATION_BATCH_SIZE);
+
+    furi_string_free(cache_path);
+    return writer;
+}
+
+static void elf_symbol_cache_flush(ELFSymbolCacheWriter* writer) {
+    size_t size = writer->buffered * sizeof(ELFSymbolCacheEntry);
+    if(!writer->error && size) {
+        writer->error = storage_file_write(writer->file, writer->buffer, size) != size;
+    }
+    writer->buffered = 0;
+}
+
+static void
+    elf_symbol_cache_write(ELFSymbolCacheWriter* writer, const ELFSymbolCacheEntry* entry) {
+    writer->buffer[writer->buffered++] = *entry;
+    writer->count++;
+    if(writer->buffered == RELOCATION_BATCH_SIZE) {
+        elf_symbol_cache_flush(writer);
+    }
+}
+
+static void elf_symbol_cache_writer_free(ELFFile* elf, ELFSymbolCacheWriter* writer, bool commit) {
+    ELFSymbolCacheHeader header;
+    elf_symbol_cache_flush(writer);
+
+    if(commit && !writer->error && elf_symbol_cache_fill_header(elf, &header)) {
+        header.entries_count = writer->count;
+        writer->error = !storage_file_seek(writer->file, 0, true) ||
+                        storage_file_write(writer->file, &header, sizeof(header)) !=
+                            sizeof(header);
+    } else {
+        writer->error = true;
+    }
+    storage_file_close(writer->file);
+
+    if(writer->error) {
+        FuriString* cache_path = furi_string_alloc();
+        elf_symbol_cache_get_path(elf, cache_path);
+        storage_simply_remove(elf->storage, furi_string_get_cstr(cache_path));
+        furi_string_free(cache_path);
+    }
+
+    storage_file_free(writer->file);
+    free(writer->buffer);
+    free(writer);
+}
+
+static bool elf_relocate(ELFFile* elf, ELFSection* s) {
+    if(!s->data) {
+        FURI_LOG_D(TAG, "Section not loaded");
+        return false;
+    }
+
+    Elf32_Rel* rels = malloc(sizeof(Elf32_Rel) * RELOCATION_BATCH_SIZE);
+    bool relocate_result = true;
+    FURI_LOG_D(TAG, " Offset   Info     Type             Symbol");
+
+    for(size_t rel_idx = 0; rel_idx < s->rel_count; rel_idx += RELOCATION_BATCH_SIZE) {
+        size_t batch_count = MIN(s->rel_count - rel_idx, (size_t)RELOCATION_BATCH_SIZE);
+        size_t batch_size = batch_count * sizeof(Elf32_Rel);
 
+        FURI_LOG_D(TAG, "  reloc YIELD");
+        furi_delay_tick(1);
+
+        // Symbol reads move file position, so every batch seeks
+        if(!storage_file_seek(elf->fd, s->rel_offset + rel_idx * sizeof(Elf32_Rel), true) ||
+           storage_file_read(elf->fd, rels, batch_size) != batch_size) {
+            FURI_LOG_E(TAG, "  reloc read fail");
+            free(rels);
+            return false;
+        }
+
+        for(size_t i = 0; i < batch_count; i++) {
             Elf32_Addr symAddr;
 
-            int symEntry = ELF32_R_SYM(rel.r_info);
-            int relType = ELF32_R_TYPE(rel.r_info);
-            Elf32_Addr relAddr = ((Elf32_Addr)s->data) + rel.r_offset;
+            int symEntry = ELF32_R_SYM(rels[i].r_info);
+            int relType = ELF32_R_TYPE(rels[i].r_info);
+            Elf32_Addr relAddr = ((Elf32_Addr)s->data) + rels[i].r_offset;
+
+            FURI_LOG_D(
+                TAG,
+                " %08X %08X %-16s #%d",
+                (unsigned int)rels[i].r_offset,
+                (unsigned int)rels[i].r_info,
+                elf_reloc_type_to_str(relType),
+                symEntry);
 
             if(!address_cache_get(elf->relocation_cache, symEntry, &symAddr)) {
-                Elf32_Sym sym;
-                furi_string_reset(symbol_name);
-                if(!elf_read_symbol(elf, symEntry, &sym, symbol_name)) {
+                ELFSymbolCacheEntry entry;
+                if(!elf_read_symbol_cache_entry(elf, symEntry, &entry)) {
                     FURI_LOG_E(TAG, "  symbol read fail");
-                    furi_string_free(symbol_name);
+                    free(rels);
                     return false;
                 }
 
-                FURI_LOG_D(
-                    TAG,
-                    " %08X %08X %-16s %s",
-                    (unsigned int)rel.r_offset,
-                    (unsigned int)rel.r_info,
-                    elf_reloc_type_to_str(relType),
-                    furi_string_get_cstr(symbol_name));
-
-                symAddr = elf_address_of(elf, &sym, furi_string_get_cstr(symbol_name));
+                symAddr = elf_address_of(elf, &entry);
                 address_cache_put(elf->relocation_cache, symEntry, symAddr);
+                if(elf->symbol_cache_writer) {
+                    elf_symbol_cache_write(elf->symbol_cache_writer, &entry);
+                }
             }
 
             if(symAddr != ELF_INVALID_ADDRESS) {
@@ -417,18 +659,14 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                     relocate_result = false;
                 }
             } else {
-                FURI_LOG_E(TAG, "  No symbol address of %s", furi_string_get_cstr(symbol_name));
+                elf_log_missing_symbol(elf, symEntry);
                 relocate_result = false;
             }
         }
-        furi_string_free(symbol_name);
-
-        return relocate_result;
-    } else {
-        FURI_LOG_D(TAG, "Section not loaded");
     }
 
-    return false;
+    free(rels);
+    return relocate_result;
 }
 
 /**************************************************************************************************/
@@ -657,14 +895,6 @@ static SectionTypeInfo elf_preload_section(
     return info;
 }
 
-static Elf32_Addr elf_address_of_by_hash(ELFFile* elf, uint32_t hash) {
-    Elf32_Addr addr = 0;
-    if(elf->api_interface->resolver_callback(elf->api_interface, hash, &addr)) {
-        return addr;
-    }
-    return ELF_INVALID_ADDRESS;
-}
-
 static bool elf_file_find_string_by_hash(ELFFile* elf, uint32_t hash, FuriString* out) {
     bool result = false;
 
@@ -809,6 +1039,8 @@ static void elf_file_call_section_list(ELFSection* section, bool reverse_order)
 
 ELFFile* elf_file_alloc(Storage* storage, const ElfApiInterface* api_interface) {
     ELFFile* elf = malloc(sizeof(ELFFile));
+    elf->storage = storage;
+    elf->path = furi_string_alloc();
     elf->fd = storage_file_alloc(storage);
     elf->api_interface = api_interface;
     ELFSectionDict_init(elf->sections);
@@ -858,6 +1090,7 @@ void elf_file_free(ELFFile* elf) {
     }
 
     elf_file_maybe_release_fd(elf);
+    furi_string_free(elf->path);
     free(elf);
 }
 
@@ -873,6 +1106,7 @@ bool elf_file_open(ELFFile* elf, const char* path) {
         return false;
     }
 
+    furi_string_set(elf->path, path);
     elf->entry = h.e_entry;
     elf->sections_count = h.e_shnum;
     elf->section_table = h.e_shoff;
@@ -972,9 +1206,22 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     furi_check(elf->fd != NULL);
     ELFFileLoadStatus status = ELFFileLoadStatusSuccess;
     ELFSectionDict_it_t it;
+    uint32_t start_tick = furi_get_tick();
+    const char* symbol_cache_state = "unused";
 
     AddressCache_init(elf->relocation_cache);
 
+#ifndef ELF_SYMBOL_CACHE_DISABLE
+    if(elf_symbol_cache_needed(elf)) {
+        if(elf_symbol_cache_load(elf)) {
+            symbol_cache_state = "hit";
+        } else {
+            symbol_cache_state = "miss";
+            elf->symbol_cache_writer = elf_symbol_cache_writer_alloc(elf);
+        }
+    }
+#endif
+
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
         ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
         FURI_LOG_D(TAG, "Relocating section '%s'", itref->key);
@@ -996,6 +1243,19 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
         }
     }
 
+    if(elf->symbol_cache_writer) {
+        elf_symbol_cache_writer_free(
+            elf, elf->symbol_cache_writer, status == ELFFileLoadStatusSuccess);
+        elf->symbol_cache_writer = NULL;
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "Relocation of %s took %lu ms, symbol cache %s",
+        furi_string_get_cstr(elf->path),
+        furi_get_tick() - start_tick,
+        symbol_cache_state);
+
     FURI_LOG_D(TAG, "Relocation cache size: %u", AddressCache_size(elf->relocation_cache));
     FURI_LOG_D(TAG, "Trampoline cache size: %u", AddressCache_size(elf->trampoline_cache));
     AddressCache_clear(elf->relocation_cache);
@@ -8,6 +8,17 @@ extern "C" {
 
 DICT_DEF2(AddressCache, int, M_DEFAULT_OPLIST, Elf32_Addr, M_DEFAULT_OPLIST) //-V1048
 
+/**
+ * Resolved symbol, as stored in symbol cache file
+ */
+typedef struct {
+    uint32_t symbol; /**< symbol table index */
+    uint32_t value; /**< name hash for undefined symbol, offset in section otherwise */
+    uint16_t section; /**< SHN_UNDEF or section index */
+} FURI_PACKED ELFSymbolCacheEntry;
+
+typedef struct ELFSymbolCacheWriter ELFSymbolCacheWriter;
+
 /**
  * Callable elf entry type
  */
@@ -41,7 +52,10 @@ struct ELFFile {
 
     AddressCache_t relocation_cache;
     AddressCache_t trampoline_cache;
+    ELFSymbolCacheWriter* symbol_cache_writer;
 
+    Storage* storage;
+    FuriString* path;
     File* fd;
     const ElfApiInterface* api_interface;
     ELFDebugLinkInfo debug_link_info;
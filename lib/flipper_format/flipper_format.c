@@ -7,6 +7,7 @@
 #include "flipper_format_i.h"
 #include "flipper_format_stream.h"
 #include "flipper_format_stream_i.h"
+#include "flipper_format_index_i.h"
 
 // permits direct casting between `FlipperFormatOffset` and `StreamOffset`
 static_assert((size_t)FlipperFormatOffsetFromCurrent == (size_t)StreamOffsetFromCurrent);
@@ -17,6 +18,7 @@ static_assert((size_t)FlipperFormatOffsetFromEnd == (size_t)StreamOffsetFromEnd)
 struct FlipperFormat {
     Stream* stream;
     bool strict_mode;
+    FlipperFormatIndex* index;
 };
 
 static const char* const flipper_format_filetype_key = "Filetype";
@@ -26,6 +28,97 @@ Stream* flipper_format_get_raw_stream(FlipperFormat* flipper_format) {
     return flipper_format->stream;
 }
 
+/** Index the whole stream in one pass right after it is opened */
+static bool flipper_format_index_opened(FlipperFormat* flipper_format, bool opened) {
+    if(flipper_format->index) {
+        flipper_format_index_reset(flipper_format->index);
+        if(opened) flipper_format_index_build(flipper_format->index, flipper_format->stream);
+    }
+    return opened;
+}
+
+static void flipper_format_index_closed(FlipperFormat* flipper_format) {
+    if(flipper_format->index) {
+        flipper_format_index_reset(flipper_format->index);
+    }
+}
+
+static void flipper_format_write_begin(FlipperFormat* flipper_format) {
+    if(flipper_format->index) {
+        flipper_format_index_write_begin(flipper_format->index, flipper_format->stream);
+    }
+}
+
+static bool flipper_format_write_end(FlipperFormat* flipper_format, bool result) {
+    if(flipper_format->index) {
+        flipper_format_index_write_end(flipper_format->index, flipper_format->stream, result);
+    }
+    return result;
+}
+
+/** Move next to the key with the index, the stream parser then finds it right away */
+static void
+    flipper_format_index_jump(FlipperFormat* flipper_format, const char* key, bool strict) {
+    // strict mode only ever looks at the next key, nothing to skip
+    if(flipper_format->index && !strict) {
+        flipper_format_index_seek_to_key(flipper_format->index, flipper_format->stream, key);
+    }
+}
+
+static bool flipper_format_read_value_line(
+    FlipperFormat* flipper_format,
+    const char* key,
+    FlipperStreamValue type,
+    void* data,
+    size_t data_size) {
+    flipper_format_index_jump(flipper_format, key, flipper_format->strict_mode);
+    return flipper_format_stream_read_value_line(
+        flipper_format->stream, key, type, data, data_size, flipper_format->strict_mode);
+}
+
+static bool flipper_format_write_value_line(
+    FlipperFormat* flipper_format,
+    FlipperStreamWriteData* write_data) {
+    flipper_format_write_begin(flipper_format);
+    bool result = flipper_format_stream_write_value_line(flipper_format->stream, write_data);
+    return flipper_format_write_end(flipper_format, result);
+}
+
+static bool flipper_format_delete_key_and_write(
+    FlipperFormat* flipper_format,
+    FlipperStreamWriteData* write_data) {
+    FlipperFormatIndex* index = flipper_format->index;
+    size_t entry_id = SIZE_MAX;
+    size_t size = stream_size(flipper_format->stream);
+    bool result = false;
+
+    // Strict mode only matches the first key of the stream, the parser finds that right away
+    if(index && !flipper_format->strict_mode) {
+        entry_id = flipper_format_index_find(index, flipper_format->stream, write_data->key);
+    }
+
+    if(entry_id != SIZE_MAX) {
+        // Stream is at the key, replace it and shift the entries after it
+        result = flipper_format_stream_delete_found_key_and_write(
+            flipper_format->stream, write_data);
+        if(result) {
+            flipper_format_index_replace(
+                index,
+                entry_id,
+                (int32_t)(stream_size(flipper_format->stream) - size),
+                write_data->type == FlipperStreamValueIgnore);
+        } else {
+            flipper_format_index_invalidate(index);
+        }
+    } else {
+        result = flipper_format_stream_delete_key_and_write(
+            flipper_format->stream, write_data, flipper_format->strict_mode);
+        if(index && result) flipper_format_index_invalidate(index);
+    }
+
+    return result;
+}
+
 /********************************** Public **********************************/
 
 FlipperFormat* flipper_format_string_alloc(void) {
@@ -51,13 +144,17 @@ FlipperFormat* flipper_format_buffered_file_alloc(Storage* storage) {
 
 bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
-    return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
+    return flipper_format_index_opened(
+        flipper_format,
+        file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING));
 }
 
 bool flipper_format_buffered_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
-    return buffered_file_stream_open(
-        flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
+    return flipper_format_index_opened(
+        flipper_format,
+        buffered_file_stream_open(
+            flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING));
 }
 
 bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char* path) {
@@ -88,38 +185,47 @@ bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char*
         stream_seek(flipper_format->stream, 0, StreamOffsetFromEnd);
     }
 
-    return result;
+    return flipper_format_index_opened(flipper_format, result);
 }
 
 bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
-    return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
+    return flipper_format_index_opened(
+        flipper_format,
+        file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
 }
 
 bool flipper_format_buffered_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
-    return buffered_file_stream_open(
-        flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
+    return flipper_format_index_opened(
+        flipper_format,
+        buffered_file_stream_open(
+            flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
 }
 
 bool flipper_format_file_open_new(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
-    return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_NEW);
+    return flipper_format_index_opened(
+        flipper_format,
+        file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_NEW));
 }
 
 bool flipper_format_file_close(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    flipper_format_index_closed(flipper_format);
     return file_stream_close(flipper_format->stream);
 }
 
 bool flipper_format_buffered_file_close(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    flipper_format_index_closed(flipper_format);
     return buffered_file_stream_close(flipper_format->stream);
 }
 
 void flipper_format_free(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
     stream_free(flipper_format->stream);
+    if(flipper_format->index) flipper_format_index_free(flipper_format->index);
     free(flipper_format);
 }
 
@@ -127,6 +233,17 @@ void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_m
     flipper_format->strict_mode = strict_mode;
 }
 
+void flipper_format_set_key_index(FlipperFormat* flipper_format, bool enabled) {
+    furi_check(flipper_format);
+    if(enabled && !flipper_format->index) {
+        // Built on the next open, or on the first lookup if already open
+        flipper_format->index = flipper_format_index_alloc();
+    } else if(!enabled && flipper_format->index) {
+        flipper_format_index_free(flipper_format->index);
+        flipper_format->index = NULL;
+    }
+}
+
 bool flipper_format_rewind(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
     return stream_rewind(flipper_format->stream);
@@ -151,6 +268,7 @@ bool flipper_format_seek_to_end(FlipperFormat* flipper_format) {
 bool flipper_format_key_exist(FlipperFormat* flipper_format, const char* key) {
     size_t pos = stream_tell(flipper_format->stream);
     stream_seek(flipper_format->stream, 0, StreamOffsetFromStart);
+    flipper_format_index_jump(flipper_format, key, false);
     bool result = flipper_format_stream_seek_to_key(flipper_format->stream, key, false);
     stream_seek(flipper_format->stream, pos, StreamOffsetFromStart);
 
@@ -190,14 +308,17 @@ bool flipper_format_get_value_count(
     const char* key,
     uint32_t* count) {
     furi_check(flipper_format);
-    return flipper_format_stream_get_value_count(
+    size_t pos = stream_tell(flipper_format->stream);
+    flipper_format_index_jump(flipper_format, key, flipper_format->strict_mode);
+    bool result = flipper_format_stream_get_value_count(
         flipper_format->stream, key, count, flipper_format->strict_mode);
+    stream_seek(flipper_format->stream, pos, StreamOffsetFromStart);
+    return result;
 }
 
 bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
     furi_check(flipper_format);
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream, key, FlipperStreamValueStr, data, 1, flipper_format->strict_mode);
+    return flipper_format_read_value_line(flipper_format, key, FlipperStreamValueStr, data, 1);
 }
 
 bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
@@ -208,7 +329,7 @@ bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key,
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -223,7 +344,7 @@ bool flipper_format_write_string_cstr(
         .data = data,
         .data_size = 1,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -233,13 +354,8 @@ bool flipper_format_read_hex_uint64(
     uint64_t* data,
     const uint16_t data_size) {
     furi_check(flipper_format);
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueHexUint64,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueHexUint64, data, data_size);
 }
 
 bool flipper_format_write_hex_uint64(
@@ -254,7 +370,7 @@ bool flipper_format_write_hex_uint64(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -264,13 +380,8 @@ bool flipper_format_read_uint32(
     uint32_t* data,
     const uint16_t data_size) {
     furi_check(flipper_format);
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueUint32,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueUint32, data, data_size);
 }
 
 bool flipper_format_write_uint32(
@@ -285,7 +396,7 @@ bool flipper_format_write_uint32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -294,13 +405,8 @@ bool flipper_format_read_int32(
     const char* key,
     int32_t* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueInt32,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueInt32, data, data_size);
 }
 
 bool flipper_format_write_int32(
@@ -315,7 +421,7 @@ bool flipper_format_write_int32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -324,13 +430,8 @@ bool flipper_format_read_bool(
     const char* key,
     bool* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueBool,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueBool, data, data_size);
 }
 
 bool flipper_format_write_bool(
@@ -345,7 +446,7 @@ bool flipper_format_write_bool(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -354,13 +455,8 @@ bool flipper_format_read_float(
     const char* key,
     float* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueFloat,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueFloat, data, data_size);
 }
 
 bool flipper_format_write_float(
@@ -375,7 +471,7 @@ bool flipper_format_write_float(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -384,13 +480,8 @@ bool flipper_format_read_hex(
     const char* key,
     uint8_t* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueHex,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueHex, data, data_size);
 }
 
 bool flipper_format_write_hex(
@@ -405,7 +496,7 @@ bool flipper_format_write_hex(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -416,12 +507,16 @@ bool flipper_format_write_comment(FlipperFormat* flipper_format, FuriString* dat
 
 bool flipper_format_write_comment_cstr(FlipperFormat* flipper_format, const char* data) {
     furi_check(flipper_format);
-    return flipper_format_stream_write_comment_cstr(flipper_format->stream, data);
+    flipper_format_write_begin(flipper_format);
+    return flipper_format_write_end(
+        flipper_format, flipper_format_stream_write_comment_cstr(flipper_format->stream, data));
 }
 
 bool flipper_format_write_empty_line(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
-    return flipper_format_stream_write_eol(flipper_format->stream);
+    flipper_format_write_begin(flipper_format);
+    return flipper_format_write_end(
+        flipper_format, flipper_format_stream_write_eol(flipper_format->stream));
 }
 
 bool flipper_format_delete_key(FlipperFormat* flipper_format, const char* key) {
@@ -432,8 +527,7 @@ bool flipper_format_delete_key(FlipperFormat* flipper_format, const char* key) {
         .data = NULL,
         .data_size = 0,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -445,8 +539,7 @@ bool flipper_format_update_string(FlipperFormat* flipper_format, const char* key
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -461,8 +554,7 @@ bool flipper_format_update_string_cstr(
         .data = data,
         .data_size = 1,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -478,8 +570,7 @@ bool flipper_format_update_uint32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -494,8 +585,7 @@ bool flipper_format_update_int32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -510,8 +600,7 @@ bool flipper_format_update_bool(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -526,8 +615,7 @@ bool flipper_format_update_float(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -542,8 +630,7 @@ bool flipper_format_update_hex(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -214,6 +214,22 @@ void flipper_format_free(FlipperFormat* flipper_format);
  */
 void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_mode);
 
+/** Set FlipperFormat key index mode.
+ *
+ * Key offsets are indexed in one pass when the file is opened, key reads then
+ * seek directly to the key line instead of scanning the stream. The index is
+ * kept up to date by FlipperFormat writes, updates and deletes. Changes made
+ * through the raw stream are not tracked. Files with too many keys fall back
+ * to scanning. Disabled by default.
+ *
+ * Pays off when keys are read out of file order or updated in place. A loader
+ * that reads keys in the order they are written only pays for the index pass.
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ * @param      enabled         True to enable the key index
+ */
+void flipper_format_set_key_index(FlipperFormat* flipper_format, bool enabled);
+
 /** Rewind the RW pointer.
  *
  * @param      flipper_format  Pointer to a FlipperFormat instance
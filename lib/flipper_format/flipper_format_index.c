@@ -0,0 +1,274 @@
+#include <furi.h>
+#include <m-array.h>
+#include "flipper_format_index_i.h"
+#include "flipper_format_stream_i.h"
+
+#define TAG "FlipperFormatIndex"
+
+#define FLIPPER_FORMAT_INDEX_MAX_KEYS    (1024U)
+#define FLIPPER_FORMAT_INDEX_BUFFER_SIZE (64U)
+
+typedef struct {
+    uint32_t hash;
+    uint32_t offset;
+} FlipperFormatIndexEntry;
+
+ARRAY_DEF(FlipperFormatIndexArray, FlipperFormatIndexEntry, M_POD_OPLIST);
+
+struct FlipperFormatIndex {
+    FlipperFormatIndexArray_t entries;
+    bool built;
+    bool overflow;
+    size_t write_position;
+    size_t write_size;
+};
+
+#define FLIPPER_FORMAT_INDEX_HASH_INIT (2166136261UL)
+
+static inline uint32_t flipper_format_index_hash_step(uint32_t hash, char c) {
+    // FNV-1a
+    return (hash ^ (uint8_t)c) * 16777619UL;
+}
+
+static uint32_t flipper_format_index_hash(const char* key) {
+    uint32_t hash = FLIPPER_FORMAT_INDEX_HASH_INIT;
+    while(*key) {
+        hash = flipper_format_index_hash_step(hash, *key++);
+    }
+    return hash;
+}
+
+FlipperFormatIndex* flipper_format_index_alloc(void) {
+    FlipperFormatIndex* index = malloc(sizeof(FlipperFormatIndex));
+    FlipperFormatIndexArray_init(index->entries);
+    return index;
+}
+
+void flipper_format_index_free(FlipperFormatIndex* index) {
+    furi_check(index);
+    FlipperFormatIndexArray_clear(index->entries);
+    free(index);
+}
+
+void flipper_format_index_reset(FlipperFormatIndex* index) {
+    furi_check(index);
+    FlipperFormatIndexArray_reset(index->entries);
+    index->built = false;
+    index->overflow = false;
+}
+
+void flipper_format_index_invalidate(FlipperFormatIndex* index) {
+    furi_check(index);
+    // Overflowed index stays disabled until the stream is reopened
+    if(!index->built) return;
+    FlipperFormatIndexArray_reset(index->entries);
+    index->built = false;
+}
+
+/**
+ * Index key lines from a line start to the end of the stream.
+ * Mirrors the key parsing of flipper_format_stream_seek_to_key: comments and
+ * lines without a delimiter have no key, only the first delimiter of a line counts.
+ */
+static bool flipper_format_index_scan(FlipperFormatIndex* index, Stream* stream, size_t from) {
+    uint8_t buffer[FLIPPER_FORMAT_INDEX_BUFFER_SIZE];
+    uint32_t hash = FLIPPER_FORMAT_INDEX_HASH_INIT;
+    size_t line_start = from;
+    size_t position = from;
+    bool accumulate = true;
+    bool new_line = true;
+
+    if(!stream_seek(stream, from, StreamOffsetFromStart)) return false;
+
+    while(true) {
+        size_t was_read = stream_read(stream, buffer, sizeof(buffer));
+        if(was_read == 0) break;
+
+        for(size_t i = 0; i < was_read; i++, position++) {
+            const char data = buffer[i];
+            if(data == flipper_format_eoln) {
+                hash = FLIPPER_FORMAT_INDEX_HASH_INIT;
+                line_start = position + 1;
+                accumulate = true;
+                new_line = true;
+            } else if(data == flipper_format_eolr) {
+                // ignore
+            } else if(data == flipper_format_comment && new_line) {
+                accumulate = false;
+                new_line = false;
+            } else if(data == flipper_format_delimiter) {
+                if(accumulate && !new_line) {
+                    if(FlipperFormatIndexArray_size(index->entries) >=
+                       FLIPPER_FORMAT_INDEX_MAX_KEYS) {
+                        FURI_LOG_W(TAG, "Too many keys, index disabled");
+                        return false;
+                    }
+                    FlipperFormatIndexEntry entry = {.hash = hash, .offset = line_start};
+                    FlipperFormatIndexArray_push_back(index->entries, entry);
+                }
+                // rest of the line is a value
+                accumulate = false;
+                new_line = false;
+            } else {
+                new_line = false;
+                if(accumulate) {
+                    hash = flipper_format_index_hash_step(hash, data);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool flipper_format_index_build(FlipperFormatIndex* index, Stream* stream) {
+    furi_check(index);
+    furi_check(stream);
+
+    size_t position = stream_tell(stream);
+
+    flipper_format_index_reset(index);
+    index->overflow = !flipper_format_index_scan(index, stream, 0);
+    index->built = !index->overflow;
+    if(index->overflow) {
+        FlipperFormatIndexArray_reset(index->entries);
+    }
+
+    stream_seek(stream, position, StreamOffsetFromStart);
+
+    return index->built;
+}
+
+static bool flipper_format_index_is_usable(FlipperFormatIndex* index, Stream* stream) {
+    if(index->overflow) return false;
+    if(!index->built) return flipper_format_index_build(index, stream);
+    return true;
+}
+
+/** First entry at or after the offset */
+static size_t flipper_format_index_lower_bound(FlipperFormatIndex* index, size_t offset) {
+    size_t low = 0;
+    size_t high = FlipperFormatIndexArray_size(index->entries);
+
+    while(low < high) {
+        size_t middle = low + (high - low) / 2;
+        if(FlipperFormatIndexArray_cget(index->entries, middle)->offset < offset) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+bool flipper_format_index_seek_to_key(FlipperFormatIndex* index, Stream* stream, const char* key) {
+    furi_check(index);
+    furi_check(stream);
+    furi_check(key);
+
+    if(!flipper_format_index_is_usable(index, stream)) return false;
+
+    const uint32_t hash = flipper_format_index_hash(key);
+    const size_t count = FlipperFormatIndexArray_size(index->entries);
+
+    for(size_t i = flipper_format_index_lower_bound(index, stream_tell(stream)); i < count; i++) {
+        const FlipperFormatIndexEntry* entry = FlipperFormatIndexArray_cget(index->entries, i);
+        if(entry->hash == hash) {
+            return stream_seek(stream, entry->offset, StreamOffsetFromStart);
+        }
+    }
+
+    return stream_seek(stream, 0, StreamOffsetFromEnd);
+}
+
+size_t flipper_format_index_find(FlipperFormatIndex* index, Stream* stream, const char* key) {
+    furi_check(index);
+    furi_check(stream);
+    furi_check(key);
+
+    size_t entry_id = SIZE_MAX;
+    if(!flipper_format_index_is_usable(index, stream)) return entry_id;
+
+    const uint32_t hash = flipper_format_index_hash(key);
+    const size_t count = FlipperFormatIndexArray_size(index->entries);
+    const size_t position = stream_tell(stream);
+
+    for(size_t i = 0; i < count; i++) {
+        const FlipperFormatIndexEntry* entry = FlipperFormatIndexArray_cget(index->entries, i);
+        if(entry->hash != hash) continue;
+
+        // Hash match, confirm with the key parser
+        if(!stream_seek(stream, entry->offset, StreamOffsetFromStart)) break;
+        if(flipper_format_stream_seek_to_key(stream, key, true)) {
+            // Line must start with the key itself for the entry to be tracked
+            if(stream_tell(stream) == entry->offset + strlen(key) + 2) entry_id = i;
+            break;
+        }
+    }
+
+    if(entry_id == SIZE_MAX) stream_seek(stream, position, StreamOffsetFromStart);
+
+    return entry_id;
+}
+
+void flipper_format_index_write_begin(FlipperFormatIndex* index, Stream* stream) {
+    furi_check(index);
+    furi_check(stream);
+
+    if(!index->built) return;
+
+    index->write_position = stream_tell(stream);
+    index->write_size = stream_size(stream);
+}
+
+void flipper_format_index_write_end(FlipperFormatIndex* index, Stream* stream, bool success) {
+    furi_check(index);
+    furi_check(stream);
+
+    if(!index->built) return;
+
+    const size_t position = stream_tell(stream);
+    bool appended = success && (index->write_position == index->write_size);
+
+    // Appended lines only start new keys if the stream ended with a new line
+    if(appended && index->write_position > 0) {
+        char last_char = 0;
+        appended = stream_seek(stream, index->write_position - 1, StreamOffsetFromStart) &&
+                   (stream_read(stream, (uint8_t*)&last_char, 1) == 1) &&
+                   (last_char == flipper_format_eoln);
+    }
+
+    if(appended) {
+        index->overflow = !flipper_format_index_scan(index, stream, index->write_position);
+        if(index->overflow) {
+            index->built = false;
+            FlipperFormatIndexArray_reset(index->entries);
+        }
+    } else {
+        flipper_format_index_invalidate(index);
+    }
+
+    stream_seek(stream, position, StreamOffsetFromStart);
+}
+
+void flipper_format_index_replace(
+    FlipperFormatIndex* index,
+    size_t entry_id,
+    int32_t size_delta,
+    bool deleted) {
+    furi_check(index);
+
+    if(!index->built) return;
+
+    const size_t count = FlipperFormatIndexArray_size(index->entries);
+    furi_check(entry_id < count);
+
+    for(size_t i = entry_id + 1; i < count; i++) {
+        FlipperFormatIndexArray_get(index->entries, i)->offset += size_delta;
+    }
+
+    if(deleted) {
+        FlipperFormatIndexArray_remove_v(index->entries, entry_id, entry_id + 1);
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Key offset index, maps each key line of a FlipperFormat stream to its offset */
+typedef struct FlipperFormatIndex FlipperFormatIndex;
+
+/**
+ * Allocate an empty, not yet built index
+ * @return FlipperFormatIndex*
+ */
+FlipperFormatIndex* flipper_format_index_alloc(void);
+
+/**
+ * Free the index
+ * @param index
+ */
+void flipper_format_index_free(FlipperFormatIndex* index);
+
+/**
+ * Drop all entries and state, use when the stream is opened or closed
+ * @param index
+ */
+void flipper_format_index_reset(FlipperFormatIndex* index);
+
+/**
+ * Drop all entries after an untracked change, the index is rebuilt on the next lookup
+ * @param index
+ */
+void flipper_format_index_invalidate(FlipperFormatIndex* index);
+
+/**
+ * Index all keys of the stream in one pass, stream position is preserved
+ * @param index
+ * @param stream
+ * @return true if the index can be used
+ */
+bool flipper_format_index_build(FlipperFormatIndex* index, Stream* stream);
+
+/**
+ * Move the stream to the line of the first candidate key at or after the current position.
+ * Position is moved to the end of the stream if there is no candidate.
+ * Keys are matched by hash, the caller still parses the key from the new position.
+ * @param index
+ * @param stream
+ * @param key
+ * @return false if the index can not be used, stream position is unchanged then
+ */
+bool flipper_format_index_seek_to_key(FlipperFormatIndex* index, Stream* stream, const char* key);
+
+/**
+ * Find the first line with the given key from the start of the stream.
+ * If found, position is at the beginning of the value, as after flipper_format_stream_seek_to_key.
+ * Otherwise position is preserved.
+ * @param index
+ * @param stream
+ * @param key
+ * @return entry id, SIZE_MAX if the key is not found or can not be tracked
+ */
+size_t flipper_format_index_find(FlipperFormatIndex* index, Stream* stream, const char* key);
+
+/**
+ * Track the stream state before a write at the current position
+ * @param index
+ * @param stream
+ */
+void flipper_format_index_write_begin(FlipperFormatIndex* index, Stream* stream);
+
+/**
+ * Index lines appended by the write, drop the index if the write was not an append
+ * @param index
+ * @param stream
+ * @param success write result
+ */
+void flipper_format_index_write_end(FlipperFormatIndex* index, Stream* stream, bool success);
+
+/**
+ * Account for a replaced or deleted key line
+ * @param index
+ * @param entry_id entry replaced, as found by flipper_format_index_find
+ * @param size_delta stream size change
+ * @param deleted line was deleted and not replaced
+ */
+void flipper_format_index_replace(
+    FlipperFormatIndex* index,
+    size_t entry_id,
+    int32_t size_delta,
+    bool deleted);
+
+#ifdef __cplusplus
+}
+#endif
@@ -491,14 +491,27 @@ bool flipper_format_stream_delete_key_and_write(
     bool result = false;
 
     do {
-        size_t size = stream_size(stream);
-        if(size == 0) break;
+        if(stream_size(stream) == 0) break;
 
         if(!stream_rewind(stream)) break;
 
         // find key
         if(!flipper_format_stream_seek_to_key(stream, write_data->key, strict_mode)) break;
 
+        result = flipper_format_stream_delete_found_key_and_write(stream, write_data);
+    } while(false);
+
+    return result;
+}
+
+bool flipper_format_stream_delete_found_key_and_write(
+    Stream* stream,
+    FlipperStreamWriteData* write_data) {
+    bool result = false;
+
+    do {
+        size_t size = stream_size(stream);
+
         // get key start position
         size_t start_position = stream_tell(stream) - strlen(write_data->key);
         if(start_position >= 2) {
@@ -29,6 +29,18 @@ bool flipper_format_stream_write_eol(Stream* stream);
  */
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode);
 
+/**
+ * Replace the key line just found by flipper_format_stream_seek_to_key with new data.
+ * Position must be at the beginning of the value, as the key was found.
+ * @param stream 
+ * @param write_data 
+ * @return true on success
+ * @return false on failure
+ */
+bool flipper_format_stream_delete_found_key_and_write(
+    Stream* stream,
+    FlipperStreamWriteData* write_data);
+
 #ifdef __cplusplus
 }
 #endif
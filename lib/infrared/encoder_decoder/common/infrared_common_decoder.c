@@ -275,6 +275,26 @@ InfraredMessage*
     return message;
 }
 
+/**
+ * Idle decoder (waiting for preamble, aligned at Mark timing) drops a Mark that doesn't match
+ * preamble together with the following Space, so such a pair can be skipped without decoding.
+ * Returns false only in this case.
+ */
+bool infrared_common_decoder_match_preamble(InfraredCommonDecoder* decoder, uint32_t duration) {
+    furi_assert(decoder);
+
+    const InfraredTimings* timings = &decoder->protocol->timings;
+
+    if((decoder->state != InfraredCommonDecoderStateWaitPreamble) || decoder->timings_cnt ||
+       decoder->level || (timings->preamble_mark == 0)) {
+        return true;
+    }
+
+    float preamble_tolerance = timings->preamble_tolerance;
+    uint16_t preamble_mark = timings->preamble_mark;
+    return MATCH_TIMING(duration, preamble_mark, preamble_tolerance);
+}
+
 void* infrared_common_decoder_alloc(const InfraredCommonProtocolSpec* protocol) {
     furi_assert(protocol);
 
@@ -20,6 +20,7 @@ typedef struct {
     InfraredDecoderReset reset;
     InfraredFree free;
     InfraredDecoderCheckReady check_ready;
+    InfraredDecoderMatchPreamble match_preamble;
 } InfraredDecoders;
 
 typedef struct {
@@ -31,6 +32,7 @@ typedef struct {
 
 struct InfraredDecoderHandler {
     void** ctx;
+    uint32_t skipped; /* decoders skipping current Mark and following Space */
 };
 
 struct InfraredEncoderHandler {
@@ -51,6 +53,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_nec_decode,
              .reset = infrared_decoder_nec_reset,
              .check_ready = infrared_decoder_nec_check_ready,
+             .match_preamble = infrared_decoder_nec_match_preamble,
              .free = infrared_decoder_nec_free},
         .encoder =
             {.alloc = infrared_encoder_nec_alloc,
@@ -65,6 +68,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_samsung32_decode,
              .reset = infrared_decoder_samsung32_reset,
              .check_ready = infrared_decoder_samsung32_check_ready,
+             .match_preamble = infrared_decoder_samsung32_match_preamble,
              .free = infrared_decoder_samsung32_free},
         .encoder =
             {.alloc = infrared_encoder_samsung32_alloc,
@@ -93,6 +97,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc6_decode,
              .reset = infrared_decoder_rc6_reset,
              .check_ready = infrared_decoder_rc6_check_ready,
+             .match_preamble = infrared_decoder_rc6_match_preamble,
              .free = infrared_decoder_rc6_free},
         .encoder =
             {.alloc = infrared_encoder_rc6_alloc,
@@ -107,6 +112,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_sirc_decode,
              .reset = infrared_decoder_sirc_reset,
              .check_ready = infrared_decoder_sirc_check_ready,
+             .match_preamble = infrared_decoder_sirc_match_preamble,
              .free = infrared_decoder_sirc_free},
         .encoder =
             {.alloc = infrared_encoder_sirc_alloc,
@@ -121,6 +127,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_pioneer_decode,
              .reset = infrared_decoder_pioneer_reset,
              .check_ready = infrared_decoder_pioneer_check_ready,
+             .match_preamble = infrared_decoder_pioneer_match_preamble,
              .free = infrared_decoder_pioneer_free},
         .encoder =
             {.alloc = infrared_encoder_pioneer_alloc,
@@ -135,6 +142,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_kaseikyo_decode,
              .reset = infrared_decoder_kaseikyo_reset,
              .check_ready = infrared_decoder_kaseikyo_check_ready,
+             .match_preamble = infrared_decoder_kaseikyo_match_preamble,
              .free = infrared_decoder_kaseikyo_free},
         .encoder =
             {.alloc = infrared_encoder_kaseikyo_alloc,
@@ -149,6 +157,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rca_decode,
              .reset = infrared_decoder_rca_reset,
              .check_ready = infrared_decoder_rca_check_ready,
+             .match_preamble = infrared_decoder_rca_match_preamble,
              .free = infrared_decoder_rca_free},
         .encoder =
             {.alloc = infrared_encoder_rca_alloc,
@@ -159,9 +168,31 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
     },
 };
 
+_Static_assert(COUNT_OF(infrared_encoder_decoder) <= 32, "Too many decoders for skip mask");
+
 static int infrared_find_index_by_protocol(InfraredProtocol protocol);
 static const InfraredProtocolVariant* infrared_get_variant_by_protocol(InfraredProtocol protocol);
 
+/* Decoders that can't start a frame with this Mark skip it along with the following Space.
+ * Skipped decoder is left idle either way, so results are the same as with decoding. */
+static void infrared_classify_mark(InfraredDecoderHandler* handler, uint32_t duration) {
+    for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        const InfraredDecoders* decoder = &infrared_encoder_decoder[i].decoder;
+        if(!decoder->match_preamble) continue;
+
+        /* Space was lost, decoder would have been reset by a repeated Mark */
+        if(handler->skipped & (1UL << i)) {
+            decoder->reset(handler->ctx[i]);
+        }
+
+        if(decoder->match_preamble(handler->ctx[i], duration)) {
+            handler->skipped &= ~(1UL << i);
+        } else {
+            handler->skipped |= (1UL << i);
+        }
+    }
+}
+
 const InfraredMessage*
     infrared_decode(InfraredDecoderHandler* handler, bool level, uint32_t duration) {
     furi_check(handler);
@@ -169,7 +200,12 @@ const InfraredMessage*
     InfraredMessage* message = NULL;
     InfraredMessage* result = NULL;
 
+    if(level) {
+        infrared_classify_mark(handler, duration);
+    }
+
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        if(handler->skipped & (1UL << i)) continue;
         if(infrared_encoder_decoder[i].decoder.decode) {
             message = infrared_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
             if(!result && message) {
@@ -178,6 +214,10 @@ const InfraredMessage*
         }
     }
 
+    if(!level) {
+        handler->skipped = 0;
+    }
+
     return result;
 }
 
@@ -211,6 +251,8 @@ void infrared_free_decoder(InfraredDecoderHandler* handler) {
 void infrared_reset_decoder(InfraredDecoderHandler* handler) {
     furi_check(handler);
 
+    handler->skipped = 0;
+
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
         if(infrared_encoder_decoder[i].decoder.reset)
             infrared_encoder_decoder[i].decoder.reset(handler->ctx[i]);
@@ -41,6 +41,10 @@ InfraredMessage* infrared_decoder_kaseikyo_decode(void* decoder, bool level, uin
     return infrared_common_decode(decoder, level, duration);
 }
 
+bool infrared_decoder_kaseikyo_match_preamble(void* decoder, uint32_t duration) {
+    return infrared_common_decoder_match_preamble(decoder, duration);
+}
+
 void infrared_decoder_kaseikyo_free(void* decoder) {
     infrared_common_decoder_free(decoder);
 }
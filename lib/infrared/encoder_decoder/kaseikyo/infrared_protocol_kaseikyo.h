@@ -21,6 +21,7 @@ void infrared_decoder_kaseikyo_reset(void* decoder);
 void infrared_decoder_kaseikyo_free(void* decoder);
 InfraredMessage* infrared_decoder_kaseikyo_check_ready(void* decoder);
 InfraredMessage* infrared_decoder_kaseikyo_decode(void* decoder, bool level, uint32_t duration);
+bool infrared_decoder_kaseikyo_match_preamble(void* decoder, uint32_t duration);
 
 void* infrared_encoder_kaseikyo_alloc(void);
 InfraredStatus
@@ -88,6 +88,10 @@ InfraredMessage* infrared_decoder_nec_decode(void* decoder, bool level, uint32_t
     return infrared_common_decode(decoder, level, duration);
 }
 
+bool infrared_decoder_nec_match_preamble(void* decoder, uint32_t duration) {
+    return infrared_common_decoder_match_preamble(decoder, duration);
+}
+
 void infrared_decoder_nec_free(void* decoder) {
     infrared_common_decoder_free(decoder);
 }
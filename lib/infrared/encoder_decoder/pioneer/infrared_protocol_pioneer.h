@@ -26,6 +26,7 @@ void infrared_decoder_pioneer_reset(void* decoder);
 InfraredMessage* infrared_decoder_pioneer_check_ready(void* decoder);
 void infrared_decoder_pioneer_free(void* decoder);
 InfraredMessage* infrared_decoder_pioneer_decode(void* decoder, bool level, uint32_t duration);
+bool infrared_decoder_pioneer_match_preamble(void* decoder, uint32_t duration);
 
 void* infrared_encoder_pioneer_alloc(void);
 void infrared_encoder_pioneer_reset(void* encoder_ptr, const InfraredMessage* message);
@@ -100,6 +100,11 @@ InfraredMessage* infrared_decoder_rc6_decode(void* decoder, bool level, uint32_t
     return infrared_common_decode(decoder_rc6->common_decoder, level, duration);
 }
 
+bool infrared_decoder_rc6_match_preamble(void* decoder, uint32_t duration) {
+    InfraredRc6Decoder* decoder_rc6 = decoder;
+    return infrared_common_decoder_match_preamble(decoder_rc6->common_decoder, duration);
+}
+
 void infrared_decoder_rc6_free(void* decoder) {
     InfraredRc6Decoder* decoder_rc6 = decoder;
     infrared_common_decoder_free(decoder_rc6->common_decoder);
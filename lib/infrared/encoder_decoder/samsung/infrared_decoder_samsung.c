@@ -60,6 +60,10 @@ InfraredMessage* infrared_decoder_samsung32_decode(void* decoder, bool level, ui
     return infrared_common_decode(decoder, level, duration);
 }
 
+bool infrared_decoder_samsung32_match_preamble(void* decoder, uint32_t duration) {
+    return infrared_common_decoder_match_preamble(decoder, duration);
+}
+
 void infrared_decoder_samsung32_free(void* decoder) {
     infrared_common_decoder_free(decoder);
 }
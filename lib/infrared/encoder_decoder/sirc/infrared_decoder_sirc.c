@@ -46,6 +46,10 @@ InfraredMessage* infrared_decoder_sirc_decode(void* decoder, bool level, uint32_
     return infrared_common_decode(decoder, level, duration);
 }
 
+bool infrared_decoder_sirc_match_preamble(void* decoder, uint32_t duration) {
+    return infrared_common_decoder_match_preamble(decoder, duration);
+}
+
 void infrared_decoder_sirc_free(void* decoder) {
     infrared_common_decoder_free(decoder);
 }
@@ -0,0 +1,98 @@
+#include <furi.h>
+#include <toolbox/manchester_decoder.h>
+#include <lfrfid/tools/fsk_demod.h>
+#include "lfrfid_demods.h"
+
+#define FSK2A_RF50_JITTER_TIME (20)
+#define FSK2A_RF50_MIN_TIME    (64 - FSK2A_RF50_JITTER_TIME)
+#define FSK2A_RF50_MAX_TIME    (80 + FSK2A_RF50_JITTER_TIME)
+
+#define MANCHESTER_RF32_SHORT_TIME  (128)
+#define MANCHESTER_RF32_LONG_TIME   (256)
+#define MANCHESTER_RF32_JITTER_TIME (60)
+
+#define MANCHESTER_RF64_SHORT_TIME  (256)
+#define MANCHESTER_RF64_LONG_TIME   (512)
+#define MANCHESTER_RF64_JITTER_TIME (100)
+
+typedef struct {
+    uint32_t short_time_low;
+    uint32_t short_time_high;
+    uint32_t long_time_low;
+    uint32_t long_time_high;
+    ManchesterState state;
+} ManchesterDemod;
+
+static void* lfrfid_demod_fsk2a_rf50_alloc(void) {
+    return fsk_demod_alloc(FSK2A_RF50_MIN_TIME, 6, FSK2A_RF50_MAX_TIME, 5);
+}
+
+const ProtocolDemod lfrfid_demod_fsk2a_rf50 = {
+    .alloc = lfrfid_demod_fsk2a_rf50_alloc,
+    .free = (ProtocolFree)fsk_demod_free,
+    .start = NULL,
+    .feed = (ProtocolDemodFeed)fsk_demod_feed,
+};
+
+static ManchesterDemod*
+    manchester_demod_alloc(uint32_t short_time, uint32_t long_time, uint32_t jitter_time) {
+    ManchesterDemod* demod = malloc(sizeof(ManchesterDemod));
+    demod->short_time_low = short_time - jitter_time;
+    demod->short_time_high = short_time + jitter_time;
+    demod->long_time_low = long_time - jitter_time;
+    demod->long_time_high = long_time + jitter_time;
+    return demod;
+}
+
+static void manchester_demod_start(void* context) {
+    ManchesterDemod* demod = context;
+    manchester_advance(demod->state, ManchesterEventReset, &demod->state, NULL);
+}
+
+static void manchester_demod_feed(
+    void* context,
+    bool level,
+    uint32_t duration,
+    bool* value,
+    uint32_t* count) {
+    ManchesterDemod* demod = context;
+    ManchesterEvent event = ManchesterEventReset;
+    *count = 0;
+
+    if(duration > demod->short_time_low && duration < demod->short_time_high) {
+        event = level ? ManchesterEventShortLow : ManchesterEventShortHigh;
+    } else if(duration > demod->long_time_low && duration < demod->long_time_high) {
+        event = level ? ManchesterEventLongLow : ManchesterEventLongHigh;
+    }
+
+    // Out of range durations are skipped, the state is kept
+    if(event != ManchesterEventReset) {
+        if(manchester_advance(demod->state, event, &demod->state, value)) {
+            *count = 1;
+        }
+    }
+}
+
+static void* lfrfid_demod_manchester_rf32_alloc(void) {
+    return manchester_demod_alloc(
+        MANCHESTER_RF32_SHORT_TIME, MANCHESTER_RF32_LONG_TIME, MANCHESTER_RF32_JITTER_TIME);
+}
+
+static void* lfrfid_demod_manchester_rf64_alloc(void) {
+    return manchester_demod_alloc(
+        MANCHESTER_RF64_SHORT_TIME, MANCHESTER_RF64_LONG_TIME, MANCHESTER_RF64_JITTER_TIME);
+}
+
+const ProtocolDemod lfrfid_demod_manchester_rf32 = {
+    .alloc = lfrfid_demod_manchester_rf32_alloc,
+    .free = free,
+    .start = manchester_demod_start,
+    .feed = manchester_demod_feed,
+};
+
+const ProtocolDemod lfrfid_demod_manchester_rf64 = {
+    .alloc = lfrfid_demod_manchester_rf64_alloc,
+    .free = free,
+    .start = manchester_demod_start,
+    .feed = manchester_demod_feed,
+};
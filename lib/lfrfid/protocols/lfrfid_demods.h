@@ -0,0 +1,18 @@
+#pragma once
+#include <toolbox/protocols/protocol.h>
+
+/**
+ * Demodulators shared by LF RFID decoders, see ProtocolDemod.
+ *
+ * A decoder may only use one of them if it demodulates with exactly the
+ * same parameters, otherwise decoded data changes.
+ */
+
+/** FSK2a RF/50, 8 and 10 clocks per cycle, one bit per cycle group */
+extern const ProtocolDemod lfrfid_demod_fsk2a_rf50;
+
+/** Manchester RF/32, one bit per event */
+extern const ProtocolDemod lfrfid_demod_manchester_rf32;
+
+/** Manchester RF/64, one bit per event */
+extern const ProtocolDemod lfrfid_demod_manchester_rf64;
@@ -54,8 +54,8 @@
 #include <furi.h>
 #include <stdlib.h>
 #include <toolbox/protocols/protocol.h>
-#include <toolbox/manchester_decoder.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 
 #define TAG "ELECTRA"
 
@@ -90,15 +90,6 @@ typedef uint64_t ElectraDecodedData;
 
 #define ELECTRA_CLOCK_PER_BIT (64)
 
-#define ELECTRA_READ_SHORT_TIME  (256)
-#define ELECTRA_READ_LONG_TIME   (512)
-#define ELECTRA_READ_JITTER_TIME (100)
-
-#define ELECTRA_READ_SHORT_TIME_LOW  (ELECTRA_READ_SHORT_TIME - ELECTRA_READ_JITTER_TIME)
-#define ELECTRA_READ_SHORT_TIME_HIGH (ELECTRA_READ_SHORT_TIME + ELECTRA_READ_JITTER_TIME)
-#define ELECTRA_READ_LONG_TIME_LOW   (ELECTRA_READ_LONG_TIME - ELECTRA_READ_JITTER_TIME)
-#define ELECTRA_READ_LONG_TIME_HIGH  (ELECTRA_READ_LONG_TIME + ELECTRA_READ_JITTER_TIME)
-
 #define EM_ENCODED_DATA_HEADER (0xFF80000000000000ULL)
 
 typedef struct {
@@ -109,8 +100,6 @@ typedef struct {
 
     uint8_t encoded_data_index;
     bool encoded_polarity;
-
-    ManchesterState decoder_manchester_state;
 } ProtocolElectra;
 
 ProtocolElectra* protocol_electra_alloc(void) {
@@ -236,65 +225,37 @@ void protocol_electra_decoder_start(ProtocolElectra* proto) {
     memset(proto->data, 0, ELECTRA_DECODED_DATA_SIZE);
     proto->encoded_base_data = 0;
     proto->encoded_epilogue = 0;
-
-    manchester_advance(
-        proto->decoder_manchester_state,
-        ManchesterEventReset,
-        &proto->decoder_manchester_state,
-        NULL);
 }
 
-bool protocol_electra_decoder_feed(ProtocolElectra* proto, bool level, uint32_t duration) {
+bool protocol_electra_decoder_feed_bits(ProtocolElectra* proto, bool value, uint32_t count) {
     bool result = false;
 
-    ManchesterEvent event = ManchesterEventReset;
-
-    if(duration > ELECTRA_READ_SHORT_TIME_LOW && duration < ELECTRA_READ_SHORT_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventShortHigh;
-        } else {
-            event = ManchesterEventShortLow;
-        }
-    } else if(duration > ELECTRA_READ_LONG_TIME_LOW && duration < ELECTRA_READ_LONG_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventLongHigh;
-        } else {
-            event = ManchesterEventLongLow;
-        }
-    }
-
-    if(event != ManchesterEventReset) {
-        bool data;
-        bool data_ok = manchester_advance(
-            proto->decoder_manchester_state, event, &proto->decoder_manchester_state, &data);
-
-        if(data_ok) {
-            /*
-                EM 4100 BASE DATA (64 bit)         ELECTRA EPILOGUE (64 bit)
-            _________________________________  _________________________________
-            | | | | | | | | | | | | | | | | |  | | | | | | | | | | | | | | | | |    <- new data bit
-            ---------------------------------  --------------------------------- 
-                                             <- epilogue msb is carry bit to base data  
-            */
-            bool carry = proto->encoded_epilogue >> 63 & 0b1;
-
-            proto->encoded_base_data = (proto->encoded_base_data << 1) | carry;
-            proto->encoded_epilogue = (proto->encoded_epilogue << 1) | data;
-
-            if(electra_can_be_decoded(
-                   (uint8_t*)&proto->encoded_base_data,
-                   ELECTRA_ENCODED_BASE_DATA_SIZE,
-                   (uint8_t*)&proto->encoded_epilogue,
-                   ELECTRA_ENCODED_EPILOGUE_SIZE)) {
-                electra_decode(
-                    (uint8_t*)&proto->encoded_base_data,
-                    ELECTRA_ENCODED_BASE_DATA_SIZE,
-                    (uint8_t*)&proto->encoded_epilogue,
-                    ELECTRA_ENCODED_EPILOGUE_SIZE,
-                    proto->data,
-                    ELECTRA_DECODED_DATA_SIZE);
-                result = true;
-            }
+    for(size_t i = 0; i < count && !result; i++) {
+        /*
+            EM 4100 BASE DATA (64 bit)         ELECTRA EPILOGUE (64 bit)
+        _________________________________  _________________________________
+        | | | | | | | | | | | | | | | | |  | | | | | | | | | | | | | | | | |    <- new data bit
+        ---------------------------------  --------------------------------- 
+                                         <- epilogue msb is carry bit to base data  
+        */
+        bool carry = proto->encoded_epilogue >> 63 & 0b1;
+
+        proto->encoded_base_data = (proto->encoded_base_data << 1) | carry;
+        proto->encoded_epilogue = (proto->encoded_epilogue << 1) | value;
+
+        if(electra_can_be_decoded(
+               (uint8_t*)&proto->encoded_base_data,
+               ELECTRA_ENCODED_BASE_DATA_SIZE,
+               (uint8_t*)&proto->encoded_epilogue,
+               ELECTRA_ENCODED_EPILOGUE_SIZE)) {
+            electra_decode(
+                (uint8_t*)&proto->encoded_base_data,
+                ELECTRA_ENCODED_BASE_DATA_SIZE,
+                (uint8_t*)&proto->encoded_epilogue,
+                ELECTRA_ENCODED_EPILOGUE_SIZE,
+                proto->data,
+                ELECTRA_DECODED_DATA_SIZE);
+            result = true;
         }
     }
 
@@ -445,7 +406,8 @@ const ProtocolBase protocol_electra = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_electra_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_electra_decoder_feed,
+            .demod = &lfrfid_demod_manchester_rf64,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_electra_decoder_feed_bits,
         },
     .encoder =
         {
@@ -2,6 +2,7 @@
 #include <toolbox/protocols/protocol.h>
 #include <toolbox/manchester_decoder.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 
 typedef uint64_t EM4100DecodedData;
 typedef uint64_t EM4100Epilogue;
@@ -217,6 +218,27 @@ void protocol_em4100_decoder_start(ProtocolEM4100* proto) {
         NULL);
 }
 
+static bool protocol_em4100_decoder_push_bit(ProtocolEM4100* proto, bool data) {
+    bool carry = proto->encoded_epilogue >> 63 & 0b1;
+
+    proto->encoded_data = (proto->encoded_data << 1) | carry;
+    proto->encoded_epilogue = (proto->encoded_epilogue << 1) | data;
+
+    if(em4100_can_be_decoded(
+           (uint8_t*)&proto->encoded_data,
+           sizeof(EM4100DecodedData),
+           (uint8_t*)&proto->encoded_epilogue)) {
+        em4100_decode(
+            (uint8_t*)&proto->encoded_data,
+            sizeof(EM4100DecodedData),
+            proto->data,
+            EM4100_DECODED_DATA_SIZE);
+        return true;
+    }
+
+    return false;
+}
+
 bool protocol_em4100_decoder_feed(ProtocolEM4100* proto, bool level, uint32_t duration) {
     bool result = false;
 
@@ -245,28 +267,24 @@ bool protocol_em4100_decoder_feed(ProtocolEM4100* proto, bool level, uint32_t du
             proto->decoder_manchester_state, event, &proto->decoder_manchester_state, &data);
 
         if(data_ok) {
-            bool carry = proto->encoded_epilogue >> 63 & 0b1;
-
-            proto->encoded_data = (proto->encoded_data << 1) | carry;
-            proto->encoded_epilogue = (proto->encoded_epilogue << 1) | data;
-
-            if(em4100_can_be_decoded(
-                   (uint8_t*)&proto->encoded_data,
-                   sizeof(EM4100DecodedData),
-                   (uint8_t*)&proto->encoded_epilogue)) {
-                em4100_decode(
-                    (uint8_t*)&proto->encoded_data,
-                    sizeof(EM4100DecodedData),
-                    proto->data,
-                    EM4100_DECODED_DATA_SIZE);
-                result = true;
-            }
+            result = protocol_em4100_decoder_push_bit(proto, data);
         }
     }
 
     return result;
 }
 
+// RF/64 timings match the shared demod, RF/32 and RF/16 variants use feed
+bool protocol_em4100_decoder_feed_bits(ProtocolEM4100* proto, bool value, uint32_t count) {
+    bool result = false;
+
+    for(size_t i = 0; i < count && !result; i++) {
+        result = protocol_em4100_decoder_push_bit(proto, value);
+    }
+
+    return result;
+}
+
 static void em4100_write_nibble(bool low_nibble, uint8_t data, EM4100DecodedData* encoded_data) {
     uint8_t parity_sum = 0;
     uint8_t start = 0;
@@ -392,7 +410,8 @@ const ProtocolBase protocol_em4100 = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_em4100_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_em4100_decoder_feed,
+            .demod = &lfrfid_demod_manchester_rf64,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_em4100_decoder_feed_bits,
         },
     .encoder =
         {
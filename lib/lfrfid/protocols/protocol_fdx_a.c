@@ -1,14 +1,10 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <lfrfid/tools/fsk_demod.h>
 #include <lfrfid/tools/fsk_osc.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 #include <bit_lib/bit_lib.h>
 
-#define JITTER_TIME (20)
-#define MIN_TIME    (64 - JITTER_TIME)
-#define MAX_TIME    (80 + JITTER_TIME)
-
 #define FDXA_DATA_SIZE     10
 #define FDXA_PREAMBLE_SIZE 2
 
@@ -20,10 +16,6 @@
 #define FDXA_PREAMBLE_0 0x55
 #define FDXA_PREAMBLE_1 0x1D
 
-typedef struct {
-    FSKDemod* fsk_demod;
-} ProtocolFDXADecoder;
-
 typedef struct {
     FSKOsc* fsk_osc;
     uint8_t encoded_index;
@@ -31,7 +23,6 @@ typedef struct {
 } ProtocolFDXAEncoder;
 
 typedef struct {
-    ProtocolFDXADecoder decoder;
     ProtocolFDXAEncoder encoder;
     uint8_t encoded_data[FDXA_ENCODED_DATA_SIZE];
     uint8_t data[FDXA_DECODED_DATA_SIZE];
@@ -40,14 +31,12 @@ typedef struct {
 
 ProtocolFDXA* protocol_fdx_a_alloc(void) {
     ProtocolFDXA* protocol = malloc(sizeof(ProtocolFDXA));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 }
 
 void protocol_fdx_a_free(ProtocolFDXA* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 }
@@ -107,19 +96,14 @@ static bool protocol_fdx_a_can_be_decoded(const uint8_t* data) {
     return parity_sum == 0;
 }
 
-bool protocol_fdx_a_decoder_feed(ProtocolFDXA* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_fdx_a_decoder_feed_bits(ProtocolFDXA* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
-    if(count > 0) {
-        for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, FDXA_ENCODED_DATA_SIZE, value);
-            if(protocol_fdx_a_can_be_decoded(protocol->encoded_data)) {
-                protocol_fdx_a_decode(protocol->encoded_data, protocol->data);
-                result = true;
-            }
+    for(size_t i = 0; i < count; i++) {
+        bit_lib_push_bit(protocol->encoded_data, FDXA_ENCODED_DATA_SIZE, value);
+        if(protocol_fdx_a_can_be_decoded(protocol->encoded_data)) {
+            protocol_fdx_a_decode(protocol->encoded_data, protocol->data);
+            result = true;
         }
     }
 
@@ -235,7 +219,8 @@ const ProtocolBase protocol_fdx_a = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_fdx_a_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_fdx_a_decoder_feed,
+            .demod = &lfrfid_demod_fsk2a_rf50,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_fdx_a_decoder_feed_bits,
         },
     .encoder =
         {
@@ -1,8 +1,8 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <toolbox/manchester_decoder.h>
 #include <bit_lib/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 
 #define GALLAGHER_CLOCK_PER_BIT (32)
 
@@ -14,23 +14,12 @@
     (GALLAGHER_ENCODED_BYTE_SIZE + GALLAGHER_PREAMBLE_BYTE_SIZE)
 #define GALLAGHER_DECODED_DATA_SIZE 8
 
-#define GALLAGHER_READ_SHORT_TIME  (128)
-#define GALLAGHER_READ_LONG_TIME   (256)
-#define GALLAGHER_READ_JITTER_TIME (60)
-
-#define GALLAGHER_READ_SHORT_TIME_LOW  (GALLAGHER_READ_SHORT_TIME - GALLAGHER_READ_JITTER_TIME)
-#define GALLAGHER_READ_SHORT_TIME_HIGH (GALLAGHER_READ_SHORT_TIME + GALLAGHER_READ_JITTER_TIME)
-#define GALLAGHER_READ_LONG_TIME_LOW   (GALLAGHER_READ_LONG_TIME - GALLAGHER_READ_JITTER_TIME)
-#define GALLAGHER_READ_LONG_TIME_HIGH  (GALLAGHER_READ_LONG_TIME + GALLAGHER_READ_JITTER_TIME)
-
 typedef struct {
     uint8_t data[GALLAGHER_DECODED_DATA_SIZE];
     uint8_t encoded_data[GALLAGHER_ENCODED_BYTE_FULL_SIZE];
 
     uint8_t encoded_data_index;
     bool encoded_polarity;
-
-    ManchesterState decoder_manchester_state;
 } ProtocolGallagher;
 
 ProtocolGallagher* protocol_gallagher_alloc(void) {
@@ -147,44 +136,20 @@ static bool protocol_gallagher_can_be_decoded(ProtocolGallagher* protocol) {
 
 void protocol_gallagher_decoder_start(ProtocolGallagher* protocol) {
     memset(protocol->encoded_data, 0, GALLAGHER_ENCODED_BYTE_FULL_SIZE);
-    manchester_advance(
-        protocol->decoder_manchester_state,
-        ManchesterEventReset,
-        &protocol->decoder_manchester_state,
-        NULL);
 }
 
-bool protocol_gallagher_decoder_feed(ProtocolGallagher* protocol, bool level, uint32_t duration) {
+bool protocol_gallagher_decoder_feed_bits(
+    ProtocolGallagher* protocol,
+    bool value,
+    uint32_t count) {
     bool result = false;
 
-    ManchesterEvent event = ManchesterEventReset;
-
-    if(duration > GALLAGHER_READ_SHORT_TIME_LOW && duration < GALLAGHER_READ_SHORT_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventShortHigh;
-        } else {
-            event = ManchesterEventShortLow;
-        }
-    } else if(duration > GALLAGHER_READ_LONG_TIME_LOW && duration < GALLAGHER_READ_LONG_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventLongHigh;
-        } else {
-            event = ManchesterEventLongLow;
-        }
-    }
-
-    if(event != ManchesterEventReset) {
-        bool data;
-        bool data_ok = manchester_advance(
-            protocol->decoder_manchester_state, event, &protocol->decoder_manchester_state, &data);
-
-        if(data_ok) {
-            bit_lib_push_bit(protocol->encoded_data, GALLAGHER_ENCODED_BYTE_FULL_SIZE, data);
+    for(size_t i = 0; i < count && !result; i++) {
+        bit_lib_push_bit(protocol->encoded_data, GALLAGHER_ENCODED_BYTE_FULL_SIZE, value);
 
-            if(protocol_gallagher_can_be_decoded(protocol)) {
-                protocol_gallagher_decode(protocol);
-                result = true;
-            }
+        if(protocol_gallagher_can_be_decoded(protocol)) {
+            protocol_gallagher_decode(protocol);
+            result = true;
         }
     }
 
@@ -332,7 +297,8 @@ const ProtocolBase protocol_gallagher = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_gallagher_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_gallagher_decoder_feed,
+            .demod = &lfrfid_demod_manchester_rf32,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_gallagher_decoder_feed_bits,
         },
     .encoder =
         {
@@ -1,8 +1,8 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <toolbox/manchester_decoder.h>
 #include <bit_lib/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 
 #define NORALSY_CLOCK_PER_BIT (32)
 
@@ -13,15 +13,6 @@
 #define NORALSY_ENCODED_BYTE_FULL_SIZE ((NORALSY_ENCODED_BIT_SIZE) / 8)
 #define NORALSY_DECODED_DATA_SIZE      ((NORALSY_ENCODED_BIT_SIZE) / 8)
 
-#define NORALSY_READ_SHORT_TIME  (128)
-#define NORALSY_READ_LONG_TIME   (256)
-#define NORALSY_READ_JITTER_TIME (60)
-
-#define NORALSY_READ_SHORT_TIME_LOW  (NORALSY_READ_SHORT_TIME - NORALSY_READ_JITTER_TIME)
-#define NORALSY_READ_SHORT_TIME_HIGH (NORALSY_READ_SHORT_TIME + NORALSY_READ_JITTER_TIME)
-#define NORALSY_READ_LONG_TIME_LOW   (NORALSY_READ_LONG_TIME - NORALSY_READ_JITTER_TIME)
-#define NORALSY_READ_LONG_TIME_HIGH  (NORALSY_READ_LONG_TIME + NORALSY_READ_JITTER_TIME)
-
 #define TAG "NORALSY"
 
 typedef struct {
@@ -30,8 +21,6 @@ typedef struct {
 
     uint8_t encoded_data_index;
     bool encoded_polarity;
-
-    ManchesterState decoder_manchester_state;
 } ProtocolNoralsy;
 
 ProtocolNoralsy* protocol_noralsy_alloc(void) {
@@ -74,44 +63,17 @@ static bool protocol_noralsy_can_be_decoded(ProtocolNoralsy* protocol) {
 
 void protocol_noralsy_decoder_start(ProtocolNoralsy* protocol) {
     memset(protocol->encoded_data, 0, NORALSY_ENCODED_BYTE_FULL_SIZE);
-    manchester_advance(
-        protocol->decoder_manchester_state,
-        ManchesterEventReset,
-        &protocol->decoder_manchester_state,
-        NULL);
 }
 
-bool protocol_noralsy_decoder_feed(ProtocolNoralsy* protocol, bool level, uint32_t duration) {
+bool protocol_noralsy_decoder_feed_bits(ProtocolNoralsy* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    ManchesterEvent event = ManchesterEventReset;
-
-    if(duration > NORALSY_READ_SHORT_TIME_LOW && duration < NORALSY_READ_SHORT_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventShortHigh;
-        } else {
-            event = ManchesterEventShortLow;
-        }
-    } else if(duration > NORALSY_READ_LONG_TIME_LOW && duration < NORALSY_READ_LONG_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventLongHigh;
-        } else {
-            event = ManchesterEventLongLow;
-        }
-    }
-
-    if(event != ManchesterEventReset) {
-        bool data;
-        bool data_ok = manchester_advance(
-            protocol->decoder_manchester_state, event, &protocol->decoder_manchester_state, &data);
-
-        if(data_ok) {
-            bit_lib_push_bit(protocol->encoded_data, NORALSY_ENCODED_BYTE_FULL_SIZE, data);
+    for(size_t i = 0; i < count && !result; i++) {
+        bit_lib_push_bit(protocol->encoded_data, NORALSY_ENCODED_BYTE_FULL_SIZE, value);
 
-            if(protocol_noralsy_can_be_decoded(protocol)) {
-                protocol_noralsy_decode(protocol);
-                result = true;
-            }
+        if(protocol_noralsy_can_be_decoded(protocol)) {
+            protocol_noralsy_decode(protocol);
+            result = true;
         }
     }
 
@@ -207,7 +169,8 @@ const ProtocolBase protocol_noralsy = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_noralsy_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_noralsy_decoder_feed,
+            .demod = &lfrfid_demod_manchester_rf32,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_noralsy_decoder_feed_bits,
         },
     .encoder =
         {
@@ -1,14 +1,10 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <lfrfid/tools/fsk_demod.h>
 #include <lfrfid/tools/fsk_osc.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 #include <bit_lib/bit_lib.h>
 
-#define JITTER_TIME (20)
-#define MIN_TIME    (64 - JITTER_TIME)
-#define MAX_TIME    (80 + JITTER_TIME)
-
 #define PYRAMID_DATA_SIZE     13
 #define PYRAMID_PREAMBLE_SIZE 3
 
@@ -18,10 +14,6 @@
 #define PYRAMID_DECODED_DATA_SIZE (4)
 #define PYRAMID_DECODED_BIT_SIZE  ((PYRAMID_ENCODED_BIT_SIZE - PYRAMID_PREAMBLE_SIZE * 8) / 2)
 
-typedef struct {
-    FSKDemod* fsk_demod;
-} ProtocolPyramidDecoder;
-
 typedef struct {
     FSKOsc* fsk_osc;
     uint8_t encoded_index;
@@ -29,7 +21,6 @@ typedef struct {
 } ProtocolPyramidEncoder;
 
 typedef struct {
-    ProtocolPyramidDecoder decoder;
     ProtocolPyramidEncoder encoder;
     uint8_t encoded_data[PYRAMID_ENCODED_DATA_SIZE];
     uint8_t data[PYRAMID_DECODED_DATA_SIZE];
@@ -37,14 +28,12 @@ typedef struct {
 
 ProtocolPyramid* protocol_pyramid_alloc(void) {
     ProtocolPyramid* protocol = malloc(sizeof(ProtocolPyramid));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 }
 
 void protocol_pyramid_free(ProtocolPyramid* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 }
@@ -105,19 +94,14 @@ static void protocol_pyramid_decode(ProtocolPyramid* protocol) {
     bit_lib_copy_bits(protocol->data, 16, 16, protocol->encoded_data, 81 + 8);
 }
 
-bool protocol_pyramid_decoder_feed(ProtocolPyramid* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_pyramid_decoder_feed_bits(ProtocolPyramid* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
-    if(count > 0) {
-        for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, PYRAMID_ENCODED_DATA_SIZE, value);
-            if(protocol_pyramid_can_be_decoded(protocol->encoded_data)) {
-                protocol_pyramid_decode(protocol);
-                result = true;
-            }
+    for(size_t i = 0; i < count; i++) {
+        bit_lib_push_bit(protocol->encoded_data, PYRAMID_ENCODED_DATA_SIZE, value);
+        if(protocol_pyramid_can_be_decoded(protocol->encoded_data)) {
+            protocol_pyramid_decode(protocol);
+            result = true;
         }
     }
 
@@ -270,7 +254,8 @@ const ProtocolBase protocol_pyramid = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_pyramid_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_pyramid_decoder_feed,
+            .demod = &lfrfid_demod_fsk2a_rf50,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_pyramid_decoder_feed_bits,
         },
     .encoder =
         {
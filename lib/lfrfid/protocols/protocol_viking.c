@@ -1,8 +1,8 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <toolbox/manchester_decoder.h>
 #include <bit_lib/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 
 #define VIKING_CLOCK_PER_BIT (32)
 
@@ -13,23 +13,12 @@
 #define VIKING_ENCODED_BYTE_FULL_SIZE (VIKING_ENCODED_BYTE_SIZE + VIKING_PREAMBLE_BYTE_SIZE)
 #define VIKING_DECODED_DATA_SIZE      4
 
-#define VIKING_READ_SHORT_TIME  (128)
-#define VIKING_READ_LONG_TIME   (256)
-#define VIKING_READ_JITTER_TIME (60)
-
-#define VIKING_READ_SHORT_TIME_LOW  (VIKING_READ_SHORT_TIME - VIKING_READ_JITTER_TIME)
-#define VIKING_READ_SHORT_TIME_HIGH (VIKING_READ_SHORT_TIME + VIKING_READ_JITTER_TIME)
-#define VIKING_READ_LONG_TIME_LOW   (VIKING_READ_LONG_TIME - VIKING_READ_JITTER_TIME)
-#define VIKING_READ_LONG_TIME_HIGH  (VIKING_READ_LONG_TIME + VIKING_READ_JITTER_TIME)
-
 typedef struct {
     uint8_t data[VIKING_DECODED_DATA_SIZE];
     uint8_t encoded_data[VIKING_ENCODED_BYTE_FULL_SIZE];
 
     uint8_t encoded_data_index;
     bool encoded_polarity;
-
-    ManchesterState decoder_manchester_state;
 } ProtocolViking;
 
 ProtocolViking* protocol_viking_alloc(void) {
@@ -75,44 +64,17 @@ static bool protocol_viking_can_be_decoded(ProtocolViking* protocol) {
 
 void protocol_viking_decoder_start(ProtocolViking* protocol) {
     memset(protocol->encoded_data, 0, VIKING_ENCODED_BYTE_FULL_SIZE);
-    manchester_advance(
-        protocol->decoder_manchester_state,
-        ManchesterEventReset,
-        &protocol->decoder_manchester_state,
-        NULL);
 }
 
-bool protocol_viking_decoder_feed(ProtocolViking* protocol, bool level, uint32_t duration) {
+bool protocol_viking_decoder_feed_bits(ProtocolViking* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    ManchesterEvent event = ManchesterEventReset;
-
-    if(duration > VIKING_READ_SHORT_TIME_LOW && duration < VIKING_READ_SHORT_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventShortHigh;
-        } else {
-            event = ManchesterEventShortLow;
-        }
-    } else if(duration > VIKING_READ_LONG_TIME_LOW && duration < VIKING_READ_LONG_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventLongHigh;
-        } else {
-            event = ManchesterEventLongLow;
-        }
-    }
-
-    if(event != ManchesterEventReset) {
-        bool data;
-        bool data_ok = manchester_advance(
-            protocol->decoder_manchester_state, event, &protocol->decoder_manchester_state, &data);
-
-        if(data_ok) {
-            bit_lib_push_bit(protocol->encoded_data, VIKING_ENCODED_BYTE_FULL_SIZE, data);
+    for(size_t i = 0; i < count && !result; i++) {
+        bit_lib_push_bit(protocol->encoded_data, VIKING_ENCODED_BYTE_FULL_SIZE, value);
 
-            if(protocol_viking_can_be_decoded(protocol)) {
-                protocol_viking_decode(protocol);
-                result = true;
-            }
+        if(protocol_viking_can_be_decoded(protocol)) {
+            protocol_viking_decode(protocol);
+            result = true;
         }
     }
 
@@ -204,7 +166,8 @@ const ProtocolBase protocol_viking = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_viking_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_viking_decoder_feed,
+            .demod = &lfrfid_demod_manchester_rf32,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_viking_decoder_feed_bits,
         },
     .encoder =
         {
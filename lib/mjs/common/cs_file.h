@@ -33,6 +33,12 @@ extern "C" {
  */
 char *cs_read_file(const char *path, size_t *size);
 
+/*
+ * Write `size` bytes of `data` to file `path`, replacing its content.
+ * Return: 1 on success, 0 on error.
+ */
+int cs_write_file(const char *path, const char *data, size_t size);
+
 #ifdef CS_MMAP
 /*
  * Only on platforms which support mmapping: mmap file `path` to the returned
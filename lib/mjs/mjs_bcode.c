@@ -3,13 +3,29 @@
  * All rights reserved
  */
 
+#include "common/cs_file.h"
 #include "common/cs_varint.h"
 
 #include "mjs_internal.h"
 #include "mjs_bcode.h"
 #include "mjs_core.h"
+#include "mjs_string.h"
 #include "mjs_tok.h"
 
+#define MJS_BCODE_CACHE_MAGIC 0x43534A4D /* "MJSC" */
+#define MJS_BCODE_CACHE_EXT ".jsc"
+
+/*
+ * Bcode cache file is the bcode part itself followed by the trailer, so the
+ * file can be read and used as is
+ */
+struct mjs_bcode_cache_trailer {
+    struct mjs_bcode_cache_key key;
+    uint32_t bcode_size;
+    uint32_t version; /* MJS_BCODE_VERSION and OP_MAX */
+    uint32_t magic; /* Last, so that a truncated file never matches */
+};
+
 static void add_lineno_map_item(struct pstate* pstate) {
     if(pstate->last_emitted_line_no < pstate->line_no) {
         int offset = pstate->cur_idx - pstate->start_bcode_idx;
@@ -127,17 +143,27 @@ MJS_PRIVATE int mjs_bcode_parts_cnt(struct mjs* mjs) {
 }
 
 MJS_PRIVATE void mjs_bcode_commit(struct mjs* mjs) {
-    struct mjs_bcode_part bp;
-    memset(&bp, 0, sizeof(bp));
+    char* data;
+    size_t len;
 
     /* Make sure the bcode doesn't occupy any extra space */
     mbuf_trim(&mjs->bcode_gen);
 
     /* Transfer the ownership of the bcode data */
-    bp.data.p = mjs->bcode_gen.buf;
-    bp.data.len = mjs->bcode_gen.len;
+    data = mjs->bcode_gen.buf;
+    len = mjs->bcode_gen.len;
     mbuf_init(&mjs->bcode_gen, 0);
 
+    mjs_bcode_commit_data(mjs, data, len);
+}
+
+MJS_PRIVATE void mjs_bcode_commit_data(struct mjs* mjs, char* data, size_t len) {
+    struct mjs_bcode_part bp;
+    memset(&bp, 0, sizeof(bp));
+
+    bp.data.p = data;
+    bp.data.len = len;
+
     bp.start_idx = mjs->bcode_len;
     bp.exec_res = MJS_ERRS_CNT;
 
@@ -145,3 +171,111 @@ MJS_PRIVATE void mjs_bcode_commit(struct mjs* mjs) {
 
     mjs->bcode_len += bp.data.len;
 }
+
+#if MJS_BCODE_CACHE
+/*
+ * Returns malloc'ed name of the cache file, or NULL if the source file
+ * doesn't have the .js extension
+ */
+static char* mjs_bcode_cache_path(const char* path) {
+    size_t len = strlen(path);
+    char* cache_path;
+
+    if(len <= 3 || strcmp(path + len - 3, ".js") != 0) return NULL;
+
+    cache_path = malloc(len - 3 + sizeof(MJS_BCODE_CACHE_EXT));
+    if(cache_path == NULL) return NULL;
+    memcpy(cache_path, path, len - 3);
+    memcpy(cache_path + len - 3, MJS_BCODE_CACHE_EXT, sizeof(MJS_BCODE_CACHE_EXT));
+    return cache_path;
+}
+
+static void mjs_bcode_cache_trailer_init(
+    struct mjs_bcode_cache_trailer* trailer,
+    const struct mjs_bcode_cache_key* key,
+    size_t bcode_size) {
+    memset(trailer, 0, sizeof(*trailer));
+    trailer->key = *key;
+    trailer->bcode_size = bcode_size;
+    trailer->version = (MJS_BCODE_VERSION << 8) | OP_MAX;
+    trailer->magic = MJS_BCODE_CACHE_MAGIC;
+}
+
+MJS_PRIVATE void
+    mjs_bcode_cache_key_init(struct mjs_bcode_cache_key* key, const char* src, size_t size) {
+    key->source_size = size;
+    key->source_hash = mjs_str_hash(src, size);
+}
+
+MJS_PRIVATE int mjs_bcode_cache_load(
+    struct mjs* mjs,
+    const char* path,
+    const struct mjs_bcode_cache_key* key) {
+    struct mjs_bcode_cache_trailer expected, trailer;
+    size_t size, bcode_size;
+    size_t filename_offset =
+        1 /* OP_BCODE_HEADER */ + sizeof(mjs_header_item_t) * MJS_HDR_ITEMS_CNT;
+    mjs_header_item_t total_size;
+    char* cache_path = mjs_bcode_cache_path(path);
+    char* data = NULL;
+    int loaded = 0;
+
+    if(cache_path != NULL) {
+        data = cs_read_file(cache_path, &size);
+        free(cache_path);
+    }
+    if(data == NULL) return 0;
+
+    do {
+        if(size < sizeof(trailer) + filename_offset) break;
+        bcode_size = size - sizeof(trailer);
+        memcpy(&trailer, data + bcode_size, sizeof(trailer));
+        mjs_bcode_cache_trailer_init(&expected, key, bcode_size);
+        if(memcmp(&trailer, &expected, sizeof(trailer)) != 0) break;
+
+        /* Sanity check of the bcode header, and the file must not have been renamed */
+        memcpy(
+            &total_size,
+            data + 1 + sizeof(mjs_header_item_t) * MJS_HDR_ITEM_TOTAL_SIZE,
+            sizeof(total_size));
+        if(data[0] != OP_BCODE_HEADER || total_size + 1 != bcode_size) break;
+        if(strlen(path) + 1 > bcode_size - filename_offset ||
+           strcmp(data + filename_offset, path) != 0) {
+            break;
+        }
+
+        mjs_bcode_commit_data(mjs, data, bcode_size);
+        loaded = 1;
+    } while(0);
+
+    if(!loaded) free(data);
+    return loaded;
+}
+
+MJS_PRIVATE void mjs_bcode_cache_save(
+    struct mjs* mjs,
+    const char* path,
+    const struct mjs_bcode_cache_key* key) {
+    struct mjs_bcode_part* bp = mjs_bcode_part_get(mjs, mjs_bcode_parts_cnt(mjs) - 1);
+    struct mjs_bcode_cache_trailer trailer;
+    char* cache_path = mjs_bcode_cache_path(path);
+    char* data;
+
+    if(cache_path == NULL || bp->in_rom) {
+        free(cache_path);
+        return;
+    }
+
+    /* Bcode part grows by the trailer to be written in one go, its length stays the same */
+    data = realloc((char*)bp->data.p, bp->data.len + sizeof(trailer));
+    if(data != NULL) {
+        bp->data.p = data;
+        mjs_bcode_cache_trailer_init(&trailer, key, bp->data.len);
+        memcpy(data + bp->data.len, &trailer, sizeof(trailer));
+        if(!cs_write_file(cache_path, data, bp->data.len + sizeof(trailer))) {
+            LOG(LL_WARN, ("Failed to write %s", cache_path));
+        }
+    }
+    free(cache_path);
+}
+#endif
@@ -60,6 +60,20 @@ enum mjs_opcode {
 struct pstate;
 struct mjs;
 
+/*
+ * Version of the bcode format. Bcode cache files of other versions are
+ * ignored, so bump it on any bcode change that keeps OP_MAX the same.
+ */
+#define MJS_BCODE_VERSION 1
+
+/*
+ * Bcode cache files are keyed by the source they were generated from
+ */
+struct mjs_bcode_cache_key {
+    uint32_t source_size;
+    uint32_t source_hash;
+};
+
 MJS_PRIVATE void emit_byte(struct pstate* pstate, uint8_t byte);
 MJS_PRIVATE void emit_int(struct pstate* pstate, int64_t n);
 MJS_PRIVATE void emit_str(struct pstate* pstate, const char* ptr, size_t len);
@@ -98,6 +112,35 @@ MJS_PRIVATE int mjs_bcode_parts_cnt(struct mjs* mjs);
  */
 MJS_PRIVATE void mjs_bcode_commit(struct mjs* mjs);
 
+/*
+ * Adds malloc'ed `data` of `len` bytes as a next bcode part, takes ownership
+ * of `data`
+ */
+MJS_PRIVATE void mjs_bcode_commit_data(struct mjs* mjs, char* data, size_t len);
+
+#if MJS_BCODE_CACHE
+MJS_PRIVATE void
+    mjs_bcode_cache_key_init(struct mjs_bcode_cache_key* key, const char* src, size_t size);
+
+/*
+ * Adds bcode from the cache file of the source file `path` as a next bcode
+ * part, if the cache is there and matches `key`. Returns 1 on success.
+ */
+MJS_PRIVATE int mjs_bcode_cache_load(
+    struct mjs* mjs,
+    const char* path,
+    const struct mjs_bcode_cache_key* key);
+
+/*
+ * Saves the last bcode part, generated from the source file `path`, to the
+ * cache file
+ */
+MJS_PRIVATE void mjs_bcode_cache_save(
+    struct mjs* mjs,
+    const char* path,
+    const struct mjs_bcode_cache_key* key);
+#endif
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
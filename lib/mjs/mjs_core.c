@@ -61,6 +61,7 @@ void mjs_destroy(struct mjs* mjs) {
     mbuf_free(&mjs->loop_addresses);
     mbuf_free(&mjs->json_visited_stack);
     mbuf_free(&mjs->array_buffers);
+    free(mjs->interned_strings);
     free(mjs->error_msg);
     free(mjs->stack_trace);
     mjs_ffi_args_free_list(mjs);
@@ -89,6 +90,9 @@ struct mjs* mjs_create(void* context) {
 
     mjs->bcode_len = 0;
 
+    /* Zeroed inline cache entries must never match */
+    mjs->prop_cache_epoch = 1;
+
     /*
    * The compacting GC exploits the null terminator of the previous string as a
    * marker.
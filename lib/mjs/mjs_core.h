@@ -60,6 +60,31 @@ struct mjs_bcode_part {
     unsigned in_rom : 1;
 };
 
+/*
+ * Number of OP_GET inline cache entries, a power of two
+ */
+#ifndef MJS_PROP_CACHE_SIZE
+#define MJS_PROP_CACHE_SIZE 32
+#endif
+
+/*
+ * Inline cache entry, selected by the bcode offset of an OP_GET: the own
+ * property `prop` of `obj` named `key`. Valid as long as `epoch` matches
+ * `mjs::prop_cache_epoch`, which changes whenever properties may be removed
+ * or strings moved.
+ */
+struct mjs_prop_cache_entry {
+    mjs_val_t key;
+    struct mjs_object* obj;
+    struct mjs_property* prop;
+    uint32_t epoch;
+};
+
+struct mjs_interned_string {
+    mjs_val_t value; /* Owned string, 0 for an empty slot */
+    uint32_t hash;
+};
+
 struct mjs {
     struct mbuf bcode_gen;
     struct mbuf bcode_parts;
@@ -89,6 +114,13 @@ struct mjs {
     struct gc_arena property_arena;
     struct gc_arena ffi_sig_arena;
 
+    struct mjs_interned_string* interned_strings; /* Open addressing, NULL until used */
+    size_t interned_strings_mask; /* Capacity minus one */
+    size_t interned_strings_count;
+
+    struct mjs_prop_cache_entry prop_cache[MJS_PROP_CACHE_SIZE];
+    uint32_t prop_cache_epoch;
+
     unsigned inhibit_gc : 1;
     unsigned need_gc : 1;
     unsigned generate_jsc : 1;
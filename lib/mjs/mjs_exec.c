@@ -627,6 +627,42 @@ static int getprop_builtin(struct mjs* mjs, mjs_val_t val, mjs_val_t name, mjs_v
     return handled;
 }
 
+/*
+ * Inline cache of OP_GET: a property found by the same key on the same object
+ * last time is reused without a lookup. Only own properties of objects and
+ * arrays are cached, keys that getprop_builtin() handles never get there.
+ */
+static struct mjs_property* mjs_prop_cache_lookup(
+    struct mjs* mjs,
+    const struct mjs_prop_cache_entry* cache,
+    mjs_val_t obj,
+    mjs_val_t key) {
+    if(cache->epoch == mjs->prop_cache_epoch && cache->key == key && mjs_is_object(obj) &&
+       cache->obj == get_object_struct(obj)) {
+        return cache->prop;
+    }
+    return NULL;
+}
+
+static mjs_val_t mjs_prop_cache_get(
+    struct mjs* mjs,
+    struct mjs_prop_cache_entry* cache,
+    mjs_val_t obj,
+    mjs_val_t key) {
+    struct mjs_property* p = mjs_get_own_property_v(mjs, obj, key);
+    if(p == NULL) {
+        return mjs_get_v_proto(mjs, obj, key);
+    }
+
+    if(mjs_is_string(key)) {
+        cache->key = key;
+        cache->obj = get_object_struct(obj);
+        cache->prop = p;
+        cache->epoch = mjs->prop_cache_epoch;
+    }
+    return p->value;
+}
+
 MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
     size_t i;
     uint8_t prev_opcode = OP_MAX;
@@ -766,10 +802,15 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
             mjs_val_t obj = mjs_pop(mjs);
             mjs_val_t key = mjs_pop(mjs);
             mjs_val_t val = MJS_UNDEFINED;
+            struct mjs_prop_cache_entry* cache =
+                &mjs->prop_cache[(bp.start_idx + i) & (MJS_PROP_CACHE_SIZE - 1)];
+            struct mjs_property* p = mjs_prop_cache_lookup(mjs, cache, obj, key);
 
-            if(!getprop_builtin(mjs, obj, key, &val)) {
+            if(p != NULL) {
+                val = p->value;
+            } else if(!getprop_builtin(mjs, obj, key, &val)) {
                 if(mjs_is_object(obj)) {
-                    val = mjs_get_v_proto(mjs, obj, key);
+                    val = mjs_prop_cache_get(mjs, cache, obj, key);
                 } else if((mjs_is_data_view(obj) && (mjs_is_number(key)))) {
                     val = mjs_dataview_get_prop(mjs, obj, key);
                 } else {
@@ -809,7 +850,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
             break;
         case OP_PUSH_STR: {
             int llen, n = cs_varint_decode_unsafe(&code[i + 1], &llen);
-            mjs_push(mjs, mjs_mk_string(mjs, (char*)code + i + 1 + llen, n, 1));
+            mjs_push(mjs, mjs_mk_string_interned(mjs, (char*)code + i + 1 + llen, n));
             i += llen + n;
             break;
         }
@@ -941,7 +982,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
             int llen1, llen2, n, arg_no = cs_varint_decode_unsafe(&code[i + 1], &llen1);
             mjs_val_t obj, key, v;
             n = cs_varint_decode_unsafe(&code[i + llen1 + 1], &llen2);
-            key = mjs_mk_string(mjs, (char*)code + i + 1 + llen1 + llen2, n, 1);
+            key = mjs_mk_string_interned(mjs, (char*)code + i + 1 + llen1 + llen2, n);
             obj = vtop(&mjs->scopes);
             v = mjs_arg(mjs, arg_no);
             mjs_set_v(mjs, obj, key, v);
@@ -1089,6 +1130,7 @@ MJS_PRIVATE mjs_err_t mjs_exec_internal(
     const char* path,
     const char* src,
     int generate_jsc,
+    const struct mjs_bcode_cache_key* cache_key,
     mjs_val_t* res) {
     size_t off = mjs->bcode_len;
     mjs_val_t r = MJS_UNDEFINED;
@@ -1164,6 +1206,12 @@ MJS_PRIVATE mjs_err_t mjs_exec_internal(
         (void)generate_jsc;
 #endif
 
+#if MJS_BCODE_CACHE
+        if(cache_key != NULL) mjs_bcode_cache_save(mjs, path, cache_key);
+#else
+        (void)cache_key;
+#endif
+
         mjs_execute(mjs, off, &r);
     }
     if(res != NULL) *res = r;
@@ -1171,7 +1219,7 @@ MJS_PRIVATE mjs_err_t mjs_exec_internal(
 }
 
 mjs_err_t mjs_exec(struct mjs* mjs, const char* src, mjs_val_t* res) {
-    return mjs_exec_internal(mjs, "<stdin>", src, 0 /* generate_jsc */, res);
+    return mjs_exec_internal(mjs, "<stdin>", src, 0 /* generate_jsc */, NULL, res);
 }
 
 mjs_err_t mjs_exec_file(struct mjs* mjs, const char* path, mjs_val_t* res) {
@@ -1187,7 +1235,32 @@ mjs_err_t mjs_exec_file(struct mjs* mjs, const char* path, mjs_val_t* res) {
     }
 
     r = MJS_UNDEFINED;
-    error = mjs_exec_internal(mjs, path, source_code, -1, &r);
+#if MJS_BCODE_CACHE
+    {
+        struct mjs_bcode_cache_key key;
+        size_t off = mjs->bcode_len;
+        mjs_bcode_cache_key_init(&key, source_code, size);
+
+        /* Free the source first, so that it doesn't take RAM along with the bcode */
+        free(source_code);
+        if(mjs_bcode_cache_load(mjs, path, &key)) {
+            error = mjs_execute(mjs, off, &r);
+            goto clean;
+        }
+
+        /* No valid cache, read the source again to parse it */
+        source_code = cs_read_file(path, &size);
+        if(source_code == NULL) {
+            error = MJS_FILE_READ_ERROR;
+            mjs_prepend_errorf(mjs, error, "failed to read file \"%s\"", path);
+            goto clean;
+        }
+        mjs_bcode_cache_key_init(&key, source_code, size);
+        error = mjs_exec_internal(mjs, path, source_code, -1, &key, &r);
+    }
+#else
+    error = mjs_exec_internal(mjs, path, source_code, -1, NULL, &r);
+#endif
     free(source_code);
 
 clean:
@@ -30,4 +30,17 @@
 #endif
 #endif
 
+/*
+ * MJS_BCODE_CACHE: if enabled, bcode of any .js file executed by
+ * `mjs_exec_file()` is saved to a .jsc file next to it, together with the
+ * source hash and bcode version. Later runs load the bcode from there instead
+ * of parsing the source again. Unlike MJS_GENERATE_JSC it doesn't need
+ * mmapping, so the two are mutually exclusive.
+ *
+ * By default it's enabled unless MJS_GENERATE_JSC is
+ */
+#if !defined(MJS_BCODE_CACHE)
+#define MJS_BCODE_CACHE (!MJS_GENERATE_JSC)
+#endif
+
 #endif /* MJS_FEATURES_H_ */
@@ -494,8 +494,19 @@ void mjs_gc(struct mjs* mjs, int full) {
 
     gc_mark_ffi_cbargs_list(mjs, mjs->ffi_cb_args);
 
+    if(mjs->interned_strings != NULL) {
+        for(size_t i = 0; i <= mjs->interned_strings_mask; i++) {
+            if(mjs->interned_strings[i].value != 0) {
+                gc_mark(mjs, &mjs->interned_strings[i].value);
+            }
+        }
+    }
+
     gc_compact_strings(mjs);
 
+    /* Strings have moved and cells are about to be reused */
+    mjs->prop_cache_epoch++;
+
     gc_sweep(mjs, &mjs->object_arena, 0);
     gc_sweep(mjs, &mjs->property_arena, 0);
     gc_sweep(mjs, &mjs->ffi_sig_arena, 0);
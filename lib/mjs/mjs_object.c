@@ -27,11 +27,13 @@ MJS_PRIVATE void mjs_obj_destructor(struct mjs* mjs, void* cell) {
 
     struct mjs_property* destructor = mjs_get_own_property(
         mjs, obj_val, MJS_DESTRUCTOR_PROP_NAME, strlen(MJS_DESTRUCTOR_PROP_NAME));
-    if(!destructor) return;
-    if(!mjs_is_foreign(destructor->value)) return;
+    if(destructor && mjs_is_foreign(destructor->value)) {
+        mjs_custom_obj_destructor_t destructor_fn = mjs_get_ptr(mjs, destructor->value);
+        if(destructor_fn) destructor_fn(mjs, obj_val);
+    }
 
-    mjs_custom_obj_destructor_t destructor_fn = mjs_get_ptr(mjs, destructor->value);
-    if(destructor_fn) destructor_fn(mjs, obj_val);
+    free(obj->table);
+    obj->table = NULL;
 }
 
 MJS_PRIVATE struct mjs_object* get_object_struct(mjs_val_t v) {
@@ -64,38 +66,152 @@ int mjs_is_object_based(mjs_val_t v) {
            ((v & MJS_TAG_MASK) == MJS_TAG_ARRAY_BUF_VIEW);
 }
 
-MJS_PRIVATE struct mjs_property*
-    mjs_get_own_property(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
+/*
+ * Names up to 5 chars are inlined into the value, so they are compared as
+ * values. Longer names are compared by contents, unless `key` is the very same
+ * value, which is the case for interned literals.
+ */
+static int mjs_prop_name_matches(
+    struct mjs* mjs,
+    struct mjs_property* p,
+    mjs_val_t key,
+    const char* name,
+    size_t len) {
+    if(p->name == key) return 1;
+    if(len <= 5) return 0;
+    return mjs_strcmp(mjs, &p->name, name, len) == 0;
+}
+
+static void
+    mjs_prop_table_insert(struct mjs_prop_table* t, struct mjs_property* p, uint32_t hash) {
+    size_t idx = hash & t->mask;
+    while(t->entries[idx].prop != NULL) {
+        idx = (idx + 1) & t->mask;
+    }
+    t->entries[idx].hash = hash;
+    t->entries[idx].prop = p;
+    t->count++;
+}
+
+static uint32_t mjs_prop_hash(struct mjs* mjs, struct mjs_property* p) {
+    size_t n;
+    const char* s = mjs_get_string(mjs, &p->name, &n);
+    return mjs_str_hash(s, n);
+}
+
+/*
+ * (Re)builds the index of all `count` properties of the object, with at least
+ * half of the slots left empty
+ */
+static void mjs_prop_table_build(struct mjs* mjs, struct mjs_object* o, size_t count) {
+    struct mjs_prop_table* t;
     struct mjs_property* p;
-    struct mjs_object* o;
+    size_t size = 16;
 
-    if(!mjs_is_object_based(obj)) {
-        return NULL;
+    while(size < count * 4) {
+        size *= 2;
+    }
+
+    free(o->table);
+    o->table = t = calloc(1, sizeof(*t) + size * sizeof(t->entries[0]));
+    if(t == NULL) return;
+
+    t->mask = size - 1;
+    for(p = o->properties; p != NULL; p = p->next) {
+        mjs_prop_table_insert(t, p, mjs_prop_hash(mjs, p));
+    }
+}
+
+static void mjs_prop_table_remove(struct mjs* mjs, struct mjs_object* o, struct mjs_property* p) {
+    struct mjs_prop_table* t = o->table;
+    size_t idx = mjs_prop_hash(mjs, p) & t->mask;
+    size_t next;
+
+    while(t->entries[idx].prop != p) {
+        idx = (idx + 1) & t->mask;
     }
 
-    o = get_object_struct(obj);
+    /* Shift back the entries that would become unreachable */
+    for(next = (idx + 1) & t->mask; t->entries[next].prop != NULL;
+        next = (next + 1) & t->mask) {
+        size_t home = t->entries[next].hash & t->mask;
+        if(((next - home) & t->mask) >= ((next - idx) & t->mask)) {
+            t->entries[idx] = t->entries[next];
+            idx = next;
+        }
+    }
+    t->entries[idx].prop = NULL;
+    t->count--;
+}
 
+/*
+ * Looks up an own property by name. `key` is either the name as a string
+ * value or MJS_UNDEFINED. If `count` is not NULL and the property is not
+ * found, it is set to the number of properties the object has.
+ */
+static struct mjs_property* mjs_find_own_property(
+    struct mjs* mjs,
+    struct mjs_object* o,
+    const char* name,
+    size_t len,
+    mjs_val_t key,
+    size_t* count) {
+    struct mjs_property* p;
+    size_t n = 0;
+
+    if(len == (size_t)~0) {
+        len = strlen(name);
+    }
     if(len <= 5) {
-        mjs_val_t ss = mjs_mk_string(mjs, name, len, 1);
-        for(p = o->properties; p != NULL; p = p->next) {
-            if(p->name == ss) return p;
+        key = mjs_mk_string(mjs, name, len, 1);
+    }
+
+    if(o->table != NULL) {
+        struct mjs_prop_table* t = o->table;
+        uint32_t hash = mjs_str_hash(name, len);
+        size_t idx;
+        for(idx = hash & t->mask; t->entries[idx].prop != NULL; idx = (idx + 1) & t->mask) {
+            p = t->entries[idx].prop;
+            if(t->entries[idx].hash == hash && mjs_prop_name_matches(mjs, p, key, name, len)) {
+                return p;
+            }
         }
+        n = t->count;
     } else {
-        for(p = o->properties; p != NULL; p = p->next) {
-            if(mjs_strcmp(mjs, &p->name, name, len) == 0) return p;
+        for(p = o->properties; p != NULL; p = p->next, n++) {
+            if(mjs_prop_name_matches(mjs, p, key, name, len)) return p;
         }
-        return p;
     }
 
+    if(count != NULL) *count = n;
     return NULL;
 }
 
+MJS_PRIVATE struct mjs_property*
+    mjs_get_own_property(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
+    if(!mjs_is_object_based(obj)) {
+        return NULL;
+    }
+
+    return mjs_find_own_property(mjs, get_object_struct(obj), name, len, MJS_UNDEFINED, NULL);
+}
+
 MJS_PRIVATE struct mjs_property*
     mjs_get_own_property_v(struct mjs* mjs, mjs_val_t obj, mjs_val_t key) {
     size_t n;
     char* s = NULL;
     int need_free = 0;
     struct mjs_property* p = NULL;
+
+    if(mjs_is_string(key)) {
+        /* No conversion needed, and the key itself can be matched */
+        const char* name = mjs_get_string(mjs, &key, &n);
+        if(!mjs_is_object_based(obj)) {
+            return NULL;
+        }
+        return mjs_find_own_property(mjs, get_object_struct(obj), name, n, key, NULL);
+    }
+
     mjs_err_t err = mjs_to_string(mjs, &key, &s, &n, &need_free);
     if(err == MJS_OK) {
         p = mjs_get_own_property(mjs, obj, s, n);
@@ -175,6 +291,7 @@ MJS_PRIVATE mjs_err_t mjs_set_internal(
     mjs_err_t rcode = MJS_OK;
 
     struct mjs_property* p;
+    size_t prop_count = 0;
 
     int need_free = 0;
 
@@ -192,7 +309,11 @@ MJS_PRIVATE mjs_err_t mjs_set_internal(
         name_v = MJS_UNDEFINED;
     }
 
-    p = mjs_get_own_property(mjs, obj, name, name_len);
+    p = NULL;
+    if(mjs_is_object_based(obj)) {
+        p = mjs_find_own_property(
+            mjs, get_object_struct(obj), name, name_len, name_v, &prop_count);
+    }
 
     if(p == NULL) {
         struct mjs_object* o;
@@ -213,6 +334,13 @@ MJS_PRIVATE mjs_err_t mjs_set_internal(
         o = get_object_struct(obj);
         p->next = o->properties;
         o->properties = p;
+
+        prop_count++;
+        if(o->table != NULL && (o->table->count + 1) * 2 <= o->table->mask + 1) {
+            mjs_prop_table_insert(o->table, p, mjs_prop_hash(mjs, p));
+        } else if(prop_count >= MJS_PROP_TABLE_THRESHOLD) {
+            mjs_prop_table_build(mjs, o, prop_count);
+        }
     }
 
     p->value = val;
@@ -246,11 +374,17 @@ int mjs_del(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
         size_t n;
         const char* s = mjs_get_string(mjs, &prop->name, &n);
         if(n == len && strncmp(s, name, len) == 0) {
+            struct mjs_object* o = get_object_struct(obj);
+            if(o->table != NULL) {
+                mjs_prop_table_remove(mjs, o, prop);
+            }
             if(prev) {
                 prev->next = prop->next;
             } else {
-                get_object_struct(obj)->properties = prop->next;
+                o->properties = prop->next;
             }
+            /* Inline caches may point to this property */
+            mjs->prop_cache_epoch++;
             mjs_destroy_property(&prop);
             return 0;
         }
@@ -21,8 +21,32 @@ struct mjs_property {
     mjs_val_t value; /* Property value */
 };
 
+/*
+ * Objects with at least that many properties get a hash index over their
+ * property list, see struct mjs_prop_table
+ */
+#ifndef MJS_PROP_TABLE_THRESHOLD
+#define MJS_PROP_TABLE_THRESHOLD 8
+#endif
+
+struct mjs_prop_table_entry {
+    uint32_t hash; /* Hash of the property name, see mjs_str_hash() */
+    struct mjs_property* prop; /* NULL for an empty slot */
+};
+
+/*
+ * Open addressing hash index over the property list, linear probing. The list
+ * stays the primary storage, the index only speeds up lookups by name.
+ */
+struct mjs_prop_table {
+    size_t count;
+    size_t mask; /* Capacity minus one, capacity is a power of two */
+    struct mjs_prop_table_entry entries[];
+};
+
 struct mjs_object {
     struct mjs_property* properties;
+    struct mjs_prop_table* table; /* NULL until the object gets big enough */
 };
 
 MJS_PRIVATE struct mjs_object* get_object_struct(mjs_val_t v);
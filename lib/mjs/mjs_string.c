@@ -286,6 +286,77 @@ MJS_PRIVATE mjs_val_t s_concat(struct mjs* mjs, mjs_val_t a, mjs_val_t b) {
     return res;
 }
 
+MJS_PRIVATE uint32_t mjs_str_hash(const char* p, size_t len) {
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    while(len-- > 0) {
+        hash = (hash ^ (uint8_t)*p++) * 16777619u;
+    }
+    return hash;
+}
+
+static struct mjs_interned_string*
+    mjs_interned_strings_slot(struct mjs* mjs, const char* p, size_t len, uint32_t hash) {
+    size_t idx = hash & mjs->interned_strings_mask;
+    for(;;) {
+        struct mjs_interned_string* slot = &mjs->interned_strings[idx];
+        if(slot->value == 0) return slot;
+        if(slot->hash == hash) {
+            size_t n;
+            const char* s = mjs_get_string(mjs, &slot->value, &n);
+            if(n == len && memcmp(s, p, len) == 0) return slot;
+        }
+        idx = (idx + 1) & mjs->interned_strings_mask;
+    }
+}
+
+static void mjs_interned_strings_grow(struct mjs* mjs) {
+    struct mjs_interned_string* old = mjs->interned_strings;
+    size_t old_size = old ? mjs->interned_strings_mask + 1 : 0;
+    size_t size = old_size ? old_size * 2 : 32;
+
+    mjs->interned_strings = calloc(size, sizeof(struct mjs_interned_string));
+    if(mjs->interned_strings == NULL) abort();
+    mjs->interned_strings_mask = size - 1;
+
+    for(size_t i = 0; i < old_size; i++) {
+        if(old[i].value == 0) continue;
+        size_t idx = old[i].hash & mjs->interned_strings_mask;
+        while(mjs->interned_strings[idx].value != 0) {
+            idx = (idx + 1) & mjs->interned_strings_mask;
+        }
+        mjs->interned_strings[idx] = old[i];
+    }
+    free(old);
+}
+
+MJS_PRIVATE mjs_val_t mjs_mk_string_interned(struct mjs* mjs, const char* p, size_t len) {
+    struct mjs_interned_string* slot;
+    uint32_t hash;
+
+    /* Short strings are inlined into the value anyway */
+    if(len <= 5 || len > MJS_INTERN_STRING_MAX_LEN) {
+        return mjs_mk_string(mjs, p, len, 1);
+    }
+
+    hash = mjs_str_hash(p, len);
+    if(mjs->interned_strings != NULL) {
+        slot = mjs_interned_strings_slot(mjs, p, len, hash);
+        if(slot->value != 0) return slot->value;
+    }
+
+    /* Keep at least half of the slots empty */
+    if((mjs->interned_strings_count + 1) * 2 > mjs->interned_strings_mask + 1) {
+        mjs_interned_strings_grow(mjs);
+    }
+
+    slot = mjs_interned_strings_slot(mjs, p, len, hash);
+    slot->value = mjs_mk_string(mjs, p, len, 1);
+    slot->hash = hash;
+    mjs->interned_strings_count++;
+    return slot->value;
+}
+
 MJS_PRIVATE void mjs_string_to_case(struct mjs* mjs, bool upper) {
     mjs_val_t ret = MJS_UNDEFINED;
     size_t size;
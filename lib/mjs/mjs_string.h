@@ -19,11 +19,32 @@ extern "C" {
  */
 #define _MJS_STRING_BUF_RESERVE 100
 
+/*
+ * Longest string literal that is interned, see mjs_mk_string_interned()
+ */
+#ifndef MJS_INTERN_STRING_MAX_LEN
+#define MJS_INTERN_STRING_MAX_LEN 32
+#endif
+
 MJS_PRIVATE unsigned long cstr_to_ulong(const char* s, size_t len, int* ok);
 MJS_PRIVATE mjs_err_t str_to_ulong(struct mjs* mjs, mjs_val_t v, int* ok, unsigned long* res);
 MJS_PRIVATE int s_cmp(struct mjs* mjs, mjs_val_t a, mjs_val_t b);
 MJS_PRIVATE mjs_val_t s_concat(struct mjs* mjs, mjs_val_t a, mjs_val_t b);
 
+/*
+ * Hash of the string contents, used by the interned strings and by property
+ * tables
+ */
+MJS_PRIVATE uint32_t mjs_str_hash(const char* p, size_t len);
+
+/*
+ * Like `mjs_mk_string()` with `copy` set, but strings up to
+ * `MJS_INTERN_STRING_MAX_LEN` are created once and then reused, so the same
+ * contents always give the same value. Interned strings live as long as the
+ * mjs instance, so use it for bcode literals only.
+ */
+MJS_PRIVATE mjs_val_t mjs_mk_string_interned(struct mjs* mjs, const char* p, size_t len);
+
 MJS_PRIVATE void embed_string(
     struct mbuf* m,
     size_t offset,
@@ -23,6 +23,7 @@ typedef enum {
     NfcMessageTypeTx,
     NfcMessageTypeTimeout,
     NfcMessageTypeAbort,
+    NfcMessageTypeFieldOff,
 } NfcMessageType;
 
 typedef struct {
@@ -313,6 +314,10 @@ static int32_t nfc_worker_listener(void* context) {
 
         if(message.type == NfcMessageTypeAbort) {
             break;
+        } else if(message.type == NfcMessageTypeFieldOff) {
+            instance->col_res_status = Iso14443_3aColResStatusIdle;
+            nfc_event.type = NfcEventTypeFieldOff;
+            instance->callback(nfc_event, instance->context);
         } else if(message.type == NfcMessageTypeTx) {
             nfc_test_print(
                 NfcTransportLogLevelInfo, "RDR", message.data.data, message.data.data_bits);
@@ -392,6 +397,12 @@ void nfc_stop(Nfc* instance) {
     } else {
         furi_thread_join(instance->worker_thread);
 
+        // Field is turned off after polling, listener state must not leak into the next poller
+        if(listener_queue) {
+            NfcMessage message = {.type = NfcMessageTypeFieldOff};
+            furi_message_queue_put(listener_queue, &message, FuriWaitForever);
+        }
+
         furi_message_queue_free(poller_queue);
         poller_queue = NULL;
 
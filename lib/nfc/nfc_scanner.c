@@ -2,11 +2,17 @@
 #include "nfc_poller.h"
 
 #include <nfc/protocols/nfc_poller_defs.h>
+#include <nfc/protocols/nfc_device_defs.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 
 #include <furi/furi.h>
 
 #define TAG "NfcScanner"
 
+#define NFC_SCANNER_CACHE_SIZE (8U)
+#define NFC_SCANNER_FINGERPRINT_UID_MAX_LEN (10U)
+#define NFC_SCANNER_PROBE_EVENTS_MAX (8U)
+
 typedef enum {
     NfcScannerStateIdle,
     NfcScannerStateTryBasePollers,
@@ -23,6 +29,39 @@ typedef enum {
     NfcScannerSessionStateStopRequest,
 } NfcScannerSessionState;
 
+/**
+ * Card identity as seen on base protocol activation.
+ *
+ * ATQA and SAK are only set for ISO14443-3A, zero otherwise.
+ */
+typedef struct {
+    NfcProtocol protocol;
+    uint8_t uid_len;
+    uint8_t uid[NFC_SCANNER_FINGERPRINT_UID_MAX_LEN];
+    uint8_t atqa[2];
+    uint8_t sak;
+} NfcScannerFingerprint;
+
+typedef struct {
+    NfcScannerFingerprint fingerprint;
+    uint32_t last_used;
+    size_t protocols_num; /**< 0 for unused entry */
+    NfcProtocol protocols[NfcProtocolNum];
+} NfcScannerCacheEntry;
+
+/**
+ * Child protocol probes done within one activation of the base protocol.
+ *
+ * Probes are run on top of the parent protocol, which is either the base
+ * protocol itself or an intermediate one, like ISO14443-4A for MIFARE DESFire.
+ */
+typedef struct {
+    NfcProtocol base;
+    NfcProtocol parent;
+    size_t probes_num;
+    NfcProtocol probes[NfcProtocolNum];
+} NfcScannerSession;
+
 struct NfcScanner {
     Nfc* nfc;
     NfcScannerState state;
@@ -51,9 +90,41 @@ struct NfcScanner {
 
     NfcProtocol current_protocol;
 
+    size_t sessions_num;
+    size_t sessions_idx;
+    NfcScannerSession sessions[NfcProtocolNum];
+
+    const NfcScannerSession* session;
+    size_t session_pollers_num;
+    NfcProtocol session_protocols[NfcProtocolNum];
+    NfcGenericInstance* session_pollers[NfcProtocolNum];
+    NfcGenericInstance* probe_pollers[NfcProtocolNum];
+    size_t probe_idx;
+    size_t probe_events;
+
+    NfcScannerFingerprint fingerprint;
+    bool fingerprint_valid;
+    NfcScannerCacheEntry cache[NFC_SCANNER_CACHE_SIZE];
+    uint32_t cache_counter;
+
+    size_t activations_num;
+    uint32_t detect_start_tick;
+
     FuriThread* scan_worker;
 };
 
+/**
+ * Child protocols whose detect() only inspects the activation done by the parent poller.
+ *
+ * They take no exchange of their own, so any number of them shares an activation.
+ * Keep in sync with the detect() implementations.
+ */
+static const NfcProtocol nfc_scanner_passive_protocols[] = {
+    NfcProtocolIso14443_4a,
+    NfcProtocolIso14443_4b,
+    NfcProtocolSlix,
+};
+
 static void nfc_scanner_reset(NfcScanner* instance) {
     instance->base_protocols_idx = 0;
     instance->base_protocols_num = 0;
@@ -64,9 +135,104 @@ static void nfc_scanner_reset(NfcScanner* instance) {
     instance->detected_protocols_num = 0;
     instance->detected_base_protocols_num = 0;
 
+    instance->sessions_idx = 0;
+    instance->sessions_num = 0;
+
+    instance->fingerprint_valid = false;
+    instance->activations_num = 0;
+
     instance->current_protocol = 0;
 }
 
+static bool nfc_scanner_is_passive(NfcProtocol protocol) {
+    for(size_t i = 0; i < COUNT_OF(nfc_scanner_passive_protocols); i++) {
+        if(nfc_scanner_passive_protocols[i] == protocol) return true;
+    }
+    return false;
+}
+
+static bool nfc_scanner_has_children(NfcProtocol protocol) {
+    for(size_t i = 0; i < NfcProtocolNum; i++) {
+        if(nfc_protocol_get_parent(i) == protocol) return true;
+    }
+    return false;
+}
+
+static bool nfc_scanner_is_detected(NfcScanner* instance, NfcProtocol protocol) {
+    for(size_t i = 0; i < instance->detected_protocols_num; i++) {
+        if(instance->detected_protocols[i] == protocol) return true;
+    }
+    return false;
+}
+
+static bool nfc_scanner_fingerprint_init(
+    NfcScannerFingerprint* fingerprint,
+    NfcProtocol protocol,
+    const NfcDeviceData* data) {
+    memset(fingerprint, 0, sizeof(NfcScannerFingerprint));
+    fingerprint->protocol = protocol;
+
+    size_t uid_len = 0;
+    const uint8_t* uid = nfc_devices[protocol]->get_uid(data, &uid_len);
+    if(uid == NULL || uid_len == 0 || uid_len > NFC_SCANNER_FINGERPRINT_UID_MAX_LEN) return false;
+
+    // Protocols that leave the UID unread on detection can't be told apart
+    bool uid_is_set = false;
+    for(size_t i = 0; i < uid_len; i++) {
+        uid_is_set |= (uid[i] != 0);
+    }
+    if(!uid_is_set) return false;
+
+    fingerprint->uid_len = uid_len;
+    memcpy(fingerprint->uid, uid, uid_len);
+
+    if(protocol == NfcProtocolIso14443_3a) {
+        iso14443_3a_get_atqa(data, fingerprint->atqa);
+        fingerprint->sak = iso14443_3a_get_sak(data);
+    }
+
+    return true;
+}
+
+static NfcScannerCacheEntry* nfc_scanner_cache_find(NfcScanner* instance) {
+    NfcScannerCacheEntry* entry = NULL;
+
+    for(size_t i = 0; i < NFC_SCANNER_CACHE_SIZE; i++) {
+        if(instance->cache[i].protocols_num == 0) continue;
+        if(memcmp(
+               &instance->cache[i].fingerprint,
+               &instance->fingerprint,
+               sizeof(NfcScannerFingerprint)) == 0) {
+            entry = &instance->cache[i];
+            break;
+        }
+    }
+
+    return entry;
+}
+
+static void nfc_scanner_cache_store(NfcScanner* instance) {
+    NfcScannerCacheEntry* entry = nfc_scanner_cache_find(instance);
+
+    if(entry == NULL) {
+        // Replace least recently used entry, unused ones have last_used 0
+        entry = &instance->cache[0];
+        for(size_t i = 1; i < NFC_SCANNER_CACHE_SIZE; i++) {
+            if(instance->cache[i].last_used < entry->last_used) {
+                entry = &instance->cache[i];
+            }
+        }
+        entry->fingerprint = instance->fingerprint;
+    }
+
+    entry->last_used = ++instance->cache_counter;
+    entry->protocols_num = instance->detected_protocols_num;
+    memcpy(
+        entry->protocols,
+        instance->detected_protocols,
+        sizeof(NfcProtocol) * instance->detected_protocols_num);
+}
+
 typedef void (*NfcScannerStateHandler)(NfcScanner* instance);
 
 void nfc_scanner_state_handler_idle(NfcScanner* instance) {
@@ -94,6 +260,14 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
 
         NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
         bool protocol_detected = nfc_poller_detect(poller);
+        instance->activations_num++;
+
+        if(protocol_detected && instance->first_detected_protocol == NfcProtocolInvalid) {
+            instance->activations_num = 1;
+            instance->detect_start_tick = furi_get_tick();
+            instance->fingerprint_valid = nfc_scanner_fingerprint_init(
+                &instance->fingerprint, instance->current_protocol, nfc_poller_get_data(poller));
+        }
         nfc_poller_free(poller);
 
         if(protocol_detected) {
@@ -108,6 +282,20 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
             if(instance->first_detected_protocol == NfcProtocolInvalid) {
                 instance->first_detected_protocol = instance->current_protocol;
                 instance->current_protocol = NfcProtocolInvalid;
+
+                // Known card, classified by this single activation
+                const NfcScannerCacheEntry* entry =
+                    instance->fingerprint_valid ? nfc_scanner_cache_find(instance) : NULL;
+                if(entry) {
+                    FURI_LOG_D(TAG, "Fingerprint cache hit");
+                    instance->detected_protocols_num = entry->protocols_num;
+                    memcpy(
+                        instance->detected_protocols,
+                        entry->protocols,
+                        sizeof(NfcProtocol) * entry->protocols_num);
+                    instance->state = NfcScannerStateComplete;
+                    break;
+                }
             }
         }
 
@@ -116,41 +304,186 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
     } while(false);
 }
 
-void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
-    for(size_t i = 0; i < NfcProtocolNum; i++) {
-        for(size_t j = 0; j < instance->detected_base_protocols_num; j++) {
-            if(nfc_protocol_has_parent(i, instance->detected_base_protocols[j])) {
-                instance->children_protocols[instance->children_protocols_num] = i;
-                instance->children_protocols_num++;
+static NfcScannerSession*
+    nfc_scanner_add_session(NfcScanner* instance, NfcProtocol base, NfcProtocol parent) {
+    furi_assert(instance->sessions_num < NfcProtocolNum);
+
+    NfcScannerSession* session = &instance->sessions[instance->sessions_num];
+    session->base = base;
+    session->parent = parent;
+    session->probes_num = 0;
+    instance->sessions_num++;
+
+    return session;
+}
+
+static void nfc_scanner_plan_sessions(NfcScanner* instance, NfcProtocol base) {
+    // Parents are visited breadth first, so a parent is probed before its children
+    size_t parents_num = 1;
+    NfcProtocol parents[NfcProtocolNum] = {base};
+
+    for(size_t i = 0; i < parents_num; i++) {
+        const NfcProtocol parent = parents[i];
+        NfcScannerSession* session = nfc_scanner_add_session(instance, base, parent);
+        bool session_has_active_probe = false;
+
+        for(size_t j = 0; j < NfcProtocolNum; j++) {
+            if(nfc_protocol_get_parent(j) != parent) continue;
+            if(nfc_scanner_has_children(j)) parents[parents_num++] = j;
+            if(!nfc_scanner_is_passive(j)) continue;
+            session->probes[session->probes_num++] = j;
+        }
+
+        // Probes that exchange data go after passive ones. On the base protocol layer
+        // a failed exchange may drop the card out of the active state, so each gets
+        // its own activation. Higher layers keep their session on protocol errors.
+        for(size_t j = 0; j < NfcProtocolNum; j++) {
+            if(nfc_protocol_get_parent(j) != parent || nfc_scanner_is_passive(j)) continue;
+            if(session_has_active_probe && parent == base) {
+                session = nfc_scanner_add_session(instance, base, parent);
             }
+            session->probes[session->probes_num++] = j;
+            session_has_active_probe = true;
         }
+
+        if(session->probes_num == 0) instance->sessions_num--;
     }
+}
 
-    if(instance->children_protocols_num > 0) {
+void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
+    for(size_t i = 0; i < instance->detected_base_protocols_num; i++) {
+        nfc_scanner_plan_sessions(instance, instance->detected_base_protocols[i]);
+    }
+
+    if(instance->sessions_num > 0) {
         instance->state = NfcScannerStateDetectChildrenProtocols;
     } else {
         instance->state = NfcScannerStateComplete;
     }
-    FURI_LOG_D(TAG, "Found %zu children", instance->children_protocols_num);
+    FURI_LOG_D(TAG, "Planned %zu child sessions", instance->sessions_num);
 }
 
-void nfc_scanner_state_handler_detect_children_protocols(NfcScanner* instance) {
-    furi_assert(instance->children_protocols_num);
-
-    instance->current_protocol = instance->children_protocols[instance->children_protocols_idx];
+static NfcCommand nfc_scanner_probe_callback(NfcGenericEvent event, void* context) {
+    furi_assert(context);
 
-    NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
-    bool protocol_detected = nfc_poller_detect(poller);
-    nfc_poller_free(poller);
+    NfcScanner* instance = context;
+    const NfcScannerSession* session = instance->session;
+    const NfcProtocol protocol = session->probes[instance->probe_idx];
 
-    if(protocol_detected) {
-        instance->detected_protocols[instance->detected_protocols_num] =
-            instance->current_protocol;
+    if(nfc_pollers_api[protocol]->detect(event, instance->probe_pollers[instance->probe_idx])) {
+        instance->detected_protocols[instance->detected_protocols_num] = protocol;
         instance->detected_protocols_num++;
     }
 
-    instance->children_protocols_idx++;
-    if(instance->children_protocols_idx == instance->children_protocols_num) {
+    instance->probe_idx++;
+    instance->probe_events = 0;
+
+    return NfcCommandContinue;
+}
+
+static NfcCommand nfc_scanner_session_callback(NfcEvent event, void* context) {
+    furi_assert(context);
+
+    NfcScanner* instance = context;
+    const NfcScannerSession* session = instance->session;
+    NfcCommand command = NfcCommandContinue;
+
+    if(event.type == NfcEventTypePollerReady) {
+        NfcGenericEvent poller_event = {
+            .protocol = NfcProtocolInvalid,
+            .instance = instance->nfc,
+            .event_data = &event,
+        };
+
+        const size_t probe_idx = instance->probe_idx;
+        nfc_pollers_api[session->base]->run(poller_event, instance->session_pollers[0]);
+
+        // Intermediate pollers take several events to reach the probe, give up if stuck
+        if(instance->probe_idx == probe_idx &&
+           ++instance->probe_events == NFC_SCANNER_PROBE_EVENTS_MAX) {
+            instance->probe_idx++;
+            instance->probe_events = 0;
+        }
+    }
+
+    if(instance->probe_idx == session->probes_num ||
+       instance->session_state == NfcScannerSessionStateStopRequest) {
+        command = NfcCommandStop;
+    }
+
+    return command;
+}
+
+static void nfc_scanner_session_alloc(NfcScanner* instance, const NfcScannerSession* session) {
+    instance->session = session;
+    instance->probe_idx = 0;
+    instance->probe_events = 0;
+
+    // Protocols from the probes parent up to the base
+    size_t chain_num = 0;
+    NfcProtocol chain[NfcProtocolNum];
+    for(NfcProtocol protocol = session->parent; protocol != NfcProtocolInvalid;
+        protocol = nfc_protocol_get_parent(protocol)) {
+        chain[chain_num++] = protocol;
+    }
+
+    NfcGenericInstance* parent_poller = instance->nfc;
+    instance->session_pollers_num = 0;
+    for(size_t i = chain_num; i > 0; i--) {
+        const NfcProtocol protocol = chain[i - 1];
+        NfcGenericInstance* poller = nfc_pollers_api[protocol]->alloc(parent_poller);
+
+        if(instance->session_pollers_num > 0) {
+            nfc_pollers_api[chain[i]]->set_callback(
+                parent_poller, nfc_pollers_api[protocol]->run, poller);
+        }
+
+        instance->session_protocols[instance->session_pollers_num] = protocol;
+        instance->session_pollers[instance->session_pollers_num] = poller;
+        instance->session_pollers_num++;
+        parent_poller = poller;
+    }
+
+    nfc_pollers_api[session->parent]->set_callback(
+        parent_poller, nfc_scanner_probe_callback, instance);
+
+    for(size_t i = 0; i < session->probes_num; i++) {
+        instance->probe_pollers[i] = nfc_pollers_api[session->probes[i]]->alloc(parent_poller);
+    }
+}
+
+static void nfc_scanner_session_free(NfcScanner* instance) {
+    const NfcScannerSession* session = instance->session;
+
+    for(size_t i = 0; i < session->probes_num; i++) {
+        nfc_pollers_api[session->probes[i]]->free(instance->probe_pollers[i]);
+    }
+
+    for(size_t i = instance->session_pollers_num; i > 0; i--) {
+        nfc_pollers_api[instance->session_protocols[i - 1]]->free(
+            instance->session_pollers[i - 1]);
+    }
+
+    instance->session_pollers_num = 0;
+    instance->session = NULL;
+}
+
+void nfc_scanner_state_handler_detect_children_protocols(NfcScanner* instance) {
+    furi_assert(instance->sessions_num);
+
+    const NfcScannerSession* session = &instance->sessions[instance->sessions_idx];
+
+    // Children of an intermediate protocol are only probed if it was detected
+    if(session->parent == session->base || nfc_scanner_is_detected(instance, session->parent)) {
+        nfc_scanner_session_alloc(instance, session);
+        nfc_start(instance->nfc, nfc_scanner_session_callback, instance);
+        nfc_stop(instance->nfc);
+        nfc_scanner_session_free(instance);
+        instance->activations_num++;
+    }
+
+    instance->sessions_idx++;
+    if(instance->sessions_idx == instance->sessions_num) {
         instance->state = NfcScannerStateComplete;
     }
 }
@@ -173,14 +506,29 @@ static void nfc_scanner_filter_detected_protocols(NfcScanner* instance) {
     }
 
     instance->detected_protocols_num = filtered_protocols_num;
-    memcpy(instance->detected_protocols, filtered_protocols, filtered_protocols_num);
+    memcpy(
+        instance->detected_protocols,
+        filtered_protocols,
+        sizeof(NfcProtocol) * filtered_protocols_num);
 }
 
 void nfc_scanner_state_handler_complete(NfcScanner* instance) {
-    if(instance->detected_protocols_num > 1) {
-        nfc_scanner_filter_detected_protocols(instance);
+    if(instance->activations_num > 0) {
+        if(instance->detected_protocols_num > 1) {
+            nfc_scanner_filter_detected_protocols(instance);
+        }
+        if(instance->fingerprint_valid) {
+            nfc_scanner_cache_store(instance);
+        }
+        FURI_LOG_I(
+            TAG,
+            "Detected %zu protocols, %zu activations, %lu ms",
+            instance->detected_protocols_num,
+            instance->activations_num,
+            furi_get_tick() - instance->detect_start_tick);
+        // Report once, the result is sent again until the scanner is stopped
+        instance->activations_num = 0;
     }
-    FURI_LOG_I(TAG, "Detected %zu protocols", instance->detected_protocols_num);
 
     NfcScannerEvent event = {
         .type = NfcScannerEventTypeDetected,
@@ -9,6 +9,11 @@
  * a just one protocol and will try others as well until all possibilities are exhausted.
  * This is to allow for multi-protocol card support.
  *
+ * Child protocols are probed on a shared activation of their base protocol, e.g. ISO14443-4A
+ * and MIFARE Ultralight are checked within one ISO14443-3A activation. Recently seen cards are
+ * remembered by their UID (plus ATQA and SAK for ISO14443-3A) and are classified by the first
+ * base protocol activation alone. The cache persists until the NfcScanner instance is freed.
+ *
  * If no supported cards are in the vicinity, the scanning process will continue
  * until stopped explicitly.
  */
@@ -1909,7 +1909,7 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                 keys_dict_check_presence(MF_CLASSIC_NESTED_SYSTEM_DICT_PATH) ?
                     keys_dict_alloc(
                         MF_CLASSIC_NESTED_SYSTEM_DICT_PATH,
-                        KeysDictModeOpenExisting,
+                        KeysDictModeOpenExistingIndexed,
                         sizeof(MfClassicKey)) :
                     NULL;
 
@@ -1917,7 +1917,7 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                 keys_dict_check_presence(MF_CLASSIC_NESTED_USER_DICT_PATH) ?
                     keys_dict_alloc(
                         MF_CLASSIC_NESTED_USER_DICT_PATH,
-                        KeysDictModeOpenExisting,
+                        KeysDictModeOpenExistingIndexed,
                         sizeof(MfClassicKey)) :
                     NULL;
         }
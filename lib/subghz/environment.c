@@ -7,6 +7,9 @@ struct SubGhzEnvironment {
     const char* came_atomo_rainbow_table_file_name;
     const char* nice_flor_s_rainbow_table_file_name;
     const char* alutech_at_4n_rainbow_table_file_name;
+    SubGhzKeystoreRaw* came_atomo_rainbow_table;
+    SubGhzKeystoreRaw* nice_flor_s_rainbow_table;
+    SubGhzKeystoreRaw* alutech_at_4n_rainbow_table;
 };
 
 SubGhzEnvironment* subghz_environment_alloc(void) {
@@ -17,10 +20,18 @@ SubGhzEnvironment* subghz_environment_alloc(void) {
     instance->came_atomo_rainbow_table_file_name = NULL;
     instance->nice_flor_s_rainbow_table_file_name = NULL;
     instance->alutech_at_4n_rainbow_table_file_name = NULL;
+    instance->came_atomo_rainbow_table = NULL;
+    instance->nice_flor_s_rainbow_table = NULL;
+    instance->alutech_at_4n_rainbow_table = NULL;
 
     return instance;
 }
 
+static void subghz_environment_set_rainbow_table(SubGhzKeystoreRaw** table, const char* filename) {
+    if(*table) subghz_keystore_raw_free(*table);
+    *table = (filename && strcmp(filename, "")) ? subghz_keystore_raw_alloc(filename) : NULL;
+}
+
 void subghz_environment_free(SubGhzEnvironment* instance) {
     furi_check(instance);
 
@@ -28,6 +39,9 @@ void subghz_environment_free(SubGhzEnvironment* instance) {
     instance->came_atomo_rainbow_table_file_name = NULL;
     instance->nice_flor_s_rainbow_table_file_name = NULL;
     instance->alutech_at_4n_rainbow_table_file_name = NULL;
+    subghz_environment_set_rainbow_table(&instance->came_atomo_rainbow_table, NULL);
+    subghz_environment_set_rainbow_table(&instance->nice_flor_s_rainbow_table, NULL);
+    subghz_environment_set_rainbow_table(&instance->alutech_at_4n_rainbow_table, NULL);
     subghz_keystore_free(instance->keystore);
 
     free(instance);
@@ -51,6 +65,7 @@ void subghz_environment_set_came_atomo_rainbow_table_file_name(
     furi_check(instance);
 
     instance->came_atomo_rainbow_table_file_name = filename;
+    subghz_environment_set_rainbow_table(&instance->came_atomo_rainbow_table, filename);
 }
 
 const char*
@@ -60,12 +75,19 @@ const char*
     return instance->came_atomo_rainbow_table_file_name;
 }
 
+SubGhzKeystoreRaw* subghz_environment_get_came_atomo_rainbow_table(SubGhzEnvironment* instance) {
+    furi_check(instance);
+
+    return instance->came_atomo_rainbow_table;
+}
+
 void subghz_environment_set_alutech_at_4n_rainbow_table_file_name(
     SubGhzEnvironment* instance,
     const char* filename) {
     furi_check(instance);
 
     instance->alutech_at_4n_rainbow_table_file_name = filename;
+    subghz_environment_set_rainbow_table(&instance->alutech_at_4n_rainbow_table, filename);
 }
 
 const char*
@@ -75,12 +97,20 @@ const char*
     return instance->alutech_at_4n_rainbow_table_file_name;
 }
 
+SubGhzKeystoreRaw*
+    subghz_environment_get_alutech_at_4n_rainbow_table(SubGhzEnvironment* instance) {
+    furi_check(instance);
+
+    return instance->alutech_at_4n_rainbow_table;
+}
+
 void subghz_environment_set_nice_flor_s_rainbow_table_file_name(
     SubGhzEnvironment* instance,
     const char* filename) {
     furi_check(instance);
 
     instance->nice_flor_s_rainbow_table_file_name = filename;
+    subghz_environment_set_rainbow_table(&instance->nice_flor_s_rainbow_table, filename);
 }
 
 const char*
@@ -90,6 +120,12 @@ const char*
     return instance->nice_flor_s_rainbow_table_file_name;
 }
 
+SubGhzKeystoreRaw* subghz_environment_get_nice_flor_s_rainbow_table(SubGhzEnvironment* instance) {
+    furi_check(instance);
+
+    return instance->nice_flor_s_rainbow_table;
+}
+
 void subghz_environment_set_protocol_registry(
     SubGhzEnvironment* instance,
     const SubGhzProtocolRegistry* protocol_registry_items) {
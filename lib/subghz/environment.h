@@ -54,6 +54,13 @@ void subghz_environment_set_came_atomo_rainbow_table_file_name(
  */
 const char* subghz_environment_get_came_atomo_rainbow_table_file_name(SubGhzEnvironment* instance);
 
+/**
+ * Get rainbow table reader to work with Came Atomo.
+ * @param instance Pointer to a SubGhzEnvironment instance
+ * @return Pointer to a SubGhzKeystoreRaw instance, NULL if the file name is not set
+ */
+SubGhzKeystoreRaw* subghz_environment_get_came_atomo_rainbow_table(SubGhzEnvironment* instance);
+
 /**
  * Set filename to work with Alutech at-4n.
  * @param instance Pointer to a SubGhzEnvironment instance
@@ -71,6 +78,13 @@ void subghz_environment_set_alutech_at_4n_rainbow_table_file_name(
 const char*
     subghz_environment_get_alutech_at_4n_rainbow_table_file_name(SubGhzEnvironment* instance);
 
+/**
+ * Get rainbow table reader to work with Alutech at-4n.
+ * @param instance Pointer to a SubGhzEnvironment instance
+ * @return Pointer to a SubGhzKeystoreRaw instance, NULL if the file name is not set
+ */
+SubGhzKeystoreRaw* subghz_environment_get_alutech_at_4n_rainbow_table(SubGhzEnvironment* instance);
+
 /**
  * Set filename to work with Nice Flor-S.
  * @param instance Pointer to a SubGhzEnvironment instance
@@ -88,6 +102,13 @@ void subghz_environment_set_nice_flor_s_rainbow_table_file_name(
 const char*
     subghz_environment_get_nice_flor_s_rainbow_table_file_name(SubGhzEnvironment* instance);
 
+/**
+ * Get rainbow table reader to work with Nice Flor-S.
+ * @param instance Pointer to a SubGhzEnvironment instance
+ * @return Pointer to a SubGhzKeystoreRaw instance, NULL if the file name is not set
+ */
+SubGhzKeystoreRaw* subghz_environment_get_nice_flor_s_rainbow_table(SubGhzEnvironment* instance);
+
 /**
  * Set list of protocols to work.
  * @param instance Pointer to a SubGhzEnvironment instance
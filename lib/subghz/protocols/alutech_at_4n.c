@@ -26,9 +26,11 @@ struct SubGhzProtocolDecoderAlutech_at_4n {
     uint32_t crc;
     uint16_t header_count;
 
-    const char* alutech_at_4n_rainbow_table_file_name;
+    SubGhzKeystoreRaw* alutech_at_4n_rainbow_table;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderAlutech_at_4n);
+
 struct SubGhzProtocolEncoderAlutech_at_4n {
     SubGhzProtocolEncoderBase base;
 
@@ -49,6 +51,8 @@ const SubGhzProtocolDecoder subghz_protocol_alutech_at_4n_decoder = {
 
     .feed = subghz_protocol_decoder_alutech_at_4n_feed,
     .reset = subghz_protocol_decoder_alutech_at_4n_reset,
+    .idle_ignore_duration = subghz_protocol_alutech_at_4n_const.te_short -
+                            subghz_protocol_alutech_at_4n_const.te_delta,
 
     .get_hash_data = subghz_protocol_decoder_alutech_at_4n_get_hash_data,
     .serialize = subghz_protocol_decoder_alutech_at_4n_serialize,
@@ -75,28 +79,30 @@ const SubGhzProtocol subghz_protocol_alutech_at_4n = {
 };
 
 /**
- * Read bytes from rainbow table
- * @param file_name Full path to rainbow table the file
- * @param number_alutech_at_4n_magic_data number in the array
- * @return alutech_at_4n_magic_data
+ * Read bytes from rainbow table, all values are read with a single lookup
+ * @param rainbow_table Pointer to a SubGhzKeystoreRaw instance of the rainbow table
+ * @param alutech_at_4n_magic_data Returned array of the first values of the table
+ * @param count number of values
  */
-static uint32_t subghz_protocol_alutech_at_4n_get_magic_data_in_file(
-    const char* file_name,
-    uint8_t number_alutech_at_4n_magic_data) {
-    if(!strcmp(file_name, "")) return SUBGHZ_NO_ALUTECH_AT_4N_RAINBOW_TABLE;
-
-    uint8_t buffer[sizeof(uint32_t)] = {0};
-    uint32_t address = number_alutech_at_4n_magic_data * sizeof(uint32_t);
-    uint32_t alutech_at_4n_magic_data = 0;
-
-    if(subghz_keystore_raw_get_data(file_name, address, buffer, sizeof(uint32_t))) {
-        for(size_t i = 0; i < sizeof(uint32_t); i++) {
-            alutech_at_4n_magic_data = (alutech_at_4n_magic_data << 8) | buffer[i];
+static void subghz_protocol_alutech_at_4n_get_magic_data_in_file(
+    SubGhzKeystoreRaw* rainbow_table,
+    uint32_t* alutech_at_4n_magic_data,
+    size_t count) {
+    uint8_t buffer[count * sizeof(uint32_t)];
+
+    if(rainbow_table && subghz_keystore_raw_read(rainbow_table, 0, buffer, sizeof(buffer))) {
+        for(size_t i = 0; i < count; i++) {
+            alutech_at_4n_magic_data[i] = 0;
+            for(size_t j = 0; j < sizeof(uint32_t); j++) {
+                alutech_at_4n_magic_data[i] =
+                    (alutech_at_4n_magic_data[i] << 8) | buffer[i * sizeof(uint32_t) + j];
+            }
         }
     } else {
-        alutech_at_4n_magic_data = SUBGHZ_NO_ALUTECH_AT_4N_RAINBOW_TABLE;
+        for(size_t i = 0; i < count; i++) {
+            alutech_at_4n_magic_data[i] = SUBGHZ_NO_ALUTECH_AT_4N_RAINBOW_TABLE;
+        }
     }
-    return alutech_at_4n_magic_data;
 }
 
 static uint8_t subghz_protocol_alutech_at_4n_crc(uint64_t data) {
@@ -129,18 +135,15 @@ static uint8_t subghz_protocol_alutech_at_4n_decrypt_data_crc(uint8_t data) {
     return ~crc;
 }
 
-static uint64_t subghz_protocol_alutech_at_4n_decrypt(uint64_t data, const char* file_name) {
+static uint64_t
+    subghz_protocol_alutech_at_4n_decrypt(uint64_t data, SubGhzKeystoreRaw* rainbow_table) {
     uint8_t* p = (uint8_t*)&data;
     uint32_t data1 = p[0] << 24 | p[1] << 16 | p[2] << 8 | p[3];
     uint32_t data2 = p[4] << 24 | p[5] << 16 | p[6] << 8 | p[7];
     uint32_t data3 = 0;
-    uint32_t magic_data[] = {
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 0),
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 1),
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 2),
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 3),
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 4),
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 5)};
+    uint32_t magic_data[6];
+    subghz_protocol_alutech_at_4n_get_magic_data_in_file(
+        rainbow_table, magic_data, COUNT_OF(magic_data));
 
     uint32_t i = magic_data[0];
     do {
@@ -201,11 +204,13 @@ void* subghz_protocol_decoder_alutech_at_4n_alloc(SubGhzEnvironment* environment
         malloc(sizeof(SubGhzProtocolDecoderAlutech_at_4n));
     instance->base.protocol = &subghz_protocol_alutech_at_4n;
     instance->generic.protocol_name = instance->base.protocol->name;
-    instance->alutech_at_4n_rainbow_table_file_name =
-        subghz_environment_get_alutech_at_4n_rainbow_table_file_name(environment);
-    if(instance->alutech_at_4n_rainbow_table_file_name) {
+    instance->alutech_at_4n_rainbow_table =
+        subghz_environment_get_alutech_at_4n_rainbow_table(environment);
+    if(instance->alutech_at_4n_rainbow_table) {
         FURI_LOG_I(
-            TAG, "Loading rainbow table from %s", instance->alutech_at_4n_rainbow_table_file_name);
+            TAG,
+            "Loading rainbow table from %s",
+            subghz_environment_get_alutech_at_4n_rainbow_table_file_name(environment));
     }
     return instance;
 }
@@ -213,7 +218,7 @@ void* subghz_protocol_decoder_alutech_at_4n_alloc(SubGhzEnvironment* environment
 void subghz_protocol_decoder_alutech_at_4n_free(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderAlutech_at_4n* instance = context;
-    instance->alutech_at_4n_rainbow_table_file_name = NULL;
+    instance->alutech_at_4n_rainbow_table = NULL;
     free(instance);
 }
 
@@ -334,12 +339,12 @@ void subghz_protocol_decoder_alutech_at_4n_feed(void* context, bool level, uint3
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
- * @param file_name Full path to rainbow table the file
+ * @param rainbow_table Pointer to a SubGhzKeystoreRaw instance of the rainbow table
  */
 static void subghz_protocol_alutech_at_4n_remote_controller(
     SubGhzBlockGeneric* instance,
     uint8_t crc,
-    const char* file_name) {
+    SubGhzKeystoreRaw* rainbow_table) {
     /**
  *  Message format 72bit LSB first
  *           data        crc
@@ -361,7 +366,7 @@ static void subghz_protocol_alutech_at_4n_remote_controller(
     crc = subghz_protocol_blocks_reverse_key(crc, 8);
 
     if(crc == subghz_protocol_alutech_at_4n_crc(data)) {
-        data = subghz_protocol_alutech_at_4n_decrypt(data, file_name);
+        data = subghz_protocol_alutech_at_4n_decrypt(data, rainbow_table);
         status = true;
     }
 
@@ -433,7 +438,7 @@ void subghz_protocol_decoder_alutech_at_4n_get_string(void* context, FuriString*
     furi_assert(context);
     SubGhzProtocolDecoderAlutech_at_4n* instance = context;
     subghz_protocol_alutech_at_4n_remote_controller(
-        &instance->generic, instance->crc, instance->alutech_at_4n_rainbow_table_file_name);
+        &instance->generic, instance->crc, instance->alutech_at_4n_rainbow_table);
     uint32_t code_found_hi = instance->generic.data >> 32;
     uint32_t code_found_lo = instance->generic.data & 0x00000000ffffffff;
 
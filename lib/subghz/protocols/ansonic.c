@@ -28,6 +28,8 @@ struct SubGhzProtocolDecoderAnsonic {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderAnsonic);
+
 struct SubGhzProtocolEncoderAnsonic {
     SubGhzProtocolEncoderBase base;
 
@@ -48,6 +50,8 @@ const SubGhzProtocolDecoder subghz_protocol_ansonic_decoder = {
 
     .feed = subghz_protocol_decoder_ansonic_feed,
     .reset = subghz_protocol_decoder_ansonic_reset,
+    .idle_ignore_duration =
+        subghz_protocol_ansonic_const.te_short * 35 - subghz_protocol_ansonic_const.te_delta * 35,
 
     .get_hash_data = subghz_protocol_decoder_ansonic_get_hash_data,
     .serialize = subghz_protocol_decoder_ansonic_serialize,
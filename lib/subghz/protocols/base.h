@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../types.h"
+#include "../blocks/decoder.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,6 +25,21 @@ struct SubGhzProtocolDecoderBase {
     void* context;
 };
 
+/** Head of decoder instances built on SubGhzBlockDecoder. Decoders that set
+ * idle_ignore_duration must start with it, the receiver peeks at parser_step
+ * through it. */
+typedef struct {
+    SubGhzProtocolDecoderBase base;
+    SubGhzBlockDecoder decoder;
+} SubGhzProtocolDecoderBlockHead;
+
+/** Check at build time that a decoder instance type starts with SubGhzProtocolDecoderBlockHead */
+#define SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(type)                                \
+    static_assert(offsetof(type, base) == 0, #type " must start with base");          \
+    static_assert(                                                                    \
+        offsetof(type, decoder) == offsetof(SubGhzProtocolDecoderBlockHead, decoder), \
+        #type " must have decoder right after base")
+
 /**
  * Set a callback upon completion of successful decoding of one of the protocols.
  * @param decoder_base Pointer to a SubGhzProtocolDecoderBase instance
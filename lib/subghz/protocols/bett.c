@@ -39,6 +39,8 @@ struct SubGhzProtocolDecoderBETT {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderBETT);
+
 struct SubGhzProtocolEncoderBETT {
     SubGhzProtocolEncoderBase base;
 
@@ -58,6 +60,8 @@ const SubGhzProtocolDecoder subghz_protocol_bett_decoder = {
 
     .feed = subghz_protocol_decoder_bett_feed,
     .reset = subghz_protocol_decoder_bett_reset,
+    .idle_ignore_duration =
+        subghz_protocol_bett_const.te_short * 44 - subghz_protocol_bett_const.te_delta * 15,
 
     .get_hash_data = subghz_protocol_decoder_bett_get_hash_data,
     .serialize = subghz_protocol_decoder_bett_serialize,
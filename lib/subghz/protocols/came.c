@@ -36,6 +36,8 @@ struct SubGhzProtocolDecoderCame {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderCame);
+
 struct SubGhzProtocolEncoderCame {
     SubGhzProtocolEncoderBase base;
 
@@ -56,6 +58,8 @@ const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
 
     .feed = subghz_protocol_decoder_came_feed,
     .reset = subghz_protocol_decoder_came_reset,
+    .idle_ignore_duration =
+        subghz_protocol_came_const.te_short * 56 - subghz_protocol_came_const.te_delta * 47,
 
     .get_hash_data = subghz_protocol_decoder_came_get_hash_data,
     .serialize = subghz_protocol_decoder_came_serialize,
@@ -24,9 +24,11 @@ struct SubGhzProtocolDecoderCameAtomo {
     SubGhzBlockGeneric generic;
 
     ManchesterState manchester_saved_state;
-    const char* came_atomo_rainbow_table_file_name;
+    SubGhzKeystoreRaw* came_atomo_rainbow_table;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderCameAtomo);
+
 struct SubGhzProtocolEncoderCameAtomo {
     SubGhzProtocolEncoderBase base;
 
@@ -45,6 +47,8 @@ const SubGhzProtocolDecoder subghz_protocol_came_atomo_decoder = {
 
     .feed = subghz_protocol_decoder_came_atomo_feed,
     .reset = subghz_protocol_decoder_came_atomo_reset,
+    .idle_ignore_duration = subghz_protocol_came_atomo_const.te_long * 60 -
+                            subghz_protocol_came_atomo_const.te_delta * 40,
 
     .get_hash_data = subghz_protocol_decoder_came_atomo_get_hash_data,
     .serialize = subghz_protocol_decoder_came_atomo_serialize,
@@ -74,11 +78,13 @@ void* subghz_protocol_decoder_came_atomo_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderCameAtomo* instance = malloc(sizeof(SubGhzProtocolDecoderCameAtomo));
     instance->base.protocol = &subghz_protocol_came_atomo;
     instance->generic.protocol_name = instance->base.protocol->name;
-    instance->came_atomo_rainbow_table_file_name =
-        subghz_environment_get_came_atomo_rainbow_table_file_name(environment);
-    if(instance->came_atomo_rainbow_table_file_name) {
+    instance->came_atomo_rainbow_table =
+        subghz_environment_get_came_atomo_rainbow_table(environment);
+    if(instance->came_atomo_rainbow_table) {
         FURI_LOG_I(
-            TAG, "Loading rainbow table from %s", instance->came_atomo_rainbow_table_file_name);
+            TAG,
+            "Loading rainbow table from %s",
+            subghz_environment_get_came_atomo_rainbow_table_file_name(environment));
     }
     return instance;
 }
@@ -86,7 +92,7 @@ void* subghz_protocol_decoder_came_atomo_alloc(SubGhzEnvironment* environment) {
 void subghz_protocol_decoder_came_atomo_free(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderCameAtomo* instance = context;
-    instance->came_atomo_rainbow_table_file_name = NULL;
+    instance->came_atomo_rainbow_table = NULL;
     free(instance);
 }
 
@@ -188,20 +194,20 @@ void subghz_protocol_decoder_came_atomo_feed(void* context, bool level, uint32_t
 
 /** 
  * Read bytes from rainbow table
- * @param file_name Full path to rainbow table the file 
+ * @param rainbow_table Pointer to a SubGhzKeystoreRaw instance of the rainbow table
  * @param number_atomo_magic_xor number in the array
  * @return atomo_magic_xor
  */
 static uint64_t subghz_protocol_came_atomo_get_magic_xor_in_file(
-    const char* file_name,
+    SubGhzKeystoreRaw* rainbow_table,
     uint8_t number_atomo_magic_xor) {
-    if(!strcmp(file_name, "")) return SUBGHZ_NO_CAME_ATOMO_RAINBOW_TABLE;
+    if(!rainbow_table) return SUBGHZ_NO_CAME_ATOMO_RAINBOW_TABLE;
 
     uint8_t buffer[sizeof(uint64_t)] = {0};
     uint32_t address = number_atomo_magic_xor * sizeof(uint64_t);
     uint64_t atomo_magic_xor = 0;
 
-    if(subghz_keystore_raw_get_data(file_name, address, buffer, sizeof(uint64_t))) {
+    if(subghz_keystore_raw_read(rainbow_table, address, buffer, sizeof(uint64_t))) {
         for(size_t i = 0; i < sizeof(uint64_t); i++) {
             atomo_magic_xor = (atomo_magic_xor << 8) | buffer[i];
         }
@@ -214,11 +220,11 @@ static uint64_t subghz_protocol_came_atomo_get_magic_xor_in_file(
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
- * @param file_name Full path to rainbow table the file
+ * @param rainbow_table Pointer to a SubGhzKeystoreRaw instance of the rainbow table
  */
 static void subghz_protocol_came_atomo_remote_controller(
     SubGhzBlockGeneric* instance,
-    const char* file_name) {
+    SubGhzKeystoreRaw* rainbow_table) {
     /* 
     * 0x1fafef3ed0f7d9ef
     * 0x185fcc1531ee86e7
@@ -277,7 +283,8 @@ static void subghz_protocol_came_atomo_remote_controller(
     parcel_counter >>= 4;
     uint8_t ind = (parcel_counter + 1) % 32;
     uint64_t temp_data = instance->data & 0x0000FFFFFFFFFFFF;
-    uint64_t atomo_magic_xor = subghz_protocol_came_atomo_get_magic_xor_in_file(file_name, ind);
+    uint64_t atomo_magic_xor =
+        subghz_protocol_came_atomo_get_magic_xor_in_file(rainbow_table, ind);
 
     if(atomo_magic_xor != SUBGHZ_NO_CAME_ATOMO_RAINBOW_TABLE) {
         temp_data = temp_data ^ atomo_magic_xor;
@@ -321,7 +328,7 @@ void subghz_protocol_decoder_came_atomo_get_string(void* context, FuriString* ou
     furi_assert(context);
     SubGhzProtocolDecoderCameAtomo* instance = context;
     subghz_protocol_came_atomo_remote_controller(
-        &instance->generic, instance->came_atomo_rainbow_table_file_name);
+        &instance->generic, instance->came_atomo_rainbow_table);
     uint32_t code_found_hi = instance->generic.data >> 32;
     uint32_t code_found_lo = instance->generic.data & 0x00000000ffffffff;
 
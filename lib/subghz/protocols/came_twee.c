@@ -58,6 +58,8 @@ struct SubGhzProtocolDecoderCameTwee {
     ManchesterState manchester_saved_state;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderCameTwee);
+
 struct SubGhzProtocolEncoderCameTwee {
     SubGhzProtocolEncoderBase base;
 
@@ -76,6 +78,8 @@ const SubGhzProtocolDecoder subghz_protocol_came_twee_decoder = {
 
     .feed = subghz_protocol_decoder_came_twee_feed,
     .reset = subghz_protocol_decoder_came_twee_reset,
+    .idle_ignore_duration = subghz_protocol_came_twee_const.te_long * 51 -
+                            subghz_protocol_came_twee_const.te_delta * 20,
 
     .get_hash_data = subghz_protocol_decoder_came_twee_get_hash_data,
     .serialize = subghz_protocol_decoder_came_twee_serialize,
@@ -52,6 +52,8 @@ struct SubGhzProtocolDecoderChamb_Code {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderChamb_Code);
+
 struct SubGhzProtocolEncoderChamb_Code {
     SubGhzProtocolEncoderBase base;
 
@@ -72,6 +74,8 @@ const SubGhzProtocolDecoder subghz_protocol_chamb_code_decoder = {
 
     .feed = subghz_protocol_decoder_chamb_code_feed,
     .reset = subghz_protocol_decoder_chamb_code_reset,
+    .idle_ignore_duration = subghz_protocol_chamb_code_const.te_short * 39 -
+                            subghz_protocol_chamb_code_const.te_delta * 20,
 
     .get_hash_data = subghz_protocol_decoder_chamb_code_get_hash_data,
     .serialize = subghz_protocol_decoder_chamb_code_serialize,
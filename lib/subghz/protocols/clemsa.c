@@ -38,6 +38,8 @@ struct SubGhzProtocolDecoderClemsa {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderClemsa);
+
 struct SubGhzProtocolEncoderClemsa {
     SubGhzProtocolEncoderBase base;
 
@@ -57,6 +59,8 @@ const SubGhzProtocolDecoder subghz_protocol_clemsa_decoder = {
 
     .feed = subghz_protocol_decoder_clemsa_feed,
     .reset = subghz_protocol_decoder_clemsa_reset,
+    .idle_ignore_duration =
+        subghz_protocol_clemsa_const.te_short * 51 - subghz_protocol_clemsa_const.te_delta * 25,
 
     .get_hash_data = subghz_protocol_decoder_clemsa_get_hash_data,
     .serialize = subghz_protocol_decoder_clemsa_serialize,
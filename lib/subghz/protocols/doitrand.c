@@ -29,6 +29,8 @@ struct SubGhzProtocolDecoderDoitrand {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderDoitrand);
+
 struct SubGhzProtocolEncoderDoitrand {
     SubGhzProtocolEncoderBase base;
 
@@ -49,6 +51,8 @@ const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder = {
 
     .feed = subghz_protocol_decoder_doitrand_feed,
     .reset = subghz_protocol_decoder_doitrand_reset,
+    .idle_ignore_duration = subghz_protocol_doitrand_const.te_short * 62 -
+                            subghz_protocol_doitrand_const.te_delta * 30,
 
     .get_hash_data = subghz_protocol_decoder_doitrand_get_hash_data,
     .serialize = subghz_protocol_decoder_doitrand_serialize,
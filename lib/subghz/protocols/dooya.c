@@ -23,6 +23,8 @@ struct SubGhzProtocolDecoderDooya {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderDooya);
+
 struct SubGhzProtocolEncoderDooya {
     SubGhzProtocolEncoderBase base;
 
@@ -43,6 +45,8 @@ const SubGhzProtocolDecoder subghz_protocol_dooya_decoder = {
 
     .feed = subghz_protocol_decoder_dooya_feed,
     .reset = subghz_protocol_decoder_dooya_reset,
+    .idle_ignore_duration =
+        subghz_protocol_dooya_const.te_long * 12 - subghz_protocol_dooya_const.te_delta * 20,
 
     .get_hash_data = subghz_protocol_decoder_dooya_get_hash_data,
     .serialize = subghz_protocol_decoder_dooya_serialize,
@@ -22,6 +22,8 @@ struct SubGhzProtocolDecoderFaacSLH {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderFaacSLH);
+
 struct SubGhzProtocolEncoderFaacSLH {
     SubGhzProtocolEncoderBase base;
 
@@ -42,6 +44,8 @@ const SubGhzProtocolDecoder subghz_protocol_faac_slh_decoder = {
 
     .feed = subghz_protocol_decoder_faac_slh_feed,
     .reset = subghz_protocol_decoder_faac_slh_reset,
+    .idle_ignore_duration =
+        subghz_protocol_faac_slh_const.te_long * 2 - subghz_protocol_faac_slh_const.te_delta * 3,
 
     .get_hash_data = subghz_protocol_decoder_faac_slh_get_hash_data,
     .serialize = subghz_protocol_decoder_faac_slh_serialize,
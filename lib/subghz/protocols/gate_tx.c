@@ -22,6 +22,8 @@ struct SubGhzProtocolDecoderGateTx {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderGateTx);
+
 struct SubGhzProtocolEncoderGateTx {
     SubGhzProtocolEncoderBase base;
 
@@ -42,6 +44,8 @@ const SubGhzProtocolDecoder subghz_protocol_gate_tx_decoder = {
 
     .feed = subghz_protocol_decoder_gate_tx_feed,
     .reset = subghz_protocol_decoder_gate_tx_reset,
+    .idle_ignore_duration =
+        subghz_protocol_gate_tx_const.te_short * 47 - subghz_protocol_gate_tx_const.te_delta * 47,
 
     .get_hash_data = subghz_protocol_decoder_gate_tx_get_hash_data,
     .serialize = subghz_protocol_decoder_gate_tx_serialize,
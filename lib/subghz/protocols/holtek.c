@@ -32,6 +32,8 @@ struct SubGhzProtocolDecoderHoltek {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderHoltek);
+
 struct SubGhzProtocolEncoderHoltek {
     SubGhzProtocolEncoderBase base;
 
@@ -52,6 +54,8 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
 
     .feed = subghz_protocol_decoder_holtek_feed,
     .reset = subghz_protocol_decoder_holtek_reset,
+    .idle_ignore_duration =
+        subghz_protocol_holtek_const.te_short * 36 - subghz_protocol_holtek_const.te_delta * 36,
 
     .get_hash_data = subghz_protocol_decoder_holtek_get_hash_data,
     .serialize = subghz_protocol_decoder_holtek_serialize,
@@ -37,6 +37,8 @@ struct SubGhzProtocolDecoderHoltek_HT12X {
     uint32_t last_data;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderHoltek_HT12X);
+
 struct SubGhzProtocolEncoderHoltek_HT12X {
     SubGhzProtocolEncoderBase base;
 
@@ -59,6 +61,8 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_th12x_decoder = {
 
     .feed = subghz_protocol_decoder_holtek_th12x_feed,
     .reset = subghz_protocol_decoder_holtek_th12x_reset,
+    .idle_ignore_duration = subghz_protocol_holtek_th12x_const.te_short * 36 -
+                            subghz_protocol_holtek_th12x_const.te_delta * 36,
 
     .get_hash_data = subghz_protocol_decoder_holtek_th12x_get_hash_data,
     .serialize = subghz_protocol_decoder_holtek_th12x_serialize,
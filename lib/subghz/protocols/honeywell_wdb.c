@@ -33,6 +33,8 @@ struct SubGhzProtocolDecoderHoneywell_WDB {
     uint8_t lowbat;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderHoneywell_WDB);
+
 struct SubGhzProtocolEncoderHoneywell_WDB {
     SubGhzProtocolEncoderBase base;
 
@@ -53,6 +55,8 @@ const SubGhzProtocolDecoder subghz_protocol_honeywell_wdb_decoder = {
 
     .feed = subghz_protocol_decoder_honeywell_wdb_feed,
     .reset = subghz_protocol_decoder_honeywell_wdb_reset,
+    .idle_ignore_duration = subghz_protocol_honeywell_wdb_const.te_short * 3 -
+                            subghz_protocol_honeywell_wdb_const.te_delta,
 
     .get_hash_data = subghz_protocol_decoder_honeywell_wdb_get_hash_data,
     .serialize = subghz_protocol_decoder_honeywell_wdb_serialize,
@@ -24,6 +24,8 @@ struct SubGhzProtocolDecoderHormann {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderHormann);
+
 struct SubGhzProtocolEncoderHormann {
     SubGhzProtocolEncoderBase base;
 
@@ -46,6 +48,8 @@ const SubGhzProtocolDecoder subghz_protocol_hormann_decoder = {
 
     .feed = subghz_protocol_decoder_hormann_feed,
     .reset = subghz_protocol_decoder_hormann_reset,
+    .idle_ignore_duration =
+        subghz_protocol_hormann_const.te_short * 24 - subghz_protocol_hormann_const.te_delta * 24,
 
     .get_hash_data = subghz_protocol_decoder_hormann_get_hash_data,
     .serialize = subghz_protocol_decoder_hormann_serialize,
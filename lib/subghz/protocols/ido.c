@@ -22,6 +22,8 @@ struct SubGhzProtocolDecoderIDo {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderIDo);
+
 struct SubGhzProtocolEncoderIDo {
     SubGhzProtocolEncoderBase base;
 
@@ -42,6 +44,8 @@ const SubGhzProtocolDecoder subghz_protocol_ido_decoder = {
 
     .feed = subghz_protocol_decoder_ido_feed,
     .reset = subghz_protocol_decoder_ido_reset,
+    .idle_ignore_duration =
+        subghz_protocol_ido_const.te_short * 10 - subghz_protocol_ido_const.te_delta * 5,
 
     .get_hash_data = subghz_protocol_decoder_ido_get_hash_data,
     .deserialize = subghz_protocol_decoder_ido_deserialize,
@@ -28,6 +28,8 @@ struct SubGhzProtocolDecoderIntertechno_V3 {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderIntertechno_V3);
+
 struct SubGhzProtocolEncoderIntertechno_V3 {
     SubGhzProtocolEncoderBase base;
 
@@ -51,6 +53,8 @@ const SubGhzProtocolDecoder subghz_protocol_intertechno_v3_decoder = {
 
     .feed = subghz_protocol_decoder_intertechno_v3_feed,
     .reset = subghz_protocol_decoder_intertechno_v3_reset,
+    .idle_ignore_duration = subghz_protocol_intertechno_v3_const.te_short * 37 -
+                            subghz_protocol_intertechno_v3_const.te_delta * 15,
 
     .get_hash_data = subghz_protocol_decoder_intertechno_v3_get_hash_data,
     .serialize = subghz_protocol_decoder_intertechno_v3_serialize,
@@ -12,6 +12,11 @@
 
 #define TAG "SubGhzProtocolKeeloq"
 
+#define KEELOQ_SEARCH_BLOCK_SIZE 16u
+// Unknown learning type expands to 8 candidate keys per manufacture code
+#define KEELOQ_SEARCH_CANDIDATES_MAX (KEELOQ_SEARCH_BLOCK_SIZE * 8u)
+#define KEELOQ_SEARCH_CACHE_SIZE     4u
+
 static const SubGhzBlockConst subghz_protocol_keeloq_const = {
     .te_short = 400,
     .te_long = 800,
@@ -19,6 +24,24 @@ static const SubGhzBlockConst subghz_protocol_keeloq_const = {
     .min_count_bit_for_found = 64,
 };
 
+typedef struct {
+    uint32_t fix;
+    uint32_t hop;
+    const SubGhzKeystore* keystore;
+    uint32_t keystore_generation;
+    const char* manufacture_name;
+    uint32_t cnt;
+    uint8_t found;
+} SubGhzKeeloqSearchCacheItem;
+
+/** Recent frames and their manufacture search result, repeated frames skip the search.
+ * Results are tied to the keystore instance and its load generation, a reload drops them. */
+typedef struct {
+    SubGhzKeeloqSearchCacheItem items[KEELOQ_SEARCH_CACHE_SIZE];
+    size_t count;
+    size_t next;
+} SubGhzKeeloqSearchCache;
+
 struct SubGhzProtocolDecoderKeeloq {
     SubGhzProtocolDecoderBase base;
 
@@ -28,8 +51,11 @@ struct SubGhzProtocolDecoderKeeloq {
     uint16_t header_count;
     SubGhzKeystore* keystore;
     const char* manufacture_name;
+    SubGhzKeeloqSearchCache search_cache;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderKeeloq);
+
 struct SubGhzProtocolEncoderKeeloq {
     SubGhzProtocolEncoderBase base;
 
@@ -53,6 +79,8 @@ const SubGhzProtocolDecoder subghz_protocol_keeloq_decoder = {
 
     .feed = subghz_protocol_decoder_keeloq_feed,
     .reset = subghz_protocol_decoder_keeloq_reset,
+    .idle_ignore_duration =
+        subghz_protocol_keeloq_const.te_short - subghz_protocol_keeloq_const.te_delta,
 
     .get_hash_data = subghz_protocol_decoder_keeloq_get_hash_data,
     .serialize = subghz_protocol_decoder_keeloq_serialize,
@@ -89,6 +117,7 @@ const SubGhzProtocol subghz_protocol_keeloq = {
 static void subghz_protocol_keeloq_check_remote_controller(
     SubGhzBlockGeneric* instance,
     SubGhzKeystore* keystore,
+    SubGhzKeeloqSearchCache* cache,
     const char** manufacture_name);
 
 void* subghz_protocol_encoder_keeloq_alloc(SubGhzEnvironment* environment) {
@@ -126,36 +155,31 @@ static bool subghz_protocol_keeloq_gen_data(SubGhzProtocolEncoderKeeloq* instanc
                        instance->generic.cnt;
     uint32_t hop = 0;
     uint64_t man = 0;
-    int res = 0;
-
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(furi_string_get_cstr(manufacture_code->name), instance->manufacture_name);
-            if(res == 0) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    //Simple Learning
-                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    //Simple Learning
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        instance->generic.serial, manufacture_code->key);
-                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    //Invalid or missing encoding type in keeloq_mfcodes
-                    hop = 0;
-                    break;
-                }
-                break;
-            }
+
+    const SubGhzKey* manufacture_code =
+        subghz_keystore_get_key_by_name(instance->keystore, instance->manufacture_name);
+    if(manufacture_code) {
+        switch(manufacture_code->type) {
+        case KEELOQ_LEARNING_SIMPLE:
+            //Simple Learning
+            hop = subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
+            break;
+        case KEELOQ_LEARNING_NORMAL:
+            //Simple Learning
+            man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+            break;
+        case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+            man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
+                instance->generic.serial, manufacture_code->key);
+            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+            break;
+        case KEELOQ_LEARNING_UNKNOWN:
+            //Invalid or missing encoding type in keeloq_mfcodes
+            hop = 0;
+            break;
         }
+    }
     if(hop) {
         uint64_t yek = (uint64_t)fix << 32 | hop;
         instance->generic.data =
@@ -269,7 +293,7 @@ SubGhzProtocolStatus
             break;
         }
         subghz_protocol_keeloq_check_remote_controller(
-            &instance->generic, instance->keystore, &instance->manufacture_name);
+            &instance->generic, instance->keystore, NULL, &instance->manufacture_name);
 
         if(strcmp(instance->manufacture_name, "DoorHan") != 0) {
             FURI_LOG_E(TAG, "Wrong manufacturer name");
@@ -480,12 +504,218 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
+static inline uint64_t subghz_protocol_keeloq_reverse_man(uint64_t key) {
+    uint64_t man_rev = 0;
+    uint64_t man_rev_byte = 0;
+    for(uint8_t i = 0; i < 64; i += 8) {
+        man_rev_byte = (uint8_t)(key >> i);
+        man_rev = man_rev | man_rev_byte << (56 - i);
+    }
+    return man_rev;
+}
+
+typedef struct {
+    // Learning keys pending derivation, decrypted in batches
+    uint64_t normal_keys[KEELOQ_SEARCH_BLOCK_SIZE * 2];
+    uint32_t normal_lo[KEELOQ_SEARCH_BLOCK_SIZE * 2];
+    uint32_t normal_hi[KEELOQ_SEARCH_BLOCK_SIZE * 2];
+    size_t normal_count;
+    uint64_t secure_keys[KEELOQ_SEARCH_BLOCK_SIZE * 2];
+    uint32_t secure_lo[KEELOQ_SEARCH_BLOCK_SIZE * 2];
+    uint32_t secure_hi[KEELOQ_SEARCH_BLOCK_SIZE * 2];
+    size_t secure_count;
+
+    // Candidate manufacture keys in the order they are checked
+    uint64_t keys[KEELOQ_SEARCH_CANDIDATES_MAX];
+    uint32_t decrypt[KEELOQ_SEARCH_CANDIDATES_MAX];
+    const SubGhzKey* codes[KEELOQ_SEARCH_CANDIDATES_MAX];
+    bool centurion[KEELOQ_SEARCH_CANDIDATES_MAX];
+    size_t count;
+} SubGhzKeeloqSearch;
+
+static inline void subghz_protocol_keeloq_search_add(
+    SubGhzKeeloqSearch* search,
+    const SubGhzKey* code,
+    uint64_t key,
+    bool centurion) {
+    search->keys[search->count] = key;
+    search->codes[search->count] = code;
+    search->centurion[search->count] = centurion;
+    search->count++;
+}
+
+/**
+ * Derive learning keys for a block of manufacture codes
+ * Normal and secure learning need two decrypts each, done for the whole block at once
+ */
+static void subghz_protocol_keeloq_search_derive(
+    SubGhzKeeloqSearch* search,
+    const SubGhzKey* codes,
+    size_t codes_count,
+    uint32_t fix,
+    uint32_t seed) {
+    search->normal_count = 0;
+    search->secure_count = 0;
+
+    for(size_t i = 0; i < codes_count; i++) {
+        const uint64_t key = codes[i].key;
+        switch(codes[i].type) {
+        case KEELOQ_LEARNING_NORMAL:
+            search->normal_keys[search->normal_count++] = key;
+            break;
+        case KEELOQ_LEARNING_SECURE:
+            search->secure_keys[search->secure_count++] = key;
+            break;
+        case KEELOQ_LEARNING_UNKNOWN:
+            search->normal_keys[search->normal_count++] = key;
+            search->normal_keys[search->normal_count++] = subghz_protocol_keeloq_reverse_man(key);
+            search->secure_keys[search->secure_count++] = key;
+            search->secure_keys[search->secure_count++] = subghz_protocol_keeloq_reverse_man(key);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Same as subghz_protocol_keeloq_common_normal_learning
+    subghz_protocol_keeloq_common_decrypt_batch(
+        (fix & 0x0FFFFFFF) | 0x20000000,
+        search->normal_keys,
+        search->normal_lo,
+        search->normal_count);
+    subghz_protocol_keeloq_common_decrypt_batch(
+        (fix & 0x0FFFFFFF) | 0x60000000,
+        search->normal_keys,
+        search->normal_hi,
+        search->normal_count);
+
+    // Same as subghz_protocol_keeloq_common_secure_learning
+    subghz_protocol_keeloq_common_decrypt_batch(
+        fix & 0x0FFFFFFF, search->secure_keys, search->secure_hi, search->secure_count);
+    subghz_protocol_keeloq_common_decrypt_batch(
+        seed, search->secure_keys, search->secure_lo, search->secure_count);
+}
+
+static inline uint64_t subghz_protocol_keeloq_search_join(uint32_t hi, uint32_t lo) {
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/**
+ * Expand a block of manufacture codes into candidate keys
+ * Order matches the sequential per code, per learning type check
+ */
+static void subghz_protocol_keeloq_search_expand(
+    SubGhzKeeloqSearch* search,
+    const SubGhzKey* codes,
+    size_t codes_count,
+    uint32_t fix) {
+    size_t normal_index = 0;
+    size_t secure_index = 0;
+    uint64_t man;
+
+    search->count = 0;
+
+    for(size_t i = 0; i < codes_count; i++) {
+        const SubGhzKey* code = &codes[i];
+        switch(code->type) {
+        case KEELOQ_LEARNING_SIMPLE:
+            subghz_protocol_keeloq_search_add(search, code, code->key, false);
+            break;
+        case KEELOQ_LEARNING_NORMAL:
+            // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+            man = subghz_protocol_keeloq_search_join(
+                search->normal_hi[normal_index], search->normal_lo[normal_index]);
+            normal_index++;
+            subghz_protocol_keeloq_search_add(
+                search, code, man, strcmp(code->name, "Centurion") == 0);
+            break;
+        case KEELOQ_LEARNING_SECURE:
+            man = subghz_protocol_keeloq_search_join(
+                search->secure_hi[secure_index], search->secure_lo[secure_index]);
+            secure_index++;
+            subghz_protocol_keeloq_search_add(search, code, man, false);
+            break;
+        case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+            man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, code->key);
+            subghz_protocol_keeloq_search_add(search, code, man, false);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+            man = subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, code->key);
+            subghz_protocol_keeloq_search_add(search, code, man, false);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+            man = subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, code->key);
+            subghz_protocol_keeloq_search_add(search, code, man, false);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+            man = subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, code->key);
+            subghz_protocol_keeloq_search_add(search, code, man, false);
+            break;
+        case KEELOQ_LEARNING_UNKNOWN: {
+            const uint64_t man_rev = subghz_protocol_keeloq_reverse_man(code->key);
+            // Simple Learning, then mirrored man
+            subghz_protocol_keeloq_search_add(search, code, code->key, false);
+            subghz_protocol_keeloq_search_add(search, code, man_rev, false);
+            // Normal Learning, then mirrored man
+            for(size_t j = 0; j < 2; j++) {
+                man = subghz_protocol_keeloq_search_join(
+                    search->normal_hi[normal_index], search->normal_lo[normal_index]);
+                normal_index++;
+                subghz_protocol_keeloq_search_add(search, code, man, false);
+            }
+            // Secure Learning, then mirrored man
+            for(size_t j = 0; j < 2; j++) {
+                man = subghz_protocol_keeloq_search_join(
+                    search->secure_hi[secure_index], search->secure_lo[secure_index]);
+                secure_index++;
+                subghz_protocol_keeloq_search_add(search, code, man, false);
+            }
+            // Magic xor type1 learning, then mirrored man
+            man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, code->key);
+            subghz_protocol_keeloq_search_add(search, code, man, false);
+            man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
+            subghz_protocol_keeloq_search_add(search, code, man, false);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+static const SubGhzKeeloqSearchCacheItem* subghz_protocol_keeloq_search_cache_find(
+    SubGhzKeeloqSearchCache* cache,
+    uint32_t fix,
+    uint32_t hop,
+    const SubGhzKeystore* keystore,
+    uint32_t keystore_generation) {
+    for(size_t i = 0; i < cache->count; i++) {
+        const SubGhzKeeloqSearchCacheItem* item = &cache->items[i];
+        if(item->fix == fix && item->hop == hop && item->keystore == keystore &&
+           item->keystore_generation == keystore_generation) {
+            return item;
+        }
+    }
+    return NULL;
+}
+
+static void subghz_protocol_keeloq_search_cache_add(
+    SubGhzKeeloqSearchCache* cache,
+    const SubGhzKeeloqSearchCacheItem* item) {
+    cache->items[cache->next] = *item;
+    cache->next = (cache->next + 1) % KEELOQ_SEARCH_CACHE_SIZE;
+    if(cache->count < KEELOQ_SEARCH_CACHE_SIZE) cache->count++;
+}
+
 /** 
  * Checking the accepted code against the database manafacture key
+ * Candidate keys are expanded block by block and decrypted in batches,
+ * the first match in keystore order wins as with a one by one search.
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param fix Fix part of the parcel
  * @param hop Hop encrypted part of the parcel
  * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param cache Pointer to a SubGhzKeeloqSearchCache instance, may be NULL
  * @param manufacture_name 
  * @return true on successful search
  */
@@ -494,6 +724,7 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     uint32_t fix,
     uint32_t hop,
     SubGhzKeystore* keystore,
+    SubGhzKeeloqSearchCache* cache,
     const char** manufacture_name) {
     // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
     // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
@@ -501,169 +732,75 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
 
     uint16_t end_serial = (uint16_t)(fix & 0xFF);
     uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
     uint32_t seed = 0;
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            switch(manufacture_code->type) {
-            case KEELOQ_LEARNING_SIMPLE:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_NORMAL:
-                // Normal Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0) {
-                    if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        return 1;
-                    }
-                } else {
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        return 1;
-                    }
-                }
-                break;
-            case KEELOQ_LEARNING_SECURE:
-                man = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_UNKNOWN:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                uint64_t man_rev = 0;
-                uint64_t man_rev_byte = 0;
-                for(uint8_t i = 0; i < 64; i += 8) {
-                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                    man_rev = man_rev | man_rev_byte << (56 - i);
-                }
-
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                //###########################
-                // Normal Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Secure Learning
-                man = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_secure_learning(fix, seed, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Magic xor type1 learning
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
+    SubGhzKeyArray_t* codes = subghz_keystore_get_data(keystore);
+    const size_t codes_count = SubGhzKeyArray_size(*codes);
+    const uint32_t keystore_generation = subghz_keystore_get_generation(keystore);
+
+    SubGhzKeeloqSearchCacheItem result = {
+        .fix = fix,
+        .hop = hop,
+        .keystore = keystore,
+        .keystore_generation = keystore_generation,
+        .manufacture_name = "Unknown",
+        .cnt = 0,
+        .found = 0,
+    };
+
+    const SubGhzKeeloqSearchCacheItem* cached =
+        cache ? subghz_protocol_keeloq_search_cache_find(
+                    cache, fix, hop, keystore, keystore_generation) :
+                NULL;
+
+    if(cached) {
+        result = *cached;
+    } else if(codes_count > 0) {
+        SubGhzKeeloqSearch* search = malloc(sizeof(SubGhzKeeloqSearch));
+        const SubGhzKey* code_base = SubGhzKeyArray_cget(*codes, 0);
+
+        for(size_t block = 0; block < codes_count && !result.found;
+            block += KEELOQ_SEARCH_BLOCK_SIZE) {
+            const size_t block_count = MIN(KEELOQ_SEARCH_BLOCK_SIZE, codes_count - block);
+
+            subghz_protocol_keeloq_search_derive(
+                search, &code_base[block], block_count, fix, seed);
+            subghz_protocol_keeloq_search_expand(search, &code_base[block], block_count, fix);
+            subghz_protocol_keeloq_common_decrypt_batch(
+                hop, search->keys, search->decrypt, search->count);
+
+            for(size_t i = 0; i < search->count; i++) {
+                bool match = search->centurion[i] ?
+                                 subghz_protocol_keeloq_check_decrypt_centurion(
+                                     instance, search->decrypt[i], btn) :
+                                 subghz_protocol_keeloq_check_decrypt(
+                                     instance, search->decrypt[i], btn, end_serial);
+                if(match) {
+                    result.manufacture_name = search->codes[i]->name;
+                    result.cnt = instance->cnt;
+                    result.found = 1;
+                    break;
                 }
-                break;
             }
         }
 
-    *manufacture_name = "Unknown";
-    instance->cnt = 0;
+        free(search);
+    }
+
+    if(cache && !cached) {
+        subghz_protocol_keeloq_search_cache_add(cache, &result);
+    }
+
+    *manufacture_name = result.manufacture_name;
+    instance->cnt = result.cnt;
 
-    return 0;
+    return result.found;
 }
 
 static void subghz_protocol_keeloq_check_remote_controller(
     SubGhzBlockGeneric* instance,
     SubGhzKeystore* keystore,
+    SubGhzKeeloqSearchCache* cache,
     const char** manufacture_name) {
     uint64_t key = subghz_protocol_blocks_reverse_key(instance->data, instance->data_count_bit);
     uint32_t key_fix = key >> 32;
@@ -678,7 +815,7 @@ static void subghz_protocol_keeloq_check_remote_controller(
         instance->cnt = key_hop >> 16;
     } else {
         subghz_protocol_keeloq_check_remote_controller_selector(
-            instance, key_fix, key_hop, keystore, manufacture_name);
+            instance, key_fix, key_hop, keystore, cache, manufacture_name);
     }
 
     instance->serial = key_fix & 0x0FFFFFFF;
@@ -699,7 +836,10 @@ SubGhzProtocolStatus subghz_protocol_decoder_keeloq_serialize(
     furi_assert(context);
     SubGhzProtocolDecoderKeeloq* instance = context;
     subghz_protocol_keeloq_check_remote_controller(
-        &instance->generic, instance->keystore, &instance->manufacture_name);
+        &instance->generic,
+        instance->keystore,
+        &instance->search_cache,
+        &instance->manufacture_name);
 
     SubGhzProtocolStatus res =
         subghz_block_generic_serialize(&instance->generic, flipper_format, preset);
@@ -725,7 +865,10 @@ void subghz_protocol_decoder_keeloq_get_string(void* context, FuriString* output
     furi_assert(context);
     SubGhzProtocolDecoderKeeloq* instance = context;
     subghz_protocol_keeloq_check_remote_controller(
-        &instance->generic, instance->keystore, &instance->manufacture_name);
+        &instance->generic,
+        instance->keystore,
+        &instance->search_cache,
+        &instance->manufacture_name);
 
     uint32_t code_found_hi = instance->generic.data >> 32;
     uint32_t code_found_lo = instance->generic.data & 0x00000000ffffffff;
@@ -35,6 +35,93 @@ inline uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const
     return x;
 }
 
+/** Transpose 32x32 bit matrix in place, row i bit j <-> row j bit i */
+static void subghz_protocol_keeloq_common_transpose32(uint32_t* m) {
+    uint32_t mask = 0x0000FFFF;
+    for(uint32_t j = 16; j != 0; j >>= 1, mask ^= (mask << j)) {
+        for(uint32_t k = 0; k < 32; k = ((k | j) + 1) & ~j) {
+            uint32_t t = ((m[k] >> j) ^ m[k | j]) & mask;
+            m[k] ^= t << j;
+            m[k | j] ^= t;
+        }
+    }
+}
+
+/** Bitsliced decrypt of up to 32 keys, one lane per key
+ * @param data - keeloq encrypt data
+ * @param keys - manufacture keys (64bit)
+ * @param result - decrypted data for each key
+ * @param count - number of keys, up to KEELOQ_BATCH_SIZE
+ */
+static void subghz_protocol_keeloq_common_decrypt_lanes(
+    const uint32_t data,
+    const uint64_t* keys,
+    uint32_t* result,
+    size_t count) {
+    uint32_t key_lo[32] = {0};
+    uint32_t key_hi[32] = {0};
+    uint32_t state[32];
+
+    // Key bit n of every lane in one word
+    for(size_t i = 0; i < count; i++) {
+        key_lo[i] = (uint32_t)keys[i];
+        key_hi[i] = (uint32_t)(keys[i] >> 32);
+    }
+    subghz_protocol_keeloq_common_transpose32(key_lo);
+    subghz_protocol_keeloq_common_transpose32(key_hi);
+
+    // All lanes start from the same data
+    for(size_t i = 0; i < 32; i++) {
+        state[i] = bit(data, i) ? 0xFFFFFFFF : 0;
+    }
+
+    // State bit i lives in state[(base + i) & 31], shifting left is a base decrement
+    uint32_t base = 0;
+    for(uint32_t r = 0; r < 528; r++) {
+        const uint32_t a = state[base & 31];
+        const uint32_t b = state[(base + 8) & 31];
+        const uint32_t c = state[(base + 19) & 31];
+        const uint32_t d = state[(base + 25) & 31];
+        const uint32_t e = state[(base + 30) & 31];
+        const uint32_t k = (15 - r) & 63;
+
+        // KEELOQ_NLF in algebraic normal form
+        const uint32_t nlf = a ^ b ^ (a & b) ^ (b & c) ^ (a & d) ^ (c & d) ^
+                             (e & (a ^ (a & b) ^ c ^ (a & c) ^ (b & d) ^ (c & d)));
+
+        const uint32_t out = state[(base + 31) & 31] ^ state[(base + 15) & 31] ^
+                             (k < 32 ? key_lo[k] : key_hi[k - 32]) ^ nlf;
+
+        base--;
+        state[base & 31] = out;
+    }
+
+    // Back to one word per lane
+    uint32_t lanes[32];
+    for(size_t i = 0; i < 32; i++) {
+        lanes[i] = state[(base + i) & 31];
+    }
+    subghz_protocol_keeloq_common_transpose32(lanes);
+    memcpy(result, lanes, count * sizeof(uint32_t));
+}
+
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t data,
+    const uint64_t* keys,
+    uint32_t* result,
+    size_t count) {
+    furi_check(keys);
+    furi_check(result);
+
+    while(count > 0) {
+        size_t lanes = MIN(count, (size_t)KEELOQ_BATCH_SIZE);
+        subghz_protocol_keeloq_common_decrypt_lanes(data, keys, result, lanes);
+        keys += lanes;
+        result += lanes;
+        count -= lanes;
+    }
+}
+
 /** Normal Learning
  * @param data - serial number (28bit)
  * @param key - manufacture (64bit)
@@ -41,6 +41,23 @@ uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const uint64
  */
 uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64_t key);
 
+/** Number of keys processed by one pass of the batch decrypt */
+#define KEELOQ_BATCH_SIZE 32u
+
+/**
+ * Batch Decrypt, same data with many keys
+ * Keys are processed bitsliced, KEELOQ_BATCH_SIZE keys per pass
+ * @param data - keeloq encrypt data
+ * @param keys - manufacture keys (64bit)
+ * @param result - decrypted data for each key, same layout as subghz_protocol_keeloq_common_decrypt
+ * @param count - number of keys
+ */
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t data,
+    const uint64_t* keys,
+    uint32_t* result,
+    size_t count);
+
 /** 
  * Normal Learning
  * @param data - serial number (28bit)
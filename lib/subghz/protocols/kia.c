@@ -24,6 +24,8 @@ struct SubGhzProtocolDecoderKIA {
     uint16_t header_count;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderKIA);
+
 struct SubGhzProtocolEncoderKIA {
     SubGhzProtocolEncoderBase base;
 
@@ -44,6 +46,8 @@ const SubGhzProtocolDecoder subghz_protocol_kia_decoder = {
 
     .feed = subghz_protocol_decoder_kia_feed,
     .reset = subghz_protocol_decoder_kia_reset,
+    .idle_ignore_duration =
+        subghz_protocol_kia_const.te_short - subghz_protocol_kia_const.te_delta,
 
     .get_hash_data = subghz_protocol_decoder_kia_get_hash_data,
     .serialize = subghz_protocol_decoder_kia_serialize,
@@ -28,6 +28,8 @@ struct SubGhzProtocolDecoderKingGates_stylo_4k {
     SubGhzKeystore* keystore;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderKingGates_stylo_4k);
+
 struct SubGhzProtocolEncoderKingGates_stylo_4k {
     SubGhzProtocolEncoderBase base;
 
@@ -49,6 +51,8 @@ const SubGhzProtocolDecoder subghz_protocol_kinggates_stylo_4k_decoder = {
 
     .feed = subghz_protocol_decoder_kinggates_stylo_4k_feed,
     .reset = subghz_protocol_decoder_kinggates_stylo_4k_reset,
+    .idle_ignore_duration = subghz_protocol_kinggates_stylo_4k_const.te_short -
+                            subghz_protocol_kinggates_stylo_4k_const.te_delta,
 
     .get_hash_data = subghz_protocol_decoder_kinggates_stylo_4k_get_hash_data,
     .serialize = subghz_protocol_decoder_kinggates_stylo_4k_serialize,
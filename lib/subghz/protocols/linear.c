@@ -29,6 +29,8 @@ struct SubGhzProtocolDecoderLinear {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderLinear);
+
 struct SubGhzProtocolEncoderLinear {
     SubGhzProtocolEncoderBase base;
 
@@ -48,6 +50,8 @@ const SubGhzProtocolDecoder subghz_protocol_linear_decoder = {
 
     .feed = subghz_protocol_decoder_linear_feed,
     .reset = subghz_protocol_decoder_linear_reset,
+    .idle_ignore_duration =
+        subghz_protocol_linear_const.te_short * 42 - subghz_protocol_linear_const.te_delta * 20,
 
     .get_hash_data = subghz_protocol_decoder_linear_get_hash_data,
     .serialize = subghz_protocol_decoder_linear_serialize,
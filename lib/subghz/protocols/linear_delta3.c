@@ -30,6 +30,8 @@ struct SubGhzProtocolDecoderLinearDelta3 {
     uint32_t last_data;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderLinearDelta3);
+
 struct SubGhzProtocolEncoderLinearDelta3 {
     SubGhzProtocolEncoderBase base;
 
@@ -49,6 +51,8 @@ const SubGhzProtocolDecoder subghz_protocol_linear_delta3_decoder = {
 
     .feed = subghz_protocol_decoder_linear_delta3_feed,
     .reset = subghz_protocol_decoder_linear_delta3_reset,
+    .idle_ignore_duration = subghz_protocol_linear_delta3_const.te_short * 70 -
+                            subghz_protocol_linear_delta3_const.te_delta * 24,
 
     .get_hash_data = subghz_protocol_decoder_linear_delta3_get_hash_data,
     .serialize = subghz_protocol_decoder_linear_delta3_serialize,
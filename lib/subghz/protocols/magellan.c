@@ -23,6 +23,8 @@ struct SubGhzProtocolDecoderMagellan {
     uint16_t header_count;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderMagellan);
+
 struct SubGhzProtocolEncoderMagellan {
     SubGhzProtocolEncoderBase base;
 
@@ -44,6 +46,8 @@ const SubGhzProtocolDecoder subghz_protocol_magellan_decoder = {
 
     .feed = subghz_protocol_decoder_magellan_feed,
     .reset = subghz_protocol_decoder_magellan_reset,
+    .idle_ignore_duration =
+        subghz_protocol_magellan_const.te_short - subghz_protocol_magellan_const.te_delta,
 
     .get_hash_data = subghz_protocol_decoder_magellan_get_hash_data,
     .serialize = subghz_protocol_decoder_magellan_serialize,
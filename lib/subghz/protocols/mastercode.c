@@ -38,6 +38,8 @@ struct SubGhzProtocolDecoderMastercode {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderMastercode);
+
 struct SubGhzProtocolEncoderMastercode {
     SubGhzProtocolEncoderBase base;
     SubGhzProtocolBlockEncoder encoder;
@@ -56,6 +58,8 @@ const SubGhzProtocolDecoder subghz_protocol_mastercode_decoder = {
 
     .feed = subghz_protocol_decoder_mastercode_feed,
     .reset = subghz_protocol_decoder_mastercode_reset,
+    .idle_ignore_duration = subghz_protocol_mastercode_const.te_short * 15 -
+                            subghz_protocol_mastercode_const.te_delta * 15,
 
     .get_hash_data = subghz_protocol_decoder_mastercode_get_hash_data,
     .serialize = subghz_protocol_decoder_mastercode_serialize,
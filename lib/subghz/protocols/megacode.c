@@ -34,6 +34,8 @@ struct SubGhzProtocolDecoderMegaCode {
     uint8_t last_bit;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderMegaCode);
+
 struct SubGhzProtocolEncoderMegaCode {
     SubGhzProtocolEncoderBase base;
 
@@ -54,6 +56,8 @@ const SubGhzProtocolDecoder subghz_protocol_megacode_decoder = {
 
     .feed = subghz_protocol_decoder_megacode_feed,
     .reset = subghz_protocol_decoder_megacode_reset,
+    .idle_ignore_duration = subghz_protocol_megacode_const.te_short * 13 -
+                            subghz_protocol_megacode_const.te_delta * 17,
 
     .get_hash_data = subghz_protocol_decoder_megacode_get_hash_data,
     .serialize = subghz_protocol_decoder_megacode_serialize,
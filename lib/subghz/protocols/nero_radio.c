@@ -24,6 +24,8 @@ struct SubGhzProtocolDecoderNeroRadio {
     uint16_t header_count;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderNeroRadio);
+
 struct SubGhzProtocolEncoderNeroRadio {
     SubGhzProtocolEncoderBase base;
 
@@ -44,6 +46,8 @@ const SubGhzProtocolDecoder subghz_protocol_nero_radio_decoder = {
 
     .feed = subghz_protocol_decoder_nero_radio_feed,
     .reset = subghz_protocol_decoder_nero_radio_reset,
+    .idle_ignore_duration =
+        subghz_protocol_nero_radio_const.te_short - subghz_protocol_nero_radio_const.te_delta,
 
     .get_hash_data = subghz_protocol_decoder_nero_radio_get_hash_data,
     .serialize = subghz_protocol_decoder_nero_radio_serialize,
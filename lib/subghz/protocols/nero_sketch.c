@@ -23,6 +23,8 @@ struct SubGhzProtocolDecoderNeroSketch {
     uint16_t header_count;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderNeroSketch);
+
 struct SubGhzProtocolEncoderNeroSketch {
     SubGhzProtocolEncoderBase base;
 
@@ -43,6 +45,8 @@ const SubGhzProtocolDecoder subghz_protocol_nero_sketch_decoder = {
 
     .feed = subghz_protocol_decoder_nero_sketch_feed,
     .reset = subghz_protocol_decoder_nero_sketch_reset,
+    .idle_ignore_duration =
+        subghz_protocol_nero_sketch_const.te_short - subghz_protocol_nero_sketch_const.te_delta,
 
     .get_hash_data = subghz_protocol_decoder_nero_sketch_get_hash_data,
     .serialize = subghz_protocol_decoder_nero_sketch_serialize,
@@ -21,6 +21,8 @@ struct SubGhzProtocolDecoderNiceFlo {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderNiceFlo);
+
 struct SubGhzProtocolEncoderNiceFlo {
     SubGhzProtocolEncoderBase base;
 
@@ -41,6 +43,8 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder = {
 
     .feed = subghz_protocol_decoder_nice_flo_feed,
     .reset = subghz_protocol_decoder_nice_flo_reset,
+    .idle_ignore_duration = subghz_protocol_nice_flo_const.te_short * 36 -
+                            subghz_protocol_nice_flo_const.te_delta * 36,
 
     .get_hash_data = subghz_protocol_decoder_nice_flo_get_hash_data,
     .serialize = subghz_protocol_decoder_nice_flo_serialize,
@@ -30,10 +30,12 @@ struct SubGhzProtocolDecoderNiceFlorS {
     SubGhzBlockDecoder decoder;
     SubGhzBlockGeneric generic;
 
-    const char* nice_flor_s_rainbow_table_file_name;
+    SubGhzKeystoreRaw* nice_flor_s_rainbow_table;
     uint64_t data;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderNiceFlorS);
+
 struct SubGhzProtocolEncoderNiceFlorS {
     SubGhzProtocolEncoderBase base;
 
@@ -55,6 +57,8 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flor_s_decoder = {
 
     .feed = subghz_protocol_decoder_nice_flor_s_feed,
     .reset = subghz_protocol_decoder_nice_flor_s_reset,
+    .idle_ignore_duration = subghz_protocol_nice_flor_s_const.te_short * 38 -
+                            subghz_protocol_nice_flor_s_const.te_delta * 38,
 
     .get_hash_data = subghz_protocol_decoder_nice_flor_s_get_hash_data,
     .serialize = subghz_protocol_decoder_nice_flor_s_serialize,
@@ -141,16 +145,17 @@ const SubGhzProtocol subghz_protocol_nice_flor_s = {
 
 /** 
  * Read bytes from rainbow table
- * @param file_name Full path to rainbow table the file 
+ * @param rainbow_table Pointer to a SubGhzKeystoreRaw instance of the rainbow table
  * @param address Byte address in file
  * @return data
  */
-static uint8_t
-    subghz_protocol_nice_flor_s_get_byte_in_file(const char* file_name, uint32_t address) {
-    if(!file_name) return 0;
+static uint8_t subghz_protocol_nice_flor_s_get_byte_in_file(
+    SubGhzKeystoreRaw* rainbow_table,
+    uint32_t address) {
+    if(!rainbow_table) return 0;
 
     uint8_t buffer[1] = {0};
-    if(subghz_keystore_raw_get_data(file_name, address, buffer, sizeof(uint8_t))) {
+    if(subghz_keystore_raw_read(rainbow_table, address, buffer, sizeof(uint8_t))) {
         return buffer[0];
     } else {
         return 0;
@@ -163,17 +168,17 @@ static inline void subghz_protocol_decoder_nice_flor_s_magic_xor(uint8_t* p, uin
     }
 }
 
-uint64_t subghz_protocol_nice_flor_s_encrypt(uint64_t data, const char* file_name) {
+uint64_t subghz_protocol_nice_flor_s_encrypt(uint64_t data, SubGhzKeystoreRaw* rainbow_table) {
     uint8_t* p = (uint8_t*)&data;
 
     uint8_t k = 0;
     for(uint8_t y = 0; y < 2; y++) {
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] & 0x1f);
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(rainbow_table, p[0] & 0x1f);
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
         p[0] ^= k & 0xe0;
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] >> 3) + 0x25;
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(rainbow_table, p[0] >> 3) + 0x25;
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
@@ -197,8 +202,9 @@ uint64_t subghz_protocol_nice_flor_s_encrypt(uint64_t data, const char* file_nam
     return data;
 }
 
-static uint64_t
-    subghz_protocol_nice_flor_s_decrypt(SubGhzBlockGeneric* instance, const char* file_name) {
+static uint64_t subghz_protocol_nice_flor_s_decrypt(
+    SubGhzBlockGeneric* instance,
+    SubGhzKeystoreRaw* rainbow_table) {
     furi_assert(instance);
     uint64_t data = instance->data;
     uint8_t* p = (uint8_t*)&data;
@@ -215,12 +221,12 @@ static uint64_t
     p[1] = k;
 
     for(uint8_t y = 0; y < 2; y++) {
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] >> 3) + 0x25;
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(rainbow_table, p[0] >> 3) + 0x25;
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
         p[0] ^= k & 0x7;
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] & 0x1f);
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(rainbow_table, p[0] & 0x1f);
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
@@ -239,11 +245,13 @@ void* subghz_protocol_decoder_nice_flor_s_alloc(SubGhzEnvironment* environment)
     SubGhzProtocolDecoderNiceFlorS* instance = malloc(sizeof(SubGhzProtocolDecoderNiceFlorS));
     instance->base.protocol = &subghz_protocol_nice_flor_s;
     instance->generic.protocol_name = instance->base.protocol->name;
-    instance->nice_flor_s_rainbow_table_file_name =
-        subghz_environment_get_nice_flor_s_rainbow_table_file_name(environment);
-    if(instance->nice_flor_s_rainbow_table_file_name) {
+    instance->nice_flor_s_rainbow_table =
+        subghz_environment_get_nice_flor_s_rainbow_table(environment);
+    if(instance->nice_flor_s_rainbow_table) {
         FURI_LOG_I(
-            TAG, "Loading rainbow table from %s", instance->nice_flor_s_rainbow_table_file_name);
+            TAG,
+            "Loading rainbow table from %s",
+            subghz_environment_get_nice_flor_s_rainbow_table_file_name(environment));
     }
     return instance;
 }
@@ -251,7 +259,7 @@ void* subghz_protocol_decoder_nice_flor_s_alloc(SubGhzEnvironment* environment)
 void subghz_protocol_decoder_nice_flor_s_free(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderNiceFlorS* instance = context;
-    instance->nice_flor_s_rainbow_table_file_name = NULL;
+    instance->nice_flor_s_rainbow_table = NULL;
     free(instance);
 }
 
@@ -352,11 +360,11 @@ void subghz_protocol_decoder_nice_flor_s_feed(void* context, bool level, uint32_
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
- * @param file_name Full path to rainbow table the file 
+ * @param rainbow_table Pointer to a SubGhzKeystoreRaw instance of the rainbow table
  */
 static void subghz_protocol_nice_flor_s_remote_controller(
     SubGhzBlockGeneric* instance,
-    const char* file_name) {
+    SubGhzKeystoreRaw* rainbow_table) {
     /*
     * Protocol Nice Flor-S
     * Packet format Nice Flor-s: START-P0-P1-P2-P3-P4-P5-P6-P7-STOP
@@ -398,12 +406,12 @@ static void subghz_protocol_nice_flor_s_remote_controller(
     *  further up to 15 with overflow
     * 
     */
-    if(!file_name) {
+    if(!rainbow_table) {
         instance->cnt = 0;
         instance->serial = 0;
         instance->btn = 0;
     } else {
-        uint64_t decrypt = subghz_protocol_nice_flor_s_decrypt(instance, file_name);
+        uint64_t decrypt = subghz_protocol_nice_flor_s_decrypt(instance, rainbow_table);
         instance->cnt = decrypt & 0xFFFF;
         instance->serial = (decrypt >> 16) & 0xFFFFFFF;
         instance->btn = (decrypt >> 48) & 0xF;
@@ -475,7 +483,7 @@ void subghz_protocol_decoder_nice_flor_s_get_string(void* context, FuriString* o
     SubGhzProtocolDecoderNiceFlorS* instance = context;
 
     subghz_protocol_nice_flor_s_remote_controller(
-        &instance->generic, instance->nice_flor_s_rainbow_table_file_name);
+        &instance->generic, instance->nice_flor_s_rainbow_table);
 
     if(instance->generic.data_count_bit == NICE_ONE_COUNT_BIT) {
         furi_string_cat_printf(
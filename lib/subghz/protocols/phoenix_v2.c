@@ -24,6 +24,8 @@ struct SubGhzProtocolDecoderPhoenix_V2 {
     SubGhzBlockGeneric generic;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderPhoenix_V2);
+
 struct SubGhzProtocolEncoderPhoenix_V2 {
     SubGhzProtocolEncoderBase base;
 
@@ -44,6 +46,8 @@ const SubGhzProtocolDecoder subghz_protocol_phoenix_v2_decoder = {
 
     .feed = subghz_protocol_decoder_phoenix_v2_feed,
     .reset = subghz_protocol_decoder_phoenix_v2_reset,
+    .idle_ignore_duration = subghz_protocol_phoenix_v2_const.te_short * 60 -
+                            subghz_protocol_phoenix_v2_const.te_delta * 30,
 
     .get_hash_data = subghz_protocol_decoder_phoenix_v2_get_hash_data,
     .serialize = subghz_protocol_decoder_phoenix_v2_serialize,
@@ -35,6 +35,8 @@ struct SubGhzProtocolDecoderPrinceton {
     uint32_t guard_time;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderPrinceton);
+
 struct SubGhzProtocolEncoderPrinceton {
     SubGhzProtocolEncoderBase base;
 
@@ -57,6 +59,8 @@ const SubGhzProtocolDecoder subghz_protocol_princeton_decoder = {
 
     .feed = subghz_protocol_decoder_princeton_feed,
     .reset = subghz_protocol_decoder_princeton_reset,
+    .idle_ignore_duration = subghz_protocol_princeton_const.te_short * 36 -
+                            subghz_protocol_princeton_const.te_delta * 36,
 
     .get_hash_data = subghz_protocol_decoder_princeton_get_hash_data,
     .serialize = subghz_protocol_decoder_princeton_serialize,
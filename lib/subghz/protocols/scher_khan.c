@@ -30,6 +30,8 @@ struct SubGhzProtocolDecoderScherKhan {
     const char* protocol_name;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderScherKhan);
+
 struct SubGhzProtocolEncoderScherKhan {
     SubGhzProtocolEncoderBase base;
 
@@ -50,6 +52,8 @@ const SubGhzProtocolDecoder subghz_protocol_scher_khan_decoder = {
 
     .feed = subghz_protocol_decoder_scher_khan_feed,
     .reset = subghz_protocol_decoder_scher_khan_reset,
+    .idle_ignore_duration =
+        subghz_protocol_scher_khan_const.te_short * 2 - subghz_protocol_scher_khan_const.te_delta,
 
     .get_hash_data = subghz_protocol_decoder_scher_khan_get_hash_data,
     .serialize = subghz_protocol_decoder_scher_khan_serialize,
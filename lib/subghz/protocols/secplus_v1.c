@@ -43,6 +43,8 @@ struct SubGhzProtocolDecoderSecPlus_v1 {
     uint8_t data_array[44];
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderSecPlus_v1);
+
 struct SubGhzProtocolEncoderSecPlus_v1 {
     SubGhzProtocolEncoderBase base;
 
@@ -65,6 +67,8 @@ const SubGhzProtocolDecoder subghz_protocol_secplus_v1_decoder = {
 
     .feed = subghz_protocol_decoder_secplus_v1_feed,
     .reset = subghz_protocol_decoder_secplus_v1_reset,
+    .idle_ignore_duration = subghz_protocol_secplus_v1_const.te_short * 120 -
+                            subghz_protocol_secplus_v1_const.te_delta * 120,
 
     .get_hash_data = subghz_protocol_decoder_secplus_v1_get_hash_data,
     .serialize = subghz_protocol_decoder_secplus_v1_serialize,
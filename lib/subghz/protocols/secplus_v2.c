@@ -38,6 +38,8 @@ struct SubGhzProtocolDecoderSecPlus_v2 {
     uint64_t secplus_packet_1;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderSecPlus_v2);
+
 struct SubGhzProtocolEncoderSecPlus_v2 {
     SubGhzProtocolEncoderBase base;
 
@@ -57,6 +59,8 @@ const SubGhzProtocolDecoder subghz_protocol_secplus_v2_decoder = {
 
     .feed = subghz_protocol_decoder_secplus_v2_feed,
     .reset = subghz_protocol_decoder_secplus_v2_reset,
+    .idle_ignore_duration = subghz_protocol_secplus_v2_const.te_long * 130 -
+                            subghz_protocol_secplus_v2_const.te_delta * 100,
 
     .get_hash_data = subghz_protocol_decoder_secplus_v2_get_hash_data,
     .serialize = subghz_protocol_decoder_secplus_v2_serialize,
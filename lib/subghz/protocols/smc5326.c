@@ -46,6 +46,8 @@ struct SubGhzProtocolDecoderSMC5326 {
     uint32_t last_data;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderSMC5326);
+
 struct SubGhzProtocolEncoderSMC5326 {
     SubGhzProtocolEncoderBase base;
 
@@ -67,6 +69,8 @@ const SubGhzProtocolDecoder subghz_protocol_smc5326_decoder = {
 
     .feed = subghz_protocol_decoder_smc5326_feed,
     .reset = subghz_protocol_decoder_smc5326_reset,
+    .idle_ignore_duration =
+        subghz_protocol_smc5326_const.te_short * 24 - subghz_protocol_smc5326_const.te_delta * 12,
 
     .get_hash_data = subghz_protocol_decoder_smc5326_get_hash_data,
     .serialize = subghz_protocol_decoder_smc5326_serialize,
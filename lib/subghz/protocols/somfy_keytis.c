@@ -27,6 +27,8 @@ struct SubGhzProtocolDecoderSomfyKeytis {
     uint32_t press_duration_counter;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderSomfyKeytis);
+
 struct SubGhzProtocolEncoderSomfyKeytis {
     SubGhzProtocolEncoderBase base;
 
@@ -48,6 +50,8 @@ const SubGhzProtocolDecoder subghz_protocol_somfy_keytis_decoder = {
 
     .feed = subghz_protocol_decoder_somfy_keytis_feed,
     .reset = subghz_protocol_decoder_somfy_keytis_reset,
+    .idle_ignore_duration = subghz_protocol_somfy_keytis_const.te_short * 4 -
+                            subghz_protocol_somfy_keytis_const.te_delta * 4,
 
     .get_hash_data = subghz_protocol_decoder_somfy_keytis_get_hash_data,
     .serialize = subghz_protocol_decoder_somfy_keytis_serialize,
@@ -26,6 +26,8 @@ struct SubGhzProtocolDecoderSomfyTelis {
     ManchesterState manchester_saved_state;
 };
 
+SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK(SubGhzProtocolDecoderSomfyTelis);
+
 struct SubGhzProtocolEncoderSomfyTelis {
     SubGhzProtocolEncoderBase base;
 
@@ -47,6 +49,8 @@ const SubGhzProtocolDecoder subghz_protocol_somfy_telis_decoder = {
 
     .feed = subghz_protocol_decoder_somfy_telis_feed,
     .reset = subghz_protocol_decoder_somfy_telis_reset,
+    .idle_ignore_duration = subghz_protocol_somfy_telis_const.te_short * 4 -
+                            subghz_protocol_somfy_telis_const.te_delta * 4,
 
     .get_hash_data = subghz_protocol_decoder_somfy_telis_get_hash_data,
     .serialize = subghz_protocol_decoder_somfy_telis_serialize,
@@ -1,11 +1,18 @@
 #include "receiver.h"
 
 #include "registry.h"
+#include "blocks/decoder.h"
 
 #include <m-array.h>
 
 typedef struct {
     SubGhzProtocolEncoderBase* base;
+
+    // Pre-dispatch
+    SubGhzDecoderFeed feed;
+    SubGhzProtocolFlag flag;
+    uint32_t idle_ignore_duration;
+    const uint32_t* parser_step;
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
@@ -32,6 +39,14 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
         if(protocol->decoder && protocol->decoder->alloc) {
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
+            slot->feed = protocol->decoder->feed;
+            slot->flag = protocol->flag;
+            slot->idle_ignore_duration = protocol->decoder->idle_ignore_duration;
+            if(slot->idle_ignore_duration) {
+                // Layout is checked by SUBGHZ_PROTOCOL_DECODER_BLOCK_HEAD_CHECK in the protocol
+                SubGhzProtocolDecoderBlockHead* head = (SubGhzProtocolDecoderBlockHead*)slot->base;
+                slot->parser_step = &head->decoder.parser_step;
+            }
         }
     }
 
@@ -63,9 +78,12 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
 
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
-            }
+            if((slot->flag & instance->filter) == 0) continue;
+            // Idle decoder can't start a frame on a pulse this short, feeding it is a no-op
+            if(slot->parser_step && duration <= slot->idle_ignore_duration &&
+               *slot->parser_step == 0)
+                continue;
+            slot->feed(slot->base, level, duration);
         }
 }
 
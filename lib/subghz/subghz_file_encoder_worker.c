@@ -5,11 +5,40 @@
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/toolbox/strint.h>
+#include <lib/toolbox/varint.h>
 
 #define TAG "SubGhzFileEncoderWorker"
 
 #define SUBGHZ_FILE_ENCODER_LOAD 512
 
+#define SUBGHZ_FILE_ENCODER_BIN_MAGIC        (0x4E494252UL) // "RBIN"
+#define SUBGHZ_FILE_ENCODER_BIN_VERSION      (1U)
+#define SUBGHZ_FILE_ENCODER_BIN_BLOCK_SIZE   (2048U)
+#define SUBGHZ_FILE_ENCODER_BIN_VARINT_MAX   (5U)
+
+/** RAW sidecar header, followed by data_size bytes of zigzag varint durations */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved[3];
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t duration_count;
+    uint32_t data_size;
+} FURI_PACKED SubGhzFileEncoderBinHeader;
+
+/** RAW sidecar being written, durations are appended as they are parsed */
+typedef struct {
+    File* file;
+    uint8_t* buffer;
+    size_t buffer_used;
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t duration_count;
+    uint32_t data_size;
+    bool write_ok;
+} SubGhzFileEncoderBinWriter;
+
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
@@ -20,6 +49,9 @@ struct SubGhzFileEncoderWorker {
     volatile bool worker_running;
     volatile bool worker_stoping;
     bool is_storage_slow;
+    File* bin_file;
+    uint32_t bin_duration_count;
+    SubGhzFileEncoderBinWriter* bin_writer;
     FuriString* str_data;
     FuriString* file_path;
     const SubGhzDevice* device;
@@ -45,6 +77,10 @@ void subghz_file_encoder_worker_add_level_duration(
     if(sizeof(int32_t) != ret) FURI_LOG_E(TAG, "Invalid add duration in the stream");
 }
 
+static void subghz_file_encoder_worker_bin_writer_add(
+    SubGhzFileEncoderBinWriter* writer,
+    int32_t duration);
+
 bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
     // Line sample: "RAW_Data: -1, 2, -2..."
 
@@ -60,6 +96,9 @@ bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, co
         int32_t duration;
         while(strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
             subghz_file_encoder_worker_add_level_duration(instance, duration);
+            if(instance->bin_writer) {
+                subghz_file_encoder_worker_bin_writer_add(instance->bin_writer, duration);
+            }
             if(*str == ',') str++; // could also be `\0`
         }
 
@@ -92,6 +131,287 @@ LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
     }
 }
 
+static void subghz_file_encoder_worker_bin_get_path(const char* file_path, FuriString* bin_path) {
+    furi_string_printf(bin_path, "%s%s", file_path, SUBGHZ_FILE_ENCODER_WORKER_BIN_EXTENSION);
+}
+
+static bool subghz_file_encoder_worker_bin_get_source_info(
+    Storage* storage,
+    const char* file_path,
+    uint32_t* source_size,
+    uint32_t* source_timestamp) {
+    FileInfo file_info = {0};
+
+    bool success = (storage_common_stat(storage, file_path, &file_info) == FSE_OK) &&
+                   (storage_common_timestamp(storage, file_path, source_timestamp) == FSE_OK);
+    *source_size = (uint32_t)file_info.size;
+
+    return success;
+}
+
+/** Start writing a RAW sidecar for a .sub file
+ * 
+ * @param writer Pointer to a SubGhzFileEncoderBinWriter instance, file must be allocated
+ * @param storage Pointer to a Storage instance
+ * @param file_path Path to the RAW .sub file
+ * @param bin_path Path to the sidecar
+ * @return true if durations can be added
+ */
+static bool subghz_file_encoder_worker_bin_writer_begin(
+    SubGhzFileEncoderBinWriter* writer,
+    Storage* storage,
+    const char* file_path,
+    const char* bin_path) {
+    writer->buffer = NULL;
+    writer->buffer_used = 0;
+    writer->duration_count = 0;
+    writer->data_size = 0;
+    writer->write_ok = false;
+
+    if(!subghz_file_encoder_worker_bin_get_source_info(
+           storage, file_path, &writer->source_size, &writer->source_timestamp))
+        return false;
+    if(!storage_file_open(writer->file, bin_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) return false;
+
+    // Placeholder header, an interrupted build leaves a sidecar that fails validation
+    SubGhzFileEncoderBinHeader header = {0};
+    writer->write_ok = storage_file_write(writer->file, &header, sizeof(header)) ==
+                       sizeof(header);
+    writer->buffer = malloc(SUBGHZ_FILE_ENCODER_BIN_BLOCK_SIZE);
+
+    return writer->write_ok;
+}
+
+static void subghz_file_encoder_worker_bin_writer_flush(SubGhzFileEncoderBinWriter* writer) {
+    if(writer->write_ok && writer->buffer_used) {
+        writer->write_ok = storage_file_write(writer->file, writer->buffer, writer->buffer_used) ==
+                           writer->buffer_used;
+    }
+    writer->data_size += writer->buffer_used;
+    writer->buffer_used = 0;
+}
+
+static void subghz_file_encoder_worker_bin_writer_add(
+    SubGhzFileEncoderBinWriter* writer,
+    int32_t duration) {
+    if(!writer->write_ok) return;
+    if(writer->buffer_used + SUBGHZ_FILE_ENCODER_BIN_VARINT_MAX >
+       SUBGHZ_FILE_ENCODER_BIN_BLOCK_SIZE) {
+        subghz_file_encoder_worker_bin_writer_flush(writer);
+    }
+    writer->buffer_used += varint_int32_pack(duration, &writer->buffer[writer->buffer_used]);
+    writer->duration_count++;
+}
+
+/** Finish a RAW sidecar, it is removed unless complete and fully written
+ * 
+ * @param writer Pointer to a SubGhzFileEncoderBinWriter instance
+ * @param storage Pointer to a Storage instance
+ * @param bin_path Path to the sidecar
+ * @param complete true if all durations of the .sub file were added
+ * @return true if the sidecar is valid
+ */
+static bool subghz_file_encoder_worker_bin_writer_end(
+    SubGhzFileEncoderBinWriter* writer,
+    Storage* storage,
+    const char* bin_path,
+    bool complete) {
+    bool success = false;
+
+    do {
+        if(!complete) break;
+        subghz_file_encoder_worker_bin_writer_flush(writer);
+        if(!writer->write_ok) {
+            FURI_LOG_E(TAG, "Unable to write sidecar");
+            break;
+        }
+
+        SubGhzFileEncoderBinHeader header = {
+            .magic = SUBGHZ_FILE_ENCODER_BIN_MAGIC,
+            .version = SUBGHZ_FILE_ENCODER_BIN_VERSION,
+            .source_size = writer->source_size,
+            .source_timestamp = writer->source_timestamp,
+            .duration_count = writer->duration_count,
+            .data_size = writer->data_size,
+        };
+        if(!storage_file_seek(writer->file, 0, true)) break;
+        if(storage_file_write(writer->file, &header, sizeof(header)) != sizeof(header)) break;
+
+        FURI_LOG_I(TAG, "Sidecar built: %lu durations", writer->duration_count);
+        success = true;
+    } while(false);
+
+    storage_file_close(writer->file);
+    if(!success) {
+        storage_simply_remove(storage, bin_path);
+    }
+    free(writer->buffer);
+    writer->buffer = NULL;
+
+    return success;
+}
+
+bool subghz_file_encoder_worker_bin_build(Storage* storage, const char* file_path) {
+    furi_assert(storage);
+    furi_assert(file_path);
+
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    SubGhzFileEncoderBinWriter writer = {.file = storage_file_alloc(storage)};
+    FuriString* bin_path = furi_string_alloc();
+    FuriString* line = furi_string_alloc();
+    bool complete = false;
+
+    subghz_file_encoder_worker_bin_get_path(file_path, bin_path);
+
+    do {
+        if(!flipper_format_file_open_existing(flipper_format, file_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for read: %s", file_path);
+            break;
+        }
+        if(!flipper_format_read_string(flipper_format, "Protocol", line)) {
+            FURI_LOG_E(TAG, "Missing Protocol");
+            break;
+        }
+
+        Stream* stream = flipper_format_get_raw_stream(flipper_format);
+        //skip the end of the previous line "\n"
+        stream_seek(stream, 1, StreamOffsetFromCurrent);
+
+        if(!subghz_file_encoder_worker_bin_writer_begin(
+               &writer, storage, file_path, furi_string_get_cstr(bin_path)))
+            break;
+
+        // Same lines the text playback accepts, up to the first one without RAW_Data
+        while(writer.write_ok && stream_read_line(stream, line)) {
+            furi_string_trim(line);
+            char* str = strstr(furi_string_get_cstr(line), "RAW_Data: ");
+            if(!str) break;
+            str = strchr(str, ' ');
+
+            int32_t duration;
+            while(strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
+                subghz_file_encoder_worker_bin_writer_add(&writer, duration);
+                if(*str == ',') str++; // could also be `\0`
+            }
+        }
+        complete = true;
+    } while(false);
+
+    bool success = subghz_file_encoder_worker_bin_writer_end(
+        &writer, storage, furi_string_get_cstr(bin_path), complete);
+    flipper_format_file_close(flipper_format);
+
+    furi_string_free(line);
+    furi_string_free(bin_path);
+    storage_file_free(writer.file);
+    flipper_format_free(flipper_format);
+
+    return success;
+}
+
+static bool subghz_file_encoder_worker_bin_open_existing(SubGhzFileEncoderWorker* instance) {
+    const char* file_path = furi_string_get_cstr(instance->file_path);
+    SubGhzFileEncoderBinHeader header;
+    uint32_t source_size = 0;
+    uint32_t source_timestamp = 0;
+    bool success = false;
+
+    subghz_file_encoder_worker_bin_get_path(file_path, instance->str_data);
+
+    do {
+        if(!subghz_file_encoder_worker_bin_get_source_info(
+               instance->storage, file_path, &source_size, &source_timestamp))
+            break;
+        if(!storage_file_open(
+               instance->bin_file,
+               furi_string_get_cstr(instance->str_data),
+               FSAM_READ,
+               FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(instance->bin_file, &header, sizeof(header)) != sizeof(header))
+            break;
+        if(header.magic != SUBGHZ_FILE_ENCODER_BIN_MAGIC ||
+           header.version != SUBGHZ_FILE_ENCODER_BIN_VERSION)
+            break;
+        if(header.source_size != source_size || header.source_timestamp != source_timestamp)
+            break;
+        if(storage_file_size(instance->bin_file) != sizeof(header) + header.data_size) break;
+
+        instance->bin_duration_count = header.duration_count;
+        success = true;
+    } while(false);
+
+    if(!success) {
+        storage_file_close(instance->bin_file);
+    }
+
+    return success;
+}
+
+static void subghz_file_encoder_worker_bin_send(
+    SubGhzFileEncoderWorker* instance,
+    const int32_t* durations,
+    size_t count) {
+    const uint8_t* data = (const uint8_t*)durations;
+    size_t size = count * sizeof(int32_t);
+
+    while(size && instance->worker_running) {
+        size_t ret = furi_stream_buffer_send(instance->stream, data, size, 0);
+        data += ret;
+        size -= ret;
+        // Full: a blocked send would wake on every duration the DMA side takes, top up per tick
+        if(size) furi_delay_ms(1);
+    }
+}
+
+/** Stream durations from the RAW sidecar, reading it in large blocks
+ * 
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ */
+static void subghz_file_encoder_worker_bin_play(SubGhzFileEncoderWorker* instance) {
+    uint8_t* buffer = malloc(SUBGHZ_FILE_ENCODER_BIN_BLOCK_SIZE);
+    int32_t* durations = malloc(sizeof(int32_t) * SUBGHZ_FILE_ENCODER_LOAD);
+    size_t buffer_start = 0;
+    size_t buffer_end = 0;
+    bool is_eof = false;
+    uint32_t remaining = instance->bin_duration_count;
+
+    while(remaining && instance->worker_running) {
+        // Refill, keeping at least one whole varint in the buffer
+        if(!is_eof && (buffer_end - buffer_start) < SUBGHZ_FILE_ENCODER_BIN_VARINT_MAX) {
+            buffer_end -= buffer_start;
+            memmove(buffer, &buffer[buffer_start], buffer_end);
+            buffer_start = 0;
+
+            size_t to_read = SUBGHZ_FILE_ENCODER_BIN_BLOCK_SIZE - buffer_end;
+            size_t ret = storage_file_read(instance->bin_file, &buffer[buffer_end], to_read);
+            if(ret < to_read) is_eof = true;
+            buffer_end += ret;
+        }
+
+        size_t count = 0;
+        while(count < SUBGHZ_FILE_ENCODER_LOAD && remaining && buffer_start < buffer_end &&
+              (is_eof || (buffer_end - buffer_start) >= SUBGHZ_FILE_ENCODER_BIN_VARINT_MAX)) {
+            buffer_start += varint_int32_unpack(
+                &durations[count++], &buffer[buffer_start], buffer_end - buffer_start);
+            remaining--;
+        }
+
+        if(count == 0) {
+            FURI_LOG_E(TAG, "Sidecar is truncated");
+            break;
+        }
+        subghz_file_encoder_worker_bin_send(instance, durations, count);
+    }
+
+    if(instance->worker_running) {
+        subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+    }
+
+    free(durations);
+    free(buffer);
+}
+
 /** Worker thread
  * 
  * @param context 
@@ -101,9 +421,21 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     SubGhzFileEncoderWorker* instance = context;
     FURI_LOG_I(TAG, "Worker start");
     bool res = false;
+    bool use_bin = false;
+    bool complete = false;
+    SubGhzFileEncoderBinWriter bin_writer = {.file = instance->bin_file};
+    FuriString* bin_path = furi_string_alloc();
     instance->is_storage_slow = false;
     Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
     do {
+        if(subghz_file_encoder_worker_bin_open_existing(instance)) {
+            use_bin = true;
+            res = true;
+            instance->worker_stoping = false;
+            FURI_LOG_I(TAG, "Start transmission from sidecar");
+            break;
+        }
+
         if(!flipper_format_file_open_existing(
                instance->flipper_format, furi_string_get_cstr(instance->file_path))) {
             FURI_LOG_E(
@@ -122,8 +454,27 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         res = true;
         instance->worker_stoping = false;
         FURI_LOG_I(TAG, "Start transmission");
+
+        // No usable sidecar: write one from the durations as they are played, next play uses it
+        subghz_file_encoder_worker_bin_get_path(
+            furi_string_get_cstr(instance->file_path), bin_path);
+        if(subghz_file_encoder_worker_bin_writer_begin(
+               &bin_writer,
+               instance->storage,
+               furi_string_get_cstr(instance->file_path),
+               furi_string_get_cstr(bin_path))) {
+            instance->bin_writer = &bin_writer;
+        } else {
+            subghz_file_encoder_worker_bin_writer_end(
+                &bin_writer, instance->storage, furi_string_get_cstr(bin_path), false);
+        }
     } while(0);
 
+    if(res && use_bin) {
+        subghz_file_encoder_worker_bin_play(instance);
+        res = false;
+    }
+
     while(res && instance->worker_running) {
         size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
         if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
@@ -132,16 +483,25 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
                 if(!subghz_file_encoder_worker_data_parse(
                        instance, furi_string_get_cstr(instance->str_data))) {
                     subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+                    complete = true;
                     break;
                 }
             } else {
                 subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+                complete = true;
                 break;
             }
         } else {
             furi_delay_ms(1);
         }
     }
+    if(instance->bin_writer) {
+        // A stopped playback did not see every duration, its sidecar is dropped
+        instance->bin_writer = NULL;
+        subghz_file_encoder_worker_bin_writer_end(
+            &bin_writer, instance->storage, furi_string_get_cstr(bin_path), complete);
+    }
+    furi_string_free(bin_path);
     //waiting for the end of the transfer
     if(instance->is_storage_slow) {
         FURI_LOG_E(TAG, "Storage is slow");
@@ -161,6 +521,7 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         furi_delay_ms(50);
     }
     flipper_format_file_close(instance->flipper_format);
+    storage_file_close(instance->bin_file);
 
     FURI_LOG_I(TAG, "Worker stop");
     return 0;
@@ -175,6 +536,7 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
 
     instance->storage = furi_record_open(RECORD_STORAGE);
     instance->flipper_format = flipper_format_file_alloc(instance->storage);
+    instance->bin_file = storage_file_alloc(instance->storage);
 
     instance->str_data = furi_string_alloc();
     instance->file_path = furi_string_alloc();
@@ -193,6 +555,7 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     furi_string_free(instance->file_path);
 
     flipper_format_free(instance->flipper_format);
+    storage_file_free(instance->bin_file);
     furi_record_close(RECORD_STORAGE);
 
     free(instance);
@@ -1,11 +1,16 @@
 #pragma once
 
 #include <furi_hal.h>
+#include <toolbox/level_duration.h>
+#include <storage/storage.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Pre-parsed RAW sidecar, stored next to the .sub file */
+#define SUBGHZ_FILE_ENCODER_WORKER_BIN_EXTENSION ".rawbin"
+
 typedef void (*SubGhzFileEncoderWorkerCallbackEnd)(void* context);
 
 typedef struct SubGhzFileEncoderWorker SubGhzFileEncoderWorker;
@@ -39,6 +44,16 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance);
  */
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context);
 
+/** 
+ * Build the pre-parsed RAW sidecar for a .sub file.
+ * Playback without a sidecar writes one as it goes, this allows doing it ahead of time.
+ * The sidecar is rebuilt whenever the .sub file size or timestamp changes.
+ * @param storage Pointer to a Storage instance
+ * @param file_path Path to the RAW .sub file
+ * @return bool - true if ok
+ */
+bool subghz_file_encoder_worker_bin_build(Storage* storage, const char* file_path);
+
 /** 
  * Start SubGhzFileEncoderWorker.
  * @param instance Pointer to a SubGhzFileEncoderWorker instance
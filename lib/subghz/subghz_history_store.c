@@ -0,0 +1,442 @@
+#include "subghz_history_store.h"
+
+#include <m-array.h>
+#include <storage/storage.h>
+#include <toolbox/path.h>
+#include <toolbox/stream/stream.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/stream/string_stream.h>
+#include <flipper_format/flipper_format_i.h>
+
+#define TAG "SubGhzHistoryStore"
+
+// Serialized signals kept in RAM when there is no SD card
+#define SUBGHZ_HISTORY_STORE_RAM_SPILL_MAX (8U * 1024U)
+// Serialized signals waiting for subghz_history_store_flush, with SD card
+#define SUBGHZ_HISTORY_STORE_PENDING_MAX (4U * 1024U)
+
+typedef struct {
+    uint32_t key;
+    uint32_t frequency;
+    uint32_t offset;
+    uint16_t size;
+    uint16_t preset_id;
+    const SubGhzProtocol* protocol;
+    char text[SUBGHZ_HISTORY_STORE_TEXT_SIZE];
+} SubGhzHistoryStoreRecord;
+
+typedef struct {
+    FuriString* name;
+    uint8_t* data;
+    size_t data_size;
+} SubGhzHistoryStorePreset;
+
+ARRAY_DEF(SubGhzHistoryStorePresetArray, SubGhzHistoryStorePreset, M_POD_OPLIST)
+
+/* Signal offsets are continuous over three streams:
+ * [0, spill_size) spill file, written by the app thread only
+ * [spill_size, pending_base) flushing, being written to the spill file
+ * [pending_base, ...) pending, appended to on add, under the mutex
+ * Without SD card there is no spill file and everything stays pending.
+ */
+struct SubGhzHistoryStore {
+    FuriMutex* mutex;
+    Storage* storage;
+    FuriString* spill_path;
+    Stream* spill;
+    bool spill_in_ram;
+    size_t spill_size;
+    Stream* flushing;
+    Stream* pending;
+    size_t pending_base;
+
+    SubGhzHistoryStoreRecord* records;
+    size_t count;
+    size_t max;
+
+    // Merged records by key, open addressing, record index + 1, 0 is empty
+    uint16_t* slots;
+    size_t slot_mask;
+
+    SubGhzHistoryStorePresetArray_t presets;
+    SubGhzRadioPreset preset;
+
+    FlipperFormat* flipper_format;
+};
+
+static void subghz_history_store_spill_close(SubGhzHistoryStore* instance) {
+    if(!instance->spill) return;
+
+    stream_free(instance->spill);
+    instance->spill = NULL;
+    storage_simply_remove(instance->storage, furi_string_get_cstr(instance->spill_path));
+}
+
+/** Recreate the spill file, SD card I/O, app thread only and without the mutex */
+static void subghz_history_store_spill_open(SubGhzHistoryStore* instance) {
+    subghz_history_store_spill_close(instance);
+
+    FuriString* dirname = furi_string_alloc();
+    path_extract_dirname(furi_string_get_cstr(instance->spill_path), dirname);
+    storage_simply_mkdir(instance->storage, furi_string_get_cstr(dirname));
+    furi_string_free(dirname);
+
+    instance->spill = file_stream_alloc(instance->storage);
+
+    if(!file_stream_open(
+           instance->spill,
+           furi_string_get_cstr(instance->spill_path),
+           FSAM_READ_WRITE,
+           FSOM_CREATE_ALWAYS)) {
+        FURI_LOG_W(TAG, "Spill file unavailable, keeping signals in RAM");
+        stream_free(instance->spill);
+        instance->spill = NULL;
+    }
+}
+
+/** Clear records and signals, with the mutex held */
+static void subghz_history_store_clear(SubGhzHistoryStore* instance) {
+    instance->spill_in_ram = !instance->spill;
+    instance->spill_size = 0;
+    instance->pending_base = 0;
+    stream_clean(instance->flushing);
+    stream_clean(instance->pending);
+
+    instance->count = 0;
+    memset(instance->slots, 0, sizeof(uint16_t) * (instance->slot_mask + 1));
+}
+
+SubGhzHistoryStore* subghz_history_store_alloc(size_t max_records, const char* spill_path) {
+    furi_check(max_records > 0 && max_records < UINT16_MAX);
+    furi_check(spill_path);
+
+    SubGhzHistoryStore* instance = malloc(sizeof(SubGhzHistoryStore));
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->spill_path = furi_string_alloc_set(spill_path);
+
+    instance->max = max_records;
+    instance->records = malloc(sizeof(SubGhzHistoryStoreRecord) * max_records);
+
+    // At most half full, keeps probe sequences short
+    size_t slot_count = 1;
+    while(slot_count < max_records * 2) {
+        slot_count <<= 1;
+    }
+    instance->slots = malloc(sizeof(uint16_t) * slot_count);
+    instance->slot_mask = slot_count - 1;
+
+    SubGhzHistoryStorePresetArray_init(instance->presets);
+    instance->preset.name = furi_string_alloc();
+    instance->flipper_format = flipper_format_string_alloc();
+    instance->flushing = string_stream_alloc();
+    instance->pending = string_stream_alloc();
+
+    subghz_history_store_spill_open(instance);
+    subghz_history_store_clear(instance);
+
+    return instance;
+}
+
+static void subghz_history_store_presets_reset(SubGhzHistoryStore* instance) {
+    for
+        M_EACH(preset, instance->presets, SubGhzHistoryStorePresetArray_t) {
+            furi_string_free(preset->name);
+        }
+    SubGhzHistoryStorePresetArray_reset(instance->presets);
+}
+
+void subghz_history_store_free(SubGhzHistoryStore* instance) {
+    furi_check(instance);
+
+    subghz_history_store_spill_close(instance);
+
+    stream_free(instance->pending);
+    stream_free(instance->flushing);
+    flipper_format_free(instance->flipper_format);
+    furi_string_free(instance->preset.name);
+    subghz_history_store_presets_reset(instance);
+    SubGhzHistoryStorePresetArray_clear(instance->presets);
+
+    free(instance->slots);
+    free(instance->records);
+    furi_string_free(instance->spill_path);
+    furi_record_close(RECORD_STORAGE);
+    furi_mutex_free(instance->mutex);
+
+    free(instance);
+}
+
+void subghz_history_store_reset(SubGhzHistoryStore* instance) {
+    furi_check(instance);
+
+    // Adds only touch the pending stream, the spill file is not theirs
+    subghz_history_store_spill_open(instance);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    subghz_history_store_clear(instance);
+    subghz_history_store_presets_reset(instance);
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+}
+
+size_t subghz_history_store_get_count(SubGhzHistoryStore* instance) {
+    furi_check(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const size_t count = instance->count;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+    return count;
+}
+
+size_t subghz_history_store_get_max(SubGhzHistoryStore* instance) {
+    furi_check(instance);
+    return instance->max;
+}
+
+static uint16_t* subghz_history_store_find_slot(SubGhzHistoryStore* instance, uint32_t key) {
+    uint32_t hash = key * 2654435761UL;
+    size_t slot = (hash ^ (hash >> 16)) & instance->slot_mask;
+
+    // Never full, the loop always ends on an empty slot
+    while(instance->slots[slot]) {
+        if(instance->records[instance->slots[slot] - 1].key == key) break;
+        slot = (slot + 1) & instance->slot_mask;
+    }
+
+    return &instance->slots[slot];
+}
+
+static uint16_t
+    subghz_history_store_get_preset_id(SubGhzHistoryStore* instance, SubGhzRadioPreset* preset) {
+    const size_t count = SubGhzHistoryStorePresetArray_size(instance->presets);
+
+    for(size_t i = 0; i < count; i++) {
+        SubGhzHistoryStorePreset* item = SubGhzHistoryStorePresetArray_get(instance->presets, i);
+        if(item->data == preset->data && furi_string_equal(item->name, preset->name)) {
+            return i;
+        }
+    }
+
+    furi_check(count < UINT16_MAX);
+    SubGhzHistoryStorePreset* item = SubGhzHistoryStorePresetArray_push_raw(instance->presets);
+    item->name = furi_string_alloc_set(preset->name);
+    item->data = preset->data;
+    item->data_size = preset->data_size;
+
+    return count;
+}
+
+/** Drop pending signals no record points to anymore */
+static void subghz_history_store_pending_compact(SubGhzHistoryStore* instance) {
+    Stream* pending = string_stream_alloc();
+
+    for(size_t i = 0; i < instance->count; i++) {
+        SubGhzHistoryStoreRecord* record = &instance->records[i];
+        if(record->offset < instance->pending_base) continue;
+
+        const size_t offset = stream_tell(pending);
+        stream_seek(
+            instance->pending, record->offset - instance->pending_base, StreamOffsetFromStart);
+        stream_copy(instance->pending, pending, record->size);
+        record->offset = instance->pending_base + offset;
+    }
+
+    stream_free(instance->pending);
+    instance->pending = pending;
+}
+
+/** Append a serialized signal to the pending stream, RAM only, with the mutex held */
+static bool subghz_history_store_pending_write(
+    SubGhzHistoryStore* instance,
+    FlipperFormat* flipper_format,
+    uint32_t* offset,
+    uint16_t* size) {
+    Stream* source = flipper_format_get_raw_stream(flipper_format);
+    const size_t source_size = stream_size(source);
+    const size_t limit = instance->spill_in_ram ? SUBGHZ_HISTORY_STORE_RAM_SPILL_MAX :
+                                                  SUBGHZ_HISTORY_STORE_PENDING_MAX;
+
+    if(source_size > UINT16_MAX) return false;
+
+    if(stream_size(instance->pending) + source_size > limit) {
+        subghz_history_store_pending_compact(instance);
+    }
+    if(stream_size(instance->pending) + source_size > limit) {
+        return false;
+    }
+
+    if(!stream_rewind(source) || !stream_seek(instance->pending, 0, StreamOffsetFromEnd)) {
+        return false;
+    }
+
+    *offset = instance->pending_base + stream_tell(instance->pending);
+    *size = source_size;
+
+    return stream_copy(source, instance->pending, source_size) == source_size;
+}
+
+SubGhzHistoryStoreAdd subghz_history_store_add(
+    SubGhzHistoryStore* instance,
+    bool merge,
+    uint32_t key,
+    const SubGhzProtocol* protocol,
+    SubGhzRadioPreset* preset,
+    const char* text,
+    FlipperFormat* flipper_format) {
+    furi_check(instance);
+    furi_check(protocol);
+    furi_check(preset);
+    furi_check(text);
+    furi_check(flipper_format);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    SubGhzHistoryStoreAdd result = SubGhzHistoryStoreAddUpdate;
+    uint16_t* slot = NULL;
+    SubGhzHistoryStoreRecord* record = NULL;
+
+    if(merge) {
+        slot = subghz_history_store_find_slot(instance, key);
+        if(*slot) record = &instance->records[*slot - 1];
+    }
+
+    do {
+        if(!record && instance->count >= instance->max) {
+            result = SubGhzHistoryStoreAddOverflow;
+            break;
+        }
+
+        // Signal first, the record is left as it was on failure
+        uint32_t offset = 0;
+        uint16_t size = 0;
+        if(!subghz_history_store_pending_write(instance, flipper_format, &offset, &size)) {
+            FURI_LOG_E(TAG, "Failed to store signal");
+            result = SubGhzHistoryStoreAddError;
+            break;
+        }
+
+        if(!record) {
+            record = &instance->records[instance->count++];
+            if(slot) *slot = instance->count;
+            result = SubGhzHistoryStoreAddNew;
+        }
+
+        record->key = key;
+        record->frequency = preset->frequency;
+        record->offset = offset;
+        record->size = size;
+        record->preset_id = subghz_history_store_get_preset_id(instance, preset);
+        record->protocol = protocol;
+        strlcpy(record->text, text, sizeof(record->text));
+    } while(false);
+
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    return result;
+}
+
+bool subghz_history_store_flush(SubGhzHistoryStore* instance) {
+    furi_check(instance);
+
+    // Pending signals are handed over, adds go on into an empty stream meanwhile
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    if(!instance->spill_in_ram && stream_size(instance->flushing) == 0) {
+        Stream* flushing = instance->pending;
+        instance->pending = instance->flushing;
+        instance->flushing = flushing;
+        instance->pending_base += stream_size(flushing);
+    }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    const size_t size = stream_size(instance->flushing);
+    if(!size) return true;
+
+    // Written where the last flush ended, a failed one is retried over its leftovers
+    bool success = stream_rewind(instance->flushing) &&
+                   stream_seek(instance->spill, instance->spill_size, StreamOffsetFromStart) &&
+                   (stream_copy(instance->flushing, instance->spill, size) == size);
+
+    if(success) {
+        instance->spill_size += size;
+        stream_clean(instance->flushing);
+    } else {
+        FURI_LOG_E(TAG, "Failed to spill signals");
+    }
+
+    return success;
+}
+
+/** Acquire the mutex and get a record, release with subghz_history_store_put_record */
+static SubGhzHistoryStoreRecord*
+    subghz_history_store_get_record(SubGhzHistoryStore* instance, size_t idx) {
+    furi_check(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(idx < instance->count);
+    return &instance->records[idx];
+}
+
+static void subghz_history_store_put_record(SubGhzHistoryStore* instance) {
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+}
+
+void subghz_history_store_get_text(SubGhzHistoryStore* instance, size_t idx, FuriString* output) {
+    furi_check(output);
+    furi_string_set(output, subghz_history_store_get_record(instance, idx)->text);
+    subghz_history_store_put_record(instance);
+}
+
+const SubGhzProtocol* subghz_history_store_get_protocol(SubGhzHistoryStore* instance, size_t idx) {
+    const SubGhzProtocol* protocol = subghz_history_store_get_record(instance, idx)->protocol;
+    subghz_history_store_put_record(instance);
+    return protocol;
+}
+
+SubGhzRadioPreset*
+    subghz_history_store_get_radio_preset(SubGhzHistoryStore* instance, size_t idx) {
+    SubGhzHistoryStoreRecord* record = subghz_history_store_get_record(instance, idx);
+    SubGhzHistoryStorePreset* preset =
+        SubGhzHistoryStorePresetArray_get(instance->presets, record->preset_id);
+
+    furi_string_set(instance->preset.name, preset->name);
+    instance->preset.frequency = record->frequency;
+    instance->preset.data = preset->data;
+    instance->preset.data_size = preset->data_size;
+
+    subghz_history_store_put_record(instance);
+
+    return &instance->preset;
+}
+
+FlipperFormat* subghz_history_store_get_flipper_format(SubGhzHistoryStore* instance, size_t idx) {
+    SubGhzHistoryStoreRecord* record = subghz_history_store_get_record(instance, idx);
+    Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
+    size_t offset = record->offset;
+    const size_t size = record->size;
+
+    stream_clean(stream);
+    bool success = false;
+    if(offset >= instance->pending_base) {
+        // Adds write here, copied out before letting them in again
+        offset -= instance->pending_base;
+        success = stream_seek(instance->pending, offset, StreamOffsetFromStart) &&
+                  (stream_copy(instance->pending, stream, size) == size);
+        subghz_history_store_put_record(instance);
+    } else {
+        // Flushing and spill file belong to the app thread, read without the mutex
+        subghz_history_store_put_record(instance);
+        Stream* source = instance->spill;
+        if(offset >= instance->spill_size) {
+            source = instance->flushing;
+            offset -= instance->spill_size;
+        }
+        success = stream_seek(source, offset, StreamOffsetFromStart) &&
+                  (stream_copy(source, stream, size) == size);
+    }
+    flipper_format_rewind(instance->flipper_format);
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Failed to load signal");
+        return NULL;
+    }
+
+    return instance->flipper_format;
+}
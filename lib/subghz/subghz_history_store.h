@@ -0,0 +1,145 @@
+/**
+ * @file subghz_history_store.h
+ * Compact received signal history for SubGhz receiver apps
+ *
+ * Every record is a fixed size entry kept in RAM: menu text, protocol type and
+ * name, radio preset and the location of the serialized signal. Serialized
+ * signals are appended to a spill file on SD card and only loaded back into a
+ * FlipperFormat when an item is opened. Without SD card they are kept in RAM.
+ * Records with the same key can be merged, lookup is hashed.
+ *
+ * Thread safe. subghz_history_store_add never touches the SD card, so it can be
+ * called from the radio worker thread. Signals added are kept in RAM until the
+ * app thread calls subghz_history_store_flush, periodically, e.g. on tick.
+ * Everything else is meant for the app thread.
+ */
+#pragma once
+
+#include <furi.h>
+#include <lib/flipper_format/flipper_format.h>
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUBGHZ_HISTORY_STORE_TEXT_SIZE (40U)
+
+typedef struct SubGhzHistoryStore SubGhzHistoryStore;
+
+typedef enum {
+    SubGhzHistoryStoreAddNew, /**< New record added */
+    SubGhzHistoryStoreAddUpdate, /**< Record with the same key updated */
+    SubGhzHistoryStoreAddOverflow, /**< No space left */
+    SubGhzHistoryStoreAddError, /**< Serialized signal was not stored */
+} SubGhzHistoryStoreAdd;
+
+/** Allocate SubGhzHistoryStore
+ *
+ * @param      max_records  maximum number of records
+ * @param      spill_path   spill file path, recreated on every reset
+ *
+ * @return     SubGhzHistoryStore instance
+ */
+SubGhzHistoryStore* subghz_history_store_alloc(size_t max_records, const char* spill_path);
+
+/** Free SubGhzHistoryStore, the spill file is removed
+ *
+ * @param      instance  SubGhzHistoryStore instance
+ */
+void subghz_history_store_free(SubGhzHistoryStore* instance);
+
+/** Remove all records
+ *
+ * @param      instance  SubGhzHistoryStore instance
+ */
+void subghz_history_store_reset(SubGhzHistoryStore* instance);
+
+/** Get number of records
+ *
+ * @param      instance  SubGhzHistoryStore instance
+ *
+ * @return     number of records
+ */
+size_t subghz_history_store_get_count(SubGhzHistoryStore* instance);
+
+/** Get maximum number of records
+ *
+ * @param      instance  SubGhzHistoryStore instance
+ *
+ * @return     maximum number of records
+ */
+size_t subghz_history_store_get_max(SubGhzHistoryStore* instance);
+
+/** Add a record or update the record with the same key
+ *
+ * RAM only, does not wait for SD card I/O.
+ *
+ * @param      instance       SubGhzHistoryStore instance
+ * @param      merge          update the record with the same key instead of adding
+ * @param      key            record key, used when merge is true
+ * @param      protocol       protocol of the signal, must outlive the store
+ * @param      preset         SubGhzRadioPreset the signal was received with
+ * @param      text           menu text, truncated to SUBGHZ_HISTORY_STORE_TEXT_SIZE
+ * @param      flipper_format serialized signal, read from the start
+ *
+ * @return     SubGhzHistoryStoreAdd
+ */
+SubGhzHistoryStoreAdd subghz_history_store_add(
+    SubGhzHistoryStore* instance,
+    bool merge,
+    uint32_t key,
+    const SubGhzProtocol* protocol,
+    SubGhzRadioPreset* preset,
+    const char* text,
+    FlipperFormat* flipper_format);
+
+/** Append signals added since the last call to the spill file
+ *
+ * Does SD card I/O, call from the app thread. Adds are not blocked meanwhile.
+ * Signals that failed to be written stay in RAM and are retried on the next call.
+ *
+ * @param      instance  SubGhzHistoryStore instance
+ *
+ * @return     true if nothing is left to write
+ */
+bool subghz_history_store_flush(SubGhzHistoryStore* instance);
+
+/** Get record menu text
+ *
+ * @param      instance  SubGhzHistoryStore instance
+ * @param      idx       record index
+ * @param      output    menu text, copied as a merge can change it
+ */
+void subghz_history_store_get_text(SubGhzHistoryStore* instance, size_t idx, FuriString* output);
+
+/** Get record protocol
+ *
+ * @param      instance  SubGhzHistoryStore instance
+ * @param      idx       record index
+ *
+ * @return     SubGhzProtocol passed on add
+ */
+const SubGhzProtocol* subghz_history_store_get_protocol(SubGhzHistoryStore* instance, size_t idx);
+
+/** Get record radio preset
+ *
+ * @param      instance  SubGhzHistoryStore instance
+ * @param      idx       record index
+ *
+ * @return     SubGhzRadioPreset, valid until the next call
+ */
+SubGhzRadioPreset* subghz_history_store_get_radio_preset(SubGhzHistoryStore* instance, size_t idx);
+
+/** Load record serialized signal
+ *
+ * @param      instance  SubGhzHistoryStore instance
+ * @param      idx       record index
+ *
+ * @return     FlipperFormat rewound to the start, valid until the next call, NULL on error
+ */
+FlipperFormat* subghz_history_store_get_flipper_format(SubGhzHistoryStore* instance, size_t idx);
+
+#ifdef __cplusplus
+}
+#endif
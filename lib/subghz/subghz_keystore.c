@@ -5,6 +5,7 @@
 
 #include <storage/storage.h>
 #include <toolbox/hex.h>
+#include <toolbox/crc32_calc.h>
 #include <toolbox/stream/stream.h>
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
@@ -21,19 +22,118 @@
 #define SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE 512
 #define SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE (SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE * 2)
 
+#define SUBGHZ_KEYSTORE_RAW_BLOCK_SIZE  64
+#define SUBGHZ_KEYSTORE_RAW_BLOCK_COUNT 8
+#define SUBGHZ_KEYSTORE_RAW_BLOCK_EMPTY UINT32_MAX
+
+#define SUBGHZ_KEYSTORE_POOL_SIZE_MIN 256
+
+#define SUBGHZ_KEYSTORE_CACHE_MAGIC      (0x4E42534BUL) // "KSBN"
+#define SUBGHZ_KEYSTORE_CACHE_VERSION    (1U)
+#define SUBGHZ_KEYSTORE_CACHE_CHECK      "SubGhz Keystore"
+#define SUBGHZ_KEYSTORE_CACHE_BLOCK_SIZE (512U)
+
 typedef enum {
     SubGhzKeystoreEncryptionNone,
     SubGhzKeystoreEncryptionAES256,
 } SubGhzKeystoreEncryption;
 
+/** Keystore cache header, followed by the encrypted check block, key records, name pool
+ * and a trailer block with CRC32 of everything before it */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved[3];
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t key_count;
+    uint32_t pool_size;
+    uint8_t iv[16];
+} FURI_PACKED SubGhzKeystoreCacheHeader;
+
+/** Keystore cache key record, one AES block */
+typedef struct {
+    uint64_t key;
+    uint32_t name_offset;
+    uint16_t type;
+    uint16_t reserved;
+} FURI_PACKED SubGhzKeystoreCacheKey;
+
+/** Name pool under construction, names are NUL terminated */
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} SubGhzKeystorePool;
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+    char** pools;
+    size_t pool_count;
+    const SubGhzKey** name_index;
+    uint32_t generation;
 };
 
+typedef struct {
+    uint32_t index;
+    uint32_t last_used;
+    uint8_t data[SUBGHZ_KEYSTORE_RAW_BLOCK_SIZE];
+} SubGhzKeystoreRawBlock;
+
+struct SubGhzKeystoreRaw {
+    FuriString* file_name;
+    FuriMutex* mutex;
+    Storage* storage;
+    FlipperFormat* flipper_format;
+    size_t data_start;
+    size_t data_size;
+    uint8_t iv[16];
+    uint32_t use_counter;
+    SubGhzKeystoreRawBlock blocks[SUBGHZ_KEYSTORE_RAW_BLOCK_COUNT];
+};
+
+static void subghz_keystore_mess_with_iv(uint8_t* iv) {
+    // Alignment check for `ldrd` instruction
+    furi_assert(((uintptr_t)iv) % 4 == 0);
+    // Please do not share decrypted manufacture keys
+    // Sharing them will bring some discomfort to legal owners
+    // And potential legal action against you
+    // While you reading this code think about your own personal responsibility
+#ifdef __arm__
+    asm volatile("nani%=:                  \n"
+                 "ldrd  r0, r2, [%0, #0x0] \n"
+                 "lsl   r1, r0, #8         \n"
+                 "lsl   r3, r2, #8         \n"
+                 "orr   r3, r3, r0, lsr #24\n"
+                 "uadd8 r1, r1, r0         \n"
+                 "uadd8 r3, r3, r2         \n"
+                 "strd  r1, r3, [%0, #0x0] \n"
+                 "ldrd  r1, r3, [%0, #0x8] \n"
+                 "lsl   r0, r1, #8         \n"
+                 "orr   r0, r0, r2, lsr #24\n"
+                 "lsl   r2, r3, #8         \n"
+                 "orr   r2, r2, r1, lsr #24\n"
+                 "uadd8 r1, r1, r0         \n"
+                 "uadd8 r3, r3, r2         \n"
+                 "strd  r1, r3, [%0, #0x8] \n"
+                 :
+                 : "r"(iv)
+                 : "r0", "r1", "r2", "r3", "memory");
+#else
+    // Same bytewise sum for host builds
+    for(size_t i = 15; i > 0; i--) {
+        iv[i] += iv[i - 1];
+    }
+#endif
+}
+
 SubGhzKeystore* subghz_keystore_alloc(void) {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    instance->pools = NULL;
+    instance->pool_count = 0;
+    instance->name_index = NULL;
 
     return instance;
 }
@@ -43,26 +143,90 @@ void subghz_keystore_free(SubGhzKeystore* instance) {
 
     for
         M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
-            furi_string_free(manufacture_code->name);
+            manufacture_code->name = NULL;
             manufacture_code->key = 0;
         }
     SubGhzKeyArray_clear(instance->data);
 
+    for(size_t i = 0; i < instance->pool_count; i++) {
+        free(instance->pools[i]);
+    }
+    free(instance->pools);
+    free(instance->name_index);
+
     free(instance);
 }
 
 static void subghz_keystore_add_key(
     SubGhzKeystore* instance,
+    SubGhzKeystorePool* pool,
     const char* name,
     uint64_t key,
     uint16_t type) {
+    size_t name_size = strlen(name) + 1;
+    if(pool->size + name_size > pool->capacity) {
+        pool->capacity = MAX(pool->capacity * 2, pool->size + name_size);
+        pool->capacity = MAX(pool->capacity, (size_t)SUBGHZ_KEYSTORE_POOL_SIZE_MIN);
+        pool->data = realloc(pool->data, pool->capacity); //-V701
+    }
+    memcpy(&pool->data[pool->size], name, name_size);
+
     SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
-    manufacture_code->name = furi_string_alloc_set(name);
+    // Pool offset until the pool is committed and stops moving
+    manufacture_code->name = (const char*)(uintptr_t)pool->size;
     manufacture_code->key = key;
     manufacture_code->type = type;
+
+    pool->size += name_size;
+}
+
+static int subghz_keystore_name_index_cmp(const void* a, const void* b) {
+    const SubGhzKey* key_a = *(const SubGhzKey**)a;
+    const SubGhzKey* key_b = *(const SubGhzKey**)b;
+    int res = strcmp(key_a->name, key_b->name);
+    // Equal names keep the load order
+    if(res == 0) res = (key_a > key_b) - (key_a < key_b);
+    return res;
 }
 
-static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
+/** Resolve names of the keys loaded since first_key and take ownership of the pool */
+static void subghz_keystore_commit_pool(
+    SubGhzKeystore* instance,
+    SubGhzKeystorePool* pool,
+    size_t first_key) {
+    size_t count = SubGhzKeyArray_size(instance->data);
+    if(first_key < count) {
+        pool->data = realloc(pool->data, pool->size); //-V701
+        instance->pools =
+            realloc(instance->pools, (instance->pool_count + 1) * sizeof(char*)); //-V701
+        instance->pools[instance->pool_count++] = pool->data;
+
+        for(size_t i = first_key; i < count; i++) {
+            SubGhzKey* manufacture_code = SubGhzKeyArray_get(instance->data, i);
+            manufacture_code->name = pool->data + (uintptr_t)manufacture_code->name;
+        }
+
+        // Key array may have moved, the index is rebuilt as a whole
+        instance->name_index =
+            realloc(instance->name_index, count * sizeof(const SubGhzKey*)); //-V701
+        for(size_t i = 0; i < count; i++) {
+            instance->name_index[i] = SubGhzKeyArray_cget(instance->data, i);
+        }
+        qsort(
+            instance->name_index, count, sizeof(const SubGhzKey*), subghz_keystore_name_index_cmp);
+    } else {
+        free(pool->data);
+    }
+
+    pool->data = NULL;
+    pool->size = 0;
+    pool->capacity = 0;
+}
+
+static bool subghz_keystore_process_line(
+    SubGhzKeystore* instance,
+    SubGhzKeystorePool* pool,
+    char* line) {
     uint64_t key = 0;
     uint16_t type = 0;
     char skey[17] = {0};
@@ -70,7 +234,7 @@ static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
     int ret = sscanf(line, "%16s:%hu:%64s", skey, &type, name);
     key = strtoull(skey, NULL, 16);
     if(ret == 3) {
-        subghz_keystore_add_key(instance, name, key, type);
+        subghz_keystore_add_key(instance, pool, name, key, type);
         return true;
     } else {
         FURI_LOG_E(TAG, "Failed to load line: %s\r\n", line);
@@ -78,35 +242,11 @@ static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
     }
 }
 
-static void subghz_keystore_mess_with_iv(uint8_t* iv) {
-    // Alignment check for `ldrd` instruction
-    furi_assert(((uint32_t)iv) % 4 == 0);
-    // Please do not share decrypted manufacture keys
-    // Sharing them will bring some discomfort to legal owners
-    // And potential legal action against you
-    // While you reading this code think about your own personal responsibility
-    asm volatile("nani%=:                  \n"
-                 "ldrd  r0, r2, [%0, #0x0] \n"
-                 "lsl   r1, r0, #8         \n"
-                 "lsl   r3, r2, #8         \n"
-                 "orr   r3, r3, r0, lsr #24\n"
-                 "uadd8 r1, r1, r0         \n"
-                 "uadd8 r3, r3, r2         \n"
-                 "strd  r1, r3, [%0, #0x0] \n"
-                 "ldrd  r1, r3, [%0, #0x8] \n"
-                 "lsl   r0, r1, #8         \n"
-                 "orr   r0, r0, r2, lsr #24\n"
-                 "lsl   r2, r3, #8         \n"
-                 "orr   r2, r2, r1, lsr #24\n"
-                 "uadd8 r1, r1, r0         \n"
-                 "uadd8 r3, r3, r2         \n"
-                 "strd  r1, r3, [%0, #0x8] \n"
-                 :
-                 : "r"(iv)
-                 : "r0", "r1", "r2", "r3", "memory");
-}
-
-static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream, uint8_t* iv) {
+static bool subghz_keystore_read_file(
+    SubGhzKeystore* instance,
+    SubGhzKeystorePool* pool,
+    Stream* stream,
+    uint8_t* iv) {
     bool result = true;
     uint8_t buffer[FILE_BUFFER_SIZE];
 
@@ -144,7 +284,7 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
 
                             if(furi_hal_crypto_decrypt(
                                    (uint8_t*)encrypted_line, (uint8_t*)decrypted_line, len)) {
-                                subghz_keystore_process_line(instance, decrypted_line);
+                                subghz_keystore_process_line(instance, pool, decrypted_line);
                             } else {
                                 FURI_LOG_E(TAG, "Decryption failed");
                                 result = false;
@@ -154,7 +294,7 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
                             FURI_LOG_E(TAG, "Invalid encrypted data: %s", encrypted_line);
                         }
                     } else {
-                        subghz_keystore_process_line(instance, encrypted_line);
+                        subghz_keystore_process_line(instance, pool, encrypted_line);
                     }
                     // reset line buffer
                     memset(decrypted_line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
@@ -184,60 +324,331 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
     return result;
 }
 
+static void subghz_keystore_cache_get_path(const char* file_name, FuriString* cache_path) {
+    furi_string_printf(cache_path, "%s%s", file_name, SUBGHZ_KEYSTORE_CACHE_EXTENSION);
+}
+
+static bool subghz_keystore_cache_get_source_info(
+    Storage* storage,
+    const char* file_name,
+    uint32_t* source_size,
+    uint32_t* source_timestamp) {
+    FileInfo file_info = {0};
+
+    bool success = (storage_common_stat(storage, file_name, &file_info) == FSE_OK) &&
+                   (storage_common_timestamp(storage, file_name, source_timestamp) == FSE_OK);
+    *source_size = (uint32_t)file_info.size;
+
+    return success;
+}
+
+static bool
+    subghz_keystore_cache_read_block(File* file, uint8_t* data, size_t size, uint32_t* crc) {
+    if(storage_file_read(file, data, size) != size) return false;
+    if(!furi_hal_crypto_decrypt(data, data, size)) return false;
+    *crc = crc32_calc_buffer(*crc, data, size);
+    return true;
+}
+
+static bool subghz_keystore_cache_load(
+    SubGhzKeystore* instance,
+    Storage* storage,
+    const char* cache_path,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    File* file = storage_file_alloc(storage);
+    SubGhzKeystoreCacheHeader header;
+    SubGhzKeystoreCacheKey* records = malloc(SUBGHZ_KEYSTORE_CACHE_BLOCK_SIZE);
+    SubGhzKeystorePool pool = {0};
+    size_t first_key = SubGhzKeyArray_size(instance->data);
+    bool key_loaded = false;
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, cache_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != SUBGHZ_KEYSTORE_CACHE_MAGIC ||
+           header.version != SUBGHZ_KEYSTORE_CACHE_VERSION)
+            break;
+        if(header.source_size != source_size || header.source_timestamp != source_timestamp)
+            break;
+        if(header.key_count == 0 || header.pool_size == 0 || header.pool_size % 16 != 0) break;
+        if(storage_file_size(file) != sizeof(header) + 16 +
+                                          (uint64_t)header.key_count * 16 + header.pool_size +
+                                          16)
+            break;
+
+        uint8_t iv[16];
+        memcpy(iv, header.iv, sizeof(iv));
+        subghz_keystore_mess_with_iv(iv);
+        if(!furi_hal_crypto_enclave_load_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
+            FURI_LOG_E(TAG, "Unable to load decryption key");
+            break;
+        }
+        key_loaded = true;
+
+        // Cache from another device does not decrypt to the check block
+        uint8_t check[16];
+        uint32_t crc = 0;
+        if(!subghz_keystore_cache_read_block(file, check, sizeof(check), &crc) ||
+           memcmp(check, SUBGHZ_KEYSTORE_CACHE_CHECK, sizeof(check)) != 0)
+            break;
+
+        SubGhzKeyArray_reserve(instance->data, first_key + header.key_count);
+        size_t records_left = header.key_count;
+        bool records_ok = true;
+        while(records_ok && records_left > 0) {
+            size_t count = MIN(
+                records_left, SUBGHZ_KEYSTORE_CACHE_BLOCK_SIZE / sizeof(SubGhzKeystoreCacheKey));
+            records_ok = subghz_keystore_cache_read_block(
+                file, (uint8_t*)records, count * sizeof(SubGhzKeystoreCacheKey), &crc);
+            for(size_t i = 0; records_ok && i < count; i++) {
+                records_ok = records[i].name_offset < header.pool_size;
+                SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
+                manufacture_code->name = (const char*)(uintptr_t)records[i].name_offset;
+                manufacture_code->key = records[i].key;
+                manufacture_code->type = records[i].type;
+            }
+            records_left -= count;
+        }
+        if(!records_ok) break;
+
+        // Names are decrypted straight into the pool
+        pool.data = malloc(header.pool_size);
+        pool.size = header.pool_size;
+        pool.capacity = header.pool_size;
+        if(!subghz_keystore_cache_read_block(file, (uint8_t*)pool.data, pool.size, &crc)) break;
+        if(pool.data[pool.size - 1] != '\0') break;
+
+        // Damaged cache does not match the CRC32
+        uint32_t trailer[4];
+        uint32_t trailer_crc = 0;
+        if(!subghz_keystore_cache_read_block(
+               file, (uint8_t*)trailer, sizeof(trailer), &trailer_crc))
+            break;
+        if(trailer[0] != crc) break;
+
+        success = true;
+    } while(false);
+
+    if(key_loaded) furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+
+    if(!success) {
+        SubGhzKeyArray_resize(instance->data, first_key);
+    }
+    subghz_keystore_commit_pool(instance, &pool, first_key);
+
+    memset(records, 0, SUBGHZ_KEYSTORE_CACHE_BLOCK_SIZE);
+    free(records);
+    storage_file_close(file);
+    storage_file_free(file);
+
+    return success;
+}
+
+static bool
+    subghz_keystore_cache_write_block(File* file, uint8_t* data, size_t* size, uint32_t* crc) {
+    *crc = crc32_calc_buffer(*crc, data, *size);
+    bool success = furi_hal_crypto_encrypt(data, data, *size) &&
+                   storage_file_write(file, data, *size) == *size;
+    *size = 0;
+    return success;
+}
+
+static bool subghz_keystore_cache_save(
+    SubGhzKeystore* instance,
+    Storage* storage,
+    const char* cache_path,
+    size_t first_key,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* buffer = malloc(SUBGHZ_KEYSTORE_CACHE_BLOCK_SIZE);
+    size_t key_count = SubGhzKeyArray_size(instance->data) - first_key;
+    const char* pool = instance->pools[instance->pool_count - 1];
+    size_t pool_size = 0;
+    bool key_loaded = false;
+    bool success = false;
+
+    for(size_t i = first_key; i < first_key + key_count; i++) {
+        const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(instance->data, i);
+        size_t name_end = (manufacture_code->name - pool) + strlen(manufacture_code->name) + 1;
+        pool_size = MAX(pool_size, name_end);
+    }
+
+    do {
+        if(!storage_file_open(file, cache_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        // Placeholder header, an interrupted build leaves a cache that fails validation
+        SubGhzKeystoreCacheHeader header = {0};
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        furi_hal_random_fill_buf(header.iv, sizeof(header.iv));
+        uint8_t iv[16];
+        memcpy(iv, header.iv, sizeof(iv));
+        subghz_keystore_mess_with_iv(iv);
+        if(!furi_hal_crypto_enclave_load_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
+            FURI_LOG_E(TAG, "Unable to load encryption key");
+            break;
+        }
+        key_loaded = true;
+
+        size_t used = 16;
+        uint32_t crc = 0;
+        memcpy(buffer, SUBGHZ_KEYSTORE_CACHE_CHECK, used);
+        bool write_ok = true;
+        for(size_t i = first_key; write_ok && i < first_key + key_count; i++) {
+            const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(instance->data, i);
+            SubGhzKeystoreCacheKey record = {
+                .key = manufacture_code->key,
+                .name_offset = manufacture_code->name - pool,
+                .type = manufacture_code->type,
+            };
+            memcpy(&buffer[used], &record, sizeof(record));
+            used += sizeof(record);
+            if(used == SUBGHZ_KEYSTORE_CACHE_BLOCK_SIZE) {
+                write_ok = subghz_keystore_cache_write_block(file, buffer, &used, &crc);
+            }
+        }
+        if(write_ok && used) {
+            write_ok = subghz_keystore_cache_write_block(file, buffer, &used, &crc);
+        }
+
+        // Pool is padded with zeroes to whole AES blocks
+        size_t pool_size_aligned = (pool_size + 15) / 16 * 16;
+        for(size_t offset = 0; write_ok && offset < pool_size_aligned;
+            offset += SUBGHZ_KEYSTORE_CACHE_BLOCK_SIZE) {
+            used = MIN((size_t)SUBGHZ_KEYSTORE_CACHE_BLOCK_SIZE, pool_size_aligned - offset);
+            size_t copy = offset < pool_size ? MIN(used, pool_size - offset) : 0;
+            memcpy(buffer, &pool[offset], copy);
+            memset(&buffer[copy], 0, used - copy);
+            write_ok = subghz_keystore_cache_write_block(file, buffer, &used, &crc);
+        }
+        if(write_ok) {
+            uint32_t trailer_crc = 0;
+            used = 16;
+            memset(buffer, 0, used);
+            memcpy(buffer, &crc, sizeof(crc));
+            write_ok = subghz_keystore_cache_write_block(file, buffer, &used, &trailer_crc);
+        }
+        if(!write_ok) {
+            FURI_LOG_E(TAG, "Unable to write cache");
+            break;
+        }
+
+        header.magic = SUBGHZ_KEYSTORE_CACHE_MAGIC;
+        header.version = SUBGHZ_KEYSTORE_CACHE_VERSION;
+        header.source_size = source_size;
+        header.source_timestamp = source_timestamp;
+        header.key_count = key_count;
+        header.pool_size = pool_size_aligned;
+        if(!storage_file_seek(file, 0, true)) break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        success = true;
+    } while(false);
+
+    if(key_loaded) furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+
+    storage_file_close(file);
+    if(!success) {
+        storage_simply_remove(storage, cache_path);
+    }
+
+    memset(buffer, 0, SUBGHZ_KEYSTORE_CACHE_BLOCK_SIZE);
+    free(buffer);
+    storage_file_free(file);
+
+    return success;
+}
+
 bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
     furi_assert(instance);
     bool result = false;
     uint8_t iv[16];
     uint32_t version;
     uint32_t encryption;
+    uint32_t source_size = 0;
+    uint32_t source_timestamp = 0;
+    SubGhzKeystorePool pool = {0};
+    size_t first_key = SubGhzKeyArray_size(instance->data);
+    // Keys may change from here on, results derived from them are stale
+    instance->generation++;
 
     FuriString* filetype;
     filetype = furi_string_alloc();
+    FuriString* cache_path;
+    cache_path = furi_string_alloc();
 
     FURI_LOG_I(TAG, "Loading keystore %s", file_name);
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
 
-    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
-    do {
-        if(!flipper_format_file_open_existing(flipper_format, file_name)) {
-            FURI_LOG_E(TAG, "Unable to open file for read: %s", file_name);
-            break;
-        }
-        if(!flipper_format_read_header(flipper_format, filetype, &version)) {
-            FURI_LOG_E(TAG, "Missing or incorrect header");
-            break;
-        }
-        if(!flipper_format_read_uint32(flipper_format, "Encryption", (uint32_t*)&encryption, 1)) {
-            FURI_LOG_E(TAG, "Missing encryption type");
-            break;
-        }
+    subghz_keystore_cache_get_path(file_name, cache_path);
+    bool source_info = subghz_keystore_cache_get_source_info(
+        storage, file_name, &source_size, &source_timestamp);
 
-        if(strcmp(furi_string_get_cstr(filetype), SUBGHZ_KEYSTORE_FILE_TYPE) != 0 ||
-           version != SUBGHZ_KEYSTORE_FILE_VERSION) {
-            FURI_LOG_E(TAG, "Type or version mismatch");
-            break;
-        }
+    if(source_info &&
+       subghz_keystore_cache_load(
+           instance, storage, furi_string_get_cstr(cache_path), source_size, source_timestamp)) {
+        FURI_LOG_I(TAG, "Loaded from cache");
+        result = true;
+    } else {
+        FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+        do {
+            if(!flipper_format_file_open_existing(flipper_format, file_name)) {
+                FURI_LOG_E(TAG, "Unable to open file for read: %s", file_name);
+                break;
+            }
+            if(!flipper_format_read_header(flipper_format, filetype, &version)) {
+                FURI_LOG_E(TAG, "Missing or incorrect header");
+                break;
+            }
+            if(!flipper_format_read_uint32(
+                   flipper_format, "Encryption", (uint32_t*)&encryption, 1)) {
+                FURI_LOG_E(TAG, "Missing encryption type");
+                break;
+            }
 
-        Stream* stream = flipper_format_get_raw_stream(flipper_format);
-        if(encryption == SubGhzKeystoreEncryptionNone) {
-            result = subghz_keystore_read_file(instance, stream, NULL);
-        } else if(encryption == SubGhzKeystoreEncryptionAES256) {
-            if(!flipper_format_read_hex(flipper_format, "IV", iv, 16)) {
-                FURI_LOG_E(TAG, "Missing IV");
+            if(strcmp(furi_string_get_cstr(filetype), SUBGHZ_KEYSTORE_FILE_TYPE) != 0 ||
+               version != SUBGHZ_KEYSTORE_FILE_VERSION) {
+                FURI_LOG_E(TAG, "Type or version mismatch");
                 break;
             }
-            subghz_keystore_mess_with_iv(iv);
-            result = subghz_keystore_read_file(instance, stream, iv);
-        } else {
-            FURI_LOG_E(TAG, "Unknown encryption");
-            break;
+
+            Stream* stream = flipper_format_get_raw_stream(flipper_format);
+            if(encryption == SubGhzKeystoreEncryptionNone) {
+                result = subghz_keystore_read_file(instance, &pool, stream, NULL);
+            } else if(encryption == SubGhzKeystoreEncryptionAES256) {
+                if(!flipper_format_read_hex(flipper_format, "IV", iv, 16)) {
+                    FURI_LOG_E(TAG, "Missing IV");
+                    break;
+                }
+                subghz_keystore_mess_with_iv(iv);
+                result = subghz_keystore_read_file(instance, &pool, stream, iv);
+            } else {
+                FURI_LOG_E(TAG, "Unknown encryption");
+                break;
+            }
+        } while(0);
+        flipper_format_free(flipper_format);
+
+        subghz_keystore_commit_pool(instance, &pool, first_key);
+
+        if(result && source_info && SubGhzKeyArray_size(instance->data) > first_key) {
+            subghz_keystore_cache_save(
+                instance,
+                storage,
+                furi_string_get_cstr(cache_path),
+                first_key,
+                source_size,
+                source_timestamp);
         }
-    } while(0);
-    flipper_format_free(flipper_format);
+    }
 
     furi_record_close(RECORD_STORAGE);
 
+    furi_string_free(cache_path);
     furi_string_free(filetype);
 
     return result;
@@ -294,7 +705,7 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
                     (uint32_t)(key->key >> 32),
                     (uint32_t)key->key,
                     key->type,
-                    furi_string_get_cstr(key->name));
+                    key->name);
                 // Verify length and align
                 furi_assert(len > 0);
                 if(len % 16 != 0) {
@@ -343,6 +754,33 @@ SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
     return &instance->data;
 }
 
+uint32_t subghz_keystore_get_generation(SubGhzKeystore* instance) {
+    furi_assert(instance);
+    return instance->generation;
+}
+
+const SubGhzKey* subghz_keystore_get_key_by_name(SubGhzKeystore* instance, const char* name) {
+    furi_assert(instance);
+    furi_assert(name);
+
+    size_t count = SubGhzKeyArray_size(instance->data);
+    size_t low = 0;
+    size_t high = count;
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        if(strcmp(instance->name_index[mid]->name, name) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if(low < count && strcmp(instance->name_index[low]->name, name) == 0) {
+        return instance->name_index[low];
+    }
+    return NULL;
+}
+
 bool subghz_keystore_raw_encrypted_save(
     const char* input_file_name,
     const char* output_file_name,
@@ -484,29 +922,77 @@ bool subghz_keystore_raw_encrypted_save(
     return encrypted;
 }
 
-bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t* data, size_t len) {
+static void subghz_keystore_hex_decode(const uint8_t* hex, uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        uint8_t hi_nibble = 0;
+        uint8_t lo_nibble = 0;
+        hex_char_to_hex_nibble(hex[i * 2], &hi_nibble);
+        hex_char_to_hex_nibble(hex[i * 2 + 1], &lo_nibble);
+        data[i] = (hi_nibble << 4) | lo_nibble;
+    }
+}
+
+SubGhzKeystoreRaw* subghz_keystore_raw_alloc(const char* file_name) {
+    furi_check(file_name);
+    SubGhzKeystoreRaw* instance = malloc(sizeof(SubGhzKeystoreRaw));
+
+    instance->file_name = furi_string_alloc_set(file_name);
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->flipper_format = NULL;
+    instance->use_counter = 0;
+    for(size_t i = 0; i < SUBGHZ_KEYSTORE_RAW_BLOCK_COUNT; i++) {
+        instance->blocks[i].index = SUBGHZ_KEYSTORE_RAW_BLOCK_EMPTY;
+    }
+
+    return instance;
+}
+
+static void subghz_keystore_raw_close(SubGhzKeystoreRaw* instance) {
+    if(instance->flipper_format) {
+        flipper_format_free(instance->flipper_format);
+        instance->flipper_format = NULL;
+    }
+    // Do not keep decrypted data of a file that is not open anymore
+    for(size_t i = 0; i < SUBGHZ_KEYSTORE_RAW_BLOCK_COUNT; i++) {
+        memset(instance->blocks[i].data, 0, SUBGHZ_KEYSTORE_RAW_BLOCK_SIZE);
+        instance->blocks[i].index = SUBGHZ_KEYSTORE_RAW_BLOCK_EMPTY;
+    }
+}
+
+void subghz_keystore_raw_free(SubGhzKeystoreRaw* instance) {
+    furi_check(instance);
+
+    subghz_keystore_raw_close(instance);
+    memset(instance->iv, 0, sizeof(instance->iv));
+    furi_record_close(RECORD_STORAGE);
+    furi_mutex_free(instance->mutex);
+    furi_string_free(instance->file_name);
+
+    free(instance);
+}
+
+static bool subghz_keystore_raw_open(SubGhzKeystoreRaw* instance) {
     bool result = false;
-    uint8_t iv[16];
     uint32_t version;
     uint32_t encryption;
+    const char* file_name = furi_string_get_cstr(instance->file_name);
 
     FuriString* str_temp;
     str_temp = furi_string_alloc();
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    char* decrypted_line = malloc(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
-
-    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    instance->flipper_format = flipper_format_file_alloc(instance->storage);
     do {
-        if(!flipper_format_file_open_existing(flipper_format, file_name)) {
+        if(!flipper_format_file_open_existing(instance->flipper_format, file_name)) {
             FURI_LOG_E(TAG, "Unable to open file for read: %s", file_name);
             break;
         }
-        if(!flipper_format_read_header(flipper_format, str_temp, &version)) {
+        if(!flipper_format_read_header(instance->flipper_format, str_temp, &version)) {
             FURI_LOG_E(TAG, "Missing or incorrect header");
             break;
         }
-        if(!flipper_format_read_uint32(flipper_format, "Encryption", (uint32_t*)&encryption, 1)) {
+        if(!flipper_format_read_uint32(
+               instance->flipper_format, "Encryption", (uint32_t*)&encryption, 1)) {
             FURI_LOG_E(TAG, "Missing encryption type");
             break;
         }
@@ -517,97 +1003,177 @@ bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t*
             break;
         }
 
-        Stream* stream = flipper_format_get_raw_stream(flipper_format);
         if(encryption != SubGhzKeystoreEncryptionAES256) {
             FURI_LOG_E(TAG, "Unknown encryption");
             break;
         }
 
-        if(offset < 16) {
-            if(!flipper_format_read_hex(flipper_format, "IV", iv, 16)) {
-                FURI_LOG_E(TAG, "Missing IV");
-                break;
-            }
-            subghz_keystore_mess_with_iv(iv);
+        if(!flipper_format_read_hex(instance->flipper_format, "IV", instance->iv, 16)) {
+            FURI_LOG_E(TAG, "Missing IV");
+            break;
         }
+        subghz_keystore_mess_with_iv(instance->iv);
 
-        if(!flipper_format_read_string(flipper_format, "Encrypt_data", str_temp)) {
+        if(!flipper_format_read_string(instance->flipper_format, "Encrypt_data", str_temp)) {
             FURI_LOG_E(TAG, "Missing Encrypt_data");
             break;
         }
 
-        size_t bufer_size;
-        if(len <= (16 - offset % 16)) {
-            bufer_size = 32;
-        } else {
-            bufer_size = (((len) / 16) + 2) * 32;
-        }
-        furi_assert(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE >= bufer_size / 2);
-
-        uint8_t buffer[bufer_size];
-        size_t ret = 0;
-        bool decrypted = true;
+        Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
         //skip the end of the previous line "\n"
+        uint8_t buffer[1];
         stream_read(stream, buffer, 1);
 
-        size_t size = stream_size(stream);
-        size -= stream_tell(stream);
-        if(size < (offset * 2 + len * 2)) {
-            FURI_LOG_E(TAG, "Seek position exceeds file size");
-            break;
-        }
+        // Only whole AES blocks can be decrypted
+        instance->data_start = stream_tell(stream);
+        instance->data_size = (stream_size(stream) - instance->data_start) / 32 * 16;
 
-        if(offset >= 16) {
-            stream_seek(stream, ((offset / 16) - 1) * 32, StreamOffsetFromCurrent);
-            ret = stream_read(stream, buffer, 32);
-            furi_assert(ret == 32);
-            for(uint16_t i = 0; i < ret - 1; i += 2) {
-                uint8_t hi_nibble = 0;
-                uint8_t lo_nibble = 0;
-                hex_char_to_hex_nibble(buffer[i], &hi_nibble);
-                hex_char_to_hex_nibble(buffer[i + 1], &lo_nibble);
-                iv[i / 2] = (hi_nibble << 4) | lo_nibble;
-            }
-        }
+        result = true;
+    } while(0);
 
-        if(!furi_hal_crypto_enclave_load_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
-            FURI_LOG_E(TAG, "Unable to load encryption key");
-            break;
+    furi_string_free(str_temp);
+
+    if(!result) subghz_keystore_raw_close(instance);
+
+    return result;
+}
+
+static SubGhzKeystoreRawBlock*
+    subghz_keystore_raw_find_block(SubGhzKeystoreRaw* instance, uint32_t index) {
+    for(size_t i = 0; i < SUBGHZ_KEYSTORE_RAW_BLOCK_COUNT; i++) {
+        if(instance->blocks[i].index == index) return &instance->blocks[i];
+    }
+    return NULL;
+}
+
+static SubGhzKeystoreRawBlock* subghz_keystore_raw_evict_block(SubGhzKeystoreRaw* instance) {
+    SubGhzKeystoreRawBlock* block = subghz_keystore_raw_find_block(
+        instance, SUBGHZ_KEYSTORE_RAW_BLOCK_EMPTY);
+    if(!block) {
+        block = &instance->blocks[0];
+        for(size_t i = 1; i < SUBGHZ_KEYSTORE_RAW_BLOCK_COUNT; i++) {
+            if(instance->blocks[i].last_used < block->last_used) block = &instance->blocks[i];
         }
+        block->index = SUBGHZ_KEYSTORE_RAW_BLOCK_EMPTY;
+    }
+    return block;
+}
 
-        do {
-            memset(buffer, 0, bufer_size);
-            ret = stream_read(stream, buffer, bufer_size);
-            furi_assert(ret == bufer_size);
-            for(uint16_t i = 0; i < ret - 1; i += 2) {
-                uint8_t hi_nibble = 0;
-                uint8_t lo_nibble = 0;
-                hex_char_to_hex_nibble(buffer[i], &hi_nibble);
-                hex_char_to_hex_nibble(buffer[i + 1], &lo_nibble);
-                buffer[i / 2] = (hi_nibble << 4) | lo_nibble;
+static bool subghz_keystore_raw_read_blocks(
+    SubGhzKeystoreRaw* instance,
+    size_t offset,
+    uint8_t* data,
+    size_t len) {
+    Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
+    uint8_t buffer[SUBGHZ_KEYSTORE_RAW_BLOCK_SIZE * 2];
+    uint8_t iv[16];
+    bool key_loaded = false;
+    uint32_t chained_index = SUBGHZ_KEYSTORE_RAW_BLOCK_EMPTY;
+    bool result = true;
+
+    const uint32_t first_index = offset / SUBGHZ_KEYSTORE_RAW_BLOCK_SIZE;
+    const uint32_t last_index = (offset + len - 1) / SUBGHZ_KEYSTORE_RAW_BLOCK_SIZE;
+    for(uint32_t index = first_index; index <= last_index; index++) {
+        const size_t block_start = index * SUBGHZ_KEYSTORE_RAW_BLOCK_SIZE;
+        SubGhzKeystoreRawBlock* block = subghz_keystore_raw_find_block(instance, index);
+
+        if(!block) {
+            // Consecutive missing blocks continue the CBC chain with the key already loaded
+            if(index != chained_index) {
+                if(key_loaded) {
+                    furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+                    key_loaded = false;
+                }
+                if(index == 0) {
+                    memcpy(iv, instance->iv, sizeof(iv));
+                    result = stream_seek(stream, instance->data_start, StreamOffsetFromStart);
+                } else {
+                    // IV is the previous ciphertext block
+                    result = stream_seek(
+                                 stream,
+                                 instance->data_start + (block_start - 16) * 2,
+                                 StreamOffsetFromStart) &&
+                             stream_read(stream, buffer, 32) == 32;
+                    subghz_keystore_hex_decode(buffer, iv, sizeof(iv));
+                }
+                if(!result) {
+                    FURI_LOG_E(TAG, "Unable to read IV");
+                    break;
+                }
+                if(!furi_hal_crypto_enclave_load_key(
+                       SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
+                    FURI_LOG_E(TAG, "Unable to load encryption key");
+                    result = false;
+                    break;
+                }
+                key_loaded = true;
             }
 
-            memset(decrypted_line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
+            const size_t block_size =
+                MIN((size_t)SUBGHZ_KEYSTORE_RAW_BLOCK_SIZE, instance->data_size - block_start);
+            if(stream_read(stream, buffer, block_size * 2) != block_size * 2) {
+                FURI_LOG_E(TAG, "Unable to read data");
+                result = false;
+                break;
+            }
+            subghz_keystore_hex_decode(buffer, buffer, block_size);
 
-            if(!furi_hal_crypto_decrypt(
-                   (uint8_t*)buffer, (uint8_t*)decrypted_line, bufer_size / 2)) {
-                decrypted = false;
+            block = subghz_keystore_raw_evict_block(instance);
+            if(!furi_hal_crypto_decrypt(buffer, block->data, block_size)) {
                 FURI_LOG_E(TAG, "Decryption failed");
+                result = false;
                 break;
             }
-            memcpy(data, (uint8_t*)decrypted_line + (offset - (offset / 16) * 16), len);
+            block->index = index;
+            chained_index = index + 1;
+        }
 
-        } while(0);
-        furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
-        if(decrypted) result = true;
-    } while(0);
-    flipper_format_free(flipper_format);
+        block->last_used = ++instance->use_counter;
 
-    furi_record_close(RECORD_STORAGE);
+        const size_t start = MAX(offset, block_start);
+        const size_t end = MIN(offset + len, block_start + SUBGHZ_KEYSTORE_RAW_BLOCK_SIZE);
+        memcpy(data + (start - offset), block->data + (start - block_start), end - start);
+    }
 
-    free(decrypted_line);
+    if(key_loaded) furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+    memset(iv, 0, sizeof(iv));
 
-    furi_string_free(str_temp);
+    return result;
+}
+
+bool subghz_keystore_raw_read(
+    SubGhzKeystoreRaw* instance,
+    size_t offset,
+    uint8_t* data,
+    size_t len) {
+    furi_check(instance);
+    furi_check(data);
+    bool result = false;
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Handle may go stale, e.g. after SD card remount, reopen it once
+    for(size_t attempt = 0; attempt < 2 && !result; attempt++) {
+        if(!instance->flipper_format && !subghz_keystore_raw_open(instance)) break;
+
+        if(offset + len > instance->data_size) {
+            FURI_LOG_E(TAG, "Seek position exceeds file size");
+            break;
+        }
+
+        result = (len == 0) || subghz_keystore_raw_read_blocks(instance, offset, data, len);
+        if(!result) subghz_keystore_raw_close(instance);
+    }
+
+    furi_mutex_release(instance->mutex);
+
+    return result;
+}
+
+bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t* data, size_t len) {
+    SubGhzKeystoreRaw* instance = subghz_keystore_raw_alloc(file_name);
+    bool result = subghz_keystore_raw_read(instance, offset, data, len);
+    subghz_keystore_raw_free(instance);
 
     return result;
 }
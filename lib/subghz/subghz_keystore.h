@@ -8,8 +8,10 @@
 extern "C" {
 #endif
 
+#define SUBGHZ_KEYSTORE_CACHE_EXTENSION ".kbin"
+
 typedef struct {
-    FuriString* name;
+    const char* name; /**< Manufacture name, owned by the keystore */
     uint64_t key;
     uint16_t type;
 } SubGhzKey;
@@ -20,6 +22,8 @@ ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST)
 
 typedef struct SubGhzKeystore SubGhzKeystore;
 
+typedef struct SubGhzKeystoreRaw SubGhzKeystoreRaw;
+
 /**
  * Allocate SubGhzKeystore.
  * @return SubGhzKeystore* pointer to a SubGhzKeystore instance
@@ -34,6 +38,8 @@ void subghz_keystore_free(SubGhzKeystore* instance);
 
 /** 
  * Loading manufacture key from file
+ * Keys are appended in file order. The file is compiled into an encrypted cache
+ * "<filename>.kbin" that is used instead of parsing while the file size and timestamp match.
  * @param instance Pointer to a SubGhzKeystore instance
  * @param filename Full path to the file
  */
@@ -54,6 +60,21 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_
  */
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance);
 
+/** 
+ * Get load generation, changes every time subghz_keystore_load is called
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @return Generation counter
+ */
+uint32_t subghz_keystore_get_generation(SubGhzKeystore* instance);
+
+/** 
+ * Find manufacture key by name
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param name Manufacture name
+ * @return First loaded key with this name, NULL if there is none
+ */
+const SubGhzKey* subghz_keystore_get_key_by_name(SubGhzKeystore* instance, const char* name);
+
 /** 
  * Save RAW encrypted to file
  * @param input_file_name Full path to the input file
@@ -75,6 +96,35 @@ bool subghz_keystore_raw_encrypted_save(
  */
 bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t* data, size_t len);
 
+/**
+ * Allocate SubGhzKeystoreRaw, a reader of an encrypted RAW file.
+ * The file is opened on the first read and stays open until the reader is freed,
+ * recently decrypted data is kept in a small block cache.
+ * @param file_name Full path to the input file
+ * @return SubGhzKeystoreRaw* pointer to a SubGhzKeystoreRaw instance
+ */
+SubGhzKeystoreRaw* subghz_keystore_raw_alloc(const char* file_name);
+
+/**
+ * Free SubGhzKeystoreRaw.
+ * @param instance Pointer to a SubGhzKeystoreRaw instance
+ */
+void subghz_keystore_raw_free(SubGhzKeystoreRaw* instance);
+
+/** 
+ * Get decrypted RAW data, same as subghz_keystore_raw_get_data without reopening the file
+ * @param instance Pointer to a SubGhzKeystoreRaw instance
+ * @param offset Offset from the start of the RAW data
+ * @param data Returned array
+ * @param len Required data length
+ * @return true On success
+ */
+bool subghz_keystore_raw_read(
+    SubGhzKeystoreRaw* instance,
+    size_t offset,
+    uint8_t* data,
+    size_t len);
+
 #ifdef __cplusplus
 }
 #endif
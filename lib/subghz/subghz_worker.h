@@ -1,6 +1,7 @@
 #pragma once
 
 #include <furi_hal.h>
+#include <toolbox/level_duration.h>
 
 #ifdef __cplusplus
 extern "C" {
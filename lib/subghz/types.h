@@ -87,6 +87,10 @@ typedef struct {
 
     SubGhzDecoderFeed feed;
     SubGhzDecoderReset reset;
+    /** Pulses this long or shorter are ignored by the decoder while its
+     * SubGhzBlockDecoder sits in the reset step (parser_step 0), so the
+     * receiver may skip feeding them. 0 - feed every pulse. */
+    uint32_t idle_ignore_duration;
 
     SubGhzGetHashData get_hash_data;
     SubGhzGetString get_string;
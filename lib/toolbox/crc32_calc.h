@@ -7,12 +7,63 @@
 extern "C" {
 #endif
 
+/** CRC32 calculation engines, all give the same result */
+typedef enum {
+    Crc32CalcEngineNibble, /**< 16 entry table, two lookups per byte */
+    Crc32CalcEngineByte, /**< 256 entry table, one lookup per byte */
+    Crc32CalcEngineSlice8, /**< 8x256 entry table, eight bytes per step */
+    Crc32CalcEngineHardware, /**< CRC calculation unit, see furi_hal_crc.h */
+} Crc32CalcEngine;
+
+#define CRC32_CALC_ENGINE_DEFAULT          Crc32CalcEngineSlice8
+#define CRC32_CALC_FILE_CHUNK_SIZE_DEFAULT (4096U)
+
+/** Calculate CRC32 with the default engine
+ *
+ * @param      crc     previous CRC32 value, 0 to start
+ * @param      buffer  data
+ * @param      size    data size
+ *
+ * @return     updated CRC32 value
+ */
 uint32_t crc32_calc_buffer(uint32_t crc, const void* buffer, size_t size);
 
+/** Calculate CRC32 with the given engine
+ *
+ * @param      engine  Crc32CalcEngine to use
+ * @param      crc     previous CRC32 value, 0 to start
+ * @param      buffer  data
+ * @param      size    data size
+ *
+ * @return     updated CRC32 value
+ */
+uint32_t crc32_calc_buffer_ex(
+    Crc32CalcEngine engine,
+    uint32_t crc,
+    const void* buffer,
+    size_t size);
+
 typedef void (*FileCrcProgressCb)(const uint8_t progress, void* context);
 
 uint32_t crc32_calc_file(File* file, const FileCrcProgressCb progress_cb, void* context);
 
+/** Calculate file CRC32 from the start of the file
+ *
+ * @param      file         opened File
+ * @param      engine       Crc32CalcEngine to use
+ * @param      chunk_size   read chunk size, larger chunks mean less storage calls
+ * @param      progress_cb  progress callback, reported on every full chunk, may be NULL
+ * @param      context      callback context
+ *
+ * @return     file CRC32 value
+ */
+uint32_t crc32_calc_file_ex(
+    File* file,
+    Crc32CalcEngine engine,
+    size_t chunk_size,
+    const FileCrcProgressCb progress_cb,
+    void* context);
+
 #ifdef __cplusplus
 }
 #endif
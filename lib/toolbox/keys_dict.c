@@ -8,11 +8,50 @@
 
 #define TAG "KeysDict"
 
+#define KEYS_DICT_INDEX_EXTENSION ".idx"
+#define KEYS_DICT_INDEX_MAGIC     (0x5844494BUL) // "KIDX"
+#define KEYS_DICT_INDEX_VERSION   (1U)
+#define KEYS_DICT_INDEX_MAX_KEYS  (8192U)
+
+// Index keys are sorted in runs that fit a small buffer, runs go to a temp file
+// and are merged from there, so building never needs a whole-dictionary array.
+#define KEYS_DICT_INDEX_RUNS_EXTENSION ".tmp"
+#define KEYS_DICT_INDEX_RUN_KEYS       (256U)
+#define KEYS_DICT_INDEX_MERGE_KEYS     (8U)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t key_size;
+    uint16_t reserved;
+    uint32_t total_keys;
+    uint32_t source_size;
+    uint32_t source_timestamp;
+} FURI_PACKED KeysDictIndexHeader;
+
+typedef struct {
+    size_t offset;
+    size_t end;
+    size_t position;
+    size_t count;
+    uint64_t keys[KEYS_DICT_INDEX_MERGE_KEYS];
+} KeysDictIndexRun;
+
 struct KeysDict {
+    Storage* storage;
     Stream* stream;
     size_t key_size;
     size_t key_size_symbols;
     size_t total_keys;
+
+    // Indexed mode
+    FuriString* path;
+    FuriString* index_path;
+    Stream* index_stream;
+    size_t index_keys;
+    size_t index_position;
+    uint8_t* pending_keys;
+    size_t pending_count;
 };
 
 static inline void keys_dict_add_ending_new_line(KeysDict* instance) {
@@ -64,17 +103,329 @@ bool keys_dict_check_presence(const char* path) {
     return dict_present;
 }
 
+static void keys_dict_int_to_str(KeysDict* instance, const uint8_t* key_int, FuriString* key_str) {
+    furi_assert(instance);
+    furi_assert(key_str);
+    furi_assert(key_int);
+
+    furi_string_reset(key_str);
+
+    for(size_t i = 0; i < instance->key_size; i++)
+        furi_string_cat_printf(key_str, "%02X", key_int[i]);
+}
+
+static void keys_dict_str_to_int(KeysDict* instance, FuriString* key_str, uint64_t* key_int) {
+    furi_assert(instance);
+    furi_assert(key_str);
+    furi_assert(key_int);
+
+    uint8_t key_byte_tmp;
+    char h, l;
+
+    *key_int = 0ULL;
+
+    for(size_t i = 0; i < instance->key_size_symbols - 1; i += 2) {
+        h = furi_string_get_char(key_str, i);
+        l = furi_string_get_char(key_str, i + 1);
+
+        args_char_to_hex(h, l, &key_byte_tmp);
+        *key_int |= (uint64_t)key_byte_tmp << (8 * (instance->key_size - 1 - i / 2));
+    }
+}
+
+static size_t keys_dict_count_keys(KeysDict* instance) {
+    FuriString* line = furi_string_alloc();
+
+    size_t total_keys = 0;
+    bool is_endfile = false;
+
+    // In this loop we only count the entries in the file
+    // We prefer not to load the whole file in memory for space reasons
+    stream_rewind(instance->stream);
+    while(!is_endfile) {
+        bool read_key = keys_dict_read_key_line(instance, line, &is_endfile);
+        if(read_key) {
+            total_keys++;
+        }
+    }
+    stream_rewind(instance->stream);
+
+    furi_string_free(line);
+
+    return total_keys;
+}
+
+static bool keys_dict_index_get_source_info(
+    KeysDict* instance,
+    uint32_t* source_size,
+    uint32_t* source_timestamp) {
+    const char* path = furi_string_get_cstr(instance->path);
+    FileInfo file_info = {0};
+
+    // Flush pending writes, otherwise size and timestamp are not final
+    buffered_file_stream_sync(instance->stream);
+
+    bool success = (storage_common_stat(instance->storage, path, &file_info) == FSE_OK) &&
+                   (storage_common_timestamp(instance->storage, path, source_timestamp) ==
+                    FSE_OK);
+    *source_size = (uint32_t)file_info.size;
+
+    return success;
+}
+
+static bool keys_dict_index_open(KeysDict* instance) {
+    KeysDictIndexHeader header;
+    uint32_t source_size = 0;
+    uint32_t source_timestamp = 0;
+    bool index_valid = false;
+
+    do {
+        if(!keys_dict_index_get_source_info(instance, &source_size, &source_timestamp))
+            break;
+        if(!buffered_file_stream_open(
+               instance->index_stream,
+               furi_string_get_cstr(instance->index_path),
+               FSAM_READ,
+               FSOM_OPEN_EXISTING))
+            break;
+        if(stream_read(instance->index_stream, (uint8_t*)&header, sizeof(header)) !=
+           sizeof(header))
+            break;
+        if(header.magic != KEYS_DICT_INDEX_MAGIC || header.version != KEYS_DICT_INDEX_VERSION)
+            break;
+        if(header.key_size != instance->key_size) break;
+        if(header.source_size != source_size || header.source_timestamp != source_timestamp)
+            break;
+        if(stream_size(instance->index_stream) !=
+           sizeof(header) + 2 * header.total_keys * instance->key_size)
+            break;
+
+        instance->index_keys = header.total_keys;
+        index_valid = true;
+    } while(false);
+
+    if(!index_valid) {
+        buffered_file_stream_close(instance->index_stream);
+    }
+
+    return index_valid;
+}
+
+static int keys_dict_index_compare(const void* a, const void* b) {
+    const uint64_t key_a = *(const uint64_t*)a;
+    const uint64_t key_b = *(const uint64_t*)b;
+
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+static void keys_dict_index_write_key(KeysDict* instance, uint64_t key_int) {
+    uint8_t key[sizeof(uint64_t)];
+
+    for(size_t i = instance->key_size; i > 0; i--) {
+        key[i - 1] = (uint8_t)key_int;
+        key_int >>= 8;
+    }
+
+    stream_write(instance->index_stream, key, instance->key_size);
+}
+
+static bool keys_dict_index_write_run(Stream* runs_stream, uint64_t* keys, size_t count) {
+    qsort(keys, count, sizeof(uint64_t), keys_dict_index_compare);
+
+    const size_t size = count * sizeof(uint64_t);
+    return stream_write(runs_stream, (const uint8_t*)keys, size) == size;
+}
+
+static bool keys_dict_index_fill_run(KeysDictIndexRun* run, Stream* runs_stream) {
+    run->count = MIN(run->end - run->offset, KEYS_DICT_INDEX_MERGE_KEYS);
+    run->position = 0;
+
+    const size_t size = run->count * sizeof(uint64_t);
+    bool success =
+        stream_seek(runs_stream, run->offset * sizeof(uint64_t), StreamOffsetFromStart) &&
+        stream_read(runs_stream, (uint8_t*)run->keys, size) == size;
+    run->offset += run->count;
+
+    return success;
+}
+
+static bool
+    keys_dict_index_merge_runs(KeysDict* instance, Stream* runs_stream, size_t key_count) {
+    const size_t run_count = (key_count + KEYS_DICT_INDEX_RUN_KEYS - 1) / KEYS_DICT_INDEX_RUN_KEYS;
+    KeysDictIndexRun* runs = malloc(sizeof(KeysDictIndexRun) * run_count);
+    bool success = true;
+
+    for(size_t i = 0; i < run_count; i++) {
+        runs[i].offset = i * KEYS_DICT_INDEX_RUN_KEYS;
+        runs[i].end = MIN(runs[i].offset + KEYS_DICT_INDEX_RUN_KEYS, key_count);
+    }
+
+    for(size_t written = 0; success && written < key_count; written++) {
+        KeysDictIndexRun* min_run = NULL;
+
+        for(size_t i = 0; success && i < run_count; i++) {
+            KeysDictIndexRun* run = &runs[i];
+            if(run->position == run->count && run->offset < run->end) {
+                success = keys_dict_index_fill_run(run, runs_stream);
+            }
+            if(run->position < run->count &&
+               (!min_run || run->keys[run->position] < min_run->keys[min_run->position])) {
+                min_run = run;
+            }
+        }
+
+        if(!min_run) success = false;
+        if(success) keys_dict_index_write_key(instance, min_run->keys[min_run->position++]);
+    }
+
+    free(runs);
+
+    return success;
+}
+
+static bool keys_dict_index_build(KeysDict* instance) {
+    KeysDictIndexHeader header = {
+        .magic = KEYS_DICT_INDEX_MAGIC,
+        .version = KEYS_DICT_INDEX_VERSION,
+        .key_size = instance->key_size,
+        .total_keys = instance->total_keys,
+    };
+    uint32_t source_size = 0;
+    uint32_t source_timestamp = 0;
+    // One run is sorted in place, more go through the runs file
+    const bool single_run = instance->total_keys <= KEYS_DICT_INDEX_RUN_KEYS;
+    uint64_t* keys = malloc(sizeof(uint64_t) * KEYS_DICT_INDEX_RUN_KEYS);
+    FuriString* line = furi_string_alloc();
+    FuriString* runs_path = furi_string_alloc_printf(
+        "%s%s", furi_string_get_cstr(instance->index_path), KEYS_DICT_INDEX_RUNS_EXTENSION);
+    Stream* runs_stream = buffered_file_stream_alloc(instance->storage);
+    bool index_built = false;
+
+    do {
+        if(instance->total_keys > KEYS_DICT_INDEX_MAX_KEYS) {
+            FURI_LOG_W(TAG, "Too many keys to build index: %zu", instance->total_keys);
+            break;
+        }
+        if(!keys_dict_index_get_source_info(instance, &source_size, &source_timestamp)) break;
+        header.source_size = source_size;
+        header.source_timestamp = source_timestamp;
+        if(!buffered_file_stream_open(
+               instance->index_stream,
+               furi_string_get_cstr(instance->index_path),
+               FSAM_WRITE,
+               FSOM_CREATE_ALWAYS))
+            break;
+        if(!single_run) {
+            const char* runs_file = furi_string_get_cstr(runs_path);
+            if(!buffered_file_stream_open(
+                   runs_stream, runs_file, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS))
+                break;
+        }
+
+        // Header, then keys in file order, then the same keys sorted
+        stream_write(instance->index_stream, (const uint8_t*)&header, sizeof(header));
+
+        size_t key_count = 0;
+        size_t run_fill = 0;
+        bool is_endfile = false;
+        bool runs_written = true;
+
+        stream_rewind(instance->stream);
+        while(runs_written && !is_endfile && key_count < instance->total_keys) {
+            if(keys_dict_read_key_line(instance, line, &is_endfile)) {
+                keys_dict_str_to_int(instance, line, &keys[run_fill]);
+                keys_dict_index_write_key(instance, keys[run_fill]);
+                key_count++;
+
+                if(++run_fill == KEYS_DICT_INDEX_RUN_KEYS && !single_run) {
+                    runs_written = keys_dict_index_write_run(runs_stream, keys, run_fill);
+                    run_fill = 0;
+                }
+            }
+        }
+        stream_rewind(instance->stream);
+
+        if(!runs_written || key_count != instance->total_keys) break;
+
+        if(single_run) {
+            qsort(keys, key_count, sizeof(uint64_t), keys_dict_index_compare);
+            for(size_t i = 0; i < key_count; i++) {
+                keys_dict_index_write_key(instance, keys[i]);
+            }
+        } else {
+            if(run_fill && !keys_dict_index_write_run(runs_stream, keys, run_fill)) break;
+            // Merge buffers replace the run buffer
+            free(keys);
+            keys = NULL;
+            if(!keys_dict_index_merge_runs(instance, runs_stream, key_count)) break;
+        }
+
+        if(!buffered_file_stream_close(instance->index_stream)) break;
+        if(!buffered_file_stream_open(
+               instance->index_stream,
+               furi_string_get_cstr(instance->index_path),
+               FSAM_READ,
+               FSOM_OPEN_EXISTING) ||
+           !stream_seek(instance->index_stream, sizeof(header), StreamOffsetFromStart))
+            break;
+
+        instance->index_keys = key_count;
+        index_built = true;
+    } while(false);
+
+    if(!index_built) {
+        buffered_file_stream_close(instance->index_stream);
+        storage_simply_remove(instance->storage, furi_string_get_cstr(instance->index_path));
+    }
+
+    if(!single_run) {
+        buffered_file_stream_close(runs_stream);
+        storage_simply_remove(instance->storage, furi_string_get_cstr(runs_path));
+    }
+
+    stream_free(runs_stream);
+    free(keys);
+    furi_string_free(runs_path);
+    furi_string_free(line);
+
+    return index_built;
+}
+
+static void keys_dict_index_init(KeysDict* instance, const char* path) {
+    instance->path = furi_string_alloc_set(path);
+    instance->index_path = furi_string_alloc_printf("%s%s", path, KEYS_DICT_INDEX_EXTENSION);
+    instance->index_stream = buffered_file_stream_alloc(instance->storage);
+
+    if(keys_dict_index_open(instance)) {
+        instance->total_keys = instance->index_keys;
+        FURI_LOG_D(TAG, "Using index %s", furi_string_get_cstr(instance->index_path));
+    } else {
+        instance->total_keys = keys_dict_count_keys(instance);
+        if(keys_dict_index_build(instance)) {
+            FURI_LOG_I(TAG, "Built index %s", furi_string_get_cstr(instance->index_path));
+        } else {
+            FURI_LOG_W(TAG, "Failed to build index, using text mode");
+            stream_free(instance->index_stream);
+            instance->index_stream = NULL;
+        }
+    }
+}
+
 KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size) {
     furi_check(path);
     furi_check(key_size > 0);
 
     KeysDict* instance = malloc(sizeof(KeysDict));
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    instance->stream = buffered_file_stream_alloc(storage);
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->stream = buffered_file_stream_alloc(instance->storage);
 
-    FS_OpenMode open_mode = (mode == KeysDictModeOpenAlways) ? FSOM_OPEN_ALWAYS :
-                                                               FSOM_OPEN_EXISTING;
+    FS_OpenMode open_mode =
+        (mode == KeysDictModeOpenAlways || mode == KeysDictModeOpenAlwaysIndexed) ?
+            FSOM_OPEN_ALWAYS :
+            FSOM_OPEN_EXISTING;
+    bool indexed = (mode == KeysDictModeOpenExistingIndexed) ||
+                   (mode == KeysDictModeOpenAlwaysIndexed);
 
     // Byte = 2 symbols + 1 end of line
     instance->key_size = key_size;
@@ -92,22 +443,13 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
         keys_dict_add_ending_new_line(instance);
     }
 
-    FuriString* line = furi_string_alloc();
-
-    bool is_endfile = false;
-
-    // In this loop we only count the entries in the file
-    // We prefer not to load the whole file in memory for space reasons
-    while(file_exists && !is_endfile) {
-        bool read_key = keys_dict_read_key_line(instance, line, &is_endfile);
-        if(read_key) {
-            instance->total_keys++;
-        }
+    if(file_exists && indexed && key_size <= sizeof(uint64_t)) {
+        keys_dict_index_init(instance, path);
+    } else if(file_exists) {
+        instance->total_keys = keys_dict_count_keys(instance);
     }
-    stream_rewind(instance->stream);
-    FURI_LOG_I(TAG, "Loaded dictionary with %zu keys", instance->total_keys);
 
-    furi_string_free(line);
+    FURI_LOG_I(TAG, "Loaded dictionary with %zu keys", instance->total_keys);
 
     return instance;
 }
@@ -116,6 +458,14 @@ void keys_dict_free(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
+    if(instance->index_stream) {
+        buffered_file_stream_close(instance->index_stream);
+        stream_free(instance->index_stream);
+    }
+    if(instance->path) furi_string_free(instance->path);
+    if(instance->index_path) furi_string_free(instance->index_path);
+    free(instance->pending_keys);
+
     buffered_file_stream_close(instance->stream);
     stream_free(instance->stream);
     free(instance);
@@ -123,36 +473,6 @@ void keys_dict_free(KeysDict* instance) {
     furi_record_close(RECORD_STORAGE);
 }
 
-static void keys_dict_int_to_str(KeysDict* instance, const uint8_t* key_int, FuriString* key_str) {
-    furi_assert(instance);
-    furi_assert(key_str);
-    furi_assert(key_int);
-
-    furi_string_reset(key_str);
-
-    for(size_t i = 0; i < instance->key_size; i++)
-        furi_string_cat_printf(key_str, "%02X", key_int[i]);
-}
-
-static void keys_dict_str_to_int(KeysDict* instance, FuriString* key_str, uint64_t* key_int) {
-    furi_assert(instance);
-    furi_assert(key_str);
-    furi_assert(key_int);
-
-    uint8_t key_byte_tmp;
-    char h, l;
-
-    *key_int = 0ULL;
-
-    for(size_t i = 0; i < instance->key_size_symbols - 1; i += 2) {
-        h = furi_string_get_char(key_str, i);
-        l = furi_string_get_char(key_str, i + 1);
-
-        args_char_to_hex(h, l, &key_byte_tmp);
-        *key_int |= (uint64_t)key_byte_tmp << (8 * (instance->key_size - 1 - i / 2));
-    }
-}
-
 size_t keys_dict_get_total_keys(KeysDict* instance) {
     furi_check(instance);
 
@@ -163,6 +483,12 @@ bool keys_dict_rewind(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
+    if(instance->index_stream) {
+        instance->index_position = 0;
+        return stream_seek(
+            instance->index_stream, sizeof(KeysDictIndexHeader), StreamOffsetFromStart);
+    }
+
     return stream_rewind(instance->stream);
 }
 
@@ -182,12 +508,25 @@ static bool keys_dict_get_next_key_str(KeysDict* instance, FuriString* key) {
     return key_read;
 }
 
-bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
-    furi_check(instance);
-    furi_check(instance->stream);
-    furi_check(instance->key_size == key_size);
-    furi_check(key);
+static bool keys_dict_index_get_next_key(KeysDict* instance, uint8_t* key) {
+    bool key_read = false;
+
+    if(instance->index_position < instance->index_keys) {
+        key_read = stream_read(instance->index_stream, key, instance->key_size) ==
+                   instance->key_size;
+    } else if(instance->index_position < instance->index_keys + instance->pending_count) {
+        size_t pending_index = instance->index_position - instance->index_keys;
+        memcpy(
+            key, &instance->pending_keys[pending_index * instance->key_size], instance->key_size);
+        key_read = true;
+    }
+
+    if(key_read) instance->index_position++;
+
+    return key_read;
+}
 
+static bool keys_dict_get_next_key_text(KeysDict* instance, uint8_t* key, size_t key_size) {
     FuriString* temp_key = furi_string_alloc();
 
     bool key_read = keys_dict_get_next_key_str(instance, temp_key);
@@ -208,6 +547,19 @@ bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
     return key_read;
 }
 
+bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
+    furi_check(instance);
+    furi_check(instance->stream);
+    furi_check(instance->key_size == key_size);
+    furi_check(key);
+
+    if(instance->index_stream) {
+        return keys_dict_index_get_next_key(instance, key);
+    }
+
+    return keys_dict_get_next_key_text(instance, key, key_size);
+}
+
 static bool keys_dict_is_key_present_str(KeysDict* instance, FuriString* key) {
     furi_assert(instance);
     furi_assert(instance->stream);
@@ -234,12 +586,55 @@ static bool keys_dict_is_key_present_str(KeysDict* instance, FuriString* key) {
     return line_found;
 }
 
+static bool keys_dict_index_is_key_present(KeysDict* instance, const uint8_t* key) {
+    const size_t key_size = instance->key_size;
+    const size_t sorted_offset = sizeof(KeysDictIndexHeader) + instance->index_keys * key_size;
+    uint8_t probe[sizeof(uint64_t)];
+    bool key_found = false;
+
+    // Keys added during this session are not in the index yet
+    for(size_t i = 0; i < instance->pending_count && !key_found; i++) {
+        key_found = memcmp(&instance->pending_keys[i * key_size], key, key_size) == 0;
+    }
+
+    uint32_t actual_pos = stream_tell(instance->index_stream);
+
+    size_t low = 0;
+    size_t high = instance->index_keys;
+    while(!key_found && low < high) {
+        size_t mid = low + (high - low) / 2;
+        if(!stream_seek(
+               instance->index_stream, sorted_offset + mid * key_size, StreamOffsetFromStart) ||
+           stream_read(instance->index_stream, probe, key_size) != key_size) {
+            break;
+        }
+
+        int result = memcmp(probe, key, key_size);
+        if(result == 0) {
+            key_found = true;
+        } else if(result < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    // Restore the position of the stream
+    stream_seek(instance->index_stream, actual_pos, StreamOffsetFromStart);
+
+    return key_found;
+}
+
 bool keys_dict_is_key_present(KeysDict* instance, const uint8_t* key, size_t key_size) {
     furi_check(instance);
     furi_check(instance->stream);
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->index_stream) {
+        return keys_dict_index_is_key_present(instance, key);
+    }
+
     FuriString* temp_key = furi_string_alloc();
 
     keys_dict_int_to_str(instance, key, temp_key);
@@ -282,6 +677,13 @@ bool keys_dict_add_key(KeysDict* instance, const uint8_t* key, size_t key_size)
     keys_dict_int_to_str(instance, key, temp_key);
     bool key_added = keys_dict_add_key_str(instance, temp_key);
 
+    if(key_added && instance->index_stream) {
+        instance->pending_keys =
+            realloc(instance->pending_keys, (instance->pending_count + 1) * key_size);
+        memcpy(&instance->pending_keys[instance->pending_count * key_size], key, key_size);
+        instance->pending_count++;
+    }
+
     FURI_LOG_I(TAG, "Added key %s", furi_string_get_cstr(temp_key));
 
     furi_string_free(temp_key);
@@ -302,7 +704,7 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
     stream_rewind(instance->stream);
 
     while(!key_removed) {
-        if(!keys_dict_get_next_key(instance, temp_key, key_size)) {
+        if(!keys_dict_get_next_key_text(instance, temp_key, key_size)) {
             break;
         }
 
@@ -327,5 +729,20 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
     stream_rewind(instance->stream);
     free(temp_key);
 
+    // Deleting shifts the whole file, so the index is rebuilt from scratch
+    if(key_removed && instance->index_stream) {
+        buffered_file_stream_close(instance->index_stream);
+        free(instance->pending_keys);
+        instance->pending_keys = NULL;
+        instance->pending_count = 0;
+        instance->index_position = 0;
+
+        if(!keys_dict_index_build(instance)) {
+            FURI_LOG_W(TAG, "Failed to rebuild index, using text mode");
+            stream_free(instance->index_stream);
+            instance->index_stream = NULL;
+        }
+    }
+
     return key_removed;
 }
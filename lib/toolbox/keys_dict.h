@@ -11,6 +11,8 @@ extern "C" {
 typedef enum {
     KeysDictModeOpenExisting,
     KeysDictModeOpenAlways,
+    KeysDictModeOpenExistingIndexed,
+    KeysDictModeOpenAlwaysIndexed,
 } KeysDictMode;
 
 typedef struct KeysDict KeysDict;
@@ -26,6 +28,12 @@ bool keys_dict_check_presence(const char* path);
 /** Open or create list
  * Depending on mode, list will be opened or created.
  *
+ * Indexed modes keep a binary sidecar index next to the list (path + ".idx")
+ * with keys in file order and in sorted order. The index is rebuilt on open
+ * when the list file size or timestamp no longer matches. Key lookups become
+ * binary searches and iteration returns keys without parsing the text.
+ * If the list is too big to be indexed, plain text mode is used.
+ *
  * @param path      - Path of the file that contain the list
  * @param mode      - ListKeysMode value
  * @param key_size  - Size of each key in bytes
@@ -0,0 +1,316 @@
+#include "profiler_slots.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <time.h>
+
+// Not assert, a mismatched exit must fail under NDEBUG too, as furi_check does on device
+#define profiler_slots_check(x)                                        \
+    do {                                                               \
+        if(!(x)) {                                                     \
+            fprintf(stderr, "profiler_slots: check failed: %s\n", #x); \
+            abort();                                                   \
+        }                                                              \
+    } while(0)
+
+static inline uint32_t profiler_slots_clock(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t profiler_slots_get_clock_hz(void) {
+    return 1000000000UL;
+}
+#else
+#include <furi.h>
+#include <stm32wbxx.h>
+
+#define profiler_slots_check(x) furi_check(x)
+
+static inline uint32_t profiler_slots_clock(void) {
+    return DWT->CYCCNT;
+}
+
+uint32_t profiler_slots_get_clock_hz(void) {
+    return SystemCoreClock;
+}
+#endif
+
+#define PROFILER_SLOTS_EXPORT_MAGIC   (0x544C5350UL) // "PSLT"
+#define PROFILER_SLOTS_EXPORT_VERSION (1U)
+#define PROFILER_SLOTS_NODE_NONE      (0xFFFFU)
+#define PROFILER_SLOTS_NODE_ROOT      (0U)
+
+/** Call path node, a slot entered from the parent node path */
+typedef struct {
+    ProfilerSlot slot;
+    uint16_t parent;
+    uint16_t first_child;
+    uint16_t next_sibling;
+    uint32_t count;
+    uint64_t total;
+    uint64_t self;
+} ProfilerSlotsNode;
+
+typedef struct {
+    ProfilerSlot slot;
+    uint16_t node;
+    uint32_t start;
+    uint32_t child;
+} ProfilerSlotsFrame;
+
+struct ProfilerSlots {
+    const char** names;
+    ProfilerSlotStats* stats;
+    size_t slot_count;
+    size_t slot_max;
+
+    ProfilerSlotsNode* nodes;
+    size_t node_count;
+    size_t node_max;
+
+    ProfilerSlotsFrame stack[PROFILER_SLOTS_DEPTH_MAX];
+    size_t depth;
+};
+
+ProfilerSlots* profiler_slots_alloc(size_t slot_count, size_t node_count) {
+    profiler_slots_check(slot_count > 0 && slot_count < PROFILER_SLOTS_NODE_NONE);
+    profiler_slots_check(node_count < PROFILER_SLOTS_NODE_NONE);
+
+    ProfilerSlots* profiler = calloc(1, sizeof(ProfilerSlots));
+    profiler->slot_max = slot_count;
+    profiler->names = calloc(slot_count, sizeof(const char*));
+    profiler->stats = calloc(slot_count, sizeof(ProfilerSlotStats));
+    // One more for the root node
+    profiler->node_max = node_count + 1;
+    profiler->nodes = calloc(profiler->node_max, sizeof(ProfilerSlotsNode));
+
+    profiler_slots_reset(profiler);
+    return profiler;
+}
+
+void profiler_slots_free(ProfilerSlots* profiler) {
+    profiler_slots_check(profiler);
+    free(profiler->nodes);
+    free(profiler->stats);
+    free(profiler->names);
+    free(profiler);
+}
+
+ProfilerSlot profiler_slots_register(ProfilerSlots* profiler, const char* name) {
+    profiler_slots_check(profiler);
+    profiler_slots_check(name);
+    profiler_slots_check(profiler->slot_count < profiler->slot_max);
+
+    const ProfilerSlot slot = profiler->slot_count++;
+    profiler->names[slot] = name;
+    return slot;
+}
+
+void profiler_slots_reset(ProfilerSlots* profiler) {
+    profiler_slots_check(profiler);
+    profiler_slots_check(profiler->depth == 0);
+
+    memset(profiler->stats, 0, profiler->slot_max * sizeof(ProfilerSlotStats));
+    for(size_t i = 0; i < profiler->slot_max; i++) {
+        profiler->stats[i].min = UINT32_MAX;
+    }
+
+    memset(profiler->nodes, 0, profiler->node_max * sizeof(ProfilerSlotsNode));
+    profiler->nodes[PROFILER_SLOTS_NODE_ROOT].first_child = PROFILER_SLOTS_NODE_NONE;
+    profiler->nodes[PROFILER_SLOTS_NODE_ROOT].next_sibling = PROFILER_SLOTS_NODE_NONE;
+    profiler->node_count = 1;
+}
+
+static uint16_t
+    profiler_slots_get_node(ProfilerSlots* profiler, uint16_t parent, ProfilerSlot slot) {
+    // Paths past the node limit are not tracked, slot statistics still are
+    if(parent == PROFILER_SLOTS_NODE_NONE) return PROFILER_SLOTS_NODE_NONE;
+
+    ProfilerSlotsNode* parent_node = &profiler->nodes[parent];
+    for(uint16_t id = parent_node->first_child; id != PROFILER_SLOTS_NODE_NONE;
+        id = profiler->nodes[id].next_sibling) {
+        if(profiler->nodes[id].slot == slot) return id;
+    }
+
+    if(profiler->node_count >= profiler->node_max) return PROFILER_SLOTS_NODE_NONE;
+
+    const uint16_t id = profiler->node_count++;
+    ProfilerSlotsNode* node = &profiler->nodes[id];
+    node->slot = slot;
+    node->parent = parent;
+    node->first_child = PROFILER_SLOTS_NODE_NONE;
+    node->next_sibling = parent_node->first_child;
+    parent_node->first_child = id;
+
+    return id;
+}
+
+void profiler_slots_enter(ProfilerSlots* profiler, ProfilerSlot slot) {
+    profiler_slots_check(slot < profiler->slot_count);
+    profiler_slots_check(profiler->depth < PROFILER_SLOTS_DEPTH_MAX);
+
+    const uint16_t parent = profiler->depth ? profiler->stack[profiler->depth - 1].node :
+                                              PROFILER_SLOTS_NODE_ROOT;
+
+    ProfilerSlotsFrame* frame = &profiler->stack[profiler->depth++];
+    frame->slot = slot;
+    frame->node = profiler_slots_get_node(profiler, parent, slot);
+    frame->child = 0;
+    // Last, bookkeeping is not part of the scope
+    frame->start = profiler_slots_clock();
+}
+
+static inline uint32_t profiler_slots_bucket(uint32_t duration) {
+    if(duration == 0) return 0;
+    return (31U - (uint32_t)__builtin_clz(duration)) / 2U;
+}
+
+void profiler_slots_exit(ProfilerSlots* profiler, ProfilerSlot slot) {
+    const uint32_t now = profiler_slots_clock();
+
+    profiler_slots_check(profiler->depth > 0);
+    ProfilerSlotsFrame* frame = &profiler->stack[--profiler->depth];
+    profiler_slots_check(frame->slot == slot);
+
+    const uint32_t duration = now - frame->start;
+    const uint32_t self = duration > frame->child ? duration - frame->child : 0;
+
+    ProfilerSlotStats* stats = &profiler->stats[slot];
+    stats->count++;
+    stats->total += duration;
+    stats->self += self;
+    if(duration < stats->min) stats->min = duration;
+    if(duration > stats->max) stats->max = duration;
+    stats->histogram[profiler_slots_bucket(duration)]++;
+
+    if(frame->node != PROFILER_SLOTS_NODE_NONE) {
+        ProfilerSlotsNode* node = &profiler->nodes[frame->node];
+        node->count++;
+        node->total += duration;
+        node->self += self;
+    }
+
+    if(profiler->depth) {
+        profiler->stack[profiler->depth - 1].child += duration;
+    }
+}
+
+const ProfilerSlotStats* profiler_slots_get_stats(ProfilerSlots* profiler, ProfilerSlot slot) {
+    profiler_slots_check(profiler);
+    profiler_slots_check(slot < profiler->slot_count);
+    return &profiler->stats[slot];
+}
+
+typedef struct {
+    uint8_t data[64];
+    size_t size;
+} ProfilerSlotsRecord;
+
+static void profiler_slots_record_put(ProfilerSlotsRecord* record, uint64_t value, size_t size) {
+    // Little endian, whatever the host is
+    for(size_t i = 0; i < size; i++) {
+        record->data[record->size++] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static bool profiler_slots_record_write(
+    ProfilerSlotsRecord* record,
+    ProfilerSlotsWriteCallback callback,
+    void* context) {
+    bool success = callback(record->data, record->size, context);
+    record->size = 0;
+    return success;
+}
+
+bool profiler_slots_export(
+    ProfilerSlots* profiler,
+    ProfilerSlotsWriteCallback callback,
+    void* context) {
+    profiler_slots_check(profiler);
+    profiler_slots_check(callback);
+
+    ProfilerSlotsRecord record = {.size = 0};
+    bool success = false;
+
+    do {
+        // Header
+        profiler_slots_record_put(&record, PROFILER_SLOTS_EXPORT_MAGIC, 4);
+        profiler_slots_record_put(&record, PROFILER_SLOTS_EXPORT_VERSION, 1);
+        profiler_slots_record_put(&record, PROFILER_SLOTS_HISTOGRAM_SIZE, 1);
+        profiler_slots_record_put(&record, profiler->slot_count, 2);
+        profiler_slots_record_put(&record, profiler->node_count - 1, 2);
+        profiler_slots_record_put(&record, profiler_slots_get_clock_hz(), 4);
+        if(!profiler_slots_record_write(&record, callback, context)) break;
+
+        // Slots: name, then statistics
+        bool slots_written = true;
+        for(size_t i = 0; i < profiler->slot_count && slots_written; i++) {
+            const ProfilerSlotStats* stats = &profiler->stats[i];
+            size_t name_length = strlen(profiler->names[i]);
+            if(name_length > UINT8_MAX) name_length = UINT8_MAX;
+
+            profiler_slots_record_put(&record, name_length, 1);
+            slots_written = profiler_slots_record_write(&record, callback, context) &&
+                            callback(profiler->names[i], name_length, context);
+            if(!slots_written) break;
+
+            profiler_slots_record_put(&record, stats->count, 4);
+            profiler_slots_record_put(&record, stats->total, 8);
+            profiler_slots_record_put(&record, stats->self, 8);
+            profiler_slots_record_put(&record, stats->count ? stats->min : 0, 4);
+            profiler_slots_record_put(&record, stats->max, 4);
+            slots_written = profiler_slots_record_write(&record, callback, context);
+            for(size_t j = 0; j < PROFILER_SLOTS_HISTOGRAM_SIZE; j++) {
+                profiler_slots_record_put(&record, stats->histogram[j], 4);
+            }
+            slots_written = slots_written &&
+                            profiler_slots_record_write(&record, callback, context);
+        }
+        if(!slots_written) break;
+
+        // Call path nodes, parents always come before their children
+        bool nodes_written = true;
+        for(size_t i = 1; i < profiler->node_count && nodes_written; i++) {
+            const ProfilerSlotsNode* node = &profiler->nodes[i];
+            profiler_slots_record_put(&record, node->parent, 2);
+            profiler_slots_record_put(&record, node->slot, 2);
+            profiler_slots_record_put(&record, node->count, 4);
+            profiler_slots_record_put(&record, node->total, 8);
+            profiler_slots_record_put(&record, node->self, 8);
+            nodes_written = profiler_slots_record_write(&record, callback, context);
+        }
+        if(!nodes_written) break;
+
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+void profiler_slots_dump(ProfilerSlots* profiler) {
+    profiler_slots_check(profiler);
+
+    const double ticks_per_us = (double)profiler_slots_get_clock_hz() / 1000000.0;
+
+    printf("Profiler slots:\r\n");
+    for(size_t i = 0; i < profiler->slot_count; i++) {
+        const ProfilerSlotStats* stats = &profiler->stats[i];
+        if(stats->count == 0) continue;
+
+        printf(
+            "\t%s[%" PRIu32 "]: total %f us, self %f us, avg %f us, min %f us, max %f us\r\n",
+            profiler->names[i],
+            stats->count,
+            (double)stats->total / ticks_per_us,
+            (double)stats->self / ticks_per_us,
+            (double)stats->total / ticks_per_us / (double)stats->count,
+            (double)stats->min / ticks_per_us,
+            (double)stats->max / ticks_per_us);
+    }
+}
@@ -0,0 +1,134 @@
+/**
+ * @file profiler_slots.h
+ * Low overhead profiler with pre-registered numeric slots
+ *
+ * Scopes are entered and exited by slot number, no lookups or allocations are
+ * done while timing. Scopes may nest, including the same slot, time spent in
+ * nested scopes is attributed to the call path and excluded from the parent
+ * self time. Every slot keeps count, total, self, min, max and a latency
+ * histogram. Not thread safe, use one instance per thread.
+ *
+ * Builds on Linux as well, timing with the monotonic clock in nanoseconds.
+ * On device timing is done in CPU cycles.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROFILER_SLOTS_HISTOGRAM_SIZE (16U)
+#define PROFILER_SLOTS_DEPTH_MAX      (32U)
+
+typedef struct ProfilerSlots ProfilerSlots;
+
+typedef uint16_t ProfilerSlot;
+
+/** Per slot statistics, times are in clock ticks */
+typedef struct {
+    uint32_t count;
+    uint64_t total; /**< Inclusive time */
+    uint64_t self; /**< Time not spent in nested scopes */
+    uint32_t min;
+    uint32_t max;
+    /** Latency histogram, bucket n holds durations in [4^n, 4^(n+1)) ticks */
+    uint32_t histogram[PROFILER_SLOTS_HISTOGRAM_SIZE];
+} ProfilerSlotStats;
+
+/** Export write callback
+ *
+ * @param      data     data to write
+ * @param      size     data size
+ * @param      context  context passed to profiler_slots_export
+ *
+ * @return     true on success
+ */
+typedef bool (*ProfilerSlotsWriteCallback)(const void* data, size_t size, void* context);
+
+/** Allocate profiler
+ *
+ * @param      slot_count  maximum number of slots
+ * @param      node_count  maximum number of distinct call paths kept for export
+ *
+ * @return     ProfilerSlots instance
+ */
+ProfilerSlots* profiler_slots_alloc(size_t slot_count, size_t node_count);
+
+/** Free profiler
+ *
+ * @param      profiler  ProfilerSlots instance
+ */
+void profiler_slots_free(ProfilerSlots* profiler);
+
+/** Register a slot, do it before timing
+ *
+ * @param      profiler  ProfilerSlots instance
+ * @param      name      slot name, must stay valid for the profiler lifetime
+ *
+ * @return     slot number
+ */
+ProfilerSlot profiler_slots_register(ProfilerSlots* profiler, const char* name);
+
+/** Enter slot scope
+ *
+ * @param      profiler  ProfilerSlots instance
+ * @param      slot      slot number
+ */
+void profiler_slots_enter(ProfilerSlots* profiler, ProfilerSlot slot);
+
+/** Exit slot scope, must match the innermost entered slot
+ *
+ * @param      profiler  ProfilerSlots instance
+ * @param      slot      slot number
+ */
+void profiler_slots_exit(ProfilerSlots* profiler, ProfilerSlot slot);
+
+/** Get slot statistics
+ *
+ * @param      profiler  ProfilerSlots instance
+ * @param      slot      slot number
+ *
+ * @return     pointer to slot statistics, valid until the profiler is freed
+ */
+const ProfilerSlotStats* profiler_slots_get_stats(ProfilerSlots* profiler, ProfilerSlot slot);
+
+/** Get clock frequency of the tick values
+ *
+ * @return     ticks per second
+ */
+uint32_t profiler_slots_get_clock_hz(void);
+
+/** Reset statistics and call paths, slots stay registered
+ *
+ * @param      profiler  ProfilerSlots instance
+ */
+void profiler_slots_reset(ProfilerSlots* profiler);
+
+/** Export statistics and call paths in compact binary form
+ *
+ * Use scripts/profiler.py to convert it to folded stacks for flame graphs.
+ *
+ * @param      profiler  ProfilerSlots instance
+ * @param      callback  write callback
+ * @param      context   callback context
+ *
+ * @return     true on success
+ */
+bool profiler_slots_export(
+    ProfilerSlots* profiler,
+    ProfilerSlotsWriteCallback callback,
+    void* context);
+
+/** Print statistics
+ *
+ * @param      profiler  ProfilerSlots instance
+ */
+void profiler_slots_dump(ProfilerSlots* profiler);
+
+#ifdef __cplusplus
+}
+#endif
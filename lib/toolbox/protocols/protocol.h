@@ -11,6 +11,15 @@ typedef uint8_t* (*ProtocolGetData)(void* protocol);
 
 typedef void (*ProtocolDecoderStart)(void* protocol);
 typedef bool (*ProtocolDecoderFeed)(void* protocol, bool level, uint32_t duration);
+typedef bool (*ProtocolDecoderFeedBits)(void* protocol, bool value, uint32_t count);
+
+typedef void (*ProtocolDemodStart)(void* demod);
+typedef void (*ProtocolDemodFeed)(
+    void* demod,
+    bool level,
+    uint32_t duration,
+    bool* value,
+    uint32_t* count);
 
 typedef bool (*ProtocolEncoderStart)(void* protocol);
 typedef LevelDuration (*ProtocolEncoderYield)(void* protocol);
@@ -18,9 +27,29 @@ typedef LevelDuration (*ProtocolEncoderYield)(void* protocol);
 typedef void (*ProtocolRenderData)(void* protocol, FuriString* result);
 typedef bool (*ProtocolWriteData)(void* protocol, void* data);
 
+/**
+ * Demodulator shared by decoders of the same modulation.
+ *
+ * ProtocolDict runs it once per duration and passes the demodulated bits,
+ * count times value, to every decoder that refers to it.
+ */
+typedef struct {
+    ProtocolAlloc alloc;
+    ProtocolFree free;
+    ProtocolDemodStart start;
+    ProtocolDemodFeed feed;
+} ProtocolDemod;
+
+/**
+ * A decoder either takes raw durations through feed, or bits from the
+ * shared demod through feed_bits. Decoders sharing a demod must have the
+ * same features, so they are always fed together.
+ */
 typedef struct {
     ProtocolDecoderStart start;
     ProtocolDecoderFeed feed;
+    const ProtocolDemod* demod;
+    ProtocolDecoderFeedBits feed_bits;
 } ProtocolDecoder;
 
 typedef struct {
@@ -1,12 +1,50 @@
 #include <furi.h>
 #include "protocol_dict.h"
 
+typedef struct {
+    const ProtocolDemod* base;
+    void* data;
+    uint32_t features;
+    bool value;
+    uint32_t count;
+} ProtocolDictDemod;
+
 struct ProtocolDict {
     const ProtocolBase* const* base;
     size_t count;
+    size_t demod_count;
+    ProtocolDictDemod* demods;
+    size_t* demod_index;
     void* data[];
 };
 
+static void protocol_dict_demods_alloc(ProtocolDict* dict) {
+    dict->demods = malloc(sizeof(ProtocolDictDemod) * dict->count);
+    dict->demod_index = malloc(sizeof(size_t) * dict->count);
+
+    for(size_t i = 0; i < dict->count; i++) {
+        const ProtocolDecoder* decoder = &dict->base[i]->decoder;
+        if(!decoder->demod) continue;
+        furi_check(decoder->feed_bits);
+
+        size_t index = 0;
+        while(index < dict->demod_count && dict->demods[index].base != decoder->demod) {
+            index++;
+        }
+
+        if(index == dict->demod_count) {
+            dict->demods[index].base = decoder->demod;
+            dict->demods[index].data = decoder->demod->alloc();
+            dict->demods[index].features = dict->base[i]->features;
+            dict->demod_count++;
+        }
+
+        // Shared demod state is only valid if all its decoders see the same durations
+        furi_check(dict->demods[index].features == dict->base[i]->features);
+        dict->demod_index[i] = index;
+    }
+}
+
 ProtocolDict* protocol_dict_alloc(const ProtocolBase* const* protocols, size_t count) {
     furi_check(protocols);
 
@@ -18,12 +56,20 @@ ProtocolDict* protocol_dict_alloc(const ProtocolBase* const* protocols, size_t c
         dict->data[i] = dict->base[i]->alloc();
     }
 
+    protocol_dict_demods_alloc(dict);
+
     return dict;
 }
 
 void protocol_dict_free(ProtocolDict* dict) {
     furi_check(dict);
 
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        dict->demods[i].base->free(dict->demods[i].data);
+    }
+    free(dict->demods);
+    free(dict->demod_index);
+
     for(size_t i = 0; i < dict->count; i++) {
         dict->base[i]->free(dict->data[i]);
     }
@@ -31,6 +77,31 @@ void protocol_dict_free(ProtocolDict* dict) {
     free(dict);
 }
 
+static void protocol_dict_demod_feed(ProtocolDictDemod* demod, bool level, uint32_t duration) {
+    demod->count = 0;
+    demod->base->feed(demod->data, level, duration, &demod->value, &demod->count);
+}
+
+static bool protocol_dict_decoder_feed(
+    ProtocolDict* dict,
+    size_t protocol_index,
+    bool level,
+    uint32_t duration) {
+    const ProtocolDecoder* decoder = &dict->base[protocol_index]->decoder;
+    bool result = false;
+
+    if(decoder->demod) {
+        const ProtocolDictDemod* demod = &dict->demods[dict->demod_index[protocol_index]];
+        if(demod->count > 0) {
+            result = decoder->feed_bits(dict->data[protocol_index], demod->value, demod->count);
+        }
+    } else if(decoder->feed) {
+        result = decoder->feed(dict->data[protocol_index], level, duration);
+    }
+
+    return result;
+}
+
 void protocol_dict_set_data(
     ProtocolDict* dict,
     size_t protocol_index,
@@ -90,6 +161,14 @@ const char* protocol_dict_get_manufacturer(ProtocolDict* dict, size_t protocol_i
 void protocol_dict_decoders_start(ProtocolDict* dict) {
     furi_check(dict);
 
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        ProtocolDemodStart fn = dict->demods[i].base->start;
+
+        if(fn) {
+            fn(dict->demods[i].data);
+        }
+    }
+
     for(size_t i = 0; i < dict->count; i++) {
         ProtocolDecoderStart fn = dict->base[i]->decoder.start;
 
@@ -110,15 +189,15 @@ ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t
     bool done = false;
     ProtocolId ready_protocol_id = PROTOCOL_NO;
 
-    for(size_t i = 0; i < dict->count; i++) {
-        ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        protocol_dict_demod_feed(&dict->demods[i], level, duration);
+    }
 
-        if(fn) {
-            if(fn(dict->data[i], level, duration)) {
-                if(!done) {
-                    ready_protocol_id = i;
-                    done = true;
-                }
+    for(size_t i = 0; i < dict->count; i++) {
+        if(protocol_dict_decoder_feed(dict, i, level, duration)) {
+            if(!done) {
+                ready_protocol_id = i;
+                done = true;
             }
         }
     }
@@ -136,17 +215,19 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
     bool done = false;
     ProtocolId ready_protocol_id = PROTOCOL_NO;
 
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        if(dict->demods[i].features & feature) {
+            protocol_dict_demod_feed(&dict->demods[i], level, duration);
+        }
+    }
+
     for(size_t i = 0; i < dict->count; i++) {
         uint32_t features = dict->base[i]->features;
         if(features & feature) {
-            ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
-
-            if(fn) {
-                if(fn(dict->data[i], level, duration)) {
-                    if(!done) {
-                        ready_protocol_id = i;
-                        done = true;
-                    }
+            if(protocol_dict_decoder_feed(dict, i, level, duration)) {
+                if(!done) {
+                    ready_protocol_id = i;
+                    done = true;
                 }
             }
         }
@@ -163,12 +244,14 @@ ProtocolId protocol_dict_decoders_feed_by_id(
     furi_check(protocol_index < dict->count);
 
     ProtocolId ready_protocol_id = PROTOCOL_NO;
-    ProtocolDecoderFeed fn = dict->base[protocol_index]->decoder.feed;
 
-    if(fn) {
-        if(fn(dict->data[protocol_index], level, duration)) {
-            ready_protocol_id = protocol_index;
-        }
+    if(dict->base[protocol_index]->decoder.demod) {
+        protocol_dict_demod_feed(
+            &dict->demods[dict->demod_index[protocol_index]], level, duration);
+    }
+
+    if(protocol_dict_decoder_feed(dict, protocol_index, level, duration)) {
+        ready_protocol_id = protocol_index;
     }
 
     return ready_protocol_id;
@@ -8,7 +8,8 @@ typedef struct {
     Stream stream_base;
     Stream* file_stream;
     StreamCache* cache;
-    bool sync_pending;
+    size_t position;
+    size_t size;
 } BufferedFileStream;
 
 static void buffered_file_stream_free(BufferedFileStream* stream);
@@ -27,8 +28,7 @@ static bool buffered_file_stream_delete_and_insert(
     StreamWriteCB write_callback,
     const void* ctx);
 
-static bool buffered_file_stream_flush(BufferedFileStream* stream);
-static bool buffered_file_stream_unread(BufferedFileStream* stream);
+static void buffered_file_stream_reload(BufferedFileStream* stream);
 
 const StreamVTable buffered_file_stream_vtable = {
     .free = (StreamFreeFn)buffered_file_stream_free,
@@ -43,11 +43,20 @@ const StreamVTable buffered_file_stream_vtable = {
 };
 
 Stream* buffered_file_stream_alloc(Storage* storage) {
+    return buffered_file_stream_alloc_ex(
+        storage, STREAM_CACHE_DEFAULT_BLOCK_SIZE, STREAM_CACHE_DEFAULT_BLOCK_COUNT);
+}
+
+Stream* buffered_file_stream_alloc_ex(Storage* storage, size_t block_size, size_t block_count) {
+    furi_check(block_size > 0);
+    furi_check(block_count > 0);
+
     BufferedFileStream* stream = malloc(sizeof(BufferedFileStream));
 
     stream->file_stream = file_stream_alloc(storage);
-    stream->cache = stream_cache_alloc();
-    stream->sync_pending = false;
+    stream->cache = stream_cache_alloc(block_size, block_count);
+    stream->position = 0;
+    stream->size = 0;
 
     stream->stream_base.vtable = &buffered_file_stream_vtable;
     return (Stream*)stream;
@@ -61,7 +70,10 @@ bool buffered_file_stream_open(
     furi_check(_stream);
     BufferedFileStream* stream = (BufferedFileStream*)_stream;
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
-    return file_stream_open(stream->file_stream, path, access_mode, open_mode);
+    bool success = file_stream_open(stream->file_stream, path, access_mode, open_mode);
+    stream_cache_drop(stream->cache);
+    buffered_file_stream_reload(stream);
+    return success;
 }
 
 bool buffered_file_stream_close(Stream* _stream) {
@@ -70,12 +82,13 @@ bool buffered_file_stream_close(Stream* _stream) {
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
     bool success = false;
     do {
-        if(!(stream->sync_pending ? buffered_file_stream_flush(stream) :
-                                    buffered_file_stream_unread(stream)))
-            break;
+        if(!stream_cache_flush(stream->cache, stream->file_stream)) break;
         if(!file_stream_close(stream->file_stream)) break;
         success = true;
     } while(false);
+    stream_cache_drop(stream->cache);
+    stream->position = 0;
+    stream->size = 0;
     return success;
 }
 
@@ -83,7 +96,7 @@ bool buffered_file_stream_sync(Stream* _stream) {
     furi_check(_stream);
     BufferedFileStream* stream = (BufferedFileStream*)_stream;
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
-    return stream->sync_pending ? buffered_file_stream_flush(stream) : true;
+    return stream_cache_flush(stream->cache, stream->file_stream);
 }
 
 FS_Error buffered_file_stream_get_error(Stream* _stream) {
@@ -93,6 +106,21 @@ FS_Error buffered_file_stream_get_error(Stream* _stream) {
     return file_stream_get_error(stream->file_stream);
 }
 
+void buffered_file_stream_get_cache_stats(Stream* _stream, StreamCacheStats* stats) {
+    furi_check(_stream);
+    furi_check(stats);
+    BufferedFileStream* stream = (BufferedFileStream*)_stream;
+    furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
+    stream_cache_get_stats(stream->cache, stats);
+}
+
+void buffered_file_stream_reset_cache_stats(Stream* _stream) {
+    furi_check(_stream);
+    BufferedFileStream* stream = (BufferedFileStream*)_stream;
+    furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
+    stream_cache_reset_stats(stream->cache);
+}
+
 static void buffered_file_stream_free(BufferedFileStream* stream) {
     furi_check(stream);
     buffered_file_stream_sync((Stream*)stream);
@@ -102,108 +130,77 @@ static void buffered_file_stream_free(BufferedFileStream* stream) {
 }
 
 static bool buffered_file_stream_eof(BufferedFileStream* stream) {
-    bool ret;
-    const bool file_stream_eof = stream_eof(stream->file_stream);
-    const bool cache_at_end = stream_cache_at_end(stream->cache);
-    if(!stream->sync_pending) {
-        ret = file_stream_eof && cache_at_end;
-    } else {
-        const size_t remaining_size =
-            stream_size(stream->file_stream) - stream_tell(stream->file_stream);
-        ret = stream_cache_size(stream->cache) >=
-              (remaining_size ? cache_at_end : file_stream_eof);
-    }
-    return ret;
+    return stream->position >= stream->size;
 }
 
 static void buffered_file_stream_clean(BufferedFileStream* stream) {
     // Not syncing because data will be deleted anyway
-    stream->sync_pending = false;
     stream_cache_drop(stream->cache);
     stream_clean(stream->file_stream);
+    stream->position = 0;
+    stream->size = 0;
 }
 
+// Same bounds as the file stream seek, but no file access: the cache is addressed by position
 static bool buffered_file_stream_seek(
     BufferedFileStream* stream,
     int32_t offset,
     StreamOffset offset_type) {
-    bool success = true;
-    int32_t new_offset = offset;
-
-    if(offset_type == StreamOffsetFromCurrent) {
-        new_offset -= stream_cache_seek(stream->cache, offset);
-        if(new_offset < 0) {
-            new_offset -= (int32_t)stream_cache_size(stream->cache);
+    bool result = false;
+    size_t seek_position = 0;
+
+    switch(offset_type) {
+    case StreamOffsetFromCurrent: {
+        if((int32_t)(stream->position + offset) >= 0) {
+            seek_position = stream->position + offset;
+            result = true;
         }
-    }
-
-    if((new_offset != 0) || (offset_type != StreamOffsetFromCurrent)) {
-        if(stream->sync_pending) {
-            success = buffered_file_stream_sync((Stream*)stream);
-        } else {
-            stream_cache_drop(stream->cache);
+    } break;
+    case StreamOffsetFromStart: {
+        if(offset >= 0) {
+            seek_position = offset;
+            result = true;
         }
-        if(success) {
-            success = stream_seek(stream->file_stream, new_offset, offset_type);
+    } break;
+    case StreamOffsetFromEnd: {
+        if((int32_t)(stream->size + offset) >= 0) {
+            seek_position = stream->size + offset;
+            result = true;
         }
+    } break;
     }
 
-    return success;
+    if(result && seek_position > stream->size) {
+        seek_position = stream->size;
+        result = false;
+    }
+
+    stream->position = seek_position;
+    return result;
 }
 
 static size_t buffered_file_stream_tell(BufferedFileStream* stream) {
-    size_t pos = stream_tell(stream->file_stream) + stream_cache_pos(stream->cache);
-    if(!stream->sync_pending) {
-        pos -= stream_cache_size(stream->cache);
-    }
-    return pos;
+    return stream->position;
 }
 
 static size_t buffered_file_stream_size(BufferedFileStream* stream) {
-    size_t size = stream_size(stream->file_stream);
-    if(stream->sync_pending) {
-        const size_t remaining_size = size - stream_tell(stream->file_stream);
-        const size_t cache_size = stream_cache_size(stream->cache);
-        if(cache_size > remaining_size) {
-            size += (cache_size - remaining_size);
-        }
-    }
-    return size;
+    return stream->size;
 }
 
 static size_t
     buffered_file_stream_write(BufferedFileStream* stream, const uint8_t* data, size_t size) {
-    size_t need_to_write = size;
-    do {
-        if(!stream->sync_pending) {
-            if(!buffered_file_stream_unread(stream)) break;
-        }
-        while(need_to_write) {
-            stream->sync_pending = true;
-            need_to_write -=
-                stream_cache_write(stream->cache, data + (size - need_to_write), need_to_write);
-            if(need_to_write) {
-                stream->sync_pending = false;
-                if(!stream_cache_flush(stream->cache, stream->file_stream)) break;
-            }
-        }
-    } while(false);
-    return size - need_to_write;
+    const size_t size_written =
+        stream_cache_write(stream->cache, stream->file_stream, stream->position, data, size);
+    stream->position += size_written;
+    stream->size = MAX(stream->size, stream->position);
+    return size_written;
 }
 
 static size_t buffered_file_stream_read(BufferedFileStream* stream, uint8_t* data, size_t size) {
-    size_t need_to_read = size;
-    while(need_to_read) {
-        need_to_read -=
-            stream_cache_read(stream->cache, data + (size - need_to_read), need_to_read);
-        if(need_to_read) {
-            if(stream->sync_pending) {
-                if(!buffered_file_stream_flush(stream)) break;
-            }
-            if(!stream_cache_fill(stream->cache, stream->file_stream)) break;
-        }
-    }
-    return size - need_to_read;
+    const size_t size_read =
+        stream_cache_read(stream->cache, stream->file_stream, stream->position, data, size);
+    stream->position += size_read;
+    return size_read;
 }
 
 static bool buffered_file_stream_delete_and_insert(
@@ -213,41 +210,20 @@ static bool buffered_file_stream_delete_and_insert(
     const void* ctx) {
     bool success = false;
     do {
-        if(!(stream->sync_pending ? buffered_file_stream_flush(stream) :
-                                    buffered_file_stream_unread(stream)))
-            break;
-        if(!stream_delete_and_insert(stream->file_stream, delete_size, write_callback, ctx)) break;
-        success = true;
-    } while(false);
-    return success;
-}
-
-// Write the cache into the underlying stream and adjust seek position
-static bool buffered_file_stream_flush(BufferedFileStream* stream) {
-    bool success = false;
-    do {
-        const int32_t offset = stream_cache_size(stream->cache) - stream_cache_pos(stream->cache);
         if(!stream_cache_flush(stream->cache, stream->file_stream)) break;
-        if(offset > 0) {
-            if(!stream_seek(stream->file_stream, -offset, StreamOffsetFromCurrent)) break;
-        }
+        if(!stream_seek(stream->file_stream, stream->position, StreamOffsetFromStart)) break;
+        stream_cache_drop(stream->cache);
+        if(!stream_delete_and_insert(stream->file_stream, delete_size, write_callback, ctx)) break;
         success = true;
     } while(false);
-    stream->sync_pending = false;
+    // File contents moved, cached blocks are stale
+    stream_cache_drop(stream->cache);
+    buffered_file_stream_reload(stream);
     return success;
 }
 
-// Drop read cache and adjust the underlying stream seek position
-static bool buffered_file_stream_unread(BufferedFileStream* stream) {
-    bool success = true;
-    const size_t cache_size = stream_cache_size(stream->cache);
-    if(cache_size > 0) {
-        const size_t cache_pos = stream_cache_pos(stream->cache);
-        if(cache_pos < cache_size) {
-            const int32_t offset = cache_size - cache_pos;
-            success = stream_seek(stream->file_stream, -offset, StreamOffsetFromCurrent);
-        }
-        stream_cache_drop(stream->cache);
-    }
-    return success;
+// Take position and size from the underlying file
+static void buffered_file_stream_reload(BufferedFileStream* stream) {
+    stream->position = stream_tell(stream->file_stream);
+    stream->size = stream_size(stream->file_stream);
 }
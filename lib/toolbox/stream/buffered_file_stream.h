@@ -7,12 +7,31 @@
 extern "C" {
 #endif
 
+/** Buffered file stream cache counters */
+typedef struct {
+    uint32_t hits; /**< Block lookups served from the cache */
+    uint32_t misses; /**< Blocks loaded from the file */
+    uint32_t flushes; /**< Dirty blocks written back to the file */
+} StreamCacheStats;
+
 /**
  * Allocate a file stream with buffered read operations
+ * Uses the default cache of two 512 byte blocks, see buffered_file_stream_alloc_ex
  * @return Stream*
  */
 Stream* buffered_file_stream_alloc(Storage* storage);
 
+/**
+ * Allocate a file stream with a custom cache
+ * Reads and writes go through block_count blocks of block_size bytes, least
+ * recently used block is evicted.
+ * @param storage pointer to a Storage instance
+ * @param block_size cache block size in bytes
+ * @param block_count number of cache blocks
+ * @return Stream*
+ */
+Stream* buffered_file_stream_alloc_ex(Storage* storage, size_t block_size, size_t block_count);
+
 /**
  * Opens an existing file or creates a new one.
  * @param stream pointer to file stream object.
@@ -48,6 +67,19 @@ bool buffered_file_stream_sync(Stream* stream);
  */
 FS_Error buffered_file_stream_get_error(Stream* stream);
 
+/**
+ * Get cache hit, miss and flush counters
+ * @param stream pointer to file stream object.
+ * @param stats pointer to a StreamCacheStats to fill
+ */
+void buffered_file_stream_get_cache_stats(Stream* stream, StreamCacheStats* stats);
+
+/**
+ * Reset cache counters
+ * @param stream pointer to file stream object.
+ */
+void buffered_file_stream_reset_cache_stats(Stream* stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,92 +1,203 @@
 #include "stream_cache.h"
 
-#define STREAM_CACHE_MAX_SIZE 1024U
+typedef struct {
+    uint8_t* data;
+    size_t offset;
+    size_t size;
+    uint32_t last_used;
+    bool loaded;
+    bool dirty;
+} StreamCacheBlock;
 
 struct StreamCache {
-    uint8_t data[STREAM_CACHE_MAX_SIZE];
-    size_t data_size;
-    size_t position;
+    StreamCacheBlock* blocks;
+    uint8_t* data;
+    size_t block_size;
+    size_t block_count;
+    uint32_t use_counter;
+    StreamCacheStats stats;
 };
 
-StreamCache* stream_cache_alloc(void) {
+StreamCache* stream_cache_alloc(size_t block_size, size_t block_count) {
+    furi_check(block_size > 0);
+    furi_check(block_count > 0);
+
     StreamCache* cache = malloc(sizeof(StreamCache));
-    cache->data_size = 0;
-    cache->position = 0;
+    cache->block_size = block_size;
+    cache->block_count = block_count;
+    cache->blocks = malloc(sizeof(StreamCacheBlock) * block_count);
+    cache->data = malloc(block_size * block_count);
+
+    for(size_t i = 0; i < block_count; i++) {
+        cache->blocks[i].data = cache->data + i * block_size;
+    }
+
+    stream_cache_drop(cache);
     return cache;
 }
+
 void stream_cache_free(StreamCache* cache) {
     furi_assert(cache);
-    cache->data_size = 0;
-    cache->position = 0;
+    free(cache->data);
+    free(cache->blocks);
     free(cache);
 }
 
 void stream_cache_drop(StreamCache* cache) {
-    cache->data_size = 0;
-    cache->position = 0;
+    furi_assert(cache);
+    for(size_t i = 0; i < cache->block_count; i++) {
+        cache->blocks[i].loaded = false;
+        cache->blocks[i].dirty = false;
+        cache->blocks[i].size = 0;
+    }
 }
 
-bool stream_cache_at_end(StreamCache* cache) {
-    furi_assert(cache->data_size >= cache->position);
-    return cache->data_size == cache->position;
+static StreamCacheBlock* stream_cache_find(StreamCache* cache, size_t offset) {
+    for(size_t i = 0; i < cache->block_count; i++) {
+        StreamCacheBlock* block = &cache->blocks[i];
+        if(block->loaded && block->offset == offset) return block;
+    }
+    return NULL;
 }
 
-size_t stream_cache_size(StreamCache* cache) {
-    return cache->data_size;
+static void stream_cache_touch(StreamCache* cache, StreamCacheBlock* block) {
+    block->last_used = ++cache->use_counter;
 }
 
-size_t stream_cache_pos(StreamCache* cache) {
-    return cache->position;
+static StreamCacheBlock* stream_cache_get_victim(StreamCache* cache) {
+    StreamCacheBlock* victim = &cache->blocks[0];
+    for(size_t i = 0; i < cache->block_count; i++) {
+        StreamCacheBlock* block = &cache->blocks[i];
+        if(!block->loaded) return block;
+        // Wrap-safe age comparison
+        if((int32_t)(block->last_used - victim->last_used) < 0) victim = block;
+    }
+    return victim;
 }
 
-size_t stream_cache_fill(StreamCache* cache, Stream* stream) {
-    const size_t size_read = stream_read(stream, cache->data, STREAM_CACHE_MAX_SIZE);
-    cache->data_size = size_read;
-    cache->position = 0;
-    return size_read;
+static bool stream_cache_load(
+    StreamCache* cache,
+    Stream* stream,
+    StreamCacheBlock* block,
+    size_t offset) {
+    block->loaded = false;
+    block->dirty = false;
+    block->offset = offset;
+    block->size = 0;
+
+    // Blocks past the end of the stream are empty, do not seek there
+    if(offset < stream_size(stream)) {
+        if(!stream_seek(stream, offset, StreamOffsetFromStart)) return false;
+        block->size = stream_read(stream, block->data, cache->block_size);
+    }
+
+    block->loaded = true;
+    cache->stats.misses++;
+    stream_cache_touch(cache, block);
+    return true;
 }
 
-bool stream_cache_flush(StreamCache* cache, Stream* stream) {
-    const size_t size_written = stream_write(stream, cache->data, cache->data_size);
-    const bool success = (size_written == cache->data_size);
-    cache->data_size = 0;
-    cache->position = 0;
-    return success;
+static StreamCacheBlock* stream_cache_get(StreamCache* cache, Stream* stream, size_t position) {
+    const size_t offset = position - (position % cache->block_size);
+    StreamCacheBlock* block = stream_cache_find(cache, offset);
+
+    if(block) {
+        cache->stats.hits++;
+        stream_cache_touch(cache, block);
+        return block;
+    }
+
+    block = stream_cache_get_victim(cache);
+    // Flush everything, dirty blocks may depend on each other to be contiguous
+    if(block->dirty && !stream_cache_flush(cache, stream)) return NULL;
+    if(!stream_cache_load(cache, stream, block, offset)) return NULL;
+
+    return block;
 }
 
-size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size) {
-    furi_assert(cache->data_size >= cache->position);
-    const size_t size_read = MIN(size, cache->data_size - cache->position);
-    if(size_read > 0) {
-        memcpy(data, cache->data + cache->position, size_read);
-        cache->position += size_read;
+size_t stream_cache_read(
+    StreamCache* cache,
+    Stream* stream,
+    size_t position,
+    uint8_t* data,
+    size_t size) {
+    furi_assert(cache);
+    size_t size_read = 0;
+
+    while(size_read < size) {
+        StreamCacheBlock* block = stream_cache_get(cache, stream, position + size_read);
+        if(!block) break;
+
+        const size_t block_position = position + size_read - block->offset;
+        if(block_position >= block->size) break;
+
+        const size_t chunk = MIN(size - size_read, block->size - block_position);
+        memcpy(data + size_read, block->data + block_position, chunk);
+        size_read += chunk;
     }
+
     return size_read;
 }
 
-size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size) {
-    furi_assert(cache->data_size >= cache->position);
-    const size_t size_written = MIN(size, STREAM_CACHE_MAX_SIZE - cache->position);
-    if(size_written > 0) {
-        memcpy(cache->data + cache->position, data, size_written);
-        cache->position += size_written;
-        if(cache->position > cache->data_size) {
-            cache->data_size = cache->position;
-        }
+size_t stream_cache_write(
+    StreamCache* cache,
+    Stream* stream,
+    size_t position,
+    const uint8_t* data,
+    size_t size) {
+    furi_assert(cache);
+    size_t size_written = 0;
+
+    while(size_written < size) {
+        StreamCacheBlock* block = stream_cache_get(cache, stream, position + size_written);
+        if(!block) break;
+
+        // Writing past the end of the block data would leave a hole
+        const size_t block_position = position + size_written - block->offset;
+        if(block_position > block->size) break;
+
+        const size_t chunk = MIN(size - size_written, cache->block_size - block_position);
+        memcpy(block->data + block_position, data + size_written, chunk);
+        block->size = MAX(block->size, block_position + chunk);
+        block->dirty = true;
+        size_written += chunk;
     }
+
     return size_written;
 }
 
-int32_t stream_cache_seek(StreamCache* cache, int32_t offset) {
-    furi_assert(cache->data_size >= cache->position);
-    int32_t actual_offset = 0;
+bool stream_cache_flush(StreamCache* cache, Stream* stream) {
+    furi_assert(cache);
+    bool success = true;
 
-    if(offset > 0) {
-        actual_offset = MIN(cache->data_size - cache->position, (size_t)offset);
-    } else if(offset < 0) {
-        actual_offset = MAX(-((int32_t)cache->position), offset);
+    while(success) {
+        StreamCacheBlock* first = NULL;
+        for(size_t i = 0; i < cache->block_count; i++) {
+            StreamCacheBlock* block = &cache->blocks[i];
+            if(block->dirty && (!first || block->offset < first->offset)) first = block;
+        }
+        if(!first) break;
+
+        success = stream_seek(stream, first->offset, StreamOffsetFromStart) &&
+                  (stream_write(stream, first->data, first->size) == first->size);
+        first->dirty = false;
+        if(!success) {
+            // Data is lost anyway, do not serve it from the cache
+            first->loaded = false;
+        }
+        cache->stats.flushes++;
     }
 
-    cache->position += actual_offset;
-    return actual_offset;
+    return success;
+}
+
+void stream_cache_get_stats(StreamCache* cache, StreamCacheStats* stats) {
+    furi_assert(cache);
+    furi_assert(stats);
+    *stats = cache->stats;
+}
+
+void stream_cache_reset_stats(StreamCache* cache) {
+    furi_assert(cache);
+    memset(&cache->stats, 0, sizeof(StreamCacheStats));
 }
@@ -1,18 +1,27 @@
 #pragma once
 
 #include "stream.h"
+#include "buffered_file_stream.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// 1 KiB in total, a line read across a block boundary can seek back without a reload
+#define STREAM_CACHE_DEFAULT_BLOCK_SIZE  512U
+#define STREAM_CACHE_DEFAULT_BLOCK_COUNT 2U
+
 typedef struct StreamCache StreamCache;
 
 /**
  * Allocate stream cache.
+ * The cache holds block_count blocks of block_size bytes each, aligned to
+ * block_size in the stream, and evicts the least recently used block.
+ * @param block_size Size of a cache block in bytes
+ * @param block_count Number of cache blocks
  * @return StreamCache* pointer to a StreamCache instance
  */
-StreamCache* stream_cache_alloc(void);
+StreamCache* stream_cache_alloc(size_t block_size, size_t block_count);
 
 /**
  * Free stream cache.
@@ -21,73 +30,65 @@ StreamCache* stream_cache_alloc(void);
 void stream_cache_free(StreamCache* cache);
 
 /**
- * Drop the cache contents and set it to initial state.
+ * Drop the cache contents, dirty blocks included, and set it to initial state.
+ * Counters are kept.
  * @param cache Pointer to a StreamCache instance
  */
 void stream_cache_drop(StreamCache* cache);
 
 /**
- * Determine if the internal cursor is at end the end of cached data.
- * @param cache Pointer to a StreamCache instance
- * @return True if cursor is at end, otherwise false.
- */
-bool stream_cache_at_end(StreamCache* cache);
-
-/**
- * Get the current size of cached data.
+ * Read data through the cache, loading missing blocks from a stream.
  * @param cache Pointer to a StreamCache instance
- * @return Size of cached data.
- */
-size_t stream_cache_size(StreamCache* cache);
-
-/**
- * Get the internal cursor position.
- * @param cache Pointer to a StreamCache instance
- * @return Cursor position inside the cache.
+ * @param stream Pointer to the underlying Stream instance
+ * @param position Position in the stream to read from
+ * @param data Pointer to a data buffer. Must be initialized.
+ * @param size Maximum size in bytes to read.
+ * @return Actual size that was read, less than size at the end of data.
  */
-size_t stream_cache_pos(StreamCache* cache);
+size_t stream_cache_read(
+    StreamCache* cache,
+    Stream* stream,
+    size_t position,
+    uint8_t* data,
+    size_t size);
 
 /**
- * Load the cache with new data from a stream.
+ * Write data to the cache, the stream is only written when dirty blocks are flushed.
  * @param cache Pointer to a StreamCache instance
- * @param stream Pointer to a Stream instance
- * @return Size of newly cached data.
+ * @param stream Pointer to the underlying Stream instance
+ * @param position Position in the stream to write to, not past the end of data
+ * @param data Pointer to a data buffer.
+ * @param size Size in bytes to write.
+ * @return Actual size that was written.
  */
-size_t stream_cache_fill(StreamCache* cache, Stream* stream);
+size_t stream_cache_write(
+    StreamCache* cache,
+    Stream* stream,
+    size_t position,
+    const uint8_t* data,
+    size_t size);
 
 /**
- * Write as much cached data as possible to a stream.
+ * Write all dirty blocks to a stream, in stream order.
+ * The stream position is left undefined.
  * @param cache Pointer to a StreamCache instance
- * @param stream Pointer to a Stream instance
+ * @param stream Pointer to the underlying Stream instance
  * @return True on success, False on failure.
  */
 bool stream_cache_flush(StreamCache* cache, Stream* stream);
 
 /**
- * Read cached data and advance the internal cursor.
- * @param cache Pointer to a StreamCache instance.
- * @param data Pointer to a data buffer. Must be initialized.
- * @param size Maximum size in bytes to read from the cache.
- * @return Actual size that was read.
- */
-size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size);
-
-/**
- * Write to cached data and advance the internal cursor.
- * @param cache Pointer to a StreamCache instance.
- * @param data Pointer to a data buffer.
- * @param size Maximum size in bytes to write to the cache.
- * @return Actual size that was written.
+ * Get the cache counters.
+ * @param cache Pointer to a StreamCache instance
+ * @param stats Pointer to a StreamCacheStats to fill
  */
-size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size);
+void stream_cache_get_stats(StreamCache* cache, StreamCacheStats* stats);
 
 /**
- * Move the internal cursor relatively to its current position.
- * @param cache Pointer to a StreamCache instance.
- * @param offset Cursor offset.
- * @return Actual cursor offset. Equal to offset parameter on hit.
+ * Reset the cache counters.
+ * @param cache Pointer to a StreamCache instance
  */
-int32_t stream_cache_seek(StreamCache* cache, int32_t offset);
+void stream_cache_reset_stats(StreamCache* cache);
 
 #ifdef __cplusplus
 }
@@ -138,6 +138,24 @@
 */
 #define U8G2_WITH_UNICODE
 
+/*
+  The following macro enables the diff buffer for u8g2_SendBuffer.
+  If a diff buffer is assigned with u8g2_SetDiffBuffer, it keeps a copy of what was sent
+  to the display and u8g2_SendBuffer will only send the changed tile range of each tile row.
+  Only available in full buffer mode.
+*/
+#define U8G2_WITH_DIFF_BUFFER
+
+/*
+  The following macro enables the glyph cache, which consumes about 1.6 KB RAM in u8g2_t.
+  For the last U8G2_GLYPH_INDEX_FONT_CNT fonts an index of the ASCII glyph positions
+  is built on first use, so the font data is not scanned for every glyph.
+  Decoded bitmaps of up to U8G2_GLYPH_CACHE_CNT glyphs (at most 16x16 pixel) of the current
+  font are kept, so that frequently drawn glyphs are not decompressed again. They are dropped
+  when u8g2_SetFont() selects another font.
+*/
+#define U8G2_WITH_GLYPH_CACHE
+
 /*==========================================*/
 
 #ifdef __GNUC__
@@ -253,6 +271,34 @@ struct _u8g2_font_decode_t {
 };
 typedef struct _u8g2_font_decode_t u8g2_font_decode_t;
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+#define U8G2_GLYPH_INDEX_FONT_CNT 4
+#define U8G2_GLYPH_INDEX_FIRST 32 /* first indexed encoding */
+#define U8G2_GLYPH_INDEX_CNT 96 /* number of indexed encodings, up to 127 */
+#define U8G2_GLYPH_CACHE_CNT 16
+#define U8G2_GLYPH_CACHE_MAX_SIZE 16 /* max width and height of a cached glyph */
+
+struct _u8g2_glyph_index_t {
+    const uint8_t* font; /* NULL if unused */
+    u8g2_font_info_t font_info; /* detects another font loaded to the same address */
+    /* offset of the glyph in the font, 0: no glyph, 0xffff: beyond 64K, search it */
+    uint16_t offset[U8G2_GLYPH_INDEX_CNT];
+};
+typedef struct _u8g2_glyph_index_t u8g2_glyph_index_t;
+
+struct _u8g2_glyph_cache_entry_t {
+    const uint8_t* glyph_data; /* NULL if unused */
+    uint8_t check[2]; /* glyph size and first data byte, detects reloaded fonts */
+    uint8_t glyph_width;
+    uint8_t glyph_height;
+    int8_t x;
+    int8_t y;
+    int8_t delta_x;
+    uint16_t rows[U8G2_GLYPH_CACHE_MAX_SIZE]; /* bit 0 is the leftmost pixel of a row */
+};
+typedef struct _u8g2_glyph_cache_entry_t u8g2_glyph_cache_entry_t;
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 struct _u8g2_kerning_t {
     uint16_t first_table_cnt;
     uint16_t second_table_cnt;
@@ -271,6 +317,17 @@ struct u8g2_cb_struct {
 
 typedef u8g2_uint_t (*u8g2_font_calc_vref_fnptr)(u8g2_t* u8g2);
 
+#ifdef U8G2_WITH_DIFF_BUFFER
+/* frame diff statistics of u8g2_SendBuffer, see u8g2_GetDiffStats */
+typedef struct {
+    uint32_t frames; /* number of u8g2_SendBuffer calls */
+    uint32_t frames_unchanged; /* frames where nothing was sent */
+    uint32_t tile_rows_sent; /* tile rows, which were sent partially or fully */
+    uint32_t bytes_sent; /* tile bytes sent to the display */
+    uint32_t bytes_skipped; /* unchanged tile bytes, which were not sent */
+} u8g2_diff_stats_t;
+#endif /* U8G2_WITH_DIFF_BUFFER */
+
 struct u8g2_struct {
     u8x8_t u8x8;
     u8g2_draw_ll_hvline_cb ll_hvline; /* low level hvline procedure */
@@ -342,6 +399,19 @@ struct u8g2_struct {
     // the following variable should be renamed to is_buffer_auto_clear
     uint8_t
         is_auto_page_clear; /* set to 0 to disable automatic clear of the buffer in firstPage() and nextPage() */
+
+#ifdef U8G2_WITH_DIFF_BUFFER
+    uint8_t* diff_buf_ptr; /* copy of the display memory, same size as tile_buf_ptr, can be NULL */
+    uint8_t is_diff_buf_valid; /* 0 if the display memory may differ from diff_buf_ptr */
+    u8g2_diff_stats_t diff_stats;
+#endif /* U8G2_WITH_DIFF_BUFFER */
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+    u8g2_glyph_index_t* glyph_index; /* index of the current font, NULL until the first lookup */
+    uint8_t glyph_index_next; /* next index to be replaced */
+    u8g2_glyph_index_t glyph_index_list[U8G2_GLYPH_INDEX_FONT_CNT];
+    u8g2_glyph_cache_entry_t glyph_cache[U8G2_GLYPH_CACHE_CNT];
+#endif /* U8G2_WITH_GLYPH_CACHE */
 };
 
 #define u8g2_GetU8x8(u8g2) ((u8x8_t*)(u8g2))
@@ -361,9 +431,17 @@ struct u8g2_struct {
 #define u8g2_SetupDisplay(u8g2, display_cb, cad_cb, byte_cb, gpio_and_delay_cb) \
     u8x8_Setup(u8g2_GetU8x8(u8g2), (display_cb), (cad_cb), (byte_cb), (gpio_and_delay_cb))
 
-#define u8g2_InitDisplay(u8g2)             u8x8_InitDisplay(u8g2_GetU8x8(u8g2))
+#ifdef U8G2_WITH_DIFF_BUFFER
+/* display memory content is unknown after init and flip, so the next u8g2_SendBuffer sends all */
+#define u8g2_InitDisplay(u8g2) \
+    (u8g2_InvalidateDiffBuffer(u8g2), u8x8_InitDisplay(u8g2_GetU8x8(u8g2)))
+#define u8g2_SetFlipMode(u8g2, mode) \
+    (u8g2_InvalidateDiffBuffer(u8g2), u8x8_SetFlipMode(u8g2_GetU8x8(u8g2), (mode)))
+#else
+#define u8g2_InitDisplay(u8g2)       u8x8_InitDisplay(u8g2_GetU8x8(u8g2))
+#define u8g2_SetFlipMode(u8g2, mode) u8x8_SetFlipMode(u8g2_GetU8x8(u8g2), (mode))
+#endif /* U8G2_WITH_DIFF_BUFFER */
 #define u8g2_SetPowerSave(u8g2, is_enable) u8x8_SetPowerSave(u8g2_GetU8x8(u8g2), (is_enable))
-#define u8g2_SetFlipMode(u8g2, mode)       u8x8_SetFlipMode(u8g2_GetU8x8(u8g2), (mode))
 #define u8g2_SetContrast(u8g2, value)      u8x8_SetContrast(u8g2_GetU8x8(u8g2), (value))
 //#define u8g2_ClearDisplay(u8g2) u8x8_ClearDisplay(u8g2_GetU8x8(u8g2))  obsolete, can not be used in all cases
 void u8g2_ClearDisplay(u8g2_t* u8g2);
@@ -3568,6 +3646,15 @@ uint8_t u8g2_NextPage(u8g2_t* u8g2);
 #define u8g2_GetBufferCurrTileRow(u8g2) ((u8g2)->tile_curr_row)
 
 void u8g2_UpdateDisplayArea(u8g2_t* u8g2, uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+
+#ifdef U8G2_WITH_DIFF_BUFFER
+/* buf must be as large as the display buffer, NULL disables the diff buffer */
+void u8g2_SetDiffBuffer(u8g2_t* u8g2, uint8_t* buf);
+void u8g2_ResetDiffStats(u8g2_t* u8g2);
+/* must be called after writing to the display memory other than with u8g2_SendBuffer */
+#define u8g2_InvalidateDiffBuffer(u8g2) ((u8g2)->is_diff_buf_valid = 0)
+#define u8g2_GetDiffStats(u8g2)         (&(u8g2)->diff_stats)
+#endif /* U8G2_WITH_DIFF_BUFFER */
 void u8g2_UpdateDisplay(u8g2_t* u8g2);
 
 void u8g2_WriteBufferPBM(u8g2_t* u8g2, void (*out)(const char* s));
@@ -3738,6 +3825,10 @@ size_t u8g2_GetFontSize(const uint8_t* font_arg);
 #define U8G2_FONT_HEIGHT_MODE_ALL   2
 
 void u8g2_SetFont(u8g2_t* u8g2, const uint8_t* font);
+#ifdef U8G2_WITH_GLYPH_CACHE
+/* only required if the data of the current font changes without another font being set */
+void u8g2_ClearGlyphCache(u8g2_t* u8g2);
+#endif /* U8G2_WITH_GLYPH_CACHE */
 void u8g2_SetFontMode(u8g2_t* u8g2, uint8_t is_transparent);
 
 uint8_t u8g2_IsGlyph(u8g2_t* u8g2, uint16_t requested_encoding);
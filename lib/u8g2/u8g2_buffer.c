@@ -78,6 +78,10 @@ static void u8g2_send_buffer(u8g2_t* u8g2) {
     dest_row = u8g2->tile_curr_row;
     dest_max = u8g2_GetU8x8(u8g2)->display_info->tile_height;
 
+#ifdef U8G2_WITH_DIFF_BUFFER
+    u8g2_InvalidateDiffBuffer(u8g2);
+#endif
+
     do {
         u8g2_send_tile_row(u8g2, src_row, dest_row);
         src_row++;
@@ -85,9 +89,82 @@ static void u8g2_send_buffer(u8g2_t* u8g2) {
     } while(src_row < src_max && dest_row < dest_max);
 }
 
+#ifdef U8G2_WITH_DIFF_BUFFER
+/*
+  write only the changed part of the buffer to the display RAM.
+  For every tile row, the tiles from the first to the last changed one are sent,
+  unchanged tile rows are skipped. Requires full buffer mode.
+*/
+static void u8g2_send_buffer_diff(u8g2_t* u8g2) {
+    u8g2_diff_stats_t* stats = &u8g2->diff_stats;
+    uint8_t* ptr = u8g2->tile_buf_ptr;
+    uint8_t* diff_ptr = u8g2->diff_buf_ptr;
+    uint16_t row_size;
+    uint16_t first;
+    uint16_t last;
+    uint8_t row;
+    uint8_t tx;
+    uint8_t tw;
+    uint8_t is_changed = 0;
+
+    tw = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+    row_size = tw * 8;
+
+    for(row = 0; row < u8g2->tile_buf_height; row++) {
+        tx = 0;
+        tw = row_size / 8;
+        if(u8g2->is_diff_buf_valid) {
+            first = 0;
+            while(first < row_size && ptr[first] == diff_ptr[first]) first++;
+            if(first == row_size) {
+                stats->bytes_skipped += row_size;
+                ptr += row_size;
+                diff_ptr += row_size;
+                continue;
+            }
+            last = row_size - 1;
+            while(ptr[last] == diff_ptr[last]) last--;
+            tx = first / 8;
+            tw = last / 8 - tx + 1;
+        }
+
+        u8x8_DrawTile(u8g2_GetU8x8(u8g2), tx, row, tw, ptr + tx * 8);
+        memcpy(diff_ptr + tx * 8, ptr + tx * 8, tw * 8);
+        is_changed = 1;
+        stats->tile_rows_sent++;
+        stats->bytes_sent += tw * 8;
+        stats->bytes_skipped += row_size - tw * 8;
+        ptr += row_size;
+        diff_ptr += row_size;
+    }
+
+    u8g2->is_diff_buf_valid = 1;
+    stats->frames++;
+    if(!is_changed) stats->frames_unchanged++;
+}
+
+void u8g2_SetDiffBuffer(u8g2_t* u8g2, uint8_t* buf) {
+    u8g2->diff_buf_ptr = buf;
+    u8g2_InvalidateDiffBuffer(u8g2);
+}
+
+void u8g2_ResetDiffStats(u8g2_t* u8g2) {
+    memset(&u8g2->diff_stats, 0, sizeof(u8g2->diff_stats));
+}
+#endif /* U8G2_WITH_DIFF_BUFFER */
+
 /* same as u8g2_send_buffer but also send the DISPLAY_REFRESH message (used by SSD1606) */
 void u8g2_SendBuffer(u8g2_t* u8g2) {
-    u8g2_send_buffer(u8g2);
+#ifdef U8G2_WITH_DIFF_BUFFER
+    /* the diff buffer mirrors the whole display, so it only works in full buffer mode */
+    if(u8g2->diff_buf_ptr != NULL &&
+       u8g2->tile_buf_height == u8g2_GetU8x8(u8g2)->display_info->tile_height) {
+        u8g2_send_buffer_diff(u8g2);
+    } else
+#endif /* U8G2_WITH_DIFF_BUFFER */
+    {
+        u8g2_send_buffer(u8g2);
+    }
     u8x8_RefreshDisplay(u8g2_GetU8x8(u8g2));
 }
 
@@ -151,6 +228,10 @@ void u8g2_UpdateDisplayArea(u8g2_t* u8g2, uint8_t tx, uint8_t ty, uint8_t tw, ui
     ptr += tx * 8;
     ptr += page_size * ty;
 
+#ifdef U8G2_WITH_DIFF_BUFFER
+    u8g2_InvalidateDiffBuffer(u8g2);
+#endif
+
     while(th > 0) {
         u8x8_DrawTile(u8g2_GetU8x8(u8g2), tx, ty, tw, ptr);
         ptr += page_size;
@@ -34,6 +34,7 @@
 */
 
 #include "u8g2.h"
+#include <string.h>
 
 /* size of the font data structure, there is no struct or class... */
 /* this is the size for the new font format */
@@ -369,6 +370,65 @@ void u8g2_add_vector(u8g2_uint_t *xp, u8g2_uint_t *yp, int8_t x, int8_t y, uint8
   Called by:
     u8g2_font_decode_glyph()
 */
+/* draw a run of current pixels of a glyph, starting at local position lx, ly */
+static void u8g2_font_draw_run(
+    u8g2_t* u8g2,
+    uint8_t lx,
+    uint8_t ly,
+    uint8_t current,
+    uint8_t is_foreground) {
+    /* target position on the screen */
+    u8g2_uint_t x, y;
+
+    u8g2_font_decode_t* decode = &(u8g2->font_decode);
+
+    /* get target position */
+    x = decode->target_x;
+    y = decode->target_y;
+
+    /* apply rotation */
+#ifdef U8G2_WITH_FONT_ROTATION
+
+    x = u8g2_add_vector_x(x, lx, ly, decode->dir);
+    y = u8g2_add_vector_y(y, lx, ly, decode->dir);
+
+    //u8g2_add_vector(&x, &y, lx, ly, decode->dir);
+
+#else
+    x += lx;
+    y += ly;
+#endif
+
+    /* draw foreground and background (if required) */
+    if(is_foreground) {
+        u8g2->draw_color = decode->fg_color; /* draw_color will be restored later */
+        u8g2_DrawHVLine(
+            u8g2,
+            x,
+            y,
+            current,
+#ifdef U8G2_WITH_FONT_ROTATION
+            /* dir */ decode->dir
+#else
+            0
+#endif
+        );
+    } else if(decode->is_transparent == 0) {
+        u8g2->draw_color = decode->bg_color; /* draw_color will be restored later */
+        u8g2_DrawHVLine(
+            u8g2,
+            x,
+            y,
+            current,
+#ifdef U8G2_WITH_FONT_ROTATION
+            /* dir */ decode->dir
+#else
+            0
+#endif
+        );
+    }
+}
+
 /* optimized */
 void u8g2_font_decode_len(u8g2_t* u8g2, uint8_t len, uint8_t is_foreground) {
     uint8_t cnt; /* total number of remaining pixels, which have to be drawn */
@@ -379,9 +439,6 @@ void u8g2_font_decode_len(u8g2_t* u8g2, uint8_t len, uint8_t is_foreground) {
     /* local coordinates of the glyph */
     uint8_t lx, ly;
 
-    /* target position on the screen */
-    u8g2_uint_t x, y;
-
     u8g2_font_decode_t* decode = &(u8g2->font_decode);
 
     cnt = len;
@@ -402,52 +459,7 @@ void u8g2_font_decode_len(u8g2_t* u8g2, uint8_t len, uint8_t is_foreground) {
 
         /* now draw the line, but apply the rotation around the glyph target position */
         //u8g2_font_decode_draw_pixel(u8g2, lx,ly,current, is_foreground);
-
-        /* get target position */
-        x = decode->target_x;
-        y = decode->target_y;
-
-        /* apply rotation */
-#ifdef U8G2_WITH_FONT_ROTATION
-
-        x = u8g2_add_vector_x(x, lx, ly, decode->dir);
-        y = u8g2_add_vector_y(y, lx, ly, decode->dir);
-
-        //u8g2_add_vector(&x, &y, lx, ly, decode->dir);
-
-#else
-        x += lx;
-        y += ly;
-#endif
-
-        /* draw foreground and background (if required) */
-        if(is_foreground) {
-            u8g2->draw_color = decode->fg_color; /* draw_color will be restored later */
-            u8g2_DrawHVLine(
-                u8g2,
-                x,
-                y,
-                current,
-#ifdef U8G2_WITH_FONT_ROTATION
-                /* dir */ decode->dir
-#else
-                0
-#endif
-            );
-        } else if(decode->is_transparent == 0) {
-            u8g2->draw_color = decode->bg_color; /* draw_color will be restored later */
-            u8g2_DrawHVLine(
-                u8g2,
-                x,
-                y,
-                current,
-#ifdef U8G2_WITH_FONT_ROTATION
-                /* dir */ decode->dir
-#else
-                0
-#endif
-            );
-        }
+        u8g2_font_draw_run(u8g2, lx, ly, current, is_foreground);
 
         /* check, whether the end of the run length code has been reached */
         if(cnt < rem) break;
@@ -481,6 +493,183 @@ static void u8g2_font_setup_decode(u8g2_t* u8g2, const uint8_t* glyph_data) {
     decode->bg_color = (decode->fg_color == 0 ? 1 : 0);
 }
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+/*========================================================================*/
+/* glyph cache */
+
+void u8g2_ClearGlyphCache(u8g2_t* u8g2) {
+    memset(u8g2->glyph_index_list, 0, sizeof(u8g2->glyph_index_list));
+    memset(u8g2->glyph_cache, 0, sizeof(u8g2->glyph_cache));
+    u8g2->glyph_index = NULL;
+    u8g2->glyph_index_next = 0;
+}
+
+/*
+  Decoded bitmaps depend on the font info and data of the current font, a glyph of
+  another font or of a font reloaded at the same address must not be taken from them.
+  Positions in the index are checked against the font info, they are kept.
+*/
+static void u8g2_glyph_cache_invalidate(u8g2_t* u8g2) {
+    uint8_t i;
+    for(i = 0; i < U8G2_GLYPH_CACHE_CNT; i++) {
+        u8g2->glyph_cache[i].glyph_data = NULL;
+    }
+}
+
+/* walk once through the ASCII glyphs of the current font and note their offsets */
+static void u8g2_glyph_index_build(u8g2_t* u8g2, u8g2_glyph_index_t* index) {
+    const uint8_t* font = u8g2->font + U8G2_FONT_DATA_STRUCT_SIZE;
+    uint16_t encoding;
+    size_t offset;
+
+    index->font = u8g2->font;
+    index->font_info = u8g2->font_info;
+    memset(index->offset, 0, sizeof(index->offset));
+
+    for(;;) {
+        if(u8x8_pgm_read(font + 1) == 0) break;
+        encoding = u8x8_pgm_read(font);
+        if(encoding >= U8G2_GLYPH_INDEX_FIRST &&
+           encoding < U8G2_GLYPH_INDEX_FIRST + U8G2_GLYPH_INDEX_CNT) {
+            offset = font - u8g2->font;
+            index->offset[encoding - U8G2_GLYPH_INDEX_FIRST] = offset < 0xffff ? offset : 0xffff;
+        }
+        font += u8x8_pgm_read(font + 1);
+    }
+}
+
+static u8g2_glyph_index_t* u8g2_glyph_index_get(u8g2_t* u8g2) {
+    u8g2_glyph_index_t* index;
+    uint8_t i;
+
+    if(u8g2->glyph_index != NULL) return u8g2->glyph_index;
+
+    for(i = 0; i < U8G2_GLYPH_INDEX_FONT_CNT; i++) {
+        index = &u8g2->glyph_index_list[i];
+        if(index->font == u8g2->font &&
+           memcmp(&index->font_info, &u8g2->font_info, sizeof(u8g2_font_info_t)) == 0) {
+            u8g2->glyph_index = index;
+            return index;
+        }
+    }
+
+    /* fonts are usually switched back and forth, replace the oldest index */
+    index = &u8g2->glyph_index_list[u8g2->glyph_index_next];
+    u8g2->glyph_index_next = (u8g2->glyph_index_next + 1) % U8G2_GLYPH_INDEX_FONT_CNT;
+    u8g2_glyph_index_build(u8g2, index);
+    u8g2->glyph_index = index;
+    return index;
+}
+
+/* same as u8g2_font_decode_len, but sets the foreground pixels in the cache entry */
+static void u8g2_glyph_cache_decode_len(
+    u8g2_glyph_cache_entry_t* entry,
+    uint8_t* lx,
+    uint8_t* ly,
+    uint8_t len,
+    uint8_t is_foreground) {
+    uint8_t cnt = len;
+    uint8_t rem;
+    uint8_t current;
+
+    for(;;) {
+        rem = entry->glyph_width;
+        rem -= *lx;
+        current = rem;
+        if(cnt < rem) current = cnt;
+
+        if(is_foreground && *ly < entry->glyph_height) {
+            entry->rows[*ly] |= ((1UL << current) - 1) << *lx;
+        }
+
+        if(cnt < rem) break;
+        cnt -= rem;
+        *lx = 0;
+        (*ly)++;
+    }
+    *lx += cnt;
+}
+
+/*
+  Returns the cache entry with the decoded glyph, decodes it if required.
+  NULL if the glyph is too large for the cache.
+*/
+static const u8g2_glyph_cache_entry_t*
+    u8g2_glyph_cache_get(u8g2_t* u8g2, const uint8_t* glyph_data) {
+    u8g2_glyph_cache_entry_t* entry;
+    u8g2_font_decode_t* decode = &(u8g2->font_decode);
+    uint8_t check[2];
+    uint8_t a, b;
+    uint8_t lx, ly;
+
+    check[0] = u8x8_pgm_read(glyph_data - 1);
+    check[1] = u8x8_pgm_read(glyph_data);
+
+    /* multiplicative hash, glyphs of even size would leave half of the slots unused otherwise */
+    entry = &u8g2->glyph_cache
+                 [(((uint32_t)(uintptr_t)glyph_data * 2654435761UL) >> 16) % U8G2_GLYPH_CACHE_CNT];
+    if(entry->glyph_data == glyph_data && memcmp(entry->check, check, sizeof(check)) == 0) {
+        return entry;
+    }
+
+    entry->glyph_data = NULL;
+    u8g2_font_setup_decode(u8g2, glyph_data);
+    if(decode->glyph_width > U8G2_GLYPH_CACHE_MAX_SIZE ||
+       decode->glyph_height > U8G2_GLYPH_CACHE_MAX_SIZE) {
+        return NULL;
+    }
+
+    entry->glyph_width = decode->glyph_width;
+    entry->glyph_height = decode->glyph_height;
+    entry->x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
+    entry->y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
+    entry->delta_x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
+    memset(entry->rows, 0, sizeof(entry->rows));
+
+    if(entry->glyph_width > 0) {
+        lx = 0;
+        ly = 0;
+        for(;;) {
+            a = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_0);
+            b = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_1);
+            do {
+                u8g2_glyph_cache_decode_len(entry, &lx, &ly, a, 0);
+                u8g2_glyph_cache_decode_len(entry, &lx, &ly, b, 1);
+            } while(u8g2_font_decode_get_unsigned_bits(decode, 1) != 0);
+
+            if(ly >= entry->glyph_height) break;
+        }
+    }
+
+    entry->glyph_data = glyph_data;
+    memcpy(entry->check, check, sizeof(check));
+    return entry;
+}
+
+/* draw the glyph from the cache entry, row by row, with the same runs as the decoder */
+static void u8g2_glyph_cache_draw(u8g2_t* u8g2, const u8g2_glyph_cache_entry_t* entry) {
+    uint16_t row;
+    uint8_t lx, ly;
+    uint8_t len;
+    uint8_t is_foreground;
+
+    for(ly = 0; ly < entry->glyph_height; ly++) {
+        row = entry->rows[ly];
+        lx = 0;
+        while(lx < entry->glyph_width) {
+            is_foreground = row & 1;
+            len = 0;
+            do {
+                row >>= 1;
+                len++;
+            } while(lx + len < entry->glyph_width && (row & 1) == is_foreground);
+            u8g2_font_draw_run(u8g2, lx, ly, len, is_foreground);
+            lx += len;
+        }
+    }
+}
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 /*
   Description:
     Decode and draw a glyph.
@@ -501,14 +690,27 @@ int8_t u8g2_font_decode_glyph(u8g2_t* u8g2, const uint8_t* glyph_data) {
     int8_t d;
     int8_t h;
     u8g2_font_decode_t* decode = &(u8g2->font_decode);
-
-    u8g2_font_setup_decode(u8g2, glyph_data);
+#ifdef U8G2_WITH_GLYPH_CACHE
+    const u8g2_glyph_cache_entry_t* entry = u8g2_glyph_cache_get(u8g2, glyph_data);
+
+    if(entry != NULL) {
+        decode->glyph_width = entry->glyph_width;
+        decode->glyph_height = entry->glyph_height;
+        decode->fg_color = u8g2->draw_color;
+        decode->bg_color = (decode->fg_color == 0 ? 1 : 0);
+        x = entry->x;
+        y = entry->y;
+        d = entry->delta_x;
+    } else
+#endif /* U8G2_WITH_GLYPH_CACHE */
+    {
+        u8g2_font_setup_decode(u8g2, glyph_data);
+        x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
+        y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
+        d = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
+    }
     h = u8g2->font_decode.glyph_height;
 
-    x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
-    y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
-    d = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
-
     if(decode->glyph_width > 0) {
 #ifdef U8G2_WITH_FONT_ROTATION
         decode->target_x = u8g2_add_vector_x(decode->target_x, x, -(h + y), decode->dir);
@@ -566,6 +768,14 @@ int8_t u8g2_font_decode_glyph(u8g2_t* u8g2, const uint8_t* glyph_data) {
         }
 #endif /* U8G2_WITH_INTERSECTION */
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+        if(entry != NULL) {
+            u8g2_glyph_cache_draw(u8g2, entry);
+            u8g2->draw_color = decode->fg_color;
+            return d;
+        }
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
         /* reset local x/y position */
         decode->x = 0;
         decode->y = 0;
@@ -601,6 +811,15 @@ const uint8_t* u8g2_font_get_glyph_data(u8g2_t* u8g2, uint16_t encoding) {
     font += U8G2_FONT_DATA_STRUCT_SIZE;
 
     if(encoding <= 255) {
+#ifdef U8G2_WITH_GLYPH_CACHE
+        if(encoding >= U8G2_GLYPH_INDEX_FIRST &&
+           encoding < U8G2_GLYPH_INDEX_FIRST + U8G2_GLYPH_INDEX_CNT) {
+            uint16_t offset =
+                u8g2_glyph_index_get(u8g2)->offset[encoding - U8G2_GLYPH_INDEX_FIRST];
+            if(offset == 0) return NULL;
+            if(offset != 0xffff) return u8g2->font + offset + 2; /* skip encoding and size */
+        }
+#endif /* U8G2_WITH_GLYPH_CACHE */
         if(encoding >= 'a') {
             font += u8g2->font_info.start_pos_lower_a;
         } else if(encoding >= 'A') {
@@ -984,6 +1203,10 @@ void u8g2_SetFont(u8g2_t* u8g2, const uint8_t* font) {
         //#endif
         u8g2->font = font;
         u8g2_read_font_info(&(u8g2->font_info), font);
+#ifdef U8G2_WITH_GLYPH_CACHE
+        u8g2->glyph_index = NULL;
+        u8g2_glyph_cache_invalidate(u8g2);
+#endif
         u8g2_UpdateRefHeight(u8g2);
         /* u8g2_SetFontPosBaseline(u8g2); */ /* removed with issue 195 */
     }
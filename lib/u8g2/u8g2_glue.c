@@ -269,6 +269,8 @@ uint8_t u8x8_d_st756x_flipper(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void*
     return 1;
 }
 
+static uint8_t u8g2_st756x_diff_buf[16 * 8 * 8];
+
 void u8g2_Setup_st756x_flipper(
     u8g2_t* u8g2,
     const u8g2_cb_t* rotation,
@@ -279,4 +281,6 @@ void u8g2_Setup_st756x_flipper(
     u8g2_SetupDisplay(u8g2, u8x8_d_st756x_flipper, u8x8_cad_001, byte_cb, gpio_and_delay_cb);
     buf = u8g2_m_16_8_f(&tile_buf_height);
     u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_vertical_top_lsb, rotation);
+    /* Most frames change only a small part of the screen, send just that */
+    u8g2_SetDiffBuffer(u8g2, u8g2_st756x_diff_buf);
 }
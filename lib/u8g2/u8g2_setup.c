@@ -93,6 +93,16 @@ void u8g2_SetupBuffer(
     u8g2->draw_color = 1;
     u8g2->is_auto_page_clear = 1;
 
+#ifdef U8G2_WITH_DIFF_BUFFER
+    u8g2->diff_buf_ptr = NULL;
+    u8g2->is_diff_buf_valid = 0;
+    u8g2_ResetDiffStats(u8g2);
+#endif
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+    u8g2_ClearGlyphCache(u8g2);
+#endif
+
     u8g2->cb = u8g2_cb;
     u8g2->cb->update_dimension(u8g2);
 #ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
@@ -34,6 +34,8 @@ Other:
         run code formatters
     firmware_pvs:
         generate a PVS-Studio report
+    host, host_test:
+        Build the native furi host port; run its tests
 
 How to open a shell with toolchain environment and other build tools:
     In your shell, type "source `./fbt -s env`". You can also use "." instead of "source".
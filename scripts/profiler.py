@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+
+import struct
+
+from flipper.app import App
+
+PROFILER_SLOTS_MAGIC = b"PSLT"
+PROFILER_SLOTS_VERSION = 1
+
+
+class ProfilerSlotsDump:
+    def __init__(self, data: bytes):
+        offset = 0
+
+        def unpack(fmt):
+            nonlocal offset
+            values = struct.unpack_from(fmt, data, offset)
+            offset += struct.calcsize(fmt)
+            return values
+
+        magic, version, histogram_size, slot_count, node_count, clock_hz = unpack(
+            "<4sBBHHI"
+        )
+        if magic != PROFILER_SLOTS_MAGIC or version != PROFILER_SLOTS_VERSION:
+            raise Exception(f"Unsupported dump: {magic}, version {version}")
+
+        self.clock_hz = clock_hz
+        self.slots = []
+        for _ in range(slot_count):
+            (name_length,) = unpack("<B")
+            name = data[offset : offset + name_length].decode()
+            offset += name_length
+            count, total, self_time, min_time, max_time = unpack("<IQQII")
+            histogram = unpack(f"<{histogram_size}I")
+            self.slots.append(
+                {
+                    "name": name,
+                    "count": count,
+                    "total": total,
+                    "self": self_time,
+                    "min": min_time,
+                    "max": max_time,
+                    "histogram": histogram,
+                }
+            )
+
+        # Node 0 is the implicit root, parents come before children
+        self.nodes = [None]
+        for _ in range(node_count):
+            parent, slot, count, total, self_time = unpack("<HHIQQ")
+            self.nodes.append(
+                {
+                    "parent": parent,
+                    "slot": slot,
+                    "count": count,
+                    "total": total,
+                    "self": self_time,
+                }
+            )
+
+    def stack(self, node_id):
+        names = []
+        while node_id != 0:
+            node = self.nodes[node_id]
+            names.append(self.slots[node["slot"]]["name"])
+            node_id = node["parent"]
+        return ";".join(reversed(names))
+
+
+class Main(App):
+    def init(self):
+        # Subparsers
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_flamegraph = self.subparsers.add_parser(
+            "flamegraph", help="Convert dump to folded stacks for flamegraph.pl"
+        )
+        self.parser_flamegraph.add_argument("filename", type=str)
+        self.parser_flamegraph.add_argument(
+            "--us", action="store_true", help="Use microseconds instead of ticks"
+        )
+        self.parser_flamegraph.set_defaults(func=self.flamegraph)
+
+        self.parser_stats = self.subparsers.add_parser(
+            "stats", help="Print per slot statistics"
+        )
+        self.parser_stats.add_argument("filename", type=str)
+        self.parser_stats.set_defaults(func=self.stats)
+
+    def _load(self):
+        with open(self.args.filename, "rb") as f:
+            return ProfilerSlotsDump(f.read())
+
+    def flamegraph(self):
+        dump = self._load()
+        scale = 1_000_000 / dump.clock_hz if self.args.us else 1
+        for node_id, node in enumerate(dump.nodes):
+            if node is None or node["self"] == 0:
+                continue
+            print(f"{dump.stack(node_id)} {round(node['self'] * scale)}")
+        return 0
+
+    def stats(self):
+        dump = self._load()
+        scale = 1_000_000 / dump.clock_hz
+        for slot in dump.slots:
+            if slot["count"] == 0:
+                continue
+            print(
+                f"{slot['name']}[{slot['count']}]: "
+                f"total {slot['total'] * scale:.3f} us, "
+                f"self {slot['self'] * scale:.3f} us, "
+                f"min {slot['min'] * scale:.3f} us, "
+                f"max {slot['max'] * scale:.3f} us"
+            )
+            buckets = [
+                f"<4^{i + 1}:{n}" for i, n in enumerate(slot["histogram"]) if n
+            ]
+            print(f"\t{' '.join(buckets)}")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
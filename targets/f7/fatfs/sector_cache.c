@@ -6,16 +6,35 @@
 #include <furi.h>
 #include <furi_hal_memory.h>
 
-#define SECTOR_SIZE 512
-#define N_SECTORS   8
+#define SECTOR_SIZE   512
+#define N_SECTORS     SECTOR_CACHE_SIZE
+#define N_BUCKETS     64
+#define SECTOR_NONE   0xFF
+#define BUCKET(n_sec) ((n_sec) & (N_BUCKETS - 1))
 
 typedef struct {
-    uint32_t itr;
-    uint32_t sectors[N_SECTORS];
+    uint32_t sector;
+    uint8_t flags;
+    uint8_t prev; // LRU list, most recently used first
+    uint8_t next; // LRU list or free list
+    uint8_t bucket_next;
+} SectorCacheEntry;
+
+typedef struct {
+    SectorCacheEntry entries[N_SECTORS];
+    uint8_t buckets[N_BUCKETS];
+    uint8_t lru_head;
+    uint8_t lru_tail;
+    uint8_t free_head;
+    uint8_t pinned_count;
+    uint8_t dirty_count;
+    SectorCacheStats stats;
     uint8_t sector_data[N_SECTORS][SECTOR_SIZE];
 } SectorCache;
 
 static SectorCache* cache = NULL;
+static SectorCacheWriteCallback write_callback = NULL;
+static void* write_context = NULL;
 
 void sector_cache_init(void) {
     if(cache == NULL) {
@@ -24,33 +43,208 @@ void sector_cache_init(void) {
 
     if(cache != NULL) {
         memset(cache, 0, sizeof(SectorCache));
+        memset(cache->buckets, SECTOR_NONE, sizeof(cache->buckets));
+        cache->lru_head = SECTOR_NONE;
+        cache->lru_tail = SECTOR_NONE;
+        for(uint8_t sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
+            cache->entries[sector_i].next = (sector_i + 1 < N_SECTORS) ? sector_i + 1 :
+                                                                         SECTOR_NONE;
+        }
+        cache->free_head = 0;
+    }
+}
+
+void sector_cache_set_write_callback(SectorCacheWriteCallback callback, void* context) {
+    write_callback = callback;
+    write_context = context;
+}
+
+static uint8_t sector_cache_find(uint32_t n_sector) {
+    uint8_t sector_i = cache->buckets[BUCKET(n_sector)];
+    while(sector_i != SECTOR_NONE && cache->entries[sector_i].sector != n_sector) {
+        sector_i = cache->entries[sector_i].bucket_next;
+    }
+    return sector_i;
+}
+
+static void sector_cache_lru_unlink(uint8_t sector_i) {
+    SectorCacheEntry* entry = &cache->entries[sector_i];
+    if(entry->prev != SECTOR_NONE) {
+        cache->entries[entry->prev].next = entry->next;
+    } else {
+        cache->lru_head = entry->next;
+    }
+    if(entry->next != SECTOR_NONE) {
+        cache->entries[entry->next].prev = entry->prev;
+    } else {
+        cache->lru_tail = entry->prev;
+    }
+}
+
+static void sector_cache_lru_push(uint8_t sector_i) {
+    SectorCacheEntry* entry = &cache->entries[sector_i];
+    entry->prev = SECTOR_NONE;
+    entry->next = cache->lru_head;
+    if(cache->lru_head != SECTOR_NONE) {
+        cache->entries[cache->lru_head].prev = sector_i;
+    } else {
+        cache->lru_tail = sector_i;
+    }
+    cache->lru_head = sector_i;
+}
+
+static void sector_cache_remove(uint8_t sector_i) {
+    SectorCacheEntry* entry = &cache->entries[sector_i];
+
+    uint8_t* link = &cache->buckets[BUCKET(entry->sector)];
+    while(*link != sector_i) {
+        link = &cache->entries[*link].bucket_next;
+    }
+    *link = entry->bucket_next;
+
+    sector_cache_lru_unlink(sector_i);
+    if(entry->flags & SectorCacheFlagPinned) cache->pinned_count--;
+    if(entry->flags & SectorCacheFlagDirty) cache->dirty_count--;
+
+    entry->flags = SectorCacheFlagNone;
+    entry->next = cache->free_head;
+    cache->free_head = sector_i;
+}
+
+static bool sector_cache_write_back(uint8_t sector_i) {
+    SectorCacheEntry* entry = &cache->entries[sector_i];
+    if(!(entry->flags & SectorCacheFlagDirty)) return true;
+
+    if(write_callback == NULL ||
+       !write_callback(entry->sector, cache->sector_data[sector_i], write_context)) {
+        return false;
     }
+
+    entry->flags &= ~SectorCacheFlagDirty;
+    cache->dirty_count--;
+    cache->stats.write_backs++;
+    return true;
+}
+
+static uint8_t sector_cache_find_victim(bool pinned) {
+    // Pinned sectors replace each other once their share is used up
+    bool replace_pinned = pinned && cache->pinned_count >= SECTOR_CACHE_PINNED_MAX;
+    if(!replace_pinned && cache->free_head != SECTOR_NONE) return cache->free_head;
+
+    for(uint8_t sector_i = cache->lru_tail; sector_i != SECTOR_NONE;
+        sector_i = cache->entries[sector_i].prev) {
+        if(!!(cache->entries[sector_i].flags & SectorCacheFlagPinned) == replace_pinned) {
+            return sector_i;
+        }
+    }
+    return cache->lru_tail;
 }
 
 uint8_t* sector_cache_get(uint32_t n_sector) {
-    if(cache != NULL && n_sector != 0) {
-        for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-            if(cache->sectors[sector_i] == n_sector) {
-                return cache->sector_data[sector_i];
-            }
+    if(cache != NULL) {
+        uint8_t sector_i = sector_cache_find(n_sector);
+        if(sector_i != SECTOR_NONE) {
+            cache->stats.hits++;
+            sector_cache_lru_unlink(sector_i);
+            sector_cache_lru_push(sector_i);
+            return cache->sector_data[sector_i];
         }
+        cache->stats.misses++;
     }
     return NULL;
 }
 
-void sector_cache_put(uint32_t n_sector, uint8_t* data) {
-    if(cache == NULL) return;
-    cache->sectors[cache->itr % N_SECTORS] = n_sector;
-    memcpy(cache->sector_data[cache->itr % N_SECTORS], data, SECTOR_SIZE);
-    cache->itr++;
+bool sector_cache_put(uint32_t n_sector, const uint8_t* data, uint8_t flags) {
+    if(cache == NULL) return !(flags & SectorCacheFlagDirty);
+
+    uint8_t sector_i = sector_cache_find(n_sector);
+    if(sector_i == SECTOR_NONE) {
+        sector_i = sector_cache_find_victim(flags & SectorCacheFlagPinned);
+        if(sector_i != cache->free_head) {
+            if(!sector_cache_write_back(sector_i)) return false;
+            sector_cache_remove(sector_i);
+            cache->stats.evictions++;
+        }
+
+        SectorCacheEntry* entry = &cache->entries[sector_i];
+        cache->free_head = entry->next;
+        entry->sector = n_sector;
+        entry->flags = SectorCacheFlagNone;
+        entry->bucket_next = cache->buckets[BUCKET(n_sector)];
+        cache->buckets[BUCKET(n_sector)] = sector_i;
+    } else {
+        sector_cache_lru_unlink(sector_i);
+    }
+    sector_cache_lru_push(sector_i);
+
+    // Once pinned the sector stays pinned, dirty state follows the latest data
+    SectorCacheEntry* entry = &cache->entries[sector_i];
+    if((flags & SectorCacheFlagPinned) && !(entry->flags & SectorCacheFlagPinned) &&
+       cache->pinned_count < SECTOR_CACHE_PINNED_MAX) {
+        entry->flags |= SectorCacheFlagPinned;
+        cache->pinned_count++;
+    }
+    if((flags & SectorCacheFlagDirty) && !(entry->flags & SectorCacheFlagDirty)) {
+        cache->dirty_count++;
+    } else if(!(flags & SectorCacheFlagDirty) && (entry->flags & SectorCacheFlagDirty)) {
+        cache->dirty_count--;
+    }
+    entry->flags = (entry->flags & ~SectorCacheFlagDirty) | (flags & SectorCacheFlagDirty);
+
+    memcpy(cache->sector_data[sector_i], data, SECTOR_SIZE);
+    return true;
+}
+
+void sector_cache_merge_dirty(uint32_t start_sector, uint32_t count, uint8_t* data) {
+    if(cache == NULL || cache->dirty_count == 0) return;
+    for(uint8_t sector_i = cache->lru_head; sector_i != SECTOR_NONE;
+        sector_i = cache->entries[sector_i].next) {
+        const SectorCacheEntry* entry = &cache->entries[sector_i];
+        if((entry->flags & SectorCacheFlagDirty) && entry->sector >= start_sector &&
+           entry->sector - start_sector < count) {
+            memcpy(
+                data + (entry->sector - start_sector) * SECTOR_SIZE,
+                cache->sector_data[sector_i],
+                SECTOR_SIZE);
+        }
+    }
+}
+
+bool sector_cache_flush(void) {
+    if(cache == NULL) return true;
+    while(cache->dirty_count > 0) {
+        uint8_t first = SECTOR_NONE;
+        for(uint8_t sector_i = cache->lru_head; sector_i != SECTOR_NONE;
+            sector_i = cache->entries[sector_i].next) {
+            const SectorCacheEntry* entry = &cache->entries[sector_i];
+            if((entry->flags & SectorCacheFlagDirty) &&
+               (first == SECTOR_NONE || entry->sector < cache->entries[first].sector)) {
+                first = sector_i;
+            }
+        }
+        if(!sector_cache_write_back(first)) return false;
+    }
+    return true;
 }
 
 void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
     if(cache == NULL) return;
-    for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-        if((cache->sectors[sector_i] >= start_sector) &&
-           (cache->sectors[sector_i] <= end_sector)) {
-            cache->sectors[sector_i] = 0;
+    uint8_t sector_i = cache->lru_head;
+    while(sector_i != SECTOR_NONE) {
+        uint8_t next = cache->entries[sector_i].next;
+        if((cache->entries[sector_i].sector >= start_sector) &&
+           (cache->entries[sector_i].sector <= end_sector)) {
+            sector_cache_remove(sector_i);
         }
+        sector_i = next;
+    }
+}
+
+void sector_cache_get_stats(SectorCacheStats* stats) {
+    furi_check(stats);
+    if(cache != NULL) {
+        *stats = cache->stats;
+    } else {
+        memset(stats, 0, sizeof(SectorCacheStats));
     }
 }
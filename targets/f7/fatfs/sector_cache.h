@@ -1,15 +1,62 @@
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Number of cached sectors, up to 255 */
+#ifndef SECTOR_CACHE_SIZE
+#define SECTOR_CACHE_SIZE 16
+#endif
+
+/** Number of pinned sectors, the rest is always left for unpinned ones */
+#ifndef SECTOR_CACHE_PINNED_MAX
+#define SECTOR_CACHE_PINNED_MAX (SECTOR_CACHE_SIZE * 3 / 4)
+#endif
+
+/** Keep single sector writes in the cache until the next flush */
+#ifndef SECTOR_CACHE_WRITE_BACK
+#define SECTOR_CACHE_WRITE_BACK 0
+#endif
+
+/** Sector flags */
+typedef enum {
+    SectorCacheFlagNone = 0,
+    SectorCacheFlagPinned = (1 << 0), /**< Evicted only by other pinned sectors */
+    SectorCacheFlagDirty = (1 << 1), /**< Newer than the card, written back on eviction */
+} SectorCacheFlag;
+
+/** Cache statistics, reset by sector_cache_init */
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t write_backs;
+} SectorCacheStats;
+
+/**
+ * @brief Write dirty sector to the card
+ * @param n_sector Sector number
+ * @param data Pointer to sector data
+ * @param context Callback context
+ * @return true on success
+ */
+typedef bool (*SectorCacheWriteCallback)(uint32_t n_sector, const uint8_t* data, void* context);
+
 /**
- * @brief Init sector cache system
+ * @brief Init sector cache system, drops all sectors including dirty ones
  */
 void sector_cache_init(void);
 
+/**
+ * @brief Set callback used to write dirty sectors
+ * @param callback Write callback
+ * @param context Callback context
+ */
+void sector_cache_set_write_callback(SectorCacheWriteCallback callback, void* context);
+
 /**
  * @brief Get sector data from cache
  * @param n_sector Sector number
@@ -18,19 +65,41 @@ void sector_cache_init(void);
 uint8_t* sector_cache_get(uint32_t n_sector);
 
 /**
- * @brief Put sector data to cache
+ * @brief Put sector data to cache, least recently used sector is evicted if needed
  * @param n_sector Sector number
  * @param data Pointer to sector data
+ * @param flags SectorCacheFlag combination
+ * @return false if evicted dirty sector was not written back
  */
-void sector_cache_put(uint32_t n_sector, uint8_t* data);
+bool sector_cache_put(uint32_t n_sector, const uint8_t* data, uint8_t flags);
 
 /**
- * @brief Invalidate sector cache for given range
+ * @brief Copy dirty sectors of the range over data read from the card
+ * @param start_sector Start sector number
+ * @param count Number of sectors
+ * @param data Pointer to data of count sectors
+ */
+void sector_cache_merge_dirty(uint32_t start_sector, uint32_t count, uint8_t* data);
+
+/**
+ * @brief Write all dirty sectors in ascending order
+ * @return true on success
+ */
+bool sector_cache_flush(void);
+
+/**
+ * @brief Invalidate sector cache for given range, dirty sectors are dropped
  * @param start_sector Start sector number
  * @param end_sector End sector number
  */
 void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector);
 
+/**
+ * @brief Get cache statistics
+ * @param stats Pointer to SectorCacheStats to fill
+ */
+void sector_cache_get_stats(SectorCacheStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,7 +1,11 @@
 #include <furi.h>
 #include <furi_hal.h>
+#include "fatfs.h"
 #include "user_diskio.h"
 #include "sector_cache.h"
+#include <furi_hal_sd_i.h>
+
+#define SECTOR_SIZE 512
 
 static DSTATUS driver_initialize(BYTE pdrv);
 static DSTATUS driver_status(BYTE pdrv);
@@ -17,6 +21,16 @@ const Diskio_drvTypeDef sd_fatfs_driver = {
     driver_ioctl,
 };
 
+static bool driver_write_back(uint32_t n_sector, const uint8_t* data, void* context) {
+    UNUSED(context);
+    return furi_hal_sd_write_blocks_uncached((const uint32_t*)data, n_sector, 1) == FuriStatusOk;
+}
+
+/** FAT, directory and boot sectors go through the file system window, file data does not */
+static uint8_t driver_cache_flags(const BYTE* buff) {
+    return buff == fatfs_object.win ? SectorCacheFlagPinned : SectorCacheFlagNone;
+}
+
 /**
   * @brief  Initializes a Drive
   * @param  pdrv: Physical drive number (0..)
@@ -24,6 +38,7 @@ const Diskio_drvTypeDef sd_fatfs_driver = {
   */
 static DSTATUS driver_initialize(BYTE pdrv) {
     UNUSED(pdrv);
+    sector_cache_set_write_callback(driver_write_back, NULL);
     return RES_OK;
 }
 
@@ -52,8 +67,25 @@ static DSTATUS driver_status(BYTE pdrv) {
   */
 static DRESULT driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
     UNUSED(pdrv);
-    FuriStatus status = furi_hal_sd_read_blocks((uint32_t*)buff, (uint32_t)(sector), count);
-    return status == FuriStatusOk ? RES_OK : RES_ERROR;
+
+    if(count == 1) {
+        uint8_t* cached_data = sector_cache_get(sector);
+        if(cached_data) {
+            memcpy(buff, cached_data, SECTOR_SIZE);
+            return RES_OK;
+        }
+    }
+
+    FuriStatus status =
+        furi_hal_sd_read_blocks_uncached((uint32_t*)buff, (uint32_t)(sector), count);
+    if(status != FuriStatusOk) return RES_ERROR;
+
+    if(count == 1) {
+        sector_cache_put(sector, buff, driver_cache_flags(buff));
+    } else {
+        sector_cache_merge_dirty(sector, count, buff);
+    }
+    return RES_OK;
 }
 
 /**
@@ -66,8 +98,21 @@ static DRESULT driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
   */
 static DRESULT driver_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count) {
     UNUSED(pdrv);
-    FuriStatus status = furi_hal_sd_write_blocks((uint32_t*)buff, (uint32_t)(sector), count);
-    return status == FuriStatusOk ? RES_OK : RES_ERROR;
+
+    if(count == 1 && SECTOR_CACHE_WRITE_BACK &&
+       sector_cache_put(sector, buff, driver_cache_flags(buff) | SectorCacheFlagDirty)) {
+        return RES_OK;
+    }
+
+    sector_cache_invalidate_range(sector, sector + count - 1);
+    FuriStatus status =
+        furi_hal_sd_write_blocks_uncached((uint32_t*)buff, (uint32_t)(sector), count);
+    if(status != FuriStatusOk) return RES_ERROR;
+
+    if(count == 1) {
+        sector_cache_put(sector, buff, driver_cache_flags(buff));
+    }
+    return RES_OK;
 }
 
 /**
@@ -87,7 +132,7 @@ static DRESULT driver_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
     switch(cmd) {
     /* Make sure that no pending write process */
     case CTRL_SYNC:
-        res = RES_OK;
+        res = sector_cache_flush() ? RES_OK : RES_ERROR;
         break;
 
     /* Get number of sectors on the disk (DWORD) */
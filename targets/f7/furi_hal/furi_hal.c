@@ -45,6 +45,7 @@ void furi_hal_init(void) {
     furi_hal_spi_dma_init();
     furi_hal_ibutton_init();
     furi_hal_speaker_init();
+    furi_hal_crc_init();
     furi_hal_crypto_init();
     furi_hal_i2c_init();
     furi_hal_power_init();
@@ -15,6 +15,7 @@
 
 #include <furi_hal_version.h>
 #include <furi_hal_power.h>
+#include <furi_hal_crc.h>
 #include <furi_hal_bus.c>
 #include <services/battery_service.h>
 #include <furi.h>
@@ -224,6 +225,9 @@ void furi_hal_bt_reinit(void) {
     // enterprise delay
     furi_delay_ms(100);
 
+    // CRC unit is shared with furi_hal_crc32_calc, keep it busy until clocked again
+    furi_check(furi_hal_crc_acquire(FuriWaitForever));
+
     furi_hal_bus_disable(FuriHalBusHSEM);
     furi_hal_bus_disable(FuriHalBusIPCC);
     furi_hal_bus_disable(FuriHalBusAES2);
@@ -231,6 +235,7 @@ void furi_hal_bt_reinit(void) {
     furi_hal_bus_disable(FuriHalBusCRC);
 
     furi_hal_bt_init();
+    furi_hal_crc_release();
     furi_hal_bt_unlock_core2();
     furi_hal_bt_start_radio_stack();
     furi_hal_power_insomnia_exit();
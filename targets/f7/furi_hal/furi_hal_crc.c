@@ -0,0 +1,59 @@
+#include <furi_hal_crc.h>
+#include <furi_hal_bus.h>
+#include <furi.h>
+
+#include <stm32wbxx_ll_crc.h>
+
+static FuriMutex* furi_hal_crc_mutex = NULL;
+
+void furi_hal_crc_init(void) {
+    furi_hal_crc_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+}
+
+bool furi_hal_crc_acquire(uint32_t timeout) {
+    furi_check(furi_hal_crc_mutex);
+    return furi_mutex_acquire(furi_hal_crc_mutex, timeout) == FuriStatusOk;
+}
+
+void furi_hal_crc_release(void) {
+    furi_check(furi_hal_crc_mutex);
+    furi_check(furi_mutex_release(furi_hal_crc_mutex) == FuriStatusOk);
+}
+
+uint32_t furi_hal_crc32_calc(uint32_t crc, const void* buffer, size_t size) {
+    furi_check(buffer || !size);
+    furi_check(furi_hal_crc_acquire(FuriWaitForever));
+
+    // Clock is shared with the radio stack, which only gates it while holding the unit
+    furi_hal_bus_enable(FuriHalBusCRC);
+
+    // Reflected input and output, state is kept in the non reflected domain
+    LL_CRC_SetPolynomialCoef(CRC, LL_CRC_DEFAULT_CRC32_POLY);
+    LL_CRC_SetPolynomialSize(CRC, LL_CRC_POLYLENGTH_32B);
+    LL_CRC_SetInputDataReverseMode(CRC, LL_CRC_INDATA_REVERSE_BYTE);
+    LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_BIT);
+    LL_CRC_SetInitialData(CRC, __RBIT(~crc));
+    LL_CRC_ResetCRCCalculationUnit(CRC);
+
+    const uint8_t* data = buffer;
+
+    while(size && ((uintptr_t)data & 3U)) {
+        LL_CRC_FeedData8(CRC, *data++);
+        size--;
+    }
+
+    // Unit takes words MSB first, swap to keep the byte order of the stream
+    for(; size >= 4; size -= 4, data += 4) {
+        LL_CRC_FeedData32(CRC, __REV(*(const uint32_t*)data));
+    }
+
+    while(size--) {
+        LL_CRC_FeedData8(CRC, *data++);
+    }
+
+    crc = ~LL_CRC_ReadData32(CRC);
+
+    furi_hal_crc_release();
+
+    return crc;
+}
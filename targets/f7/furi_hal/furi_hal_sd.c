@@ -1,5 +1,5 @@
 #include <furi_hal_sd.h>
-#include <stm32wbxx_ll_gpio.h>
+#include <furi_hal_sd_i.h>
 #include <furi.h>
 #include <furi_hal.h>
 #include "../fatfs/sector_cache.h"
@@ -21,6 +21,8 @@
 #define FLAG_SET(x, y) (((x) & (y)) == (y))
 
 static bool sd_high_capacity = false;
+/** Card size in blocks, read from the CSD on init, 0 if unknown */
+static uint32_t sd_block_count = 0;
 
 typedef enum {
     SdSpiDataResponceOK = 0x05,
@@ -67,6 +69,7 @@ typedef enum {
     SD_CMD17_READ_SINGLE_BLOCK = 17,
     SD_CMD18_READ_MULT_BLOCK = 18,
     SD_CMD23_SET_BLOCK_COUNT = 23,
+    SD_CMD23_SET_WR_BLK_ERASE_COUNT = 23,
     SD_CMD24_WRITE_SINGLE_BLOCK = 24,
     SD_CMD25_WRITE_MULT_BLOCK = 25,
     SD_CMD27_PROG_CSD = 27,
@@ -315,6 +318,19 @@ static uint8_t sd_spi_wait_for_data_and_read(void) {
     return responce;
 }
 
+static uint8_t sd_spi_wait_for_r1(void) {
+    uint8_t retry_count = SD_ANSWER_RETRY_COUNT;
+    uint8_t responce;
+
+    // R1 always has bit 7 clear, bytes ahead of it are not always 0xFF
+    do {
+        responce = sd_spi_read_byte();
+        retry_count--;
+    } while((responce & 0x80) && retry_count);
+
+    return responce;
+}
+
 static FuriStatus sd_spi_wait_for_data(uint8_t data, uint32_t timeout_ms) {
     FuriHalCortexTimer timer = furi_hal_cortex_timer_get(timeout_ms * 1000);
     uint8_t byte;
@@ -335,8 +351,8 @@ static inline void sd_spi_deselect_card_and_purge(void) {
 }
 
 static inline void sd_spi_purge_crc(void) {
-    sd_spi_read_byte();
-    sd_spi_read_byte();
+    uint8_t crc[2];
+    sd_spi_read_bytes(crc, sizeof(crc));
 }
 
 static SdSpiCmdAnswer
@@ -642,6 +658,20 @@ static FuriStatus sd_spi_get_csd(SD_CSD* csd) {
     return ret;
 }
 
+static uint64_t sd_spi_get_capacity(const SD_CSD* csd) {
+    uint64_t capacity;
+
+    if(sd_high_capacity == 1) {
+        capacity = ((uint64_t)csd->version.v2.DeviceSize + 1UL) * 1024UL * SD_BLOCK_SIZE;
+    } else {
+        capacity = (csd->version.v1.DeviceSize + 1);
+        capacity *= (1UL << (csd->version.v1.DeviceSizeMul + 2));
+        capacity *= (1UL << (csd->RdBlockLen));
+    }
+
+    return capacity;
+}
+
 static FuriStatus sd_spi_get_cid(SD_CID* Cid) {
     uint16_t counter = 0;
     uint8_t cid_data[16];
@@ -685,10 +715,132 @@ static FuriStatus sd_spi_get_cid(SD_CID* Cid) {
     return ret;
 }
 
+static FuriStatus sd_spi_stop_transmission(uint8_t* r1, uint32_t timeout_ms) {
+    // Card is still selected and sending data, CMD12 is written without reselecting
+    uint8_t frame[SD_CMD_LENGTH] = {SD_CMD12_STOP_TRANSMISSION | 0x40, 0, 0, 0, 0, 0xFF};
+    sd_spi_write_bytes(frame, sizeof(frame));
+
+    // CMD12 (STOP_TRANSMISSION): stuff byte, R1 response (0x00: no errors) and busy.
+    // Data may still be clocked out until R1, it is told apart by bit 7 only.
+    sd_spi_read_byte();
+    *r1 = sd_spi_wait_for_r1();
+    if(sd_spi_wait_for_data(SD_DUMMY_BYTE, timeout_ms) != FuriStatusOk) {
+        return FuriStatusErrorTimeout;
+    }
+
+    return FuriStatusOk;
+}
+
+static FuriStatus sd_spi_cmd_read_mult_blocks(
+    uint32_t* data,
+    uint32_t block_address,
+    uint32_t blocks,
+    bool to_last_block,
+    uint32_t timeout_ms) {
+    // CMD18 (READ_MULT_BLOCK): R1 response (0x00: no errors)
+    SdSpiCmdAnswer response =
+        sd_spi_send_cmd(SD_CMD18_READ_MULT_BLOCK, block_address, 0xFF, SdSpiCmdAnswerTypeR1);
+    if(response.r1 != SdSpi_R1_NO_ERROR) {
+        sd_spi_deselect_card_and_purge();
+        return FuriStatusError;
+    }
+
+    // Blocks follow each other while the card stays selected
+    FuriStatus status = FuriStatusOk;
+    uint8_t* block = (uint8_t*)data;
+    while(blocks--) {
+        if(sd_spi_wait_for_data(SD_TOKEN_START_DATA_MULTIPLE_BLOCK_READ, timeout_ms) !=
+           FuriStatusOk) {
+            status = FuriStatusError;
+            break;
+        }
+
+        sd_spi_read_bytes_dma(block, SD_BLOCK_SIZE);
+        sd_spi_purge_crc();
+        block += SD_BLOCK_SIZE;
+    }
+
+    // The card reads ahead past the last block and flags OUT_OF_RANGE, which is to be
+    // ignored once all blocks up to the last one have arrived (SD spec 4.3.3)
+    const bool read_ahead_error = status == FuriStatusOk && to_last_block;
+    uint8_t r1 = SdSpi_R1_NO_ERROR;
+    if(sd_spi_stop_transmission(&r1, timeout_ms) != FuriStatusOk) {
+        status = FuriStatusError;
+    } else if(read_ahead_error) {
+        r1 &= ~(SdSpi_R1_ADDRESS_ERROR | SdSpi_R1_PARAMETER_ERROR);
+    }
+    if(r1 != SdSpi_R1_NO_ERROR) {
+        status = FuriStatusError;
+    }
+    sd_spi_deselect_card_and_purge();
+
+    if(read_ahead_error) {
+        // OUT_OF_RANGE is cleared by reading it, the status poll after the read sees a clean card
+        sd_spi_send_cmd(SD_CMD13_SEND_STATUS, 0, 0xFF, SdSpiCmdAnswerTypeR2);
+        sd_spi_deselect_card_and_purge();
+    }
+
+    return status;
+}
+
+static FuriStatus sd_spi_cmd_write_mult_blocks(
+    const uint32_t* data,
+    uint32_t block_address,
+    uint32_t blocks,
+    uint32_t timeout_ms) {
+    // CMD55 (APP_CMD) before any ACMD command: R1 response (0x00: no errors)
+    SdSpiCmdAnswer response = sd_spi_send_cmd(SD_CMD55_APP_CMD, 0, 0xFF, SdSpiCmdAnswerTypeR1);
+    sd_spi_deselect_card_and_purge();
+    if(response.r1 == SdSpi_R1_NO_ERROR) {
+        // ACMD23 (SET_WR_BLK_ERASE_COUNT): R1 response, only a pre-erase hint, errors are ignored
+        sd_spi_send_cmd(SD_CMD23_SET_WR_BLK_ERASE_COUNT, blocks, 0xFF, SdSpiCmdAnswerTypeR1);
+        sd_spi_deselect_card_and_purge();
+    }
+
+    // CMD25 (WRITE_MULT_BLOCK): R1 response (0x00: no errors)
+    response =
+        sd_spi_send_cmd(SD_CMD25_WRITE_MULT_BLOCK, block_address, 0xFF, SdSpiCmdAnswerTypeR1);
+    if(response.r1 != SdSpi_R1_NO_ERROR) {
+        sd_spi_deselect_card_and_purge();
+        return FuriStatusError;
+    }
+
+    // Blocks follow each other while the card stays selected
+    FuriStatus status = FuriStatusOk;
+    const uint8_t* block = (const uint8_t*)data;
+    while(blocks--) {
+        // One byte for NWR timing before the token
+        sd_spi_write_byte(SD_DUMMY_BYTE);
+        sd_spi_write_byte(SD_TOKEN_START_DATA_MULTIPLE_BLOCK_WRITE);
+        sd_spi_write_bytes_dma((uint8_t*)block, SD_BLOCK_SIZE);
+        sd_spi_purge_crc();
+        block += SD_BLOCK_SIZE;
+
+        // Data response, then busy while the block is programmed
+        if((sd_spi_read_byte() & 0x1F) != SdSpiDataResponceOK) {
+            status = FuriStatusError;
+            break;
+        }
+        if(sd_spi_wait_for_data(SD_DUMMY_BYTE, timeout_ms) != FuriStatusOk) {
+            status = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+
+    // Stop token ends the transfer on errors too, then one byte and busy again
+    sd_spi_write_byte(SD_TOKEN_STOP_DATA_MULTIPLE_BLOCK_WRITE);
+    sd_spi_read_byte();
+    if(sd_spi_wait_for_data(SD_DUMMY_BYTE, timeout_ms) != FuriStatusOk) {
+        status = FuriStatusErrorTimeout;
+    }
+    sd_spi_deselect_card_and_purge();
+
+    return status;
+}
+
 static FuriStatus
     sd_spi_cmd_read_blocks(uint32_t* data, uint32_t address, uint32_t blocks, uint32_t timeout_ms) {
     uint32_t block_address = address;
-    uint32_t offset = 0;
 
     // CMD16 (SET_BLOCKLEN): R1 response (0x00: no errors)
     SdSpiCmdAnswer response =
@@ -703,40 +855,32 @@ static FuriStatus
         block_address = address * SD_BLOCK_SIZE;
     }
 
-    while(blocks--) {
-        // CMD17 (READ_SINGLE_BLOCK): R1 response (0x00: no errors)
-        response =
-            sd_spi_send_cmd(SD_CMD17_READ_SINGLE_BLOCK, block_address, 0xFF, SdSpiCmdAnswerTypeR1);
-        if(response.r1 != SdSpi_R1_NO_ERROR) {
-            sd_spi_deselect_card_and_purge();
-            return FuriStatusError;
-        }
-
-        // Wait for the data start token
-        if(sd_spi_wait_for_data(SD_TOKEN_START_DATA_SINGLE_BLOCK_READ, timeout_ms) ==
-           FuriStatusOk) {
-            // Read the data block
-            sd_spi_read_bytes_dma((uint8_t*)data + offset, SD_BLOCK_SIZE);
-            sd_spi_purge_crc();
-
-            // increase offset
-            offset += SD_BLOCK_SIZE;
-
-            // increase block address
-            if(sd_high_capacity) {
-                block_address += 1;
-            } else {
-                block_address += SD_BLOCK_SIZE;
-            }
-        } else {
-            sd_spi_deselect_card_and_purge();
-            return FuriStatusError;
-        }
+    if(blocks > 1) {
+        const bool to_last_block = sd_block_count && address + blocks == sd_block_count;
+        return sd_spi_cmd_read_mult_blocks(data, block_address, blocks, to_last_block, timeout_ms);
+    }
 
+    // CMD17 (READ_SINGLE_BLOCK): R1 response (0x00: no errors)
+    response =
+        sd_spi_send_cmd(SD_CMD17_READ_SINGLE_BLOCK, block_address, 0xFF, SdSpiCmdAnswerTypeR1);
+    if(response.r1 != SdSpi_R1_NO_ERROR) {
         sd_spi_deselect_card_and_purge();
+        return FuriStatusError;
     }
 
-    return FuriStatusOk;
+    // Wait for the data start token
+    FuriStatus status = sd_spi_wait_for_data(SD_TOKEN_START_DATA_SINGLE_BLOCK_READ, timeout_ms);
+    if(status == FuriStatusOk) {
+        // Read the data block
+        sd_spi_read_bytes_dma((uint8_t*)data, SD_BLOCK_SIZE);
+        sd_spi_purge_crc();
+    } else {
+        status = FuriStatusError;
+    }
+
+    sd_spi_deselect_card_and_purge();
+
+    return status;
 }
 
 static FuriStatus sd_spi_cmd_write_blocks(
@@ -745,7 +889,6 @@ static FuriStatus sd_spi_cmd_write_blocks(
     uint32_t blocks,
     uint32_t timeout_ms) {
     uint32_t block_address = address;
-    uint32_t offset = 0;
 
     // CMD16 (SET_BLOCKLEN): R1 response (0x00: no errors)
     SdSpiCmdAnswer response =
@@ -760,42 +903,34 @@ static FuriStatus sd_spi_cmd_write_blocks(
         block_address = address * SD_BLOCK_SIZE;
     }
 
-    while(blocks--) {
-        // CMD24 (WRITE_SINGLE_BLOCK): R1 response (0x00: no errors)
-        response = sd_spi_send_cmd(
-            SD_CMD24_WRITE_SINGLE_BLOCK, block_address, 0xFF, SdSpiCmdAnswerTypeR1);
-        if(response.r1 != SdSpi_R1_NO_ERROR) {
-            sd_spi_deselect_card_and_purge();
-            return FuriStatusError;
-        }
-
-        // Send dummy byte for NWR timing : one byte between CMD_WRITE and TOKEN
-        // TODO FL-3509: check bytes count
-        sd_spi_write_byte(SD_DUMMY_BYTE);
-        sd_spi_write_byte(SD_DUMMY_BYTE);
-
-        // Send the data start token
-        sd_spi_write_byte(SD_TOKEN_START_DATA_SINGLE_BLOCK_WRITE);
-        sd_spi_write_bytes_dma((uint8_t*)data + offset, SD_BLOCK_SIZE);
-        sd_spi_purge_crc();
+    if(blocks > 1) {
+        return sd_spi_cmd_write_mult_blocks(data, block_address, blocks, timeout_ms);
+    }
 
-        // Read data response
-        SdSpiDataResponce data_responce = sd_spi_get_data_response(timeout_ms);
+    // CMD24 (WRITE_SINGLE_BLOCK): R1 response (0x00: no errors)
+    response =
+        sd_spi_send_cmd(SD_CMD24_WRITE_SINGLE_BLOCK, block_address, 0xFF, SdSpiCmdAnswerTypeR1);
+    if(response.r1 != SdSpi_R1_NO_ERROR) {
         sd_spi_deselect_card_and_purge();
+        return FuriStatusError;
+    }
 
-        if(data_responce != SdSpiDataResponceOK) {
-            return FuriStatusError;
-        }
+    // Send dummy byte for NWR timing : one byte between CMD_WRITE and TOKEN
+    // TODO FL-3509: check bytes count
+    sd_spi_write_byte(SD_DUMMY_BYTE);
+    sd_spi_write_byte(SD_DUMMY_BYTE);
 
-        // increase offset
-        offset += SD_BLOCK_SIZE;
+    // Send the data start token
+    sd_spi_write_byte(SD_TOKEN_START_DATA_SINGLE_BLOCK_WRITE);
+    sd_spi_write_bytes_dma((uint8_t*)data, SD_BLOCK_SIZE);
+    sd_spi_purge_crc();
 
-        // increase block address
-        if(sd_high_capacity) {
-            block_address += 1;
-        } else {
-            block_address += SD_BLOCK_SIZE;
-        }
+    // Read data response
+    SdSpiDataResponce data_responce = sd_spi_get_data_response(timeout_ms);
+    sd_spi_deselect_card_and_purge();
+
+    if(data_responce != SdSpiDataResponceOK) {
+        return FuriStatusError;
     }
 
     return FuriStatusOk;
@@ -816,27 +951,6 @@ static FuriStatus sd_spi_get_card_state(void) {
     return FuriStatusError;
 }
 
-static inline bool sd_cache_get(uint32_t address, uint32_t* data) {
-    uint8_t* cached_data = sector_cache_get(address);
-    if(cached_data) {
-        memcpy(data, cached_data, SD_BLOCK_SIZE);
-        return true;
-    }
-    return false;
-}
-
-static inline void sd_cache_put(uint32_t address, uint32_t* data) {
-    sector_cache_put(address, (uint8_t*)data);
-}
-
-static inline void sd_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
-    sector_cache_invalidate_range(start_sector, end_sector);
-}
-
-static inline void sd_cache_invalidate_all(void) {
-    sector_cache_init();
-}
-
 static FuriStatus sd_device_read(uint32_t* buff, uint32_t sector, uint32_t count) {
     FuriStatus status = FuriStatusError;
 
@@ -877,8 +991,6 @@ static FuriStatus sd_device_write(const uint32_t* buff, uint32_t sector, uint32_
             status = sd_spi_get_card_state();
 
             if(furi_hal_cortex_timer_is_expired(timer)) {
-                sd_cache_invalidate_all();
-
                 status = FuriStatusErrorTimeout;
                 break;
             }
@@ -911,7 +1023,7 @@ uint8_t furi_hal_sd_max_mount_retry_count(void) {
     return 10;
 }
 
-FuriStatus furi_hal_sd_init(bool power_reset) {
+static FuriStatus sd_init(bool power_reset) {
     // Slow speed init
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_slow);
     furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_slow;
@@ -950,10 +1062,23 @@ FuriStatus furi_hal_sd_init(bool power_reset) {
         }
     }
 
+    // Card size, multi block reads ending at the last block need it
+    SD_CSD csd;
+    sd_block_count = 0;
+    if(status == FuriStatusOk && sd_spi_get_csd(&csd) == FuriStatusOk) {
+        sd_block_count = sd_spi_get_capacity(&csd) / SD_BLOCK_SIZE;
+    }
+
     furi_hal_sd_spi_handle = NULL;
     furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_slow);
 
-    // Init sector cache
+    return status;
+}
+
+FuriStatus furi_hal_sd_init(bool power_reset) {
+    FuriStatus status = sd_init(power_reset);
+
+    // Card may have been replaced, cached sectors are stale
     sector_cache_init();
 
     return status;
@@ -971,19 +1096,10 @@ FuriStatus furi_hal_sd_get_card_state(void) {
     return status;
 }
 
-FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t count) {
+FuriStatus furi_hal_sd_read_blocks_uncached(uint32_t* buff, uint32_t sector, uint32_t count) {
     furi_check(buff);
 
-    FuriStatus status;
-    bool single_sector = count == 1;
-
-    if(single_sector) {
-        if(sd_cache_get(sector, buff)) {
-            return FuriStatusOk;
-        }
-    }
-
-    status = sd_device_read(buff, sector, count);
+    FuriStatus status = sd_device_read(buff, sector, count);
 
     if(status != FuriStatusOk) {
         uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -991,9 +1107,9 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
         while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
             if((counter % 2) == 0) {
                 // power reset sd card
-                status = furi_hal_sd_init(true);
+                status = sd_init(true);
             } else {
-                status = furi_hal_sd_init(false);
+                status = sd_init(false);
             }
 
             if(status == FuriStatusOk) {
@@ -1003,21 +1119,14 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
         }
     }
 
-    if(single_sector && status == FuriStatusOk) {
-        sd_cache_put(sector, buff);
-    }
-
     return status;
 }
 
-FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count) {
+FuriStatus
+    furi_hal_sd_write_blocks_uncached(const uint32_t* buff, uint32_t sector, uint32_t count) {
     furi_check(buff);
 
-    FuriStatus status;
-
-    sd_cache_invalidate_range(sector, sector + count);
-
-    status = sd_device_write(buff, sector, count);
+    FuriStatus status = sd_device_write(buff, sector, count);
 
     if(status != FuriStatusOk) {
         uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -1025,9 +1134,9 @@ FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint3
         while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
             if((counter % 2) == 0) {
                 // power reset sd card
-                status = furi_hal_sd_init(true);
+                status = sd_init(true);
             } else {
-                status = furi_hal_sd_init(false);
+                status = sd_init(false);
             }
 
             if(status == FuriStatusOk) {
@@ -1040,6 +1149,26 @@ FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint3
     return status;
 }
 
+FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = furi_hal_sd_read_blocks_uncached(buff, sector, count);
+
+    // Sectors written back lazily are newer than the card
+    if(status == FuriStatusOk) {
+        sector_cache_merge_dirty(sector, count, (uint8_t*)buff);
+    }
+
+    return status;
+}
+
+FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    // Drop cached copies before the card changes under them, dirty ones are superseded
+    if(count > 0) {
+        sector_cache_invalidate_range(sector, sector + count - 1);
+    }
+
+    return furi_hal_sd_write_blocks_uncached(buff, sector, count);
+}
+
 FuriStatus furi_hal_sd_info(FuriHalSdInfo* info) {
     furi_check(info);
 
@@ -1063,20 +1192,10 @@ FuriStatus furi_hal_sd_info(FuriHalSdInfo* info) {
             break;
         }
 
-        if(sd_high_capacity == 1) {
-            info->logical_block_size = 512;
-            info->block_size = 512;
-            info->capacity = ((uint64_t)csd.version.v2.DeviceSize + 1UL) * 1024UL *
-                             (uint64_t)info->logical_block_size;
-            info->logical_block_count = (info->capacity) / (info->logical_block_size);
-        } else {
-            info->capacity = (csd.version.v1.DeviceSize + 1);
-            info->capacity *= (1UL << (csd.version.v1.DeviceSizeMul + 2));
-            info->logical_block_size = 512;
-            info->block_size = 1UL << (csd.RdBlockLen);
-            info->capacity *= info->block_size;
-            info->logical_block_count = (info->capacity) / (info->logical_block_size);
-        }
+        info->logical_block_size = SD_BLOCK_SIZE;
+        info->block_size = sd_high_capacity == 1 ? SD_BLOCK_SIZE : 1UL << (csd.RdBlockLen);
+        info->capacity = sd_spi_get_capacity(&csd);
+        info->logical_block_count = (info->capacity) / (info->logical_block_size);
 
         info->manufacturer_id = cid.ManufacturerID;
 
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <furi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Read blocks from SD card, bypassing the sector cache
+ * Used by the FatFs driver, which keeps the cache itself
+ * @param buff 
+ * @param sector 
+ * @param count 
+ * @return FuriStatus 
+ */
+FuriStatus furi_hal_sd_read_blocks_uncached(uint32_t* buff, uint32_t sector, uint32_t count);
+
+/**
+ * @brief Write blocks to SD card, bypassing the sector cache
+ * Used by the FatFs driver, which keeps the cache itself
+ * @param buff 
+ * @param sector 
+ * @param count 
+ * @return FuriStatus 
+ */
+FuriStatus
+    furi_hal_sd_write_blocks_uncached(const uint32_t* buff, uint32_t sector, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file furi_hal_crc.h
+ * CRC calculation unit HAL API
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initialize CRC HAL */
+void furi_hal_crc_init(void);
+
+/** Acquire CRC calculation unit for exclusive use
+ *
+ * Must be held by anyone gating the unit clock (FuriHalBusCRC), so the bus is
+ * never turned off under a running calculation.
+ *
+ * @param      timeout  timeout in ticks
+ *
+ * @return     true if acquired
+ */
+bool furi_hal_crc_acquire(uint32_t timeout);
+
+/** Release CRC calculation unit */
+void furi_hal_crc_release(void);
+
+/** Calculate CRC32 (IEEE 802.3, as zlib) using the CRC calculation unit
+ *
+ * Thread safe, acquires the unit and configures it on every call. Blocks while
+ * the unit is held with furi_hal_crc_acquire, e.g. during a BLE stack restart.
+ *
+ * @param      crc     previous CRC32 value, 0 to start
+ * @param      buffer  data to feed
+ * @param      size    data size
+ *
+ * @return     updated CRC32 value
+ */
+uint32_t furi_hal_crc32_calc(uint32_t crc, const void* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -52,6 +52,7 @@ FuriStatus furi_hal_sd_init(bool power_reset);
 
 /**
  * @brief Read blocks from SD card
+ * Sectors still held dirty by the file system cache are returned as cached
  * @param buff 
  * @param sector 
  * @param count 
@@ -61,6 +62,7 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
 
 /**
  * @brief Write blocks to SD card
+ * Cached copies of the written sectors are dropped
  * @param buff 
  * @param sector 
  * @param count 
@@ -0,0 +1,46 @@
+#include <core/check.h>
+#include <core/common_defines.h>
+#include <core/thread.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char* furi_check_host_message(const void* message, const char* fallback) {
+    if(message == NULL) {
+        return fallback;
+    } else if(message == (void*)__FURI_ASSERT_MESSAGE_FLAG) {
+        return "furi_assert failed";
+    } else if(message == (void*)__FURI_CHECK_MESSAGE_FLAG) {
+        return "furi_check failed";
+    } else {
+        return message;
+    }
+}
+
+static void furi_check_host_print(const char* kind, const char* message) {
+    // No logging here: crash may happen with log mutex held
+    FuriThread* thread = furi_thread_get_current();
+    const char* name = thread ? furi_thread_get_name(furi_thread_get_id(thread)) : NULL;
+
+    fprintf(stderr, "\r\n\033[0;31m[%s][%s] %s\033[0m\r\n", kind, name ? name : "main", message);
+    fflush(stderr);
+}
+
+FURI_NORETURN void __furi_crash_host(const void* message) {
+    furi_check_host_print("CRASH", furi_check_host_message(message, "Fatal Error"));
+    // Let debugger or core dump catch it with the stack intact
+    abort();
+}
+
+FURI_NORETURN void __furi_halt_host(const void* message) {
+    furi_check_host_print("HALT", furi_check_host_message(message, "System halt requested."));
+    exit(EXIT_FAILURE);
+}
+
+FURI_NORETURN void __furi_crash_implementation(void) {
+    __furi_crash_host(NULL);
+}
+
+FURI_NORETURN void __furi_halt_implementation(void) {
+    __furi_halt_host(NULL);
+}
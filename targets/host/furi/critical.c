@@ -0,0 +1,24 @@
+#include <core/common_defines.h>
+#include <core/check.h>
+
+#include <pthread.h>
+
+// Critical sections exclude each other, not every other thread as on device
+static pthread_mutex_t furi_critical_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+__FuriCriticalInfo __furi_critical_enter(void) {
+    __FuriCriticalInfo info;
+
+    info.isrm = 0;
+    info.from_isr = false;
+    info.kernel_running = true;
+
+    furi_check(pthread_mutex_lock(&furi_critical_mutex) == 0);
+
+    return info;
+}
+
+void __furi_critical_exit(__FuriCriticalInfo info) {
+    UNUSED(info);
+    furi_check(pthread_mutex_unlock(&furi_critical_mutex) == 0);
+}
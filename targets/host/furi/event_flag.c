@@ -0,0 +1,172 @@
+#include "furi_host_i.h"
+
+#include <core/event_flag.h>
+#include <core/common_defines.h>
+#include <core/check.h>
+
+#include <core/event_loop_link_i.h>
+
+#define FURI_EVENT_FLAG_MAX_BITS_EVENT_GROUPS 24U
+#define FURI_EVENT_FLAG_VALID_BITS            ((1UL << FURI_EVENT_FLAG_MAX_BITS_EVENT_GROUPS) - 1U)
+#define FURI_EVENT_FLAG_INVALID_BITS          (~(FURI_EVENT_FLAG_VALID_BITS))
+
+struct FuriEventFlag {
+    pthread_mutex_t guard;
+    pthread_cond_t cond;
+    uint32_t bits;
+    FuriEventLoopLink event_loop_link;
+};
+
+FuriEventFlag* furi_event_flag_alloc(void) {
+    furi_check(!FURI_IS_IRQ_MODE());
+
+    FuriEventFlag* instance = malloc(sizeof(FuriEventFlag));
+
+    furi_check(pthread_mutex_init(&instance->guard, NULL) == 0);
+    furi_host_cond_init(&instance->cond);
+
+    return instance;
+}
+
+void furi_event_flag_free(FuriEventFlag* instance) {
+    furi_check(!FURI_IS_IRQ_MODE());
+
+    // Event Loop must be disconnected
+    furi_check(!instance->event_loop_link.item_in);
+    furi_check(!instance->event_loop_link.item_out);
+
+    pthread_cond_destroy(&instance->cond);
+    pthread_mutex_destroy(&instance->guard);
+    free(instance);
+}
+
+uint32_t furi_event_flag_set(FuriEventFlag* instance, uint32_t flags) {
+    furi_check(instance);
+    furi_check((flags & FURI_EVENT_FLAG_INVALID_BITS) == 0U);
+
+    FURI_CRITICAL_ENTER();
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+    instance->bits |= flags;
+    const uint32_t rflags = instance->bits;
+    pthread_cond_broadcast(&instance->cond);
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    if(rflags & flags) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventIn);
+    }
+
+    FURI_CRITICAL_EXIT();
+
+    /* Return event flags after setting */
+    return rflags;
+}
+
+uint32_t furi_event_flag_clear(FuriEventFlag* instance, uint32_t flags) {
+    furi_check(instance);
+    furi_check((flags & FURI_EVENT_FLAG_INVALID_BITS) == 0U);
+
+    FURI_CRITICAL_ENTER();
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+    const uint32_t rflags = instance->bits;
+    instance->bits &= ~flags;
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    if(rflags & flags) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+    }
+
+    FURI_CRITICAL_EXIT();
+
+    /* Return event flags before clearing */
+    return rflags;
+}
+
+uint32_t furi_event_flag_get(FuriEventFlag* instance) {
+    furi_check(instance);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+    const uint32_t rflags = instance->bits;
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    /* Return current event flags */
+    return rflags;
+}
+
+static bool furi_event_flag_is_set(uint32_t bits, uint32_t flags, uint32_t options) {
+    if(options & FuriFlagWaitAll) {
+        return (bits & flags) == flags;
+    } else {
+        return (bits & flags) != 0U;
+    }
+}
+
+uint32_t furi_event_flag_wait(
+    FuriEventFlag* instance,
+    uint32_t flags,
+    uint32_t options,
+    uint32_t timeout) {
+    furi_check(!FURI_IS_IRQ_MODE());
+    furi_check(instance);
+    furi_check((flags & FURI_EVENT_FLAG_INVALID_BITS) == 0U);
+
+    struct timespec deadline;
+    furi_host_deadline(&deadline, timeout);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+
+    while(!furi_event_flag_is_set(instance->bits, flags, options)) {
+        if(timeout == 0U ||
+           !furi_host_cond_wait(&instance->cond, &instance->guard, &deadline, timeout)) {
+            break;
+        }
+    }
+
+    uint32_t rflags = instance->bits;
+
+    if(furi_event_flag_is_set(rflags, flags, options)) {
+        if(!(options & FuriFlagNoClear)) {
+            instance->bits &= ~flags;
+        }
+    } else if(timeout > 0U) {
+        rflags = (uint32_t)FuriStatusErrorTimeout;
+    } else {
+        rflags = (uint32_t)FuriStatusErrorResource;
+    }
+
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    if((rflags & FuriFlagError) == 0U) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+    }
+
+    /* Return event flags before clearing */
+    return rflags;
+}
+
+static FuriEventLoopLink* furi_event_flag_event_loop_get_link(FuriEventLoopObject* object) {
+    FuriEventFlag* instance = object;
+    furi_assert(instance);
+    return &instance->event_loop_link;
+}
+
+static bool
+    furi_event_flag_event_loop_get_level(FuriEventLoopObject* object, FuriEventLoopEvent event) {
+    FuriEventFlag* instance = object;
+    furi_assert(instance);
+
+    if(event == FuriEventLoopEventIn) {
+        return (furi_event_flag_get(instance) & FURI_EVENT_FLAG_VALID_BITS);
+    } else if(event == FuriEventLoopEventOut) {
+        return (furi_event_flag_get(instance) & FURI_EVENT_FLAG_VALID_BITS) !=
+               FURI_EVENT_FLAG_VALID_BITS;
+    } else {
+        furi_crash();
+    }
+}
+
+const FuriEventLoopContract furi_event_flag_event_loop_contract = {
+    .get_link = furi_event_flag_event_loop_get_link,
+    .get_level = furi_event_flag_event_loop_get_level,
+};
@@ -0,0 +1,33 @@
+#include <furi.h>
+
+#include <core/thread_i.h>
+
+#include <stdio.h>
+
+static void furi_host_log_stdout(const uint8_t* data, size_t size, void* context) {
+    UNUSED(context);
+    fwrite(data, 1, size, stdout);
+    fflush(stdout);
+}
+
+void furi_init(void) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+
+    furi_thread_init();
+    furi_log_init();
+    furi_record_init();
+
+    // There is no serial console, logs go to stdout
+    furi_log_add_handler((FuriLogHandler){.callback = furi_host_log_stdout, .context = NULL});
+}
+
+void furi_run(void) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+
+    // Threads are running since start, main thread becomes the background thread
+    furi_background();
+}
+
+void furi_background(void) {
+    furi_thread_scrub();
+}
@@ -0,0 +1,57 @@
+/**
+ * @file furi_host_i.h
+ * Helpers shared by the POSIX implementation of the furi core
+ */
+#pragma once
+
+#include <core/base.h>
+#include <core/thread.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initialize condition variable that waits on the monotonic clock
+ *
+ * @param      cond  condition variable
+ */
+void furi_host_cond_init(pthread_cond_t* cond);
+
+/** Calculate deadline for a timeout
+ *
+ * @param      deadline  absolute CLOCK_MONOTONIC time
+ * @param      timeout   timeout in ticks, FuriWaitForever is never reached
+ */
+void furi_host_deadline(struct timespec* deadline, uint32_t timeout);
+
+/** Wait on condition variable until deadline
+ *
+ * @param      cond      condition variable
+ * @param      mutex     locked mutex
+ * @param      deadline  deadline from furi_host_deadline
+ * @param      timeout   timeout the deadline was made of
+ *
+ * @return     false if deadline is reached
+ */
+bool furi_host_cond_wait(
+    pthread_cond_t* cond,
+    pthread_mutex_t* mutex,
+    const struct timespec* deadline,
+    uint32_t timeout);
+
+/** Get number of bytes currently allocated from heap
+ *
+ * @return     allocated bytes, including allocator rounding
+ */
+size_t memmgr_host_get_used(void);
+
+/** Park current thread while it is suspended by furi_thread_suspend */
+void furi_thread_host_park(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,17 @@
+#include <host_compat.h>
+
+#ifdef FURI_HOST_STRLCPY
+
+size_t strlcpy(char* dst, const char* src, size_t size) {
+    const size_t length = strlen(src);
+
+    if(size) {
+        const size_t copy = length < size ? length : size - 1;
+        memcpy(dst, src, copy);
+        dst[copy] = '\0';
+    }
+
+    return length;
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include "furi_host_i.h"
+
+#include <core/kernel.h>
+#include <core/check.h>
+#include <core/common_defines.h>
+
+#include <furi_hal_cortex.h>
+
+#include <errno.h>
+#include <sched.h>
+
+// There is no scheduler to suspend: kernel lock serializes lock holders only
+static pthread_mutex_t furi_kernel_lock_mutex = PTHREAD_MUTEX_INITIALIZER;
+static __thread bool furi_kernel_locked = false;
+
+static pthread_once_t furi_kernel_tick_once = PTHREAD_ONCE_INIT;
+static struct timespec furi_kernel_tick_start;
+
+static void furi_kernel_tick_init(void) {
+    clock_gettime(CLOCK_MONOTONIC, &furi_kernel_tick_start);
+}
+
+void furi_host_cond_init(pthread_cond_t* cond) {
+    pthread_condattr_t attr;
+    furi_check(pthread_condattr_init(&attr) == 0);
+    furi_check(pthread_condattr_setclock(&attr, CLOCK_MONOTONIC) == 0);
+    furi_check(pthread_cond_init(cond, &attr) == 0);
+    pthread_condattr_destroy(&attr);
+}
+
+void furi_host_deadline(struct timespec* deadline, uint32_t timeout) {
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+
+    if(timeout == FuriWaitForever) return;
+
+    deadline->tv_sec += timeout / 1000U;
+    deadline->tv_nsec += (long)(timeout % 1000U) * 1000000L;
+    if(deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+bool furi_host_cond_wait(
+    pthread_cond_t* cond,
+    pthread_mutex_t* mutex,
+    const struct timespec* deadline,
+    uint32_t timeout) {
+    if(timeout == FuriWaitForever) {
+        furi_check(pthread_cond_wait(cond, mutex) == 0);
+        return true;
+    }
+
+    int ret = pthread_cond_timedwait(cond, mutex, deadline);
+    furi_check(ret == 0 || ret == ETIMEDOUT);
+
+    return ret == 0;
+}
+
+bool furi_kernel_is_irq_or_masked(void) {
+    // Host code never runs in interrupt context
+    return false;
+}
+
+bool furi_kernel_is_running(void) {
+    return true;
+}
+
+int32_t furi_kernel_lock(void) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+
+    if(furi_kernel_locked) return 1;
+
+    furi_check(pthread_mutex_lock(&furi_kernel_lock_mutex) == 0);
+    furi_kernel_locked = true;
+
+    /* Return previous lock state */
+    return 0;
+}
+
+int32_t furi_kernel_unlock(void) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+
+    if(!furi_kernel_locked) return 0;
+
+    furi_kernel_locked = false;
+    furi_check(pthread_mutex_unlock(&furi_kernel_lock_mutex) == 0);
+
+    /* Return previous lock state */
+    return 1;
+}
+
+int32_t furi_kernel_restore_lock(int32_t lock) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+
+    if(lock == 1) {
+        furi_kernel_lock();
+    } else if(lock == 0) {
+        furi_kernel_unlock();
+    } else {
+        lock = (int32_t)FuriStatusError;
+    }
+
+    /* Return new lock state */
+    return lock;
+}
+
+uint32_t furi_kernel_get_tick_frequency(void) {
+    /* Return frequency in hertz */
+    return 1000U;
+}
+
+void furi_delay_tick(uint32_t ticks) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+
+    furi_thread_host_park();
+
+    if(ticks == 0U) {
+        sched_yield();
+    } else {
+        struct timespec deadline;
+        furi_host_deadline(&deadline, ticks);
+
+        int ret;
+        do {
+            ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+        } while(ret == EINTR);
+    }
+}
+
+FuriStatus furi_delay_until_tick(uint32_t tick) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+
+    FuriStatus stat = FuriStatusOk;
+
+    /* Determine remaining number of tick to delay */
+    const uint32_t delay = tick - furi_get_tick();
+
+    /* Check if target tick has not expired */
+    if((delay != 0U) && (0 == (delay >> 31))) {
+        furi_delay_tick(delay);
+    } else {
+        /* No delay or already expired */
+        stat = FuriStatusErrorParameter;
+    }
+
+    /* Return execution status */
+    return stat;
+}
+
+uint32_t furi_get_tick(void) {
+    pthread_once(&furi_kernel_tick_once, furi_kernel_tick_init);
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    const int64_t ms = (int64_t)(now.tv_sec - furi_kernel_tick_start.tv_sec) * 1000 +
+                       (now.tv_nsec - furi_kernel_tick_start.tv_nsec) / 1000000L;
+
+    return (uint32_t)ms;
+}
+
+uint32_t furi_ms_to_ticks(uint32_t milliseconds) {
+    return milliseconds;
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    furi_delay_tick(milliseconds);
+}
+
+void furi_delay_us(uint32_t microseconds) {
+    furi_hal_cortex_delay_us(microseconds);
+}
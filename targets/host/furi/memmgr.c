@@ -0,0 +1,133 @@
+#include "furi_host_i.h"
+
+#include <core/memmgr.h>
+#include <core/common_defines.h>
+
+#include <malloc.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+// glibc allocator entry points, furi semantics are added on top of them
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void* ptr);
+
+// Nominal heap size, only used to report free heap for leak checks
+#define MEMMGR_HOST_HEAP_SIZE (64U * 1024U * 1024U)
+
+static atomic_size_t memmgr_used = 0;
+static atomic_size_t memmgr_used_max = 0;
+
+static void* memmgr_account(void* p) {
+    if(p == NULL) {
+        // Same as on device, furi never returns NULL from allocator
+        fputs("\r\n[CRASH] Out of memory\r\n", stderr);
+        abort();
+    }
+
+    const size_t size = malloc_usable_size(p);
+    const size_t used = atomic_fetch_add(&memmgr_used, size) + size;
+
+    size_t used_max = atomic_load(&memmgr_used_max);
+    while(used > used_max) {
+        if(atomic_compare_exchange_weak(&memmgr_used_max, &used_max, used)) break;
+    }
+
+    return p;
+}
+
+void* malloc(size_t size) {
+    // Allocated memory is zeroed, as on device
+    return memmgr_account(__libc_calloc(1, size ? size : 1));
+}
+
+void free(void* ptr) {
+    if(ptr == NULL) return;
+
+    atomic_fetch_sub(&memmgr_used, malloc_usable_size(ptr));
+    __libc_free(ptr);
+}
+
+void* realloc(void* ptr, size_t size) {
+    if(size == 0) {
+        free(ptr);
+        return NULL;
+    }
+
+    if(ptr == NULL) return malloc(size);
+
+    atomic_fetch_sub(&memmgr_used, malloc_usable_size(ptr));
+    return memmgr_account(__libc_realloc(ptr, size));
+}
+
+void* calloc(size_t count, size_t size) {
+    size_t total;
+    if(__builtin_mul_overflow(count, size, &total)) {
+        memmgr_account(NULL);
+    }
+
+    return malloc(total);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    return memmgr_account(__libc_memalign(alignment, size ? size : 1));
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+    *ptr = memalign(alignment, size);
+    return 0;
+}
+
+size_t memmgr_get_free_heap(void) {
+    const size_t used = atomic_load(&memmgr_used);
+    return used < MEMMGR_HOST_HEAP_SIZE ? MEMMGR_HOST_HEAP_SIZE - used : 0;
+}
+
+size_t memmgr_get_total_heap(void) {
+    return MEMMGR_HOST_HEAP_SIZE;
+}
+
+size_t memmgr_get_minimum_free_heap(void) {
+    const size_t used_max = atomic_load(&memmgr_used_max);
+    return used_max < MEMMGR_HOST_HEAP_SIZE ? MEMMGR_HOST_HEAP_SIZE - used_max : 0;
+}
+
+void* memmgr_alloc_from_pool(size_t size) {
+    // No SRAM2 pool on host
+    return malloc(size);
+}
+
+size_t memmgr_pool_get_free(void) {
+    return 0;
+}
+
+size_t memmgr_pool_get_max_block(void) {
+    return 0;
+}
+
+void* aligned_malloc(size_t size, size_t alignment) {
+    void* p1; // original block
+    void** p2; // aligned block
+    int offset = alignment - 1 + sizeof(void*);
+    if((p1 = (void*)malloc(size + offset)) == NULL) {
+        return NULL;
+    }
+    p2 = (void**)(((size_t)(p1) + offset) & ~(alignment - 1));
+    p2[-1] = p1;
+    return p2;
+}
+
+void aligned_free(void* p) {
+    if(p) {
+        free(((void**)p)[-1]);
+    }
+}
+
+size_t memmgr_host_get_used(void) {
+    return atomic_load(&memmgr_used);
+}
@@ -0,0 +1,29 @@
+#include "furi_host_i.h"
+
+#include <core/memmgr.h>
+#include <core/memmgr_heap.h>
+#include <core/common_defines.h>
+
+#include <stdio.h>
+
+void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
+    // Allocations are not tagged with the owner thread on host
+    UNUSED(thread_id);
+}
+
+void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+}
+
+size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    return MEMMGR_HEAP_UNKNOWN;
+}
+
+size_t memmgr_heap_get_max_free_block(void) {
+    return memmgr_get_free_heap();
+}
+
+void memmgr_heap_printf_free_blocks(void) {
+    printf("Used: %zu, free: %zu\r\n", memmgr_host_get_used(), memmgr_get_free_heap());
+}
@@ -0,0 +1,205 @@
+#include "furi_host_i.h"
+
+#include <core/message_queue.h>
+#include <core/kernel.h>
+#include <core/check.h>
+
+#include <core/event_loop_link_i.h>
+
+#include <string.h>
+
+struct FuriMessageQueue {
+    pthread_mutex_t guard;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    uint32_t capacity;
+    uint32_t message_size;
+    uint32_t count;
+    uint32_t head;
+    FuriEventLoopLink event_loop_link;
+    uint8_t buffer[];
+};
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
+    furi_check((furi_kernel_is_irq_or_masked() == 0U) && (msg_count > 0U) && (msg_size > 0U));
+
+    FuriMessageQueue* instance = malloc(sizeof(FuriMessageQueue) + msg_count * msg_size);
+
+    furi_check(pthread_mutex_init(&instance->guard, NULL) == 0);
+    furi_host_cond_init(&instance->not_empty);
+    furi_host_cond_init(&instance->not_full);
+    instance->capacity = msg_count;
+    instance->message_size = msg_size;
+
+    return instance;
+}
+
+void furi_message_queue_free(FuriMessageQueue* instance) {
+    furi_check(furi_kernel_is_irq_or_masked() == 0U);
+    furi_check(instance);
+
+    // Event Loop must be disconnected
+    furi_check(!instance->event_loop_link.item_in);
+    furi_check(!instance->event_loop_link.item_out);
+
+    pthread_cond_destroy(&instance->not_full);
+    pthread_cond_destroy(&instance->not_empty);
+    pthread_mutex_destroy(&instance->guard);
+    free(instance);
+}
+
+FuriStatus
+    furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout) {
+    furi_check(instance);
+
+    if(msg_ptr == NULL) return FuriStatusErrorParameter;
+
+    FuriStatus stat = FuriStatusOk;
+
+    struct timespec deadline;
+    furi_host_deadline(&deadline, timeout);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+
+    while(instance->count == instance->capacity) {
+        if(timeout == 0U) {
+            stat = FuriStatusErrorResource;
+            break;
+        } else if(!furi_host_cond_wait(
+                      &instance->not_full, &instance->guard, &deadline, timeout)) {
+            stat = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+
+    if(stat == FuriStatusOk) {
+        const uint32_t tail = (instance->head + instance->count) % instance->capacity;
+        memcpy(
+            &instance->buffer[tail * instance->message_size], msg_ptr, instance->message_size);
+        instance->count++;
+        pthread_cond_signal(&instance->not_empty);
+    }
+
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventIn);
+    }
+
+    /* Return execution status */
+    return stat;
+}
+
+FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout) {
+    furi_check(instance);
+
+    if(msg_ptr == NULL) return FuriStatusErrorParameter;
+
+    FuriStatus stat = FuriStatusOk;
+
+    struct timespec deadline;
+    furi_host_deadline(&deadline, timeout);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+
+    while(instance->count == 0U) {
+        if(timeout == 0U) {
+            stat = FuriStatusErrorResource;
+            break;
+        } else if(!furi_host_cond_wait(
+                      &instance->not_empty, &instance->guard, &deadline, timeout)) {
+            stat = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+
+    if(stat == FuriStatusOk) {
+        memcpy(
+            msg_ptr,
+            &instance->buffer[instance->head * instance->message_size],
+            instance->message_size);
+        instance->head = (instance->head + 1) % instance->capacity;
+        instance->count--;
+        pthread_cond_signal(&instance->not_full);
+    }
+
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+    }
+
+    return stat;
+}
+
+uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
+    furi_check(instance);
+
+    return instance->capacity;
+}
+
+uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
+    furi_check(instance);
+
+    return instance->message_size;
+}
+
+uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
+    furi_check(instance);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+    const uint32_t count = instance->count;
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    return count;
+}
+
+uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
+    furi_check(instance);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+    const uint32_t space = instance->capacity - instance->count;
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    return space;
+}
+
+FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
+    furi_check(instance);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+    instance->count = 0;
+    instance->head = 0;
+    pthread_cond_broadcast(&instance->not_full);
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+
+    /* Return execution status */
+    return FuriStatusOk;
+}
+
+static FuriEventLoopLink* furi_message_queue_event_loop_get_link(FuriEventLoopObject* object) {
+    FuriMessageQueue* instance = object;
+    furi_assert(instance);
+    return &instance->event_loop_link;
+}
+
+static bool
+    furi_message_queue_event_loop_get_level(FuriEventLoopObject* object, FuriEventLoopEvent event) {
+    FuriMessageQueue* instance = object;
+    furi_assert(instance);
+
+    if(event == FuriEventLoopEventIn) {
+        return furi_message_queue_get_count(instance);
+    } else if(event == FuriEventLoopEventOut) {
+        return furi_message_queue_get_space(instance);
+    } else {
+        furi_crash();
+    }
+}
+
+const FuriEventLoopContract furi_message_queue_event_loop_contract = {
+    .get_link = furi_message_queue_event_loop_get_link,
+    .get_level = furi_message_queue_event_loop_get_level,
+};
@@ -0,0 +1,138 @@
+#include "furi_host_i.h"
+
+#include <core/mutex.h>
+#include <core/check.h>
+
+#include <core/event_loop_link_i.h>
+
+struct FuriMutex {
+    pthread_mutex_t guard;
+    pthread_cond_t cond;
+    FuriMutexType type;
+    FuriThreadId owner;
+    uint32_t count;
+    FuriEventLoopLink event_loop_link;
+};
+
+FuriMutex* furi_mutex_alloc(FuriMutexType type) {
+    furi_check(!FURI_IS_IRQ_MODE());
+    furi_check(type == FuriMutexTypeNormal || type == FuriMutexTypeRecursive);
+
+    FuriMutex* instance = malloc(sizeof(FuriMutex));
+
+    furi_check(pthread_mutex_init(&instance->guard, NULL) == 0);
+    furi_host_cond_init(&instance->cond);
+    instance->type = type;
+
+    return instance;
+}
+
+void furi_mutex_free(FuriMutex* instance) {
+    furi_check(!FURI_IS_IRQ_MODE());
+    furi_check(instance);
+
+    // Event Loop must be disconnected
+    furi_check(!instance->event_loop_link.item_in);
+    furi_check(!instance->event_loop_link.item_out);
+
+    pthread_cond_destroy(&instance->cond);
+    pthread_mutex_destroy(&instance->guard);
+    free(instance);
+}
+
+FuriStatus furi_mutex_acquire(FuriMutex* instance, uint32_t timeout) {
+    furi_check(instance);
+
+    const FuriThreadId self = furi_thread_get_current_id();
+    FuriStatus stat = FuriStatusOk;
+
+    struct timespec deadline;
+    furi_host_deadline(&deadline, timeout);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+
+    if(instance->type == FuriMutexTypeRecursive && instance->owner == self) {
+        instance->count++;
+    } else {
+        // Normal mutex taken twice by the same thread times out, as on device
+        while(instance->owner) {
+            if(timeout == 0U) {
+                stat = FuriStatusErrorResource;
+                break;
+            } else if(!furi_host_cond_wait(
+                          &instance->cond, &instance->guard, &deadline, timeout)) {
+                stat = FuriStatusErrorTimeout;
+                break;
+            }
+        }
+
+        if(stat == FuriStatusOk) {
+            instance->owner = self;
+            instance->count = 1;
+        }
+    }
+
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+    }
+
+    return stat;
+}
+
+FuriStatus furi_mutex_release(FuriMutex* instance) {
+    furi_check(instance);
+
+    FuriStatus stat = FuriStatusOk;
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+
+    if(instance->owner != furi_thread_get_current_id()) {
+        stat = FuriStatusErrorResource;
+    } else if(--instance->count == 0) {
+        instance->owner = NULL;
+        pthread_cond_signal(&instance->cond);
+    }
+
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventIn);
+    }
+
+    return stat;
+}
+
+FuriThreadId furi_mutex_get_owner(FuriMutex* instance) {
+    furi_check(instance);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+    FuriThreadId owner = instance->owner;
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    return owner;
+}
+
+static FuriEventLoopLink* furi_mutex_event_loop_get_link(FuriEventLoopObject* object) {
+    FuriMutex* instance = object;
+    furi_assert(instance);
+    return &instance->event_loop_link;
+}
+
+static bool
+    furi_mutex_event_loop_get_level(FuriEventLoopObject* object, FuriEventLoopEvent event) {
+    FuriMutex* instance = object;
+    furi_assert(instance);
+
+    if(event == FuriEventLoopEventIn || event == FuriEventLoopEventOut) {
+        return !furi_mutex_get_owner(instance);
+    } else {
+        furi_crash();
+    }
+}
+
+const FuriEventLoopContract furi_mutex_event_loop_contract = {
+    .get_link = furi_mutex_event_loop_get_link,
+    .get_level = furi_mutex_event_loop_get_level,
+};
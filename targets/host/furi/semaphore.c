@@ -0,0 +1,142 @@
+#include "furi_host_i.h"
+
+#include <core/semaphore.h>
+#include <core/check.h>
+
+#include <core/event_loop_link_i.h>
+
+struct FuriSemaphore {
+    pthread_mutex_t guard;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t max_count;
+    FuriEventLoopLink event_loop_link;
+};
+
+FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count) {
+    furi_check(!FURI_IS_IRQ_MODE());
+    furi_check((max_count > 0U) && (initial_count <= max_count));
+
+    FuriSemaphore* instance = malloc(sizeof(FuriSemaphore));
+
+    furi_check(pthread_mutex_init(&instance->guard, NULL) == 0);
+    furi_host_cond_init(&instance->cond);
+    instance->count = initial_count;
+    instance->max_count = max_count;
+
+    return instance;
+}
+
+void furi_semaphore_free(FuriSemaphore* instance) {
+    furi_check(instance);
+    furi_check(!FURI_IS_IRQ_MODE());
+
+    // Event Loop must be disconnected
+    furi_check(!instance->event_loop_link.item_in);
+    furi_check(!instance->event_loop_link.item_out);
+
+    pthread_cond_destroy(&instance->cond);
+    pthread_mutex_destroy(&instance->guard);
+    free(instance);
+}
+
+FuriStatus furi_semaphore_acquire(FuriSemaphore* instance, uint32_t timeout) {
+    furi_check(instance);
+
+    FuriStatus stat = FuriStatusOk;
+
+    struct timespec deadline;
+    furi_host_deadline(&deadline, timeout);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+
+    while(instance->count == 0U) {
+        if(timeout == 0U) {
+            stat = FuriStatusErrorResource;
+            break;
+        } else if(!furi_host_cond_wait(&instance->cond, &instance->guard, &deadline, timeout)) {
+            stat = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+
+    if(stat == FuriStatusOk) {
+        instance->count--;
+    }
+
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+    }
+
+    return stat;
+}
+
+FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
+    furi_check(instance);
+
+    FuriStatus stat = FuriStatusOk;
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+
+    if(instance->count < instance->max_count) {
+        instance->count++;
+        pthread_cond_signal(&instance->cond);
+    } else {
+        stat = FuriStatusErrorResource;
+    }
+
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventIn);
+    }
+
+    return stat;
+}
+
+uint32_t furi_semaphore_get_count(FuriSemaphore* instance) {
+    furi_check(instance);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+    const uint32_t count = instance->count;
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    return count;
+}
+
+uint32_t furi_semaphore_get_space(FuriSemaphore* instance) {
+    furi_assert(instance);
+
+    furi_check(pthread_mutex_lock(&instance->guard) == 0);
+    const uint32_t space = instance->max_count - instance->count;
+    furi_check(pthread_mutex_unlock(&instance->guard) == 0);
+
+    return space;
+}
+
+static FuriEventLoopLink* furi_semaphore_event_loop_get_link(FuriEventLoopObject* object) {
+    FuriSemaphore* instance = object;
+    furi_assert(instance);
+    return &instance->event_loop_link;
+}
+
+static bool
+    furi_semaphore_event_loop_get_level(FuriEventLoopObject* object, FuriEventLoopEvent event) {
+    FuriSemaphore* instance = object;
+    furi_assert(instance);
+
+    if(event == FuriEventLoopEventIn) {
+        return furi_semaphore_get_count(instance);
+    } else if(event == FuriEventLoopEventOut) {
+        return furi_semaphore_get_space(instance);
+    } else {
+        furi_crash();
+    }
+}
+
+const FuriEventLoopContract furi_semaphore_event_loop_contract = {
+    .get_link = furi_semaphore_event_loop_get_link,
+    .get_level = furi_semaphore_event_loop_get_level,
+};
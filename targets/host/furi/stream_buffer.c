@@ -0,0 +1,219 @@
+#include "furi_host_i.h"
+
+#include <core/stream_buffer.h>
+#include <core/check.h>
+#include <core/common_defines.h>
+
+#include <core/event_loop_link_i.h>
+
+#include <string.h>
+
+struct FuriStreamBuffer {
+    pthread_mutex_t guard;
+    pthread_cond_t cond;
+    size_t size;
+    size_t trigger_level;
+    size_t head;
+    size_t count;
+    FuriEventLoopLink event_loop_link;
+    uint8_t buffer[];
+};
+
+FuriStreamBuffer* furi_stream_buffer_alloc(size_t size, size_t trigger_level) {
+    furi_check(size != 0);
+    furi_check(trigger_level <= size);
+
+    FuriStreamBuffer* stream_buffer = malloc(sizeof(FuriStreamBuffer) + size);
+
+    furi_check(pthread_mutex_init(&stream_buffer->guard, NULL) == 0);
+    furi_host_cond_init(&stream_buffer->cond);
+    stream_buffer->size = size;
+    // Same as FreeRTOS, zero trigger level means one byte
+    stream_buffer->trigger_level = trigger_level ? trigger_level : 1;
+
+    return stream_buffer;
+}
+
+void furi_stream_buffer_free(FuriStreamBuffer* stream_buffer) {
+    furi_check(stream_buffer);
+
+    // Event Loop must be disconnected
+    furi_check(!stream_buffer->event_loop_link.item_in);
+    furi_check(!stream_buffer->event_loop_link.item_out);
+
+    pthread_cond_destroy(&stream_buffer->cond);
+    pthread_mutex_destroy(&stream_buffer->guard);
+    free(stream_buffer);
+}
+
+bool furi_stream_set_trigger_level(FuriStreamBuffer* stream_buffer, size_t trigger_level) {
+    furi_check(stream_buffer);
+
+    if(trigger_level > stream_buffer->size) return false;
+
+    furi_check(pthread_mutex_lock(&stream_buffer->guard) == 0);
+    stream_buffer->trigger_level = trigger_level ? trigger_level : 1;
+    pthread_cond_broadcast(&stream_buffer->cond);
+    furi_check(pthread_mutex_unlock(&stream_buffer->guard) == 0);
+
+    return true;
+}
+
+size_t furi_stream_get_trigger_level(FuriStreamBuffer* stream_buffer) {
+    furi_check(stream_buffer);
+    return stream_buffer->trigger_level;
+}
+
+size_t furi_stream_buffer_send(
+    FuriStreamBuffer* stream_buffer,
+    const void* data,
+    size_t length,
+    uint32_t timeout) {
+    furi_check(stream_buffer);
+
+    struct timespec deadline;
+    furi_host_deadline(&deadline, timeout);
+
+    furi_check(pthread_mutex_lock(&stream_buffer->guard) == 0);
+
+    // Wait for the whole message to fit, then send as much as possible
+    const size_t required = MIN(length, stream_buffer->size);
+    while(timeout && (stream_buffer->size - stream_buffer->count) < required) {
+        if(!furi_host_cond_wait(
+               &stream_buffer->cond, &stream_buffer->guard, &deadline, timeout)) {
+            break;
+        }
+    }
+
+    const size_t ret = MIN(length, stream_buffer->size - stream_buffer->count);
+    const uint8_t* src = data;
+    for(size_t i = 0; i < ret;) {
+        const size_t tail = (stream_buffer->head + stream_buffer->count) % stream_buffer->size;
+        const size_t chunk = MIN(ret - i, stream_buffer->size - tail);
+        memcpy(&stream_buffer->buffer[tail], &src[i], chunk);
+        stream_buffer->count += chunk;
+        i += chunk;
+    }
+
+    const size_t bytes_available = stream_buffer->count;
+    const size_t trigger_level = stream_buffer->trigger_level;
+    if(ret > 0) pthread_cond_broadcast(&stream_buffer->cond);
+
+    furi_check(pthread_mutex_unlock(&stream_buffer->guard) == 0);
+
+    if(ret > 0 && bytes_available >= trigger_level) {
+        furi_event_loop_link_notify(&stream_buffer->event_loop_link, FuriEventLoopEventIn);
+    }
+
+    return ret;
+}
+
+size_t furi_stream_buffer_receive(
+    FuriStreamBuffer* stream_buffer,
+    void* data,
+    size_t length,
+    uint32_t timeout) {
+    furi_check(stream_buffer);
+
+    struct timespec deadline;
+    furi_host_deadline(&deadline, timeout);
+
+    furi_check(pthread_mutex_lock(&stream_buffer->guard) == 0);
+
+    // Empty buffer blocks until trigger level is reached, as in FreeRTOS
+    if(stream_buffer->count == 0) {
+        while(timeout && stream_buffer->count < stream_buffer->trigger_level) {
+            if(!furi_host_cond_wait(
+                   &stream_buffer->cond, &stream_buffer->guard, &deadline, timeout)) {
+                break;
+            }
+        }
+    }
+
+    const size_t ret = MIN(length, stream_buffer->count);
+    uint8_t* dst = data;
+    for(size_t i = 0; i < ret;) {
+        const size_t chunk = MIN(ret - i, stream_buffer->size - stream_buffer->head);
+        memcpy(&dst[i], &stream_buffer->buffer[stream_buffer->head], chunk);
+        stream_buffer->head = (stream_buffer->head + chunk) % stream_buffer->size;
+        stream_buffer->count -= chunk;
+        i += chunk;
+    }
+
+    if(ret > 0) pthread_cond_broadcast(&stream_buffer->cond);
+
+    furi_check(pthread_mutex_unlock(&stream_buffer->guard) == 0);
+
+    if(ret > 0) {
+        furi_event_loop_link_notify(&stream_buffer->event_loop_link, FuriEventLoopEventOut);
+    }
+
+    return ret;
+}
+
+size_t furi_stream_buffer_bytes_available(FuriStreamBuffer* stream_buffer) {
+    furi_check(stream_buffer);
+
+    furi_check(pthread_mutex_lock(&stream_buffer->guard) == 0);
+    const size_t count = stream_buffer->count;
+    furi_check(pthread_mutex_unlock(&stream_buffer->guard) == 0);
+
+    return count;
+}
+
+size_t furi_stream_buffer_spaces_available(FuriStreamBuffer* stream_buffer) {
+    furi_check(stream_buffer);
+
+    return stream_buffer->size - furi_stream_buffer_bytes_available(stream_buffer);
+}
+
+bool furi_stream_buffer_is_full(FuriStreamBuffer* stream_buffer) {
+    furi_check(stream_buffer);
+
+    return furi_stream_buffer_spaces_available(stream_buffer) == 0;
+}
+
+bool furi_stream_buffer_is_empty(FuriStreamBuffer* stream_buffer) {
+    furi_check(stream_buffer);
+
+    return furi_stream_buffer_bytes_available(stream_buffer) == 0;
+}
+
+FuriStatus furi_stream_buffer_reset(FuriStreamBuffer* stream_buffer) {
+    furi_check(stream_buffer);
+
+    furi_check(pthread_mutex_lock(&stream_buffer->guard) == 0);
+    stream_buffer->head = 0;
+    stream_buffer->count = 0;
+    pthread_cond_broadcast(&stream_buffer->cond);
+    furi_check(pthread_mutex_unlock(&stream_buffer->guard) == 0);
+
+    furi_event_loop_link_notify(&stream_buffer->event_loop_link, FuriEventLoopEventOut);
+
+    return FuriStatusOk;
+}
+
+static FuriEventLoopLink* furi_stream_buffer_event_loop_get_link(FuriEventLoopObject* object) {
+    FuriStreamBuffer* stream_buffer = object;
+    furi_assert(stream_buffer);
+    return &stream_buffer->event_loop_link;
+}
+
+static bool
+    furi_stream_buffer_event_loop_get_level(FuriEventLoopObject* object, FuriEventLoopEvent event) {
+    FuriStreamBuffer* stream_buffer = object;
+    furi_assert(stream_buffer);
+
+    if(event == FuriEventLoopEventIn) {
+        return furi_stream_buffer_bytes_available(stream_buffer);
+    } else if(event == FuriEventLoopEventOut) {
+        return furi_stream_buffer_spaces_available(stream_buffer);
+    } else {
+        furi_crash();
+    }
+}
+
+const FuriEventLoopContract furi_stream_buffer_event_loop_contract = {
+    .get_link = furi_stream_buffer_event_loop_get_link,
+    .get_level = furi_stream_buffer_event_loop_get_level,
+};
@@ -0,0 +1,1016 @@
+#include "furi_host_i.h"
+
+#include <core/thread_i.h>
+#include <core/thread_list_i.h>
+#include <core/kernel.h>
+#include <core/memmgr.h>
+#include <core/memmgr_heap.h>
+#include <core/check.h>
+#include <core/common_defines.h>
+#include <core/string.h>
+#include <core/event_loop_thread_flag_interface.h>
+#include <core/log.h>
+
+#include <furi_hal_rtc.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <limits.h>
+#include <sched.h>
+#include <string.h>
+
+#define TAG "FuriThread"
+
+#define THREAD_NOTIFY_INDEX (1) // Index 0 is used for stream buffers
+#define THREAD_NOTIFY_COUNT (3) // Index 2 is used by event loop
+
+// Host code needs much more stack than the same code on device
+#define THREAD_HOST_STACK_MIN   (256U * 1024U)
+#define THREAD_HOST_STACK_SCALE (4U)
+
+typedef struct {
+    FuriThreadStdoutWriteCallback write_callback;
+    FuriString* buffer;
+    void* context;
+} FuriThreadStdout;
+
+typedef struct {
+    FuriThreadStdinReadCallback read_callback;
+    FuriString* unread_buffer; // <! stores data from `ungetc` and friends
+    void* context;
+} FuriThreadStdin;
+
+typedef struct {
+    uint32_t value;
+    bool pending;
+} FuriThreadNotify;
+
+struct FuriThread {
+    pthread_t task;
+
+    volatile FuriThreadState state;
+    int32_t ret;
+
+    FuriThreadCallback callback;
+    void* context;
+
+    FuriThreadStateCallback state_callback;
+    void* state_context;
+
+    FuriThreadSignalCallback signal_callback;
+    void* signal_context;
+
+    char* name;
+    char* appid;
+
+    FuriThreadPriority priority;
+
+    size_t stack_size;
+    size_t heap_size;
+
+    FuriThreadStdout output;
+    FuriThreadStdin input;
+
+    // Task notifications, guarded by notify_mutex
+    pthread_mutex_t notify_mutex;
+    pthread_cond_t notify_cond;
+    FuriThreadNotify notify[THREAD_NOTIFY_COUNT];
+    bool is_suspended;
+
+    // Running threads, guarded by furi_thread_registry_mutex
+    FuriThread* registry_prev;
+    FuriThread* registry_next;
+
+    // Keep all non-alignable byte types in one place,
+    // this ensures that the size of this structure is minimal
+    bool is_service;
+    bool is_adopted;
+    bool is_joinable;
+    bool heap_trace_enabled;
+};
+
+static pthread_mutex_t furi_thread_registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+static FuriThread* furi_thread_registry = NULL;
+
+static pthread_once_t furi_thread_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t furi_thread_key;
+
+static size_t __furi_thread_stdout_write(FuriThread* thread, const char* data, size_t size);
+static int32_t __furi_thread_stdout_flush(FuriThread* thread);
+
+static void furi_thread_registry_add(FuriThread* thread) {
+    furi_check(pthread_mutex_lock(&furi_thread_registry_mutex) == 0);
+    thread->registry_prev = NULL;
+    thread->registry_next = furi_thread_registry;
+    if(furi_thread_registry) furi_thread_registry->registry_prev = thread;
+    furi_thread_registry = thread;
+    furi_check(pthread_mutex_unlock(&furi_thread_registry_mutex) == 0);
+}
+
+static void furi_thread_registry_remove(FuriThread* thread) {
+    furi_check(pthread_mutex_lock(&furi_thread_registry_mutex) == 0);
+    if(thread->registry_prev) {
+        thread->registry_prev->registry_next = thread->registry_next;
+    } else {
+        furi_thread_registry = thread->registry_next;
+    }
+    if(thread->registry_next) thread->registry_next->registry_prev = thread->registry_prev;
+    thread->registry_prev = NULL;
+    thread->registry_next = NULL;
+    furi_check(pthread_mutex_unlock(&furi_thread_registry_mutex) == 0);
+}
+
+static void furi_thread_set_state(FuriThread* thread, FuriThreadState state) {
+    furi_assert(thread);
+    thread->state = state;
+    if(thread->state_callback) {
+        thread->state_callback(thread, state, thread->state_context);
+    }
+}
+
+static void furi_thread_release_adopted(void* context) {
+    FuriThread* thread = context;
+    if(!thread->is_adopted) return;
+
+    furi_thread_registry_remove(thread);
+    furi_string_free(thread->output.buffer);
+    furi_string_free(thread->input.unread_buffer);
+    pthread_cond_destroy(&thread->notify_cond);
+    pthread_mutex_destroy(&thread->notify_mutex);
+    free(thread->name);
+    free(thread->appid);
+    free(thread);
+}
+
+static void furi_thread_key_init(void) {
+    // Only threads that were not started by furi are released on exit
+    furi_check(pthread_key_create(&furi_thread_key, furi_thread_release_adopted) == 0);
+}
+
+static void furi_thread_set_current(FuriThread* thread) {
+    pthread_once(&furi_thread_key_once, furi_thread_key_init);
+    furi_check(pthread_setspecific(furi_thread_key, thread) == 0);
+}
+
+static void* furi_thread_body(void* context) {
+    furi_check(context);
+    FuriThread* thread = context;
+
+    // store thread instance to thread local storage
+    furi_thread_set_current(thread);
+
+    furi_check(thread->state == FuriThreadStateStarting);
+    furi_thread_set_state(thread, FuriThreadStateRunning);
+
+    thread->ret = thread->callback(thread->context);
+
+    furi_check(!thread->is_service, "Service threads MUST NOT return");
+
+    if(thread->heap_trace_enabled == true) {
+        thread->heap_size = memmgr_heap_get_thread_memory((FuriThreadId)thread);
+    }
+
+    furi_check(thread->state == FuriThreadStateRunning);
+
+    // flush stdout
+    __furi_thread_stdout_flush(thread);
+
+    furi_thread_set_state(thread, FuriThreadStateStopping);
+
+    // Nothing to scrub on host, thread is released by join
+    furi_thread_registry_remove(thread);
+    furi_check(pthread_setspecific(furi_thread_key, NULL) == 0);
+
+    furi_thread_set_state(thread, FuriThreadStateStopped);
+
+    return NULL;
+}
+
+static void furi_thread_init_common(FuriThread* thread) {
+    thread->output.buffer = furi_string_alloc();
+    thread->input.unread_buffer = furi_string_alloc();
+
+    furi_check(pthread_mutex_init(&thread->notify_mutex, NULL) == 0);
+    furi_host_cond_init(&thread->notify_cond);
+
+    FuriThread* parent = furi_thread_get_current();
+    if(parent && parent->appid) {
+        furi_thread_set_appid(thread, parent->appid);
+    } else if(parent) {
+        furi_thread_set_appid(thread, "unknown");
+    } else {
+        // if there is no furi thread yet, we are starting driver thread
+        furi_thread_set_appid(thread, "driver");
+    }
+
+    thread->priority = FuriThreadPriorityNormal;
+
+    FuriHalRtcHeapTrackMode mode = furi_hal_rtc_get_heap_track_mode();
+    if(mode == FuriHalRtcHeapTrackModeAll) {
+        thread->heap_trace_enabled = true;
+    } else if(mode == FuriHalRtcHeapTrackModeTree && parent) {
+        thread->heap_trace_enabled = parent->heap_trace_enabled;
+    } else {
+        thread->heap_trace_enabled = false;
+    }
+}
+
+/** Make a FuriThread for a thread that was not started by furi */
+static FuriThread* furi_thread_adopt(void) {
+    FuriThread* thread = malloc(sizeof(FuriThread));
+
+    furi_thread_init_common(thread);
+
+    thread->task = pthread_self();
+    thread->is_adopted = true;
+    thread->state = FuriThreadStateRunning;
+
+    furi_thread_registry_add(thread);
+    furi_thread_set_current(thread);
+
+    return thread;
+}
+
+void furi_thread_init(void) {
+    // Caller becomes the main thread
+    if(!furi_thread_get_current()) {
+        furi_thread_adopt();
+    }
+}
+
+void furi_thread_scrub(void) {
+    // Threads are released by join, nothing is ever posted here
+    while(true) {
+        furi_delay_tick(FuriWaitForever - 1);
+    }
+}
+
+FuriThread* furi_thread_alloc(void) {
+    FuriThread* thread = malloc(sizeof(FuriThread));
+
+    furi_thread_init_common(thread);
+
+    return thread;
+}
+
+FuriThread* furi_thread_alloc_service(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context) {
+    FuriThread* thread = memmgr_alloc_from_pool(sizeof(FuriThread));
+
+    furi_thread_init_common(thread);
+
+    thread->stack_size = stack_size;
+    thread->is_service = true;
+
+    furi_thread_set_name(thread, name);
+    furi_thread_set_callback(thread, callback);
+    furi_thread_set_context(thread, context);
+
+    return thread;
+}
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context) {
+    FuriThread* thread = furi_thread_alloc();
+    furi_thread_set_name(thread, name);
+    furi_thread_set_stack_size(thread, stack_size);
+    furi_thread_set_callback(thread, callback);
+    furi_thread_set_context(thread, context);
+    return thread;
+}
+
+static void furi_thread_reap(FuriThread* thread) {
+    if(thread->is_joinable) {
+        furi_check(pthread_join(thread->task, NULL) == 0);
+        thread->is_joinable = false;
+    }
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_check(thread);
+    // Cannot free a service thread
+    furi_check(thread->is_service == false);
+    // Cannot free a non-joined thread
+    furi_check(thread->state == FuriThreadStateStopped);
+
+    furi_thread_reap(thread);
+
+    furi_thread_set_name(thread, NULL);
+    furi_thread_set_appid(thread, NULL);
+
+    pthread_cond_destroy(&thread->notify_cond);
+    pthread_mutex_destroy(&thread->notify_mutex);
+
+    furi_string_free(thread->output.buffer);
+    furi_string_free(thread->input.unread_buffer);
+    free(thread);
+}
+
+void furi_thread_set_name(FuriThread* thread, const char* name) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+
+    if(thread->name) {
+        free(thread->name);
+    }
+
+    thread->name = name ? strdup(name) : NULL;
+}
+
+void furi_thread_set_appid(FuriThread* thread, const char* appid) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+
+    if(thread->appid) {
+        free(thread->appid);
+    }
+
+    thread->appid = appid ? strdup(appid) : NULL;
+}
+
+void furi_thread_set_stack_size(FuriThread* thread, size_t stack_size) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    furi_check(stack_size);
+    furi_check(stack_size % sizeof(uint32_t) == 0);
+    // Stack size cannot be configured for a thread that has been marked as a service
+    furi_check(thread->is_service == false);
+
+    thread->stack_size = stack_size;
+}
+
+void furi_thread_set_callback(FuriThread* thread, FuriThreadCallback callback) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    thread->callback = callback;
+}
+
+void furi_thread_set_context(FuriThread* thread, void* context) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    thread->context = context;
+}
+
+void furi_thread_set_priority(FuriThread* thread, FuriThreadPriority priority) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    furi_check(priority <= FuriThreadPriorityIsr);
+    thread->priority = priority;
+}
+
+FuriThreadPriority furi_thread_get_priority(FuriThread* thread) {
+    furi_check(thread);
+    // Priorities are kept for API parity, host scheduler ignores them
+    return thread->priority;
+}
+
+void furi_thread_set_current_priority(FuriThreadPriority priority) {
+    furi_check(priority <= FuriThreadPriorityIsr);
+    ((FuriThread*)furi_thread_get_current_id())->priority = priority;
+}
+
+FuriThreadPriority furi_thread_get_current_priority(void) {
+    return ((FuriThread*)furi_thread_get_current_id())->priority;
+}
+
+void furi_thread_set_state_callback(FuriThread* thread, FuriThreadStateCallback callback) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    thread->state_callback = callback;
+}
+
+void furi_thread_set_state_context(FuriThread* thread, void* context) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    thread->state_context = context;
+}
+
+FuriThreadState furi_thread_get_state(FuriThread* thread) {
+    furi_check(thread);
+    return thread->state;
+}
+
+void furi_thread_set_signal_callback(
+    FuriThread* thread,
+    FuriThreadSignalCallback callback,
+    void* context) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped || thread == furi_thread_get_current());
+
+    thread->signal_callback = callback;
+    thread->signal_context = context;
+}
+
+FuriThreadSignalCallback furi_thread_get_signal_callback(const FuriThread* thread) {
+    furi_check(thread);
+
+    return thread->signal_callback;
+}
+
+bool furi_thread_signal(const FuriThread* thread, uint32_t signal, void* arg) {
+    furi_check(thread);
+
+    bool is_consumed = false;
+
+    if(thread->signal_callback) {
+        is_consumed = thread->signal_callback(signal, arg, thread->signal_context);
+    }
+
+    return is_consumed;
+}
+
+void furi_thread_start(FuriThread* thread) {
+    furi_check(thread);
+    furi_check(thread->callback);
+    furi_check(thread->state == FuriThreadStateStopped);
+    furi_check(thread->stack_size > 0);
+
+    // Previous run may still be exiting
+    furi_thread_reap(thread);
+
+    memset(thread->notify, 0, sizeof(thread->notify));
+    thread->is_suspended = false;
+
+    furi_thread_set_state(thread, FuriThreadStateStarting);
+
+    size_t stack_size = thread->stack_size * THREAD_HOST_STACK_SCALE;
+    if(stack_size < THREAD_HOST_STACK_MIN) stack_size = THREAD_HOST_STACK_MIN;
+
+    pthread_attr_t attr;
+    furi_check(pthread_attr_init(&attr) == 0);
+    furi_check(pthread_attr_setstacksize(&attr, stack_size) == 0);
+
+    furi_thread_registry_add(thread);
+    furi_check(pthread_create(&thread->task, &attr, furi_thread_body, thread) == 0);
+    thread->is_joinable = true;
+
+    pthread_attr_destroy(&attr);
+
+    if(thread->name) {
+        // Linux limits thread names to 15 characters
+        char name[16];
+        strlcpy(name, thread->name, sizeof(name));
+        pthread_setname_np(thread->task, name);
+    }
+}
+
+bool furi_thread_join(FuriThread* thread) {
+    furi_check(thread);
+    // Cannot join a service thread
+    furi_check(!thread->is_service);
+    // Cannot join a thread to itself
+    furi_check(furi_thread_get_current() != thread);
+
+    furi_thread_reap(thread);
+
+    return true;
+}
+
+FuriThreadId furi_thread_get_id(FuriThread* thread) {
+    furi_check(thread);
+    return (FuriThreadId)thread;
+}
+
+void furi_thread_enable_heap_trace(FuriThread* thread) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    thread->heap_trace_enabled = true;
+}
+
+void furi_thread_disable_heap_trace(FuriThread* thread) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    thread->heap_trace_enabled = false;
+}
+
+size_t furi_thread_get_heap_size(FuriThread* thread) {
+    furi_check(thread);
+    furi_check(thread->heap_trace_enabled == true);
+    return thread->heap_size;
+}
+
+int32_t furi_thread_get_return_code(FuriThread* thread) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    return thread->ret;
+}
+
+FuriThreadId furi_thread_get_current_id(void) {
+    FuriThread* thread = furi_thread_get_current();
+
+    // Foreign threads get an identity on first use, e.g. for event loop
+    if(!thread) {
+        thread = furi_thread_adopt();
+    }
+
+    return (FuriThreadId)thread;
+}
+
+FuriThread* furi_thread_get_current(void) {
+    pthread_once(&furi_thread_key_once, furi_thread_key_init);
+    FuriThread* thread = pthread_getspecific(furi_thread_key);
+    return thread;
+}
+
+void furi_thread_yield(void) {
+    furi_check(!FURI_IS_IRQ_MODE());
+    sched_yield();
+}
+
+static void furi_thread_notify_apply(
+    FuriThreadNotify* notify,
+    uint32_t value,
+    eNotifyAction action,
+    BaseType_t* result) {
+    switch(action) {
+    case eSetBits:
+        notify->value |= value;
+        break;
+    case eIncrement:
+        notify->value++;
+        break;
+    case eSetValueWithOverwrite:
+        notify->value = value;
+        break;
+    case eSetValueWithoutOverwrite:
+        if(notify->pending) {
+            *result = pdFAIL;
+        } else {
+            notify->value = value;
+        }
+        break;
+    case eNoAction:
+    default:
+        break;
+    }
+}
+
+BaseType_t xTaskNotifyAndQueryIndexed(
+    TaskHandle_t task,
+    UBaseType_t index,
+    uint32_t value,
+    eNotifyAction action,
+    uint32_t* previous_value) {
+    FuriThread* thread = task;
+    furi_check(thread);
+    furi_check(index < THREAD_NOTIFY_COUNT);
+
+    BaseType_t result = pdPASS;
+
+    furi_check(pthread_mutex_lock(&thread->notify_mutex) == 0);
+
+    FuriThreadNotify* notify = &thread->notify[index];
+    if(previous_value) *previous_value = notify->value;
+
+    furi_thread_notify_apply(notify, value, action, &result);
+
+    if(result == pdPASS && action != eNoAction) {
+        notify->pending = true;
+        pthread_cond_broadcast(&thread->notify_cond);
+    }
+
+    furi_check(pthread_mutex_unlock(&thread->notify_mutex) == 0);
+
+    return result;
+}
+
+BaseType_t xTaskNotifyIndexed(
+    TaskHandle_t task,
+    UBaseType_t index,
+    uint32_t value,
+    eNotifyAction action) {
+    return xTaskNotifyAndQueryIndexed(task, index, value, action, NULL);
+}
+
+BaseType_t xTaskNotifyIndexedFromISR(
+    TaskHandle_t task,
+    UBaseType_t index,
+    uint32_t value,
+    eNotifyAction action,
+    BaseType_t* yield) {
+    if(yield) *yield = pdFALSE;
+    return xTaskNotifyAndQueryIndexed(task, index, value, action, NULL);
+}
+
+BaseType_t xTaskNotifyWaitIndexed(
+    UBaseType_t index,
+    uint32_t clear_on_entry,
+    uint32_t clear_on_exit,
+    uint32_t* value,
+    TickType_t timeout) {
+    furi_check(index < THREAD_NOTIFY_COUNT);
+
+    furi_thread_host_park();
+
+    FuriThread* thread = (FuriThread*)furi_thread_get_current_id();
+    BaseType_t result = pdFALSE;
+
+    struct timespec deadline;
+    furi_host_deadline(&deadline, timeout);
+
+    furi_check(pthread_mutex_lock(&thread->notify_mutex) == 0);
+
+    FuriThreadNotify* notify = &thread->notify[index];
+    if(!notify->pending) {
+        notify->value &= ~clear_on_entry;
+
+        while(!notify->pending && timeout) {
+            if(!furi_host_cond_wait(
+                   &thread->notify_cond, &thread->notify_mutex, &deadline, timeout)) {
+                break;
+            }
+        }
+    }
+
+    if(value) *value = notify->value;
+
+    if(notify->pending) {
+        notify->value &= ~clear_on_exit;
+        result = pdTRUE;
+    }
+
+    notify->pending = false;
+
+    furi_check(pthread_mutex_unlock(&thread->notify_mutex) == 0);
+
+    return result;
+}
+
+BaseType_t xTaskNotifyStateClearIndexed(TaskHandle_t task, UBaseType_t index) {
+    FuriThread* thread = task ? task : furi_thread_get_current_id();
+    furi_check(index < THREAD_NOTIFY_COUNT);
+
+    furi_check(pthread_mutex_lock(&thread->notify_mutex) == 0);
+    const BaseType_t was_pending = thread->notify[index].pending ? pdTRUE : pdFALSE;
+    thread->notify[index].pending = false;
+    furi_check(pthread_mutex_unlock(&thread->notify_mutex) == 0);
+
+    return was_pending;
+}
+
+uint32_t ulTaskNotifyValueClearIndexed(TaskHandle_t task, UBaseType_t index, uint32_t bits) {
+    FuriThread* thread = task ? task : furi_thread_get_current_id();
+    furi_check(index < THREAD_NOTIFY_COUNT);
+
+    furi_check(pthread_mutex_lock(&thread->notify_mutex) == 0);
+    const uint32_t value = thread->notify[index].value;
+    thread->notify[index].value &= ~bits;
+    furi_check(pthread_mutex_unlock(&thread->notify_mutex) == 0);
+
+    return value;
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return furi_get_tick();
+}
+
+/* Limits */
+#define MAX_BITS_TASK_NOTIFY 31U
+
+#define THREAD_FLAGS_INVALID_BITS (~((1UL << MAX_BITS_TASK_NOTIFY) - 1U))
+
+uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags) {
+    TaskHandle_t hTask = (TaskHandle_t)thread_id;
+    uint32_t rflags;
+
+    if((hTask == NULL) || ((flags & THREAD_FLAGS_INVALID_BITS) != 0U)) {
+        rflags = (uint32_t)FuriStatusErrorParameter;
+    } else {
+        (void)xTaskNotifyIndexed(hTask, THREAD_NOTIFY_INDEX, flags, eSetBits);
+        (void)xTaskNotifyAndQueryIndexed(hTask, THREAD_NOTIFY_INDEX, 0, eNoAction, &rflags);
+    }
+
+    furi_event_loop_thread_flag_callback(thread_id);
+
+    /* Return flags after setting */
+    return rflags;
+}
+
+uint32_t furi_thread_flags_clear(uint32_t flags) {
+    uint32_t rflags;
+
+    if((flags & THREAD_FLAGS_INVALID_BITS) != 0U) {
+        rflags = (uint32_t)FuriStatusErrorParameter;
+    } else {
+        rflags = ulTaskNotifyValueClearIndexed(NULL, THREAD_NOTIFY_INDEX, flags);
+    }
+
+    /* Return flags before clearing */
+    return rflags;
+}
+
+uint32_t furi_thread_flags_get(void) {
+    uint32_t rflags;
+
+    (void)xTaskNotifyAndQueryIndexed(
+        furi_thread_get_current_id(), THREAD_NOTIFY_INDEX, 0, eNoAction, &rflags);
+
+    return rflags;
+}
+
+uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout) {
+    uint32_t rflags, nval;
+    uint32_t clear;
+    TickType_t t0, td, tout;
+    BaseType_t rval;
+
+    if((flags & THREAD_FLAGS_INVALID_BITS) != 0U) {
+        rflags = (uint32_t)FuriStatusErrorParameter;
+    } else {
+        if((options & FuriFlagNoClear) == FuriFlagNoClear) {
+            clear = 0U;
+        } else {
+            clear = flags;
+        }
+
+        rflags = 0U;
+        tout = timeout;
+
+        t0 = xTaskGetTickCount();
+        do {
+            rval = xTaskNotifyWaitIndexed(THREAD_NOTIFY_INDEX, 0, clear, &nval, tout);
+
+            if(rval == pdPASS) {
+                rflags &= flags;
+                rflags |= nval;
+
+                if((options & FuriFlagWaitAll) == FuriFlagWaitAll) {
+                    if((flags & rflags) == flags) {
+                        break;
+                    } else {
+                        if(timeout == 0U) {
+                            rflags = (uint32_t)FuriStatusErrorResource;
+                            break;
+                        }
+                    }
+                } else {
+                    if((flags & rflags) != 0) {
+                        break;
+                    } else {
+                        if(timeout == 0U) {
+                            rflags = (uint32_t)FuriStatusErrorResource;
+                            break;
+                        }
+                    }
+                }
+
+                /* Update timeout */
+                td = xTaskGetTickCount() - t0;
+
+                if(td > tout) {
+                    tout = 0;
+                } else {
+                    tout -= td;
+                }
+            } else {
+                if(timeout == 0) {
+                    rflags = (uint32_t)FuriStatusErrorResource;
+                } else {
+                    rflags = (uint32_t)FuriStatusErrorTimeout;
+                }
+            }
+        } while(rval != pdFAIL);
+    }
+
+    /* Return flags before clearing */
+    return rflags;
+}
+
+static uint32_t furi_thread_get_runtime(FuriThread* thread) {
+    clockid_t clock;
+    struct timespec time = {0};
+
+    if(pthread_getcpuclockid(thread->task, &clock) == 0) {
+        clock_gettime(clock, &time);
+    }
+
+    return (uint32_t)(time.tv_sec * 1000000ULL + time.tv_nsec / 1000U);
+}
+
+bool furi_thread_enumerate(FuriThreadList* thread_list) {
+    furi_check(thread_list);
+    furi_check(!FURI_IS_IRQ_MODE());
+
+    uint32_t tick = furi_get_tick();
+
+    furi_check(pthread_mutex_lock(&furi_thread_registry_mutex) == 0);
+
+    for(FuriThread* thread = furi_thread_registry; thread; thread = thread->registry_next) {
+        FuriThreadListItem* item = furi_thread_list_get_or_insert(thread_list, thread);
+
+        item->thread = thread;
+        item->app_id = thread->appid ? thread->appid : "system";
+        item->name = thread->name;
+        item->priority = thread->priority;
+        item->stack_address = 0;
+        item->heap = 0;
+        item->stack_size = thread->stack_size;
+        item->stack_min_free = thread->stack_size;
+        item->state = thread->is_suspended ? "Suspended" : "Running";
+        item->counter_previous = item->counter_current;
+        item->counter_current = furi_thread_get_runtime(thread);
+        item->tick = tick;
+    }
+
+    furi_check(pthread_mutex_unlock(&furi_thread_registry_mutex) == 0);
+
+    // Wall clock in microseconds, same unit as thread runtime
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    furi_thread_list_process(
+        thread_list, (uint32_t)(now.tv_sec * 1000000ULL + now.tv_nsec / 1000U), tick);
+
+    return true;
+}
+
+const char* furi_thread_get_name(FuriThreadId thread_id) {
+    FuriThread* thread = (FuriThread*)thread_id;
+    return thread ? thread->name : NULL;
+}
+
+const char* furi_thread_get_appid(FuriThreadId thread_id) {
+    FuriThread* thread = (FuriThread*)thread_id;
+    const char* appid = "system";
+
+    if(thread && thread->appid) {
+        appid = thread->appid;
+    }
+
+    return appid;
+}
+
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
+    FuriThread* thread = (FuriThread*)thread_id;
+    // Watermark is not tracked on host, report the requested size
+    return thread ? thread->stack_size : 0U;
+}
+
+static size_t __furi_thread_stdout_write(FuriThread* thread, const char* data, size_t size) {
+    if(thread->output.write_callback != NULL) {
+        thread->output.write_callback(data, size, thread->output.context);
+    } else {
+        furi_log_tx((const uint8_t*)data, size);
+    }
+    return size;
+}
+
+static size_t
+    __furi_thread_stdin_read(FuriThread* thread, char* data, size_t size, FuriWait timeout) {
+    if(thread->input.read_callback != NULL) {
+        return thread->input.read_callback(data, size, timeout, thread->input.context);
+    } else {
+        return 0;
+    }
+}
+
+static int32_t __furi_thread_stdout_flush(FuriThread* thread) {
+    FuriString* buffer = thread->output.buffer;
+    size_t size = furi_string_size(buffer);
+    if(size > 0) {
+        __furi_thread_stdout_write(thread, furi_string_get_cstr(buffer), size);
+        furi_string_reset(buffer);
+    }
+    return 0;
+}
+
+void furi_thread_get_stdout_callback(FuriThreadStdoutWriteCallback* callback, void** context) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+    furi_check(callback);
+    furi_check(context);
+    *callback = thread->output.write_callback;
+    *context = thread->output.context;
+}
+
+void furi_thread_get_stdin_callback(FuriThreadStdinReadCallback* callback, void** context) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+    furi_check(callback);
+    furi_check(context);
+    *callback = thread->input.read_callback;
+    *context = thread->input.context;
+}
+
+void furi_thread_set_stdout_callback(FuriThreadStdoutWriteCallback callback, void* context) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+    __furi_thread_stdout_flush(thread);
+    thread->output.write_callback = callback;
+    thread->output.context = context;
+}
+
+void furi_thread_set_stdin_callback(FuriThreadStdinReadCallback callback, void* context) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+    thread->input.read_callback = callback;
+    thread->input.context = context;
+}
+
+size_t furi_thread_stdout_write(const char* data, size_t size) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+
+    if(size == 0 || data == NULL) {
+        return __furi_thread_stdout_flush(thread);
+    } else {
+        if(data[size - 1] == '\n') {
+            // if the last character is a newline, we can flush buffer and write data as is, wo buffers
+            __furi_thread_stdout_flush(thread);
+            __furi_thread_stdout_write(thread, data, size);
+        } else {
+            // string_cat doesn't work here because we need to write the exact size data
+            for(size_t i = 0; i < size; i++) {
+                furi_string_push_back(thread->output.buffer, data[i]);
+                if(data[i] == '\n') {
+                    __furi_thread_stdout_flush(thread);
+                }
+            }
+        }
+    }
+
+    return size;
+}
+
+int32_t furi_thread_stdout_flush(void) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+
+    return __furi_thread_stdout_flush(thread);
+}
+
+size_t furi_thread_stdin_read(char* buffer, size_t size, FuriWait timeout) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+
+    size_t from_buffer = MIN(furi_string_size(thread->input.unread_buffer), size);
+    size_t from_input = size - from_buffer;
+    size_t from_input_actual =
+        __furi_thread_stdin_read(thread, buffer + from_buffer, from_input, timeout);
+    memcpy(buffer, furi_string_get_cstr(thread->input.unread_buffer), from_buffer);
+    furi_string_right(thread->input.unread_buffer, from_buffer);
+
+    return from_buffer + from_input_actual;
+}
+
+void furi_thread_stdin_unread(char* buffer, size_t size) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+
+    FuriString* new_buf = furi_string_alloc(); // there's no furi_string_alloc_set_strn :(
+    furi_string_set_strn(new_buf, buffer, size);
+    furi_string_cat(new_buf, thread->input.unread_buffer);
+    furi_string_free(thread->input.unread_buffer);
+    thread->input.unread_buffer = new_buf;
+}
+
+void furi_thread_host_park(void) {
+    FuriThread* thread = furi_thread_get_current();
+    if(!thread) return;
+
+    furi_check(pthread_mutex_lock(&thread->notify_mutex) == 0);
+    while(thread->is_suspended) {
+        furi_check(pthread_cond_wait(&thread->notify_cond, &thread->notify_mutex) == 0);
+    }
+    furi_check(pthread_mutex_unlock(&thread->notify_mutex) == 0);
+}
+
+void furi_thread_suspend(FuriThreadId thread_id) {
+    furi_check(thread_id);
+
+    FuriThread* thread = (FuriThread*)thread_id;
+
+    // Threads can not be stopped from outside, suspended thread parks on next wait
+    furi_check(pthread_mutex_lock(&thread->notify_mutex) == 0);
+    thread->is_suspended = true;
+    furi_check(pthread_mutex_unlock(&thread->notify_mutex) == 0);
+
+    if(thread == furi_thread_get_current()) {
+        furi_thread_host_park();
+    }
+}
+
+void furi_thread_resume(FuriThreadId thread_id) {
+    furi_check(thread_id);
+
+    FuriThread* thread = (FuriThread*)thread_id;
+
+    furi_check(pthread_mutex_lock(&thread->notify_mutex) == 0);
+    thread->is_suspended = false;
+    pthread_cond_broadcast(&thread->notify_cond);
+    furi_check(pthread_mutex_unlock(&thread->notify_mutex) == 0);
+}
+
+bool furi_thread_is_suspended(FuriThreadId thread_id) {
+    furi_check(thread_id);
+
+    FuriThread* thread = (FuriThread*)thread_id;
+
+    return thread->is_suspended;
+}
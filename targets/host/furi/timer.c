@@ -0,0 +1,273 @@
+#include "furi_host_i.h"
+
+#include <core/timer.h>
+#include <core/check.h>
+#include <core/kernel.h>
+#include <core/event_flag.h>
+#include <core/common_defines.h>
+
+#include <m-list.h>
+
+struct FuriTimer {
+    FuriTimerCallback cb_func;
+    void* cb_context;
+    FuriTimerType type;
+    uint32_t period;
+    uint32_t expire_time;
+    bool is_running;
+    FuriTimer* next;
+};
+
+typedef struct {
+    FuriTimerPendigCallback callback;
+    void* context;
+    uint32_t arg;
+} FuriTimerPendingItem;
+
+LIST_DUAL_PUSH_DEF(FuriTimerPendingList, FuriTimerPendingItem, M_POD_OPLIST)
+
+/** Timer service thread, runs timer and pending callbacks one by one as the FreeRTOS daemon */
+typedef struct {
+    pthread_t task;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    FuriTimer* active;
+    FuriTimer* current;
+    FuriTimerPendingList_t pending;
+} FuriTimerService;
+
+#define TIMER_DELETED_EVENT (1U << 0)
+
+static FuriTimerService furi_timer_service = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static pthread_once_t furi_timer_service_once = PTHREAD_ONCE_INIT;
+
+static FuriTimer* furi_timer_service_get_next(FuriTimerService* service) {
+    FuriTimer* next = NULL;
+
+    for(FuriTimer* timer = service->active; timer; timer = timer->next) {
+        if(!next || (int32_t)(timer->expire_time - next->expire_time) < 0) {
+            next = timer;
+        }
+    }
+
+    return next;
+}
+
+static void furi_timer_service_unlink(FuriTimerService* service, FuriTimer* instance) {
+    for(FuriTimer** timer = &service->active; *timer; timer = &(*timer)->next) {
+        if(*timer == instance) {
+            *timer = instance->next;
+            break;
+        }
+    }
+
+    instance->next = NULL;
+    instance->is_running = false;
+}
+
+static void* furi_timer_service_body(void* context) {
+    FuriTimerService* service = context;
+
+    furi_check(pthread_mutex_lock(&service->mutex) == 0);
+
+    while(true) {
+        if(!FuriTimerPendingList_empty_p(service->pending)) {
+            FuriTimerPendingItem item;
+            FuriTimerPendingList_pop_front(&item, service->pending);
+
+            furi_check(pthread_mutex_unlock(&service->mutex) == 0);
+            item.callback(item.context, item.arg);
+            furi_check(pthread_mutex_lock(&service->mutex) == 0);
+            continue;
+        }
+
+        const uint32_t now = furi_get_tick();
+        FuriTimer* timer = furi_timer_service_get_next(service);
+
+        if(!timer) {
+            furi_check(pthread_cond_wait(&service->cond, &service->mutex) == 0);
+
+        } else if((int32_t)(timer->expire_time - now) > 0) {
+            const uint32_t timeout = timer->expire_time - now;
+            struct timespec deadline;
+            furi_host_deadline(&deadline, timeout);
+            furi_host_cond_wait(&service->cond, &service->mutex, &deadline, timeout);
+
+        } else {
+            // Periodic timer keeps its phase, missed periods are delivered late
+            if(timer->type == FuriTimerTypePeriodic) {
+                timer->expire_time += timer->period;
+            } else {
+                furi_timer_service_unlink(service, timer);
+            }
+
+            service->current = timer;
+            furi_check(pthread_mutex_unlock(&service->mutex) == 0);
+            timer->cb_func(timer->cb_context);
+            furi_check(pthread_mutex_lock(&service->mutex) == 0);
+            service->current = NULL;
+            pthread_cond_broadcast(&service->cond);
+        }
+    }
+
+    return NULL;
+}
+
+static void furi_timer_service_init(void) {
+    FuriTimerService* service = &furi_timer_service;
+
+    furi_host_cond_init(&service->cond);
+    FuriTimerPendingList_init(service->pending);
+
+    furi_check(pthread_create(&service->task, NULL, furi_timer_service_body, service) == 0);
+    pthread_setname_np(service->task, "TimerSvc");
+}
+
+static FuriTimerService* furi_timer_service_lock(void) {
+    pthread_once(&furi_timer_service_once, furi_timer_service_init);
+    furi_check(pthread_mutex_lock(&furi_timer_service.mutex) == 0);
+    return &furi_timer_service;
+}
+
+static void furi_timer_service_unlock(FuriTimerService* service) {
+    pthread_cond_broadcast(&service->cond);
+    furi_check(pthread_mutex_unlock(&service->mutex) == 0);
+}
+
+static void furi_timer_flush_epilogue(void* context, uint32_t arg) {
+    furi_assert(context);
+    UNUSED(arg);
+
+    FuriEventFlag* event = context;
+    furi_event_flag_set(event, TIMER_DELETED_EVENT);
+}
+
+FuriTimer* furi_timer_alloc(FuriTimerCallback func, FuriTimerType type, void* context) {
+    furi_check((furi_kernel_is_irq_or_masked() == 0U) && (func != NULL));
+
+    FuriTimer* instance = malloc(sizeof(FuriTimer));
+
+    instance->cb_func = func;
+    instance->cb_context = context;
+    instance->type = type;
+
+    return instance;
+}
+
+void furi_timer_free(FuriTimer* instance) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+    furi_check(instance);
+
+    FuriTimerService* service = furi_timer_service_lock();
+    furi_timer_service_unlink(service, instance);
+    furi_timer_service_unlock(service);
+
+    furi_timer_flush();
+
+    free(instance);
+}
+
+void furi_timer_flush(void) {
+    FuriTimerService* service = furi_timer_service_lock();
+    // Flushing from timer callback would wait for itself forever
+    furi_check(!pthread_equal(pthread_self(), service->task));
+    furi_timer_service_unlock(service);
+
+    FuriEventFlag* event = furi_event_flag_alloc();
+    furi_timer_pending_callback(furi_timer_flush_epilogue, event, 0);
+
+    furi_check(
+        furi_event_flag_wait(event, TIMER_DELETED_EVENT, FuriFlagWaitAny, FuriWaitForever) ==
+        TIMER_DELETED_EVENT);
+    furi_event_flag_free(event);
+}
+
+static FuriStatus furi_timer_arm(FuriTimer* instance, uint32_t ticks) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+    furi_check(instance);
+    furi_check(ticks > 0 && ticks < FuriWaitForever);
+
+    FuriTimerService* service = furi_timer_service_lock();
+
+    instance->period = ticks;
+    instance->expire_time = furi_get_tick() + ticks;
+
+    if(!instance->is_running) {
+        instance->next = service->active;
+        service->active = instance;
+        instance->is_running = true;
+    }
+
+    furi_timer_service_unlock(service);
+
+    return FuriStatusOk;
+}
+
+FuriStatus furi_timer_start(FuriTimer* instance, uint32_t ticks) {
+    return furi_timer_arm(instance, ticks);
+}
+
+FuriStatus furi_timer_restart(FuriTimer* instance, uint32_t ticks) {
+    return furi_timer_arm(instance, ticks);
+}
+
+FuriStatus furi_timer_stop(FuriTimer* instance) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+    furi_check(instance);
+
+    FuriTimerService* service = furi_timer_service_lock();
+    furi_timer_service_unlink(service, instance);
+    furi_timer_service_unlock(service);
+
+    return FuriStatusOk;
+}
+
+uint32_t furi_timer_is_running(FuriTimer* instance) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+    furi_check(instance);
+
+    FuriTimerService* service = furi_timer_service_lock();
+    const bool is_running = instance->is_running;
+    furi_timer_service_unlock(service);
+
+    /* Return 0: not running, 1: running */
+    return (uint32_t)is_running;
+}
+
+uint32_t furi_timer_get_expire_time(FuriTimer* instance) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+    furi_check(instance);
+
+    FuriTimerService* service = furi_timer_service_lock();
+    const uint32_t expire_time = instance->expire_time;
+    furi_timer_service_unlock(service);
+
+    return expire_time;
+}
+
+void furi_timer_pending_callback(FuriTimerPendigCallback callback, void* context, uint32_t arg) {
+    furi_check(callback);
+
+    FuriTimerService* service = furi_timer_service_lock();
+
+    FuriTimerPendingItem item = {
+        .callback = callback,
+        .context = context,
+        .arg = arg,
+    };
+    FuriTimerPendingList_push_back(service->pending, item);
+
+    furi_timer_service_unlock(service);
+}
+
+void furi_timer_set_thread_priority(FuriTimerThreadPriority priority) {
+    furi_check(!furi_kernel_is_irq_or_masked());
+
+    // Priorities are ignored by host scheduler
+    if(priority != FuriTimerThreadPriorityNormal && priority != FuriTimerThreadPriorityElevated) {
+        furi_crash();
+    }
+}
@@ -0,0 +1,23 @@
+#include <furi_hal.h>
+
+#define TAG "FuriHal"
+
+void furi_hal_init_early(void) {
+    furi_hal_cortex_init_early();
+    furi_hal_rtc_init_early();
+}
+
+void furi_hal_deinit_early(void) {
+    furi_hal_rtc_deinit_early();
+}
+
+void furi_hal_init(void) {
+    furi_hal_resources_init();
+    furi_hal_random_init();
+    furi_hal_rtc_init();
+    furi_hal_interrupt_init();
+    furi_hal_crc_init();
+    furi_hal_crypto_init();
+    furi_hal_memory_init();
+    furi_hal_spi_config_init();
+}
@@ -0,0 +1,40 @@
+/**
+ * @file furi_hal.h
+ * Host Furi HAL API, the subset used by furi and the portable libs
+ */
+#pragma once
+
+#ifdef __cplusplus
+template <unsigned int N>
+struct STOP_EXTERNING_ME {};
+#endif
+
+#include <furi_hal_cortex.h>
+#include <furi_hal_crc.h>
+#include <furi_hal_crypto.h>
+#include <furi_hal_gpio.h>
+#include <furi_hal_interrupt.h>
+#include <furi_hal_memory.h>
+#include <furi_hal_power.h>
+#include <furi_hal_random.h>
+#include <furi_hal_resources.h>
+#include <furi_hal_rtc.h>
+#include <furi_hal_sd.h>
+#include <furi_hal_spi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Early FuriHal init, only essential subsystems */
+void furi_hal_init_early(void);
+
+/** Early FuriHal deinit */
+void furi_hal_deinit_early(void);
+
+/** Init FuriHal */
+void furi_hal_init(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,82 @@
+#include <furi_hal_cortex.h>
+#include <furi.h>
+
+#include <time.h>
+#include <errno.h>
+
+// Nominal core clock, DWT cycle counter is emulated from the monotonic clock
+#define FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND (64U)
+
+// Longer delays sleep instead of spinning
+#define FURI_HAL_CORTEX_DELAY_SLEEP_US (1000U)
+
+static uint32_t furi_hal_cortex_get_cycles(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    const uint64_t ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    return (uint32_t)(ns * FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND / 1000U);
+}
+
+void furi_hal_cortex_init_early(void) {
+}
+
+void furi_hal_cortex_delay_us(uint32_t microseconds) {
+    furi_check(microseconds < (UINT32_MAX / FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND));
+
+    if(microseconds >= FURI_HAL_CORTEX_DELAY_SLEEP_US) {
+        struct timespec delay = {
+            .tv_sec = microseconds / 1000000U,
+            .tv_nsec = (long)(microseconds % 1000000U) * 1000L,
+        };
+        while(nanosleep(&delay, &delay) != 0 && errno == EINTR) {
+        }
+        return;
+    }
+
+    uint32_t start = furi_hal_cortex_get_cycles();
+    uint32_t time_ticks = FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND * microseconds;
+
+    while((furi_hal_cortex_get_cycles() - start) < time_ticks) {
+    };
+}
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void) {
+    return FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND;
+}
+
+FURI_WARN_UNUSED FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us) {
+    furi_check(timeout_us < (UINT32_MAX / FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND));
+
+    FuriHalCortexTimer cortex_timer = {0};
+    cortex_timer.start = furi_hal_cortex_get_cycles();
+    cortex_timer.value = FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND * timeout_us;
+    return cortex_timer;
+}
+
+bool furi_hal_cortex_timer_is_expired(FuriHalCortexTimer cortex_timer) {
+    return !((furi_hal_cortex_get_cycles() - cortex_timer.start) < cortex_timer.value);
+}
+
+void furi_hal_cortex_timer_wait(FuriHalCortexTimer cortex_timer) {
+    while(!furi_hal_cortex_timer_is_expired(cortex_timer))
+        ;
+}
+
+// No DWT on host, breakpoints are left to the debugger
+void furi_hal_cortex_comp_enable(
+    FuriHalCortexComp comp,
+    FuriHalCortexCompFunction function,
+    uint32_t value,
+    uint32_t mask,
+    FuriHalCortexCompSize size) {
+    UNUSED(comp);
+    UNUSED(function);
+    UNUSED(value);
+    UNUSED(mask);
+    UNUSED(size);
+}
+
+void furi_hal_cortex_comp_reset(FuriHalCortexComp comp) {
+    UNUSED(comp);
+}
@@ -0,0 +1,41 @@
+#include <furi_hal_crc.h>
+#include <furi.h>
+
+// Same polynomial and reflection as the device CRC unit setup
+#define FURI_HAL_CRC32_POLY_REFLECTED (0xEDB88320UL)
+
+static FuriMutex* furi_hal_crc_mutex = NULL;
+
+void furi_hal_crc_init(void) {
+    furi_hal_crc_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+}
+
+bool furi_hal_crc_acquire(uint32_t timeout) {
+    furi_check(furi_hal_crc_mutex);
+    return furi_mutex_acquire(furi_hal_crc_mutex, timeout) == FuriStatusOk;
+}
+
+void furi_hal_crc_release(void) {
+    furi_check(furi_hal_crc_mutex);
+    furi_check(furi_mutex_release(furi_hal_crc_mutex) == FuriStatusOk);
+}
+
+uint32_t furi_hal_crc32_calc(uint32_t crc, const void* buffer, size_t size) {
+    furi_check(buffer || !size);
+    furi_check(furi_hal_crc_acquire(FuriWaitForever));
+
+    // Bit serial, as the unit shifts the data in
+    const uint8_t* data = buffer;
+    crc = ~crc;
+
+    while(size--) {
+        crc ^= *data++;
+        for(size_t i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (FURI_HAL_CRC32_POLY_REFLECTED & (0U - (crc & 1U)));
+        }
+    }
+
+    furi_hal_crc_release();
+
+    return ~crc;
+}
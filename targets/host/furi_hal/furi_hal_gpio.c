@@ -0,0 +1,130 @@
+#include <furi_hal_gpio.h>
+#include <furi.h>
+
+#define FURI_HAL_GPIO_HOST_PIN_MAX (64U)
+
+typedef struct {
+    void* port;
+    uint16_t pin;
+    GpioMode mode;
+    bool state;
+    bool enabled;
+    GpioInterrupt interrupt;
+} FuriHalGpioHostPin;
+
+static FuriHalGpioHostPin furi_hal_gpio_host_pins[FURI_HAL_GPIO_HOST_PIN_MAX];
+static size_t furi_hal_gpio_host_pin_count = 0;
+
+// Must be called inside FURI_CRITICAL
+static FuriHalGpioHostPin* furi_hal_gpio_host_get_pin(const GpioPin* gpio) {
+    furi_check(gpio);
+
+    for(size_t i = 0; i < furi_hal_gpio_host_pin_count; i++) {
+        FuriHalGpioHostPin* pin = &furi_hal_gpio_host_pins[i];
+        if(pin->port == gpio->port && pin->pin == gpio->pin) return pin;
+    }
+
+    furi_check(furi_hal_gpio_host_pin_count < FURI_HAL_GPIO_HOST_PIN_MAX);
+    FuriHalGpioHostPin* pin = &furi_hal_gpio_host_pins[furi_hal_gpio_host_pin_count++];
+    pin->port = gpio->port;
+    pin->pin = gpio->pin;
+
+    return pin;
+}
+
+void furi_hal_gpio_init_simple(const GpioPin* gpio, const GpioMode mode) {
+    furi_hal_gpio_init(gpio, mode, GpioPullNo, GpioSpeedLow);
+}
+
+void furi_hal_gpio_init(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed) {
+    furi_hal_gpio_init_ex(gpio, mode, pull, speed, GpioAltFnUnused);
+}
+
+void furi_hal_gpio_init_ex(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed,
+    const GpioAltFn alt_fn) {
+    UNUSED(speed);
+    UNUSED(alt_fn);
+
+    FURI_CRITICAL_ENTER();
+    FuriHalGpioHostPin* pin = furi_hal_gpio_host_get_pin(gpio);
+    pin->mode = mode;
+    if(pull == GpioPullUp) {
+        pin->state = true;
+    } else if(pull == GpioPullDown) {
+        pin->state = false;
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_gpio_add_int_callback(const GpioPin* gpio, GpioExtiCallback cb, void* ctx) {
+    furi_check(cb);
+
+    FURI_CRITICAL_ENTER();
+    FuriHalGpioHostPin* pin = furi_hal_gpio_host_get_pin(gpio);
+    furi_check(pin->interrupt.callback == NULL);
+    pin->interrupt.callback = cb;
+    pin->interrupt.context = ctx;
+    pin->enabled = true;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_gpio_enable_int_callback(const GpioPin* gpio) {
+    FURI_CRITICAL_ENTER();
+    furi_hal_gpio_host_get_pin(gpio)->enabled = true;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_gpio_disable_int_callback(const GpioPin* gpio) {
+    FURI_CRITICAL_ENTER();
+    furi_hal_gpio_host_get_pin(gpio)->enabled = false;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_gpio_remove_int_callback(const GpioPin* gpio) {
+    FURI_CRITICAL_ENTER();
+    FuriHalGpioHostPin* pin = furi_hal_gpio_host_get_pin(gpio);
+    pin->interrupt.callback = NULL;
+    pin->interrupt.context = NULL;
+    pin->enabled = false;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_gpio_write(const GpioPin* gpio, const bool state) {
+    FURI_CRITICAL_ENTER();
+    furi_hal_gpio_host_get_pin(gpio)->state = state;
+    FURI_CRITICAL_EXIT();
+}
+
+bool furi_hal_gpio_read(const GpioPin* gpio) {
+    FURI_CRITICAL_ENTER();
+    bool state = furi_hal_gpio_host_get_pin(gpio)->state;
+    FURI_CRITICAL_EXIT();
+
+    return state;
+}
+
+void furi_hal_gpio_host_set_input(const GpioPin* gpio, bool state) {
+    GpioInterrupt interrupt = {0};
+
+    FURI_CRITICAL_ENTER();
+    FuriHalGpioHostPin* pin = furi_hal_gpio_host_get_pin(gpio);
+    if(pin->state != state && pin->enabled) {
+        const bool rise = (pin->mode == GpioModeInterruptRise) ||
+                          (pin->mode == GpioModeInterruptRiseFall);
+        const bool fall = (pin->mode == GpioModeInterruptFall) ||
+                          (pin->mode == GpioModeInterruptRiseFall);
+        if((state && rise) || (!state && fall)) interrupt = pin->interrupt;
+    }
+    pin->state = state;
+    FURI_CRITICAL_EXIT();
+
+    if(interrupt.callback) interrupt.callback(interrupt.context);
+}
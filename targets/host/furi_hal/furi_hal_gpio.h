@@ -0,0 +1,102 @@
+/**
+ * @file furi_hal_gpio.h
+ * Host GPIO HAL API
+ *
+ * Pins are virtual: read returns the last written or injected level, edges
+ * injected with furi_hal_gpio_host_set_input fire interrupt callbacks.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GPIO_NUMBER (16U)
+
+typedef void (*GpioExtiCallback)(void* ctx);
+
+typedef struct {
+    GpioExtiCallback callback;
+    void* context;
+} GpioInterrupt;
+
+typedef enum {
+    GpioModeInput,
+    GpioModeOutputPushPull,
+    GpioModeOutputOpenDrain,
+    GpioModeAltFunctionPushPull,
+    GpioModeAltFunctionOpenDrain,
+    GpioModeAnalog,
+    GpioModeInterruptRise,
+    GpioModeInterruptFall,
+    GpioModeInterruptRiseFall,
+    GpioModeEventRise,
+    GpioModeEventFall,
+    GpioModeEventRiseFall,
+} GpioMode;
+
+typedef enum {
+    GpioPullNo,
+    GpioPullUp,
+    GpioPullDown,
+} GpioPull;
+
+typedef enum {
+    GpioSpeedLow,
+    GpioSpeedMedium,
+    GpioSpeedHigh,
+    GpioSpeedVeryHigh,
+} GpioSpeed;
+
+typedef enum {
+    GpioAltFn5SPI2 = 5, /*!< SPI2 Alternate Function mapping */
+    GpioAltFnUnused = 16, /*!< just dummy value */
+} GpioAltFn;
+
+typedef struct {
+    void* port;
+    uint16_t pin;
+} GpioPin;
+
+void furi_hal_gpio_init_simple(const GpioPin* gpio, const GpioMode mode);
+
+void furi_hal_gpio_init(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed);
+
+void furi_hal_gpio_init_ex(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed,
+    const GpioAltFn alt_fn);
+
+void furi_hal_gpio_add_int_callback(const GpioPin* gpio, GpioExtiCallback cb, void* ctx);
+
+void furi_hal_gpio_enable_int_callback(const GpioPin* gpio);
+
+void furi_hal_gpio_disable_int_callback(const GpioPin* gpio);
+
+void furi_hal_gpio_remove_int_callback(const GpioPin* gpio);
+
+void furi_hal_gpio_write(const GpioPin* gpio, const bool state);
+
+bool furi_hal_gpio_read(const GpioPin* gpio);
+
+/** Drive pin input level from the host side
+ *
+ * Fires the pin interrupt callback on a matching edge, in the caller thread.
+ *
+ * @param      gpio   GpioPin
+ * @param      state  new input level
+ */
+void furi_hal_gpio_host_set_input(const GpioPin* gpio, bool state);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,49 @@
+#include <furi_hal_interrupt.h>
+#include <furi.h>
+
+typedef struct {
+    FuriHalInterruptISR isr;
+    void* context;
+} FuriHalInterruptISRPair;
+
+static FuriHalInterruptISRPair furi_hal_interrupt_isr[FuriHalInterruptIdMax] = {0};
+
+void furi_hal_interrupt_init(void) {
+}
+
+void furi_hal_interrupt_set_isr(FuriHalInterruptId index, FuriHalInterruptISR isr, void* context) {
+    furi_hal_interrupt_set_isr_ex(index, FuriHalInterruptPriorityNormal, isr, context);
+}
+
+void furi_hal_interrupt_set_isr_ex(
+    FuriHalInterruptId index,
+    FuriHalInterruptPriority priority,
+    FuriHalInterruptISR isr,
+    void* context) {
+    furi_check(index < FuriHalInterruptIdMax);
+    furi_check(
+        (priority >= FuriHalInterruptPriorityLowest &&
+         priority <= FuriHalInterruptPriorityHighest) ||
+        priority == FuriHalInterruptPriorityKamiSama);
+
+    FURI_CRITICAL_ENTER();
+    if(isr) {
+        // Pre ISR set
+        furi_check(furi_hal_interrupt_isr[index].isr == NULL);
+    } else {
+        // Pre ISR clear
+        furi_check(furi_hal_interrupt_isr[index].isr != NULL);
+    }
+    furi_hal_interrupt_isr[index].isr = isr;
+    furi_hal_interrupt_isr[index].context = context;
+    FURI_CRITICAL_EXIT();
+}
+
+const char* furi_hal_interrupt_get_name(uint8_t exception_number) {
+    UNUSED(exception_number);
+    return NULL;
+}
+
+uint32_t furi_hal_interrupt_get_time_in_isr_total(void) {
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file furi_hal_interrupt.h
+ * Host interrupt HAL API
+ *
+ * There are no interrupts on host, handlers are only stored so drivers can
+ * be set up and torn down as on the device.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Timer ISR */
+typedef void (*FuriHalInterruptISR)(void* context);
+
+typedef enum {
+    FuriHalInterruptIdTim1TrgComTim17,
+    FuriHalInterruptIdTim1Cc,
+    FuriHalInterruptIdTim1UpTim16,
+    FuriHalInterruptIdTIM2,
+    FuriHalInterruptIdRtcAlarm,
+    FuriHalInterruptIdLpTim1,
+    FuriHalInterruptIdLpTim2,
+
+    // Service value
+    FuriHalInterruptIdMax,
+} FuriHalInterruptId;
+
+typedef enum {
+    FuriHalInterruptPriorityLowest = -3,
+    FuriHalInterruptPriorityLower = -2,
+    FuriHalInterruptPriorityLow = -1,
+    FuriHalInterruptPriorityNormal = 0,
+    FuriHalInterruptPriorityHigh = 1,
+    FuriHalInterruptPriorityHigher = 2,
+    FuriHalInterruptPriorityHighest = 3,
+    FuriHalInterruptPriorityKamiSama = 6,
+} FuriHalInterruptPriority;
+
+/** Initialize interrupt subsystem */
+void furi_hal_interrupt_init(void);
+
+/** Set ISR
+ *
+ * @param      index    - interrupt ID
+ * @param      isr      - your interrupt service routine or use NULL to clear
+ * @param      context  - isr context
+ */
+void furi_hal_interrupt_set_isr(FuriHalInterruptId index, FuriHalInterruptISR isr, void* context);
+
+/** Set ISR, priority is ignored on host
+ *
+ * @param      index     - interrupt ID
+ * @param      priority  - One of FuriHalInterruptPriority
+ * @param      isr       - your interrupt service routine or use NULL to clear
+ * @param      context   - isr context
+ */
+void furi_hal_interrupt_set_isr_ex(
+    FuriHalInterruptId index,
+    FuriHalInterruptPriority priority,
+    FuriHalInterruptISR isr,
+    void* context);
+
+/** Get interrupt name by exception number, always NULL on host
+ *
+ * @param exception_number 
+ * @return const char* or NULL if interrupt name is not found
+ */
+const char* furi_hal_interrupt_get_name(uint8_t exception_number);
+
+/** Get total time(in CPU clocks) spent in ISR, always 0 on host
+ *
+ * @return     total time in CPU clocks
+ */
+uint32_t furi_hal_interrupt_get_time_in_isr_total(void);
+
+#ifdef __cplusplus
+}
+#endif
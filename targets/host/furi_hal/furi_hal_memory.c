@@ -0,0 +1,20 @@
+#include <furi.h>
+#include <furi_hal_memory.h>
+
+// There is no separate SRAM2 pool on host, callers fall back to the heap
+
+void furi_hal_memory_init(void) {
+}
+
+void* furi_hal_memory_alloc(size_t size) {
+    UNUSED(size);
+    return NULL;
+}
+
+size_t furi_hal_memory_get_free(void) {
+    return 0;
+}
+
+size_t furi_hal_memory_max_pool_block(void) {
+    return 0;
+}
@@ -0,0 +1,12 @@
+#include <furi_hal_power.h>
+#include <furi_hal_resources.h>
+
+// Only the peripheral supply switch, drivers power cycle the SD card with it
+
+void furi_hal_power_enable_external_3_3v(void) {
+    furi_hal_gpio_write(&gpio_periph_power, 1);
+}
+
+void furi_hal_power_disable_external_3_3v(void) {
+    furi_hal_gpio_write(&gpio_periph_power, 0);
+}
@@ -0,0 +1,40 @@
+#include <furi_hal_random.h>
+#include <furi.h>
+
+#include <errno.h>
+#include <sys/random.h>
+
+void furi_hal_random_init(void) {
+}
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len) {
+    furi_check(buf || !len);
+
+    while(len) {
+        ssize_t ret = getrandom(buf, len, 0);
+        if(ret < 0) {
+            furi_check(errno == EINTR);
+            continue;
+        }
+        buf += ret;
+        len -= ret;
+    }
+}
+
+uint32_t furi_hal_random_get(void) {
+    uint32_t value;
+    furi_hal_random_fill_buf((uint8_t*)&value, sizeof(value));
+    return value;
+}
+
+void srand(unsigned seed) {
+    UNUSED(seed);
+}
+
+int rand(void) {
+    return furi_hal_random_get() & RAND_MAX;
+}
+
+long random(void) {
+    return furi_hal_random_get() & RAND_MAX;
+}
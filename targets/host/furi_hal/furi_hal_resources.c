@@ -0,0 +1,22 @@
+#include <furi_hal_resources.h>
+
+// Ports only tell the virtual pins apart, device addresses keep the pin map readable
+#define GPIOA ((void*)0x48000000UL)
+#define GPIOB ((void*)0x48000400UL)
+#define GPIOC ((void*)0x48000800UL)
+#define GPIOD ((void*)0x48000C00UL)
+
+const GpioPin gpio_sdcard_cs = {.port = GPIOC, .pin = 1U << 12};
+const GpioPin gpio_sdcard_cd = {.port = GPIOC, .pin = 1U << 10};
+
+const GpioPin gpio_spi_d_miso = {.port = GPIOC, .pin = 1U << 2};
+const GpioPin gpio_spi_d_mosi = {.port = GPIOB, .pin = 1U << 15};
+const GpioPin gpio_spi_d_sck = {.port = GPIOD, .pin = 1U << 1};
+
+const GpioPin gpio_periph_power = {.port = GPIOA, .pin = 1U << 3};
+
+void furi_hal_resources_init(void) {
+    // Peripheral power is on from boot, as on the device
+    furi_hal_gpio_write(&gpio_periph_power, 1);
+    furi_hal_gpio_init(&gpio_periph_power, GpioModeOutputOpenDrain, GpioPullNo, GpioSpeedLow);
+}
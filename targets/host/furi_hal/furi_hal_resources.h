@@ -0,0 +1,27 @@
+/**
+ * @file furi_hal_resources.h
+ * Host pins, the subset used by the drivers built for host tests
+ */
+#pragma once
+
+#include <furi_hal_gpio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const GpioPin gpio_sdcard_cs;
+extern const GpioPin gpio_sdcard_cd;
+
+extern const GpioPin gpio_spi_d_miso;
+extern const GpioPin gpio_spi_d_mosi;
+extern const GpioPin gpio_spi_d_sck;
+
+extern const GpioPin gpio_periph_power;
+
+/** Initialize resources, peripheral power on */
+void furi_hal_resources_init(void);
+
+#ifdef __cplusplus
+}
+#endif
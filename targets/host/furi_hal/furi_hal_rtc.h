@@ -0,0 +1,7 @@
+/**
+ * @file furi_hal_rtc.h
+ * Furi Hal RTC API, shared with the device, it has no hardware types
+ */
+#pragma once
+
+#include "../../f7/furi_hal/furi_hal_rtc.h"
@@ -0,0 +1,113 @@
+#include <furi_hal_sd.h>
+#include <furi_hal_sd_i.h>
+#include <furi.h>
+#include <sector_cache.h>
+
+#include <string.h>
+#include <sys/mman.h>
+
+#define TAG "FuriHalSd"
+
+#define SD_BLOCK_SIZE (512)
+
+/** RAM disk size in blocks, pages are only backed once written */
+#ifndef FURI_HAL_SD_HOST_BLOCKS
+#define FURI_HAL_SD_HOST_BLOCKS (64UL * 1024 * 1024 / SD_BLOCK_SIZE)
+#endif
+
+static uint8_t* sd_disk = NULL;
+
+void furi_hal_sd_presence_init(void) {
+}
+
+bool furi_hal_sd_is_present(void) {
+    return true;
+}
+
+uint8_t furi_hal_sd_max_mount_retry_count(void) {
+    return 1;
+}
+
+FuriStatus furi_hal_sd_init(bool power_reset) {
+    UNUSED(power_reset);
+
+    if(!sd_disk) {
+        sd_disk = mmap(
+            NULL,
+            FURI_HAL_SD_HOST_BLOCKS * SD_BLOCK_SIZE,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+            -1,
+            0);
+        furi_check(sd_disk != MAP_FAILED);
+        FURI_LOG_I(TAG, "RAM disk ready, %lu blocks", FURI_HAL_SD_HOST_BLOCKS);
+    }
+
+    // Same as a card swap on the device
+    sector_cache_init();
+
+    return FuriStatusOk;
+}
+
+FuriStatus furi_hal_sd_get_card_state(void) {
+    return sd_disk ? FuriStatusOk : FuriStatusErrorResource;
+}
+
+FuriStatus furi_hal_sd_read_blocks_uncached(uint32_t* buff, uint32_t sector, uint32_t count) {
+    furi_check(buff);
+    furi_check(sd_disk);
+
+    if(sector > FURI_HAL_SD_HOST_BLOCKS || count > FURI_HAL_SD_HOST_BLOCKS - sector) {
+        return FuriStatusErrorParameter;
+    }
+    memcpy(buff, sd_disk + (size_t)sector * SD_BLOCK_SIZE, (size_t)count * SD_BLOCK_SIZE);
+
+    return FuriStatusOk;
+}
+
+FuriStatus
+    furi_hal_sd_write_blocks_uncached(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    furi_check(buff);
+    furi_check(sd_disk);
+
+    if(sector > FURI_HAL_SD_HOST_BLOCKS || count > FURI_HAL_SD_HOST_BLOCKS - sector) {
+        return FuriStatusErrorParameter;
+    }
+    memcpy(sd_disk + (size_t)sector * SD_BLOCK_SIZE, buff, (size_t)count * SD_BLOCK_SIZE);
+
+    return FuriStatusOk;
+}
+
+FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = furi_hal_sd_read_blocks_uncached(buff, sector, count);
+
+    // Sectors written back lazily are newer than the disk
+    if(status == FuriStatusOk) {
+        sector_cache_merge_dirty(sector, count, (uint8_t*)buff);
+    }
+
+    return status;
+}
+
+FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    // Drop cached copies before the disk changes under them, dirty ones are superseded
+    if(count > 0) {
+        sector_cache_invalidate_range(sector, sector + count - 1);
+    }
+
+    return furi_hal_sd_write_blocks_uncached(buff, sector, count);
+}
+
+FuriStatus furi_hal_sd_info(FuriHalSdInfo* info) {
+    furi_check(info);
+
+    memset(info, 0, sizeof(FuriHalSdInfo));
+    info->capacity = (uint64_t)FURI_HAL_SD_HOST_BLOCKS * SD_BLOCK_SIZE;
+    info->block_size = SD_BLOCK_SIZE;
+    info->logical_block_count = FURI_HAL_SD_HOST_BLOCKS;
+    info->logical_block_size = SD_BLOCK_SIZE;
+    strlcpy(info->oem_id, "FL", sizeof(info->oem_id));
+    strlcpy(info->product_name, "RAMSD", sizeof(info->product_name));
+
+    return FuriStatusOk;
+}
@@ -0,0 +1,7 @@
+/**
+ * @file furi_hal_sd_i.h
+ * Furi Hal SD internal API, shared with the device, it has no hardware types
+ */
+#pragma once
+
+#include "../../f7/furi_hal/furi_hal_sd_i.h"
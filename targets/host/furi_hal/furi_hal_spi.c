@@ -0,0 +1,153 @@
+#include <furi_hal_spi.h>
+#include <furi_hal_resources.h>
+#include <furi.h>
+
+#include <string.h>
+
+#define TAG "FuriHalSpi"
+
+FuriHalSpiBus furi_hal_spi_bus_d = {0};
+
+const FuriHalSpiBusHandle furi_hal_spi_bus_handle_sd_fast = {
+    .bus = &furi_hal_spi_bus_d,
+    .miso = &gpio_spi_d_miso,
+    .mosi = &gpio_spi_d_mosi,
+    .sck = &gpio_spi_d_sck,
+    .cs = &gpio_sdcard_cs,
+};
+
+const FuriHalSpiBusHandle furi_hal_spi_bus_handle_sd_slow = {
+    .bus = &furi_hal_spi_bus_d,
+    .miso = &gpio_spi_d_miso,
+    .mosi = &gpio_spi_d_mosi,
+    .sck = &gpio_spi_d_sck,
+    .cs = &gpio_sdcard_cs,
+};
+
+void furi_hal_spi_config_init_early(void) {
+    furi_hal_spi_bus_init(&furi_hal_spi_bus_d);
+}
+
+void furi_hal_spi_config_deinit_early(void) {
+    furi_hal_spi_bus_deinit(&furi_hal_spi_bus_d);
+}
+
+void furi_hal_spi_config_init(void) {
+    furi_hal_spi_config_init_early();
+    furi_hal_spi_bus_handle_init(&furi_hal_spi_bus_handle_sd_fast);
+}
+
+void furi_hal_spi_dma_init(void) {
+}
+
+void furi_hal_spi_bus_init(FuriHalSpiBus* bus) {
+    furi_check(bus);
+    furi_check(bus->mutex == NULL);
+    bus->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+}
+
+void furi_hal_spi_bus_deinit(FuriHalSpiBus* bus) {
+    furi_check(bus);
+    furi_check(bus->current_handle == NULL);
+    furi_mutex_free(bus->mutex);
+    bus->mutex = NULL;
+}
+
+void furi_hal_spi_bus_handle_init(const FuriHalSpiBusHandle* handle) {
+    furi_check(handle);
+    // CS is high while idle, as on the device
+    furi_hal_gpio_write(handle->cs, true);
+    furi_hal_gpio_init(handle->cs, GpioModeOutputPushPull, GpioPullNo, GpioSpeedVeryHigh);
+}
+
+void furi_hal_spi_bus_handle_deinit(const FuriHalSpiBusHandle* handle) {
+    furi_check(handle);
+    furi_hal_gpio_init(handle->cs, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
+}
+
+void furi_hal_spi_host_set_device(
+    FuriHalSpiBus* bus,
+    FuriHalSpiHostDeviceCallback callback,
+    void* context) {
+    furi_check(bus);
+    furi_check(furi_mutex_acquire(bus->mutex, FuriWaitForever) == FuriStatusOk);
+    bus->device = callback;
+    bus->context = context;
+    furi_check(furi_mutex_release(bus->mutex) == FuriStatusOk);
+}
+
+void furi_hal_spi_acquire(const FuriHalSpiBusHandle* handle) {
+    furi_check(handle);
+    furi_check(furi_mutex_acquire(handle->bus->mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(handle->bus->current_handle == NULL);
+    handle->bus->current_handle = handle;
+}
+
+void furi_hal_spi_release(const FuriHalSpiBusHandle* handle) {
+    furi_check(handle);
+    furi_check(handle->bus->current_handle == handle);
+    handle->bus->current_handle = NULL;
+    furi_check(furi_mutex_release(handle->bus->mutex) == FuriStatusOk);
+}
+
+static void furi_hal_spi_host_transfer(
+    const FuriHalSpiBusHandle* handle,
+    const uint8_t* tx_buffer,
+    uint8_t* rx_buffer,
+    size_t size) {
+    furi_check(handle);
+    furi_check(handle->bus->current_handle == handle);
+    furi_check(size > 0);
+
+    if(handle->bus->device) {
+        handle->bus->device(handle, tx_buffer, rx_buffer, size, handle->bus->context);
+    } else if(rx_buffer) {
+        memset(rx_buffer, 0xFF, size);
+    }
+}
+
+bool furi_hal_spi_bus_rx(
+    const FuriHalSpiBusHandle* handle,
+    uint8_t* buffer,
+    size_t size,
+    uint32_t timeout) {
+    UNUSED(timeout);
+    furi_check(buffer);
+    furi_hal_spi_host_transfer(handle, NULL, buffer, size);
+    return true;
+}
+
+bool furi_hal_spi_bus_tx(
+    const FuriHalSpiBusHandle* handle,
+    const uint8_t* buffer,
+    size_t size,
+    uint32_t timeout) {
+    UNUSED(timeout);
+    furi_check(buffer);
+    furi_hal_spi_host_transfer(handle, buffer, NULL, size);
+    return true;
+}
+
+bool furi_hal_spi_bus_trx(
+    const FuriHalSpiBusHandle* handle,
+    const uint8_t* tx_buffer,
+    uint8_t* rx_buffer,
+    size_t size,
+    uint32_t timeout) {
+    UNUSED(timeout);
+    furi_check(tx_buffer || rx_buffer);
+    furi_hal_spi_host_transfer(handle, tx_buffer, rx_buffer, size);
+    return true;
+}
+
+bool furi_hal_spi_bus_trx_dma(
+    const FuriHalSpiBusHandle* handle,
+    uint8_t* tx_buffer,
+    uint8_t* rx_buffer,
+    size_t size,
+    uint32_t timeout_ms) {
+    UNUSED(timeout_ms);
+    furi_check(tx_buffer || rx_buffer);
+    furi_hal_spi_host_transfer(handle, tx_buffer, rx_buffer, size);
+    return true;
+}
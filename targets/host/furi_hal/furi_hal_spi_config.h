@@ -0,0 +1,80 @@
+/**
+ * @file furi_hal_spi_config.h
+ * Host SPI buses and handles
+ *
+ * There is no controller: transfers are handed to the device attached to the
+ * bus with furi_hal_spi_host_set_device. A bus without a device reads 0xFF,
+ * as MISO held high by its pull-up.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <furi_hal_gpio.h>
+#include <core/mutex.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriHalSpiBus FuriHalSpiBus;
+typedef struct FuriHalSpiBusHandle FuriHalSpiBusHandle;
+
+/** Device on a host bus, clocks one transfer in and out
+ *
+ * CS is not part of the transfer, the device reads the handle cs pin.
+ *
+ * @param      handle     handle the transfer is made with
+ * @param      tx_buffer  bytes from the controller, NULL when it clocks out 0xFF
+ * @param      rx_buffer  bytes to the controller, NULL when it drops them
+ * @param      size       transfer size
+ * @param      context    device context
+ */
+typedef void (*FuriHalSpiHostDeviceCallback)(
+    const FuriHalSpiBusHandle* handle,
+    const uint8_t* tx_buffer,
+    uint8_t* rx_buffer,
+    size_t size,
+    void* context);
+
+/** FuriHal spi bus */
+struct FuriHalSpiBus {
+    FuriMutex* mutex;
+    const FuriHalSpiBusHandle* current_handle;
+    FuriHalSpiHostDeviceCallback device;
+    void* context;
+};
+
+/** FuriHal spi handle */
+struct FuriHalSpiBusHandle {
+    FuriHalSpiBus* bus;
+    const GpioPin* miso;
+    const GpioPin* mosi;
+    const GpioPin* sck;
+    const GpioPin* cs;
+};
+
+/** Furi Hal Spi Bus D (Display, SdCard) */
+extern FuriHalSpiBus furi_hal_spi_bus_d;
+
+/** SdCard in fast mode on `furi_hal_spi_bus_d` */
+extern const FuriHalSpiBusHandle furi_hal_spi_bus_handle_sd_fast;
+
+/** SdCard in slow mode on `furi_hal_spi_bus_d` */
+extern const FuriHalSpiBusHandle furi_hal_spi_bus_handle_sd_slow;
+
+/** Attach a device to a host bus
+ *
+ * @param      bus       pointer to FuriHalSpiBus instance
+ * @param      callback  transfer callback, NULL detaches the device
+ * @param      context   callback context
+ */
+void furi_hal_spi_host_set_device(
+    FuriHalSpiBus* bus,
+    FuriHalSpiHostDeviceCallback callback,
+    void* context);
+
+#ifdef __cplusplus
+}
+#endif
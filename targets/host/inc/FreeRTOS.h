@@ -0,0 +1,25 @@
+/**
+ * @file FreeRTOS.h
+ * Host shim for the FreeRTOS types used by the portable part of furi/core
+ *
+ * There is no FreeRTOS on host. Only the types and constants needed to build
+ * the event loop sources unmodified are provided, see task.h.
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE  ((BaseType_t)1)
+#define pdPASS  (pdTRUE)
+#define pdFAIL  (pdFALSE)
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+
+#define configTICK_RATE_HZ_RAW 1000
+
+#define portYIELD_FROM_ISR(x) ((void)(x))
@@ -0,0 +1,87 @@
+/**
+ * @file cmsis_compiler.h
+ * Host replacement for the CMSIS compiler header
+ *
+ * Host code never runs in interrupt context and can not mask interrupts, so
+ * PRIMASK and IPSR always read as zero and interrupt control is a no-op.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifndef __ASM
+#define __ASM __asm
+#endif
+#ifndef __INLINE
+#define __INLINE inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+#define __USED __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#endif
+#ifndef __RESTRICT
+#define __RESTRICT __restrict
+#endif
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void) {
+    return 0U;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_IPSR(void) {
+    return 0U;
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void) {
+}
+
+__STATIC_FORCEINLINE void __enable_irq(void) {
+}
+
+__STATIC_FORCEINLINE void __NOP(void) {
+}
+
+__STATIC_FORCEINLINE void __DSB(void) {
+    __sync_synchronize();
+}
+
+__STATIC_FORCEINLINE void __ISB(void) {
+    __sync_synchronize();
+}
+
+__STATIC_FORCEINLINE void __DMB(void) {
+    __sync_synchronize();
+}
+
+__STATIC_FORCEINLINE uint32_t __REV(uint32_t value) {
+    return __builtin_bswap32(value);
+}
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value) {
+    uint32_t result = 0U;
+    for(uint32_t i = 0; i < 32U; i++) {
+        result = (result << 1) | (value & 1U);
+        value >>= 1;
+    }
+    return result;
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value) {
+    return value ? (uint8_t)__builtin_clz(value) : 32U;
+}
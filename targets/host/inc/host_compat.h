@@ -0,0 +1,32 @@
+/**
+ * @file host_compat.h
+ * Newlib extensions expected by furi headers, for host libcs
+ *
+ * Force included into every host translation unit by targets/host/SConscript.
+ */
+#pragma once
+
+// Libs use static_assert, which newlib headers make visible everywhere
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifndef _ATTRIBUTE
+#define _ATTRIBUTE(attrs) __attribute__(attrs)
+#endif
+
+// glibc provides strlcpy since 2.38, macOS and the BSDs always did
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+#define FURI_HOST_STRLCPY
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+size_t strlcpy(char* dst, const char* src, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * @file task.h
+ * Host shim for FreeRTOS task notifications
+ *
+ * Every FuriThread has a small array of notification values, implemented in
+ * targets/host/furi/thread.c. A TaskHandle_t is a FuriThreadId.
+ */
+#pragma once
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void* TaskHandle_t;
+
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite,
+} eNotifyAction;
+
+BaseType_t xTaskNotifyIndexed(
+    TaskHandle_t task,
+    UBaseType_t index,
+    uint32_t value,
+    eNotifyAction action);
+
+BaseType_t xTaskNotifyIndexedFromISR(
+    TaskHandle_t task,
+    UBaseType_t index,
+    uint32_t value,
+    eNotifyAction action,
+    BaseType_t* yield);
+
+BaseType_t xTaskNotifyAndQueryIndexed(
+    TaskHandle_t task,
+    UBaseType_t index,
+    uint32_t value,
+    eNotifyAction action,
+    uint32_t* previous_value);
+
+BaseType_t xTaskNotifyWaitIndexed(
+    UBaseType_t index,
+    uint32_t clear_on_entry,
+    uint32_t clear_on_exit,
+    uint32_t* value,
+    TickType_t timeout);
+
+BaseType_t xTaskNotifyStateClearIndexed(TaskHandle_t task, UBaseType_t index);
+
+uint32_t ulTaskNotifyValueClearIndexed(TaskHandle_t task, UBaseType_t index, uint32_t bits);
+
+TickType_t xTaskGetTickCount(void);
+
+#ifdef __cplusplus
+}
+#endif
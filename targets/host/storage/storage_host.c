@@ -0,0 +1,868 @@
+#include "storage_host.h"
+
+#include <furi.h>
+#include <furi_hal_rtc.h>
+#include <m-array.h>
+#include <storage/storage.h>
+
+#define TAG "StorageHost"
+
+// Reported by fs_info, writes are not limited by it
+#define STORAGE_HOST_SIZE (64U * 1024U * 1024U)
+
+typedef struct {
+    FuriString* path;
+    bool is_dir;
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    uint32_t timestamp;
+    uint32_t open_count;
+    bool open_write;
+} StorageHostNode;
+
+ARRAY_DEF(StorageHostNodeArray, StorageHostNode*, M_PTR_OPLIST)
+
+struct Storage {
+    FuriMutex* mutex;
+    // Sorted by path
+    StorageHostNodeArray_t nodes;
+    FuriPubSub* pubsub;
+};
+
+typedef enum {
+    StorageHostFileTypeClosed,
+    StorageHostFileTypeFile,
+    StorageHostFileTypeDir,
+} StorageHostFileType;
+
+struct File {
+    Storage* storage;
+    StorageHostFileType type;
+    FS_AccessMode access_mode;
+    FuriString* path;
+    // Last returned entry when listing a directory
+    FuriString* cursor;
+    size_t position;
+    FS_Error error;
+};
+
+static const char* storage_host_roots[] = {STORAGE_EXT_PATH_PREFIX, STORAGE_INT_PATH_PREFIX};
+
+/** Absolute path without trailing slash, /any is resolved to /ext */
+static void storage_host_path_normalize(FuriString* path, const char* source) {
+    furi_string_set(path, source);
+    if(furi_string_start_with_str(path, STORAGE_ANY_PATH_PREFIX)) {
+        furi_string_replace_at(
+            path, 0, strlen(STORAGE_ANY_PATH_PREFIX), STORAGE_EXT_PATH_PREFIX);
+    }
+    while(furi_string_size(path) > 1 && furi_string_end_with(path, "/")) {
+        furi_string_left(path, furi_string_size(path) - 1);
+    }
+}
+
+static void storage_host_path_parent(FuriString* parent, FuriString* path) {
+    size_t slash = furi_string_search_rchar(path, '/');
+    furi_string_set(parent, path);
+    furi_string_left(parent, slash == FURI_STRING_FAILURE ? 0 : slash);
+}
+
+/** True if path is a direct or nested child of dir */
+static bool storage_host_path_is_child(const char* path, const char* dir) {
+    const size_t dir_len = strlen(dir);
+    return strncmp(path, dir, dir_len) == 0 && path[dir_len] == '/';
+}
+
+// Lookups below must be called with the storage mutex held
+
+/** Binary search, returns node index or the insertion point */
+static size_t storage_host_find_index(Storage* storage, const char* path, bool* found) {
+    size_t low = 0;
+    size_t high = StorageHostNodeArray_size(storage->nodes);
+
+    while(low < high) {
+        size_t mid = (low + high) / 2;
+        StorageHostNode* node = *StorageHostNodeArray_get(storage->nodes, mid);
+        int cmp = strcmp(furi_string_get_cstr(node->path), path);
+        if(cmp == 0) {
+            *found = true;
+            return mid;
+        } else if(cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    *found = false;
+    return low;
+}
+
+static StorageHostNode* storage_host_find(Storage* storage, const char* path) {
+    bool found;
+    size_t index = storage_host_find_index(storage, path, &found);
+    return found ? *StorageHostNodeArray_get(storage->nodes, index) : NULL;
+}
+
+static StorageHostNode* storage_host_create(Storage* storage, const char* path, bool is_dir) {
+    bool found;
+    size_t index = storage_host_find_index(storage, path, &found);
+    furi_check(!found);
+
+    StorageHostNode* node = malloc(sizeof(StorageHostNode));
+    node->path = furi_string_alloc_set(path);
+    node->is_dir = is_dir;
+    node->timestamp = furi_hal_rtc_get_timestamp();
+    StorageHostNodeArray_push_at(storage->nodes, index, node);
+
+    return node;
+}
+
+static void storage_host_node_free(StorageHostNode* node) {
+    furi_string_free(node->path);
+    free(node->data);
+    free(node);
+}
+
+static FS_Error storage_host_check_parent(Storage* storage, FuriString* path) {
+    FuriString* parent = furi_string_alloc();
+    storage_host_path_parent(parent, path);
+    StorageHostNode* node = storage_host_find(storage, furi_string_get_cstr(parent));
+    furi_string_free(parent);
+
+    if(!node) return FSE_NOT_EXIST;
+    if(!node->is_dir) return FSE_INVALID_NAME;
+    return FSE_OK;
+}
+
+static void storage_host_node_reserve(StorageHostNode* node, size_t size) {
+    if(size <= node->capacity) return;
+
+    size_t capacity = MAX(node->capacity * 2, (size_t)64);
+    while(capacity < size) {
+        capacity *= 2;
+    }
+
+    node->data = realloc(node->data, capacity);
+    memset(node->data + node->capacity, 0, capacity - node->capacity);
+    node->capacity = capacity;
+}
+
+/** Children sort right after their parent */
+static bool storage_host_has_child(Storage* storage, size_t index) {
+    if(index + 1 >= StorageHostNodeArray_size(storage->nodes)) return false;
+
+    StorageHostNode* node = *StorageHostNodeArray_get(storage->nodes, index);
+    StorageHostNode* next = *StorageHostNodeArray_get(storage->nodes, index + 1);
+    return storage_host_path_is_child(
+        furi_string_get_cstr(next->path), furi_string_get_cstr(node->path));
+}
+
+static size_t storage_host_used(Storage* storage) {
+    size_t used = 0;
+    for(size_t i = 0; i < StorageHostNodeArray_size(storage->nodes); i++) {
+        used += (*StorageHostNodeArray_get(storage->nodes, i))->size;
+    }
+    return used;
+}
+
+/******************* File Functions *******************/
+
+File* storage_file_alloc(Storage* storage) {
+    furi_check(storage);
+
+    File* file = malloc(sizeof(File));
+    file->storage = storage;
+    file->path = furi_string_alloc();
+    file->cursor = furi_string_alloc();
+
+    return file;
+}
+
+void storage_file_free(File* file) {
+    furi_check(file);
+
+    if(file->type == StorageHostFileTypeFile) {
+        storage_file_close(file);
+    } else if(file->type == StorageHostFileTypeDir) {
+        storage_dir_close(file);
+    }
+
+    furi_string_free(file->cursor);
+    furi_string_free(file->path);
+    free(file);
+}
+
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    furi_check(file);
+    furi_check(file->type == StorageHostFileTypeClosed);
+    furi_check(path);
+
+    Storage* storage = file->storage;
+    storage_host_path_normalize(file->path, path);
+    const char* cpath = furi_string_get_cstr(file->path);
+    const bool write = access_mode & FSAM_WRITE;
+
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    do {
+        file->error = storage_host_check_parent(storage, file->path);
+        if(file->error != FSE_OK) break;
+
+        StorageHostNode* node = storage_host_find(storage, cpath);
+        if(node && node->is_dir) {
+            file->error = FSE_DENIED;
+            break;
+        }
+        if(node && (node->open_write || (write && node->open_count))) {
+            file->error = FSE_ALREADY_OPEN;
+            break;
+        }
+
+        if(node && (open_mode & FSOM_CREATE_NEW)) {
+            file->error = FSE_EXIST;
+            break;
+        } else if(!node && (open_mode & FSOM_OPEN_EXISTING)) {
+            file->error = FSE_NOT_EXIST;
+            break;
+        } else if(node && (open_mode & FSOM_CREATE_ALWAYS)) {
+            node->size = 0;
+            node->timestamp = furi_hal_rtc_get_timestamp();
+        } else if(!node) {
+            node = storage_host_create(storage, cpath, false);
+        }
+
+        node->open_count++;
+        if(write) node->open_write = true;
+
+        file->type = StorageHostFileTypeFile;
+        file->access_mode = access_mode;
+        file->position = (open_mode & FSOM_OPEN_APPEND) ? node->size : 0;
+    } while(false);
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    return file->error == FSE_OK;
+}
+
+bool storage_file_close(File* file) {
+    furi_check(file);
+
+    if(file->type != StorageHostFileTypeFile) {
+        file->error = FSE_INVALID_PARAMETER;
+        return false;
+    }
+
+    Storage* storage = file->storage;
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    StorageHostNode* node = storage_host_find(storage, furi_string_get_cstr(file->path));
+    furi_check(node && node->open_count);
+    node->open_count--;
+    if(file->access_mode & FSAM_WRITE) node->open_write = false;
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    file->type = StorageHostFileTypeClosed;
+    file->error = FSE_OK;
+
+    return true;
+}
+
+bool storage_file_is_open(File* file) {
+    furi_check(file);
+    return file->type != StorageHostFileTypeClosed;
+}
+
+bool storage_file_is_dir(File* file) {
+    furi_check(file);
+    return file->type == StorageHostFileTypeDir;
+}
+
+size_t storage_file_read(File* file, void* buff, size_t bytes_to_read) {
+    furi_check(file);
+    furi_check(buff || !bytes_to_read);
+
+    if(file->type != StorageHostFileTypeFile || !(file->access_mode & FSAM_READ)) {
+        file->error = FSE_DENIED;
+        return 0;
+    }
+
+    Storage* storage = file->storage;
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    StorageHostNode* node = storage_host_find(storage, furi_string_get_cstr(file->path));
+    size_t bytes_read = 0;
+    if(file->position < node->size) {
+        bytes_read = MIN(bytes_to_read, node->size - file->position);
+        memcpy(buff, node->data + file->position, bytes_read);
+        file->position += bytes_read;
+    }
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    file->error = FSE_OK;
+    return bytes_read;
+}
+
+size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write) {
+    furi_check(file);
+    furi_check(buff || !bytes_to_write);
+
+    if(file->type != StorageHostFileTypeFile || !(file->access_mode & FSAM_WRITE)) {
+        file->error = FSE_DENIED;
+        return 0;
+    }
+
+    Storage* storage = file->storage;
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    StorageHostNode* node = storage_host_find(storage, furi_string_get_cstr(file->path));
+    storage_host_node_reserve(node, file->position + bytes_to_write);
+    memcpy(node->data + file->position, buff, bytes_to_write);
+    file->position += bytes_to_write;
+    node->size = MAX(node->size, file->position);
+    node->timestamp = furi_hal_rtc_get_timestamp();
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    file->error = FSE_OK;
+    return bytes_to_write;
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    furi_check(file);
+
+    if(file->type != StorageHostFileTypeFile) {
+        file->error = FSE_INVALID_PARAMETER;
+        return false;
+    }
+
+    Storage* storage = file->storage;
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    StorageHostNode* node = storage_host_find(storage, furi_string_get_cstr(file->path));
+    size_t position = from_start ? offset : file->position + offset;
+
+    // As FatFs: seeking past the end extends writable files, clamps the rest
+    if(position > node->size) {
+        if(file->access_mode & FSAM_WRITE) {
+            storage_host_node_reserve(node, position);
+            node->size = position;
+        } else {
+            position = node->size;
+        }
+    }
+    file->position = position;
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    file->error = FSE_OK;
+    return true;
+}
+
+uint64_t storage_file_tell(File* file) {
+    furi_check(file);
+    file->error = FSE_OK;
+    return file->position;
+}
+
+bool storage_file_truncate(File* file) {
+    furi_check(file);
+
+    if(file->type != StorageHostFileTypeFile || !(file->access_mode & FSAM_WRITE)) {
+        file->error = FSE_DENIED;
+        return false;
+    }
+
+    Storage* storage = file->storage;
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    StorageHostNode* node = storage_host_find(storage, furi_string_get_cstr(file->path));
+    if(file->position < node->size) node->size = file->position;
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    file->error = FSE_OK;
+    return true;
+}
+
+uint64_t storage_file_size(File* file) {
+    furi_check(file);
+
+    if(file->type != StorageHostFileTypeFile) {
+        file->error = FSE_INVALID_PARAMETER;
+        return 0;
+    }
+
+    Storage* storage = file->storage;
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+    uint64_t size = storage_host_find(storage, furi_string_get_cstr(file->path))->size;
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    file->error = FSE_OK;
+    return size;
+}
+
+bool storage_file_sync(File* file) {
+    furi_check(file);
+    file->error = FSE_OK;
+    return file->type == StorageHostFileTypeFile;
+}
+
+bool storage_file_eof(File* file) {
+    return storage_file_tell(file) >= storage_file_size(file);
+}
+
+bool storage_file_exists(Storage* storage, const char* path) {
+    FileInfo fileinfo;
+    return storage_common_stat(storage, path, &fileinfo) == FSE_OK &&
+           !file_info_is_dir(&fileinfo);
+}
+
+bool storage_file_copy_to_file(File* source, File* destination, size_t size) {
+    uint8_t* buffer = malloc(512);
+
+    while(size) {
+        size_t chunk = MIN(size, (size_t)512);
+        if(storage_file_read(source, buffer, chunk) != chunk) break;
+        if(storage_file_write(destination, buffer, chunk) != chunk) break;
+        size -= chunk;
+    }
+
+    free(buffer);
+    return size == 0;
+}
+
+FS_Error storage_file_get_error(File* file) {
+    furi_check(file);
+    return file->error;
+}
+
+const char* storage_file_get_error_desc(File* file) {
+    furi_check(file);
+    return storage_error_get_desc(file->error);
+}
+
+/******************* Dir Functions *******************/
+
+bool storage_dir_open(File* file, const char* path) {
+    furi_check(file);
+    furi_check(file->type == StorageHostFileTypeClosed);
+    furi_check(path);
+
+    Storage* storage = file->storage;
+    storage_host_path_normalize(file->path, path);
+
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+    StorageHostNode* node = storage_host_find(storage, furi_string_get_cstr(file->path));
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    if(!node) {
+        file->error = FSE_NOT_EXIST;
+    } else if(!node->is_dir) {
+        file->error = FSE_INVALID_NAME;
+    } else {
+        file->type = StorageHostFileTypeDir;
+        furi_string_reset(file->cursor);
+        file->error = FSE_OK;
+    }
+
+    return file->error == FSE_OK;
+}
+
+bool storage_dir_close(File* file) {
+    furi_check(file);
+
+    if(file->type != StorageHostFileTypeDir) {
+        file->error = FSE_INVALID_PARAMETER;
+        return false;
+    }
+
+    file->type = StorageHostFileTypeClosed;
+    file->error = FSE_OK;
+    return true;
+}
+
+bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length) {
+    furi_check(file);
+
+    if(file->type != StorageHostFileTypeDir) {
+        file->error = FSE_INVALID_PARAMETER;
+        return false;
+    }
+
+    Storage* storage = file->storage;
+    const char* dir = furi_string_get_cstr(file->path);
+    const size_t dir_len = furi_string_size(file->path);
+    file->error = FSE_NOT_EXIST;
+
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Next direct child after the cursor, entries are returned in path order
+    const char* cursor =
+        furi_string_empty(file->cursor) ? dir : furi_string_get_cstr(file->cursor);
+    bool found;
+    size_t index = storage_host_find_index(storage, cursor, &found);
+    if(found) index++;
+
+    for(; index < StorageHostNodeArray_size(storage->nodes); index++) {
+        StorageHostNode* node = *StorageHostNodeArray_get(storage->nodes, index);
+        const char* path = furi_string_get_cstr(node->path);
+        if(!storage_host_path_is_child(path, dir)) continue;
+        if(strchr(path + dir_len + 1, '/')) continue;
+
+        if(fileinfo) {
+            fileinfo->flags = node->is_dir ? FSF_DIRECTORY : 0;
+            fileinfo->size = node->size;
+        }
+        if(name) strlcpy(name, path + dir_len + 1, name_length);
+        furi_string_set(file->cursor, node->path);
+        file->error = FSE_OK;
+        break;
+    }
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    return file->error == FSE_OK;
+}
+
+bool storage_dir_rewind(File* file) {
+    furi_check(file);
+
+    if(file->type != StorageHostFileTypeDir) {
+        file->error = FSE_INVALID_PARAMETER;
+        return false;
+    }
+
+    furi_string_reset(file->cursor);
+    file->error = FSE_OK;
+    return true;
+}
+
+bool storage_dir_exists(Storage* storage, const char* path) {
+    FileInfo fileinfo;
+    return storage_common_stat(storage, path, &fileinfo) == FSE_OK &&
+           file_info_is_dir(&fileinfo);
+}
+
+/******************* Common Functions *******************/
+
+FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t* timestamp) {
+    furi_check(storage);
+    furi_check(path);
+
+    FuriString* npath = furi_string_alloc();
+    storage_host_path_normalize(npath, path);
+
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+    StorageHostNode* node = storage_host_find(storage, furi_string_get_cstr(npath));
+    if(node && timestamp) *timestamp = node->timestamp;
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    furi_string_free(npath);
+    return node ? FSE_OK : FSE_NOT_EXIST;
+}
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
+    furi_check(storage);
+    furi_check(path);
+
+    FuriString* npath = furi_string_alloc();
+    storage_host_path_normalize(npath, path);
+
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+    StorageHostNode* node = storage_host_find(storage, furi_string_get_cstr(npath));
+    if(node && fileinfo) {
+        fileinfo->flags = node->is_dir ? FSF_DIRECTORY : 0;
+        fileinfo->size = node->size;
+    }
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    furi_string_free(npath);
+    return node ? FSE_OK : FSE_NOT_EXIST;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    furi_check(storage);
+    furi_check(path);
+
+    FuriString* npath = furi_string_alloc();
+    storage_host_path_normalize(npath, path);
+    const char* cpath = furi_string_get_cstr(npath);
+    FS_Error error = FSE_OK;
+
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    do {
+        bool found;
+        size_t index = storage_host_find_index(storage, cpath, &found);
+        if(!found) {
+            error = FSE_NOT_EXIST;
+            break;
+        }
+
+        StorageHostNode* node = *StorageHostNodeArray_get(storage->nodes, index);
+        if(node->open_count) {
+            error = FSE_ALREADY_OPEN;
+            break;
+        }
+
+        // Roots can't be removed, directories must be empty
+        bool is_root = strchr(cpath + 1, '/') == NULL;
+        if(is_root || storage_host_has_child(storage, index)) {
+            error = FSE_DENIED;
+            break;
+        }
+
+        StorageHostNodeArray_erase(storage->nodes, index);
+        storage_host_node_free(node);
+    } while(false);
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    furi_string_free(npath);
+    return error;
+}
+
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
+    furi_check(storage);
+    furi_check(old_path);
+    furi_check(new_path);
+
+    FuriString* from = furi_string_alloc();
+    FuriString* to = furi_string_alloc();
+    storage_host_path_normalize(from, old_path);
+    storage_host_path_normalize(to, new_path);
+    const char* cfrom = furi_string_get_cstr(from);
+    const char* cto = furi_string_get_cstr(to);
+    FS_Error error = FSE_OK;
+
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    do {
+        if(!storage_host_find(storage, cfrom)) {
+            error = FSE_NOT_EXIST;
+            break;
+        }
+        if(storage_host_find(storage, cto)) {
+            error = FSE_EXIST;
+            break;
+        }
+        if(storage_host_path_is_child(cto, cfrom)) {
+            error = FSE_INVALID_NAME;
+            break;
+        }
+        error = storage_host_check_parent(storage, to);
+        if(error != FSE_OK) break;
+
+        // Take out the node and its children, open ones block the rename
+        StorageHostNodeArray_t moved;
+        StorageHostNodeArray_init(moved);
+        for(size_t i = 0; i < StorageHostNodeArray_size(storage->nodes); i++) {
+            StorageHostNode* node = *StorageHostNodeArray_get(storage->nodes, i);
+            const char* path = furi_string_get_cstr(node->path);
+            if(strcmp(path, cfrom) == 0 || storage_host_path_is_child(path, cfrom)) {
+                if(node->open_count) error = FSE_ALREADY_OPEN;
+                StorageHostNodeArray_push_back(moved, node);
+            }
+        }
+
+        if(error == FSE_OK) {
+            for(size_t i = 0; i < StorageHostNodeArray_size(moved); i++) {
+                StorageHostNode* node = *StorageHostNodeArray_get(moved, i);
+                bool found;
+                size_t index =
+                    storage_host_find_index(storage, furi_string_get_cstr(node->path), &found);
+                furi_check(found);
+                StorageHostNodeArray_erase(storage->nodes, index);
+
+                furi_string_replace_at(node->path, 0, furi_string_size(from), cto);
+                index = storage_host_find_index(storage, furi_string_get_cstr(node->path), &found);
+                furi_check(!found);
+                StorageHostNodeArray_push_at(storage->nodes, index, node);
+            }
+        }
+
+        StorageHostNodeArray_clear(moved);
+    } while(false);
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    furi_string_free(to);
+    furi_string_free(from);
+    return error;
+}
+
+FS_Error storage_common_mkdir(Storage* storage, const char* path) {
+    furi_check(storage);
+    furi_check(path);
+
+    FuriString* npath = furi_string_alloc();
+    storage_host_path_normalize(npath, path);
+    FS_Error error = FSE_OK;
+
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    if(storage_host_find(storage, furi_string_get_cstr(npath))) {
+        error = FSE_EXIST;
+    } else {
+        error = storage_host_check_parent(storage, npath);
+        if(error == FSE_OK) storage_host_create(storage, furi_string_get_cstr(npath), true);
+    }
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    furi_string_free(npath);
+    return error;
+}
+
+FS_Error storage_common_fs_info(
+    Storage* storage,
+    const char* fs_path,
+    uint64_t* total_space,
+    uint64_t* free_space) {
+    furi_check(storage);
+    furi_check(fs_path);
+
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+    size_t used = storage_host_used(storage);
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    if(total_space) *total_space = STORAGE_HOST_SIZE;
+    if(free_space) *free_space = used < STORAGE_HOST_SIZE ? STORAGE_HOST_SIZE - used : 0;
+
+    return FSE_OK;
+}
+
+bool storage_common_exists(Storage* storage, const char* path) {
+    return storage_common_stat(storage, path, NULL) == FSE_OK;
+}
+
+/******************* Error Functions *******************/
+
+const char* storage_error_get_desc(FS_Error error_id) {
+    switch(error_id) {
+    case FSE_OK:
+        return "OK";
+    case FSE_NOT_READY:
+        return "filesystem not ready";
+    case FSE_EXIST:
+        return "file/dir already exist";
+    case FSE_NOT_EXIST:
+        return "file/dir not exist";
+    case FSE_INVALID_PARAMETER:
+        return "invalid parameter";
+    case FSE_DENIED:
+        return "access denied";
+    case FSE_INVALID_NAME:
+        return "invalid name/path";
+    case FSE_INTERNAL:
+        return "internal error";
+    case FSE_NOT_IMPLEMENTED:
+        return "function not implemented";
+    case FSE_ALREADY_OPEN:
+        return "file is already open";
+    default:
+        return "unknown error";
+    }
+}
+
+/******************* Utils Functions *******************/
+
+bool file_info_is_dir(const FileInfo* file_info) {
+    furi_check(file_info);
+    return file_info->flags & FSF_DIRECTORY;
+}
+
+bool storage_simply_remove(Storage* storage, const char* path) {
+    FS_Error result = storage_common_remove(storage, path);
+    return result == FSE_OK || result == FSE_NOT_EXIST;
+}
+
+bool storage_simply_remove_recursive(Storage* storage, const char* path) {
+    furi_check(storage);
+    furi_check(path);
+
+    FuriString* npath = furi_string_alloc();
+    storage_host_path_normalize(npath, path);
+    const char* cpath = furi_string_get_cstr(npath);
+    bool result = true;
+
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Backwards, so children are gone before their parent is checked
+    for(size_t i = StorageHostNodeArray_size(storage->nodes); i > 0; i--) {
+        StorageHostNode* node = *StorageHostNodeArray_get(storage->nodes, i - 1);
+        const char* node_path = furi_string_get_cstr(node->path);
+        if(!storage_host_path_is_child(node_path, cpath) && strcmp(node_path, cpath) != 0) {
+            continue;
+        }
+        if(node->open_count || !strchr(node_path + 1, '/') ||
+           storage_host_has_child(storage, i - 1)) {
+            result = false;
+            continue;
+        }
+        StorageHostNodeArray_erase(storage->nodes, i - 1);
+        storage_host_node_free(node);
+    }
+
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+
+    furi_string_free(npath);
+    return result;
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    FS_Error result = storage_common_mkdir(storage, path);
+    return result == FSE_OK || result == FSE_EXIST;
+}
+
+void storage_get_next_filename(
+    Storage* storage,
+    const char* dirname,
+    const char* filename,
+    const char* fileextension,
+    FuriString* nextfilename,
+    uint8_t max_len) {
+    FuriString* name = furi_string_alloc_set(filename);
+    FuriString* path = furi_string_alloc_printf("%s/%s%s", dirname, filename, fileextension);
+
+    for(unsigned long num = 1; storage_common_exists(storage, furi_string_get_cstr(path));
+        num++) {
+        furi_string_printf(name, "%s%lu", filename, num);
+        furi_string_printf(
+            path, "%s/%s%s", dirname, furi_string_get_cstr(name), fileextension);
+    }
+
+    if(furi_string_size(name) > max_len) {
+        furi_string_set(name, filename);
+    }
+    furi_string_set(nextfilename, name);
+
+    furi_string_free(path);
+    furi_string_free(name);
+}
+
+FuriPubSub* storage_get_pubsub(Storage* storage) {
+    furi_check(storage);
+    return storage->pubsub;
+}
+
+void storage_host_init(void) {
+    Storage* storage = malloc(sizeof(Storage));
+    storage->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    storage->pubsub = furi_pubsub_alloc();
+    StorageHostNodeArray_init(storage->nodes);
+
+    for(size_t i = 0; i < COUNT_OF(storage_host_roots); i++) {
+        storage_host_create(storage, storage_host_roots[i], true);
+    }
+
+    furi_record_create(RECORD_STORAGE, storage);
+    FURI_LOG_I(TAG, "In-memory storage ready");
+}
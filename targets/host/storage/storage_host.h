@@ -0,0 +1,20 @@
+/**
+ * @file storage_host.h
+ * In-memory Storage for the host target
+ *
+ * Implements the Storage API on top of a RAM file tree with /ext and /int
+ * roots, /any is an alias of /ext. Contents are lost on exit, which keeps
+ * native tests hermetic.
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Allocate in-memory Storage and register it as RECORD_STORAGE */
+void storage_host_init(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,32 @@
+#include <subghz/devices/registry.h>
+
+// There are no radios on the host: the registry is empty, so SubGhz code that
+// is given a device name runs without one.
+
+static bool subghz_device_registry_valid = false;
+
+void subghz_device_registry_init(void) {
+    subghz_device_registry_valid = true;
+}
+
+void subghz_device_registry_deinit(void) {
+    subghz_device_registry_valid = false;
+}
+
+bool subghz_device_registry_is_valid(void) {
+    return subghz_device_registry_valid;
+}
+
+const SubGhzDevice* subghz_device_registry_get_by_name(const char* name) {
+    UNUSED(name);
+    return NULL;
+}
+
+const SubGhzDevice* subghz_device_registry_get_by_index(size_t index) {
+    UNUSED(index);
+    return NULL;
+}
+
+size_t subghz_device_registry_count(void) {
+    return 0;
+}
@@ -0,0 +1,329 @@
+/**
+ * @file buffered_file_stream_bench.c
+ * BufferedFileStream cache layouts under the access patterns of its callers
+ *
+ * Each workload runs over a plain FileStream for reference and over buffered
+ * streams with the same 1 KiB of cache split into 1 to 8 blocks, 1 x 1024 B
+ * being the former default. Workloads: an infrared library read through the
+ * FlipperFormat parser, which seeks back after counting values, a MIFARE
+ * Classic dump read line by line, and KeysDict style binary search lookups and
+ * line scans. Every layout must read the same data as the reference. On the
+ * device each block load is a storage call, a 512 byte block is one SD sector.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_stream.h>
+#include <toolbox/stream/stream.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/stream/buffered_file_stream.h>
+
+#include "host_bench.h"
+
+#include <stdio.h>
+
+#define TAG "BufferedFileStreamBench"
+
+#define BFS_BENCH_IR_FILE    EXT_PATH("bfs_bench.ir")
+#define BFS_BENCH_NFC_FILE   EXT_PATH("bfs_bench.nfc")
+#define BFS_BENCH_INDEX_FILE EXT_PATH("bfs_bench.idx")
+#define BFS_BENCH_DICT_FILE  EXT_PATH("bfs_bench.dic")
+
+#define BFS_BENCH_IR_SIGNALS  150
+#define BFS_BENCH_IR_TIMINGS  256
+#define BFS_BENCH_NFC_BLOCKS  256
+#define BFS_BENCH_INDEX_KEYS  4096
+#define BFS_BENCH_LOOKUPS     2000
+#define BFS_BENCH_DICT_KEYS   2000
+#define BFS_BENCH_CACHE_SIZE  1024
+#define BFS_BENCH_LOOKUP_SEED 0x1D3U
+#define BFS_BENCH_KEY_SYMBOLS 12
+
+typedef struct {
+    Storage* storage;
+    uint32_t rng;
+} BufferedFileStreamBench;
+
+typedef struct {
+    const char* name;
+    const char* path;
+    uint32_t (*run)(Stream* stream);
+} BufferedFileStreamBenchWorkload;
+
+static uint32_t bfs_bench_rand(uint32_t* rng) {
+    *rng = *rng * 1664525U + 1013904223U;
+    return *rng >> 8;
+}
+
+static uint32_t bfs_bench_mix(uint32_t checksum, uint32_t value) {
+    return checksum * 31 + value;
+}
+
+static void bfs_bench_write_ir(BufferedFileStreamBench* bench) {
+    FlipperFormat* format = flipper_format_file_alloc(bench->storage);
+    FuriString* name = furi_string_alloc();
+    uint32_t timings[BFS_BENCH_IR_TIMINGS];
+
+    furi_check(flipper_format_file_open_always(format, BFS_BENCH_IR_FILE));
+    furi_check(flipper_format_write_header_cstr(format, "IR library file", 1));
+    for(size_t i = 0; i < BFS_BENCH_IR_SIGNALS; i++) {
+        furi_string_printf(name, "Signal_%zu", i);
+        furi_check(flipper_format_write_comment_cstr(format, ""));
+        furi_check(flipper_format_write_string(format, "name", name));
+        if(i % 4) {
+            uint32_t address = bfs_bench_rand(&bench->rng) & 0xFF;
+            uint32_t command = bfs_bench_rand(&bench->rng) & 0xFF;
+            furi_check(flipper_format_write_string_cstr(format, "type", "parsed"));
+            furi_check(flipper_format_write_string_cstr(format, "protocol", "NEC"));
+            furi_check(flipper_format_write_hex(format, "address", (uint8_t*)&address, 4));
+            furi_check(flipper_format_write_hex(format, "command", (uint8_t*)&command, 4));
+        } else {
+            uint32_t frequency = 38000;
+            float duty_cycle = 0.33f;
+            for(size_t j = 0; j < COUNT_OF(timings); j++) {
+                timings[j] = 300 + bfs_bench_rand(&bench->rng) % 9000;
+            }
+            furi_check(flipper_format_write_string_cstr(format, "type", "raw"));
+            furi_check(flipper_format_write_uint32(format, "frequency", &frequency, 1));
+            furi_check(flipper_format_write_float(format, "duty_cycle", &duty_cycle, 1));
+            furi_check(flipper_format_write_uint32(format, "data", timings, COUNT_OF(timings)));
+        }
+    }
+
+    furi_string_free(name);
+    flipper_format_free(format);
+}
+
+static void bfs_bench_write_nfc(BufferedFileStreamBench* bench) {
+    FlipperFormat* format = flipper_format_file_alloc(bench->storage);
+    FuriString* key = furi_string_alloc();
+    uint8_t block[16];
+
+    furi_check(flipper_format_file_open_always(format, BFS_BENCH_NFC_FILE));
+    furi_check(flipper_format_write_header_cstr(format, "Flipper NFC device", 4));
+    furi_check(flipper_format_write_string_cstr(format, "Device type", "Mifare Classic"));
+    for(size_t i = 0; i < BFS_BENCH_NFC_BLOCKS; i++) {
+        for(size_t j = 0; j < sizeof(block); j++) {
+            block[j] = bfs_bench_rand(&bench->rng);
+        }
+        furi_string_printf(key, "Block %zu", i);
+        furi_check(flipper_format_write_hex(format, furi_string_get_cstr(key), block, 16));
+    }
+
+    furi_string_free(key);
+    flipper_format_free(format);
+}
+
+/** Sorted keys, as the second half of a KeysDict index */
+static void bfs_bench_write_index(BufferedFileStreamBench* bench) {
+    Stream* stream = file_stream_alloc(bench->storage);
+    furi_check(file_stream_open(stream, BFS_BENCH_INDEX_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+
+    uint64_t key = 0;
+    for(size_t i = 0; i < BFS_BENCH_INDEX_KEYS; i++) {
+        key += 1 + bfs_bench_rand(&bench->rng) % 0xFFFF;
+        furi_check(stream_write(stream, (const uint8_t*)&key, sizeof(key)) == sizeof(key));
+    }
+
+    stream_free(stream);
+}
+
+static void bfs_bench_write_dict(BufferedFileStreamBench* bench) {
+    Stream* stream = file_stream_alloc(bench->storage);
+    furi_check(file_stream_open(stream, BFS_BENCH_DICT_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+
+    for(size_t i = 0; i < BFS_BENCH_DICT_KEYS; i++) {
+        if(i % 64 == 0) furi_check(stream_write_format(stream, "# Group %zu\n\n", i / 64));
+        furi_check(stream_write_format(
+            stream,
+            "%06lX%06lX\n",
+            bfs_bench_rand(&bench->rng) & 0xFFFFFF,
+            bfs_bench_rand(&bench->rng) & 0xFFFFFF));
+    }
+
+    stream_free(stream);
+}
+
+/** Signals read like infrared_signal_read, the raw data is counted before it is read */
+static uint32_t bfs_bench_run_ir(Stream* stream) {
+    FuriString* value = furi_string_alloc();
+    uint32_t timings[BFS_BENCH_IR_TIMINGS];
+    uint32_t checksum = 0;
+
+    while(flipper_format_stream_read_value_line(
+        stream, "name", FlipperStreamValueStr, value, 1, false)) {
+        checksum = bfs_bench_mix(checksum, furi_string_hash(value));
+        furi_check(flipper_format_stream_read_value_line(
+            stream, "type", FlipperStreamValueStr, value, 1, false));
+        if(furi_string_equal(value, "parsed")) {
+            uint32_t address, command;
+            furi_check(flipper_format_stream_read_value_line(
+                stream, "protocol", FlipperStreamValueStr, value, 1, false));
+            furi_check(flipper_format_stream_read_value_line(
+                stream, "address", FlipperStreamValueHex, &address, 4, false));
+            furi_check(flipper_format_stream_read_value_line(
+                stream, "command", FlipperStreamValueHex, &command, 4, false));
+            checksum = bfs_bench_mix(bfs_bench_mix(checksum, address), command);
+        } else {
+            uint32_t frequency, count;
+            furi_check(flipper_format_stream_read_value_line(
+                stream, "frequency", FlipperStreamValueUint32, &frequency, 1, false));
+            furi_check(flipper_format_stream_get_value_count(stream, "data", &count, false));
+            furi_check(count == COUNT_OF(timings));
+            furi_check(flipper_format_stream_read_value_line(
+                stream, "data", FlipperStreamValueUint32, timings, count, false));
+            for(size_t j = 0; j < count; j++) {
+                checksum = bfs_bench_mix(checksum, timings[j]);
+            }
+        }
+    }
+
+    furi_string_free(value);
+    return checksum;
+}
+
+/** Blocks read in file order, like mf_classic_load */
+static uint32_t bfs_bench_run_nfc(Stream* stream) {
+    FuriString* key = furi_string_alloc();
+    uint8_t block[16];
+    uint32_t checksum = 0;
+
+    for(size_t i = 0; i < BFS_BENCH_NFC_BLOCKS; i++) {
+        furi_string_printf(key, "Block %zu", i);
+        furi_check(flipper_format_stream_read_value_line(
+            stream, furi_string_get_cstr(key), FlipperStreamValueHex, block, 16, false));
+        for(size_t j = 0; j < sizeof(block); j++) {
+            checksum = bfs_bench_mix(checksum, block[j]);
+        }
+    }
+
+    furi_string_free(key);
+    return checksum;
+}
+
+/** Binary search of the sorted keys, like keys_dict_index_is_key_present */
+static uint32_t bfs_bench_run_index(Stream* stream) {
+    uint32_t rng = BFS_BENCH_LOOKUP_SEED;
+    uint32_t checksum = 0;
+
+    for(size_t i = 0; i < BFS_BENCH_LOOKUPS; i++) {
+        // Known keys are probed by position, for a mix of hits and misses
+        uint64_t key;
+        const size_t target = bfs_bench_rand(&rng) % BFS_BENCH_INDEX_KEYS;
+        furi_check(stream_seek(stream, target * sizeof(key), StreamOffsetFromStart));
+        furi_check(stream_read(stream, (uint8_t*)&key, sizeof(key)) == sizeof(key));
+        key += i % 2;
+
+        size_t low = 0;
+        size_t high = BFS_BENCH_INDEX_KEYS;
+        bool found = false;
+        while(!found && low < high) {
+            const size_t middle = low + (high - low) / 2;
+            uint64_t probe;
+            furi_check(stream_seek(stream, middle * sizeof(probe), StreamOffsetFromStart));
+            furi_check(stream_read(stream, (uint8_t*)&probe, sizeof(probe)) == sizeof(probe));
+            if(probe == key) {
+                found = true;
+            } else if(probe < key) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        checksum = bfs_bench_mix(checksum, found);
+    }
+
+    return checksum;
+}
+
+/** Key lines read one by one, like keys_dict_get_next_key */
+static uint32_t bfs_bench_run_dict(Stream* stream) {
+    FuriString* line = furi_string_alloc();
+    uint32_t checksum = 0;
+
+    while(stream_read_line(stream, line)) {
+        if(furi_string_get_char(line, 0) == '#') continue;
+        if(furi_string_size(line) != BFS_BENCH_KEY_SYMBOLS + 1) continue;
+        checksum = bfs_bench_mix(checksum, furi_string_hash(line));
+    }
+
+    furi_string_free(line);
+    return checksum;
+}
+
+static const BufferedFileStreamBenchWorkload bfs_bench_workloads[] = {
+    {"IR library", BFS_BENCH_IR_FILE, bfs_bench_run_ir},
+    {"MIFARE Classic dump", BFS_BENCH_NFC_FILE, bfs_bench_run_nfc},
+    {"index lookups", BFS_BENCH_INDEX_FILE, bfs_bench_run_index},
+    {"dictionary scan", BFS_BENCH_DICT_FILE, bfs_bench_run_dict},
+};
+
+static const size_t bfs_bench_block_counts[] = {1, 2, 4, 8};
+
+static void bfs_bench_workload(
+    BufferedFileStreamBench* bench,
+    const BufferedFileStreamBenchWorkload* workload) {
+    printf("%s\r\n", workload->name);
+
+    Stream* stream = file_stream_alloc(bench->storage);
+    furi_check(file_stream_open(stream, workload->path, FSAM_READ, FSOM_OPEN_EXISTING));
+    uint64_t start = host_bench_now_ns();
+    const uint32_t reference = workload->run(stream);
+    printf("  %-14s %10.1f us\r\n", "file stream:", host_bench_elapsed_us(start));
+    stream_free(stream);
+
+    for(size_t i = 0; i < COUNT_OF(bfs_bench_block_counts); i++) {
+        const size_t block_count = bfs_bench_block_counts[i];
+        const size_t block_size = BFS_BENCH_CACHE_SIZE / block_count;
+        stream = buffered_file_stream_alloc_ex(bench->storage, block_size, block_count);
+        furi_check(
+            buffered_file_stream_open(stream, workload->path, FSAM_READ, FSOM_OPEN_EXISTING));
+
+        start = host_bench_now_ns();
+        furi_check(workload->run(stream) == reference);
+        const double elapsed_us = host_bench_elapsed_us(start);
+
+        StreamCacheStats stats;
+        buffered_file_stream_get_cache_stats(stream, &stats);
+        printf(
+            "  %zu x %4zu B:   %10.1f us, %6lu loads, %7.1f KiB loaded, %7lu hits\r\n",
+            block_count,
+            block_size,
+            elapsed_us,
+            stats.misses,
+            stats.misses * block_size / 1024.0,
+            stats.hits);
+        stream_free(stream);
+    }
+
+    furi_check(storage_simply_remove(bench->storage, workload->path));
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+    storage_host_init();
+
+    BufferedFileStreamBench* bench = malloc(sizeof(BufferedFileStreamBench));
+    bench->storage = furi_record_open(RECORD_STORAGE);
+    bench->rng = 0xB5;
+
+    bfs_bench_write_ir(bench);
+    bfs_bench_write_nfc(bench);
+    bfs_bench_write_index(bench);
+    bfs_bench_write_dict(bench);
+
+    for(size_t i = 0; i < COUNT_OF(bfs_bench_workloads); i++) {
+        bfs_bench_workload(bench, &bfs_bench_workloads[i]);
+    }
+
+    furi_record_close(RECORD_STORAGE);
+    free(bench);
+
+    printf("buffered_file_stream_bench passed\r\n");
+    return 0;
+}
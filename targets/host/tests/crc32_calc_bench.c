@@ -0,0 +1,238 @@
+/**
+ * @file crc32_calc_bench.c
+ * CRC32 engines of crc32_calc, equivalence and throughput
+ *
+ * Every engine must match a bit serial software CRC32 on the check value and on
+ * random seeds, offsets and lengths, fed in one call or in pieces, and file
+ * CRCs must not depend on the chunk size. Throughput is reported in MB/s per
+ * engine. On the host the hardware engine runs the bit serial model of the
+ * unit in furi_hal_crc.c, its rate says nothing about the device.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <toolbox/crc32_calc.h>
+
+#include "host_bench.h"
+
+#include <stdio.h>
+
+#define TAG "Crc32CalcBench"
+
+#define CRC32_CALC_BENCH_FILE EXT_PATH("crc32_calc_bench.bin")
+
+#define CRC32_CALC_BENCH_SIZE      (1024UL * 1024)
+#define CRC32_CALC_BENCH_CASES     2000
+#define CRC32_CALC_BENCH_MAX_LEN   300
+#define CRC32_CALC_BENCH_ROUNDS    8
+#define CRC32_CALC_BENCH_CHECK     (0xCBF43926UL)
+#define CRC32_CALC_BENCH_POLY      (0xEDB88320UL)
+#define CRC32_CALC_BENCH_LOCKED_MS 50
+
+typedef struct {
+    Crc32CalcEngine engine;
+    const char* name;
+} Crc32CalcBenchEngine;
+
+static const Crc32CalcBenchEngine crc32_calc_bench_engines[] = {
+    {Crc32CalcEngineNibble, "nibble"},
+    {Crc32CalcEngineByte, "byte"},
+    {Crc32CalcEngineSlice8, "slice-by-8"},
+    {Crc32CalcEngineHardware, "hardware"},
+};
+
+static const size_t crc32_calc_bench_chunks[] = {512, 4096, 16384};
+
+typedef struct {
+    Storage* storage;
+    uint8_t* data;
+    uint32_t rng;
+    uint32_t crc;
+    uint8_t progress;
+    volatile bool done;
+} Crc32CalcBench;
+
+static uint32_t crc32_calc_bench_rand(Crc32CalcBench* bench) {
+    bench->rng = bench->rng * 1664525U + 1013904223U;
+    return bench->rng >> 8;
+}
+
+/** Bit serial CRC32 (IEEE 802.3), the reference every engine is held to */
+static uint32_t crc32_calc_bench_reference(uint32_t crc, const uint8_t* data, size_t size) {
+    crc = ~crc;
+    while(size--) {
+        crc ^= *data++;
+        for(size_t i = 0; i < 8; i++) {
+            crc = (crc & 1U) ? (crc >> 1) ^ CRC32_CALC_BENCH_POLY : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+static void crc32_calc_bench_equivalence(Crc32CalcBench* bench) {
+    static const char check[] = "123456789";
+    furi_check(
+        crc32_calc_bench_reference(0, (const uint8_t*)check, strlen(check)) ==
+        CRC32_CALC_BENCH_CHECK);
+
+    for(size_t i = 0; i < COUNT_OF(crc32_calc_bench_engines); i++) {
+        const Crc32CalcEngine engine = crc32_calc_bench_engines[i].engine;
+        furi_check(
+            crc32_calc_buffer_ex(engine, 0, check, strlen(check)) == CRC32_CALC_BENCH_CHECK);
+        furi_check(crc32_calc_buffer_ex(engine, 0x12345678, NULL, 0) == 0x12345678);
+    }
+    furi_check(crc32_calc_buffer(0, check, strlen(check)) == CRC32_CALC_BENCH_CHECK);
+
+    // Odd offsets and lengths walk every alignment path of slice-by-8 and the unit
+    for(size_t i = 0; i < CRC32_CALC_BENCH_CASES; i++) {
+        const uint32_t seed = crc32_calc_bench_rand(bench) ^ (crc32_calc_bench_rand(bench) << 16);
+        const size_t offset = crc32_calc_bench_rand(bench) % 16;
+        const size_t size = crc32_calc_bench_rand(bench) % CRC32_CALC_BENCH_MAX_LEN;
+        const size_t split = size ? crc32_calc_bench_rand(bench) % size : 0;
+        const uint8_t* data = bench->data + offset;
+        const uint32_t expected = crc32_calc_bench_reference(seed, data, size);
+
+        for(size_t j = 0; j < COUNT_OF(crc32_calc_bench_engines); j++) {
+            const Crc32CalcEngine engine = crc32_calc_bench_engines[j].engine;
+            furi_check(crc32_calc_buffer_ex(engine, seed, data, size) == expected);
+
+            uint32_t crc = crc32_calc_buffer_ex(engine, seed, data, split);
+            crc = crc32_calc_buffer_ex(engine, crc, data + split, size - split);
+            furi_check(crc == expected);
+        }
+    }
+
+    printf("  %u random cases match the bit serial CRC32\r\n", CRC32_CALC_BENCH_CASES);
+}
+
+static void crc32_calc_bench_buffer(Crc32CalcBench* bench) {
+    for(size_t i = 0; i < COUNT_OF(crc32_calc_bench_engines); i++) {
+        const Crc32CalcBenchEngine* engine = &crc32_calc_bench_engines[i];
+
+        uint32_t crc = 0;
+        const uint64_t start = host_bench_now_ns();
+        for(size_t round = 0; round < CRC32_CALC_BENCH_ROUNDS; round++) {
+            crc = crc32_calc_buffer_ex(engine->engine, crc, bench->data, CRC32_CALC_BENCH_SIZE);
+        }
+        const double elapsed_us = host_bench_elapsed_us(start);
+
+        printf(
+            "  %-12s %8.1f MB/s\r\n",
+            engine->name,
+            CRC32_CALC_BENCH_ROUNDS * CRC32_CALC_BENCH_SIZE / MAX(elapsed_us, 1.0));
+    }
+}
+
+static void crc32_calc_bench_progress(const uint8_t progress, void* context) {
+    Crc32CalcBench* bench = context;
+    furi_check(progress >= bench->progress && progress <= 100);
+    bench->progress = progress;
+}
+
+static void crc32_calc_bench_file(Crc32CalcBench* bench) {
+    File* file = storage_file_alloc(bench->storage);
+    furi_check(
+        storage_file_open(file, CRC32_CALC_BENCH_FILE, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    furi_check(
+        storage_file_write(file, bench->data, CRC32_CALC_BENCH_SIZE) == CRC32_CALC_BENCH_SIZE);
+
+    const uint32_t expected = crc32_calc_bench_reference(0, bench->data, CRC32_CALC_BENCH_SIZE);
+    furi_check(crc32_calc_file(file, NULL, NULL) == expected);
+
+    for(size_t i = 0; i < COUNT_OF(crc32_calc_bench_engines); i++) {
+        const Crc32CalcBenchEngine* engine = &crc32_calc_bench_engines[i];
+        printf("  %-12s", engine->name);
+
+        for(size_t j = 0; j < COUNT_OF(crc32_calc_bench_chunks); j++) {
+            bench->progress = 0;
+            const uint64_t start = host_bench_now_ns();
+            const uint32_t crc = crc32_calc_file_ex(
+                file,
+                engine->engine,
+                crc32_calc_bench_chunks[j],
+                crc32_calc_bench_progress,
+                bench);
+            const double elapsed_us = host_bench_elapsed_us(start);
+
+            furi_check(crc == expected);
+            furi_check(bench->progress == 100);
+            printf(
+                " %5zu B: %7.1f MB/s",
+                crc32_calc_bench_chunks[j],
+                CRC32_CALC_BENCH_SIZE / MAX(elapsed_us, 1.0));
+        }
+        printf("\r\n");
+    }
+
+    storage_file_free(file);
+    furi_check(storage_simply_remove(bench->storage, CRC32_CALC_BENCH_FILE));
+}
+
+static int32_t crc32_calc_bench_locked_worker(void* context) {
+    Crc32CalcBench* bench = context;
+    bench->crc =
+        crc32_calc_buffer_ex(Crc32CalcEngineHardware, 0, bench->data, CRC32_CALC_BENCH_MAX_LEN);
+    bench->done = true;
+    return 0;
+}
+
+/** A calculation waits while the unit is held, as during a BLE stack restart */
+static void crc32_calc_bench_locked(Crc32CalcBench* bench) {
+    furi_check(furi_hal_crc_acquire(FuriWaitForever));
+    // Normal mutex, a second acquire does not nest
+    furi_check(!furi_hal_crc_acquire(0));
+
+    bench->done = false;
+    FuriThread* thread = furi_thread_alloc_ex(TAG, 1024, crc32_calc_bench_locked_worker, bench);
+    furi_thread_start(thread);
+
+    furi_delay_ms(CRC32_CALC_BENCH_LOCKED_MS);
+    furi_check(!bench->done);
+
+    furi_hal_crc_release();
+    furi_check(furi_thread_join(thread));
+    furi_thread_free(thread);
+
+    furi_check(bench->done);
+    furi_check(
+        bench->crc == crc32_calc_bench_reference(0, bench->data, CRC32_CALC_BENCH_MAX_LEN));
+    printf("  calculation waited for the unit to be released\r\n");
+}
+
+static void crc32_calc_bench(void) {
+    Crc32CalcBench* bench = malloc(sizeof(Crc32CalcBench));
+    bench->storage = furi_record_open(RECORD_STORAGE);
+    bench->data = malloc(CRC32_CALC_BENCH_SIZE);
+    bench->rng = 0xC4C;
+
+    for(size_t i = 0; i < CRC32_CALC_BENCH_SIZE; i++) {
+        bench->data[i] = crc32_calc_bench_rand(bench);
+    }
+
+    printf("Equivalence:\r\n");
+    crc32_calc_bench_equivalence(bench);
+    printf("Buffer, %lu KiB x %u:\r\n", CRC32_CALC_BENCH_SIZE / 1024, CRC32_CALC_BENCH_ROUNDS);
+    crc32_calc_bench_buffer(bench);
+    printf("File, %lu KiB, per chunk size:\r\n", CRC32_CALC_BENCH_SIZE / 1024);
+    crc32_calc_bench_file(bench);
+    printf("Locking:\r\n");
+    crc32_calc_bench_locked(bench);
+
+    free(bench->data);
+    furi_record_close(RECORD_STORAGE);
+    free(bench);
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+    storage_host_init();
+
+    crc32_calc_bench();
+
+    printf("crc32_calc_bench passed\r\n");
+    return 0;
+}
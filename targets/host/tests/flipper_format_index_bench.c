@@ -0,0 +1,391 @@
+/**
+ * @file flipper_format_index_bench.c
+ * FlipperFormat key reads and updates with the key index against the plain scan
+ *
+ * A MIFARE Classic 4K dump is saved and loaded through NfcDevice, then its
+ * "Block N" keys are read in file order, in reverse order and updated in
+ * random order, with and without the index. An infrared library is read
+ * signal by signal, in file order, the way the remote loaders do. Indexed and
+ * plain runs must read the same values and leave byte-identical files.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <flipper_format/flipper_format.h>
+#include <nfc/nfc_device.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+#include "host_bench.h"
+
+#include <stdio.h>
+
+#define TAG "FlipperFormatIndexBench"
+
+#define FF_INDEX_BENCH_NFC_FILE   EXT_PATH("ff_index_bench.nfc")
+#define FF_INDEX_BENCH_PLAIN_FILE EXT_PATH("ff_index_bench_plain.nfc")
+#define FF_INDEX_BENCH_INDEX_FILE EXT_PATH("ff_index_bench_index.nfc")
+#define FF_INDEX_BENCH_IR_FILE    EXT_PATH("ff_index_bench.ir")
+
+#define FF_INDEX_BENCH_IR_SIGNALS 150
+#define FF_INDEX_BENCH_IR_TIMINGS 96
+#define FF_INDEX_BENCH_DELETE_GAP 8
+#define FF_INDEX_BENCH_EXTRA_KEYS 32
+
+typedef struct {
+    Storage* storage;
+    MfClassicData* mf_classic;
+    uint16_t block_count;
+    uint16_t order[MF_CLASSIC_TOTAL_BLOCKS_MAX];
+    uint32_t rng;
+} FlipperFormatIndexBench;
+
+static uint32_t ff_index_bench_rand(FlipperFormatIndexBench* bench) {
+    bench->rng = bench->rng * 1664525U + 1013904223U;
+    return bench->rng >> 8;
+}
+
+static void ff_index_bench_block_key(FuriString* key, uint16_t block) {
+    furi_string_printf(key, "Block %u", block);
+}
+
+static void ff_index_bench_shuffle(FlipperFormatIndexBench* bench) {
+    for(uint16_t i = 0; i < bench->block_count; i++) {
+        bench->order[i] = i;
+    }
+    for(uint16_t i = bench->block_count - 1; i > 0; i--) {
+        uint16_t j = ff_index_bench_rand(bench) % (i + 1);
+        uint16_t swap = bench->order[i];
+        bench->order[i] = bench->order[j];
+        bench->order[j] = swap;
+    }
+}
+
+static void ff_index_bench_nfc_save(FlipperFormatIndexBench* bench) {
+    MfClassicData* data = mf_classic_alloc();
+    data->type = MfClassicType4k;
+    data->iso14443_3a_data->uid_len = 4;
+    for(size_t i = 0; i < data->iso14443_3a_data->uid_len; i++) {
+        data->iso14443_3a_data->uid[i] = ff_index_bench_rand(bench);
+    }
+    data->iso14443_3a_data->atqa[0] = 0x02;
+    data->iso14443_3a_data->sak = 0x18;
+
+    bench->block_count = mf_classic_get_total_block_num(data->type);
+    for(uint16_t i = 0; i < bench->block_count; i++) {
+        MfClassicBlock block;
+        for(size_t j = 0; j < sizeof(block.data); j++) {
+            block.data[j] = ff_index_bench_rand(bench);
+        }
+        mf_classic_set_block_read(data, i, &block);
+    }
+    // Keys of unknown sectors are saved as "??", the dump is complete
+    for(uint8_t i = 0; i < mf_classic_get_total_sectors_num(data->type); i++) {
+        const MfClassicBlock* trailer =
+            &data->block[mf_classic_get_sector_trailer_num_by_sector(i)];
+        uint64_t key_a = 0, key_b = 0;
+        for(size_t j = 0; j < MF_CLASSIC_KEY_SIZE; j++) {
+            key_a = key_a << 8 | trailer->data[j];
+            key_b = key_b << 8 | trailer->data[MF_CLASSIC_BLOCK_SIZE - MF_CLASSIC_KEY_SIZE + j];
+        }
+        mf_classic_set_key_found(data, i, MfClassicKeyTypeA, key_a);
+        mf_classic_set_key_found(data, i, MfClassicKeyTypeB, key_b);
+    }
+    bench->mf_classic = data;
+
+    NfcDevice* device = nfc_device_alloc();
+    nfc_device_set_data(device, NfcProtocolMfClassic, data);
+    furi_check(nfc_device_save(device, FF_INDEX_BENCH_NFC_FILE));
+    furi_check(nfc_device_save(device, FF_INDEX_BENCH_PLAIN_FILE));
+    furi_check(nfc_device_save(device, FF_INDEX_BENCH_INDEX_FILE));
+    nfc_device_free(device);
+}
+
+static void ff_index_bench_nfc_load(FlipperFormatIndexBench* bench) {
+    NfcDevice* device = nfc_device_alloc();
+
+    uint64_t start = host_bench_now_ns();
+    furi_check(nfc_device_load(device, FF_INDEX_BENCH_NFC_FILE));
+    printf("  %-30s %10.1f us\r\n", "nfc_device_load:", host_bench_elapsed_us(start));
+
+    furi_check(nfc_device_get_protocol(device) == NfcProtocolMfClassic);
+    const MfClassicData* data = nfc_device_get_data(device, NfcProtocolMfClassic);
+    furi_check(mf_classic_is_equal(data, bench->mf_classic));
+
+    nfc_device_free(device);
+}
+
+/** Read every block of the dump, each key looked up from the start in reverse order */
+static double ff_index_bench_nfc_read(
+    FlipperFormatIndexBench* bench,
+    const char* path,
+    bool indexed,
+    bool reverse) {
+    FlipperFormat* format = flipper_format_buffered_file_alloc(bench->storage);
+    FuriString* key = furi_string_alloc();
+    MfClassicBlock block;
+
+    uint64_t start = host_bench_now_ns();
+    flipper_format_set_key_index(format, indexed);
+    furi_check(flipper_format_buffered_file_open_existing(format, path));
+    for(uint16_t i = 0; i < bench->block_count; i++) {
+        const uint16_t block_num = reverse ? bench->block_count - 1 - i : i;
+        if(reverse) furi_check(flipper_format_rewind(format));
+        ff_index_bench_block_key(key, block_num);
+        furi_check(flipper_format_read_hex(
+            format, furi_string_get_cstr(key), block.data, sizeof(block.data)));
+        furi_check(!memcmp(&block, &bench->mf_classic->block[block_num], sizeof(block)));
+    }
+    double elapsed_us = host_bench_elapsed_us(start);
+
+    furi_string_free(key);
+    flipper_format_free(format);
+    return elapsed_us;
+}
+
+/** Rewrite blocks in random order, drop some and append new keys, as an editor would */
+static double ff_index_bench_nfc_update(
+    FlipperFormatIndexBench* bench,
+    const char* path,
+    bool indexed,
+    uint32_t seed,
+    uint32_t* checksum) {
+    FlipperFormat* format = flipper_format_file_alloc(bench->storage);
+    FuriString* key = furi_string_alloc();
+    MfClassicBlock block;
+
+    bench->rng = seed;
+    ff_index_bench_shuffle(bench);
+
+    uint64_t start = host_bench_now_ns();
+    flipper_format_set_key_index(format, indexed);
+    furi_check(flipper_format_file_open_existing(format, path));
+    for(uint16_t i = 0; i < bench->block_count; i++) {
+        const uint16_t block_num = bench->order[i];
+        ff_index_bench_block_key(key, block_num);
+        if(block_num % FF_INDEX_BENCH_DELETE_GAP == FF_INDEX_BENCH_DELETE_GAP - 1) {
+            furi_check(flipper_format_delete_key(format, furi_string_get_cstr(key)));
+        } else {
+            for(size_t j = 0; j < sizeof(block.data); j++) {
+                block.data[j] = ff_index_bench_rand(bench);
+            }
+            // Values change length now and then, to move the lines after it
+            const uint16_t size = (i % 3) ? sizeof(block.data) : sizeof(block.data) / 2;
+            furi_check(
+                flipper_format_update_hex(format, furi_string_get_cstr(key), block.data, size));
+        }
+
+        if(i % (bench->block_count / FF_INDEX_BENCH_EXTRA_KEYS) == 0) {
+            furi_string_printf(key, "Extra %u", i);
+            uint32_t value = i;
+            furi_check(flipper_format_insert_or_update_uint32(
+                format, furi_string_get_cstr(key), &value, 1));
+        }
+    }
+    double elapsed_us = host_bench_elapsed_us(start);
+
+    // Every remaining key must still be found where it is now
+    *checksum = 0;
+    for(uint16_t i = 0; i < bench->block_count; i++) {
+        const uint16_t block_num = bench->block_count - 1 - i;
+        ff_index_bench_block_key(key, block_num);
+        furi_check(flipper_format_rewind(format));
+        uint32_t count = 0;
+        const bool exists =
+            flipper_format_get_value_count(format, furi_string_get_cstr(key), &count);
+        const bool deleted =
+            (block_num % FF_INDEX_BENCH_DELETE_GAP) == FF_INDEX_BENCH_DELETE_GAP - 1;
+        furi_check(exists != deleted);
+        if(exists) {
+            furi_check(
+                flipper_format_read_hex(format, furi_string_get_cstr(key), block.data, count));
+            for(size_t j = 0; j < count; j++) {
+                *checksum = *checksum * 31 + block.data[j];
+            }
+        }
+    }
+
+    furi_string_free(key);
+    flipper_format_free(format);
+    return elapsed_us;
+}
+
+static void ff_index_bench_compare_files(Storage* storage, const char* path, const char* other) {
+    File* file = storage_file_alloc(storage);
+    File* other_file = storage_file_alloc(storage);
+    furi_check(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING));
+    furi_check(storage_file_open(other_file, other, FSAM_READ, FSOM_OPEN_EXISTING));
+
+    uint8_t buffer[256];
+    uint8_t other_buffer[sizeof(buffer)];
+    size_t was_read;
+    do {
+        was_read = storage_file_read(file, buffer, sizeof(buffer));
+        furi_check(storage_file_read(other_file, other_buffer, sizeof(other_buffer)) == was_read);
+        furi_check(!memcmp(buffer, other_buffer, was_read));
+    } while(was_read);
+
+    storage_file_free(other_file);
+    storage_file_free(file);
+}
+
+static void ff_index_bench_nfc(FlipperFormatIndexBench* bench) {
+    ff_index_bench_nfc_save(bench);
+    printf("MIFARE Classic 4K, %u blocks\r\n", bench->block_count);
+
+    ff_index_bench_nfc_load(bench);
+
+    const struct {
+        const char* name;
+        bool reverse;
+    } reads[] = {
+        {"file order:", false},
+        {"reverse order:", true},
+    };
+    for(size_t i = 0; i < COUNT_OF(reads); i++) {
+        double plain_us =
+            ff_index_bench_nfc_read(bench, FF_INDEX_BENCH_NFC_FILE, false, reads[i].reverse);
+        double index_us =
+            ff_index_bench_nfc_read(bench, FF_INDEX_BENCH_NFC_FILE, true, reads[i].reverse);
+        printf(
+            "  read, %-24s %10.1f us plain, %10.1f us indexed\r\n",
+            reads[i].name,
+            plain_us,
+            index_us);
+    }
+
+    const uint32_t seed = bench->rng;
+    uint32_t plain, indexed;
+    double plain_us =
+        ff_index_bench_nfc_update(bench, FF_INDEX_BENCH_PLAIN_FILE, false, seed, &plain);
+    double index_us =
+        ff_index_bench_nfc_update(bench, FF_INDEX_BENCH_INDEX_FILE, true, seed, &indexed);
+    furi_check(plain == indexed);
+    printf(
+        "  %-30s %10.1f us plain, %10.1f us indexed\r\n", "update:", plain_us, index_us);
+    ff_index_bench_compare_files(
+        bench->storage, FF_INDEX_BENCH_PLAIN_FILE, FF_INDEX_BENCH_INDEX_FILE);
+
+    mf_classic_free(bench->mf_classic);
+    furi_check(storage_simply_remove(bench->storage, FF_INDEX_BENCH_NFC_FILE));
+    furi_check(storage_simply_remove(bench->storage, FF_INDEX_BENCH_PLAIN_FILE));
+    furi_check(storage_simply_remove(bench->storage, FF_INDEX_BENCH_INDEX_FILE));
+}
+
+/** Library in the infrared remote format, parsed and raw signals mixed */
+static void ff_index_bench_ir_write(FlipperFormatIndexBench* bench) {
+    FlipperFormat* format = flipper_format_file_alloc(bench->storage);
+    FuriString* name = furi_string_alloc();
+    uint32_t timings[FF_INDEX_BENCH_IR_TIMINGS];
+
+    furi_check(flipper_format_file_open_always(format, FF_INDEX_BENCH_IR_FILE));
+    furi_check(flipper_format_write_header_cstr(format, "IR library file", 1));
+    for(size_t i = 0; i < FF_INDEX_BENCH_IR_SIGNALS; i++) {
+        furi_string_printf(name, "Signal_%zu", i);
+        furi_check(flipper_format_write_comment_cstr(format, ""));
+        furi_check(flipper_format_write_string(format, "name", name));
+        if(i % 4) {
+            uint32_t address = ff_index_bench_rand(bench) & 0xFF;
+            uint32_t command = ff_index_bench_rand(bench) & 0xFF;
+            furi_check(flipper_format_write_string_cstr(format, "type", "parsed"));
+            furi_check(flipper_format_write_string_cstr(format, "protocol", "NEC"));
+            furi_check(flipper_format_write_hex(format, "address", (uint8_t*)&address, 4));
+            furi_check(flipper_format_write_hex(format, "command", (uint8_t*)&command, 4));
+        } else {
+            uint32_t frequency = 38000;
+            float duty_cycle = 0.33f;
+            for(size_t j = 0; j < COUNT_OF(timings); j++) {
+                timings[j] = 300 + ff_index_bench_rand(bench) % 9000;
+            }
+            furi_check(flipper_format_write_string_cstr(format, "type", "raw"));
+            furi_check(flipper_format_write_uint32(format, "frequency", &frequency, 1));
+            furi_check(flipper_format_write_float(format, "duty_cycle", &duty_cycle, 1));
+            furi_check(
+                flipper_format_write_uint32(format, "data", timings, COUNT_OF(timings)));
+        }
+    }
+
+    furi_string_free(name);
+    flipper_format_free(format);
+}
+
+/** Read all signals like infrared_signal_read, returns a checksum of everything read */
+static uint32_t
+    ff_index_bench_ir_read(FlipperFormatIndexBench* bench, bool indexed, double* elapsed_us) {
+    FlipperFormat* format = flipper_format_buffered_file_alloc(bench->storage);
+    FuriString* value = furi_string_alloc();
+    uint32_t timings[FF_INDEX_BENCH_IR_TIMINGS];
+    uint32_t checksum = 0;
+    size_t signals = 0;
+
+    uint64_t start = host_bench_now_ns();
+    flipper_format_set_key_index(format, indexed);
+    furi_check(flipper_format_buffered_file_open_existing(format, FF_INDEX_BENCH_IR_FILE));
+    uint32_t version;
+    furi_check(flipper_format_read_header(format, value, &version));
+    while(flipper_format_read_string(format, "name", value)) {
+        checksum = checksum * 31 + furi_string_hash(value);
+        furi_check(flipper_format_read_string(format, "type", value));
+        if(furi_string_equal(value, "parsed")) {
+            uint32_t address, command;
+            furi_check(flipper_format_read_string(format, "protocol", value));
+            furi_check(flipper_format_read_hex(format, "address", (uint8_t*)&address, 4));
+            furi_check(flipper_format_read_hex(format, "command", (uint8_t*)&command, 4));
+            checksum = checksum * 31 + address;
+            checksum = checksum * 31 + command;
+        } else {
+            uint32_t frequency, count;
+            float duty_cycle;
+            furi_check(flipper_format_read_uint32(format, "frequency", &frequency, 1));
+            furi_check(flipper_format_read_float(format, "duty_cycle", &duty_cycle, 1));
+            furi_check(flipper_format_get_value_count(format, "data", &count));
+            furi_check(count == COUNT_OF(timings));
+            furi_check(flipper_format_read_uint32(format, "data", timings, count));
+            for(size_t j = 0; j < count; j++) {
+                checksum = checksum * 31 + timings[j];
+            }
+        }
+        signals++;
+    }
+    *elapsed_us = host_bench_elapsed_us(start);
+    furi_check(signals == FF_INDEX_BENCH_IR_SIGNALS);
+
+    furi_string_free(value);
+    flipper_format_free(format);
+    return checksum;
+}
+
+static void ff_index_bench_ir(FlipperFormatIndexBench* bench) {
+    ff_index_bench_ir_write(bench);
+    printf("IR library, %u signals\r\n", FF_INDEX_BENCH_IR_SIGNALS);
+
+    double plain_us, index_us;
+    uint32_t plain = ff_index_bench_ir_read(bench, false, &plain_us);
+    uint32_t indexed = ff_index_bench_ir_read(bench, true, &index_us);
+    furi_check(plain == indexed);
+    printf(
+        "  %-30s %10.1f us plain, %10.1f us indexed\r\n", "read, file order:", plain_us, index_us);
+
+    furi_check(storage_simply_remove(bench->storage, FF_INDEX_BENCH_IR_FILE));
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+    storage_host_init();
+
+    FlipperFormatIndexBench* bench = malloc(sizeof(FlipperFormatIndexBench));
+    bench->storage = furi_record_open(RECORD_STORAGE);
+    bench->rng = 0xF1F0;
+
+    ff_index_bench_nfc(bench);
+    ff_index_bench_ir(bench);
+
+    furi_record_close(RECORD_STORAGE);
+    free(bench);
+
+    printf("flipper_format_index_bench passed\r\n");
+    return 0;
+}
@@ -0,0 +1,23 @@
+/**
+ * @file host_bench.h
+ * Timing helpers shared by the host benchmarks
+ *
+ * Benchmarks log their results and check that the code under test still
+ * produces the same output as the path it replaces, numbers are not asserted.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+/** Monotonic time in nanoseconds */
+static inline uint64_t host_bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/** Microseconds elapsed since a host_bench_now_ns() sample */
+static inline double host_bench_elapsed_us(uint64_t start_ns) {
+    return (double)(host_bench_now_ns() - start_ns) / 1000.0;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file host_smoke_test.c
+ * Smoke test of the host port: threads, mutexes and the in-memory storage
+ *
+ * Exits with 0 on success, any failed check crashes through furi_check.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <stdio.h>
+
+#define TAG "HostSmokeTest"
+
+#define HOST_SMOKE_TEST_THREADS    4
+#define HOST_SMOKE_TEST_ITERATIONS 10000
+#define HOST_SMOKE_TEST_RETURN     42
+
+#define HOST_SMOKE_TEST_DIR  EXT_PATH("host_smoke_test")
+#define HOST_SMOKE_TEST_FILE HOST_SMOKE_TEST_DIR "/data.bin"
+
+typedef struct {
+    FuriMutex* mutex;
+    volatile uint32_t counter;
+} HostSmokeTestShared;
+
+static int32_t host_smoke_test_worker(void* context) {
+    HostSmokeTestShared* shared = context;
+
+    for(uint32_t i = 0; i < HOST_SMOKE_TEST_ITERATIONS; i++) {
+        furi_check(furi_mutex_acquire(shared->mutex, FuriWaitForever) == FuriStatusOk);
+        // Unprotected read-modify-write, loses counts unless the mutex excludes
+        const uint32_t counter = shared->counter;
+        furi_thread_yield();
+        shared->counter = counter + 1;
+        furi_check(furi_mutex_release(shared->mutex) == FuriStatusOk);
+    }
+
+    return HOST_SMOKE_TEST_RETURN;
+}
+
+static void host_smoke_test_threads(void) {
+    HostSmokeTestShared shared = {
+        .mutex = furi_mutex_alloc(FuriMutexTypeNormal),
+        .counter = 0,
+    };
+
+    FuriThread* threads[HOST_SMOKE_TEST_THREADS];
+    for(size_t i = 0; i < COUNT_OF(threads); i++) {
+        threads[i] = furi_thread_alloc_ex("HostSmokeWorker", 1024, host_smoke_test_worker, &shared);
+        furi_thread_start(threads[i]);
+    }
+
+    for(size_t i = 0; i < COUNT_OF(threads); i++) {
+        furi_check(furi_thread_join(threads[i]));
+        furi_check(furi_thread_get_return_code(threads[i]) == HOST_SMOKE_TEST_RETURN);
+        furi_thread_free(threads[i]);
+    }
+
+    furi_check(shared.counter == HOST_SMOKE_TEST_THREADS * HOST_SMOKE_TEST_ITERATIONS);
+    furi_mutex_free(shared.mutex);
+
+    FURI_LOG_I(TAG, "Threads and mutex: ok");
+}
+
+static void host_smoke_test_storage(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    uint8_t data[1500];
+    for(size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 7U);
+    }
+
+    furi_check(storage_simply_mkdir(storage, HOST_SMOKE_TEST_DIR));
+
+    File* file = storage_file_alloc(storage);
+    furi_check(storage_file_open(file, HOST_SMOKE_TEST_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    furi_check(storage_file_write(file, data, sizeof(data)) == sizeof(data));
+    furi_check(storage_file_close(file));
+
+    FileInfo fileinfo;
+    furi_check(storage_common_stat(storage, HOST_SMOKE_TEST_FILE, &fileinfo) == FSE_OK);
+    furi_check(!file_info_is_dir(&fileinfo) && fileinfo.size == sizeof(data));
+
+    uint8_t read_back[sizeof(data)] = {0};
+    furi_check(storage_file_open(file, HOST_SMOKE_TEST_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    furi_check(storage_file_seek(file, 1000, true));
+    furi_check(storage_file_read(file, read_back, sizeof(read_back)) == sizeof(data) - 1000);
+    furi_check(memcmp(read_back, data + 1000, sizeof(data) - 1000) == 0);
+    furi_check(storage_file_seek(file, 0, true));
+    furi_check(storage_file_read(file, read_back, sizeof(read_back)) == sizeof(data));
+    furi_check(memcmp(read_back, data, sizeof(data)) == 0);
+    furi_check(storage_file_close(file));
+
+    char name[32];
+    furi_check(storage_dir_open(file, HOST_SMOKE_TEST_DIR));
+    furi_check(storage_dir_read(file, &fileinfo, name, sizeof(name)));
+    furi_check(strcmp(name, "data.bin") == 0);
+    furi_check(!storage_dir_read(file, &fileinfo, name, sizeof(name)));
+    furi_check(storage_dir_close(file));
+    storage_file_free(file);
+
+    furi_check(storage_simply_remove_recursive(storage, HOST_SMOKE_TEST_DIR));
+    furi_check(!storage_common_exists(storage, HOST_SMOKE_TEST_FILE));
+
+    furi_record_close(RECORD_STORAGE);
+
+    FURI_LOG_I(TAG, "Storage: ok");
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+    storage_host_init();
+
+    host_smoke_test_threads();
+    host_smoke_test_storage();
+
+    printf("Host smoke test passed\r\n");
+
+    return 0;
+}
@@ -0,0 +1,381 @@
+/**
+ * @file keeloq_search_test.c
+ * KeeLoq manufacture key search against a one key at a time reference
+ *
+ * Frames encrypted with keys of every learning type, plus frames no key matches,
+ * are decoded with the KeeLoq decoder and must name the same manufacture as a
+ * sequential search in keystore order. Repeated frames hit the decoder search
+ * cache, reloading the keystore must drop it. Search rates are logged.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <lib/subghz/environment.h>
+#include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/protocols/keeloq.h>
+#include <lib/subghz/protocols/keeloq_common.h>
+#include <lib/subghz/blocks/math.h>
+
+#include "host_bench.h"
+
+#include <stdio.h>
+
+#define TAG "KeeloqSearchTest"
+
+#define KEELOQ_SEARCH_TEST_KEYS     512
+#define KEELOQ_SEARCH_TEST_FRAMES   64
+#define KEELOQ_SEARCH_TEST_UNKNOWN  "Unknown"
+#define KEELOQ_SEARCH_TEST_KEYSTORE EXT_PATH("keeloq_search_test.txt")
+#define KEELOQ_SEARCH_TEST_EXTRA    EXT_PATH("keeloq_search_test_extra.txt")
+
+typedef struct {
+    uint64_t data;
+    const char* expected;
+} KeeloqSearchTestFrame;
+
+typedef struct {
+    SubGhzEnvironment* environment;
+    SubGhzProtocolDecoderBase* decoder;
+    FuriString* output;
+    KeeloqSearchTestFrame frames[KEELOQ_SEARCH_TEST_FRAMES];
+    uint32_t rng;
+} KeeloqSearchTest;
+
+static uint32_t keeloq_search_test_rand(KeeloqSearchTest* test) {
+    test->rng = test->rng * 1664525U + 1013904223U;
+    return test->rng;
+}
+
+static uint64_t keeloq_search_test_rand_key(KeeloqSearchTest* test) {
+    return (uint64_t)keeloq_search_test_rand(test) << 32 | keeloq_search_test_rand(test);
+}
+
+static void keeloq_search_test_write_keystore(
+    Storage* storage,
+    const char* path,
+    const SubGhzKey* keys,
+    size_t count) {
+    File* file = storage_file_alloc(storage);
+    furi_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    FuriString* line = furi_string_alloc_set_str("Filetype: Flipper SubGhz Keystore File\n"
+                                                 "Version: 0\n"
+                                                 "Encryption: 0\n");
+    for(size_t i = 0; i < count; i++) {
+        furi_string_cat_printf(
+            line,
+            "%08lX%08lX:%hu:%s\n",
+            (uint32_t)(keys[i].key >> 32),
+            (uint32_t)keys[i].key,
+            keys[i].type,
+            keys[i].name);
+    }
+    const size_t size = furi_string_size(line);
+    furi_check(storage_file_write(file, furi_string_get_cstr(line), size) == size);
+    furi_string_free(line);
+    storage_file_free(file);
+}
+
+static bool keeloq_search_test_check(
+    uint32_t decrypt,
+    uint8_t btn,
+    uint16_t end_serial,
+    bool centurion) {
+    const uint16_t discriminator = (uint16_t)(decrypt >> 16);
+    if(decrypt >> 28 != btn) return false;
+    if(centurion) return (discriminator & 0x3FF) == 0x1CE;
+    return (discriminator & 0xFF) == end_serial || (discriminator & 0xFF) == 0;
+}
+
+static uint64_t keeloq_search_test_reverse_man(uint64_t key) {
+    uint64_t man_rev = 0;
+    for(uint8_t i = 0; i < 64; i += 8) {
+        man_rev |= (uint64_t)(uint8_t)(key >> i) << (56 - i);
+    }
+    return man_rev;
+}
+
+/** Reference search: candidate keys of each code in keystore order, one decrypt at a time */
+static const char*
+    keeloq_search_test_reference(SubGhzKeystore* keystore, uint32_t fix, uint32_t hop) {
+    const uint16_t end_serial = (uint16_t)(fix & 0xFF);
+    const uint8_t btn = (uint8_t)(fix >> 28);
+    SubGhzKeyArray_t* codes = subghz_keystore_get_data(keystore);
+
+    for(size_t i = 0; i < SubGhzKeyArray_size(*codes); i++) {
+        const SubGhzKey* code = SubGhzKeyArray_cget(*codes, i);
+        const uint64_t rev = keeloq_search_test_reverse_man(code->key);
+        uint64_t candidates[12];
+        size_t count = 0;
+        bool centurion = false;
+
+        switch(code->type) {
+        case KEELOQ_LEARNING_SIMPLE:
+            candidates[count++] = code->key;
+            break;
+        case KEELOQ_LEARNING_NORMAL:
+            candidates[count++] = subghz_protocol_keeloq_common_normal_learning(fix, code->key);
+            centurion = strcmp(code->name, "Centurion") == 0;
+            break;
+        case KEELOQ_LEARNING_SECURE:
+            candidates[count++] =
+                subghz_protocol_keeloq_common_secure_learning(fix, 0, code->key);
+            break;
+        case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+            candidates[count++] =
+                subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, code->key);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+            candidates[count++] =
+                subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, code->key);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+            candidates[count++] =
+                subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, code->key);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+            candidates[count++] =
+                subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, code->key);
+            break;
+        case KEELOQ_LEARNING_UNKNOWN:
+            candidates[count++] = code->key;
+            candidates[count++] = rev;
+            candidates[count++] = subghz_protocol_keeloq_common_normal_learning(fix, code->key);
+            candidates[count++] = subghz_protocol_keeloq_common_normal_learning(fix, rev);
+            candidates[count++] =
+                subghz_protocol_keeloq_common_secure_learning(fix, 0, code->key);
+            candidates[count++] = subghz_protocol_keeloq_common_secure_learning(fix, 0, rev);
+            candidates[count++] =
+                subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, code->key);
+            candidates[count++] =
+                subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, rev);
+            break;
+        default:
+            break;
+        }
+
+        for(size_t j = 0; j < count; j++) {
+            const uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, candidates[j]);
+            if(keeloq_search_test_check(decrypt, btn, end_serial, centurion)) return code->name;
+        }
+    }
+
+    return KEELOQ_SEARCH_TEST_UNKNOWN;
+}
+
+/** Learning key a remote using this code would encrypt with */
+static uint64_t
+    keeloq_search_test_learning_key(const SubGhzKey* code, uint32_t fix, bool reverse) {
+    const uint64_t key = reverse ? keeloq_search_test_reverse_man(code->key) : code->key;
+    switch(code->type) {
+    case KEELOQ_LEARNING_NORMAL:
+        return subghz_protocol_keeloq_common_normal_learning(fix, key);
+    case KEELOQ_LEARNING_SECURE:
+        return subghz_protocol_keeloq_common_secure_learning(fix, 0, key);
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        return subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        return subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        return subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        return subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key);
+    default:
+        return key;
+    }
+}
+
+static uint64_t keeloq_search_test_frame(uint32_t fix, uint32_t hop) {
+    return subghz_protocol_blocks_reverse_key((uint64_t)fix << 32 | hop, 64);
+}
+
+/** Decoder search result for a frame, as shown by get_string */
+static const char* keeloq_search_test_decode(KeeloqSearchTest* test, uint64_t data) {
+    FlipperFormat* format = flipper_format_string_alloc();
+    uint32_t bit = 64;
+    uint8_t key[sizeof(uint64_t)];
+    for(size_t i = 0; i < sizeof(key); i++) {
+        key[i] = (uint8_t)(data >> ((sizeof(key) - 1 - i) * 8));
+    }
+    furi_check(flipper_format_write_uint32(format, "Bit", &bit, 1));
+    furi_check(flipper_format_write_hex(format, "Key", key, sizeof(key)));
+    furi_check(
+        subghz_protocol_decoder_keeloq_deserialize(test->decoder, format) ==
+        SubGhzProtocolStatusOk);
+    flipper_format_free(format);
+
+    furi_string_reset(test->output);
+    subghz_protocol_decoder_keeloq_get_string(test->decoder, test->output);
+    size_t start = furi_string_search_str(test->output, "MF:");
+    furi_check(start != FURI_STRING_FAILURE);
+    start += strlen("MF:");
+    const size_t end = furi_string_search_str(test->output, "\r\n", start);
+    furi_check(end != FURI_STRING_FAILURE);
+    furi_string_mid(test->output, start, end - start);
+    return furi_string_get_cstr(test->output);
+}
+
+static void keeloq_search_test_generate(KeeloqSearchTest* test, Storage* storage) {
+    SubGhzKey* keys = malloc(KEELOQ_SEARCH_TEST_KEYS * sizeof(SubGhzKey));
+    char(*names)[16] = malloc(KEELOQ_SEARCH_TEST_KEYS * sizeof(*names));
+    for(size_t i = 0; i < KEELOQ_SEARCH_TEST_KEYS; i++) {
+        snprintf(names[i], sizeof(names[i]), "Mf%04u", (unsigned)i);
+        keys[i] = (SubGhzKey){
+            .name = names[i],
+            .key = keeloq_search_test_rand_key(test),
+            .type = i % (KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3 + 1),
+        };
+    }
+    keys[KEELOQ_SEARCH_TEST_KEYS / 2].name = "Centurion";
+    keys[KEELOQ_SEARCH_TEST_KEYS / 2].type = KEELOQ_LEARNING_NORMAL;
+    keeloq_search_test_write_keystore(
+        storage, KEELOQ_SEARCH_TEST_KEYSTORE, keys, KEELOQ_SEARCH_TEST_KEYS);
+
+    for(size_t i = 0; i < KEELOQ_SEARCH_TEST_FRAMES; i++) {
+        const uint8_t btn = 1 + keeloq_search_test_rand(test) % 8;
+        const uint32_t serial = keeloq_search_test_rand(test) & 0x0FFFFFFF;
+        const uint32_t fix = (uint32_t)btn << 28 | serial;
+        const uint16_t cnt = keeloq_search_test_rand(test);
+
+        if(i % 4 == 3) {
+            // Hop from no key in the keystore, may still match one by chance
+            test->frames[i].data =
+                keeloq_search_test_frame(fix, keeloq_search_test_rand(test) | 0x80000000);
+        } else {
+            // Mostly late keys, the search has to walk most of the keystore
+            const size_t index = (i == 0) ? KEELOQ_SEARCH_TEST_KEYS / 2 :
+                                            KEELOQ_SEARCH_TEST_KEYS - 1 - (i * 7) % 64;
+            const bool reverse = keys[index].type == KEELOQ_LEARNING_UNKNOWN && (i & 1);
+            const bool centurion = index == KEELOQ_SEARCH_TEST_KEYS / 2;
+            const uint16_t discriminator = centurion ? 0x1CE : (serial & 0xFF);
+            const uint32_t plain = (uint32_t)btn << 28 | (uint32_t)discriminator << 16 | cnt;
+            const uint64_t learning = keeloq_search_test_learning_key(&keys[index], fix, reverse);
+            const uint32_t hop = subghz_protocol_keeloq_common_encrypt(plain, learning);
+            test->frames[i].data = keeloq_search_test_frame(fix, hop);
+        }
+    }
+
+    free(names);
+    free(keys);
+}
+
+static void keeloq_search_test_equivalence(KeeloqSearchTest* test) {
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(test->environment);
+    size_t found = 0;
+
+    uint64_t reference_us = 0;
+    uint64_t search_us = 0;
+    uint64_t cached_us = 0;
+
+    for(size_t i = 0; i < KEELOQ_SEARCH_TEST_FRAMES; i++) {
+        const uint64_t reversed = subghz_protocol_blocks_reverse_key(test->frames[i].data, 64);
+        const uint32_t fix = reversed >> 32;
+        const uint32_t hop = (uint32_t)reversed;
+
+        uint64_t start = host_bench_now_ns();
+        test->frames[i].expected = keeloq_search_test_reference(keystore, fix, hop);
+        reference_us += host_bench_elapsed_us(start);
+
+        start = host_bench_now_ns();
+        const char* name = keeloq_search_test_decode(test, test->frames[i].data);
+        search_us += host_bench_elapsed_us(start);
+        furi_check(strcmp(name, test->frames[i].expected) == 0);
+
+        start = host_bench_now_ns();
+        name = keeloq_search_test_decode(test, test->frames[i].data);
+        cached_us += host_bench_elapsed_us(start);
+        furi_check(strcmp(name, test->frames[i].expected) == 0);
+
+        if(strcmp(name, KEELOQ_SEARCH_TEST_UNKNOWN) != 0) found++;
+    }
+
+    // Every frame made from a key is found, Centurion included
+    furi_check(found >= KEELOQ_SEARCH_TEST_FRAMES - KEELOQ_SEARCH_TEST_FRAMES / 4);
+    furi_check(strcmp(test->frames[0].expected, "Centurion") == 0);
+
+    printf(
+        "%u keys, %u frames, %u found\r\n"
+        "  one by one: %8llu us, %8.1f frames/s\r\n"
+        "  batched:    %8llu us, %8.1f frames/s\r\n"
+        "  cached:     %8llu us, %8.1f frames/s\r\n",
+        KEELOQ_SEARCH_TEST_KEYS,
+        KEELOQ_SEARCH_TEST_FRAMES,
+        (unsigned)found,
+        (unsigned long long)reference_us,
+        KEELOQ_SEARCH_TEST_FRAMES * 1e6 / MAX(reference_us, 1ULL),
+        (unsigned long long)search_us,
+        KEELOQ_SEARCH_TEST_FRAMES * 1e6 / MAX(search_us, 1ULL),
+        (unsigned long long)cached_us,
+        KEELOQ_SEARCH_TEST_FRAMES * 1e6 / MAX(cached_us, 1ULL));
+}
+
+static void keeloq_search_test_reload(KeeloqSearchTest* test, Storage* storage) {
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(test->environment);
+
+    // Frame no key matches yet, its Unknown result is now cached
+    uint32_t fix = 0;
+    uint32_t hop = 0;
+    do {
+        fix = keeloq_search_test_rand(test);
+        hop = keeloq_search_test_rand(test);
+    } while(strcmp(keeloq_search_test_reference(keystore, fix, hop), KEELOQ_SEARCH_TEST_UNKNOWN) !=
+            0);
+    const uint64_t data = keeloq_search_test_frame(fix, hop);
+    furi_check(strcmp(keeloq_search_test_decode(test, data), KEELOQ_SEARCH_TEST_UNKNOWN) == 0);
+
+    // A key that decrypts it to a valid discriminator, loaded on top
+    SubGhzKey extra = {.name = "Reloaded", .type = KEELOQ_LEARNING_SIMPLE};
+    do {
+        extra.key = keeloq_search_test_rand_key(test);
+    } while(!keeloq_search_test_check(
+        subghz_protocol_keeloq_common_decrypt(hop, extra.key),
+        fix >> 28,
+        fix & 0xFF,
+        false));
+    keeloq_search_test_write_keystore(storage, KEELOQ_SEARCH_TEST_EXTRA, &extra, 1);
+
+    const uint32_t generation = subghz_keystore_get_generation(keystore);
+    furi_check(subghz_environment_load_keystore(test->environment, KEELOQ_SEARCH_TEST_EXTRA));
+    furi_check(subghz_keystore_get_generation(keystore) != generation);
+
+    furi_check(strcmp(keeloq_search_test_reference(keystore, fix, hop), "Reloaded") == 0);
+    furi_check(strcmp(keeloq_search_test_decode(test, data), "Reloaded") == 0);
+
+    FURI_LOG_I(TAG, "Reload drops cached results: ok");
+}
+
+static void keeloq_search_test(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    KeeloqSearchTest* test = malloc(sizeof(KeeloqSearchTest));
+    test->rng = 0x4B51;
+    test->output = furi_string_alloc();
+
+    keeloq_search_test_generate(test, storage);
+
+    test->environment = subghz_environment_alloc();
+    furi_check(
+        subghz_environment_load_keystore(test->environment, KEELOQ_SEARCH_TEST_KEYSTORE));
+    test->decoder = subghz_protocol_decoder_keeloq_alloc(test->environment);
+
+    keeloq_search_test_equivalence(test);
+    keeloq_search_test_reload(test, storage);
+
+    subghz_protocol_decoder_keeloq_free(test->decoder);
+    subghz_environment_free(test->environment);
+    furi_string_free(test->output);
+    free(test);
+    furi_record_close(RECORD_STORAGE);
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+    storage_host_init();
+
+    keeloq_search_test();
+
+    printf("keeloq_search_test passed\r\n");
+    return 0;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file keys_dict_bench.c
+ * KeysDict lookups with the binary index against the text scan
+ *
+ * Writes dictionaries in the MIFARE Classic key format, then compares opening,
+ * iteration and lookups in text and indexed mode. Both modes must return the
+ * same keys in the same order and agree on every lookup. The biggest
+ * dictionary takes the multi-run path of the index build.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+#include <toolbox/keys_dict.h>
+
+#include "host_bench.h"
+
+#include <stdio.h>
+
+#define TAG "KeysDictBench"
+
+#define KEYS_DICT_BENCH_DIR      EXT_PATH("keys_dict_bench")
+#define KEYS_DICT_BENCH_KEY_SIZE 6
+#define KEYS_DICT_BENCH_LOOKUPS  2000
+
+typedef struct {
+    uint32_t rng;
+    size_t key_count;
+    uint8_t (*keys)[KEYS_DICT_BENCH_KEY_SIZE];
+} KeysDictBench;
+
+static uint32_t keys_dict_bench_random(KeysDictBench* bench) {
+    bench->rng = bench->rng * 1103515245U + 12345U;
+    return bench->rng >> 8;
+}
+
+static void keys_dict_bench_random_key(KeysDictBench* bench, uint8_t* key) {
+    for(size_t i = 0; i < KEYS_DICT_BENCH_KEY_SIZE; i++) {
+        key[i] = (uint8_t)keys_dict_bench_random(bench);
+    }
+}
+
+static void keys_dict_bench_write(KeysDictBench* bench, const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    furi_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+
+    char line[32];
+    for(size_t i = 0; i < bench->key_count; i++) {
+        // Comments and blank lines as in the system dictionaries
+        if(i % 64 == 0) {
+            int size = snprintf(line, sizeof(line), "# Group %zu\n\n", i / 64);
+            furi_check(storage_file_write(file, line, size) == (size_t)size);
+        }
+
+        keys_dict_bench_random_key(bench, bench->keys[i]);
+        const uint8_t* key = bench->keys[i];
+        int size = snprintf(
+            line,
+            sizeof(line),
+            "%02X%02X%02X%02X%02X%02X\n",
+            key[0],
+            key[1],
+            key[2],
+            key[3],
+            key[4],
+            key[5]);
+        furi_check(storage_file_write(file, line, size) == (size_t)size);
+    }
+
+    furi_check(storage_file_close(file));
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static KeysDict* keys_dict_bench_open(const char* path, KeysDictMode mode, const char* label) {
+    uint64_t start = host_bench_now_ns();
+    KeysDict* dict = keys_dict_alloc(path, mode, KEYS_DICT_BENCH_KEY_SIZE);
+    FURI_LOG_I(TAG, "  %-18s %10.1f us", label, host_bench_elapsed_us(start));
+    return dict;
+}
+
+static void keys_dict_bench_check_order(KeysDictBench* bench, KeysDict* dict) {
+    uint8_t key[KEYS_DICT_BENCH_KEY_SIZE];
+
+    furi_check(keys_dict_get_total_keys(dict) == bench->key_count);
+    furi_check(keys_dict_rewind(dict));
+    for(size_t i = 0; i < bench->key_count; i++) {
+        furi_check(keys_dict_get_next_key(dict, key, sizeof(key)));
+        furi_check(memcmp(key, bench->keys[i], sizeof(key)) == 0);
+    }
+    furi_check(!keys_dict_get_next_key(dict, key, sizeof(key)));
+}
+
+static void keys_dict_bench_lookups(
+    KeysDictBench* bench,
+    KeysDict* dict,
+    const char* label,
+    bool* results,
+    bool compare) {
+    uint8_t key[KEYS_DICT_BENCH_KEY_SIZE];
+    size_t found = 0;
+    uint32_t rng = bench->rng;
+
+    uint64_t start = host_bench_now_ns();
+    for(size_t i = 0; i < KEYS_DICT_BENCH_LOOKUPS; i++) {
+        // Half are present, the rest are random
+        if(i % 2) {
+            size_t index = keys_dict_bench_random(bench) % bench->key_count;
+            memcpy(key, bench->keys[index], sizeof(key));
+        } else {
+            keys_dict_bench_random_key(bench, key);
+        }
+
+        bool present = keys_dict_is_key_present(dict, key, sizeof(key));
+        if(compare) {
+            furi_check(results[i] == present);
+        } else {
+            results[i] = present;
+        }
+        found += present;
+    }
+    double elapsed = host_bench_elapsed_us(start);
+    bench->rng = rng;
+
+    furi_check(found >= KEYS_DICT_BENCH_LOOKUPS / 2);
+    FURI_LOG_I(
+        TAG,
+        "  %-18s %10.1f us, %.2f us per lookup",
+        label,
+        elapsed,
+        elapsed / KEYS_DICT_BENCH_LOOKUPS);
+}
+
+static void keys_dict_bench_run(KeysDictBench* bench, size_t key_count) {
+    char path[64];
+    char index_path[80];
+    char runs_path[80];
+    bool results[KEYS_DICT_BENCH_LOOKUPS];
+
+    snprintf(path, sizeof(path), "%s/keys_%zu.nfc", KEYS_DICT_BENCH_DIR, key_count);
+    snprintf(index_path, sizeof(index_path), "%s.idx", path);
+    snprintf(runs_path, sizeof(runs_path), "%s.tmp", index_path);
+
+    bench->key_count = key_count;
+    keys_dict_bench_write(bench, path);
+    FURI_LOG_I(TAG, "%zu keys:", key_count);
+
+    KeysDict* dict = keys_dict_bench_open(path, KeysDictModeOpenExisting, "Text open");
+    keys_dict_bench_check_order(bench, dict);
+    keys_dict_bench_lookups(bench, dict, "Text lookups", results, false);
+    keys_dict_free(dict);
+
+    dict = keys_dict_bench_open(path, KeysDictModeOpenExistingIndexed, "Index build");
+    keys_dict_free(dict);
+
+    dict = keys_dict_bench_open(path, KeysDictModeOpenExistingIndexed, "Index open");
+    keys_dict_bench_check_order(bench, dict);
+    keys_dict_bench_lookups(bench, dict, "Index lookups", results, true);
+    keys_dict_free(dict);
+
+    // Only the index is left behind, sort runs are removed
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    furi_check(storage_file_exists(storage, index_path));
+    furi_check(!storage_file_exists(storage, runs_path));
+    furi_record_close(RECORD_STORAGE);
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+    storage_host_init();
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    furi_check(storage_simply_mkdir(storage, KEYS_DICT_BENCH_DIR));
+    furi_record_close(RECORD_STORAGE);
+
+    KeysDictBench bench = {
+        .rng = 1,
+        .keys = malloc(8192 * KEYS_DICT_BENCH_KEY_SIZE),
+    };
+
+    // Single sort run, a typical system dictionary, and the index size limit
+    const size_t key_counts[] = {200, 2000, 8192};
+    for(size_t i = 0; i < COUNT_OF(key_counts); i++) {
+        keys_dict_bench_run(&bench, key_counts[i]);
+    }
+
+    free(bench.keys);
+
+    printf("KeysDict bench passed\r\n");
+
+    return 0;
+}
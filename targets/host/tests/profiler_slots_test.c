@@ -0,0 +1,221 @@
+/**
+ * @file profiler_slots_test.c
+ * ProfilerSlots nesting, self time, export and checks
+ *
+ * Timed scopes spin for known durations, so self times can be bounded from
+ * below and inclusive times must add up exactly along each call path. The
+ * export is converted by scripts/profiler.py, its folded stacks must match the
+ * statistics read in place. A mismatched exit must abort, whatever NDEBUG is.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <toolbox/profiler_slots.h>
+
+#include "host_bench.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define TAG "ProfilerSlotsTest"
+
+#define PROFILER_SLOTS_TEST_FRAMES    20
+#define PROFILER_SLOTS_TEST_FRAME_US  200
+#define PROFILER_SLOTS_TEST_UPDATE_US 100
+#define PROFILER_SLOTS_TEST_LEAF_US   50
+#define PROFILER_SLOTS_TEST_DEPTH     3
+#define PROFILER_SLOTS_TEST_LINE      256
+
+typedef struct {
+    ProfilerSlots* profiler;
+    ProfilerSlot frame;
+    ProfilerSlot update;
+    ProfilerSlot leaf;
+    ProfilerSlot recurse;
+} ProfilerSlotsTest;
+
+static void profiler_slots_test_spin(uint32_t us) {
+    const uint64_t start = host_bench_now_ns();
+    while(host_bench_now_ns() - start < us * 1000ULL) {
+    }
+}
+
+static void profiler_slots_test_recurse(ProfilerSlotsTest* test, size_t depth) {
+    profiler_slots_enter(test->profiler, test->recurse);
+    profiler_slots_test_spin(PROFILER_SLOTS_TEST_LEAF_US);
+    if(depth > 1) profiler_slots_test_recurse(test, depth - 1);
+    profiler_slots_exit(test->profiler, test->recurse);
+}
+
+static void profiler_slots_test_run(ProfilerSlotsTest* test) {
+    for(size_t i = 0; i < PROFILER_SLOTS_TEST_FRAMES; i++) {
+        profiler_slots_enter(test->profiler, test->frame);
+        profiler_slots_test_spin(PROFILER_SLOTS_TEST_FRAME_US / 2);
+
+        profiler_slots_enter(test->profiler, test->update);
+        profiler_slots_test_spin(PROFILER_SLOTS_TEST_UPDATE_US);
+        profiler_slots_enter(test->profiler, test->leaf);
+        profiler_slots_test_spin(PROFILER_SLOTS_TEST_LEAF_US);
+        profiler_slots_exit(test->profiler, test->leaf);
+        profiler_slots_exit(test->profiler, test->update);
+
+        profiler_slots_test_spin(PROFILER_SLOTS_TEST_FRAME_US / 2);
+        profiler_slots_exit(test->profiler, test->frame);
+
+        profiler_slots_test_recurse(test, PROFILER_SLOTS_TEST_DEPTH);
+    }
+}
+
+static void profiler_slots_test_stats(
+    ProfilerSlotsTest* test,
+    ProfilerSlot slot,
+    uint32_t count,
+    uint32_t self_us) {
+    const ProfilerSlotStats* stats = profiler_slots_get_stats(test->profiler, slot);
+    furi_check(stats->count == count);
+    furi_check(stats->self >= (uint64_t)count * self_us * 1000);
+    furi_check(stats->self <= stats->total);
+    furi_check(stats->min <= stats->max);
+
+    uint32_t histogram_count = 0;
+    for(size_t i = 0; i < PROFILER_SLOTS_HISTOGRAM_SIZE; i++) {
+        histogram_count += stats->histogram[i];
+    }
+    furi_check(histogram_count == count);
+}
+
+static bool profiler_slots_test_write(const void* data, size_t size, void* context) {
+    return fwrite(data, 1, size, context) == size;
+}
+
+/** Run profiler.py on the export, returns the sum of the values ending its output lines */
+static uint64_t
+    profiler_slots_test_script(const char* command, const char* path, const char* filter) {
+    char line[PROFILER_SLOTS_TEST_LINE];
+    snprintf(
+        line,
+        sizeof(line),
+        "%s %s %s %s%s",
+        PROFILER_SLOTS_TEST_PYTHON,
+        PROFILER_SLOTS_TEST_SCRIPT,
+        command,
+        path,
+        filter);
+    FILE* output = popen(line, "r");
+    furi_check(output);
+
+    uint64_t sum = 0;
+    size_t lines = 0;
+    while(fgets(line, sizeof(line), output)) {
+        printf("  %s", line);
+        const char* value = strrchr(line, ' ');
+        if(value) sum += strtoull(value + 1, NULL, 10);
+        lines++;
+    }
+    furi_check(pclose(output) == 0);
+    furi_check(lines > 0);
+
+    return sum;
+}
+
+static uint64_t profiler_slots_test_stack(const char* path, const char* stack) {
+    char filter[PROFILER_SLOTS_TEST_LINE];
+    snprintf(filter, sizeof(filter), " | grep -x '%s [0-9]*'", stack);
+    return profiler_slots_test_script("flamegraph", path, filter);
+}
+
+static void profiler_slots_test_export(ProfilerSlotsTest* test) {
+    char path[] = "/tmp/profiler_slots_test_XXXXXX";
+    const int fd = mkstemp(path);
+    furi_check(fd >= 0);
+    FILE* file = fdopen(fd, "wb");
+    furi_check(profiler_slots_export(test->profiler, profiler_slots_test_write, file));
+    furi_check(fclose(file) == 0);
+
+    // Folded stacks carry the self time of each call path
+    const ProfilerSlotStats* frame = profiler_slots_get_stats(test->profiler, test->frame);
+    const ProfilerSlotStats* update = profiler_slots_get_stats(test->profiler, test->update);
+    const ProfilerSlotStats* leaf = profiler_slots_get_stats(test->profiler, test->leaf);
+    const ProfilerSlotStats* recurse = profiler_slots_get_stats(test->profiler, test->recurse);
+    furi_check(profiler_slots_test_stack(path, "frame") == frame->self);
+    furi_check(profiler_slots_test_stack(path, "frame;update") == update->self);
+    furi_check(profiler_slots_test_stack(path, "frame;update;leaf") == leaf->self);
+
+    uint64_t recurse_self = 0;
+    char stack[PROFILER_SLOTS_TEST_LINE] = "recurse";
+    for(size_t i = 0; i < PROFILER_SLOTS_TEST_DEPTH; i++) {
+        const uint64_t self = profiler_slots_test_stack(path, stack);
+        furi_check(self > 0);
+        recurse_self += self;
+        strcat(stack, ";recurse");
+    }
+    furi_check(recurse_self == recurse->self);
+
+    profiler_slots_test_script("stats", path, "");
+    furi_check(unlink(path) == 0);
+}
+
+/** Exit of a slot that is not the innermost one aborts, in a child process */
+static void profiler_slots_test_mismatch(ProfilerSlotsTest* test) {
+    fflush(stdout);
+    const pid_t pid = fork();
+    furi_check(pid >= 0);
+    if(pid == 0) {
+        // The expected abort message is not a test failure
+        freopen("/dev/null", "w", stderr);
+        profiler_slots_enter(test->profiler, test->frame);
+        profiler_slots_exit(test->profiler, test->update);
+        _exit(0);
+    }
+
+    int status;
+    furi_check(waitpid(pid, &status, 0) == pid);
+    furi_check(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+}
+
+static void profiler_slots_test(void) {
+    ProfilerSlotsTest test;
+    test.profiler = profiler_slots_alloc(4, 16);
+    test.frame = profiler_slots_register(test.profiler, "frame");
+    test.update = profiler_slots_register(test.profiler, "update");
+    test.leaf = profiler_slots_register(test.profiler, "leaf");
+    test.recurse = profiler_slots_register(test.profiler, "recurse");
+
+    profiler_slots_test_run(&test);
+    profiler_slots_dump(test.profiler);
+
+    const uint32_t frames = PROFILER_SLOTS_TEST_FRAMES;
+    profiler_slots_test_stats(&test, test.frame, frames, PROFILER_SLOTS_TEST_FRAME_US);
+    profiler_slots_test_stats(&test, test.update, frames, PROFILER_SLOTS_TEST_UPDATE_US);
+    profiler_slots_test_stats(&test, test.leaf, frames, PROFILER_SLOTS_TEST_LEAF_US);
+    profiler_slots_test_stats(
+        &test, test.recurse, frames * PROFILER_SLOTS_TEST_DEPTH, PROFILER_SLOTS_TEST_LEAF_US);
+
+    // Nested time is moved from the parent self time, never lost or counted twice
+    const ProfilerSlotStats* frame = profiler_slots_get_stats(test.profiler, test.frame);
+    const ProfilerSlotStats* update = profiler_slots_get_stats(test.profiler, test.update);
+    const ProfilerSlotStats* leaf = profiler_slots_get_stats(test.profiler, test.leaf);
+    furi_check(frame->total == frame->self + update->total);
+    furi_check(update->total == update->self + leaf->total);
+
+    profiler_slots_test_export(&test);
+    profiler_slots_test_mismatch(&test);
+
+    profiler_slots_reset(test.profiler);
+    furi_check(profiler_slots_get_stats(test.profiler, test.frame)->count == 0);
+
+    profiler_slots_free(test.profiler);
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+
+    profiler_slots_test();
+
+    printf("profiler_slots_test passed\r\n");
+    return 0;
+}
@@ -0,0 +1,274 @@
+/**
+ * @file sd_fatfs_test.c
+ * FatFs and the SD sector cache on the host RAM disk
+ *
+ * Formats the disk, then runs directory listing and file copy workloads and
+ * checks every file after a remount with an empty cache. Raw HAL block access
+ * is checked to stay coherent with the cache. Exits with 0 on success, any
+ * failed check crashes through furi_check.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <fatfs.h>
+#include <sector_cache.h>
+
+#include <stdio.h>
+
+#define TAG "SdFatfsTest"
+
+#define SD_FATFS_TEST_VOLUME "0:"
+#define SD_FATFS_TEST_DIRS   8
+#define SD_FATFS_TEST_FILES  32
+#define SD_FATFS_TEST_COPIES 4
+#define SD_FATFS_TEST_PASSES 3
+
+#define SD_FATFS_TEST_SECTOR_SIZE 512
+#define SD_FATFS_TEST_RAW_SECTOR  1000
+
+typedef struct {
+    uint32_t rng;
+    uint32_t sizes[SD_FATFS_TEST_DIRS][SD_FATFS_TEST_FILES];
+    uint32_t sums[SD_FATFS_TEST_DIRS][SD_FATFS_TEST_FILES];
+    uint8_t buffer[4096];
+} SdFatfsTest;
+
+static uint32_t sd_fatfs_test_random(SdFatfsTest* test) {
+    test->rng = test->rng * 1103515245U + 12345U;
+    return test->rng >> 8;
+}
+
+static uint32_t sd_fatfs_test_sum(const uint8_t* data, size_t size, uint32_t sum) {
+    while(size--) {
+        sum = sum * 31U + *data++;
+    }
+    return sum;
+}
+
+static void sd_fatfs_test_log_stats(const char* workload, const SectorCacheStats* before) {
+    SectorCacheStats stats;
+    sector_cache_get_stats(&stats);
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu hits, %lu misses, %lu evictions, %lu write backs",
+        workload,
+        (unsigned long)(stats.hits - before->hits),
+        (unsigned long)(stats.misses - before->misses),
+        (unsigned long)(stats.evictions - before->evictions),
+        (unsigned long)(stats.write_backs - before->write_backs));
+}
+
+static void sd_fatfs_test_raw_coherency(void) {
+    uint8_t cached[SD_FATFS_TEST_SECTOR_SIZE];
+    uint8_t written[SD_FATFS_TEST_SECTOR_SIZE];
+    uint32_t blocks[3 * SD_FATFS_TEST_SECTOR_SIZE / sizeof(uint32_t)];
+    const uint8_t* middle = (const uint8_t*)blocks + SD_FATFS_TEST_SECTOR_SIZE;
+
+    memset(cached, 0xA5, sizeof(cached));
+    memset(written, 0x5A, sizeof(written));
+
+    // Dirty sector is newer than the disk, raw reads must see it
+    furi_check(sector_cache_put(SD_FATFS_TEST_RAW_SECTOR, cached, SectorCacheFlagDirty));
+    furi_check(furi_hal_sd_read_blocks(blocks, SD_FATFS_TEST_RAW_SECTOR - 1, 3) == FuriStatusOk);
+    furi_check(memcmp(middle, cached, sizeof(cached)) == 0);
+
+    // Raw write supersedes the cached copy
+    FuriStatus status =
+        furi_hal_sd_write_blocks((const uint32_t*)written, SD_FATFS_TEST_RAW_SECTOR, 1);
+    furi_check(status == FuriStatusOk);
+    furi_check(sector_cache_get(SD_FATFS_TEST_RAW_SECTOR) == NULL);
+    furi_check(furi_hal_sd_read_blocks(blocks, SD_FATFS_TEST_RAW_SECTOR - 1, 3) == FuriStatusOk);
+    furi_check(memcmp(middle, written, sizeof(written)) == 0);
+
+    // Clean copies are dropped too, multi block writes included
+    furi_check(sector_cache_put(SD_FATFS_TEST_RAW_SECTOR + 1, cached, SectorCacheFlagNone));
+    memset(blocks, 0, sizeof(blocks));
+    furi_check(furi_hal_sd_write_blocks(blocks, SD_FATFS_TEST_RAW_SECTOR, 3) == FuriStatusOk);
+    furi_check(sector_cache_get(SD_FATFS_TEST_RAW_SECTOR + 1) == NULL);
+
+    FURI_LOG_I(TAG, "Raw access coherency: ok");
+}
+
+static void
+    sd_fatfs_test_write_file(SdFatfsTest* test, const char* path, uint32_t size, uint32_t* sum) {
+    FIL file;
+    furi_check(f_open(&file, path, FA_WRITE | FA_CREATE_ALWAYS) == FR_OK);
+
+    *sum = 0;
+    while(size) {
+        // Storage service writes in small chunks
+        UINT chunk = size < SD_FATFS_TEST_SECTOR_SIZE ?
+                         size :
+                         1 + sd_fatfs_test_random(test) % SD_FATFS_TEST_SECTOR_SIZE;
+        for(UINT i = 0; i < chunk; i++) {
+            test->buffer[i] = (uint8_t)sd_fatfs_test_random(test);
+        }
+        *sum = sd_fatfs_test_sum(test->buffer, chunk, *sum);
+
+        UINT written;
+        furi_check(f_write(&file, test->buffer, chunk, &written) == FR_OK && written == chunk);
+        size -= chunk;
+    }
+
+    furi_check(f_close(&file) == FR_OK);
+}
+
+static uint32_t sd_fatfs_test_read_sum(SdFatfsTest* test, const char* path) {
+    FIL file;
+    furi_check(f_open(&file, path, FA_READ) == FR_OK);
+
+    uint32_t sum = 0;
+    UINT read;
+    do {
+        furi_check(f_read(&file, test->buffer, sizeof(test->buffer), &read) == FR_OK);
+        sum = sd_fatfs_test_sum(test->buffer, read, sum);
+    } while(read == sizeof(test->buffer));
+
+    furi_check(f_close(&file) == FR_OK);
+    return sum;
+}
+
+static void sd_fatfs_test_create_tree(SdFatfsTest* test) {
+    char path[64];
+
+    for(size_t dir = 0; dir < SD_FATFS_TEST_DIRS; dir++) {
+        snprintf(path, sizeof(path), "/dir%02zu", dir);
+        furi_check(f_mkdir(path) == FR_OK);
+
+        for(size_t i = 0; i < SD_FATFS_TEST_FILES; i++) {
+            snprintf(path, sizeof(path), "/dir%02zu/file_%03zu.sub", dir, i);
+            test->sizes[dir][i] = 100 + sd_fatfs_test_random(test) % 12000;
+            sd_fatfs_test_write_file(test, path, test->sizes[dir][i], &test->sums[dir][i]);
+        }
+    }
+}
+
+static void sd_fatfs_test_list_dirs(SdFatfsTest* test) {
+    char path[64];
+    char file_path[sizeof(path) + _MAX_LFN + 2];
+
+    for(size_t pass = 0; pass < SD_FATFS_TEST_PASSES; pass++) {
+        for(size_t dir = 0; dir < SD_FATFS_TEST_DIRS; dir++) {
+            DIR dir_object;
+            FILINFO fileinfo;
+            size_t count = 0;
+
+            snprintf(path, sizeof(path), "/dir%02zu", dir);
+            furi_check(f_opendir(&dir_object, path) == FR_OK);
+            while(f_readdir(&dir_object, &fileinfo) == FR_OK && fileinfo.fname[0]) {
+                size_t i;
+                furi_check(sscanf(fileinfo.fname, "file_%zu.sub", &i) == 1);
+                furi_check(i < SD_FATFS_TEST_FILES && fileinfo.fsize == test->sizes[dir][i]);
+
+                // File manager stats every entry it lists
+                snprintf(file_path, sizeof(file_path), "%s/%s", path, fileinfo.fname);
+                furi_check(f_stat(file_path, &fileinfo) == FR_OK);
+                count++;
+            }
+            furi_check(f_closedir(&dir_object) == FR_OK);
+            furi_check(count == SD_FATFS_TEST_FILES);
+        }
+    }
+}
+
+static void sd_fatfs_test_copy_files(SdFatfsTest* test) {
+    char path[64];
+    char copy_path[64];
+
+    furi_check(f_mkdir("/copy") == FR_OK);
+
+    for(size_t dir = 0; dir < SD_FATFS_TEST_COPIES; dir++) {
+        for(size_t i = 0; i < SD_FATFS_TEST_FILES; i++) {
+            FIL source, destination;
+            snprintf(path, sizeof(path), "/dir%02zu/file_%03zu.sub", dir, i);
+            snprintf(copy_path, sizeof(copy_path), "/copy/dir%02zu_file_%03zu.sub", dir, i);
+            furi_check(f_open(&source, path, FA_READ) == FR_OK);
+            furi_check(f_open(&destination, copy_path, FA_WRITE | FA_CREATE_ALWAYS) == FR_OK);
+
+            UINT read, written;
+            do {
+                furi_check(
+                    f_read(&source, test->buffer, SD_FATFS_TEST_SECTOR_SIZE, &read) == FR_OK);
+                furi_check(
+                    f_write(&destination, test->buffer, read, &written) == FR_OK &&
+                    written == read);
+            } while(read == SD_FATFS_TEST_SECTOR_SIZE);
+
+            furi_check(f_close(&source) == FR_OK);
+            furi_check(f_close(&destination) == FR_OK);
+        }
+    }
+}
+
+static void sd_fatfs_test_verify(SdFatfsTest* test) {
+    char path[64];
+
+    for(size_t dir = 0; dir < SD_FATFS_TEST_DIRS; dir++) {
+        for(size_t i = 0; i < SD_FATFS_TEST_FILES; i++) {
+            snprintf(path, sizeof(path), "/dir%02zu/file_%03zu.sub", dir, i);
+            furi_check(sd_fatfs_test_read_sum(test, path) == test->sums[dir][i]);
+
+            if(dir < SD_FATFS_TEST_COPIES) {
+                snprintf(path, sizeof(path), "/copy/dir%02zu_file_%03zu.sub", dir, i);
+                furi_check(sd_fatfs_test_read_sum(test, path) == test->sums[dir][i]);
+            }
+        }
+    }
+}
+
+static void sd_fatfs_test_workloads(SdFatfsTest* test) {
+    SectorCacheStats before;
+
+    uint8_t* work = malloc(_MAX_SS * 8);
+    furi_check(f_mkfs(SD_FATFS_TEST_VOLUME, FM_ANY, 0, work, _MAX_SS * 8) == FR_OK);
+    free(work);
+    furi_check(f_mount(&fatfs_object, SD_FATFS_TEST_VOLUME, 1) == FR_OK);
+
+    sector_cache_get_stats(&before);
+    sd_fatfs_test_create_tree(test);
+    sd_fatfs_test_log_stats("Create tree", &before);
+
+    sector_cache_get_stats(&before);
+    sd_fatfs_test_list_dirs(test);
+    sd_fatfs_test_log_stats("List dirs", &before);
+
+    SectorCacheStats listed;
+    sector_cache_get_stats(&listed);
+    // Directory and FAT sectors stay pinned across the passes
+    furi_check(listed.hits - before.hits > listed.misses - before.misses);
+
+    sector_cache_get_stats(&before);
+    sd_fatfs_test_copy_files(test);
+    sd_fatfs_test_log_stats("Copy files", &before);
+
+    sd_fatfs_test_verify(test);
+
+    // Everything must have reached the disk
+    furi_check(f_mount(NULL, SD_FATFS_TEST_VOLUME, 0) == FR_OK);
+    furi_check(furi_hal_sd_init(false) == FuriStatusOk);
+    furi_check(f_mount(&fatfs_object, SD_FATFS_TEST_VOLUME, 1) == FR_OK);
+    sd_fatfs_test_verify(test);
+    furi_check(f_mount(NULL, SD_FATFS_TEST_VOLUME, 0) == FR_OK);
+
+    FURI_LOG_I(TAG, "Workloads: ok");
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+
+    furi_check(furi_hal_sd_init(false) == FuriStatusOk);
+    fatfs_init();
+
+    SdFatfsTest* test = malloc(sizeof(SdFatfsTest));
+    test->rng = 1;
+
+    sd_fatfs_test_raw_coherency();
+    sd_fatfs_test_workloads(test);
+
+    free(test);
+
+    printf("SD FatFs test passed\r\n");
+
+    return 0;
+}
@@ -0,0 +1,540 @@
+/**
+ * @file sd_spi_test.c
+ * SD card SPI driver of the device against an emulated card
+ *
+ * The card below sits on the host SPI bus D and answers in SPI mode as an
+ * SDHC card: NCR byte ahead of R1, start tokens ahead of data, busy after
+ * writes. A multi block read streams blocks until CMD12 and reads ahead past
+ * the requested ones; past the last block it sends an error token and flags
+ * OUT_OF_RANGE. After CMD12 it sends the stuff byte and one more data byte
+ * before R1, as cards still clocking out a block do. Commands are logged and
+ * bus transfers, bytes and selects are counted per MB for each request size.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi_hal_sd_i.h>
+
+#include <stdio.h>
+
+#define TAG "SdSpiTest"
+
+#define SD_SPI_TEST_BLOCK_SIZE 512
+// CSD v2 C_SIZE, capacity is (C_SIZE + 1) * 512 KiB
+#define SD_SPI_TEST_C_SIZE      3
+#define SD_SPI_TEST_BLOCK_COUNT ((SD_SPI_TEST_C_SIZE + 1) * 1024UL)
+#define SD_SPI_TEST_MB_BLOCKS   (1024UL * 1024 / SD_SPI_TEST_BLOCK_SIZE)
+#define SD_SPI_TEST_OUT_SIZE    (SD_SPI_TEST_BLOCK_SIZE + 32)
+#define SD_SPI_TEST_LOG_SIZE    64
+#define SD_SPI_TEST_BUSY        2
+#define SD_SPI_TEST_MAX_BLOCKS  64
+
+#define SD_SPI_TEST_R1_IDLE         0x01
+#define SD_SPI_TEST_R1_ILLEGAL      0x04
+#define SD_SPI_TEST_R1_PARAMETER    0x40
+#define SD_SPI_TEST_R2_OUT_OF_RANGE 0x80
+
+#define SD_SPI_TEST_TOKEN_READ         0xFE
+#define SD_SPI_TEST_TOKEN_WRITE        0xFE
+#define SD_SPI_TEST_TOKEN_WRITE_MULT   0xFC
+#define SD_SPI_TEST_TOKEN_STOP         0xFD
+#define SD_SPI_TEST_TOKEN_OUT_OF_RANGE 0x08
+#define SD_SPI_TEST_DATA_ACCEPTED      0xE5
+#define SD_SPI_TEST_DATA_WRITE_ERROR   0xED
+
+typedef enum {
+    SdSpiTestModeCommand,
+    SdSpiTestModeRead, /**< CMD18, blocks stream until CMD12 */
+    SdSpiTestModeWrite, /**< CMD24 or CMD25, waiting for a token */
+    SdSpiTestModeWriteData, /**< Block and CRC coming in */
+} SdSpiTestMode;
+
+typedef struct {
+    uint8_t* data;
+    bool spi_mode;
+    bool idle;
+    bool app_cmd;
+    uint8_t op_cond_count;
+    bool out_of_range;
+    // R1 error of the next CMD12, once
+    uint8_t stop_error;
+
+    SdSpiTestMode mode;
+    bool write_multiple;
+    uint32_t address;
+    uint8_t frame[6];
+    size_t frame_size;
+    uint8_t block[SD_SPI_TEST_BLOCK_SIZE + 2];
+    size_t block_size;
+
+    uint8_t out[SD_SPI_TEST_OUT_SIZE];
+    size_t out_pos;
+    size_t out_size;
+    size_t busy;
+
+    bool selected;
+    size_t transfers;
+    size_t bytes;
+    size_t selects;
+    uint8_t log[SD_SPI_TEST_LOG_SIZE];
+    size_t log_size;
+} SdSpiTestCard;
+
+static const uint8_t sd_spi_test_csd[16] = {
+    0x40, 0x0E, 0x00, 0x32, 0x5B, 0x59, 0x00, 0x00,
+    0x00, SD_SPI_TEST_C_SIZE, 0x7F, 0x80, 0x0A, 0x40, 0x00, 0x01,
+};
+
+static const uint8_t sd_spi_test_cid[16] = {
+    0x03, 'S', 'D', 'E', 'M', 'U', 'L', '8', 0x10, 0x12, 0x34, 0x56, 0x78, 0x01, 0x8A, 0x01,
+};
+
+static uint32_t sd_spi_test_rng = 0x5D;
+
+static uint32_t sd_spi_test_rand(void) {
+    sd_spi_test_rng = sd_spi_test_rng * 1664525U + 1013904223U;
+    return sd_spi_test_rng >> 8;
+}
+
+static void sd_spi_test_card_push(SdSpiTestCard* card, const uint8_t* data, size_t size) {
+    if(card->out_pos == card->out_size) {
+        card->out_pos = 0;
+        card->out_size = 0;
+    }
+    furi_check(card->out_size + size <= SD_SPI_TEST_OUT_SIZE);
+    memcpy(&card->out[card->out_size], data, size);
+    card->out_size += size;
+}
+
+static void sd_spi_test_card_push_byte(SdSpiTestCard* card, uint8_t byte) {
+    sd_spi_test_card_push(card, &byte, 1);
+}
+
+/** NCR byte, then R1, idle bit included */
+static void sd_spi_test_card_push_r1(SdSpiTestCard* card, uint8_t r1) {
+    sd_spi_test_card_push_byte(card, 0xFF);
+    sd_spi_test_card_push_byte(card, r1 | (card->idle ? SD_SPI_TEST_R1_IDLE : 0));
+}
+
+/** Access time byte, start token, data and CRC */
+static void sd_spi_test_card_push_data(SdSpiTestCard* card, const uint8_t* data, size_t size) {
+    const uint8_t crc[2] = {0x00, 0x00};
+    sd_spi_test_card_push_byte(card, 0xFF);
+    sd_spi_test_card_push_byte(card, SD_SPI_TEST_TOKEN_READ);
+    sd_spi_test_card_push(card, data, size);
+    sd_spi_test_card_push(card, crc, sizeof(crc));
+}
+
+/** Next block of a CMD18 stream, read ahead whether it is wanted or not */
+static void sd_spi_test_card_stream(SdSpiTestCard* card) {
+    if(card->address < SD_SPI_TEST_BLOCK_COUNT) {
+        sd_spi_test_card_push_data(
+            card, &card->data[card->address * SD_SPI_TEST_BLOCK_SIZE], SD_SPI_TEST_BLOCK_SIZE);
+        card->address++;
+    } else {
+        sd_spi_test_card_push_byte(card, 0xFF);
+        sd_spi_test_card_push_byte(card, SD_SPI_TEST_TOKEN_OUT_OF_RANGE);
+        card->out_of_range = true;
+        card->mode = SdSpiTestModeCommand;
+    }
+}
+
+static void sd_spi_test_card_command(SdSpiTestCard* card) {
+    const uint8_t command = card->frame[0] & 0x3F;
+    const uint32_t arg = (card->frame[1] << 24) | (card->frame[2] << 16) |
+                         (card->frame[3] << 8) | card->frame[4];
+    const bool app_cmd = card->app_cmd;
+    card->app_cmd = false;
+
+    if(command == 0) {
+        card->spi_mode = true;
+        card->idle = true;
+        card->op_cond_count = 0;
+        card->out_of_range = false;
+    } else if(!card->spi_mode) {
+        return;
+    }
+
+    if(card->log_size < SD_SPI_TEST_LOG_SIZE) {
+        card->log[card->log_size++] = command;
+    }
+
+    // A command ends whatever was being clocked out
+    card->out_pos = card->out_size = 0;
+    card->busy = 0;
+
+    switch(command) {
+    case 0:
+        card->mode = SdSpiTestModeCommand;
+        sd_spi_test_card_push_r1(card, 0);
+        break;
+    case 8: {
+        sd_spi_test_card_push_r1(card, 0);
+        const uint8_t r7[4] = {0x00, 0x00, (arg >> 8) & 0x0F, arg & 0xFF};
+        sd_spi_test_card_push(card, r7, sizeof(r7));
+        break;
+    }
+    case 9:
+        sd_spi_test_card_push_r1(card, 0);
+        sd_spi_test_card_push_data(card, sd_spi_test_csd, sizeof(sd_spi_test_csd));
+        break;
+    case 10:
+        sd_spi_test_card_push_r1(card, 0);
+        sd_spi_test_card_push_data(card, sd_spi_test_cid, sizeof(sd_spi_test_cid));
+        break;
+    case 12: {
+        // Stuff byte and the data byte in flight come ahead of R1, neither is 0xFF
+        uint8_t r1 = card->stop_error;
+        if(card->out_of_range) r1 |= SD_SPI_TEST_R1_PARAMETER;
+        card->stop_error = 0;
+        sd_spi_test_card_push_byte(card, 0x5A);
+        sd_spi_test_card_push_byte(card, 0xC3);
+        sd_spi_test_card_push_byte(card, r1);
+        card->busy = SD_SPI_TEST_BUSY;
+        card->mode = SdSpiTestModeCommand;
+        break;
+    }
+    case 13: {
+        sd_spi_test_card_push_r1(card, 0);
+        sd_spi_test_card_push_byte(card, card->out_of_range ? SD_SPI_TEST_R2_OUT_OF_RANGE : 0);
+        // Clear on read
+        card->out_of_range = false;
+        break;
+    }
+    case 16:
+        sd_spi_test_card_push_r1(
+            card, arg == SD_SPI_TEST_BLOCK_SIZE ? 0 : SD_SPI_TEST_R1_PARAMETER);
+        break;
+    case 17:
+    case 18:
+        if(arg >= SD_SPI_TEST_BLOCK_COUNT) {
+            sd_spi_test_card_push_r1(card, SD_SPI_TEST_R1_PARAMETER);
+        } else if(command == 17) {
+            sd_spi_test_card_push_r1(card, 0);
+            sd_spi_test_card_push_data(
+                card, &card->data[arg * SD_SPI_TEST_BLOCK_SIZE], SD_SPI_TEST_BLOCK_SIZE);
+        } else {
+            sd_spi_test_card_push_r1(card, 0);
+            card->address = arg;
+            card->mode = SdSpiTestModeRead;
+        }
+        break;
+    case 23:
+        sd_spi_test_card_push_r1(card, app_cmd ? 0 : SD_SPI_TEST_R1_ILLEGAL);
+        break;
+    case 24:
+    case 25:
+        if(arg >= SD_SPI_TEST_BLOCK_COUNT) {
+            sd_spi_test_card_push_r1(card, SD_SPI_TEST_R1_PARAMETER);
+        } else {
+            sd_spi_test_card_push_r1(card, 0);
+            card->address = arg;
+            card->write_multiple = command == 25;
+            card->mode = SdSpiTestModeWrite;
+        }
+        break;
+    case 41:
+        if(!app_cmd) {
+            sd_spi_test_card_push_r1(card, SD_SPI_TEST_R1_ILLEGAL);
+            break;
+        }
+        // Ready on the second ACMD41, as cards that take a while to power up
+        if(++card->op_cond_count > 1) card->idle = false;
+        sd_spi_test_card_push_r1(card, 0);
+        break;
+    case 55:
+        card->app_cmd = true;
+        sd_spi_test_card_push_r1(card, 0);
+        break;
+    case 58: {
+        // Powered up, CCS set: SDHC
+        const uint8_t ocr[4] = {0xC0, 0xFF, 0x80, 0x00};
+        sd_spi_test_card_push_r1(card, 0);
+        sd_spi_test_card_push(card, ocr, sizeof(ocr));
+        break;
+    }
+    default:
+        sd_spi_test_card_push_r1(card, SD_SPI_TEST_R1_ILLEGAL);
+        break;
+    }
+}
+
+static void sd_spi_test_card_receive(SdSpiTestCard* card, uint8_t byte) {
+    switch(card->mode) {
+    case SdSpiTestModeWrite:
+        if(byte == (card->write_multiple ? SD_SPI_TEST_TOKEN_WRITE_MULT :
+                                           SD_SPI_TEST_TOKEN_WRITE)) {
+            card->block_size = 0;
+            card->mode = SdSpiTestModeWriteData;
+        } else if(card->write_multiple && byte == SD_SPI_TEST_TOKEN_STOP) {
+            card->busy = SD_SPI_TEST_BUSY;
+            card->mode = SdSpiTestModeCommand;
+        }
+        return;
+    case SdSpiTestModeWriteData:
+        card->block[card->block_size++] = byte;
+        if(card->block_size == sizeof(card->block)) {
+            if(card->address < SD_SPI_TEST_BLOCK_COUNT) {
+                memcpy(
+                    &card->data[card->address * SD_SPI_TEST_BLOCK_SIZE],
+                    card->block,
+                    SD_SPI_TEST_BLOCK_SIZE);
+                card->address++;
+                sd_spi_test_card_push_byte(card, SD_SPI_TEST_DATA_ACCEPTED);
+            } else {
+                card->out_of_range = true;
+                sd_spi_test_card_push_byte(card, SD_SPI_TEST_DATA_WRITE_ERROR);
+            }
+            card->busy = SD_SPI_TEST_BUSY;
+            card->mode = card->write_multiple ? SdSpiTestModeWrite : SdSpiTestModeCommand;
+        }
+        return;
+    case SdSpiTestModeCommand:
+    case SdSpiTestModeRead:
+        break;
+    }
+
+    // Frames start with 01 in the top bits, idle 0xFF bytes are skipped
+    if(card->frame_size == 0 && (byte & 0xC0) != 0x40) return;
+    card->frame[card->frame_size++] = byte;
+    if(card->frame_size == sizeof(card->frame)) {
+        card->frame_size = 0;
+        sd_spi_test_card_command(card);
+    }
+}
+
+static uint8_t sd_spi_test_card_clock(SdSpiTestCard* card, uint8_t tx) {
+    uint8_t rx = 0xFF;
+
+    if(card->out_pos == card->out_size && card->busy == 0 && card->mode == SdSpiTestModeRead) {
+        sd_spi_test_card_stream(card);
+    }
+
+    if(card->out_pos < card->out_size) {
+        rx = card->out[card->out_pos++];
+    } else if(card->busy) {
+        rx = 0x00;
+        card->busy--;
+    }
+
+    sd_spi_test_card_receive(card, tx);
+    return rx;
+}
+
+static void sd_spi_test_card_callback(
+    const FuriHalSpiBusHandle* handle,
+    const uint8_t* tx_buffer,
+    uint8_t* rx_buffer,
+    size_t size,
+    void* context) {
+    SdSpiTestCard* card = context;
+    const bool selected = !furi_hal_gpio_read(handle->cs);
+
+    card->transfers++;
+    card->bytes += size;
+    if(selected && !card->selected) card->selects++;
+    card->selected = selected;
+
+    for(size_t i = 0; i < size; i++) {
+        uint8_t rx = 0xFF;
+        if(selected) {
+            rx = sd_spi_test_card_clock(card, tx_buffer ? tx_buffer[i] : 0xFF);
+        } else {
+            // Deselected card leaves MISO to the pull-up, a partial frame is dropped
+            card->frame_size = 0;
+        }
+        if(rx_buffer) rx_buffer[i] = rx;
+    }
+}
+
+static void sd_spi_test_reset_stats(SdSpiTestCard* card) {
+    card->transfers = 0;
+    card->bytes = 0;
+    card->selects = 0;
+    card->log_size = 0;
+}
+
+static void sd_spi_test_expect(
+    SdSpiTestCard* card,
+    const char* name,
+    const uint8_t* commands,
+    size_t count) {
+    printf("  %-20s", name);
+    for(size_t i = 0; i < card->log_size; i++) {
+        printf(" CMD%u", card->log[i]);
+    }
+    printf("\r\n");
+
+    furi_check(card->log_size == count);
+    furi_check(memcmp(card->log, commands, count) == 0);
+    sd_spi_test_reset_stats(card);
+}
+
+#define SD_SPI_TEST_EXPECT(card, name, ...) \
+    sd_spi_test_expect(                     \
+        card, name, (const uint8_t[]){__VA_ARGS__}, sizeof((const uint8_t[]){__VA_ARGS__}))
+
+static void sd_spi_test_sequences(SdSpiTestCard* card, uint8_t* buffer) {
+    sd_spi_test_reset_stats(card);
+    furi_check(furi_hal_sd_init(false) == FuriStatusOk);
+    SD_SPI_TEST_EXPECT(card, "init", 0, 8, 55, 41, 55, 41, 58, 9);
+
+    FuriHalSdInfo info;
+    furi_check(furi_hal_sd_info(&info) == FuriStatusOk);
+    furi_check(info.logical_block_count == SD_SPI_TEST_BLOCK_COUNT);
+    furi_check(info.manufacturer_id == sd_spi_test_cid[0]);
+    SD_SPI_TEST_EXPECT(card, "info", 9, 10);
+
+    furi_check(furi_hal_sd_read_blocks((uint32_t*)buffer, 100, 1) == FuriStatusOk);
+    SD_SPI_TEST_EXPECT(card, "single read", 16, 17, 13);
+
+    furi_check(furi_hal_sd_read_blocks((uint32_t*)buffer, 100, 8) == FuriStatusOk);
+    SD_SPI_TEST_EXPECT(card, "multi read", 16, 18, 12, 13);
+
+    furi_check(furi_hal_sd_write_blocks((uint32_t*)buffer, 100, 1) == FuriStatusOk);
+    SD_SPI_TEST_EXPECT(card, "single write", 16, 24, 13);
+
+    furi_check(furi_hal_sd_write_blocks((uint32_t*)buffer, 100, 8) == FuriStatusOk);
+    SD_SPI_TEST_EXPECT(card, "multi write", 16, 55, 23, 25, 13);
+
+    // Read ahead past the last block flags OUT_OF_RANGE, a complete read still succeeds
+    const uint32_t last = SD_SPI_TEST_BLOCK_COUNT - 8;
+    furi_check(furi_hal_sd_read_blocks((uint32_t*)buffer, last, 8) == FuriStatusOk);
+    furi_check(!card->out_of_range);
+    furi_check(
+        memcmp(
+            buffer,
+            &card->data[last * SD_SPI_TEST_BLOCK_SIZE],
+            8 * SD_SPI_TEST_BLOCK_SIZE) == 0);
+    SD_SPI_TEST_EXPECT(card, "read to last block", 16, 18, 12, 13, 13);
+
+    // Not short of the end though
+    furi_check(furi_hal_sd_read_blocks((uint32_t*)buffer, last - 1, 8) == FuriStatusOk);
+    SD_SPI_TEST_EXPECT(card, "read near last block", 16, 18, 12, 13);
+}
+
+static void sd_spi_test_data(SdSpiTestCard* card, uint8_t* buffer) {
+    const size_t size = SD_SPI_TEST_MAX_BLOCKS * SD_SPI_TEST_BLOCK_SIZE;
+    uint8_t* expected = malloc(size);
+    for(size_t i = 0; i < size; i++) {
+        expected[i] = sd_spi_test_rand();
+    }
+
+    const uint32_t sector = 1000;
+    furi_check(
+        furi_hal_sd_write_blocks((uint32_t*)expected, sector, SD_SPI_TEST_MAX_BLOCKS) ==
+        FuriStatusOk);
+    furi_check(memcmp(&card->data[sector * SD_SPI_TEST_BLOCK_SIZE], expected, size) == 0);
+
+    furi_check(
+        furi_hal_sd_read_blocks((uint32_t*)buffer, sector, SD_SPI_TEST_MAX_BLOCKS) ==
+        FuriStatusOk);
+    furi_check(memcmp(buffer, expected, size) == 0);
+
+    for(size_t i = 0; i < 4; i++) {
+        const uint32_t block = sd_spi_test_rand() % SD_SPI_TEST_MAX_BLOCKS;
+        uint8_t* data = &expected[block * SD_SPI_TEST_BLOCK_SIZE];
+        for(size_t j = 0; j < SD_SPI_TEST_BLOCK_SIZE; j++) {
+            data[j] = sd_spi_test_rand();
+        }
+        furi_check(furi_hal_sd_write_blocks((uint32_t*)data, sector + block, 1) == FuriStatusOk);
+        furi_check(furi_hal_sd_read_blocks((uint32_t*)buffer, sector + block, 1) == FuriStatusOk);
+        furi_check(memcmp(buffer, data, SD_SPI_TEST_BLOCK_SIZE) == 0);
+    }
+
+    free(expected);
+    sd_spi_test_reset_stats(card);
+    printf("  %u blocks written and read back\r\n", SD_SPI_TEST_MAX_BLOCKS);
+}
+
+/** Bus transfers, bytes and selects for one MB in requests of `count` blocks */
+static size_t sd_spi_test_transfers(SdSpiTestCard* card, uint8_t* buffer, size_t count) {
+    sd_spi_test_reset_stats(card);
+    for(size_t block = 0; block < SD_SPI_TEST_MB_BLOCKS; block += count) {
+        furi_check(furi_hal_sd_read_blocks((uint32_t*)buffer, block, count) == FuriStatusOk);
+    }
+    const size_t read_transfers = card->transfers;
+    printf(
+        "  read  %2zu blocks: %6zu transfers %8zu B %5zu selects per MB\r\n",
+        count,
+        card->transfers,
+        card->bytes,
+        card->selects);
+
+    sd_spi_test_reset_stats(card);
+    for(size_t block = 0; block < SD_SPI_TEST_MB_BLOCKS; block += count) {
+        furi_check(furi_hal_sd_write_blocks((uint32_t*)buffer, block, count) == FuriStatusOk);
+    }
+    printf(
+        "  write %2zu blocks: %6zu transfers %8zu B %5zu selects per MB\r\n",
+        count,
+        card->transfers,
+        card->bytes,
+        card->selects);
+
+    return read_transfers;
+}
+
+static void sd_spi_test_throughput(SdSpiTestCard* card, uint8_t* buffer) {
+    const size_t single = sd_spi_test_transfers(card, buffer, 1);
+    const size_t multi = sd_spi_test_transfers(card, buffer, 8);
+    const size_t large = sd_spi_test_transfers(card, buffer, SD_SPI_TEST_MAX_BLOCKS);
+
+    // Command overhead is paid once per request, the per block cost stays
+    furi_check(multi * 2 < single);
+    furi_check(large < multi);
+}
+
+/** CMD12 error short of the last block fails the read, the driver recovers by init */
+static void sd_spi_test_recovery(SdSpiTestCard* card, uint8_t* buffer) {
+    furi_hal_gpio_host_set_input(&gpio_sdcard_cd, false);
+    furi_check(furi_hal_sd_is_present());
+
+    card->stop_error = SD_SPI_TEST_R1_PARAMETER;
+    sd_spi_test_reset_stats(card);
+    furi_check(furi_hal_sd_read_blocks((uint32_t*)buffer, 200, 8) == FuriStatusOk);
+    furi_check(card->stop_error == 0);
+    furi_check(
+        memcmp(
+            buffer, &card->data[200 * SD_SPI_TEST_BLOCK_SIZE], 8 * SD_SPI_TEST_BLOCK_SIZE) ==
+        0);
+    SD_SPI_TEST_EXPECT(
+        card, "recovery", 16, 18, 12, 0, 8, 55, 41, 55, 41, 58, 9, 16, 18, 12, 13);
+}
+
+static void sd_spi_test(void) {
+    SdSpiTestCard* card = malloc(sizeof(SdSpiTestCard));
+    memset(card, 0, sizeof(SdSpiTestCard));
+    card->data = malloc(SD_SPI_TEST_BLOCK_COUNT * SD_SPI_TEST_BLOCK_SIZE);
+    for(size_t i = 0; i < SD_SPI_TEST_BLOCK_COUNT * SD_SPI_TEST_BLOCK_SIZE; i++) {
+        card->data[i] = sd_spi_test_rand();
+    }
+    uint8_t* buffer = malloc(SD_SPI_TEST_MAX_BLOCKS * SD_SPI_TEST_BLOCK_SIZE);
+
+    furi_hal_spi_host_set_device(&furi_hal_spi_bus_d, sd_spi_test_card_callback, card);
+    furi_hal_sd_presence_init();
+
+    printf("Command sequences:\r\n");
+    sd_spi_test_sequences(card, buffer);
+    printf("Data:\r\n");
+    sd_spi_test_data(card, buffer);
+    printf("Bus use:\r\n");
+    sd_spi_test_throughput(card, buffer);
+    printf("Recovery:\r\n");
+    sd_spi_test_recovery(card, buffer);
+
+    furi_hal_spi_host_set_device(&furi_hal_spi_bus_d, NULL, NULL);
+    free(buffer);
+    free(card->data);
+    free(card);
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+
+    sd_spi_test();
+
+    printf("sd_spi_test passed\r\n");
+    return 0;
+}
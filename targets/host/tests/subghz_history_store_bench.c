@@ -0,0 +1,327 @@
+/**
+ * @file subghz_history_store_bench.c
+ * SubGhzHistoryStore memory use, insert cost and worker/app thread split
+ *
+ * A worker thread adds merged frames like the radio worker does, while the main
+ * thread flushes and opens records like the app thread does. Every opened
+ * signal must belong to its record, and once done every record must hold the
+ * last frame added for its key. Adds must not write the spill file, only a
+ * flush does. Without SD card signals stay in RAM, compacted as they are merged.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/stream.h>
+#include <lib/subghz/subghz_history_store.h>
+
+#include "host_bench.h"
+
+#include <stdio.h>
+
+#define TAG "SubGhzHistoryStoreBench"
+
+#define SUBGHZ_HISTORY_STORE_BENCH_SPILL   EXT_PATH("subghz_history_store_bench/spill.tmp")
+#define SUBGHZ_HISTORY_STORE_BENCH_SIZING  EXT_PATH("subghz_history_store_bench/sizing.tmp")
+#define SUBGHZ_HISTORY_STORE_BENCH_BLOCKER EXT_PATH("subghz_history_store_bench_blocker")
+#define SUBGHZ_HISTORY_STORE_BENCH_NO_SD   SUBGHZ_HISTORY_STORE_BENCH_BLOCKER "/spill.tmp"
+
+#define SUBGHZ_HISTORY_STORE_BENCH_RECORDS    200
+#define SUBGHZ_HISTORY_STORE_BENCH_SENSORS    150
+#define SUBGHZ_HISTORY_STORE_BENCH_FRAMES     5000
+#define SUBGHZ_HISTORY_STORE_BENCH_BURST      8
+#define SUBGHZ_HISTORY_STORE_BENCH_UNFLUSHED  10
+#define SUBGHZ_HISTORY_STORE_BENCH_RAM_KEYS   20
+#define SUBGHZ_HISTORY_STORE_BENCH_RAM_FRAMES 400
+
+static const SubGhzProtocol subghz_history_store_bench_protocol = {
+    .name = "Bench",
+    .type = SubGhzProtocolWeatherStation,
+};
+
+typedef struct {
+    Storage* storage;
+    SubGhzHistoryStore* store;
+    SubGhzRadioPreset preset;
+    FlipperFormat* frame;
+    FuriString* text;
+    uint32_t rng;
+
+    // Written by the worker, read once it is joined
+    uint32_t last[SUBGHZ_HISTORY_STORE_BENCH_SENSORS];
+    uint32_t added;
+    uint32_t errors;
+    uint64_t add_ns;
+    volatile bool done;
+} SubGhzHistoryStoreBench;
+
+static uint32_t subghz_history_store_bench_rand(SubGhzHistoryStoreBench* bench) {
+    bench->rng = bench->rng * 1664525U + 1013904223U;
+    return bench->rng >> 8;
+}
+
+/** Serialize a frame, its content follows from key and sequence number alone */
+static void subghz_history_store_bench_frame(
+    FlipperFormat* frame,
+    FuriString* text,
+    uint32_t key,
+    uint32_t sequence) {
+    stream_clean(flipper_format_get_raw_stream(frame));
+    furi_check(flipper_format_write_string_cstr(frame, "Protocol", "Bench"));
+    furi_check(flipper_format_write_uint32(frame, "Id", &key, 1));
+    furi_check(flipper_format_write_uint32(frame, "Sequence", &sequence, 1));
+    const uint32_t data[4] = {key * 31, sequence, key ^ sequence, 0x5EED};
+    furi_check(flipper_format_write_hex(frame, "Data", (const uint8_t*)data, sizeof(data)));
+    furi_string_printf(text, "Bench %lu #%lu", key, sequence);
+}
+
+/** Open a record, its signal must carry the key in its menu text */
+static uint32_t subghz_history_store_bench_open(SubGhzHistoryStoreBench* bench, size_t idx) {
+    subghz_history_store_get_text(bench->store, idx, bench->text);
+    uint32_t key = 0;
+    furi_check(sscanf(furi_string_get_cstr(bench->text), "Bench %lu", &key) == 1);
+
+    FlipperFormat* signal = subghz_history_store_get_flipper_format(bench->store, idx);
+    furi_check(signal);
+    uint32_t id = UINT32_MAX;
+    uint32_t sequence = 0;
+    furi_check(flipper_format_read_uint32(signal, "Id", &id, 1));
+    furi_check(flipper_format_read_uint32(signal, "Sequence", &sequence, 1));
+    furi_check(id == key);
+
+    return sequence;
+}
+
+/** Spill file size, the store keeps it open for writing */
+static size_t subghz_history_store_bench_spill_size(SubGhzHistoryStoreBench* bench) {
+    FileInfo fileinfo;
+    furi_check(
+        storage_common_stat(bench->storage, SUBGHZ_HISTORY_STORE_BENCH_SPILL, &fileinfo) ==
+        FSE_OK);
+    return fileinfo.size;
+}
+
+static int32_t subghz_history_store_bench_worker(void* context) {
+    SubGhzHistoryStoreBench* bench = context;
+    FlipperFormat* frame = flipper_format_string_alloc();
+    FuriString* text = furi_string_alloc();
+    uint32_t rng = 0x5EED;
+
+    for(uint32_t i = 0; i < SUBGHZ_HISTORY_STORE_BENCH_FRAMES; i++) {
+        rng = rng * 1664525U + 1013904223U;
+        const uint32_t key = (rng >> 8) % SUBGHZ_HISTORY_STORE_BENCH_SENSORS;
+        subghz_history_store_bench_frame(frame, text, key, i + 1);
+
+        const uint64_t start = host_bench_now_ns();
+        const SubGhzHistoryStoreAdd result = subghz_history_store_add(
+            bench->store,
+            true,
+            key,
+            &subghz_history_store_bench_protocol,
+            &bench->preset,
+            furi_string_get_cstr(text),
+            frame);
+        bench->add_ns += host_bench_now_ns() - start;
+
+        if(result == SubGhzHistoryStoreAddError) {
+            // Pending signals full, the record keeps its previous frame
+            bench->errors++;
+        } else {
+            furi_check(result != SubGhzHistoryStoreAddOverflow);
+            bench->last[key] = i + 1;
+            bench->added++;
+        }
+
+        // Frames come in bursts on air, the app thread gets to flush in between
+        if(i % SUBGHZ_HISTORY_STORE_BENCH_BURST == 0) furi_delay_ms(1);
+    }
+
+    furi_string_free(text);
+    flipper_format_free(frame);
+    bench->done = true;
+    return 0;
+}
+
+/** Heap taken by an empty store, signals live on SD card or in the bounded pending stream */
+static size_t subghz_history_store_bench_heap(size_t records) {
+    const size_t heap_before = memmgr_get_free_heap();
+    SubGhzHistoryStore* store =
+        subghz_history_store_alloc(records, SUBGHZ_HISTORY_STORE_BENCH_SIZING);
+    const size_t heap = heap_before - memmgr_get_free_heap();
+    subghz_history_store_free(store);
+    return heap;
+}
+
+static void subghz_history_store_bench_threads(SubGhzHistoryStoreBench* bench) {
+    const size_t heap = subghz_history_store_bench_heap(SUBGHZ_HISTORY_STORE_BENCH_RECORDS);
+    const size_t heap_twice =
+        subghz_history_store_bench_heap(SUBGHZ_HISTORY_STORE_BENCH_RECORDS * 2);
+    printf(
+        "  heap: %zu B for %u records, %.1f B per extra record\r\n",
+        heap,
+        SUBGHZ_HISTORY_STORE_BENCH_RECORDS,
+        (heap_twice - heap) / (double)SUBGHZ_HISTORY_STORE_BENCH_RECORDS);
+
+    bench->store = subghz_history_store_alloc(
+        SUBGHZ_HISTORY_STORE_BENCH_RECORDS, SUBGHZ_HISTORY_STORE_BENCH_SPILL);
+
+    FuriThread* thread = furi_thread_alloc_ex(TAG, 2048, subghz_history_store_bench_worker, bench);
+    furi_thread_start(thread);
+
+    uint32_t opened = 0;
+    uint32_t flushes = 0;
+    while(!bench->done) {
+        furi_check(subghz_history_store_flush(bench->store));
+        flushes++;
+        const size_t count = subghz_history_store_get_count(bench->store);
+        if(count) {
+            subghz_history_store_bench_open(bench, subghz_history_store_bench_rand(bench) % count);
+            opened++;
+        }
+        furi_delay_ms(1);
+    }
+
+    furi_check(furi_thread_join(thread));
+    furi_thread_free(thread);
+    furi_check(subghz_history_store_flush(bench->store));
+
+    // Every sensor got a record holding its last accepted frame
+    const size_t count = subghz_history_store_get_count(bench->store);
+    furi_check(count == SUBGHZ_HISTORY_STORE_BENCH_SENSORS);
+    for(size_t i = 0; i < count; i++) {
+        const uint32_t sequence = subghz_history_store_bench_open(bench, i);
+        subghz_history_store_get_text(bench->store, i, bench->text);
+        uint32_t key = 0;
+        sscanf(furi_string_get_cstr(bench->text), "Bench %lu", &key);
+        furi_check(sequence == bench->last[key]);
+    }
+
+    printf(
+        "  %lu adds, %.2f us per add, %lu rejected, %lu flushes, %lu opened meanwhile\r\n",
+        bench->added,
+        bench->add_ns / 1000.0 / (bench->added + bench->errors),
+        bench->errors,
+        flushes,
+        opened);
+    printf("  spill file: %zu B\r\n", subghz_history_store_bench_spill_size(bench));
+}
+
+/** Adds stay in RAM and can be opened there, only a flush writes the spill file */
+static void subghz_history_store_bench_unflushed(SubGhzHistoryStoreBench* bench) {
+    subghz_history_store_reset(bench->store);
+    furi_check(subghz_history_store_bench_spill_size(bench) == 0);
+
+    for(uint32_t i = 0; i < SUBGHZ_HISTORY_STORE_BENCH_UNFLUSHED; i++) {
+        subghz_history_store_bench_frame(bench->frame, bench->text, i, i + 1);
+        furi_check(
+            subghz_history_store_add(
+                bench->store,
+                true,
+                i,
+                &subghz_history_store_bench_protocol,
+                &bench->preset,
+                furi_string_get_cstr(bench->text),
+                bench->frame) == SubGhzHistoryStoreAddNew);
+    }
+    furi_check(subghz_history_store_bench_spill_size(bench) == 0);
+    for(uint32_t i = 0; i < SUBGHZ_HISTORY_STORE_BENCH_UNFLUSHED; i++) {
+        furi_check(subghz_history_store_bench_open(bench, i) == i + 1);
+    }
+
+    furi_check(subghz_history_store_flush(bench->store));
+    const size_t spilled = subghz_history_store_bench_spill_size(bench);
+    furi_check(spilled > 0);
+    for(uint32_t i = 0; i < SUBGHZ_HISTORY_STORE_BENCH_UNFLUSHED; i++) {
+        furi_check(subghz_history_store_bench_open(bench, i) == i + 1);
+    }
+    printf(
+        "  %u adds left the spill file empty, one flush wrote %zu B\r\n",
+        SUBGHZ_HISTORY_STORE_BENCH_UNFLUSHED,
+        spilled);
+
+    subghz_history_store_free(bench->store);
+    furi_check(!storage_file_exists(bench->storage, SUBGHZ_HISTORY_STORE_BENCH_SPILL));
+}
+
+/** No spill file, merged signals are compacted in RAM and never lost */
+static void subghz_history_store_bench_no_sd(SubGhzHistoryStoreBench* bench) {
+    File* file = storage_file_alloc(bench->storage);
+    furi_check(storage_file_open(
+        file, SUBGHZ_HISTORY_STORE_BENCH_BLOCKER, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    storage_file_free(file);
+
+    bench->store = subghz_history_store_alloc(
+        SUBGHZ_HISTORY_STORE_BENCH_RECORDS, SUBGHZ_HISTORY_STORE_BENCH_NO_SD);
+
+    uint32_t last[SUBGHZ_HISTORY_STORE_BENCH_RAM_KEYS] = {0};
+    size_t written = 0;
+    for(uint32_t i = 0; i < SUBGHZ_HISTORY_STORE_BENCH_RAM_FRAMES; i++) {
+        const uint32_t key = subghz_history_store_bench_rand(bench) %
+                             SUBGHZ_HISTORY_STORE_BENCH_RAM_KEYS;
+        subghz_history_store_bench_frame(bench->frame, bench->text, key, i + 1);
+        written += stream_size(flipper_format_get_raw_stream(bench->frame));
+        const SubGhzHistoryStoreAdd result = subghz_history_store_add(
+            bench->store,
+            true,
+            key,
+            &subghz_history_store_bench_protocol,
+            &bench->preset,
+            furi_string_get_cstr(bench->text),
+            bench->frame);
+        furi_check(result == SubGhzHistoryStoreAddNew || result == SubGhzHistoryStoreAddUpdate);
+        last[key] = i + 1;
+        // Nothing to write, flush is a no-op
+        furi_check(subghz_history_store_flush(bench->store));
+    }
+
+    for(size_t i = 0; i < subghz_history_store_get_count(bench->store); i++) {
+        const uint32_t sequence = subghz_history_store_bench_open(bench, i);
+        subghz_history_store_get_text(bench->store, i, bench->text);
+        uint32_t key = 0;
+        sscanf(furi_string_get_cstr(bench->text), "Bench %lu", &key);
+        furi_check(sequence == last[key]);
+    }
+    printf("  no SD card: %zu B of merged signals kept in RAM\r\n", written);
+
+    subghz_history_store_free(bench->store);
+    furi_check(storage_simply_remove(bench->storage, SUBGHZ_HISTORY_STORE_BENCH_BLOCKER));
+}
+
+static void subghz_history_store_bench(void) {
+    SubGhzHistoryStoreBench* bench = malloc(sizeof(SubGhzHistoryStoreBench));
+    memset(bench, 0, sizeof(SubGhzHistoryStoreBench));
+    bench->storage = furi_record_open(RECORD_STORAGE);
+    bench->preset.name = furi_string_alloc_set("AM650");
+    bench->preset.frequency = 433920000;
+    bench->frame = flipper_format_string_alloc();
+    bench->text = furi_string_alloc();
+    bench->rng = 0x4157;
+
+    printf("Worker adds, app thread flushes and opens:\r\n");
+    subghz_history_store_bench_threads(bench);
+    printf("Unflushed adds:\r\n");
+    subghz_history_store_bench_unflushed(bench);
+    printf("No spill file:\r\n");
+    subghz_history_store_bench_no_sd(bench);
+
+    furi_string_free(bench->text);
+    flipper_format_free(bench->frame);
+    furi_string_free(bench->preset.name);
+    furi_record_close(RECORD_STORAGE);
+    free(bench);
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+    storage_host_init();
+
+    subghz_history_store_bench();
+
+    printf("subghz_history_store_bench passed\r\n");
+    return 0;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file subghz_raw_play_bench.c
+ * Playback of a multi-MB SubGhz RAW file through SubGhzFileEncoderWorker
+ *
+ * The worker is drained once as fast as possible, for throughput, and once at a
+ * fixed rate well above what the radio asks for, where it must never underrun.
+ * Both runs are done from text, writing the sidecar as it plays, and from the
+ * sidecar. Every run must deliver the exact durations of the file, a stopped
+ * playback must not leave a sidecar behind.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/stream.h>
+#include <lib/subghz/subghz_file_encoder_worker.h>
+
+#include "host_bench.h"
+
+#include <stdio.h>
+
+#define TAG "SubGhzRawPlayBench"
+
+#define SUBGHZ_RAW_PLAY_BENCH_FILE EXT_PATH("subghz_raw_play_bench.sub")
+#define SUBGHZ_RAW_PLAY_BENCH_SIDECAR \
+    EXT_PATH("subghz_raw_play_bench.sub" SUBGHZ_FILE_ENCODER_WORKER_BIN_EXTENSION)
+
+#define SUBGHZ_RAW_PLAY_BENCH_SIZE     (2UL * 1024 * 1024)
+#define SUBGHZ_RAW_PLAY_BENCH_LINE     512
+#define SUBGHZ_RAW_PLAY_BENCH_RATE     50000
+#define SUBGHZ_RAW_PLAY_BENCH_STOP_AT  1000
+#define SUBGHZ_RAW_PLAY_BENCH_PACE_US  20
+#define SUBGHZ_RAW_PLAY_BENCH_DURATION 32000
+
+typedef struct {
+    uint32_t count;
+    uint32_t checksum;
+    uint32_t underruns;
+    uint64_t elapsed_us;
+} SubGhzRawPlayBenchRun;
+
+typedef struct {
+    Storage* storage;
+    SubGhzFileEncoderWorker* worker;
+    size_t file_size;
+    uint32_t count;
+    uint32_t checksum;
+    uint32_t rng;
+} SubGhzRawPlayBench;
+
+static uint32_t subghz_raw_play_bench_rand(SubGhzRawPlayBench* bench) {
+    bench->rng = bench->rng * 1664525U + 1013904223U;
+    return bench->rng >> 8;
+}
+
+static uint32_t subghz_raw_play_bench_checksum(uint32_t checksum, int32_t duration) {
+    return checksum * 31 + (uint32_t)duration;
+}
+
+static void subghz_raw_play_bench_write(SubGhzRawPlayBench* bench) {
+    FlipperFormat* format = flipper_format_file_alloc(bench->storage);
+    furi_check(flipper_format_file_open_always(format, SUBGHZ_RAW_PLAY_BENCH_FILE));
+    furi_check(flipper_format_write_header_cstr(format, "Flipper SubGhz RAW File", 1));
+    uint32_t frequency = 433920000;
+    furi_check(flipper_format_write_uint32(format, "Frequency", &frequency, 1));
+    furi_check(
+        flipper_format_write_string_cstr(format, "Preset", "FuriHalSubGhzPresetOok650Async"));
+    furi_check(flipper_format_write_string_cstr(format, "Protocol", "RAW"));
+
+    int32_t line[SUBGHZ_RAW_PLAY_BENCH_LINE];
+    Stream* stream = flipper_format_get_raw_stream(format);
+    while(stream_size(stream) < SUBGHZ_RAW_PLAY_BENCH_SIZE) {
+        for(size_t i = 0; i < COUNT_OF(line); i++) {
+            const int32_t duration =
+                1 + (int32_t)(subghz_raw_play_bench_rand(bench) % SUBGHZ_RAW_PLAY_BENCH_DURATION);
+            line[i] = (bench->count & 1) ? -duration : duration;
+            bench->checksum = subghz_raw_play_bench_checksum(bench->checksum, line[i]);
+            bench->count++;
+        }
+        furi_check(flipper_format_write_int32(format, "RAW_Data", line, COUNT_OF(line)));
+    }
+    bench->file_size = stream_size(stream);
+    flipper_format_free(format);
+}
+
+/** Drain the worker like the TX DMA does, at most rate durations/s, 0 for no limit */
+static void subghz_raw_play_bench_drain(
+    SubGhzRawPlayBench* bench,
+    uint32_t rate,
+    uint32_t stop_at,
+    SubGhzRawPlayBenchRun* run) {
+    memset(run, 0, sizeof(SubGhzRawPlayBenchRun));
+    furi_check(subghz_file_encoder_worker_start(bench->worker, SUBGHZ_RAW_PLAY_BENCH_FILE, NULL));
+
+    // The radio starts on the first duration, underruns count from there
+    LevelDuration level_duration;
+    do {
+        level_duration = subghz_file_encoder_worker_get_level_duration(bench->worker);
+    } while(level_duration_is_wait(level_duration));
+
+    const uint64_t start = host_bench_now_ns();
+    bool stalled = false;
+    while(!level_duration_is_reset(level_duration)) {
+        if(level_duration_is_wait(level_duration)) {
+            // One underrun per gap in the output, however long it is
+            if(rate && !stalled) run->underruns++;
+            stalled = true;
+        } else {
+            stalled = false;
+            const int32_t duration = level_duration_get_duration(level_duration);
+            const int32_t value = level_duration_get_level(level_duration) ? duration : -duration;
+            run->checksum = subghz_raw_play_bench_checksum(run->checksum, value);
+            run->count++;
+            if(run->count == stop_at) break;
+        }
+
+        while(rate && (uint64_t)run->count * 1000000000ULL >
+                          (host_bench_now_ns() - start) * (uint64_t)rate) {
+            furi_delay_us(SUBGHZ_RAW_PLAY_BENCH_PACE_US);
+        }
+        level_duration = subghz_file_encoder_worker_get_level_duration(bench->worker);
+    }
+    run->elapsed_us = host_bench_elapsed_us(start);
+
+    subghz_file_encoder_worker_stop(bench->worker);
+}
+
+static void subghz_raw_play_bench_play(
+    SubGhzRawPlayBench* bench,
+    const char* name,
+    uint32_t rate,
+    bool from_sidecar) {
+    furi_check(storage_file_exists(bench->storage, SUBGHZ_RAW_PLAY_BENCH_SIDECAR) == from_sidecar);
+
+    SubGhzRawPlayBenchRun run;
+    subghz_raw_play_bench_drain(bench, rate, 0, &run);
+
+    furi_check(run.count == bench->count);
+    furi_check(run.checksum == bench->checksum);
+    // Played from text, the sidecar is written on the way for the next play
+    furi_check(storage_file_exists(bench->storage, SUBGHZ_RAW_PLAY_BENCH_SIDECAR));
+
+    printf(
+        "  %-22s %8llu us, %10.0f durations/s, %6.1f MB/s of .sub, %lu underruns\r\n",
+        name,
+        (unsigned long long)run.elapsed_us,
+        run.count * 1e6 / MAX(run.elapsed_us, 1ULL),
+        bench->file_size / (double)MAX(run.elapsed_us, 1ULL),
+        run.underruns);
+    if(rate) furi_check(run.underruns == 0);
+}
+
+static void subghz_raw_play_bench(void) {
+    SubGhzRawPlayBench* bench = malloc(sizeof(SubGhzRawPlayBench));
+    bench->storage = furi_record_open(RECORD_STORAGE);
+    bench->worker = subghz_file_encoder_worker_alloc();
+    bench->rng = 0x5AB;
+
+    subghz_raw_play_bench_write(bench);
+    printf("%zu bytes, %lu durations\r\n", bench->file_size, bench->count);
+
+    // A stopped playback has not seen every duration, no sidecar from it
+    SubGhzRawPlayBenchRun run;
+    subghz_raw_play_bench_drain(bench, 0, SUBGHZ_RAW_PLAY_BENCH_STOP_AT, &run);
+    furi_check(run.count == SUBGHZ_RAW_PLAY_BENCH_STOP_AT);
+    furi_check(!storage_file_exists(bench->storage, SUBGHZ_RAW_PLAY_BENCH_SIDECAR));
+
+    subghz_raw_play_bench_play(bench, "text, unpaced:", 0, false);
+    subghz_raw_play_bench_play(bench, "sidecar, unpaced:", 0, true);
+
+    furi_check(storage_simply_remove(bench->storage, SUBGHZ_RAW_PLAY_BENCH_SIDECAR));
+    subghz_raw_play_bench_play(bench, "text, paced:", SUBGHZ_RAW_PLAY_BENCH_RATE, false);
+    subghz_raw_play_bench_play(bench, "sidecar, paced:", SUBGHZ_RAW_PLAY_BENCH_RATE, true);
+
+    // Sidecar of a changed file is not used, playing from text replaces it
+    File* file = storage_file_alloc(bench->storage);
+    furi_check(storage_file_open(file, SUBGHZ_RAW_PLAY_BENCH_FILE, FSAM_WRITE, FSOM_OPEN_APPEND));
+    furi_check(storage_file_write(file, "\n", 1) == 1);
+    storage_file_free(file);
+    bench->file_size++;
+    subghz_raw_play_bench_drain(bench, 0, 0, &run);
+    furi_check(run.count == bench->count && run.checksum == bench->checksum);
+    subghz_raw_play_bench_play(bench, "sidecar, rebuilt:", 0, true);
+
+    subghz_file_encoder_worker_free(bench->worker);
+    furi_check(storage_simply_remove(bench->storage, SUBGHZ_RAW_PLAY_BENCH_SIDECAR));
+    furi_check(storage_simply_remove(bench->storage, SUBGHZ_RAW_PLAY_BENCH_FILE));
+    furi_record_close(RECORD_STORAGE);
+    free(bench);
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+    storage_host_init();
+
+    subghz_raw_play_bench();
+
+    printf("subghz_raw_play_bench passed\r\n");
+    return 0;
+}
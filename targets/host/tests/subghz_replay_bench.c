@@ -0,0 +1,310 @@
+/**
+ * @file subghz_replay_bench.c
+ * Replay of a SubGhz RAW capture through every decoder
+ *
+ * Builds a .sub RAW file of encoded frames buried in short noise pulses, reads it
+ * back and feeds it to all decoders twice: directly, the way SubGhzReceiver did
+ * before idle decoders were skipped, and through SubGhzReceiver. Both runs must
+ * report the same decodes, pulses/sec of each are logged.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <flipper_format/flipper_format.h>
+#include <lib/subghz/environment.h>
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/transmitter.h>
+#include <lib/subghz/subghz_protocol_registry.h>
+#include <lib/subghz/protocols/protocol_items.h>
+
+#include "host_bench.h"
+
+#include <stdio.h>
+
+#define TAG "SubGhzReplayBench"
+
+#define SUBGHZ_REPLAY_BENCH_FILE   EXT_PATH("subghz_replay_bench.sub")
+#define SUBGHZ_REPLAY_BENCH_ROUNDS 64
+#define SUBGHZ_REPLAY_BENCH_NOISE  4096
+#define SUBGHZ_REPLAY_BENCH_REPEAT 4
+#define SUBGHZ_REPLAY_BENCH_LINE   512
+#define SUBGHZ_REPLAY_BENCH_EVENTS 4096
+
+#define SUBGHZ_REPLAY_BENCH_NOISE_MIN 20
+#define SUBGHZ_REPLAY_BENCH_NOISE_MAX 600
+#define SUBGHZ_REPLAY_BENCH_GAP       20000
+
+#define SUBGHZ_REPLAY_BENCH_FILTER (SubGhzProtocolFlag_Decodable)
+
+typedef struct {
+    const char* protocol;
+    uint32_t bit;
+    uint64_t key;
+    uint32_t te;
+} SubGhzReplayBenchFrame;
+
+static const SubGhzReplayBenchFrame subghz_replay_bench_frames[] = {
+    {SUBGHZ_PROTOCOL_PRINCETON_NAME, 24, 0x95D5D4, 400},
+    {SUBGHZ_PROTOCOL_CAME_NAME, 24, 0x6F8C3A, 0},
+    {SUBGHZ_PROTOCOL_NICE_FLO_NAME, 12, 0xA5C, 0},
+    {SUBGHZ_PROTOCOL_GATE_TX_NAME, 24, 0x47B30E, 0},
+    {SUBGHZ_PROTOCOL_LINEAR_NAME, 10, 0x2D3, 0},
+};
+
+typedef struct {
+    const char* protocol;
+    uint8_t hash;
+} SubGhzReplayBenchEvent;
+
+typedef struct {
+    int32_t* data;
+    size_t count;
+    size_t capacity;
+
+    SubGhzReplayBenchEvent events[SUBGHZ_REPLAY_BENCH_EVENTS];
+    size_t event_count;
+
+    uint32_t rng;
+} SubGhzReplayBench;
+
+static uint32_t subghz_replay_bench_rand(SubGhzReplayBench* bench) {
+    bench->rng = bench->rng * 1664525U + 1013904223U;
+    return bench->rng >> 8;
+}
+
+static void subghz_replay_bench_push(SubGhzReplayBench* bench, bool level, uint32_t duration) {
+    if(bench->count == bench->capacity) {
+        bench->capacity = bench->capacity ? bench->capacity * 2 : 4096;
+        bench->data = realloc(bench->data, bench->capacity * sizeof(int32_t));
+        furi_check(bench->data);
+    }
+    bench->data[bench->count++] = level ? (int32_t)duration : -(int32_t)duration;
+}
+
+static void subghz_replay_bench_push_noise(SubGhzReplayBench* bench) {
+    const uint32_t span = SUBGHZ_REPLAY_BENCH_NOISE_MAX - SUBGHZ_REPLAY_BENCH_NOISE_MIN;
+    for(size_t i = 0; i < SUBGHZ_REPLAY_BENCH_NOISE; i++) {
+        const uint32_t duration =
+            SUBGHZ_REPLAY_BENCH_NOISE_MIN + subghz_replay_bench_rand(bench) % span;
+        subghz_replay_bench_push(bench, !(i & 1), duration);
+    }
+    subghz_replay_bench_push(bench, false, SUBGHZ_REPLAY_BENCH_GAP);
+}
+
+static void subghz_replay_bench_push_frame(
+    SubGhzReplayBench* bench,
+    SubGhzEnvironment* environment,
+    const SubGhzReplayBenchFrame* frame) {
+    FlipperFormat* format = flipper_format_string_alloc();
+    uint8_t key[sizeof(uint64_t)];
+    for(size_t i = 0; i < sizeof(key); i++) {
+        key[i] = (uint8_t)(frame->key >> ((sizeof(key) - 1 - i) * 8));
+    }
+    furi_check(flipper_format_write_string_cstr(format, "Protocol", frame->protocol));
+    furi_check(flipper_format_write_uint32(format, "Bit", &frame->bit, 1));
+    furi_check(flipper_format_write_hex(format, "Key", key, sizeof(key)));
+    if(frame->te) furi_check(flipper_format_write_uint32(format, "TE", &frame->te, 1));
+    uint32_t repeat = SUBGHZ_REPLAY_BENCH_REPEAT;
+    furi_check(flipper_format_write_uint32(format, "Repeat", &repeat, 1));
+    flipper_format_rewind(format);
+
+    SubGhzTransmitter* transmitter = subghz_transmitter_alloc_init(environment, frame->protocol);
+    furi_check(transmitter);
+    furi_check(subghz_transmitter_deserialize(transmitter, format) == SubGhzProtocolStatusOk);
+
+    for(size_t i = 0; i < SUBGHZ_REPLAY_BENCH_REPEAT * 1024; i++) {
+        LevelDuration level_duration = subghz_transmitter_yield(transmitter);
+        if(level_duration_is_reset(level_duration)) break;
+        subghz_replay_bench_push(
+            bench,
+            level_duration_get_level(level_duration),
+            level_duration_get_duration(level_duration));
+    }
+    subghz_replay_bench_push(bench, false, SUBGHZ_REPLAY_BENCH_GAP);
+
+    subghz_transmitter_free(transmitter);
+    flipper_format_free(format);
+}
+
+static void subghz_replay_bench_write(SubGhzReplayBench* bench, Storage* storage) {
+    FlipperFormat* format = flipper_format_file_alloc(storage);
+    furi_check(flipper_format_file_open_always(format, SUBGHZ_REPLAY_BENCH_FILE));
+    furi_check(flipper_format_write_header_cstr(format, "Flipper SubGhz RAW File", 1));
+    uint32_t frequency = 433920000;
+    furi_check(flipper_format_write_uint32(format, "Frequency", &frequency, 1));
+    furi_check(
+        flipper_format_write_string_cstr(format, "Preset", "FuriHalSubGhzPresetOok650Async"));
+    furi_check(flipper_format_write_string_cstr(format, "Protocol", "RAW"));
+    for(size_t i = 0; i < bench->count; i += SUBGHZ_REPLAY_BENCH_LINE) {
+        const size_t count = MIN(bench->count - i, (size_t)SUBGHZ_REPLAY_BENCH_LINE);
+        furi_check(flipper_format_write_int32(format, "RAW_Data", &bench->data[i], count));
+    }
+    flipper_format_free(format);
+}
+
+static void subghz_replay_bench_read(SubGhzReplayBench* bench, Storage* storage) {
+    const size_t written = bench->count;
+    bench->count = 0;
+
+    FlipperFormat* format = flipper_format_file_alloc(storage);
+    furi_check(flipper_format_file_open_existing(format, SUBGHZ_REPLAY_BENCH_FILE));
+    int32_t line[SUBGHZ_REPLAY_BENCH_LINE];
+    uint32_t count = 0;
+    while(flipper_format_get_value_count(format, "RAW_Data", &count) && count) {
+        furi_check(count <= COUNT_OF(line));
+        furi_check(flipper_format_read_int32(format, "RAW_Data", line, count));
+        for(size_t i = 0; i < count; i++) {
+            subghz_replay_bench_push(bench, line[i] > 0, line[i] > 0 ? line[i] : -line[i]);
+        }
+    }
+    flipper_format_free(format);
+
+    furi_check(bench->count == written);
+}
+
+static void subghz_replay_bench_decoded(SubGhzProtocolDecoderBase* decoder_base, void* context) {
+    SubGhzReplayBench* bench = context;
+    furi_check(bench->event_count < COUNT_OF(bench->events));
+    bench->events[bench->event_count++] = (SubGhzReplayBenchEvent){
+        .protocol = decoder_base->protocol->name,
+        .hash = subghz_protocol_decoder_base_get_hash_data(decoder_base),
+    };
+}
+
+static void subghz_replay_bench_receiver_decoded(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    subghz_replay_bench_decoded(decoder_base, context);
+}
+
+/** Feed every pulse to every decoder, as SubGhzReceiver did before */
+static uint64_t subghz_replay_bench_run_direct(SubGhzReplayBench* bench, SubGhzEnvironment* env) {
+    const SubGhzProtocolRegistry* registry = subghz_environment_get_protocol_registry(env);
+    const size_t protocol_count = subghz_protocol_registry_count(registry);
+    SubGhzProtocolDecoderBase** decoders = malloc(protocol_count * sizeof(*decoders));
+    size_t decoder_count = 0;
+    for(size_t i = 0; i < protocol_count; i++) {
+        const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_index(registry, i);
+        if(!protocol->decoder || !protocol->decoder->alloc) continue;
+        if((protocol->flag & SUBGHZ_REPLAY_BENCH_FILTER) == 0) continue;
+        decoders[decoder_count] = protocol->decoder->alloc(env);
+        subghz_protocol_decoder_base_set_decoder_callback(
+            decoders[decoder_count], subghz_replay_bench_decoded, bench);
+        decoder_count++;
+    }
+
+    bench->event_count = 0;
+    const uint64_t start = host_bench_now_ns();
+    for(size_t i = 0; i < bench->count; i++) {
+        const int32_t value = bench->data[i];
+        for(size_t j = 0; j < decoder_count; j++) {
+            decoders[j]->protocol->decoder->feed(
+                decoders[j], value > 0, value > 0 ? value : -value);
+        }
+    }
+    const uint64_t elapsed = host_bench_elapsed_us(start);
+
+    for(size_t j = 0; j < decoder_count; j++) {
+        decoders[j]->protocol->decoder->free(decoders[j]);
+    }
+    free(decoders);
+    return elapsed;
+}
+
+static uint64_t
+    subghz_replay_bench_run_receiver(SubGhzReplayBench* bench, SubGhzEnvironment* env) {
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(env);
+    subghz_receiver_set_filter(receiver, SUBGHZ_REPLAY_BENCH_FILTER);
+    subghz_receiver_set_rx_callback(receiver, subghz_replay_bench_receiver_decoded, bench);
+
+    bench->event_count = 0;
+    const uint64_t start = host_bench_now_ns();
+    for(size_t i = 0; i < bench->count; i++) {
+        const int32_t value = bench->data[i];
+        subghz_receiver_decode(receiver, value > 0, value > 0 ? value : -value);
+    }
+    const uint64_t elapsed = host_bench_elapsed_us(start);
+
+    subghz_receiver_free(receiver);
+    return elapsed;
+}
+
+static bool subghz_replay_bench_decoded_protocol(SubGhzReplayBench* bench, const char* name) {
+    for(size_t i = 0; i < bench->event_count; i++) {
+        if(strcmp(bench->events[i].protocol, name) == 0) return true;
+    }
+    return false;
+}
+
+static void subghz_replay_bench(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, &subghz_protocol_registry);
+
+    SubGhzReplayBench* bench = malloc(sizeof(SubGhzReplayBench));
+    bench->rng = 0x5EED;
+
+    for(size_t round = 0; round < SUBGHZ_REPLAY_BENCH_ROUNDS; round++) {
+        subghz_replay_bench_push_noise(bench);
+        subghz_replay_bench_push_frame(
+            bench,
+            environment,
+            &subghz_replay_bench_frames[round % COUNT_OF(subghz_replay_bench_frames)]);
+    }
+    subghz_replay_bench_push_noise(bench);
+
+    subghz_replay_bench_write(bench, storage);
+    subghz_replay_bench_read(bench, storage);
+
+    const uint64_t direct_us = subghz_replay_bench_run_direct(bench, environment);
+    const size_t direct_event_count = bench->event_count;
+    SubGhzReplayBenchEvent* direct_events = malloc(sizeof(bench->events));
+    memcpy(direct_events, bench->events, sizeof(bench->events));
+
+    const uint64_t receiver_us = subghz_replay_bench_run_receiver(bench, environment);
+
+    // Skipping idle decoders must not change what gets decoded
+    furi_check(bench->event_count == direct_event_count);
+    for(size_t i = 0; i < bench->event_count; i++) {
+        furi_check(strcmp(bench->events[i].protocol, direct_events[i].protocol) == 0);
+        furi_check(bench->events[i].hash == direct_events[i].hash);
+    }
+    for(size_t i = 0; i < COUNT_OF(subghz_replay_bench_frames); i++) {
+        furi_check(subghz_replay_bench_decoded_protocol(
+            bench, subghz_replay_bench_frames[i].protocol));
+    }
+
+    printf(
+        "%zu pulses, %zu decodes\r\n"
+        "  all decoders: %8llu us, %10.0f pulses/s\r\n"
+        "  receiver:     %8llu us, %10.0f pulses/s\r\n",
+        bench->count,
+        bench->event_count,
+        (unsigned long long)direct_us,
+        bench->count * 1e6 / MAX(direct_us, 1ULL),
+        (unsigned long long)receiver_us,
+        bench->count * 1e6 / MAX(receiver_us, 1ULL));
+
+    free(direct_events);
+    free(bench->data);
+    free(bench);
+    subghz_environment_free(environment);
+    furi_check(storage_simply_remove(storage, SUBGHZ_REPLAY_BENCH_FILE));
+    furi_record_close(RECORD_STORAGE);
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+    storage_host_init();
+
+    subghz_replay_bench();
+
+    printf("subghz_replay_bench passed\r\n");
+    return 0;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file u8g2_diff_buffer_test.c
+ * u8g2_SendBuffer with a diff buffer, bytes on the display bus per frame
+ *
+ * The panel below is a host framebuffer behind the byte callback: it decodes
+ * the column and page address commands of the st756x display driver and
+ * writes data bytes where the controller would. Every byte on the bus is
+ * counted. An unchanged frame must send nothing, a one tile change one tile,
+ * a full change or an invalidated diff buffer the whole frame. The panel must
+ * match the u8g2 buffer after every send.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <u8g2.h>
+
+#include <stdio.h>
+
+#define TAG "U8g2DiffBufferTest"
+
+#define U8G2_DIFF_BUFFER_TEST_TILE_WIDTH  16
+#define U8G2_DIFF_BUFFER_TEST_TILE_HEIGHT 8
+#define U8G2_DIFF_BUFFER_TEST_ROW_SIZE    (U8G2_DIFF_BUFFER_TEST_TILE_WIDTH * 8)
+#define U8G2_DIFF_BUFFER_TEST_SIZE \
+    (U8G2_DIFF_BUFFER_TEST_ROW_SIZE * U8G2_DIFF_BUFFER_TEST_TILE_HEIGHT)
+// Column high, column low and page address ahead of every tile run
+#define U8G2_DIFF_BUFFER_TEST_ADDRESS     3
+#define U8G2_DIFF_BUFFER_TEST_FULL_FRAME \
+    (U8G2_DIFF_BUFFER_TEST_TILE_HEIGHT *     \
+     (U8G2_DIFF_BUFFER_TEST_ADDRESS + U8G2_DIFF_BUFFER_TEST_ROW_SIZE))
+
+typedef struct {
+    uint8_t memory[U8G2_DIFF_BUFFER_TEST_SIZE];
+    uint8_t column;
+    uint8_t page;
+    bool is_data;
+    size_t bytes;
+    size_t transfers;
+} U8g2DiffBufferTestPanel;
+
+static U8g2DiffBufferTestPanel u8g2_diff_buffer_test_panel;
+
+static const u8x8_display_info_t u8g2_diff_buffer_test_display_info = {
+    .tile_width = U8G2_DIFF_BUFFER_TEST_TILE_WIDTH,
+    .tile_height = U8G2_DIFF_BUFFER_TEST_TILE_HEIGHT,
+    .pixel_width = U8G2_DIFF_BUFFER_TEST_TILE_WIDTH * 8,
+    .pixel_height = U8G2_DIFF_BUFFER_TEST_TILE_HEIGHT * 8,
+};
+
+static void u8g2_diff_buffer_test_panel_write(uint8_t byte) {
+    U8g2DiffBufferTestPanel* panel = &u8g2_diff_buffer_test_panel;
+    panel->bytes++;
+
+    if(panel->is_data) {
+        furi_check(panel->page < U8G2_DIFF_BUFFER_TEST_TILE_HEIGHT);
+        furi_check(panel->column < U8G2_DIFF_BUFFER_TEST_ROW_SIZE);
+        panel->memory[panel->page * U8G2_DIFF_BUFFER_TEST_ROW_SIZE + panel->column++] = byte;
+    } else if((byte & 0xF0) == 0x10) {
+        panel->column = (panel->column & 0x0F) | ((byte & 0x0F) << 4);
+    } else if((byte & 0xF0) == 0x00) {
+        panel->column = (panel->column & 0xF0) | (byte & 0x0F);
+    } else if((byte & 0xF0) == 0xB0) {
+        panel->page = byte & 0x0F;
+    }
+}
+
+static uint8_t
+    u8g2_diff_buffer_test_byte_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    UNUSED(u8x8);
+    U8g2DiffBufferTestPanel* panel = &u8g2_diff_buffer_test_panel;
+
+    switch(msg) {
+    case U8X8_MSG_BYTE_SEND:
+        for(uint8_t i = 0; i < arg_int; i++) {
+            u8g2_diff_buffer_test_panel_write(((const uint8_t*)arg_ptr)[i]);
+        }
+        break;
+    case U8X8_MSG_BYTE_SET_DC:
+        panel->is_data = arg_int;
+        break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+        panel->transfers++;
+        break;
+    case U8X8_MSG_BYTE_INIT:
+    case U8X8_MSG_BYTE_END_TRANSFER:
+        break;
+    default:
+        return 0;
+    }
+    return 1;
+}
+
+static uint8_t u8g2_diff_buffer_test_gpio_cb(
+    u8x8_t* u8x8,
+    uint8_t msg,
+    uint8_t arg_int,
+    void* arg_ptr) {
+    UNUSED(u8x8);
+    UNUSED(msg);
+    UNUSED(arg_int);
+    UNUSED(arg_ptr);
+    return 1;
+}
+
+/** Tile writes as in u8x8_d_st756x_common, other messages are accepted and ignored */
+static uint8_t
+    u8g2_diff_buffer_test_display_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    u8x8_tile_t* tile = arg_ptr;
+
+    switch(msg) {
+    case U8X8_MSG_DISPLAY_SETUP_MEMORY:
+        u8x8_d_helper_display_setup_memory(u8x8, &u8g2_diff_buffer_test_display_info);
+        break;
+    case U8X8_MSG_DISPLAY_INIT:
+        u8x8_d_helper_display_init(u8x8);
+        break;
+    case U8X8_MSG_DISPLAY_DRAW_TILE: {
+        const uint8_t x = tile->x_pos * 8;
+        u8x8_cad_StartTransfer(u8x8);
+        u8x8_cad_SendCmd(u8x8, 0x10 | (x >> 4));
+        u8x8_cad_SendCmd(u8x8, 0x00 | (x & 15));
+        u8x8_cad_SendCmd(u8x8, 0xB0 | tile->y_pos);
+        do {
+            u8x8_cad_SendData(u8x8, tile->cnt * 8, tile->tile_ptr);
+            arg_int--;
+        } while(arg_int > 0);
+        u8x8_cad_EndTransfer(u8x8);
+        break;
+    }
+    case U8X8_MSG_DISPLAY_SET_POWER_SAVE:
+    case U8X8_MSG_DISPLAY_SET_FLIP_MODE:
+    case U8X8_MSG_DISPLAY_SET_CONTRAST:
+    case U8X8_MSG_DISPLAY_REFRESH:
+        break;
+    default:
+        return 0;
+    }
+    return 1;
+}
+
+/** Send a frame, returns the bytes it took on the bus */
+static size_t u8g2_diff_buffer_test_send(u8g2_t* u8g2) {
+    U8g2DiffBufferTestPanel* panel = &u8g2_diff_buffer_test_panel;
+    const size_t bytes = panel->bytes;
+
+    u8g2_SendBuffer(u8g2);
+    furi_check(
+        memcmp(panel->memory, u8g2_GetBufferPtr(u8g2), U8G2_DIFF_BUFFER_TEST_SIZE) == 0);
+
+    return panel->bytes - bytes;
+}
+
+static void u8g2_diff_buffer_test(void) {
+    static uint8_t buffer[U8G2_DIFF_BUFFER_TEST_SIZE];
+    static uint8_t diff_buffer[U8G2_DIFF_BUFFER_TEST_SIZE];
+    u8g2_t u8g2;
+
+    u8g2_SetupDisplay(
+        &u8g2,
+        u8g2_diff_buffer_test_display_cb,
+        u8x8_cad_001,
+        u8g2_diff_buffer_test_byte_cb,
+        u8g2_diff_buffer_test_gpio_cb);
+    u8g2_SetupBuffer(
+        &u8g2,
+        buffer,
+        U8G2_DIFF_BUFFER_TEST_TILE_HEIGHT,
+        u8g2_ll_hvline_vertical_top_lsb,
+        U8G2_R0);
+    u8g2_SetDiffBuffer(&u8g2, diff_buffer);
+    u8g2_InitDisplay(&u8g2);
+    u8g2_ClearBuffer(&u8g2);
+    // Anything the first send must overwrite
+    memset(u8g2_diff_buffer_test_panel.memory, 0xA5, U8G2_DIFF_BUFFER_TEST_SIZE);
+
+    // Nothing known about the display yet, the whole frame
+    size_t bytes = u8g2_diff_buffer_test_send(&u8g2);
+    printf("  first frame:      %4zu B\r\n", bytes);
+    furi_check(bytes == U8G2_DIFF_BUFFER_TEST_FULL_FRAME);
+
+    u8g2_ResetDiffStats(&u8g2);
+    const size_t transfers = u8g2_diff_buffer_test_panel.transfers;
+    bytes = u8g2_diff_buffer_test_send(&u8g2);
+    printf("  no change:        %4zu B\r\n", bytes);
+    furi_check(bytes == 0);
+    furi_check(u8g2_diff_buffer_test_panel.transfers == transfers);
+    furi_check(u8g2_GetDiffStats(&u8g2)->frames == 1);
+    furi_check(u8g2_GetDiffStats(&u8g2)->frames_unchanged == 1);
+    furi_check(u8g2_GetDiffStats(&u8g2)->bytes_skipped == U8G2_DIFF_BUFFER_TEST_SIZE);
+
+    // Pixel 44,29 is in tile 5 of page 3
+    u8g2_DrawPixel(&u8g2, 44, 29);
+    u8g2_ResetDiffStats(&u8g2);
+    bytes = u8g2_diff_buffer_test_send(&u8g2);
+    printf("  single tile:      %4zu B\r\n", bytes);
+    furi_check(bytes == U8G2_DIFF_BUFFER_TEST_ADDRESS + 8);
+    furi_check(u8g2_GetDiffStats(&u8g2)->tile_rows_sent == 1);
+    furi_check(u8g2_GetDiffStats(&u8g2)->bytes_sent == 8);
+
+    // Tiles in between two changed ones go too, in the same transfer
+    u8g2_DrawPixel(&u8g2, 16, 0);
+    u8g2_DrawPixel(&u8g2, 79, 7);
+    bytes = u8g2_diff_buffer_test_send(&u8g2);
+    printf("  tiles 2 to 9:     %4zu B\r\n", bytes);
+    furi_check(bytes == U8G2_DIFF_BUFFER_TEST_ADDRESS + 8 * 8);
+
+    u8g2_DrawBox(&u8g2, 0, 0, 128, 64);
+    bytes = u8g2_diff_buffer_test_send(&u8g2);
+    printf("  full frame:       %4zu B\r\n", bytes);
+    furi_check(bytes == U8G2_DIFF_BUFFER_TEST_FULL_FRAME);
+
+    // Flip mode rewrites display RAM behind the diff buffer, next frame goes in full
+    u8g2_SetFlipMode(&u8g2, 1);
+    bytes = u8g2_diff_buffer_test_send(&u8g2);
+    printf("  after flip mode:  %4zu B\r\n", bytes);
+    furi_check(bytes == U8G2_DIFF_BUFFER_TEST_FULL_FRAME);
+
+    // Without diff buffer every frame is sent in full
+    u8g2_SetDiffBuffer(&u8g2, NULL);
+    bytes = u8g2_diff_buffer_test_send(&u8g2);
+    printf("  no diff buffer:   %4zu B\r\n", bytes);
+    furi_check(bytes == U8G2_DIFF_BUFFER_TEST_FULL_FRAME);
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+
+    u8g2_diff_buffer_test();
+
+    printf("u8g2_diff_buffer_test passed\r\n");
+    return 0;
+}
@@ -0,0 +1,310 @@
+/**
+ * @file u8g2_glyph_cache_test.c
+ * u8g2 glyph index and glyph cache, output across font changes and draw time
+ *
+ * The tree carries no u8g2 fonts, so the test encodes its own from random
+ * bitmaps. Every glyph is padded to the same size, so glyphs of two fonts at
+ * the same address also agree in the size and first data byte the cache
+ * checks. Strings drawn through u8g2 must match the bitmaps drawn pixel by
+ * pixel: again from the cache, after switching fonts and after another font
+ * is built into the buffer of a font used before. Draw times per string are
+ * reported with one font, alternating fonts and a cleared cache.
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <u8g2.h>
+
+#include "host_bench.h"
+
+#include <stdio.h>
+
+#define TAG "U8g2GlyphCacheTest"
+
+#define U8G2_GLYPH_CACHE_TEST_WIDTH       128
+#define U8G2_GLYPH_CACHE_TEST_HEIGHT      64
+#define U8G2_GLYPH_CACHE_TEST_BUFFER_SIZE \
+    (U8G2_GLYPH_CACHE_TEST_WIDTH * U8G2_GLYPH_CACHE_TEST_HEIGHT / 8)
+#define U8G2_GLYPH_CACHE_TEST_GLYPHS      "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+#define U8G2_GLYPH_CACHE_TEST_GLYPH_CNT   (sizeof(U8G2_GLYPH_CACHE_TEST_GLYPHS) - 1)
+#define U8G2_GLYPH_CACHE_TEST_MAX_HEIGHT  8
+// Font info ahead of the glyphs, U8G2_FONT_DATA_STRUCT_SIZE in u8g2_font.c
+#define U8G2_GLYPH_CACHE_TEST_HEADER_SIZE 23
+// Runs of up to 15 pixels, 4 bit width and height, 2 bit x and y, 4 bit advance
+#define U8G2_GLYPH_CACHE_TEST_RUN_BITS    4
+#define U8G2_GLYPH_CACHE_TEST_SIZE_BITS   4
+#define U8G2_GLYPH_CACHE_TEST_POS_BITS    2
+#define U8G2_GLYPH_CACHE_TEST_DELTA_BITS  4
+#define U8G2_GLYPH_CACHE_TEST_MAX_RUN     ((1U << U8G2_GLYPH_CACHE_TEST_RUN_BITS) - 1)
+// Worst case 7x8 bitmap is 28 pairs of 9 bit plus 16 bit of glyph header
+#define U8G2_GLYPH_CACHE_TEST_GLYPH_DATA  36
+#define U8G2_GLYPH_CACHE_TEST_GLYPH_SIZE  (2 + U8G2_GLYPH_CACHE_TEST_GLYPH_DATA)
+#define U8G2_GLYPH_CACHE_TEST_FONT_SIZE \
+    (U8G2_GLYPH_CACHE_TEST_HEADER_SIZE + \
+     U8G2_GLYPH_CACHE_TEST_GLYPH_CNT * U8G2_GLYPH_CACHE_TEST_GLYPH_SIZE + 2)
+#define U8G2_GLYPH_CACHE_TEST_BASELINE    20
+#define U8G2_GLYPH_CACHE_TEST_ROUNDS      2000
+
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    // Bit 0 is the leftmost pixel of a row
+    uint8_t rows[U8G2_GLYPH_CACHE_TEST_GLYPH_CNT][U8G2_GLYPH_CACHE_TEST_MAX_HEIGHT];
+    uint8_t* data;
+} U8g2GlyphCacheTestFont;
+
+typedef struct {
+    uint8_t* data;
+    size_t bit_pos;
+} U8g2GlyphCacheTestWriter;
+
+typedef struct {
+    u8g2_t u8g2;
+    uint8_t buffer[U8G2_GLYPH_CACHE_TEST_BUFFER_SIZE];
+    uint8_t expected[U8G2_GLYPH_CACHE_TEST_BUFFER_SIZE];
+    uint32_t rng;
+} U8g2GlyphCacheTest;
+
+static const u8x8_display_info_t u8g2_glyph_cache_test_display_info = {
+    .tile_width = U8G2_GLYPH_CACHE_TEST_WIDTH / 8,
+    .tile_height = U8G2_GLYPH_CACHE_TEST_HEIGHT / 8,
+    .pixel_width = U8G2_GLYPH_CACHE_TEST_WIDTH,
+    .pixel_height = U8G2_GLYPH_CACHE_TEST_HEIGHT,
+};
+
+/** Frame buffer only, nothing is sent */
+static uint8_t
+    u8g2_glyph_cache_test_display_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    UNUSED(arg_int);
+    UNUSED(arg_ptr);
+    if(msg == U8X8_MSG_DISPLAY_SETUP_MEMORY) {
+        u8x8_d_helper_display_setup_memory(u8x8, &u8g2_glyph_cache_test_display_info);
+    }
+    return 1;
+}
+
+static uint32_t u8g2_glyph_cache_test_rand(U8g2GlyphCacheTest* test) {
+    test->rng = test->rng * 1664525U + 1013904223U;
+    return test->rng >> 8;
+}
+
+static void
+    u8g2_glyph_cache_test_put(U8g2GlyphCacheTestWriter* writer, uint8_t value, size_t bits) {
+    for(size_t i = 0; i < bits; i++) {
+        if(value & (1U << i)) writer->data[writer->bit_pos / 8] |= 1U << (writer->bit_pos % 8);
+        writer->bit_pos++;
+    }
+}
+
+static bool
+    u8g2_glyph_cache_test_pixel(const U8g2GlyphCacheTestFont* font, size_t glyph, size_t i) {
+    return font->rows[glyph][i / font->width] & (1U << (i % font->width));
+}
+
+/** Run length encoded glyph bitmap, as the u8g2 font decoder reads it */
+static void u8g2_glyph_cache_test_encode(
+    const U8g2GlyphCacheTestFont* font,
+    size_t glyph,
+    uint8_t* data) {
+    U8g2GlyphCacheTestWriter writer = {.data = data};
+    const size_t total = font->width * font->height;
+
+    u8g2_glyph_cache_test_put(&writer, font->width, U8G2_GLYPH_CACHE_TEST_SIZE_BITS);
+    u8g2_glyph_cache_test_put(&writer, font->height, U8G2_GLYPH_CACHE_TEST_SIZE_BITS);
+    // Signed fields are stored with an offset of half their range
+    u8g2_glyph_cache_test_put(&writer, 2, U8G2_GLYPH_CACHE_TEST_POS_BITS);
+    u8g2_glyph_cache_test_put(&writer, 2, U8G2_GLYPH_CACHE_TEST_POS_BITS);
+    u8g2_glyph_cache_test_put(&writer, 8 + font->width + 1, U8G2_GLYPH_CACHE_TEST_DELTA_BITS);
+
+    size_t i = 0;
+    while(i < total) {
+        uint8_t zeros = 0;
+        while(i < total && zeros < U8G2_GLYPH_CACHE_TEST_MAX_RUN &&
+              !u8g2_glyph_cache_test_pixel(font, glyph, i)) {
+            zeros++;
+            i++;
+        }
+        uint8_t ones = 0;
+        while(i < total && ones < U8G2_GLYPH_CACHE_TEST_MAX_RUN &&
+              u8g2_glyph_cache_test_pixel(font, glyph, i)) {
+            ones++;
+            i++;
+        }
+        u8g2_glyph_cache_test_put(&writer, zeros, U8G2_GLYPH_CACHE_TEST_RUN_BITS);
+        u8g2_glyph_cache_test_put(&writer, ones, U8G2_GLYPH_CACHE_TEST_RUN_BITS);
+        // No repetition of the pair
+        u8g2_glyph_cache_test_put(&writer, 0, 1);
+    }
+    furi_check(writer.bit_pos <= U8G2_GLYPH_CACHE_TEST_GLYPH_DATA * 8);
+}
+
+/** Random bitmaps of the given size, encoded into font->data */
+static void u8g2_glyph_cache_test_font_build(
+    U8g2GlyphCacheTest* test,
+    U8g2GlyphCacheTestFont* font,
+    uint8_t width,
+    uint8_t height) {
+    furi_check(width < 8 && height <= U8G2_GLYPH_CACHE_TEST_MAX_HEIGHT);
+    font->width = width;
+    font->height = height;
+
+    uint8_t* data = font->data;
+    memset(data, 0, U8G2_GLYPH_CACHE_TEST_FONT_SIZE);
+    data[0] = U8G2_GLYPH_CACHE_TEST_GLYPH_CNT;
+    data[2] = U8G2_GLYPH_CACHE_TEST_RUN_BITS;
+    data[3] = U8G2_GLYPH_CACHE_TEST_RUN_BITS;
+    data[4] = U8G2_GLYPH_CACHE_TEST_SIZE_BITS;
+    data[5] = U8G2_GLYPH_CACHE_TEST_SIZE_BITS;
+    data[6] = U8G2_GLYPH_CACHE_TEST_POS_BITS;
+    data[7] = U8G2_GLYPH_CACHE_TEST_POS_BITS;
+    data[8] = U8G2_GLYPH_CACHE_TEST_DELTA_BITS;
+    data[9] = width;
+    data[10] = height;
+    data[13] = height;
+    data[15] = height;
+
+    uint8_t* glyph = data + U8G2_GLYPH_CACHE_TEST_HEADER_SIZE;
+    for(size_t i = 0; i < U8G2_GLYPH_CACHE_TEST_GLYPH_CNT; i++) {
+        const char encoding = U8G2_GLYPH_CACHE_TEST_GLYPHS[i];
+        if(encoding == 'A') {
+            const size_t offset = glyph - (data + U8G2_GLYPH_CACHE_TEST_HEADER_SIZE);
+            data[17] = offset >> 8;
+            data[18] = offset & 0xFF;
+        }
+        for(size_t row = 0; row < height; row++) {
+            font->rows[i][row] = u8g2_glyph_cache_test_rand(test) & ((1U << width) - 1);
+        }
+        glyph[0] = encoding;
+        glyph[1] = U8G2_GLYPH_CACHE_TEST_GLYPH_SIZE;
+        u8g2_glyph_cache_test_encode(font, i, glyph + 2);
+        glyph += U8G2_GLYPH_CACHE_TEST_GLYPH_SIZE;
+    }
+
+    // Lower case search starts at the terminating empty glyph
+    const size_t offset = glyph - (data + U8G2_GLYPH_CACHE_TEST_HEADER_SIZE);
+    data[19] = offset >> 8;
+    data[20] = offset & 0xFF;
+}
+
+/** Draw with u8g2 and pixel by pixel, both must give the same buffer */
+static void u8g2_glyph_cache_test_check(
+    U8g2GlyphCacheTest* test,
+    const U8g2GlyphCacheTestFont* font,
+    const char* str) {
+    u8g2_t* u8g2 = &test->u8g2;
+
+    u8g2_ClearBuffer(u8g2);
+    size_t x = 0;
+    for(const char* c = str; *c; c++) {
+        const size_t glyph =
+            strchr(U8G2_GLYPH_CACHE_TEST_GLYPHS, *c) - U8G2_GLYPH_CACHE_TEST_GLYPHS;
+        for(size_t row = 0; row < font->height; row++) {
+            for(size_t column = 0; column < font->width; column++) {
+                if(font->rows[glyph][row] & (1U << column)) {
+                    u8g2_DrawPixel(
+                        u8g2, x + column, U8G2_GLYPH_CACHE_TEST_BASELINE - font->height + row);
+                }
+            }
+        }
+        x += font->width + 1;
+    }
+    memcpy(test->expected, test->buffer, sizeof(test->expected));
+
+    u8g2_ClearBuffer(u8g2);
+    u8g2_SetFont(u8g2, font->data);
+    u8g2_DrawStr(u8g2, 0, U8G2_GLYPH_CACHE_TEST_BASELINE, str);
+    furi_check(memcmp(test->buffer, test->expected, sizeof(test->expected)) == 0);
+}
+
+static double u8g2_glyph_cache_test_time(
+    U8g2GlyphCacheTest* test,
+    const U8g2GlyphCacheTestFont* font_a,
+    const U8g2GlyphCacheTestFont* font_b,
+    bool clear) {
+    u8g2_t* u8g2 = &test->u8g2;
+    const uint64_t start = host_bench_now_ns();
+    for(size_t i = 0; i < U8G2_GLYPH_CACHE_TEST_ROUNDS; i++) {
+        if(clear) u8g2_ClearGlyphCache(u8g2);
+        u8g2_SetFont(u8g2, (i % 2) ? font_b->data : font_a->data);
+        u8g2_DrawStr(u8g2, 0, U8G2_GLYPH_CACHE_TEST_BASELINE, "FLIPPERZERO2024");
+    }
+    return host_bench_elapsed_us(start) / U8G2_GLYPH_CACHE_TEST_ROUNDS;
+}
+
+static void u8g2_glyph_cache_test(void) {
+    U8g2GlyphCacheTest* test = malloc(sizeof(U8g2GlyphCacheTest));
+    U8g2GlyphCacheTestFont* font_a = malloc(sizeof(U8g2GlyphCacheTestFont));
+    U8g2GlyphCacheTestFont* font_b = malloc(sizeof(U8g2GlyphCacheTestFont));
+    U8g2GlyphCacheTestFont* font_c = malloc(sizeof(U8g2GlyphCacheTestFont));
+    test->rng = 0x8629;
+
+    u8g2_SetupDisplay(
+        &test->u8g2,
+        u8g2_glyph_cache_test_display_cb,
+        u8x8_cad_empty,
+        u8x8_dummy_cb,
+        u8x8_dummy_cb);
+    u8g2_SetupBuffer(
+        &test->u8g2,
+        test->buffer,
+        U8G2_GLYPH_CACHE_TEST_HEIGHT / 8,
+        u8g2_ll_hvline_vertical_top_lsb,
+        U8G2_R0);
+
+    // Font B is built into the buffer of font A later on
+    font_a->data = malloc(U8G2_GLYPH_CACHE_TEST_FONT_SIZE);
+    font_b->data = font_a->data;
+    font_c->data = malloc(U8G2_GLYPH_CACHE_TEST_FONT_SIZE);
+    u8g2_glyph_cache_test_font_build(test, font_a, 6, 8);
+    u8g2_glyph_cache_test_font_build(test, font_c, 5, 7);
+
+    // Decoded on first use, from the cache after that
+    u8g2_glyph_cache_test_check(test, font_a, "0123456789ABCDEF");
+    u8g2_glyph_cache_test_check(test, font_a, "0123456789ABCDEF");
+    u8g2_glyph_cache_test_check(test, font_a, "GHIJKLMNOPQRSTUV");
+
+    for(size_t i = 0; i < 4; i++) {
+        u8g2_glyph_cache_test_check(test, font_c, "WXYZ0123ABCD");
+        u8g2_glyph_cache_test_check(test, font_a, "ABCD0123WXYZ");
+    }
+
+    // Same address, same glyph sizes, other bitmaps
+    u8g2_SetFont(&test->u8g2, font_c->data);
+    u8g2_glyph_cache_test_font_build(test, font_b, 6, 8);
+    u8g2_glyph_cache_test_check(test, font_b, "0123456789ABCDEF");
+    u8g2_glyph_cache_test_check(test, font_b, "ABCD0123WXYZ");
+    printf("  strings match the font bitmaps across font changes\r\n");
+
+    printf(
+        "  one font:                         %6.2f us per string\r\n",
+        u8g2_glyph_cache_test_time(test, font_b, font_b, false));
+    printf(
+        "  one font, cache cleared:          %6.2f us per string\r\n",
+        u8g2_glyph_cache_test_time(test, font_b, font_b, true));
+    printf(
+        "  alternating fonts:                %6.2f us per string\r\n",
+        u8g2_glyph_cache_test_time(test, font_b, font_c, false));
+    printf(
+        "  alternating fonts, cache cleared: %6.2f us per string\r\n",
+        u8g2_glyph_cache_test_time(test, font_b, font_c, true));
+    printf(
+        "  glyph cache and index: %zu B per u8g2_t\r\n",
+        sizeof(test->u8g2.glyph_cache) + sizeof(test->u8g2.glyph_index_list));
+
+    free(font_a->data);
+    free(font_c->data);
+    free(font_a);
+    free(font_b);
+    free(font_c);
+    free(test);
+}
+
+int main(void) {
+    furi_hal_init_early();
+    furi_init();
+    furi_hal_init();
+
+    u8g2_glyph_cache_test();
+
+    printf("u8g2_glyph_cache_test passed\r\n");
+    return 0;
+}